@@ -0,0 +1,145 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Common/Exception.h>
+#include <common/likely.h>
+#include <common/types.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace DB
+{
+namespace ErrorCodes
+{
+extern const int LOGICAL_ERROR;
+}
+
+/** A split block bloom filter (the same layout as the Parquet/Impala one).
+  * The filter is an array of 256-bit buckets. A key is mapped to one bucket by the
+  * high 32 bits of its hash and sets/checks exactly one bit in each of the 8 words
+  * of that bucket, so every lookup touches a single cache line, and the per-word
+  * bit masks are independent so that the compiler is able to vectorize them.
+  *
+  * The caller is responsible for hashing keys into UInt64 with a good hash function.
+  */
+class BlockedBloomFilter
+{
+public:
+    static constexpr size_t WORDS_PER_BUCKET = 8;
+    static constexpr size_t BYTES_PER_BUCKET = WORDS_PER_BUCKET * sizeof(UInt32);
+
+    static constexpr size_t MIN_BYTES = BYTES_PER_BUCKET;
+    static constexpr size_t MAX_BYTES = 128 * 1024 * 1024;
+
+    explicit BlockedBloomFilter(size_t num_bytes)
+        : buckets(std::max(1UL, std::min(num_bytes, MAX_BYTES) / BYTES_PER_BUCKET))
+    {}
+
+    /// Returns the filter size in bytes that is expected to keep the false positive
+    /// rate under `fpp` after `ndv` distinct keys are inserted.
+    static size_t optimalNumBytes(size_t ndv, double fpp)
+    {
+        if (unlikely(fpp <= 0.0 || fpp >= 1.0))
+            throw Exception(ErrorCodes::LOGICAL_ERROR, "Invalid false positive rate {} for bloom filter", fpp);
+        const double bits = -8.0 * static_cast<double>(ndv) / std::log(1.0 - std::pow(fpp, 1.0 / 8));
+        size_t bytes = static_cast<size_t>(bits / 8);
+        // round up to the size of bucket
+        bytes = (bytes + BYTES_PER_BUCKET - 1) / BYTES_PER_BUCKET * BYTES_PER_BUCKET;
+        return std::clamp(bytes, MIN_BYTES, MAX_BYTES);
+    }
+
+    /// The max number of distinct keys that a filter of `num_bytes` can hold while
+    /// keeping the false positive rate under `fpp`.
+    static size_t maxNumKeys(size_t num_bytes, double fpp)
+    {
+        const double bits = static_cast<double>(num_bytes) * 8;
+        return static_cast<size_t>(-bits * std::log(1.0 - std::pow(fpp, 1.0 / 8)) / 8.0);
+    }
+
+    void insert(UInt64 hash)
+    {
+        Bucket & bucket = buckets[bucketIndex(hash)];
+        UInt32 masks[WORDS_PER_BUCKET];
+        makeMasks(static_cast<UInt32>(hash), masks);
+        for (size_t i = 0; i < WORDS_PER_BUCKET; ++i)
+            bucket.words[i] |= masks[i];
+    }
+
+    bool contains(UInt64 hash) const
+    {
+        const Bucket & bucket = buckets[bucketIndex(hash)];
+        UInt32 masks[WORDS_PER_BUCKET];
+        makeMasks(static_cast<UInt32>(hash), masks);
+        UInt32 missing = 0;
+        for (size_t i = 0; i < WORDS_PER_BUCKET; ++i)
+            missing |= masks[i] & ~bucket.words[i];
+        return missing == 0;
+    }
+
+    /// Check `size` hashes, and set `res[i]` to 0 for those that are definitely not in the filter.
+    /// `res[i]` is left untouched when `hashes[i]` may be in the filter, so the result can be
+    /// and-ed with an existing row filter.
+    void containsBatch(const UInt64 * hashes, size_t size, UInt8 * res) const
+    {
+        for (size_t i = 0; i < size; ++i)
+            res[i] &= static_cast<UInt8>(contains(hashes[i]));
+    }
+
+    /// Merge a filter with the same size into this one.
+    void merge(const BlockedBloomFilter & other)
+    {
+        if (unlikely(other.buckets.size() != buckets.size()))
+            throw Exception(
+                ErrorCodes::LOGICAL_ERROR,
+                "Can not merge bloom filters with different size, {} vs {}",
+                buckets.size(),
+                other.buckets.size());
+        for (size_t i = 0; i < buckets.size(); ++i)
+        {
+            for (size_t j = 0; j < WORDS_PER_BUCKET; ++j)
+                buckets[i].words[j] |= other.buckets[i].words[j];
+        }
+    }
+
+    size_t getBytes() const { return buckets.size() * BYTES_PER_BUCKET; }
+
+private:
+    struct alignas(BYTES_PER_BUCKET) Bucket
+    {
+        UInt32 words[WORDS_PER_BUCKET] = {};
+    };
+
+    size_t bucketIndex(UInt64 hash) const
+    {
+        // Map the high 32 bits into [0, buckets.size()) without modulo, see
+        // https://lemire.me/blog/2016/06/27/a-fast-alternative-to-the-modulo-reduction/
+        return static_cast<size_t>(((hash >> 32) * static_cast<UInt64>(buckets.size())) >> 32);
+    }
+
+    static void makeMasks(UInt32 key, UInt32 * masks)
+    {
+        static constexpr UInt32 SALT[WORDS_PER_BUCKET]
+            = {0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU, 0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+        for (size_t i = 0; i < WORDS_PER_BUCKET; ++i)
+            masks[i] = 1U << ((key * SALT[i]) >> 27);
+    }
+
+    std::vector<Bucket> buckets;
+};
+
+} // namespace DB
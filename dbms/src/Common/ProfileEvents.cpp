@@ -33,6 +33,8 @@
                                                \
     M(ExternalAggregationCompressedBytes)      \
     M(ExternalAggregationUncompressedBytes)    \
+    M(JoinV2SpilledPartitions)                 \
+    M(JoinV2RestoredPartitions)                \
                                                \
     M(ContextLock)                             \
     M(CreatedHTTPConnections)                  \
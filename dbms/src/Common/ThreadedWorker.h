@@ -111,6 +111,12 @@ protected:
 
     virtual Dest doWork(const Src & task) = 0;
 
+    /// Called after a result is pushed into the result queue.
+    virtual void onResultPushed() {}
+
+    /// Called after the result queue is finished or cancelled.
+    virtual void onResultQueueClosed() {}
+
 private:
     void handleWorkerFinished() noexcept
     {
@@ -131,6 +137,7 @@ private:
                     total_wait_downstream_ms / 1000.0);
                 // Note: the result queue may be already cancelled, but it is fine.
                 result_queue->finish();
+                onResultQueueClosed();
             });
         }
     }
@@ -163,6 +170,7 @@ private:
                         auto cancel_reason = source_queue->getCancelReason();
                         LOG_WARNING(log, "{}#{} meeting error from upstream: {}", getName(), thread_idx, cancel_reason);
                         result_queue->cancelWith(cancel_reason);
+                        onResultQueueClosed();
                         break;
                     }
                     else
@@ -208,6 +216,7 @@ private:
                     }
                 }
 
+                onResultPushed();
                 total_processed_tasks++;
             }
         }
@@ -217,6 +226,7 @@ private:
             auto cancel_reason = fmt::format("{} failed: {}", getName(), getCurrentExceptionMessage(false));
             source_queue->cancelWith(cancel_reason);
             result_queue->cancelWith(cancel_reason);
+            onResultQueueClosed();
         }
     }
 
@@ -237,7 +237,8 @@ static_assert(RAFT_REGION_BIG_WRITE_THRES * 4 < RAFT_REGION_BIG_WRITE_MAX, "Inva
       "TiFlash memory consumes by class",                                                                                           \
       Gauge,                                                                                                                        \
       F(type_uni_page_ids, {"type", "uni_page_ids"}),                                                                               \
-      F(type_versioned_entries, {"type", "versioned_entries"}))                                                                     \
+      F(type_versioned_entries, {"type", "versioned_entries"}),                                                                     \
+      F(type_versioned_page_entries, {"type", "versioned_page_entries"}))                                                           \
     M(tiflash_storage_read_tasks_count, "Total number of storage engine read tasks", Counter)                                       \
     M(tiflash_storage_place_index_count,                                                                                            \
       "Total number of place index operations",                                                                                     \
@@ -384,6 +385,14 @@ static_assert(RAFT_REGION_BIG_WRITE_THRES * 4 < RAFT_REGION_BIG_WRITE_MAX, "Inva
       F(type_wait_in_group, {{"type", "wait_in_group"}}, ExpBuckets{0.00005, 1.8, 26}),                                             \
       F(type_wal, {{"type", "wal"}}, ExpBuckets{0.00005, 1.8, 26}),                                                                 \
       F(type_commit, {{"type", "commit"}}, ExpBuckets{0.00005, 1.8, 26}))                                                           \
+    M(tiflash_storage_page_restore_duration_seconds,                                                                                \
+      "The duration of restoring PageDirectory from WAL when starting up",                                                          \
+      Histogram,                                                                                                                    \
+      F(type_total, {{"type", "total"}}, ExpBuckets{0.001, 2, 20}),                                                                 \
+      F(type_wal_read, {{"type", "wal_read"}}, ExpBuckets{0.001, 2, 20}),                                                           \
+      F(type_apply, {{"type", "apply"}}, ExpBuckets{0.001, 2, 20}),                                                                 \
+      F(type_gc_in_mem, {{"type", "gc_in_mem"}}, ExpBuckets{0.001, 2, 20}),                                                         \
+      F(type_blob_stats, {{"type", "blob_stats"}}, ExpBuckets{0.001, 2, 20}))                                                       \
     M(tiflash_storage_logical_throughput_bytes,                                                                                     \
       "The logical throughput of read tasks of storage in bytes",                                                                   \
       Histogram,                                                                                                                    \
@@ -456,6 +465,7 @@ static_assert(RAFT_REGION_BIG_WRITE_THRES * 4 < RAFT_REGION_BIG_WRITE_MAX, "Inva
       F(type_cache_occupy, {{"type", "cache_occupy"}}, ExpBuckets{0.01, 2, 20}),                                                    \
       F(type_worker_fetch_page, {{"type", "worker_fetch_page"}}, ExpBuckets{0.01, 2, 20}),                                          \
       F(type_worker_prepare_stream, {{"type", "worker_prepare_stream"}}, ExpBuckets{0.01, 2, 20}),                                  \
+      F(type_worker_prefetch_stable, {{"type", "worker_prefetch_stable"}}, ExpBuckets{0.01, 2, 20}),                                \
       F(type_stream_wait_next_task, {{"type", "stream_wait_next_task"}}, ExpBuckets{0.01, 2, 20}),                                  \
       F(type_stream_read, {{"type", "stream_read"}}, ExpBuckets{0.01, 2, 20}),                                                      \
       F(type_deserialize_page, {{"type", "deserialize_page"}}, ExpBuckets{0.01, 2, 20}),                                            \
@@ -466,7 +476,8 @@ static_assert(RAFT_REGION_BIG_WRITE_THRES * 4 < RAFT_REGION_BIG_WRITE_MAX, "Inva
       "",                                                                                                                           \
       Counter,                                                                                                                      \
       F(type_cftiny_read, {{"type", "cftiny_read"}}),                                                                               \
-      F(type_cftiny_fetch, {{"type", "cftiny_fetch"}}))                                                                             \
+      F(type_cftiny_fetch, {{"type", "cftiny_fetch"}}),                                                                             \
+      F(type_stable_file_prefetch, {{"type", "stable_file_prefetch"}}))                                                             \
     M(tiflash_fap_task_result,                                                                                                      \
       "",                                                                                                                           \
       Counter,                                                                                                                      \
@@ -880,6 +891,10 @@ static_assert(RAFT_REGION_BIG_WRITE_THRES * 4 < RAFT_REGION_BIG_WRITE_MAX, "Inva
       F(type_to_finished, {"type", "to_finished"}),                                                                                 \
       F(type_to_error, {"type", "to_error"}),                                                                                       \
       F(type_to_cancelled, {"type", "to_cancelled"}))                                                                               \
+    M(tiflash_pipeline_numa_task_migration,                                                                                         \
+      "pipeline cpu tasks migrated to another numa node",                                                                           \
+      Counter,                                                                                                                      \
+      F(type_cross_node, {"type", "cross_node"}))                                                                                   \
     M(tiflash_storage_s3_lock_mgr_status, "S3 Lock Manager", Gauge, F(type_prelock_keys, {{"type", "prelock_keys"}}))               \
     M(tiflash_storage_s3_lock_mgr_counter,                                                                                          \
       "S3 Lock Manager Counter",                                                                                                    \
@@ -917,6 +932,8 @@ static_assert(RAFT_REGION_BIG_WRITE_THRES * 4 < RAFT_REGION_BIG_WRITE_MAX, "Inva
       F(type_dtfile_full, {"type", "dtfile_full"}),                                                                                 \
       F(type_dtfile_download, {"type", "dtfile_download"}),                                                                         \
       F(type_dtfile_download_failed, {"type", "dtfile_download_failed"}),                                                           \
+      F(type_dtfile_reserve_exact, {"type", "dtfile_reserve_exact"}),                                                               \
+      F(type_dtfile_reserve_estimated, {"type", "dtfile_reserve_estimated"}),                                                       \
       F(type_wait_on_downloading, {"type", "wait_on_downloading"}),                                                                 \
       F(type_wait_on_downloading_hit, {"type", "wait_on_downloading_hit"}),                                                         \
       F(type_wait_on_downloading_timeout, {"type", "wait_on_downloading_timeout"}),                                                 \
@@ -932,6 +949,8 @@ static_assert(RAFT_REGION_BIG_WRITE_THRES * 4 < RAFT_REGION_BIG_WRITE_MAX, "Inva
       F(type_dtfile_evict_bytes, {"type", "dtfile_evict_bytes"}),                                                                   \
       F(type_dtfile_download_bytes, {"type", "dtfile_download_bytes"}),                                                             \
       F(type_dtfile_read_bytes, {"type", "dtfile_read_bytes"}),                                                                     \
+      F(type_dtfile_reserve_over_bytes, {"type", "dtfile_reserve_over_bytes"}),                                                     \
+      F(type_dtfile_reserve_under_bytes, {"type", "dtfile_reserve_under_bytes"}),                                                   \
       F(type_page_evict_bytes, {"type", "page_evict_bytes"}),                                                                       \
       F(type_page_download_bytes, {"type", "page_download_bytes"}),                                                                 \
       F(type_page_read_bytes, {"type", "page_read_bytes"}))                                                                         \
@@ -945,6 +964,7 @@ static_assert(RAFT_REGION_BIG_WRITE_THRES * 4 < RAFT_REGION_BIG_WRITE_MAX, "Inva
       Histogram,                                                                                                                    \
       F(type_fsync, {{"type", "fsync"}}, ExpBuckets{0.0001, 2, 20}))                                                                \
     M(tiflash_storage_mvcc_index_cache, "", Counter, F(type_hit, {"type", "hit"}), F(type_miss, {"type", "miss"}))                  \
+    M(tiflash_storage_mvcc_bitmap_cache, "", Counter, F(type_hit, {"type", "hit"}), F(type_miss, {"type", "miss"}))                 \
     M(tiflash_resource_group,                                                                                                       \
       "RU usage of each resource group",                                                                                            \
       Gauge,                                                                                                                        \
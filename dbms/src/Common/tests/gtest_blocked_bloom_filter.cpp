@@ -0,0 +1,91 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/BlockedBloomFilter.h>
+#include <Common/HashTable/Hash.h>
+#include <Common/PODArray.h>
+#include <gtest/gtest.h>
+
+#include <random>
+
+namespace DB
+{
+namespace tests
+{
+TEST(BlockedBloomFilterTest, NoFalseNegative)
+{
+    const size_t ndv = 100000;
+    BlockedBloomFilter filter(BlockedBloomFilter::optimalNumBytes(ndv, 0.01));
+    std::mt19937_64 rng(42);
+    std::vector<UInt64> keys(ndv);
+    for (auto & key : keys)
+    {
+        key = rng();
+        filter.insert(key);
+    }
+    for (const auto key : keys)
+        ASSERT_TRUE(filter.contains(key));
+
+    PaddedPODArray<UInt8> res(ndv, 1);
+    filter.containsBatch(keys.data(), keys.size(), res.data());
+    for (const auto r : res)
+        ASSERT_EQ(r, 1);
+}
+
+TEST(BlockedBloomFilterTest, FalsePositiveRate)
+{
+    const size_t ndv = 100000;
+    const double fpp = 0.01;
+    BlockedBloomFilter filter(BlockedBloomFilter::optimalNumBytes(ndv, fpp));
+    ASSERT_GE(BlockedBloomFilter::maxNumKeys(filter.getBytes(), fpp), ndv);
+    std::mt19937_64 rng(42);
+    for (size_t i = 0; i < ndv; ++i)
+        filter.insert(rng());
+
+    const size_t probes = 1000000;
+    size_t false_positives = 0;
+    for (size_t i = 0; i < probes; ++i)
+        false_positives += filter.contains(rng());
+    // The estimation of split block bloom filter is not exact, allow some slack.
+    ASSERT_LT(static_cast<double>(false_positives) / probes, fpp * 2);
+}
+
+TEST(BlockedBloomFilterTest, Merge)
+{
+    BlockedBloomFilter a(1024);
+    BlockedBloomFilter b(1024);
+    for (UInt64 i = 0; i < 100; ++i)
+    {
+        a.insert(intHash64(i));
+        b.insert(intHash64(i + 100));
+    }
+    a.merge(b);
+    for (UInt64 i = 0; i < 200; ++i)
+        ASSERT_TRUE(a.contains(intHash64(i)));
+
+    BlockedBloomFilter c(2048);
+    ASSERT_ANY_THROW(a.merge(c));
+}
+
+TEST(BlockedBloomFilterTest, Size)
+{
+    ASSERT_EQ(BlockedBloomFilter(0).getBytes(), BlockedBloomFilter::MIN_BYTES);
+    ASSERT_EQ(BlockedBloomFilter(100).getBytes(), 96);
+    ASSERT_EQ(BlockedBloomFilter::optimalNumBytes(0, 0.01), BlockedBloomFilter::MIN_BYTES);
+    ASSERT_EQ(BlockedBloomFilter::optimalNumBytes(1UL << 40, 0.01), BlockedBloomFilter::MAX_BYTES);
+    ASSERT_ANY_THROW(BlockedBloomFilter::optimalNumBytes(100, 0.0));
+}
+
+} // namespace tests
+} // namespace DB
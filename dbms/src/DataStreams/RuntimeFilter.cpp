@@ -12,8 +12,13 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <Columns/ColumnNullable.h>
+#include <Columns/countBytesInFilter.h>
+#include <Common/FieldVisitors.h>
 #include <DataStreams/RuntimeFilter.h>
+#include <DataTypes/DataTypeNullable.h>
 #include <Interpreters/Set.h>
+#include <Storages/DeltaMerge/Filter/RSOperator.h>
 #include <Storages/DeltaMerge/FilterParser/FilterParser.h>
 #include <common/logger_useful.h>
 
@@ -55,6 +60,19 @@ void RuntimeFilter::setINValuesSet(const std::shared_ptr<Set> & in_values_set_)
     in_values_set = in_values_set_;
 }
 
+void RuntimeFilter::setBloomFilterParams(
+    const DataTypePtr & source_type_,
+    const TiDB::TiDBCollatorPtr & collator_,
+    size_t max_bytes,
+    double false_positive_rate)
+{
+    source_type = source_type_;
+    collator = collator_;
+    bloom_filter_max_bytes = std::clamp(max_bytes, BlockedBloomFilter::MIN_BYTES, BlockedBloomFilter::MAX_BYTES);
+    bloom_filter_fpp = false_positive_rate;
+    bloom_max_num_keys = BlockedBloomFilter::maxNumKeys(bloom_filter_max_bytes, bloom_filter_fpp);
+}
+
 void RuntimeFilter::setTimezoneInfo(const TimezoneInfo & timezone_info_)
 {
     timezone_info = timezone_info_;
@@ -107,14 +125,128 @@ void RuntimeFilter::updateValues(const ColumnWithTypeAndName & values, const Log
         }
         break;
     case tipb::MIN_MAX:
+        updateMinMaxValues(values.column);
+        break;
     case tipb::BLOOM_FILTER:
-        // todo
+        updateBloomFilterValues(values.column, log);
         break;
     }
 }
 
+void RuntimeFilter::updateMinMaxValues(const ColumnPtr & column)
+{
+    ColumnPtr not_null_column = column;
+    if (column->isColumnNullable())
+    {
+        // ColumnNullable::getExtremes only supports a few nested types, so filter out the null values
+        // and get the extremes from the nested column.
+        const auto & nullable_column = static_cast<const ColumnNullable &>(*column);
+        const auto & null_map = nullable_column.getNullMapData();
+        IColumn::Filter not_null_filter(null_map.size());
+        for (size_t i = 0; i < null_map.size(); ++i)
+            not_null_filter[i] = !null_map[i];
+        not_null_column = nullable_column.getNestedColumn().filter(not_null_filter, -1);
+    }
+    if (not_null_column->empty())
+        return;
+
+    Field block_min;
+    Field block_max;
+    not_null_column->getExtremes(block_min, block_max);
+
+    std::lock_guard<std::mutex> lock(values_mtx);
+    if (min_value.isNull() || block_min < min_value)
+        min_value = block_min;
+    if (max_value.isNull() || max_value < block_max)
+        max_value = block_max;
+}
+
+void RuntimeFilter::computeBloomHashes(
+    const IColumn & column,
+    PaddedPODArray<UInt64> & hashes,
+    const NullMap *& null_map) const
+{
+    const IColumn * nested_column = &column;
+    null_map = nullptr;
+    if (column.isColumnNullable())
+    {
+        const auto & nullable_column = static_cast<const ColumnNullable &>(column);
+        nested_column = &nullable_column.getNestedColumn();
+        null_map = &nullable_column.getNullMapData();
+    }
+    const size_t rows = column.size();
+    IColumn::HashValues hash_values(rows, SipHash());
+    String sort_key_container;
+    nested_column->updateHashWithValues(hash_values, collator, sort_key_container);
+    hashes.resize(rows);
+    for (size_t i = 0; i < rows; ++i)
+        hashes[i] = hash_values[i].get64();
+}
+
+void RuntimeFilter::updateBloomFilterValues(const ColumnPtr & column, const LoggerPtr & log)
+{
+    // compute the hashes outside the lock, the build side is usually inserted concurrently
+    PaddedPODArray<UInt64> hashes;
+    const NullMap * null_map = nullptr;
+    computeBloomHashes(*column, hashes, null_map);
+
+    std::lock_guard<std::mutex> lock(values_mtx);
+    if (isFailed())
+        return;
+    for (size_t i = 0; i < hashes.size(); ++i)
+    {
+        // null never matches any row in the probe side
+        if (null_map && (*null_map)[i])
+            continue;
+        ++bloom_num_keys;
+        if (bloom_filter)
+            bloom_filter->insert(hashes[i]);
+        else
+            pending_bloom_hashes.push_back(hashes[i]);
+    }
+    if (bloom_num_keys > bloom_max_num_keys)
+    {
+        // Duplicated keys are also counted, so the rf may be failed a little earlier than necessary.
+        auto reason = fmt::format(
+            "The number of bloom filter keys {} exceeds {}, which is the limit to keep the false positive rate {} "
+            "with {} bytes",
+            bloom_num_keys,
+            bloom_max_num_keys,
+            bloom_filter_fpp,
+            bloom_filter_max_bytes);
+        if (updateStatus(RuntimeFilterStatus::FAILED, reason))
+            LOG_WARNING(log, "cancel runtime filter id:{}, reason: {} ", id, reason);
+        PaddedPODArray<UInt64>().swap(pending_bloom_hashes);
+        bloom_filter.reset();
+        return;
+    }
+    // Bound the memory of the pending hashes by the max size of the filter. The number of distinct
+    // values is still unknown, so the filter is materialized with the max size.
+    if (!bloom_filter && pending_bloom_hashes.size() * sizeof(UInt64) >= bloom_filter_max_bytes)
+        materializeBloomFilter(bloom_max_num_keys);
+}
+
+void RuntimeFilter::materializeBloomFilter(size_t ndv)
+{
+    if (bloom_filter)
+        return;
+    // The number of hashes may be larger than ndv because of duplicated keys, so the
+    // filter may be a little larger than necessary.
+    bloom_filter = std::make_unique<BlockedBloomFilter>(
+        std::min(BlockedBloomFilter::optimalNumBytes(ndv, bloom_filter_fpp), bloom_filter_max_bytes));
+    for (const auto hash : pending_bloom_hashes)
+        bloom_filter->insert(hash);
+    PaddedPODArray<UInt64>().swap(pending_bloom_hashes);
+}
+
 void RuntimeFilter::finalize(const LoggerPtr & log)
 {
+    if (rf_type == tipb::BLOOM_FILTER && !isFailed())
+    {
+        // The bloom filter must be built before the rf is marked as ready.
+        std::lock_guard<std::mutex> lock(values_mtx);
+        materializeBloomFilter(pending_bloom_hashes.size());
+    }
     if (!updateStatus(RuntimeFilterStatus::READY))
     {
         return;
@@ -126,8 +258,13 @@ void RuntimeFilter::finalize(const LoggerPtr & log)
         rf_values_info = fmt::format("number of IN values:{}", in_values_set->getTotalRowCount());
         break;
     case tipb::MIN_MAX:
+        rf_values_info = fmt::format(
+            "min:{} max:{}",
+            applyVisitor(FieldVisitorToDebugString(), min_value),
+            applyVisitor(FieldVisitorToDebugString(), max_value));
+        break;
     case tipb::BLOOM_FILTER:
-        // TODO
+        rf_values_info = fmt::format("bloom filter bytes:{}", bloom_filter->getBytes());
         break;
     }
     LOG_INFO(log, "finalize runtime filter id:{}, rf values info:{}", id, rf_values_info);
@@ -227,11 +364,51 @@ DM::RSOperatorPtr RuntimeFilter::parseToRSOperator() const
             in_values_set->getUniqueSetElements(),
             timezone_info);
     case tipb::MIN_MAX:
+        return DM::FilterParser::parseRFMinMaxExpr(target_expr, target_attr, min_value, max_value, timezone_info);
     case tipb::BLOOM_FILTER:
-        // TODO
+        // Bloom filter can not prune packs by min max index, it is applied row by row in `filterBlock`.
+        return DM::createUnsupported("bloom filter is applied on rows");
     default:
         throw Exception("Unsupported rf type");
     }
 }
 
+size_t RuntimeFilter::filterBlock(Block & block) const
+{
+    if (rf_type != tipb::BLOOM_FILTER || !bloom_filter || !target_attr || !block.has(target_attr->col_name))
+        return 0;
+    const auto & target_column = block.getByName(target_attr->col_name);
+    // The hash of a value depends on its type, skip it if the scanned type is different from the build side.
+    if (!source_type || !removeNullable(target_column.type)->equals(*removeNullable(source_type)))
+        return 0;
+
+    const size_t rows = block.rows();
+    PaddedPODArray<UInt64> hashes;
+    const NullMap * null_map = nullptr;
+    computeBloomHashes(*target_column.column, hashes, null_map);
+    IColumn::Filter filter(rows, 1);
+    bloom_filter->containsBatch(hashes.data(), rows, filter.data());
+    // Keep the null rows as they are, let the join decide whether they match.
+    if (null_map)
+    {
+        for (size_t i = 0; i < rows; ++i)
+            filter[i] |= (*null_map)[i];
+    }
+
+    const size_t passed_rows = countBytesInFilter(filter);
+    if (passed_rows == rows)
+        return 0;
+    for (auto & column : block)
+        column.column = column.column->filter(filter, passed_rows);
+    return rows - passed_rows;
+}
+
+bool RuntimeFilter::isMinMaxSupportType(const DataTypePtr & type)
+{
+    // Only the types whose order is the same as the order of their Fields are supported,
+    // string types are excluded because of collation.
+    const auto nested_type = removeNullable(type);
+    return (nested_type->isValueRepresentedByNumber() && !nested_type->isEnum()) || nested_type->isDecimal();
+}
+
 } // namespace DB
@@ -15,6 +15,7 @@
 #pragma once
 
 #include <Columns/IColumn.h>
+#include <Common/BlockedBloomFilter.h>
 #include <Interpreters/Set.h>
 #include <Storages/DeltaMerge/DeltaMergeDefines.h>
 #include <Storages/DeltaMerge/Filter/RSOperator_fwd.h>
@@ -61,6 +62,12 @@ public:
 
     void setINValuesSet(const std::shared_ptr<Set> & in_values_set_);
 
+    void setBloomFilterParams(
+        const DataTypePtr & source_type_,
+        const TiDB::TiDBCollatorPtr & collator_,
+        size_t max_bytes,
+        double false_positive_rate);
+
     void setTimezoneInfo(const TimezoneInfo & timezone_info_);
 
     void build();
@@ -80,11 +87,30 @@ public:
     void setTargetAttr(const TiDB::ColumnInfos & scan_column_infos, const DM::ColumnDefines & table_column_defines);
     DM::RSOperatorPtr parseToRSOperator() const;
 
+    // Whether this rf should be applied row by row to the blocks read from the table scan.
+    // Only bloom filter can not be pushed down as a rough set filter.
+    bool isRowFilter() const { return rf_type == tipb::BLOOM_FILTER; }
+
+    // Remove the rows in `block` whose target column value is definitely not in the build side.
+    // Only valid after the rf is ready. Return the number of rows removed.
+    size_t filterBlock(Block & block) const;
+
+    static bool isMinMaxSupportType(const DataTypePtr & type);
+
     const int id;
 
 private:
     bool updateStatus(RuntimeFilterStatus status_, const std::string & reason = "");
 
+    void updateMinMaxValues(const ColumnPtr & column);
+    void updateBloomFilterValues(const ColumnPtr & column, const LoggerPtr & log);
+    void materializeBloomFilter(size_t ndv);
+
+    // Compute the hash of the non-null rows in `column`. `null_map` will point to the null map
+    // of `column` if it is nullable, the hashes of null rows are meaningless.
+    void computeBloomHashes(const IColumn & column, PaddedPODArray<UInt64> & hashes, const NullMap *& null_map)
+        const;
+
     tipb::Expr source_expr;
     tipb::Expr target_expr;
     std::optional<DM::Attr> target_attr;
@@ -101,7 +127,25 @@ private:
     // only used for In predicate
     // thread safe
     SetPtr in_values_set;
-    // todo min max
+
+    // used for min max and bloom filter
+    std::mutex values_mtx;
+    // only used for min max predicate, both are Null if there is no value in the build side
+    Field min_value;
+    Field max_value;
+    // only used for bloom filter
+    // The hashes are buffered before the number of distinct values is known. Once the buffer
+    // takes `bloom_filter_max_bytes`, a filter of `bloom_filter_max_bytes` will be materialized
+    // and the following hashes will be inserted into it directly. If more than `bloom_max_num_keys`
+    // keys are inserted, the filter can not keep the false positive rate and the rf is failed.
+    DataTypePtr source_type;
+    TiDB::TiDBCollatorPtr collator = nullptr;
+    size_t bloom_filter_max_bytes = 0;
+    double bloom_filter_fpp = 0.01;
+    size_t bloom_max_num_keys = 0;
+    size_t bloom_num_keys = 0;
+    PaddedPODArray<UInt64> pending_bloom_hashes;
+    std::unique_ptr<BlockedBloomFilter> bloom_filter;
 
     // used for await or signal
     std::mutex inner_mutex;
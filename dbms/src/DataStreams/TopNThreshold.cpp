@@ -0,0 +1,127 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Columns/ColumnNullable.h>
+#include <Columns/countBytesInFilter.h>
+#include <DataStreams/RuntimeFilter.h>
+#include <DataStreams/TopNThreshold.h>
+#include <DataTypes/DataTypeNullable.h>
+#include <Storages/DeltaMerge/FilterParser/FilterParser.h>
+#include <TiDB/Schema/TiDB.h>
+
+namespace DB
+{
+TopNThreshold::TopNThreshold(
+    const tipb::Expr & target_expr_,
+    const String & column_name_,
+    const DataTypePtr & type_,
+    int direction_,
+    int nulls_direction_,
+    const TimezoneInfo & timezone_info_)
+    : target_expr(target_expr_)
+    , column_name(column_name_)
+    , type(type_)
+    , direction(direction_)
+    , nulls_direction(nulls_direction_)
+    , timezone_info(timezone_info_)
+{}
+
+void TopNThreshold::update(const Field & value)
+{
+    // Null values are ordered by `nulls_direction`, they can not be compared with the min max index.
+    if (value.isNull())
+        return;
+    std::lock_guard lock(mtx);
+    if (!threshold.isNull() && (direction > 0 ? !(value < threshold) : !(threshold < value)))
+        return;
+    threshold = value;
+    has_threshold.store(true, std::memory_order_release);
+}
+
+Field TopNThreshold::getThreshold() const
+{
+    std::lock_guard lock(mtx);
+    return threshold;
+}
+
+void TopNThreshold::setTargetAttr(
+    const TiDB::ColumnInfos & scan_column_infos,
+    const DM::ColumnDefines & table_column_defines)
+{
+    target_attr = DM::FilterParser::createAttr(target_expr, scan_column_infos, table_column_defines);
+}
+
+DM::RSOperatorPtr TopNThreshold::parseToRSOperator() const
+{
+    if (!hasThreshold())
+        return nullptr;
+    // Note that the threshold comes from the blocks of the TopN (after timezone casted).
+    return DM::FilterParser::parseTopNThresholdExpr(
+        target_expr,
+        target_attr,
+        getThreshold(),
+        direction > 0,
+        nullsFirst(),
+        timezone_info);
+}
+
+size_t TopNThreshold::filterBlock(Block & block) const
+{
+    if (!hasThreshold() || !target_attr || !block.has(target_attr->col_name))
+        return 0;
+    // The blocks read from the table scan are not casted to the timezone of the request yet.
+    if (target_expr.field_type().tp() == TiDB::TypeTimestamp && !timezone_info.is_utc_timezone)
+        return 0;
+    const auto & target_column = block.getByName(target_attr->col_name);
+    const auto nested_type = removeNullable(type);
+    if (!removeNullable(target_column.type)->equals(*nested_type))
+        return 0;
+
+    auto threshold_column = nested_type->createColumn();
+    threshold_column->insert(getThreshold());
+    const IColumn * column = target_column.column.get();
+    const NullMap * null_map = nullptr;
+    if (const auto * nullable_column = typeid_cast<const ColumnNullable *>(column))
+    {
+        column = &nullable_column->getNestedColumn();
+        null_map = &nullable_column->getNullMapData();
+    }
+
+    const size_t rows = block.rows();
+    IColumn::Filter filter(rows);
+    // The null rows are before the threshold only if nulls are ordered first.
+    const UInt8 null_passed = nullsFirst();
+    for (size_t i = 0; i < rows; ++i)
+    {
+        if (null_map && (*null_map)[i])
+            filter[i] = null_passed;
+        else
+            filter[i] = direction * column->compareAt(i, 0, *threshold_column, nulls_direction) <= 0;
+    }
+
+    const size_t passed_rows = countBytesInFilter(filter);
+    if (passed_rows == rows)
+        return 0;
+    for (auto & col : block)
+        col.column = col.column->filter(filter, passed_rows);
+    return rows - passed_rows;
+}
+
+bool TopNThreshold::isSupportType(const DataTypePtr & type)
+{
+    // The threshold is compared with the min max index and the rows by the order of Fields.
+    return RuntimeFilter::isMinMaxSupportType(type);
+}
+
+} // namespace DB
@@ -0,0 +1,89 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Core/Block.h>
+#include <Core/Field.h>
+#include <DataStreams/TopNThreshold_fwd.h>
+#include <Interpreters/TimezoneInfo.h>
+#include <Storages/DeltaMerge/DeltaMergeDefines.h>
+#include <Storages/DeltaMerge/Filter/RSOperator_fwd.h>
+#include <tipb/expression.pb.h>
+
+#include <atomic>
+#include <mutex>
+#include <optional>
+
+namespace DB
+{
+/// The boundary of the rows that can still enter the result of a TopN.
+///
+/// When the first order by item of a TopN is a column read by the table scan under it, the TopN operators
+/// publish the value of the first sort column of their k-th rows here. A row ordered after the boundary by
+/// the first sort column can not enter the result any more, so the table scan skips the packs whose rows are
+/// all after the boundary, and removes such rows from the blocks it reads.
+///
+/// The boundary only becomes tighter, so it is always safe to apply the boundary seen at any moment.
+class TopNThreshold
+{
+public:
+    TopNThreshold(
+        const tipb::Expr & target_expr_,
+        const String & column_name_,
+        const DataTypePtr & type_,
+        int direction_,
+        int nulls_direction_,
+        const TimezoneInfo & timezone_info_);
+
+    /// The name of the first sort column in the blocks of the TopN.
+    const String & getColumnName() const { return column_name; }
+
+    /// Called by the TopN operators with the value of the first sort column of their k-th rows.
+    void update(const Field & value);
+
+    bool hasThreshold() const { return has_threshold.load(std::memory_order_acquire); }
+
+    /// Null if there is no threshold yet.
+    Field getThreshold() const;
+
+    void setTargetAttr(const TiDB::ColumnInfos & scan_column_infos, const DM::ColumnDefines & table_column_defines);
+
+    /// Return nullptr if there is no threshold yet.
+    DM::RSOperatorPtr parseToRSOperator() const;
+
+    /// Remove the rows in `block` ordered after the threshold by the target column.
+    /// Return the number of rows removed.
+    size_t filterBlock(Block & block) const;
+
+    static bool isSupportType(const DataTypePtr & type);
+
+private:
+    bool nullsFirst() const { return direction * nulls_direction < 0; }
+
+    const tipb::Expr target_expr;
+    const String column_name;
+    const DataTypePtr type;
+    // 1 for ascending, -1 for descending, the same as `SortColumnDescription`.
+    const int direction;
+    const int nulls_direction;
+    const TimezoneInfo timezone_info;
+    std::optional<DM::Attr> target_attr;
+
+    mutable std::mutex mtx;
+    Field threshold;
+    std::atomic_bool has_threshold = false;
+};
+
+} // namespace DB
@@ -30,7 +30,7 @@ void MockRuntimeFilter::toPB(
     astToPB(target_schema, target_expr, target_expr_pb, collator_id, context);
     rf->set_source_executor_id(source_executor_id);
     rf->set_target_executor_id(target_executor_id);
-    rf->set_rf_type(tipb::IN);
+    rf->set_rf_type(rf_type);
     rf->set_rf_mode(tipb::LOCAL);
 }
 } // namespace DB::mock
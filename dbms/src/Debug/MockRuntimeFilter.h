@@ -28,12 +28,14 @@ public:
         ASTPtr source_expr_,
         ASTPtr target_expr_,
         const std::string & source_executor_id_,
-        const std::string & target_executor_id_)
+        const std::string & target_executor_id_,
+        tipb::RuntimeFilterType rf_type_ = tipb::IN)
         : id(id_)
         , source_expr(source_expr_)
         , target_expr(target_expr_)
         , source_executor_id(source_executor_id_)
         , target_executor_id(target_executor_id_)
+        , rf_type(rf_type_)
     {}
     void toPB(
         const DAGSchema & source_schema,
@@ -48,5 +50,6 @@ private:
     ASTPtr target_expr;
     std::string source_executor_id;
     std::string target_executor_id;
+    tipb::RuntimeFilterType rf_type;
 };
 } // namespace DB::mock
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <Common/Exception.h>
 #include <Flash/Coprocessor/CHBlockChunkCodecV1.h>
 #include <Flash/Coprocessor/ChunkDecodeAndSquash.h>
 #include <IO/Buffer/ReadBufferFromString.h>
@@ -85,6 +86,56 @@ std::optional<Block> CHBlockChunkDecodeAndSquash::decodeAndSquashV1Impl(ReadBuff
     return res;
 }
 
+std::optional<Block> CHBlockChunkDecodeAndSquash::squash(Block && block)
+{
+    std::optional<Block> res;
+    const size_t rows = block.rows();
+    if (!rows)
+        return res;
+
+    /// The names of the sender are different from the local header, only the types are checked.
+    const auto & header = codec.header;
+    RUNTIME_CHECK_MSG(
+        block.columns() == header.columns(),
+        "Local block structure mismatch, block: {}, header: {}",
+        block.dumpStructure(),
+        header.dumpStructure());
+    for (size_t i = 0; i < header.columns(); ++i)
+    {
+        RUNTIME_CHECK_MSG(
+            block.getByPosition(i).type->equals(*header.getByPosition(i).type),
+            "Local block structure mismatch, block: {}, header: {}",
+            block.dumpStructure(),
+            header.dumpStructure());
+    }
+
+    if (!accumulated_block)
+    {
+        /// Take the columns away from `block`, so that they are not shared and can be appended without copying.
+        Columns columns;
+        columns.reserve(block.columns());
+        for (auto & column : block)
+            columns.push_back(std::move(column.column));
+        /// Respect the names and types of local header
+        accumulated_block.emplace(codec.header.cloneWithColumns(std::move(columns)));
+    }
+    else
+    {
+        auto mutable_columns = accumulated_block->mutateColumns();
+        for (size_t i = 0; i < mutable_columns.size(); ++i)
+            mutable_columns[i]->insertRangeFrom(*block.getByPosition(i).column, 0, rows);
+        accumulated_block->setColumns(std::move(mutable_columns));
+    }
+
+    if (accumulated_block->rows() >= rows_limit)
+    {
+        /// Return accumulated data and reset accumulated_block
+        res.swap(accumulated_block);
+        return res;
+    }
+    return res;
+}
+
 std::optional<Block> CHBlockChunkDecodeAndSquash::decodeAndSquash(const String & str)
 {
     auto block = doDecodeAndSquash(str);
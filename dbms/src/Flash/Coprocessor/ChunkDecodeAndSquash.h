@@ -28,6 +28,8 @@ public:
     ~CHBlockChunkDecodeAndSquash() = default;
     std::optional<Block> decodeAndSquash(const String &);
     std::optional<Block> decodeAndSquashV1(std::string_view);
+    // Squash the block received from local tunnel, which is not serialized.
+    std::optional<Block> squash(Block && block);
     std::optional<Block> flush();
 
 private:
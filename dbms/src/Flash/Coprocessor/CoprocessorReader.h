@@ -21,6 +21,8 @@
 #include <Flash/Coprocessor/ChunkDecodeAndSquash.h>
 #include <Flash/Coprocessor/DecodeDetail.h>
 #include <Flash/Coprocessor/DefaultChunkCodec.h>
+#include <Flash/Pipeline/Schedule/Tasks/NotifyFuture.h>
+#include <Flash/Pipeline/Schedule/Tasks/PipeConditionVariable.h>
 #include <Flash/Statistics/ConnectionProfileInfo.h>
 #include <common/logger_useful.h>
 
@@ -52,7 +54,10 @@ public:
 
     MPMCQueueResult tryPush(T && t) override
     {
-        switch (queue.tryPush(std::move(t)))
+        auto res = queue.tryPush(std::move(t));
+        if (res == DB::MPMCQueueResult::OK)
+            notifyOneReader();
+        switch (res)
         {
         case DB::MPMCQueueResult::OK:
             return MPMCQueueResult::OK;
@@ -69,7 +74,10 @@ public:
 
     MPMCQueueResult push(T && t) override
     {
-        switch (queue.push(std::move(t)))
+        auto res = queue.push(std::move(t));
+        if (res == DB::MPMCQueueResult::OK)
+            notifyOneReader();
+        switch (res)
         {
         case DB::MPMCQueueResult::OK:
             return MPMCQueueResult::OK;
@@ -114,12 +122,55 @@ public:
         }
     }
 
-    bool cancel() override { return queue.cancel(); }
+    bool cancel() override
+    {
+        auto ret = queue.cancel();
+        notifyAllReaders();
+        return ret;
+    }
+
+    bool finish() override
+    {
+        auto ret = queue.finish();
+        notifyAllReaders();
+        return ret;
+    }
+
+    /// Park the pipeline task until a result is pushed or the queue is finished/cancelled.
+    void registerPipeReadTask(DB::TaskPtr && task, DB::NotifyType type)
+    {
+        {
+            std::lock_guard lock(pipe_mu);
+            if (queue.size() == 0 && queue.getStatus() == DB::MPMCQueueStatus::NORMAL)
+            {
+                task->setNotifyType(type);
+                pipe_reader_cv.registerTask(std::move(task));
+                return;
+            }
+        }
+        DB::PipeConditionVariable::notifyTaskDirectly(std::move(task));
+    }
 
-    bool finish() override { return queue.finish(); }
+private:
+    /// `queue` changes its state under its own mutex, so `pipe_mu` is taken both for registering and notifying
+    /// to make sure a task registered after checking the queue can not miss the notification.
+    void notifyOneReader()
+    {
+        std::lock_guard lock(pipe_mu);
+        pipe_reader_cv.notifyOne();
+    }
+
+    void notifyAllReaders()
+    {
+        std::lock_guard lock(pipe_mu);
+        pipe_reader_cv.notifyAll();
+    }
 
 private:
     DB::MPMCQueue<T> queue;
+
+    std::mutex pipe_mu;
+    DB::PipeConditionVariable pipe_reader_cv;
 };
 
 } // namespace common
@@ -157,7 +208,8 @@ struct CoprocessorReaderResult
 
 /// This is an adapter for pingcap::coprocessor::ResponseIter, so it can be used in TiRemoteBlockInputStream
 /// Note that CoprocessorReader may be used concurrently.
-class CoprocessorReader
+/// It is also a NotifyFuture, pipeline tasks waiting for the next response are notified when the response arrives.
+class CoprocessorReader : public NotifyFuture
 {
 public:
     static constexpr bool is_streaming_reader = false;
@@ -173,6 +225,8 @@ private:
     const bool has_enforce_encode_type;
     const size_t concurrency;
     const bool enable_cop_stream;
+    /// Owned by `resp_iter`.
+    CopIterQueue * resp_queue = nullptr;
     pingcap::coprocessor::ResponseIter resp_iter;
 
 public:
@@ -194,7 +248,11 @@ public:
         , concurrency(concurrency_)
         , enable_cop_stream(enable_cop_stream_)
         , resp_iter(
-              std::make_unique<CopIterQueue>(queue_size),
+              [&] {
+                  auto queue = std::make_unique<CopIterQueue>(queue_size);
+                  resp_queue = queue.get();
+                  return queue;
+              }(),
               std::move(tasks),
               cluster,
               concurrency_,
@@ -267,6 +325,11 @@ public:
         return resp_iter.nonBlockingNext();
     }
 
+    void registerTask(TaskPtr && task) override
+    {
+        resp_queue->registerPipeReadTask(std::move(task), NotifyType::WAIT_ON_GRPC_RECV_READ);
+    }
+
     CoprocessorReaderResult toResult(
         std::pair<pingcap::coprocessor::ResponseIter::Result, bool> & result_pair,
         std::queue<Block> & block_queue,
@@ -32,6 +32,7 @@
 #include <Core/TaskOperatorSpillContexts.h>
 #include <DataStreams/BlockIO.h>
 #include <DataStreams/IBlockInputStream.h>
+#include <DataStreams/TopNThreshold_fwd.h>
 #include <Flash/Coprocessor/ColumnarScanContext_fwd.h>
 #include <Flash/Coprocessor/DAGRequest.h>
 #include <Flash/Coprocessor/FineGrainedShuffle.h>
@@ -478,6 +479,9 @@ public:
 
     RuntimeFilterMgr runtime_filter_mgr;
 
+    /// table scan executor_id, the threshold published by the TopN above the table scan.
+    std::unordered_map<String, TopNThresholdPtr> topn_threshold_map;
+
 private:
     void initExecutorIdToJoinIdMap();
     void initOutputInfo();
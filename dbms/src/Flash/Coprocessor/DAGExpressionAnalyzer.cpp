@@ -1444,7 +1444,7 @@ String DAGExpressionAnalyzer::appendNullAwareSemiJoinEqColumn(
                                      : applyFunction("and", and_arg_names, last_step.actions, nullptr);
 }
 
-void DAGExpressionAnalyzer::appendRuntimeFilterProperties(RuntimeFilterPtr & runtime_filter)
+bool DAGExpressionAnalyzer::appendRuntimeFilterProperties(RuntimeFilterPtr & runtime_filter, const LoggerPtr & log)
 {
     NameAndTypePair name_and_type;
     name_and_type = getColumnNameAndTypeForColumnExpr(runtime_filter->getSourceExpr(), getCurrentInputColumns());
@@ -1464,10 +1464,32 @@ void DAGExpressionAnalyzer::appendRuntimeFilterProperties(RuntimeFilterPtr & run
         runtime_filter->setTimezoneInfo(context.getTimezoneInfo());
         break;
     case tipb::MIN_MAX:
+        if (!RuntimeFilter::isMinMaxSupportType(name_and_type.type))
+        {
+            runtime_filter->cancel(
+                log,
+                fmt::format("The min max rf doesn't support source column type:{}", name_and_type.type->getName()));
+            return false;
+        }
+        runtime_filter->setTimezoneInfo(context.getTimezoneInfo());
+        break;
     case tipb::BLOOM_FILTER:
-        // todo
+        // The values of timestamp column in the table scan are in UTC, which can not be
+        // compared with the hashes of the build side values.
+        if (runtime_filter->getSourceExpr().field_type().tp() == TiDB::TypeTimestamp
+            && !context.getTimezoneInfo().is_utc_timezone)
+        {
+            runtime_filter->cancel(log, "The bloom filter rf doesn't support timestamp column with non-UTC timezone");
+            return false;
+        }
+        runtime_filter->setBloomFilterParams(
+            name_and_type.type,
+            getCollatorFromExpr(runtime_filter->getSourceExpr()),
+            settings.rf_max_bloom_filter_bytes,
+            settings.rf_bloom_filter_false_positive_rate);
         break;
     }
+    return true;
 }
 
 void DAGExpressionAnalyzer::appendCastAfterWindow(
@@ -130,7 +130,9 @@ public:
         const Names & build_key_names,
         const TiDB::TiDBCollators & collators);
 
-    void appendRuntimeFilterProperties(RuntimeFilterPtr & runtime_filter);
+    // Return false and cancel the rf if the source column is not supported by the rf type,
+    // the rf is only an optimization so the query runs without it.
+    bool appendRuntimeFilterProperties(RuntimeFilterPtr & runtime_filter, const LoggerPtr & log);
 
     void appendSourceColumnsToRequireOutput(ExpressionActionsChain::Step & step) const;
 
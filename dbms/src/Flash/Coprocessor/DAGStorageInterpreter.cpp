@@ -934,6 +934,9 @@ std::unordered_map<TableID, SelectQueryInfo> DAGStorageInterpreter::generateSele
         query_info.req_id = fmt::format("{} table_id={}", log->identifier(), table_id);
         query_info.keep_order = table_scan.keepOrder();
         query_info.is_fast_scan = table_scan.isFastScan();
+        if (auto it = dagContext().topn_threshold_map.find(table_scan.getTableScanExecutorID());
+            it != dagContext().topn_threshold_map.end())
+            query_info.topn_threshold = it->second;
         return query_info;
     };
     RUNTIME_CHECK_MSG(mvcc_query_info->scan_context != nullptr, "Unexpected null scan_context");
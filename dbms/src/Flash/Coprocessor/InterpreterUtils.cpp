@@ -35,6 +35,7 @@
 #include <Operators/MergeSortTransformOp.h>
 #include <Operators/PartialSortTransformOp.h>
 #include <Operators/SharedQueue.h>
+#include <Operators/TopNTransformOp.h>
 
 namespace DB
 {
@@ -332,6 +333,40 @@ void executeLocalSort(
     }
 }
 
+void executeLocalTopN(
+    PipelineExecutorContext & exec_context,
+    PipelineExecGroupBuilder & group_builder,
+    const SortDescription & order_descr,
+    size_t limit,
+    const TopNThresholdPtr & topn_threshold,
+    const Context & context,
+    const LoggerPtr & log)
+{
+    auto input_header = group_builder.getCurrentHeader();
+    if (SortHelper::isSortByConstants(input_header, order_descr))
+    {
+        // For order by const col, we will generate LimitOperator directly.
+        group_builder.transform([&](auto & builder) {
+            auto local_limit = std::make_shared<LocalLimitTransformAction>(input_header, limit);
+            builder.appendTransformOp(
+                std::make_unique<LimitTransformOp<LocalLimitPtr>>(exec_context, log->identifier(), local_limit));
+        });
+    }
+    else
+    {
+        const size_t max_block_size = context.getSettingsRef().max_block_size;
+        group_builder.transform([&](auto & builder) {
+            builder.appendTransformOp(std::make_unique<TopNTransformOp>(
+                exec_context,
+                log->identifier(),
+                order_descr,
+                limit,
+                max_block_size,
+                topn_threshold));
+        });
+    }
+}
+
 void executeFinalSort(
     PipelineExecutorContext & exec_context,
     PipelineExecGroupBuilder & group_builder,
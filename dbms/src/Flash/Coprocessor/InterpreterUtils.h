@@ -16,6 +16,7 @@
 
 #include <Common/Logger.h>
 #include <Core/SortDescription.h>
+#include <DataStreams/TopNThreshold_fwd.h>
 #include <Flash/Coprocessor/DAGExpressionAnalyzer.h>
 #include <Flash/Coprocessor/DAGPipeline.h>
 #include <Flash/Coprocessor/FilterConditions.h>
@@ -86,6 +87,16 @@ void executeLocalSort(
     const Context & context,
     const LoggerPtr & log);
 
+// Like `executeLocalSort` with a limit, but keep the first `limit` rows in a bounded heap instead of sorting all rows.
+void executeLocalTopN(
+    PipelineExecutorContext & exec_context,
+    PipelineExecGroupBuilder & group_builder,
+    const SortDescription & order_descr,
+    size_t limit,
+    const TopNThresholdPtr & topn_threshold,
+    const Context & context,
+    const LoggerPtr & log);
+
 void executeFinalSort(
     PipelineExecutorContext & exec_context,
     PipelineExecGroupBuilder & group_builder,
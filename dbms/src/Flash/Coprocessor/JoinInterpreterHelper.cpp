@@ -428,7 +428,14 @@ std::vector<RuntimeFilterPtr> TiFlashJoin::genRuntimeFilterList(
         try
         {
             runtime_filter->build();
-            dag_analyzer.appendRuntimeFilterProperties(runtime_filter);
+            if (!dag_analyzer.appendRuntimeFilterProperties(runtime_filter, log))
+            {
+                LOG_WARNING(
+                    log,
+                    "The runtime filter will not be register, reason:{}",
+                    runtime_filter->getFailedReason());
+                continue;
+            }
             /// update the source column name to use the join key as source column
             const auto & updated_key_name_it = key_names_map.find(runtime_filter->getSourceColumnName());
             RUNTIME_CHECK_MSG(
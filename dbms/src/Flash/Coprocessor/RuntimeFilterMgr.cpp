@@ -40,4 +40,26 @@ void RuntimeFilterMgr::registerRuntimeFilterList(std::vector<RuntimeFilterPtr> &
     }
 }
 
+RuntimeFilterList RuntimeFilterMgr::getRowFilterList(const RuntimeFilterList & rf_list)
+{
+    RuntimeFilterList result;
+    for (const auto & rf : rf_list)
+    {
+        if (rf->isRowFilter())
+            result.push_back(rf);
+    }
+    return result;
+}
+
+void RuntimeFilterMgr::applyRowFilters(const RuntimeFilterList & rf_list, Block & block)
+{
+    for (const auto & rf : rf_list)
+    {
+        if (block.rows() == 0)
+            return;
+        if (rf->isReady())
+            rf->filterBlock(block);
+    }
+}
+
 } // namespace DB
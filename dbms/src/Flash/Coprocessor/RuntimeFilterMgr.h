@@ -38,6 +38,12 @@ public:
 
     void registerRuntimeFilterList(std::vector<RuntimeFilterPtr> & rfList);
 
+    // Get the rfs that should be applied on the rows read from the storage.
+    static RuntimeFilterList getRowFilterList(const RuntimeFilterList & rf_list);
+
+    // Apply the ready rfs in `rf_list` on `block`, the rfs not ready yet are skipped.
+    static void applyRowFilters(const RuntimeFilterList & rf_list, Block & block);
+
 private:
     // Local rf id -> runtime filter ref
     std::unordered_map<int, RuntimeFilterPtr> local_runtime_filter_map;
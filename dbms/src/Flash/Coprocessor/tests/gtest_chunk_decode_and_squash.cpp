@@ -17,6 +17,8 @@
 #include <Flash/Coprocessor/CHBlockChunkCodec.h>
 #include <Flash/Coprocessor/CHBlockChunkCodecV1.h>
 #include <Flash/Coprocessor/ChunkDecodeAndSquash.h>
+#include <Flash/Mpp/ReceivedMessage.h>
+#include <Flash/Mpp/TrackedMppDataPacket.h>
 #include <TestUtils/ColumnGenerator.h>
 #include <TestUtils/FunctionTestUtils.h>
 #include <TestUtils/TiFlashTestBasic.h>
@@ -168,5 +170,97 @@ try
 }
 CATCH
 
+TEST_F(TestChunkDecodeAndSquash, testSquashLocalBlocks)
+try
+{
+    const size_t rows_limit = 100;
+    std::vector<Block> blocks;
+    for (size_t rows : {30, 0, 50, 40, 10})
+        blocks.push_back(prepareBlock(rows));
+    std::vector<Block> reference_blocks = blocks;
+
+    Block header = prepareBlock(0);
+    CHBlockChunkDecodeAndSquash decoder(header, rows_limit);
+    std::vector<Block> squashed_blocks;
+    for (auto & block : blocks)
+    {
+        auto result = decoder.squash(std::move(block));
+        if (result)
+        {
+            ASSERT_EQ(result->rows(), 120);
+            squashed_blocks.push_back(std::move(*result));
+        }
+    }
+    ASSERT_EQ(squashed_blocks.size(), 1);
+    auto last_block = decoder.flush();
+    ASSERT_TRUE(last_block);
+    ASSERT_EQ(last_block->rows(), 10);
+    squashed_blocks.push_back(std::move(*last_block));
+    ASSERT_BLOCK_EQ(squashBlocks(reference_blocks), squashBlocks(squashed_blocks));
+
+    // The blocks whose structure is different from the header are refused.
+    Block fewer_columns = prepareBlock(10);
+    fewer_columns.erase(0);
+    ASSERT_THROW(decoder.squash(std::move(fewer_columns)), Exception);
+    Block other_types = prepareBlock(10);
+    other_types.getByPosition(0) = createColumn<Nullable<Int64>>({1, 2, 3, 4, 5, 6, 7, 8, 9, 10}, "col0");
+    ASSERT_THROW(decoder.squash(std::move(other_types)), Exception);
+}
+CATCH
+
+TEST_F(TestChunkDecodeAndSquash, testReceiveLocalBlocks)
+try
+{
+    Block header = prepareBlock(0);
+    const size_t stream_count = 2;
+    // Fine grained shuffle: the blocks are dispatched to the receiver streams by their stream ids.
+    {
+        auto packet = std::make_shared<TrackedMppDataPacket>(MPPDataPacketV1);
+        std::vector<Blocks> sent_blocks(stream_count);
+        for (UInt64 stream_id = 0; stream_id < 4; ++stream_id)
+        {
+            auto block = prepareBlock(10 + stream_id);
+            sent_blocks[stream_id % stream_count].push_back(block);
+            packet->addLocalBlock(std::move(block), stream_id);
+        }
+        ReceivedMessage msg(0, "", packet, nullptr, nullptr, {}, stream_count);
+        ASSERT_TRUE(msg.containUsefulMessage());
+        for (size_t stream_id = 0; stream_id < stream_count; ++stream_id)
+        {
+            const auto & blocks = msg.getBlocks(stream_id);
+            ASSERT_EQ(blocks.size(), 2);
+            CHBlockChunkDecodeAndSquash decoder(header, 1000);
+            for (auto * block : blocks)
+                ASSERT_FALSE(decoder.squash(std::move(*block)));
+            auto result = decoder.flush();
+            ASSERT_TRUE(result);
+            ASSERT_BLOCK_EQ(vstackBlocks(std::move(sent_blocks[stream_id])), *result);
+        }
+    }
+    // Broadcast: every receiver gets a copy of the packet, the columns are shared by the copies and
+    // must not be changed when a receiver appends to them.
+    {
+        auto packet = std::make_shared<TrackedMppDataPacket>(MPPDataPacketV1);
+        Blocks sent_blocks{prepareBlock(10), prepareBlock(20)};
+        for (const auto & block : sent_blocks)
+            packet->addLocalBlock(Block(block));
+        const Block reference_block = vstackBlocks(Blocks(sent_blocks));
+        for (size_t receiver = 0; receiver < 2; ++receiver)
+        {
+            ReceivedMessage msg(0, "", packet->copy(), nullptr, nullptr, {}, 0);
+            CHBlockChunkDecodeAndSquash decoder(header, 1000);
+            for (auto * block : msg.getBlocks(0))
+                ASSERT_FALSE(decoder.squash(std::move(*block)));
+            auto result = decoder.flush();
+            ASSERT_TRUE(result);
+            ASSERT_BLOCK_EQ(reference_block, *result);
+        }
+        ASSERT_EQ(packet->local_blocks[0].rows(), 10);
+        ASSERT_EQ(packet->local_blocks[1].rows(), 20);
+        ASSERT_BLOCK_EQ(packet->local_blocks[0], sent_blocks[0]);
+    }
+}
+CATCH
+
 } // namespace tests
 } // namespace DB
@@ -352,6 +352,9 @@ void EstablishCallData::trySendOneMsg()
         // set state back to original_state so we can use setCallStateAndUpdateMetrics later
         state = original_state;
         async_tunnel_sender->subDataSizeMetric(packet->getPacket().ByteSizeLong());
+        // The packet is popped only after the previous write is done, so the time of waiting for the previous write
+        // is counted as the send cost of this packet.
+        async_tunnel_sender->recordSendCost(packet);
         /// Note: has to switch the memory tracker before `write`
         /// because after `write`, `async_tunnel_sender` can be destroyed at any time
         /// so there is a risk that `res` is destructed after `aysnc_tunnel_sender`
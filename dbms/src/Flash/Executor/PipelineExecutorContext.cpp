@@ -196,6 +196,9 @@ void PipelineExecutorContext::cancel()
 
             if (auto mpp_receiver_set = dag_context->getMPPReceiverSet(); mpp_receiver_set)
                 mpp_receiver_set->cancel();
+            else
+                for (const auto & coprocessor_reader : dag_context->getCoprocessorReaders())
+                    coprocessor_reader->cancel();
         }
         cancelResultQueueIfNeed();
         if likely (TaskScheduler::instance && !query_id.empty())
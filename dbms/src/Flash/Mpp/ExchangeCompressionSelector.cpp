@@ -0,0 +1,169 @@
+// Copyright 2024 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/Exception.h>
+#include <Flash/Mpp/ExchangeCompressionSelector.h>
+
+#include <algorithm>
+#include <limits>
+#include <optional>
+
+namespace DB
+{
+namespace
+{
+// Weight of the newest sample in the moving averages.
+constexpr double sample_weight = 0.25;
+
+// The baseline cost of sending one byte, about 1GB/s for inner-zone tunnels and 125MB/s for inter-zone tunnels.
+double baselineSendNsPerByte(ConnectionProfileInfo::ConnectionType type)
+{
+    switch (type)
+    {
+    case ConnectionProfileInfo::InnerZoneRemote:
+        return 1.0;
+    case ConnectionProfileInfo::InterZoneRemote:
+        return 8.0;
+    default:
+        return 0.0;
+    }
+}
+
+size_t candidateNum(CompressionMethod max_method)
+{
+    switch (max_method)
+    {
+    case CompressionMethod::LZ4:
+        return 2;
+    case CompressionMethod::ZSTD:
+        return 3;
+    default:
+        return 0;
+    }
+}
+
+CompressionMethod indexToMethod(size_t index)
+{
+    static constexpr CompressionMethod methods[] = {
+        CompressionMethod::NONE,
+        CompressionMethod::LZ4,
+        CompressionMethod::ZSTD,
+    };
+    return methods[index];
+}
+
+std::optional<size_t> methodToIndex(CompressionMethod method)
+{
+    switch (method)
+    {
+    case CompressionMethod::NONE:
+        return 0;
+    case CompressionMethod::LZ4:
+        return 1;
+    case CompressionMethod::ZSTD:
+        return 2;
+    default:
+        return std::nullopt;
+    }
+}
+
+void updateAverage(double & avg, double sample, UInt64 prev_samples)
+{
+    if (prev_samples == 0)
+        avg = sample;
+    else
+        avg += sample_weight * (sample - avg);
+}
+} // namespace
+
+ExchangeCompressionSelector::ExchangeCompressionSelector(
+    std::vector<ConnectionProfileInfo::ConnectionType> && conn_types)
+    : tunnels(conn_types.size())
+{
+    for (size_t i = 0; i < conn_types.size(); ++i)
+        tunnels[i].min_send_ns_per_byte = baselineSendNsPerByte(conn_types[i]);
+}
+
+CompressionMethod ExchangeCompressionSelector::choose(size_t tunnel_index, CompressionMethod max_method)
+{
+    const size_t candidate_num = candidateNum(max_method);
+    // Only NONE/LZ4/ZSTD are adaptive, other methods are used as they are.
+    if (candidate_num == 0)
+        return max_method;
+
+    RUNTIME_CHECK(tunnel_index < tunnels.size(), tunnel_index, tunnels.size());
+    auto & tunnel = tunnels[tunnel_index];
+    ++tunnel.packets;
+
+    // Try every candidate at least once before estimating.
+    for (size_t i = 0; i < candidate_num; ++i)
+    {
+        if (tunnel.methods[i].samples == 0)
+            return indexToMethod(i);
+    }
+
+    const double send_ns_per_byte = std::max(tunnel.send_ns_per_byte, tunnel.min_send_ns_per_byte);
+    size_t best = 0;
+    double best_cost = std::numeric_limits<double>::max();
+    for (size_t i = 0; i < candidate_num; ++i)
+    {
+        const auto & stat = tunnel.methods[i];
+        const double cost = stat.encode_ns_per_byte + stat.ratio * send_ns_per_byte;
+        if (cost < best_cost)
+        {
+            best = i;
+            best_cost = cost;
+        }
+    }
+
+    if (tunnel.packets % probe_interval == 0)
+    {
+        tunnel.probe_cursor = (tunnel.probe_cursor + 1) % candidate_num;
+        if (tunnel.probe_cursor == best)
+            tunnel.probe_cursor = (tunnel.probe_cursor + 1) % candidate_num;
+        return indexToMethod(tunnel.probe_cursor);
+    }
+    return indexToMethod(best);
+}
+
+void ExchangeCompressionSelector::update(
+    size_t tunnel_index,
+    CompressionMethod method,
+    size_t original_size,
+    size_t packet_size,
+    UInt64 encode_ns)
+{
+    const auto index = methodToIndex(method);
+    if (!index || original_size == 0 || packet_size == 0)
+        return;
+
+    RUNTIME_CHECK(tunnel_index < tunnels.size(), tunnel_index, tunnels.size());
+    auto & tunnel = tunnels[tunnel_index];
+    auto & stat = tunnel.methods[*index];
+    updateAverage(stat.ratio, static_cast<double>(packet_size) / original_size, stat.samples);
+    updateAverage(stat.encode_ns_per_byte, static_cast<double>(encode_ns) / original_size, stat.samples);
+    ++stat.samples;
+}
+
+void ExchangeCompressionSelector::updateSendCost(size_t tunnel_index, UInt64 send_ns, UInt64 sent_bytes)
+{
+    if (sent_bytes == 0)
+        return;
+
+    RUNTIME_CHECK(tunnel_index < tunnels.size(), tunnel_index, tunnels.size());
+    auto & tunnel = tunnels[tunnel_index];
+    updateAverage(tunnel.send_ns_per_byte, static_cast<double>(send_ns) / sent_bytes, tunnel.send_samples);
+    ++tunnel.send_samples;
+}
+} // namespace DB
@@ -0,0 +1,80 @@
+// Copyright 2024 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Flash/Statistics/ConnectionProfileInfo.h>
+#include <IO/Compression/CompressionMethod.h>
+#include <common/types.h>
+
+#include <array>
+#include <vector>
+
+namespace DB
+{
+/// Choose the compression method of each packet sent to a remote tunnel.
+///
+/// For every tunnel it keeps the moving average of the compression ratio and the encoding cost of each candidate
+/// method, and the cost of sending one byte through the tunnel. The candidate with the lowest estimated
+/// `encode cost + encoded bytes * send cost` is chosen. The send cost is measured by the tunnel sender, which is the
+/// time from a packet being ready to send until it is sent, see `TunnelSender::recordSendCost`. It is never lower
+/// than the baseline of the tunnel's connection type, so that inter-zone tunnels prefer stronger compression than
+/// inner-zone ones.
+/// Every `probe_interval` packets another candidate is tried, to keep its statistic up to date with the data.
+///
+/// It is not thread-safe, every exchange writer owns its own selector.
+class ExchangeCompressionSelector
+{
+public:
+    static constexpr UInt64 probe_interval = 16;
+
+    explicit ExchangeCompressionSelector(std::vector<ConnectionProfileInfo::ConnectionType> && conn_types);
+
+    // `max_method` is the compression method required by the query, stronger methods will not be chosen.
+    CompressionMethod choose(size_t tunnel_index, CompressionMethod max_method);
+
+    void update(
+        size_t tunnel_index,
+        CompressionMethod method,
+        size_t original_size,
+        size_t packet_size,
+        UInt64 encode_ns);
+
+    // `send_ns` is the time the tunnel sender spent on sending `sent_bytes` bytes since the last call.
+    void updateSendCost(size_t tunnel_index, UInt64 send_ns, UInt64 sent_bytes);
+
+private:
+    // The candidates are NONE, LZ4 and ZSTD, ordered by the compression strength.
+    static constexpr size_t max_candidates = 3;
+
+    struct MethodStat
+    {
+        UInt64 samples = 0;
+        double ratio = 1.0;
+        double encode_ns_per_byte = 0.0;
+    };
+
+    struct TunnelStat
+    {
+        std::array<MethodStat, max_candidates> methods{};
+        UInt64 send_samples = 0;
+        double send_ns_per_byte = 0.0;
+        double min_send_ns_per_byte = 0.0;
+        UInt64 packets = 0;
+        size_t probe_cursor = 0;
+    };
+
+    std::vector<TunnelStat> tunnels;
+};
+} // namespace DB
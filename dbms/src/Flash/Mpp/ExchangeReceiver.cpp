@@ -560,7 +560,8 @@ void ExchangeReceiverBase<RPCContext>::setUpLocalConnections(std::vector<Request
                 [this]() { this->connectionLocalDone(); },
                 [this]() { this->addLocalConnectionNum(); },
                 req_info,
-                &received_message_queue);
+                &received_message_queue,
+                mem_tracker.get());
 
             rpc_context->establishMPPConnectionLocalV2(req, req.source_index, local_request_handler, has_remote_conn);
             --connection_uncreated_num;
@@ -729,7 +730,8 @@ DecodeDetail ExchangeReceiverBase<RPCContext>::decodeChunks(
     DecodeDetail detail;
 
     const auto & chunks = recv_msg->getChunks(stream_id);
-    if (chunks.empty())
+    const auto & blocks = recv_msg->getBlocks(stream_id);
+    if (chunks.empty() && blocks.empty())
         return detail;
     const auto & packet = recv_msg->getPacket();
 
@@ -739,12 +741,22 @@ DecodeDetail ExchangeReceiverBase<RPCContext>::decodeChunks(
         bool init_value = false;
         if (recv_msg->getPacketSizeRecorded().compare_exchange_strong(init_value, true, std::memory_order_relaxed))
         {
-            detail.packet_bytes = packet.ByteSizeLong();
+            detail.packet_bytes = recv_msg->getByteSize();
         }
     }
     else
     {
-        detail.packet_bytes = packet.ByteSizeLong();
+        detail.packet_bytes = recv_msg->getByteSize();
+    }
+
+    // Blocks from local tunnel need no decoding, each of them belongs to only one stream so it can be moved out.
+    for (auto * block : blocks)
+    {
+        auto && result = decoder_ptr->squash(std::move(*block));
+        if (!result || !result->rows())
+            continue;
+        detail.rows += result->rows();
+        block_queue.push(std::move(*result));
     }
 
     switch (auto version = packet.version(); version)
@@ -934,7 +946,7 @@ ExchangeReceiverResult ExchangeReceiverBase<RPCContext>::toDecodeResult(
             "Data should not be encoded into tipb::SelectResponse.chunks when fine grained shuffle is enabled");
         result.decode_detail = CoprocessorReader::decodeChunks(select_resp, block_queue, header, schema);
     }
-    else if (!recv_msg->getChunks(stream_id).empty())
+    else if (!recv_msg->getChunks(stream_id).empty() || !recv_msg->getBlocks(stream_id).empty())
     {
         result.decode_detail = decodeChunks(stream_id, recv_msg, block_queue, decoder_ptr);
     }
@@ -83,6 +83,104 @@ void fillSelectorForFineGrainedShuffle(
     }
 }
 
+/// Group the rows by the partition in `selector` with a counting sort.
+/// After it, the rows of partition i are `row_indexes[partition_offsets[i], partition_offsets[i + 1])` in their
+/// original order. The row indexes refer to the block, so rows of a selective block are mapped through `selective`.
+template <bool selective_block>
+void groupRowsByPartition(
+    const IColumn::Selector & selector,
+    size_t part_num,
+    const BlockSelective * selective,
+    IColumn::Offsets & row_indexes,
+    std::vector<size_t> & partition_offsets)
+{
+    const size_t rows = selector.size();
+
+    // pass 1: histogram of the partitions
+    partition_offsets.assign(part_num + 1, 0);
+    for (size_t i = 0; i < rows; ++i)
+        ++partition_offsets[selector[i] + 1];
+    for (size_t i = 0; i < part_num; ++i)
+        partition_offsets[i + 1] += partition_offsets[i];
+
+    // pass 2: place every row at the next free slot of its partition
+    std::vector<size_t> cursors(partition_offsets.begin(), partition_offsets.end() - 1);
+    row_indexes.resize(rows);
+    for (size_t i = 0; i < rows; ++i)
+    {
+        if constexpr (selective_block)
+            row_indexes[cursors[selector[i]]++] = (*selective)[i];
+        else
+            row_indexes[cursors[selector[i]]++] = i;
+    }
+}
+
+/// Append the grouped rows of every column to the destination columns, `dest_columns(col_id, part_id)` returns the
+/// destination of the rows of partition `part_id` in column `col_id`.
+/// Every destination is reserved once and filled by one sequential gather, and all columns share the same grouping,
+/// instead of appending row by row to a random partition like `IColumn::scatter`.
+template <typename DestColumnsGetter>
+void scatterGroupedRows(
+    const Block & block,
+    const IColumn::Offsets & row_indexes,
+    const std::vector<size_t> & partition_offsets,
+    DestColumnsGetter && dest_columns)
+{
+    const size_t part_num = partition_offsets.size() - 1;
+    for (size_t col_id = 0; col_id < block.columns(); ++col_id)
+    {
+        const auto & src = *block.getByPosition(col_id).column;
+        for (size_t part_id = 0; part_id < part_num; ++part_id)
+        {
+            const size_t start = partition_offsets[part_id];
+            const size_t length = partition_offsets[part_id + 1] - start;
+            if (length == 0)
+                continue;
+            auto & dest = dest_columns(col_id, part_id);
+            dest->reserve(dest->size() + length);
+            dest->insertSelectiveRangeFrom(src, row_indexes, start, length);
+        }
+    }
+}
+
+void scatterToDestColumns(
+    const Block & block,
+    const IColumn::Selector & selector,
+    uint32_t bucket_num,
+    std::vector<std::vector<MutableColumnPtr>> & result_columns)
+{
+    IColumn::Offsets row_indexes;
+    std::vector<size_t> partition_offsets;
+    if (block.info.selective)
+        groupRowsByPartition<true>(selector, bucket_num, block.info.selective.get(), row_indexes, partition_offsets);
+    else
+        groupRowsByPartition<false>(selector, bucket_num, nullptr, row_indexes, partition_offsets);
+
+    RUNTIME_CHECK(result_columns.size() == bucket_num, result_columns.size(), bucket_num);
+    scatterGroupedRows(block, row_indexes, partition_offsets, [&](size_t col_id, size_t part_id) -> MutableColumnPtr & {
+        return result_columns[part_id][col_id];
+    });
+}
+
+void scatterToScatteredColumns(
+    const Block & block,
+    const IColumn::Selector & selector,
+    size_t bucket_num,
+    std::vector<IColumn::ScatterColumns> & scattered)
+{
+    IColumn::Offsets row_indexes;
+    std::vector<size_t> partition_offsets;
+    if (block.info.selective)
+        groupRowsByPartition<true>(selector, bucket_num, block.info.selective.get(), row_indexes, partition_offsets);
+    else
+        groupRowsByPartition<false>(selector, bucket_num, nullptr, row_indexes, partition_offsets);
+
+    RUNTIME_CHECK(scattered.size() == block.columns(), scattered.size(), block.columns());
+    scatterGroupedRows(block, row_indexes, partition_offsets, [&](size_t col_id, size_t part_id) -> MutableColumnPtr & {
+        return scattered[col_id][part_id];
+    });
+}
+
 void computeHash(
     const Block & block,
     const std::vector<Int64> & partition_col_ids,
@@ -158,17 +256,7 @@ void scatterColumns(
     IColumn::Selector selector;
     fillSelector(input_block.rows(), hash, bucket_num, selector);
 
-    for (size_t col_id = 0; col_id < input_block.columns(); ++col_id)
-    {
-        // Scatter columns to different partitions
-        std::vector<MutableColumnPtr> part_columns
-            = input_block.getByPosition(col_id).column->scatter(bucket_num, selector);
-        assert(part_columns.size() == bucket_num);
-        for (size_t bucket_idx = 0; bucket_idx < bucket_num; ++bucket_idx)
-        {
-            result_columns[bucket_idx][col_id] = std::move(part_columns[bucket_idx]);
-        }
-    }
+    scatterToDestColumns(input_block, selector, bucket_num, result_columns);
 }
 
 void scatterColumnsSelectiveBlock(
@@ -187,16 +275,7 @@ void scatterColumnsSelectiveBlock(
     IColumn::Selector selector;
     fillSelector(input_block.info.selective->size(), hash, bucket_num, selector);
 
-    for (size_t col_id = 0; col_id < input_block.columns(); ++col_id)
-    {
-        std::vector<MutableColumnPtr> part_columns
-            = input_block.getByPosition(col_id).column->scatter(bucket_num, selector, *input_block.info.selective);
-        assert(part_columns.size() == bucket_num);
-        for (size_t bucket_idx = 0; bucket_idx < bucket_num; ++bucket_idx)
-        {
-            result_columns[bucket_idx][col_id] = std::move(part_columns[bucket_idx]);
-        }
-    }
+    scatterToDestColumns(input_block, selector, bucket_num, result_columns);
 }
 
 void scatterColumnsForFineGrainedShuffle(
@@ -220,11 +299,11 @@ void scatterColumnsForFineGrainedShuffle(
     fillSelectorForFineGrainedShuffle(block.rows(), hash, part_num, fine_grained_shuffle_stream_count, selector);
 
     // partition
-    for (size_t i = 0; i < block.columns(); ++i)
-    {
-        const auto & column = block.getByPosition(i).column;
-        column->scatterTo(scattered[i], selector);
-    }
+    scatterToScatteredColumns(
+        block,
+        selector,
+        static_cast<size_t>(part_num) * fine_grained_shuffle_stream_count,
+        scattered);
 }
 
 void scatterColumnsForFineGrainedShuffleSelectiveBlock(
@@ -249,11 +328,11 @@ void scatterColumnsForFineGrainedShuffleSelectiveBlock(
         fine_grained_shuffle_stream_count,
         selector);
 
-    for (size_t i = 0; i < block.columns(); ++i)
-    {
-        const auto & column = block.getByPosition(i).column;
-        column->scatterTo(scattered[i], selector, *block.info.selective);
-    }
+    scatterToScatteredColumns(
+        block,
+        selector,
+        static_cast<size_t>(part_num) * fine_grained_shuffle_stream_count,
+        scattered);
 }
 
 } // namespace DB::HashBaseWriterHelper
@@ -27,17 +27,22 @@ struct LocalRequestHandler
         std::function<void()> && notify_close_,
         std::function<void()> && add_local_conn_num_,
         const std::string & req_info_,
-        ReceivedMessageQueue * msg_queue_)
+        ReceivedMessageQueue * msg_queue_,
+        MemoryTracker * mem_tracker_ = nullptr)
         : notify_write_done(std::move(notify_write_done_))
         , notify_close(std::move(notify_close_))
         , add_local_conn_num(std::move(add_local_conn_num_))
         , req_info(req_info_)
         , msg_queue(msg_queue_)
+        , mem_tracker(mem_tracker_)
     {}
 
     template <bool is_force>
     bool write(size_t source_index, const TrackedMppDataPacketPtr & tracked_packet)
     {
+        // Local blocks are consumed by the receiver without decoding, so account them to the receiver.
+        if (mem_tracker != nullptr && tracked_packet->hasLocalBlocks())
+            tracked_packet->switchMemTracker(mem_tracker);
         return msg_queue->pushPacket<is_force>(source_index, req_info, tracked_packet, ReceiverMode::Local);
     }
 
@@ -68,6 +73,8 @@ struct LocalRequestHandler
     std::function<void()> add_local_conn_num;
     const std::string req_info;
     ReceivedMessageQueue * msg_queue;
+    // Memory tracker of the receiver, nullptr means not switching the memory tracker of packets.
+    MemoryTracker * mem_tracker;
     UInt64 waiting_task_time = 0;
     Stopwatch watch;
 };
@@ -173,10 +173,12 @@ void MPPTunnel::write(TrackedMppDataPacketPtr && data)
         waitUntilConnectedOrFinished(lk);
         RUNTIME_CHECK_MSG(tunnel_sender != nullptr, "write to tunnel {} which is already closed.", tunnel_id);
     }
+    checkLocalBlocks(data);
 
     FAIL_POINT_TRIGGER_EXCEPTION(FailPoints::random_tunnel_write_failpoint);
 
-    auto pushed_data_size = data->getPacket().ByteSizeLong();
+    auto pushed_data_size = data->getByteSize();
+    data->push_ns = clock_gettime_ns();
     if (tunnel_sender->push(std::move(data)))
     {
         updateMetric(data_size_in_queue, pushed_data_size, mode);
@@ -192,10 +194,12 @@ void MPPTunnel::write(TrackedMppDataPacketPtr && data)
 void MPPTunnel::forceWrite(TrackedMppDataPacketPtr && data)
 {
     LOG_TRACE(log, "start force writing");
+    checkLocalBlocks(data);
 
     FAIL_POINT_TRIGGER_EXCEPTION(FailPoints::random_tunnel_write_failpoint);
 
-    auto pushed_data_size = data->getPacket().ByteSizeLong();
+    auto pushed_data_size = data->getByteSize();
+    data->push_ns = clock_gettime_ns();
     if (tunnel_sender->forcePush(std::move(data)))
     {
         updateMetric(data_size_in_queue, pushed_data_size, mode);
@@ -208,6 +212,15 @@ void MPPTunnel::forceWrite(TrackedMppDataPacketPtr && data)
         tunnel_sender->isConsumerFinished() ? tunnel_sender->getConsumerFinishMsg() : ""));
 }
 
+void MPPTunnel::checkLocalBlocks(const TrackedMppDataPacketPtr & data) const
+{
+    // Only local tunnel version 2 hands the packets to `ExchangeReceiver` directly, other tunnels only send chunks.
+    RUNTIME_CHECK_MSG(
+        !data->hasLocalBlocks() || local_tunnel_v2 != nullptr || local_tunnel_local_only_v2 != nullptr,
+        "Packet with local blocks is written to tunnel {} which is not a local tunnel version 2",
+        tunnel_id);
+}
+
 /// done normally and being called exactly once after writing all packets
 void MPPTunnel::writeDone()
 {
@@ -460,6 +473,7 @@ void SyncTunnelSender::sendJob(PacketWriter * writer)
                 err_msg = "grpc writes failed.";
                 break;
             }
+            recordSendCost(res);
         }
         /// write the last error packet if needed
         if (send_queue.getStatus() == MPMCQueueStatus::CANCELLED)
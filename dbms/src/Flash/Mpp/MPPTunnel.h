@@ -29,6 +29,7 @@
 #include <Flash/Mpp/TrackedMppDataPacket.h>
 #include <Flash/Pipeline/Schedule/Tasks/NotifyFuture.h>
 #include <Flash/Pipeline/Schedule/Tasks/Task.h>
+#include <Flash/Statistics/CompressionProfileInfo.h>
 #include <Flash/Statistics/ConnectionProfileInfo.h>
 #include <common/StringRef.h>
 #include <common/defines.h>
@@ -126,6 +127,23 @@ public:
     String getTunnelId() { return tunnel_id; }
     MemoryTracker * getMemoryTracker() const { return memory_tracker != nullptr ? memory_tracker.get() : nullptr; }
 
+    // Called by the sender when it is done with `packet`. The cost is the time from the later of the packet being
+    // pushed and the previous packet being done, so it is the real time of sending the packet no matter whether the
+    // writer blocks on pushing or not. It is only called by one thread at a time.
+    void recordSendCost(const TrackedMppDataPacketPtr & packet)
+    {
+        const auto now = clock_gettime_ns();
+        send_cost_ns.fetch_add(now - std::min(now, std::max(packet->push_ns, last_sent_ns)), std::memory_order_relaxed);
+        sent_bytes.fetch_add(packet->getPacket().ByteSizeLong(), std::memory_order_relaxed);
+        last_sent_ns = now;
+    }
+
+    // Returns the send cost and the sent bytes recorded since the last call.
+    std::pair<UInt64, UInt64> fetchSendCost()
+    {
+        return {send_cost_ns.exchange(0, std::memory_order_relaxed), sent_bytes.exchange(0, std::memory_order_relaxed)};
+    }
+
 protected:
     /// TunnelSender use consumer state to inform tunnel that whether sender has finished its work
     class ConsumerState
@@ -161,6 +179,10 @@ protected:
     const String tunnel_id;
 
     std::atomic<Int64> * data_size_in_queue; // Come from MppTunnel
+
+    UInt64 last_sent_ns = 0;
+    std::atomic<UInt64> send_cost_ns = 0;
+    std::atomic<UInt64> sent_bytes = 0;
 };
 
 /// SyncTunnelSender maintains a new thread itself to consume and send data
@@ -536,6 +558,19 @@ public:
 
     const ConnectionProfileInfo & getConnectionProfileInfo() const { return connection_profile_info; }
 
+    CompressionProfileInfo getCompressionProfileInfo() const { return compression_profile_info.load(); }
+    void updateCompressionProfileInfo(CompressionMethod method, size_t original_size, size_t packet_size)
+    {
+        compression_profile_info.update(method, original_size, packet_size);
+    }
+
+    // Fetch and reset the time the sender spent on sending packets and the sent bytes,
+    // see `TunnelSender::recordSendCost`.
+    std::pair<UInt64, UInt64> fetchSendCost()
+    {
+        return tunnel_sender ? tunnel_sender->fetchSendCost() : std::pair<UInt64, UInt64>{0, 0};
+    }
+
     bool isLocal() const { return mode == TunnelSenderMode::LOCAL; }
     bool isAsync() const { return mode == TunnelSenderMode::ASYNC_GRPC; }
 
@@ -566,6 +601,8 @@ private:
 
     void waitForSenderFinish(bool allow_throw);
 
+    void checkLocalBlocks(const TrackedMppDataPacketPtr & data) const;
+
     MemoryTracker * getMemTracker() { return mem_tracker ? mem_tracker.get() : nullptr; }
 
     void updateConnProfileInfo(size_t pushed_data_size)
@@ -597,6 +634,7 @@ private:
     std::shared_ptr<MemoryTracker> mem_tracker;
     const CapacityLimits queue_limit;
     ConnectionProfileInfo connection_profile_info;
+    ConcurrentCompressionProfileInfo compression_profile_info;
     const LoggerPtr log;
     TunnelSenderMode mode; // Tunnel transfer data mode
     TunnelSenderPtr
@@ -183,5 +183,79 @@ TrackedMppDataPacketPtr ToCompressedPacket(
     return compressed_tracked_packet;
 }
 
+TrackedMppDataPacketPtr ToLocalPacket(const Blocks & blocks, MPPDataPacketVersion version, size_t & original_size)
+{
+    assert(version > MPPDataPacketV0);
+
+    auto tracked_packet = std::make_shared<TrackedMppDataPacket>(version);
+    for (const auto & block : blocks)
+    {
+        if (!block.rows())
+            continue;
+        // The columns are shared with other tunnels, and will be copied on write by the receivers.
+        Block local_block = block;
+        for (auto & column : local_block)
+            column.column = column.column->convertToFullColumnIfConst();
+        original_size += local_block.bytes();
+        tracked_packet->addLocalBlock(std::move(local_block));
+    }
+    if unlikely (!tracked_packet->hasLocalBlocks())
+        return nullptr;
+    return tracked_packet;
+}
+
+TrackedMppDataPacketPtr ToLocalPacket(
+    const Block & header,
+    std::vector<MutableColumns> && part_columns,
+    MPPDataPacketVersion version,
+    size_t & original_size)
+{
+    assert(version > MPPDataPacketV0);
+
+    auto tracked_packet = std::make_shared<TrackedMppDataPacket>(version);
+    for (auto & columns : part_columns)
+    {
+        if unlikely (!columns.front() || columns.front()->empty())
+            continue;
+        auto block = header.cloneWithColumns(std::move(columns));
+        original_size += block.bytes();
+        tracked_packet->addLocalBlock(std::move(block));
+    }
+    return tracked_packet;
+}
+
+TrackedMppDataPacketPtr ToLocalFineGrainedPacket(
+    const Block & header,
+    std::vector<IColumn::ScatterColumns> & scattered,
+    size_t bucket_idx,
+    UInt64 fine_grained_shuffle_stream_count,
+    size_t num_columns,
+    MPPDataPacketVersion version,
+    size_t & original_size)
+{
+    assert(version > MPPDataPacketV0);
+
+    auto tracked_packet = std::make_shared<TrackedMppDataPacket>(version);
+    for (uint64_t stream_idx = 0; stream_idx < fine_grained_shuffle_stream_count; ++stream_idx)
+    {
+        if (scattered[0][bucket_idx + stream_idx]->empty())
+            continue;
+
+        // Move the scatter columns into the block, and leave empty columns for the next round of scatter.
+        MutableColumns columns;
+        columns.reserve(num_columns);
+        for (size_t col_id = 0; col_id < num_columns; ++col_id)
+        {
+            auto & column = scattered[col_id][bucket_idx + stream_idx];
+            auto empty_column = column->cloneEmpty();
+            columns.emplace_back(std::move(column));
+            column = std::move(empty_column);
+        }
+        auto block = header.cloneWithColumns(std::move(columns));
+        original_size += block.bytes();
+        tracked_packet->addLocalBlock(std::move(block), stream_idx);
+    }
+    return tracked_packet;
+}
 
 } // namespace DB::MPPTunnelSetHelper
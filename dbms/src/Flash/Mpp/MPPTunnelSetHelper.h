@@ -63,4 +63,22 @@ TrackedMppDataPacketPtr ToFineGrainedPacket(
     CompressionMethod compression_method,
     size_t & original_size);
 
+// The following functions build packets for local tunnel, which carry the blocks without serialization.
+TrackedMppDataPacketPtr ToLocalPacket(const Blocks & blocks, MPPDataPacketVersion version, size_t & original_size);
+
+TrackedMppDataPacketPtr ToLocalPacket(
+    const Block & header,
+    std::vector<MutableColumns> && part_columns,
+    MPPDataPacketVersion version,
+    size_t & original_size);
+
+TrackedMppDataPacketPtr ToLocalFineGrainedPacket(
+    const Block & header,
+    std::vector<IColumn::ScatterColumns> & scattered,
+    size_t bucket_idx,
+    UInt64 fine_grained_shuffle_stream_count,
+    size_t num_columns,
+    MPPDataPacketVersion version,
+    size_t & original_size);
+
 } // namespace DB::MPPTunnelSetHelper
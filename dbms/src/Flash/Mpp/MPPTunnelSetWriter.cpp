@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <Common/Exception.h>
+#include <Common/Stopwatch.h>
 #include <Common/TiFlashMetrics.h>
 #include <Flash/Coprocessor/CHBlockChunkCodecV1.h>
 #include <Flash/Mpp/MPPTunnelSetHelper.h>
@@ -238,12 +239,53 @@ static void broadcastOrPassThroughWriteV0(
 MPPTunnelSetWriterBase::MPPTunnelSetWriterBase(
     const MPPTunnelSetPtr & mpp_tunnel_set_,
     const std::vector<tipb::FieldType> & result_field_types_,
-    const String & req_id)
+    const String & req_id,
+    bool enable_adaptive_compression,
+    bool enable_local_zero_copy_)
     : mpp_tunnel_set(mpp_tunnel_set_)
     , result_field_types(result_field_types_)
     , log(Logger::get(req_id))
+    , enable_local_zero_copy(enable_local_zero_copy_)
 {
     RUNTIME_CHECK(mpp_tunnel_set->getPartitionNum() > 0);
+    if (enable_adaptive_compression)
+    {
+        std::vector<ConnectionProfileInfo::ConnectionType> conn_types;
+        conn_types.reserve(mpp_tunnel_set->getPartitionNum());
+        for (const auto & tunnel : mpp_tunnel_set->getTunnels())
+            conn_types.push_back(tunnel->getConnectionProfileInfo().type);
+        compression_selector = std::make_unique<ExchangeCompressionSelector>(std::move(conn_types));
+    }
+}
+
+CompressionMethod MPPTunnelSetWriterBase::chooseCompressionMethod(
+    int16_t partition_id,
+    bool is_local,
+    CompressionMethod method)
+{
+    if (is_local)
+        return CompressionMethod::NONE;
+    if (compression_selector)
+        return compression_selector->choose(partition_id, method);
+    return method;
+}
+
+void MPPTunnelSetWriterBase::updateCompressionInfo(
+    int16_t partition_id,
+    CompressionMethod method,
+    size_t original_size,
+    size_t packet_size,
+    UInt64 encode_ns)
+{
+    const auto & tunnel = mpp_tunnel_set->getTunnels()[partition_id];
+    tunnel->updateCompressionProfileInfo(method, original_size, packet_size);
+    if (compression_selector)
+    {
+        compression_selector->update(partition_id, method, original_size, packet_size, encode_ns);
+        // Pushing into the async tunnel never blocks, so the send cost is measured by the tunnel sender.
+        const auto [send_ns, sent_bytes] = tunnel->fetchSendCost();
+        compression_selector->updateSendCost(partition_id, send_ns, sent_bytes);
+    }
 }
 
 void MPPTunnelSetWriterBase::write(tipb::SelectResponse & response)
@@ -282,11 +324,39 @@ static void broadcastOrPassThroughWrite(
     Blocks & blocks,
     MPPDataPacketVersion version,
     CompressionMethod compression_method,
+    bool local_zero_copy,
     FuncIsLocalTunnel && isLocalTunnel,
     FuncWriteToTunnel && writeToTunnel)
 {
     assert(version > MPPDataPacketV0);
 
+    if (local_zero_copy && local_tunnel_cnt > 0)
+    {
+        // local tunnels share the blocks, only remote tunnels need encoding
+        size_t original_size = 0;
+        auto local_tracked_packet = MPPTunnelSetHelper::ToLocalPacket(blocks, version, original_size);
+        if (!local_tracked_packet)
+            return;
+
+        TrackedMppDataPacketPtr remote_tracked_packet = nullptr;
+        if (local_tunnel_cnt != tunnel_cnt)
+        {
+            size_t encoded_original_size = 0;
+            remote_tracked_packet
+                = MPPTunnelSetHelper::ToPacket(std::move(blocks), version, compression_method, encoded_original_size);
+        }
+
+        return broadcastOrPassThroughWriteImpl<is_broadcast>(
+            tunnel_cnt,
+            local_tunnel_cnt,
+            local_tracked_packet->getByteSize(),
+            std::move(local_tracked_packet),
+            std::move(remote_tracked_packet),
+            compression_method,
+            std::forward<FuncIsLocalTunnel>(isLocalTunnel),
+            std::forward<FuncWriteToTunnel>(writeToTunnel));
+    }
+
     size_t original_size = 0;
     // encode by method NONE
     auto && ori_tracked_packet
@@ -341,6 +411,7 @@ void MPPTunnelSetWriterBase::broadcastWrite(
         blocks,
         version,
         compression_method,
+        enable_local_zero_copy,
         [&](size_t i) { return mpp_tunnel_set->isLocal(i); },
         [&](TrackedMppDataPacketPtr && data, size_t index) { return writeToTunnel(std::move(data), index); });
 }
@@ -358,6 +429,7 @@ void MPPTunnelSetWriterBase::passThroughWrite(
         blocks,
         version,
         compression_method,
+        enable_local_zero_copy,
         [&](size_t i) { return mpp_tunnel_set->isLocal(i); },
         [&](TrackedMppDataPacketPtr && data, size_t index) { return writeToTunnel(std::move(data), index); });
 }
@@ -386,16 +458,20 @@ void MPPTunnelSetWriterBase::partitionWrite(
     assert(version > MPPDataPacketV0);
 
     bool is_local = mpp_tunnel_set->isLocal(partition_id);
-    compression_method = is_local ? CompressionMethod::NONE : compression_method;
+    compression_method = chooseCompressionMethod(partition_id, is_local, compression_method);
 
+    Stopwatch watch;
     size_t original_size = 0;
-    auto tracked_packet
-        = MPPTunnelSetHelper::ToPacket(header, std::move(part_columns), version, compression_method, original_size);
+    auto tracked_packet = is_local && enable_local_zero_copy
+        ? MPPTunnelSetHelper::ToLocalPacket(header, std::move(part_columns), version, original_size)
+        : MPPTunnelSetHelper::ToPacket(header, std::move(part_columns), version, compression_method, original_size);
     assert(tracked_packet);
+    const auto encode_ns = watch.elapsedFromLastTime();
 
-    auto packet_bytes = tracked_packet->getPacket().ByteSizeLong();
+    auto packet_bytes = tracked_packet->getByteSize();
     checkPacketSize(packet_bytes);
     writeToTunnel(std::move(tracked_packet), partition_id);
+    updateCompressionInfo(partition_id, compression_method, original_size, packet_bytes, encode_ns);
     updatePartitionWriterMetrics(compression_method, original_size, packet_bytes, is_local);
 }
 
@@ -419,22 +495,34 @@ void MPPTunnelSetWriterBase::fineGrainedShuffleWrite(
             partition_id);
 
     bool is_local = mpp_tunnel_set->isLocal(partition_id);
-    compression_method = is_local ? CompressionMethod::NONE : compression_method;
+    compression_method = chooseCompressionMethod(partition_id, is_local, compression_method);
 
+    Stopwatch watch;
     size_t original_size = 0;
-    auto tracked_packet = MPPTunnelSetHelper::ToFineGrainedPacket(
-        header,
-        scattered,
-        bucket_idx,
-        fine_grained_shuffle_stream_count,
-        num_columns,
-        version,
-        compression_method,
-        original_size);
+    auto tracked_packet = is_local && enable_local_zero_copy
+        ? MPPTunnelSetHelper::ToLocalFineGrainedPacket(
+            header,
+            scattered,
+            bucket_idx,
+            fine_grained_shuffle_stream_count,
+            num_columns,
+            version,
+            original_size)
+        : MPPTunnelSetHelper::ToFineGrainedPacket(
+            header,
+            scattered,
+            bucket_idx,
+            fine_grained_shuffle_stream_count,
+            num_columns,
+            version,
+            compression_method,
+            original_size);
+    const auto encode_ns = watch.elapsedFromLastTime();
 
-    auto packet_bytes = tracked_packet->getPacket().ByteSizeLong();
+    auto packet_bytes = tracked_packet->getByteSize();
     checkPacketSize(packet_bytes);
     writeToTunnel(std::move(tracked_packet), partition_id);
+    updateCompressionInfo(partition_id, compression_method, original_size, packet_bytes, encode_ns);
     updatePartitionWriterMetrics(compression_method, original_size, packet_bytes, is_local);
 }
 
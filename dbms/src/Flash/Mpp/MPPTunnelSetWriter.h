@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <Flash/Mpp/ExchangeCompressionSelector.h>
 #include <Flash/Mpp/MPPTunnelSet.h>
 #include <IO/Compression/CompressionMethod.h>
 
@@ -25,7 +26,9 @@ public:
     MPPTunnelSetWriterBase(
         const MPPTunnelSetPtr & mpp_tunnel_set_,
         const std::vector<tipb::FieldType> & result_field_types_,
-        const String & req_id);
+        const String & req_id,
+        bool enable_adaptive_compression = false,
+        bool enable_local_zero_copy_ = false);
 
     virtual ~MPPTunnelSetWriterBase() = default;
 
@@ -75,10 +78,23 @@ protected:
     virtual void writeToTunnel(TrackedMppDataPacketPtr && data, size_t index) = 0;
     virtual void writeToTunnel(tipb::SelectResponse & response, size_t index) = 0;
 
+private:
+    CompressionMethod chooseCompressionMethod(int16_t partition_id, bool is_local, CompressionMethod method);
+    void updateCompressionInfo(
+        int16_t partition_id,
+        CompressionMethod method,
+        size_t original_size,
+        size_t packet_size,
+        UInt64 encode_ns);
+
 protected:
     MPPTunnelSetPtr mpp_tunnel_set;
     std::vector<tipb::FieldType> result_field_types;
     const LoggerPtr log;
+    // nullptr if adaptive compression is disabled.
+    std::unique_ptr<ExchangeCompressionSelector> compression_selector;
+    // Hand blocks to the receivers of local tunnels directly, without serialization.
+    const bool enable_local_zero_copy;
 };
 
 class SyncMPPTunnelSetWriter : public MPPTunnelSetWriterBase
@@ -87,8 +103,15 @@ public:
     SyncMPPTunnelSetWriter(
         const MPPTunnelSetPtr & mpp_tunnel_set_,
         const std::vector<tipb::FieldType> & result_field_types_,
-        const String & req_id)
-        : MPPTunnelSetWriterBase(mpp_tunnel_set_, result_field_types_, req_id)
+        const String & req_id,
+        bool enable_adaptive_compression = false,
+        bool enable_local_zero_copy = false)
+        : MPPTunnelSetWriterBase(
+            mpp_tunnel_set_,
+            result_field_types_,
+            req_id,
+            enable_adaptive_compression,
+            enable_local_zero_copy)
     {}
 
     // For sync writer, `waitForWritable` will not be called, so an exception is thrown here.
@@ -106,8 +129,15 @@ public:
     AsyncMPPTunnelSetWriter(
         const MPPTunnelSetPtr & mpp_tunnel_set_,
         const std::vector<tipb::FieldType> & result_field_types_,
-        const String & req_id)
-        : MPPTunnelSetWriterBase(mpp_tunnel_set_, result_field_types_, req_id)
+        const String & req_id,
+        bool enable_adaptive_compression = false,
+        bool enable_local_zero_copy = false)
+        : MPPTunnelSetWriterBase(
+            mpp_tunnel_set_,
+            result_field_types_,
+            req_id,
+            enable_adaptive_compression,
+            enable_local_zero_copy)
     {}
 
     WaitResult waitForWritable() const override { return mpp_tunnel_set->waitForWritable(); }
@@ -23,6 +23,15 @@ const std::vector<const String *> & ReceivedMessage::getChunks(size_t stream_id)
     else
         return chunks;
 }
+
+const std::vector<Block *> & ReceivedMessage::getBlocks(size_t stream_id) const
+{
+    if (fine_grained_consumer_size > 0)
+        return fine_grained_blocks[stream_id];
+    else
+        return blocks;
+}
+
 // Constructor that move chunks.
 ReceivedMessage::ReceivedMessage(
     size_t source_index_,
@@ -44,6 +53,7 @@ ReceivedMessage::ReceivedMessage(
     if (fine_grained_consumer_size > 0)
     {
         fine_grained_chunks.resize(fine_grained_consumer_size);
+        fine_grained_blocks.resize(fine_grained_consumer_size);
         if (packet->packet.chunks_size() > 0)
         {
             RUNTIME_CHECK_MSG(
@@ -68,9 +78,23 @@ ReceivedMessage::ReceivedMessage(
             }
         }
     }
+
+    auto & local_blocks = packet->local_blocks;
+    for (size_t i = 0; i < local_blocks.size(); ++i)
+    {
+        if (fine_grained_consumer_size > 0)
+        {
+            UInt64 stream_id = packet->local_stream_ids[i] % fine_grained_consumer_size;
+            fine_grained_blocks[stream_id].push_back(&local_blocks[i]);
+        }
+        else
+        {
+            blocks.push_back(&local_blocks[i]);
+        }
+    }
 }
 bool ReceivedMessage::containUsefulMessage() const
 {
-    return error_ptr != nullptr || resp_ptr != nullptr || !chunks.empty();
+    return error_ptr != nullptr || resp_ptr != nullptr || !chunks.empty() || packet->hasLocalBlocks();
 }
 } // namespace DB
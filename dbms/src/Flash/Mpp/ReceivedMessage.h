@@ -34,6 +34,9 @@ class ReceivedMessage
     std::vector<const String *> chunks;
     /// used for fine grained shuffle, remaining_consumers will be nullptr for non fine grained shuffle
     std::vector<std::vector<const String *>> fine_grained_chunks;
+    /// blocks sent by local tunnel without serialization, they can be moved out by the consumer
+    std::vector<Block *> blocks;
+    std::vector<std::vector<Block *>> fine_grained_blocks;
     std::atomic<size_t> remaining_consumers;
     size_t fine_grained_consumer_size;
     std::atomic<bool> packet_size_recorded{false}; // used to flag if fined grained shuffle packet size is recorded
@@ -55,7 +58,9 @@ public:
     const String * getRespPtr(size_t stream_id) const { return stream_id == 0 ? resp_ptr : nullptr; }
     std::atomic<size_t> & getRemainingConsumers() { return remaining_consumers; }
     const std::vector<const String *> & getChunks(size_t stream_id) const;
+    const std::vector<Block *> & getBlocks(size_t stream_id) const;
     const mpp::MPPDataPacket & getPacket() const { return packet->packet; }
+    size_t getByteSize() const { return packet->getByteSize(); }
     std::atomic<bool> & getPacketSizeRecorded() { return packet_size_recorded; }
     bool containUsefulMessage() const;
 };
@@ -16,6 +16,7 @@
 
 #include <Common/Exception.h>
 #include <Common/Logger.h>
+#include <Core/Block.h>
 #include <common/logger_useful.h>
 #include <common/types.h>
 #pragma GCC diagnostic push
@@ -132,6 +133,22 @@ struct TrackedMppDataPacket
         packet.add_chunks(std::move(value));
     }
 
+    // Add a block which is handed to the receiver through local tunnel without serialization.
+    // `stream_id` is the same as `packet.stream_ids` and only used by fine grained shuffle.
+    void addLocalBlock(Block && block, UInt64 stream_id = 0)
+    {
+        auto bytes = block.bytes();
+        mem_tracker_wrapper.alloc(bytes);
+        local_blocks_bytes += bytes;
+        local_blocks.push_back(std::move(block));
+        local_stream_ids.push_back(stream_id);
+    }
+
+    bool hasLocalBlocks() const { return !local_blocks.empty(); }
+
+    // The size of data carried by the packet, including the local blocks.
+    size_t getByteSize() const { return packet.ByteSizeLong() + local_blocks_bytes; }
+
     void serializeByResponse(const tipb::SelectResponse & response)
     {
         mem_tracker_wrapper.alloc(response.ByteSizeLong());
@@ -188,14 +205,25 @@ struct TrackedMppDataPacket
 
     std::shared_ptr<DB::TrackedMppDataPacket> copy() const
     {
-        return std::make_shared<TrackedMppDataPacket>(
+        auto res = std::make_shared<TrackedMppDataPacket>(
             packet,
             mem_tracker_wrapper.size,
             mem_tracker_wrapper.memory_tracker);
+        // Columns are immutable and shared by the copies.
+        res->local_blocks = local_blocks;
+        res->local_stream_ids = local_stream_ids;
+        res->local_blocks_bytes = local_blocks_bytes;
+        return res;
     }
 
     MemTrackerWrapper mem_tracker_wrapper;
     mpp::MPPDataPacket packet;
+    // Blocks sent through local tunnel, each of them is consumed by exactly one receiver stream.
+    Blocks local_blocks;
+    std::vector<UInt64> local_stream_ids;
+    size_t local_blocks_bytes = 0;
+    // The time the packet is pushed into the tunnel, used to measure the send cost.
+    UInt64 push_ns = 0;
     bool need_recompute = false;
     String error_message;
 };
@@ -118,14 +118,20 @@ std::unique_ptr<DAGResponseWriter> newMPPExchangeWriter(
     UInt64 fine_grained_shuffle_batch_size,
     tipb::CompressionMode compression_mode,
     Int64 batch_send_min_limit_compression,
+    bool enable_adaptive_compression,
+    bool enable_local_zero_copy,
     const String & req_id,
     bool is_async)
 {
     RUNTIME_CHECK_MSG(dag_context.isMPPTask() && dag_context.tunnel_set != nullptr, "exchange writer only run in MPP");
     if (is_async)
     {
-        auto writer
-            = std::make_shared<AsyncMPPTunnelSetWriter>(dag_context.tunnel_set, dag_context.result_field_types, req_id);
+        auto writer = std::make_shared<AsyncMPPTunnelSetWriter>(
+            dag_context.tunnel_set,
+            dag_context.result_field_types,
+            req_id,
+            enable_adaptive_compression,
+            enable_local_zero_copy);
         return buildMPPExchangeWriter(
             writer,
             partition_col_ids,
@@ -143,8 +149,12 @@ std::unique_ptr<DAGResponseWriter> newMPPExchangeWriter(
     }
     else
     {
-        auto writer
-            = std::make_shared<SyncMPPTunnelSetWriter>(dag_context.tunnel_set, dag_context.result_field_types, req_id);
+        auto writer = std::make_shared<SyncMPPTunnelSetWriter>(
+            dag_context.tunnel_set,
+            dag_context.result_field_types,
+            req_id,
+            enable_adaptive_compression,
+            enable_local_zero_copy);
         return buildMPPExchangeWriter(
             writer,
             partition_col_ids,
@@ -32,6 +32,8 @@ std::unique_ptr<DAGResponseWriter> newMPPExchangeWriter(
     UInt64 fine_grained_shuffle_batch_size,
     tipb::CompressionMode compression_mode,
     Int64 batch_send_min_limit_compression,
+    bool enable_adaptive_compression,
+    bool enable_local_zero_copy,
     const String & req_id,
     bool is_async = false);
 
@@ -0,0 +1,150 @@
+// Copyright 2024 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Flash/Mpp/ExchangeCompressionSelector.h>
+#include <gtest/gtest.h>
+
+#include <map>
+#include <vector>
+
+namespace DB::tests
+{
+namespace
+{
+constexpr size_t original_size = 1000;
+
+struct MethodCost
+{
+    double ratio;
+    double encode_ns_per_byte;
+};
+
+// Send `packets` packets to the tunnel, and return how many times each method is chosen.
+std::map<CompressionMethod, size_t> sendPackets(
+    ExchangeCompressionSelector & selector,
+    size_t tunnel_index,
+    CompressionMethod max_method,
+    const std::map<CompressionMethod, MethodCost> & costs,
+    size_t packets)
+{
+    std::map<CompressionMethod, size_t> chosen;
+    for (size_t i = 0; i < packets; ++i)
+    {
+        auto method = selector.choose(tunnel_index, max_method);
+        ++chosen[method];
+        const auto & cost = costs.at(method);
+        selector.update(
+            tunnel_index,
+            method,
+            original_size,
+            static_cast<size_t>(cost.ratio * original_size),
+            static_cast<UInt64>(cost.encode_ns_per_byte * original_size));
+    }
+    return chosen;
+}
+} // namespace
+
+TEST(ExchangeCompressionSelectorTest, TryEveryCandidateFirst)
+{
+    ExchangeCompressionSelector selector({ConnectionProfileInfo::InterZoneRemote});
+    std::vector<CompressionMethod> methods;
+    for (size_t i = 0; i < 3; ++i)
+    {
+        methods.push_back(selector.choose(0, CompressionMethod::ZSTD));
+        selector.update(0, methods.back(), original_size, original_size, 0);
+    }
+    std::vector<CompressionMethod> expected{CompressionMethod::NONE, CompressionMethod::LZ4, CompressionMethod::ZSTD};
+    ASSERT_EQ(methods, expected);
+}
+
+TEST(ExchangeCompressionSelectorTest, ChooseByConnectionType)
+{
+    ExchangeCompressionSelector selector(
+        {ConnectionProfileInfo::InnerZoneRemote, ConnectionProfileInfo::InterZoneRemote});
+    const std::map<CompressionMethod, MethodCost> costs{
+        {CompressionMethod::NONE, {1.0, 0.1}},
+        {CompressionMethod::LZ4, {0.5, 0.5}},
+        {CompressionMethod::ZSTD, {0.1, 1.0}},
+    };
+    const size_t packets = 10 * ExchangeCompressionSelector::probe_interval;
+
+    // Inner-zone: NONE costs 1.1, LZ4 costs 1.0, ZSTD costs 1.1 per byte.
+    auto inner_zone = sendPackets(selector, 0, CompressionMethod::ZSTD, costs, packets);
+    ASSERT_GT(inner_zone[CompressionMethod::LZ4], packets * 3 / 4);
+
+    // Inter-zone: NONE costs 8.1, LZ4 costs 4.5, ZSTD costs 1.8 per byte.
+    auto inter_zone = sendPackets(selector, 1, CompressionMethod::ZSTD, costs, packets);
+    ASSERT_GT(inter_zone[CompressionMethod::ZSTD], packets * 3 / 4);
+    // Other candidates are probed periodically.
+    ASSERT_GT(inter_zone[CompressionMethod::NONE], 1);
+    ASSERT_GT(inter_zone[CompressionMethod::LZ4], 1);
+}
+
+TEST(ExchangeCompressionSelectorTest, ChooseBySendCost)
+{
+    ExchangeCompressionSelector selector({ConnectionProfileInfo::InnerZoneRemote});
+    const std::map<CompressionMethod, MethodCost> costs{
+        {CompressionMethod::NONE, {1.0, 0.1}},
+        {CompressionMethod::LZ4, {0.5, 0.5}},
+        {CompressionMethod::ZSTD, {0.1, 1.0}},
+    };
+    const size_t packets = 10 * ExchangeCompressionSelector::probe_interval;
+
+    // The sender is fast, the baseline of inner-zone is used and LZ4 is the cheapest.
+    selector.updateSendCost(0, 0, original_size);
+    auto fast = sendPackets(selector, 0, CompressionMethod::ZSTD, costs, packets);
+    ASSERT_GT(fast[CompressionMethod::LZ4], packets * 3 / 4);
+
+    // The sender is slow, 10ns per byte: NONE costs 10.1, LZ4 costs 5.5, ZSTD costs 2.0 per byte.
+    for (size_t i = 0; i < 10; ++i)
+        selector.updateSendCost(0, 10 * original_size, original_size);
+    auto slow = sendPackets(selector, 0, CompressionMethod::ZSTD, costs, packets);
+    ASSERT_GT(slow[CompressionMethod::ZSTD], packets * 3 / 4);
+
+    // Nothing is sent since the last update.
+    selector.updateSendCost(0, 0, 0);
+    auto unchanged = sendPackets(selector, 0, CompressionMethod::ZSTD, costs, packets);
+    ASSERT_GT(unchanged[CompressionMethod::ZSTD], packets * 3 / 4);
+}
+
+TEST(ExchangeCompressionSelectorTest, IncompressibleData)
+{
+    ExchangeCompressionSelector selector({ConnectionProfileInfo::InterZoneRemote});
+    const std::map<CompressionMethod, MethodCost> costs{
+        {CompressionMethod::NONE, {1.0, 0.1}},
+        {CompressionMethod::LZ4, {1.0, 0.5}},
+        {CompressionMethod::ZSTD, {1.0, 2.0}},
+    };
+    const size_t packets = 10 * ExchangeCompressionSelector::probe_interval;
+    auto chosen = sendPackets(selector, 0, CompressionMethod::ZSTD, costs, packets);
+    ASSERT_GT(chosen[CompressionMethod::NONE], packets * 3 / 4);
+}
+
+TEST(ExchangeCompressionSelectorTest, BoundedByMaxMethod)
+{
+    ExchangeCompressionSelector selector({ConnectionProfileInfo::InterZoneRemote});
+    const std::map<CompressionMethod, MethodCost> costs{
+        {CompressionMethod::NONE, {1.0, 0.1}},
+        {CompressionMethod::LZ4, {0.5, 0.5}},
+        {CompressionMethod::ZSTD, {0.1, 1.0}},
+    };
+    auto chosen = sendPackets(selector, 0, CompressionMethod::LZ4, costs, 100);
+    ASSERT_EQ(chosen.count(CompressionMethod::ZSTD), 0);
+    ASSERT_GT(chosen[CompressionMethod::LZ4], 75);
+
+    // Methods that are not adaptive are returned as they are.
+    ASSERT_EQ(selector.choose(0, CompressionMethod::NONE), CompressionMethod::NONE);
+    ASSERT_EQ(selector.choose(0, CompressionMethod::Lightweight), CompressionMethod::Lightweight);
+}
+} // namespace DB::tests
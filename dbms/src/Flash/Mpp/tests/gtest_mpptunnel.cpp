@@ -12,10 +12,12 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <Columns/ColumnsNumber.h>
 #include <Common/Exception.h>
 #include <Common/Logger.h>
 #include <Common/LooseBoundedMPMCQueue.h>
 #include <Common/MemoryTracker.h>
+#include <DataTypes/DataTypesNumber.h>
 #include <Flash/EstablishCall.h>
 #include <Flash/Mpp/GRPCReceiverContext.h>
 #include <Flash/Mpp/MPPTunnel.h>
@@ -431,6 +433,26 @@ try
 }
 CATCH
 
+TEST_F(TestMPPTunnel, SyncSendCost)
+try
+{
+    auto mpp_tunnel_ptr = constructRemoteSyncTunnel();
+    std::unique_ptr<PacketWriter> writer_ptr = std::make_unique<MockPacketWriter>();
+    mpp_tunnel_ptr->connectSync(writer_ptr.get());
+    auto first = newDataPacket("First");
+    auto second = newDataPacket("Second");
+    const auto sent_bytes = first->getPacket().ByteSizeLong() + second->getPacket().ByteSizeLong();
+    mpp_tunnel_ptr->write(std::move(first));
+    mpp_tunnel_ptr->write(std::move(second));
+    mpp_tunnel_ptr->writeDone();
+    GTEST_ASSERT_EQ(getTunnelFinishedFlag(mpp_tunnel_ptr), true);
+
+    // The cost is recorded by the sender and reset after being fetched.
+    GTEST_ASSERT_EQ(mpp_tunnel_ptr->fetchSendCost().second, sent_bytes);
+    GTEST_ASSERT_EQ(mpp_tunnel_ptr->fetchSendCost().second, 0);
+}
+CATCH
+
 TEST_F(TestMPPTunnel, SyncConsumerFinish)
 try
 {
@@ -836,6 +858,29 @@ TEST_F(TestMPPTunnel, LocalTunnelForceWrite)
     GTEST_ASSERT_EQ(receiver->getReceivedMsgs().back()->getPacket().data(), "First");
 }
 
+TEST_F(TestMPPTunnel, LocalTunnelWithLocalBlocks)
+try
+{
+    auto [receiver, tunnels] = prepareLocal(1);
+    std::thread t(&MockExchangeReceiver::receiveAll, receiver.get());
+
+    auto column = ColumnUInt64::create();
+    for (UInt64 i = 0; i < 10; ++i)
+        column->insert(Field(i));
+    auto packet = std::make_shared<TrackedMppDataPacket>(MPPDataPacketV1);
+    packet->addLocalBlock(Block{{std::move(column), std::make_shared<DataTypeUInt64>(), "a"}});
+    tunnels[0]->write(packet);
+    tunnels[0]->writeDone();
+    t.join();
+
+    GTEST_ASSERT_EQ(receiver->getReceivedMsgs().size(), 1);
+    const auto & blocks = receiver->getReceivedMsgs().back()->getBlocks(0);
+    GTEST_ASSERT_EQ(blocks.size(), 1);
+    GTEST_ASSERT_EQ(blocks[0]->rows(), 10);
+    GTEST_ASSERT_EQ(receiver->getReceivedMsgs().back()->getByteSize(), packet->getByteSize());
+}
+CATCH
+
 TEST_F(TestMPPTunnel, isWritableTimeout)
 try
 {
@@ -14,6 +14,7 @@
 
 #include <Common/CPUAffinityManager.h>
 #include <Common/Exception.h>
+#include <Common/Stopwatch.h>
 #include <Common/TiFlashMetrics.h>
 #include <Common/setThreadName.h>
 #include <Flash/Pipeline/Schedule/Reactor/WaitReactor.h>
@@ -21,11 +22,22 @@
 #include <Flash/Pipeline/Schedule/Tasks/NotifyFuture.h>
 #include <Flash/Pipeline/Schedule/Tasks/TaskHelper.h>
 #include <common/logger_useful.h>
-#include <errno.h>
-#include <sched.h>
+
+#include <algorithm>
 
 namespace DB
 {
+namespace
+{
+struct LaterPoll
+{
+    bool operator()(const WaitingTask & lhs, const WaitingTask & rhs) const
+    {
+        return lhs.next_poll_ns > rhs.next_poll_ns;
+    }
+};
+} // namespace
+
 WaitReactor::WaitReactor(TaskScheduler & scheduler_)
     : scheduler(scheduler_)
 {
@@ -44,10 +56,10 @@ WaitReactor::WaitReactor(TaskScheduler & scheduler_)
     thread = std::thread(&WaitReactor::loop, this);
 }
 
-bool WaitReactor::awaitAndCollectReadyTask(WaitingTask && task)
+bool WaitReactor::awaitAndCollectReadyTask(WaitingTask & task)
 {
-    assert(task.first);
-    auto * task_ptr = task.second;
+    assert(task.task);
+    auto * task_ptr = task.task.get();
     auto status = task_ptr->await();
     switch (status)
     {
@@ -55,23 +67,23 @@ bool WaitReactor::awaitAndCollectReadyTask(WaitingTask && task)
         return false;
     case ExecTaskStatus::RUNNING:
         task_ptr->profile_info.elapsedAwaitTime();
-        cpu_tasks.push_back(std::move(task.first));
+        cpu_tasks.push_back(std::move(task.task));
         return true;
     case ExecTaskStatus::IO_IN:
     case ExecTaskStatus::IO_OUT:
         task_ptr->profile_info.elapsedAwaitTime();
-        io_tasks.push_back(std::move(task.first));
+        io_tasks.push_back(std::move(task.task));
         return true;
     case ExecTaskStatus::WAIT_FOR_NOTIFY:
         task_ptr->profile_info.elapsedAwaitTime();
-        registerTaskToFuture(std::move(task.first));
+        registerTaskToFuture(std::move(task.task));
         return true;
     case FINISH_STATUS:
         task_ptr->profile_info.elapsedAwaitTime();
         task_ptr->startTraceMemory();
         task_ptr->finalize();
         task_ptr->endTraceMemory();
-        task.first.reset();
+        task.task.reset();
         return true;
     default:
         UNEXPECTED_STATUS(logger, status);
@@ -80,50 +92,16 @@ bool WaitReactor::awaitAndCollectReadyTask(WaitingTask && task)
 
 void WaitReactor::submitReadyTasks()
 {
-    if (cpu_tasks.empty() && io_tasks.empty())
+    if (!cpu_tasks.empty())
     {
-        tryYield();
-        return;
+        scheduler.submitToCPUTaskThreadPool(cpu_tasks);
+        cpu_tasks.clear();
     }
 
-    scheduler.submitToCPUTaskThreadPool(cpu_tasks);
-    cpu_tasks.clear();
-
-    scheduler.submitToIOTaskThreadPool(io_tasks);
-    io_tasks.clear();
-
-    spin_count = 0;
-}
-
-void WaitReactor::tryYield()
-{
-    ++spin_count;
-
-    // spin_count % 16 == 0
-    if ((spin_count & 0xf) == 0)
+    if (!io_tasks.empty())
     {
-#if defined(__x86_64__)
-        _mm_pause();
-#elif defined __aarch64__
-        // A "yield" instruction in aarch64 is essentially a nop, and does
-        // not cause enough delay to help backoff. "isb" is a barrier that,
-        // especially inside a loop, creates a small delay without consuming
-        // ALU resources.  Experiments shown that adding the isb instruction
-        // improves stability and reduces result jitter. Adding more delay
-        // to the UT_RELAX_CPU than a single isb reduces performance.
-        // clang-format off
-        asm volatile("isb" ::: "memory");
-        // clang-format on
-#else
-        // TODO: Maybe there's a better intrinsic like _mm_pause on non-x86_64 architecture.
-        sched_yield();
-#endif
-        if (spin_count == 160)
-        {
-            spin_count = 0;
-            using namespace std::chrono_literals;
-            std::this_thread::sleep_for(2ms);
-        }
+        scheduler.submitToIOTaskThreadPool(io_tasks);
+        io_tasks.clear();
     }
 }
 
@@ -151,31 +129,53 @@ void WaitReactor::submit(std::list<TaskPtr> & tasks)
 bool WaitReactor::takeFromWaitingTaskList(WaitingTasks & local_waiting_tasks)
 {
     std::list<TaskPtr> tmp_list;
-    bool ret = local_waiting_tasks.empty()
-        ? waiting_task_list.take(tmp_list)
-        // If the local waiting tasks are not empty, there is no need to be blocked here
-        // and we can continue to process the leftover tasks in the local waiting tasks
-        : waiting_task_list.tryTake(tmp_list);
+    bool ret = true;
+    if (local_waiting_tasks.empty())
+    {
+        ret = waiting_task_list.take(tmp_list);
+    }
+    else
+    {
+        // If the local waiting tasks are not empty, only wait until the next task is due,
+        // and then continue to process the leftover tasks in the local waiting tasks.
+        const auto now = clock_gettime_ns();
+        const auto next_poll_ns = local_waiting_tasks.front().next_poll_ns;
+        ret = waiting_task_list.tryTake(tmp_list, next_poll_ns > now ? next_poll_ns - now : 0);
+    }
     if unlikely (!ret)
         return false;
 
+    // The new tasks are polled in the next round immediately.
     for (auto & task : tmp_list)
     {
-        auto * task_ptr = task.get();
-        local_waiting_tasks.emplace_back(std::move(task), std::move(task_ptr));
+        local_waiting_tasks.push_back(WaitingTask{.task = std::move(task)});
+        std::push_heap(local_waiting_tasks.begin(), local_waiting_tasks.end(), LaterPoll{});
     }
     return true;
 }
 
 void WaitReactor::react(WaitingTasks & local_waiting_tasks)
 {
-    for (auto task_it = local_waiting_tasks.begin(); task_it != local_waiting_tasks.end();)
+    // Only poll the tasks that are due, the others are left in the heap.
+    const auto now = clock_gettime_ns();
+    while (!local_waiting_tasks.empty() && local_waiting_tasks.front().next_poll_ns <= now)
     {
-        if (awaitAndCollectReadyTask(std::move(*task_it)))
-            task_it = local_waiting_tasks.erase(task_it);
-        else
-            ++task_it;
+        std::pop_heap(local_waiting_tasks.begin(), local_waiting_tasks.end(), LaterPoll{});
+        auto task = std::move(local_waiting_tasks.back());
+        local_waiting_tasks.pop_back();
+        if (!awaitAndCollectReadyTask(task))
+        {
+            task.poll_interval_ns = std::clamp(task.poll_interval_ns * 2, MIN_POLL_INTERVAL_NS, MAX_POLL_INTERVAL_NS);
+            task.next_poll_ns = now + task.poll_interval_ns;
+            polled_tasks.push_back(std::move(task));
+        }
     }
+    for (auto & task : polled_tasks)
+    {
+        local_waiting_tasks.push_back(std::move(task));
+        std::push_heap(local_waiting_tasks.begin(), local_waiting_tasks.end(), LaterPoll{});
+    }
+    polled_tasks.clear();
 
     thread_local auto & metrics = GET_METRIC(tiflash_pipeline_scheduler, type_waiting_tasks_count);
     metrics.Set(local_waiting_tasks.size());
@@ -203,7 +203,16 @@ void WaitReactor::doLoop()
         react(local_waiting_tasks);
     // Handle remaining tasks.
     while (!local_waiting_tasks.empty())
+    {
         react(local_waiting_tasks);
+        if (!local_waiting_tasks.empty())
+        {
+            const auto now = clock_gettime_ns();
+            const auto next_poll_ns = local_waiting_tasks.front().next_poll_ns;
+            if (next_poll_ns > now)
+                std::this_thread::sleep_for(std::chrono::nanoseconds(next_poll_ns - now));
+        }
+    }
 
     LOG_INFO(logger, "wait reactor loop finished");
 }
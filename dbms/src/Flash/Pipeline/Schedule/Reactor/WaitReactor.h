@@ -20,17 +20,31 @@
 
 #include <list>
 #include <thread>
+#include <vector>
 
 namespace DB
 {
 class TaskScheduler;
 
-// hold the `Task *` to avoid the cost of `TaskPtr->get()`
-using WaitingTask = std::pair<TaskPtr, Task *>;
-using WaitingTasks = std::list<WaitingTask>;
-
-/// Used for batch calling task.await and submitting the tasks that have been removed from the waiting state to task thread pools.
-/// When there is no non-waiting state task for a long time, it will try to let the current thread rest for a period of time to give the CPU to other threads.
+struct WaitingTask
+{
+    TaskPtr task;
+    // The time to poll the task next time.
+    UInt64 next_poll_ns = 0;
+    // Doubled each time the task is still waiting after polled.
+    UInt64 poll_interval_ns = 0;
+};
+// A min-heap ordered by `next_poll_ns`.
+using WaitingTasks = std::vector<WaitingTask>;
+
+/// Polls the tasks in `ExecTaskStatus::WAITING`.
+/// The tasks waiting for an event should return `WAIT_FOR_NOTIFY` and register to a `NotifyFuture` instead,
+/// polling is only the fallback for the waiting states having no event to wake up the tasks, such as timeouts.
+///
+/// To avoid burning a core when there are many waiting tasks, a task that keeps waiting is polled less
+/// and less frequently, up to `MAX_POLL_INTERVAL_NS`, and only the tasks due are polled in each round.
+/// `MAX_POLL_INTERVAL_NS` is also the most latency added to a polled task after it becomes ready.
+/// When no task is due, the reactor blocks until the next task is due or new tasks are submitted.
 class WaitReactor
 {
 public:
@@ -46,6 +60,11 @@ public:
 
     void submit(std::list<TaskPtr> & tasks);
 
+public:
+    static constexpr UInt64 MIN_POLL_INTERVAL_NS = 10'000; // 10us
+
+    static constexpr UInt64 MAX_POLL_INTERVAL_NS = 200'000; // 200us
+
 private:
     void loop();
     void doLoop();
@@ -56,12 +75,10 @@ private:
 
     inline void react(WaitingTasks & local_waiting_tasks);
 
-    inline bool awaitAndCollectReadyTask(WaitingTask && task);
+    inline bool awaitAndCollectReadyTask(WaitingTask & task);
 
     inline void submitReadyTasks();
 
-    inline void tryYield();
-
 private:
     LoggerPtr logger = Logger::get();
 
@@ -71,7 +88,8 @@ private:
 
     WaitingTaskList waiting_task_list;
 
-    int16_t spin_count = 0;
+    // The tasks still waiting after polled in the current round.
+    std::vector<WaitingTask> polled_tasks;
     std::vector<TaskPtr> cpu_tasks;
     std::vector<TaskPtr> io_tasks;
 };
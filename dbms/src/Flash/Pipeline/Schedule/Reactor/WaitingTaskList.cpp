@@ -38,9 +38,11 @@ bool WaitingTaskList::take(std::list<TaskPtr> & local_waiting_tasks)
     return true;
 }
 
-bool WaitingTaskList::tryTake(std::list<TaskPtr> & local_waiting_tasks)
+bool WaitingTaskList::tryTake(std::list<TaskPtr> & local_waiting_tasks, UInt64 timeout_ns)
 {
-    std::lock_guard lock(mu);
+    std::unique_lock lock(mu);
+    if (waiting_tasks.empty() && timeout_ns > 0)
+        cv.wait_for(lock, std::chrono::nanoseconds(timeout_ns), [&] { return !waiting_tasks.empty() || is_finished; });
     if (waiting_tasks.empty())
         return !is_finished;
     local_waiting_tasks.splice(local_waiting_tasks.end(), waiting_tasks);
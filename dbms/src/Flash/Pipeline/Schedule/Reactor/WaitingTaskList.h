@@ -27,8 +27,8 @@ public:
     /// return false if the waiting task list had been closed.
     // this function will wait until `!waiting_tasks.empty()`
     bool take(std::list<TaskPtr> & local_waiting_tasks);
-    // this function will return immediately.
-    bool tryTake(std::list<TaskPtr> & local_waiting_tasks);
+    // this function will wait at most `timeout_ns` until `!waiting_tasks.empty()`.
+    bool tryTake(std::list<TaskPtr> & local_waiting_tasks, UInt64 timeout_ns = 0);
 
     void submit(TaskPtr && task);
     void submit(std::list<TaskPtr> & tasks);
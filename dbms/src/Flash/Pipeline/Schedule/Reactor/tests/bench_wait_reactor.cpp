@@ -0,0 +1,93 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Flash/Executor/PipelineExecutorContext.h>
+#include <Flash/Pipeline/Schedule/TaskScheduler.h>
+#include <TestUtils/TiFlashTestBasic.h>
+#include <benchmark/benchmark.h>
+#include <time.h>
+
+#include <atomic>
+#include <thread>
+
+namespace DB::tests
+{
+namespace
+{
+class PollingTask : public Task
+{
+public:
+    PollingTask(PipelineExecutorContext & exec_context_, const std::atomic_bool & ready_)
+        : Task(exec_context_)
+        , ready(ready_)
+    {}
+
+protected:
+    ExecTaskStatus executeImpl() override
+    {
+        return ready.load(std::memory_order_relaxed) ? ExecTaskStatus::FINISHED : ExecTaskStatus::WAITING;
+    }
+
+    ExecTaskStatus awaitImpl() override
+    {
+        return ready.load(std::memory_order_relaxed) ? ExecTaskStatus::RUNNING : ExecTaskStatus::WAITING;
+    }
+
+private:
+    const std::atomic_bool & ready;
+};
+
+UInt64 getProcessCPUTimeNs()
+{
+    timespec ts{};
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1'000'000'000ULL + ts.tv_nsec;
+}
+} // namespace
+
+// The cpu consumed by the wait reactor while all the tasks keep waiting.
+// The thread pools are idle during the measurement, so the process cpu time is spent by the reactor.
+static void waitReactorCPU(benchmark::State & state)
+try
+{
+    const auto task_num = state.range(0);
+    constexpr auto measure_time = std::chrono::milliseconds(200);
+    for (auto _ : state)
+    {
+        PipelineExecutorContext exec_context;
+        std::atomic_bool ready = false;
+        TaskSchedulerConfig config{1, 1};
+        TaskScheduler task_scheduler(config);
+
+        std::vector<TaskPtr> tasks;
+        tasks.reserve(task_num);
+        for (Int64 i = 0; i < task_num; ++i)
+            tasks.push_back(std::make_unique<PollingTask>(exec_context, ready));
+        task_scheduler.submit(tasks);
+
+        const auto cpu_begin = getProcessCPUTimeNs();
+        std::this_thread::sleep_for(measure_time);
+        const auto cpu_ns = getProcessCPUTimeNs() - cpu_begin;
+
+        ready = true;
+        exec_context.wait();
+
+        state.counters["reactor_cpu_ratio"]
+            = static_cast<double>(cpu_ns) / std::chrono::duration_cast<std::chrono::nanoseconds>(measure_time).count();
+    }
+}
+CATCH
+BENCHMARK(waitReactorCPU)->RangeMultiplier(10)->Range(10, 100'000)->Iterations(1)->UseRealTime();
+
+} // namespace DB::tests
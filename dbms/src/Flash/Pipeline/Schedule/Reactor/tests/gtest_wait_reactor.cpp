@@ -0,0 +1,162 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/Stopwatch.h>
+#include <Flash/Executor/PipelineExecutorContext.h>
+#include <Flash/Pipeline/Schedule/Reactor/WaitReactor.h>
+#include <Flash/Pipeline/Schedule/TaskScheduler.h>
+#include <Flash/Pipeline/Schedule/Tasks/OneTimeNotifyFuture.h>
+#include <Flash/ResourceControl/LocalAdmissionController.h>
+#include <TestUtils/TiFlashTestBasic.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+namespace DB::tests
+{
+namespace
+{
+/// Keeps waiting until `wait_ns` elapsed, which can only be polled by the WaitReactor.
+class PolledTask : public Task
+{
+public:
+    PolledTask(PipelineExecutorContext & exec_context_, UInt64 wait_ns_, std::atomic_size_t & await_count_)
+        : Task(exec_context_)
+        , wait_ns(wait_ns_)
+        , await_count(await_count_)
+    {}
+
+protected:
+    ExecTaskStatus executeImpl() override
+    {
+        if (watch.elapsed() < wait_ns)
+            return ExecTaskStatus::WAITING;
+        return ExecTaskStatus::FINISHED;
+    }
+
+    ExecTaskStatus awaitImpl() override
+    {
+        ++await_count;
+        return watch.elapsed() < wait_ns ? ExecTaskStatus::WAITING : ExecTaskStatus::RUNNING;
+    }
+
+private:
+    Stopwatch watch;
+    const UInt64 wait_ns;
+    std::atomic_size_t & await_count;
+};
+
+/// Waits on `future` once, and finishes after being notified.
+class NotifiedTask : public Task
+{
+public:
+    NotifiedTask(PipelineExecutorContext & exec_context_, NotifyFuture & future_, std::atomic_size_t & await_count_)
+        : Task(exec_context_)
+        , future(future_)
+        , await_count(await_count_)
+    {}
+
+protected:
+    ExecTaskStatus executeImpl() override
+    {
+        if (!waited)
+        {
+            waited = true;
+            setNotifyFuture(&future);
+            return ExecTaskStatus::WAIT_FOR_NOTIFY;
+        }
+        return ExecTaskStatus::FINISHED;
+    }
+
+    ExecTaskStatus awaitImpl() override
+    {
+        ++await_count;
+        return ExecTaskStatus::RUNNING;
+    }
+
+private:
+    NotifyFuture & future;
+    std::atomic_size_t & await_count;
+    bool waited = false;
+};
+} // namespace
+
+class WaitReactorTestRunner : public ::testing::Test
+{
+public:
+    static constexpr size_t thread_num = 5;
+
+    void SetUp() override
+    {
+        DB::LocalAdmissionController::global_instance = std::make_unique<DB::MockLocalAdmissionController>();
+        TaskSchedulerConfig config{thread_num, thread_num};
+        assert(!TaskScheduler::instance);
+        TaskScheduler::instance = std::make_unique<TaskScheduler>(config);
+    }
+
+    void TearDown() override
+    {
+        assert(TaskScheduler::instance);
+        TaskScheduler::instance.reset();
+    }
+};
+
+TEST_F(WaitReactorTestRunner, pollWithBackoff)
+try
+{
+    static constexpr UInt64 wait_ns = 50'000'000; // 50ms
+    static constexpr size_t task_num = 10;
+
+    PipelineExecutorContext exec_context;
+    std::atomic_size_t await_count = 0;
+    std::vector<TaskPtr> tasks;
+    for (size_t i = 0; i < task_num; ++i)
+        tasks.push_back(std::make_unique<PolledTask>(exec_context, wait_ns, await_count));
+    Stopwatch watch;
+    TaskScheduler::instance->submit(tasks);
+    exec_context.waitFor(std::chrono::seconds(15));
+
+    // Each task is polled at most once per `MAX_POLL_INTERVAL_NS` after the interval is fully backed off,
+    // instead of once per round of the reactor.
+    const size_t max_polls_per_task = watch.elapsed() / WaitReactor::MAX_POLL_INTERVAL_NS + 64;
+    ASSERT_GT(await_count.load(), 0);
+    ASSERT_LE(await_count.load(), task_num * max_polls_per_task);
+}
+CATCH
+
+TEST_F(WaitReactorTestRunner, notifyWithoutPolling)
+try
+{
+    static constexpr size_t task_num = 10;
+
+    PipelineExecutorContext exec_context;
+    OneTimeNotifyFuture future{NotifyType::WAIT_ON_TABLE_SCAN_READ};
+    std::atomic_size_t await_count = 0;
+    std::vector<TaskPtr> tasks;
+    for (size_t i = 0; i < task_num; ++i)
+        tasks.push_back(std::make_unique<NotifiedTask>(exec_context, future, await_count));
+    TaskScheduler::instance->submit(tasks);
+
+    // The tasks waiting for notification are parked in the future, the WaitReactor never polls them.
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_EQ(await_count.load(), 0);
+
+    future.finish();
+    exec_context.waitFor(std::chrono::seconds(15));
+    ASSERT_EQ(await_count.load(), 0);
+}
+CATCH
+
+} // namespace DB::tests
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <Common/Stopwatch.h>
 #include <Common/ThreadManager.h>
 #include <Flash/Executor/PipelineExecutorContext.h>
 #include <Flash/Pipeline/Schedule/Reactor/WaitingTaskList.h>
@@ -92,4 +93,46 @@ try
 }
 CATCH
 
+TEST_F(TestWaitingTaskList, tryTakeWithTimeout)
+try
+{
+    PipelineExecutorContext context;
+    // To avoid the active ref count being returned to 0 in advance.
+    context.incActiveRefCount();
+    SCOPE_EXIT({ context.decActiveRefCount(); });
+
+    WaitingTaskList list;
+    std::list<TaskPtr> local_list;
+
+    // Return after the timeout if no task is submitted.
+    constexpr UInt64 timeout_ns = 10'000'000;
+    Stopwatch watch;
+    ASSERT_TRUE(list.tryTake(local_list, timeout_ns));
+    ASSERT_TRUE(local_list.empty());
+    ASSERT_GE(watch.elapsed(), timeout_ns);
+
+    // Woken up by the submitted task.
+    constexpr UInt64 long_timeout_ns = 60'000'000'000;
+    auto thread_manager = newThreadManager();
+    thread_manager->schedule(false, "submit", [&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        list.submit(std::make_unique<PlainTask>(context));
+    });
+    ASSERT_TRUE(list.tryTake(local_list, long_timeout_ns));
+    ASSERT_EQ(local_list.size(), 1);
+    FINALIZE_TASK(local_list.front());
+    local_list.clear();
+    thread_manager->wait();
+
+    // Woken up by finish.
+    thread_manager = newThreadManager();
+    thread_manager->schedule(false, "finish", [&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        list.finish();
+    });
+    ASSERT_FALSE(list.tryTake(local_list, long_timeout_ns));
+    thread_manager->wait();
+}
+CATCH
+
 } // namespace DB::tests
@@ -16,6 +16,7 @@
 
 #include <common/types.h>
 
+#include <deque>
 #include <mutex>
 #include <unordered_set>
 
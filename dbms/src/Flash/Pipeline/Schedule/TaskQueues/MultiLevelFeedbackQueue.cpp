@@ -71,31 +71,41 @@ MultiLevelFeedbackQueue<TimeGetter>::~MultiLevelFeedbackQueue()
     drainTaskQueueWithoutLock();
 }
 
-template <typename TimeGetter>
-MultiLevelFeedbackQueue<TimeGetter>::MultiLevelFeedbackQueue()
+std::vector<UnitQueueInfo> createUnitQueueInfos(size_t queue_size, UInt64 level_time_slice_base_ns)
 {
-    UInt64 time_slices[QUEUE_SIZE];
+    std::vector<UInt64> time_slices(queue_size);
     UInt64 time_slice = 0;
-    for (size_t i = 0; i < QUEUE_SIZE; ++i)
+    for (size_t i = 0; i < queue_size; ++i)
     {
-        time_slice += LEVEL_TIME_SLICE_BASE_NS * (i + 1);
+        time_slice += level_time_slice_base_ns * (i + 1);
         time_slices[i] = time_slice;
     }
 
     static constexpr double RATIO_OF_ADJACENT_QUEUE = 1.2;
-    double factors[QUEUE_SIZE];
+    std::vector<double> factors(queue_size);
     double factor = 1;
-    for (int i = QUEUE_SIZE - 1; i >= 0; --i)
+    for (size_t i = queue_size; i > 0; --i)
     {
         // Initialize factor for every unit queue.
         // Higher priority queues have more execution time,
         // so they should have a larger factor.
-        factors[i] = factor;
+        factors[i - 1] = factor;
         factor *= RATIO_OF_ADJACENT_QUEUE;
     }
 
+    std::vector<UnitQueueInfo> infos;
+    infos.reserve(queue_size);
+    for (size_t i = 0; i < queue_size; ++i)
+        infos.emplace_back(time_slices[i], factors[i]);
+    return infos;
+}
+
+template <typename TimeGetter>
+MultiLevelFeedbackQueue<TimeGetter>::MultiLevelFeedbackQueue()
+{
+    const auto infos = createUnitQueueInfos(QUEUE_SIZE, LEVEL_TIME_SLICE_BASE_NS);
     for (size_t i = 0; i < QUEUE_SIZE; ++i)
-        level_queues[i] = std::make_unique<UnitQueue>(time_slices[i], factors[i]);
+        level_queues[i] = std::make_unique<UnitQueue>(infos[i].time_slice, infos[i].factor_for_normal);
 }
 
 template <typename TimeGetter>
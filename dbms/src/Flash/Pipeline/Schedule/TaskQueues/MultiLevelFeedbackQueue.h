@@ -22,6 +22,7 @@
 #include <atomic>
 #include <deque>
 #include <mutex>
+#include <vector>
 
 namespace DB
 {
@@ -69,6 +70,10 @@ struct UnitQueueInfo
     double factor_for_normal;
 };
 
+// Create the infos of `queue_size` unit queues, from high priority to low priority.
+// The time slice of the i-th level is (i+1)*level_time_slice_base_ns more than the (i-1)-th level.
+std::vector<UnitQueueInfo> createUnitQueueInfos(size_t queue_size, UInt64 level_time_slice_base_ns);
+
 class UnitQueue
 {
 public:
@@ -17,6 +17,7 @@
 #include <Flash/Pipeline/Schedule/TaskQueues/IOPriorityQueue.h>
 #include <Flash/Pipeline/Schedule/TaskQueues/MultiLevelFeedbackQueue.h>
 #include <Flash/Pipeline/Schedule/TaskQueues/ResourceControlQueue.h>
+#include <Flash/Pipeline/Schedule/TaskQueues/WorkStealingMultiLevelFeedbackQueue.h>
 #include <Flash/Pipeline/Schedule/Tasks/TaskHelper.h>
 
 namespace DB
@@ -69,7 +70,7 @@ void ResourceControlQueue<NestedTaskQueueType>::submitWithoutLock(TaskPtr && tas
     auto iter = resource_group_task_queues.find(name_with_keyspace_id);
     if (iter == resource_group_task_queues.end())
     {
-        auto task_queue = std::make_shared<NestedTaskQueueType>();
+        auto task_queue = nested_task_queue_creator();
         auto priority = LocalAdmissionController::global_instance->getPriority(keyspace_id, name);
         if unlikely (!priority.has_value())
         {
@@ -284,6 +285,7 @@ void ResourceControlQueue<NestedTaskQueueType>::mustTakeTask(const NestedTaskQue
 }
 
 template class ResourceControlQueue<CPUMultiLevelFeedbackQueue>;
+template class ResourceControlQueue<CPUWorkStealingMultiLevelFeedbackQueue>;
 // For now, io_task_thread_pool is not managed by ResourceControl mechanism.
 template class ResourceControlQueue<IOPriorityQueue>;
 } // namespace DB
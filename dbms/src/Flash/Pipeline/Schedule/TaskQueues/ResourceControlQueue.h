@@ -18,6 +18,7 @@
 #include <Flash/Pipeline/Schedule/TaskQueues/TaskQueue.h>
 #include <Flash/ResourceControl/LocalAdmissionController.h>
 
+#include <functional>
 #include <mutex>
 
 namespace DB
@@ -28,7 +29,11 @@ class ResourceControlQueue
     , private boost::noncopyable
 {
 public:
-    ResourceControlQueue()
+    using NestedTaskQueueCreator = std::function<std::shared_ptr<NestedTaskQueueType>()>;
+
+    explicit ResourceControlQueue(
+        NestedTaskQueueCreator nested_task_queue_creator_ = [] { return std::make_shared<NestedTaskQueueType>(); })
+        : nested_task_queue_creator(std::move(nested_task_queue_creator_))
     {
         RUNTIME_CHECK_MSG(
             LocalAdmissionController::global_instance != nullptr,
@@ -95,6 +100,9 @@ private:
     void mustEraseResourceGroupInfoWithoutLock(const KeyspaceID & keyspace_id, const String & name);
     static void mustTakeTask(const NestedTaskQueuePtr & task_queue, TaskPtr & task);
 
+    // Create the nested task queue of a resource group.
+    const NestedTaskQueueCreator nested_task_queue_creator;
+
     mutable std::mutex mu;
     std::condition_variable cv;
 
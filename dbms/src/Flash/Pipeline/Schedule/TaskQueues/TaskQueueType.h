@@ -22,5 +22,6 @@ enum class TaskQueueType
     MLFQ, // multi-level feedback queue
     IO_PRIORITY, // io priority queue
     RCQ_MLFQ, // resource control queue nesting MLFQ.
+    WS_MLFQ, // MLFQ with per-worker shards and work stealing, nested in the resource control queue for cpu.
 };
 } // namespace DB
@@ -0,0 +1,394 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/Exception.h>
+#include <Flash/Pipeline/Schedule/TaskQueues/WorkStealingMultiLevelFeedbackQueue.h>
+#include <Flash/Pipeline/Schedule/Tasks/TaskHelper.h>
+#include <assert.h>
+#include <common/likely.h>
+
+#include <algorithm>
+#include <iterator>
+
+namespace DB
+{
+namespace
+{
+// The registry and the index of the worker running in the current thread.
+// A thread is the worker of at most one registry.
+struct WorkerInfo
+{
+    const WorkStealingWorkerRegistry * registry = nullptr;
+    size_t index = 0;
+};
+thread_local WorkerInfo current_worker;
+} // namespace
+
+template <typename TimeGetter>
+WorkStealingMultiLevelFeedbackQueue<TimeGetter>::WorkStealingMultiLevelFeedbackQueue(
+    size_t worker_num,
+    WorkStealingWorkerRegistryPtr worker_registry_)
+    : level_infos(createUnitQueueInfos(QUEUE_SIZE, LEVEL_TIME_SLICE_BASE_NS))
+    , worker_registry(std::move(worker_registry_))
+{
+    RUNTIME_CHECK(worker_num > 0 && worker_registry);
+    shards.reserve(worker_num);
+    for (size_t i = 0; i < worker_num; ++i)
+        shards.push_back(std::make_unique<Shard>());
+}
+
+template <typename TimeGetter>
+WorkStealingMultiLevelFeedbackQueue<TimeGetter>::~WorkStealingMultiLevelFeedbackQueue()
+{
+    drainTaskQueue();
+}
+
+template <typename TimeGetter>
+void WorkStealingMultiLevelFeedbackQueue<TimeGetter>::computeQueueLevel(const TaskPtr & task) const
+{
+    auto time_spent = TimeGetter::get(task);
+    // level will only increment.
+    for (size_t i = task->mlfq_level; i < QUEUE_SIZE; ++i)
+    {
+        if (time_spent < level_infos[i].time_slice)
+        {
+            task->mlfq_level = i;
+            return;
+        }
+    }
+    task->mlfq_level = QUEUE_SIZE - 1;
+}
+
+template <typename TimeGetter>
+size_t WorkStealingMultiLevelFeedbackQueue<TimeGetter>::chooseSubmitShard()
+{
+    if (current_worker.registry == worker_registry.get())
+        return current_worker.index % shards.size();
+    return next_submit_shard.fetch_add(1, std::memory_order_relaxed) % shards.size();
+}
+
+template <typename TimeGetter>
+size_t WorkStealingMultiLevelFeedbackQueue<TimeGetter>::registerWorker()
+{
+    if (current_worker.registry != worker_registry.get())
+    {
+        current_worker.registry = worker_registry.get();
+        current_worker.index = worker_registry->next_worker.fetch_add(1, std::memory_order_relaxed);
+    }
+    return current_worker.index % shards.size();
+}
+
+template <typename TimeGetter>
+void WorkStealingMultiLevelFeedbackQueue<TimeGetter>::submitToShard(Shard & shard, TaskPtr && task)
+{
+    assert(task);
+    std::lock_guard lock(shard.mu);
+    if unlikely (shard.cancel_query_id_cache.contains(task->getQueryId()))
+    {
+        shard.cancel_task_queue.push_back(std::move(task));
+        ++shard.cancel_size;
+        ++cancel_task_count;
+    }
+    else
+    {
+        const auto level = task->mlfq_level;
+        shard.level_queues[level].push_back(std::move(task));
+        ++shard.level_sizes[level];
+        ++level_task_counts[level];
+    }
+}
+
+template <typename TimeGetter>
+void WorkStealingMultiLevelFeedbackQueue<TimeGetter>::notifyIdleWorkers(size_t task_num)
+{
+    // Pairs with the `++idle_workers` and `hasTask()` in `take`, a worker either sees the new tasks
+    // before blocking or is counted here.
+    const auto idle = idle_workers.load();
+    if (idle == 0)
+        return;
+
+    std::lock_guard lock(idle_mu);
+    if (task_num >= idle)
+    {
+        idle_cv.notify_all();
+    }
+    else
+    {
+        for (size_t i = 0; i < task_num; ++i)
+            idle_cv.notify_one();
+    }
+}
+
+template <typename TimeGetter>
+void WorkStealingMultiLevelFeedbackQueue<TimeGetter>::submit(TaskPtr && task)
+{
+    if unlikely (is_finished)
+    {
+        FINALIZE_TASK(task);
+        return;
+    }
+
+    computeQueueLevel(task);
+    submitToShard(*shards[chooseSubmitShard()], std::move(task));
+    assert(!task);
+    notifyIdleWorkers(1);
+}
+
+template <typename TimeGetter>
+void WorkStealingMultiLevelFeedbackQueue<TimeGetter>::submit(std::vector<TaskPtr> & tasks)
+{
+    if (tasks.empty())
+        return;
+
+    if unlikely (is_finished)
+    {
+        FINALIZE_TASKS(tasks);
+        return;
+    }
+
+    // Spread the tasks to all shards, so that they can be taken by the workers in parallel.
+    for (auto & task : tasks)
+    {
+        computeQueueLevel(task);
+        const auto shard = next_submit_shard.fetch_add(1, std::memory_order_relaxed) % shards.size();
+        submitToShard(*shards[shard], std::move(task));
+    }
+    notifyIdleWorkers(tasks.size());
+}
+
+template <typename TimeGetter>
+bool WorkStealingMultiLevelFeedbackQueue<TimeGetter>::tryTakeCancelled(Shard & shard, TaskPtr & task)
+{
+    if (shard.cancel_size.load(std::memory_order_relaxed) == 0)
+        return false;
+
+    std::lock_guard lock(shard.mu);
+    if (!popTask(shard.cancel_task_queue, task))
+        return false;
+    --shard.cancel_size;
+    --cancel_task_count;
+    return true;
+}
+
+template <typename TimeGetter>
+bool WorkStealingMultiLevelFeedbackQueue<TimeGetter>::tryTakeLevel(Shard & shard, size_t level, TaskPtr & task)
+{
+    if (shard.level_sizes[level].load(std::memory_order_relaxed) == 0)
+        return false;
+
+    std::lock_guard lock(shard.mu);
+    if (!popTask(shard.level_queues[level], task))
+        return false;
+    --shard.level_sizes[level];
+    --level_task_counts[level];
+    return true;
+}
+
+template <typename TimeGetter>
+bool WorkStealingMultiLevelFeedbackQueue<TimeGetter>::tryTake(size_t worker_shard, TaskPtr & task)
+{
+    const size_t shard_num = shards.size();
+    if (cancel_task_count.load() > 0)
+    {
+        for (size_t i = 0; i < shard_num; ++i)
+        {
+            if (tryTakeCancelled(*shards[(worker_shard + i) % shard_num], task))
+                return true;
+        }
+    }
+
+    // Find the levels having tasks, ordered by the normalized execution time.
+    std::array<size_t, QUEUE_SIZE> levels{};
+    std::array<double, QUEUE_SIZE> normalized_time_microsecond{};
+    size_t level_num = 0;
+    for (size_t i = 0; i < QUEUE_SIZE; ++i)
+    {
+        if (level_task_counts[i].load() > 0)
+        {
+            normalized_time_microsecond[i] = accu_consume_time_microsecond[i] / level_infos[i].factor_for_normal;
+            levels[level_num++] = i;
+        }
+    }
+    std::stable_sort(levels.begin(), levels.begin() + level_num, [&](size_t lhs, size_t rhs) {
+        return normalized_time_microsecond[lhs] < normalized_time_microsecond[rhs];
+    });
+
+    // Take from the own shard first, then steal from the others.
+    for (size_t i = 0; i < level_num; ++i)
+    {
+        for (size_t j = 0; j < shard_num; ++j)
+        {
+            if (tryTakeLevel(*shards[(worker_shard + j) % shard_num], levels[i], task))
+                return true;
+        }
+    }
+    return false;
+}
+
+template <typename TimeGetter>
+bool WorkStealingMultiLevelFeedbackQueue<TimeGetter>::hasTask() const
+{
+    if (cancel_task_count.load() > 0)
+        return true;
+    for (const auto & count : level_task_counts)
+    {
+        if (count.load() > 0)
+            return true;
+    }
+    return false;
+}
+
+template <typename TimeGetter>
+bool WorkStealingMultiLevelFeedbackQueue<TimeGetter>::take(TaskPtr & task)
+{
+    assert(!task);
+    const size_t worker_shard = registerWorker();
+    while (true)
+    {
+        // Remaining tasks will be drained in destructor.
+        if (unlikely(is_finished))
+            return false;
+
+        if (tryTake(worker_shard, task))
+        {
+            assert(task);
+            return true;
+        }
+
+        std::unique_lock lock(idle_mu);
+        ++idle_workers;
+        idle_cv.wait(lock, [&] { return is_finished || hasTask(); });
+        --idle_workers;
+    }
+}
+
+template <typename TimeGetter>
+void WorkStealingMultiLevelFeedbackQueue<TimeGetter>::drainTaskQueue()
+{
+    TaskPtr task;
+    for (auto & shard : shards)
+    {
+        while (popTask(shard->cancel_task_queue, task))
+        {
+            FINALIZE_TASK(task);
+        }
+        for (auto & level_queue : shard->level_queues)
+        {
+            while (popTask(level_queue, task))
+            {
+                FINALIZE_TASK(task);
+            }
+        }
+    }
+}
+
+template <typename TimeGetter>
+void WorkStealingMultiLevelFeedbackQueue<TimeGetter>::updateStatistics(
+    const TaskPtr & task,
+    ExecTaskStatus,
+    UInt64 inc_ns)
+{
+    assert(task);
+    accu_consume_time_microsecond[task->mlfq_level] += (inc_ns / 1000);
+}
+
+template <typename TimeGetter>
+bool WorkStealingMultiLevelFeedbackQueue<TimeGetter>::empty() const
+{
+    return !hasTask();
+}
+
+template <typename TimeGetter>
+void WorkStealingMultiLevelFeedbackQueue<TimeGetter>::finish()
+{
+    {
+        std::lock_guard lock(idle_mu);
+        is_finished = true;
+    }
+    idle_cv.notify_all();
+}
+
+template <typename TimeGetter>
+const UnitQueueInfo & WorkStealingMultiLevelFeedbackQueue<TimeGetter>::getUnitQueueInfo(size_t level) const
+{
+    assert(level < QUEUE_SIZE);
+    return level_infos[level];
+}
+
+template <typename TimeGetter>
+void WorkStealingMultiLevelFeedbackQueue<TimeGetter>::cancel(const TaskCancelInfo & cancel_info)
+{
+    if unlikely (cancel_info.query_id.empty())
+        return;
+
+    bool has_new_cancelled = false;
+    for (auto & shard : shards)
+    {
+        std::lock_guard lock(shard->mu);
+        if (!shard->cancel_query_id_cache.add(cancel_info.query_id))
+            continue;
+        has_new_cancelled = true;
+        const auto cancelled = moveCancelledTasks(*shard, shard->cancel_task_queue, cancel_info.query_id);
+        shard->cancel_size += cancelled;
+        cancel_task_count += cancelled;
+    }
+
+    if (has_new_cancelled)
+    {
+        std::lock_guard lock(idle_mu);
+        idle_cv.notify_all();
+    }
+}
+
+template <typename TimeGetter>
+void WorkStealingMultiLevelFeedbackQueue<TimeGetter>::collectCancelledTasks(
+    std::deque<TaskPtr> & cancel_queue,
+    const String & query_id)
+{
+    for (auto & shard : shards)
+    {
+        std::lock_guard lock(shard->mu);
+        moveCancelledTasks(*shard, cancel_queue, query_id);
+    }
+}
+
+template <typename TimeGetter>
+Int64 WorkStealingMultiLevelFeedbackQueue<TimeGetter>::moveCancelledTasks(
+    Shard & shard,
+    std::deque<TaskPtr> & cancel_queue,
+    const String & query_id)
+{
+    Int64 total_cancelled = 0;
+    for (size_t level = 0; level < QUEUE_SIZE; ++level)
+    {
+        auto & level_queue = shard.level_queues[level];
+        auto it = std::stable_partition(level_queue.begin(), level_queue.end(), [&](const TaskPtr & task) {
+            return task->getQueryId() != query_id;
+        });
+        const auto cancelled = static_cast<Int64>(level_queue.end() - it);
+        if (cancelled == 0)
+            continue;
+        std::move(it, level_queue.end(), std::back_inserter(cancel_queue));
+        level_queue.erase(it, level_queue.end());
+        shard.level_sizes[level] -= cancelled;
+        level_task_counts[level] -= cancelled;
+        total_cancelled += cancelled;
+    }
+    return total_cancelled;
+}
+
+template class WorkStealingMultiLevelFeedbackQueue<CPUTimeGetter>;
+template class WorkStealingMultiLevelFeedbackQueue<IOTimeGetter>;
+
+} // namespace DB
@@ -0,0 +1,154 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Flash/Pipeline/Schedule/TaskQueues/FIFOQueryIdCache.h>
+#include <Flash/Pipeline/Schedule/TaskQueues/MultiLevelFeedbackQueue.h>
+#include <Flash/Pipeline/Schedule/TaskQueues/TaskQueue.h>
+#include <absl/base/optimization.h>
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace DB
+{
+/// Assigns the threads taking tasks to the shards. The queues taken by the same workers share one registry,
+/// e.g. the queues of all resource groups nested in a `ResourceControlQueue`, so that a worker uses the
+/// same shard of every queue.
+struct WorkStealingWorkerRegistry
+{
+    std::atomic_size_t next_worker = 0;
+};
+using WorkStealingWorkerRegistryPtr = std::shared_ptr<WorkStealingWorkerRegistry>;
+
+/// A multi-level feedback queue split into one shard per worker.
+///
+/// `MultiLevelFeedbackQueue` guards all the tasks by one mutex, so the lock and the wakeups become
+/// the bottleneck when there are many workers executing short tasks. Here each worker submits
+/// the tasks it yields to its own shard and takes tasks from its own shard first, and steals
+/// from the other shards when its own shard has no task of the chosen level.
+///
+/// The scheduling is the same as `MultiLevelFeedbackQueue`:
+/// - The execution time of each level is accounted globally, and the level is chosen by
+///   the global normalized execution time among the levels having tasks in any shard.
+/// - The tasks of the cancelled queries are taken before other tasks.
+///
+/// The workers only block on the shared condition variable when there is no task in any shard,
+/// and the submitters only notify it when some worker is blocked.
+///
+/// The queue is not aware of resource groups. To schedule the tasks by the priority and RU of resource groups,
+/// nest it in `ResourceControlQueue`, which picks the resource group and then takes from its work-stealing queue.
+template <typename TimeGetter>
+class WorkStealingMultiLevelFeedbackQueue : public TaskQueue
+{
+public:
+    explicit WorkStealingMultiLevelFeedbackQueue(
+        size_t worker_num,
+        WorkStealingWorkerRegistryPtr worker_registry_ = std::make_shared<WorkStealingWorkerRegistry>());
+
+    ~WorkStealingMultiLevelFeedbackQueue() override;
+
+    void submit(TaskPtr && task) override;
+
+    void submit(std::vector<TaskPtr> & tasks) override;
+
+    bool take(TaskPtr & task) override;
+
+    void updateStatistics(const TaskPtr & task, ExecTaskStatus, UInt64 inc_ns) override;
+
+    bool empty() const override;
+
+    void finish() override;
+
+    void cancel(const TaskCancelInfo & cancel_info) override;
+
+    // Called by `ResourceControlQueue`, which keeps the cancelled query ids itself.
+    void collectCancelledTasks(std::deque<TaskPtr> & cancel_queue, const String & query_id);
+
+    const UnitQueueInfo & getUnitQueueInfo(size_t level) const;
+
+    size_t getShardNum() const { return shards.size(); }
+
+public:
+    static constexpr size_t QUEUE_SIZE = MultiLevelFeedbackQueue<TimeGetter>::QUEUE_SIZE;
+
+    static constexpr int64_t LEVEL_TIME_SLICE_BASE_NS = MultiLevelFeedbackQueue<TimeGetter>::LEVEL_TIME_SLICE_BASE_NS;
+
+private:
+    struct alignas(ABSL_CACHELINE_SIZE) Shard
+    {
+        std::mutex mu;
+        std::array<std::deque<TaskPtr>, QUEUE_SIZE> level_queues;
+        // The size of each level queue, can be read without locking `mu` to skip empty queues quickly.
+        std::array<std::atomic<Int64>, QUEUE_SIZE> level_sizes{};
+
+        // Every shard keeps the cancelled query ids, so that submitting doesn't need a global lock.
+        FIFOQueryIdCache cancel_query_id_cache;
+        std::deque<TaskPtr> cancel_task_queue;
+        std::atomic<Int64> cancel_size = 0;
+    };
+
+    void computeQueueLevel(const TaskPtr & task) const;
+
+    // The shard of the current thread if it is a worker taking tasks from this queue,
+    // otherwise the shards are chosen in round-robin.
+    size_t chooseSubmitShard();
+
+    size_t registerWorker();
+
+    void submitToShard(Shard & shard, TaskPtr && task);
+
+    bool tryTake(size_t worker_shard, TaskPtr & task);
+
+    bool tryTakeCancelled(Shard & shard, TaskPtr & task);
+
+    bool tryTakeLevel(Shard & shard, size_t level, TaskPtr & task);
+
+    bool hasTask() const;
+
+    void notifyIdleWorkers(size_t task_num);
+
+    void drainTaskQueue();
+
+    // Move the tasks of the query from the level queues of the shard, the lock of the shard must be held.
+    Int64 moveCancelledTasks(Shard & shard, std::deque<TaskPtr> & cancel_queue, const String & query_id);
+
+private:
+    const std::vector<UnitQueueInfo> level_infos;
+    std::array<std::atomic_uint64_t, QUEUE_SIZE> accu_consume_time_microsecond{};
+    // The number of tasks in each level of all shards, used to choose the level to take.
+    std::array<std::atomic<Int64>, QUEUE_SIZE> level_task_counts{};
+    std::atomic<Int64> cancel_task_count = 0;
+
+    std::vector<std::unique_ptr<Shard>> shards;
+    std::atomic_size_t next_submit_shard = 0;
+    const WorkStealingWorkerRegistryPtr worker_registry;
+
+    // Only used to block the workers when there is no task in any shard.
+    mutable std::mutex idle_mu;
+    std::condition_variable idle_cv;
+    std::atomic_size_t idle_workers = 0;
+    std::atomic_bool is_finished = false;
+};
+
+using CPUWorkStealingMultiLevelFeedbackQueue = WorkStealingMultiLevelFeedbackQueue<CPUTimeGetter>;
+using IOWorkStealingMultiLevelFeedbackQueue = WorkStealingMultiLevelFeedbackQueue<IOTimeGetter>;
+
+} // namespace DB
@@ -14,11 +14,13 @@
 
 #include <Flash/Executor/PipelineExecutorContext.h>
 #include <Flash/Pipeline/Schedule/TaskQueues/MultiLevelFeedbackQueue.h>
+#include <Flash/Pipeline/Schedule/TaskQueues/WorkStealingMultiLevelFeedbackQueue.h>
 #include <Flash/Pipeline/Schedule/TaskScheduler.h>
 #include <TestUtils/TiFlashTestBasic.h>
 #include <benchmark/benchmark.h>
 
 #include <random>
+#include <thread>
 
 namespace DB
 {
@@ -112,5 +114,82 @@ BENCHMARK_REGISTER_F(ResourceContorlQueue, Basic)
     ->Args({10, 1, 1, 10000, 2}) // 10000 * 1 * 2 / 10 = 2s
     ->Args({10, 15, 15, 1000, 2}) // 1000 * 15 * 2 / 10 = 3s
     ->Args({10, 200, 200, 1000, 2}); // 1000 * 200 * 2 / 10 = 40s
+
+class ShortTask : public Task
+{
+public:
+    ShortTask(PipelineExecutorContext & exec_context, size_t round_num_)
+        : Task(exec_context)
+        , round_num(round_num_)
+    {}
+
+    ExecTaskStatus executeImpl() override { return ExecTaskStatus::FINISHED; }
+
+    size_t round_num;
+};
+
+// The workers take and resubmit very short tasks without executing them,
+// so that the cost of the task queue itself dominates.
+void taskQueueScaling(benchmark::State & state, TaskQueuePtr (*new_task_queue)(size_t))
+try
+{
+    const size_t worker_num = state.range(0);
+    constexpr size_t task_num_per_worker = 4;
+    constexpr size_t round_num = 1000;
+    const size_t task_num = worker_num * task_num_per_worker;
+
+    for (auto _ : state)
+    {
+        PipelineExecutorContext exec_context;
+        // To avoid the active ref count being returned to 0 in advance.
+        exec_context.incActiveRefCount();
+        SCOPE_EXIT({ exec_context.decActiveRefCount(); });
+
+        auto task_queue = new_task_queue(worker_num);
+        std::vector<TaskPtr> tasks;
+        for (size_t i = 0; i < task_num; ++i)
+            tasks.push_back(std::make_unique<ShortTask>(exec_context, round_num));
+        task_queue->submit(tasks);
+
+        std::atomic_size_t finished_task_num = 0;
+        std::vector<std::thread> workers;
+        for (size_t i = 0; i < worker_num; ++i)
+        {
+            workers.emplace_back([&]() {
+                TaskPtr task;
+                while (task_queue->take(task))
+                {
+                    task_queue->updateStatistics(task, ExecTaskStatus::RUNNING, 1000);
+                    if (--static_cast<ShortTask &>(*task).round_num > 0)
+                    {
+                        task_queue->submit(std::move(task));
+                        continue;
+                    }
+                    FINALIZE_TASK(task);
+                    if (finished_task_num.fetch_add(1) + 1 == task_num)
+                        task_queue->finish();
+                }
+            });
+        }
+        for (auto & worker : workers)
+            worker.join();
+    }
+    state.SetItemsProcessed(state.iterations() * task_num * round_num);
+}
+CATCH
+
+BENCHMARK_CAPTURE(taskQueueScaling, MLFQ, [](size_t) -> TaskQueuePtr {
+    return std::make_unique<CPUMultiLevelFeedbackQueue>();
+})
+    ->RangeMultiplier(2)
+    ->Range(8, 128)
+    ->UseRealTime();
+
+BENCHMARK_CAPTURE(taskQueueScaling, WS_MLFQ, [](size_t worker_num) -> TaskQueuePtr {
+    return std::make_unique<CPUWorkStealingMultiLevelFeedbackQueue>(worker_num);
+})
+    ->RangeMultiplier(2)
+    ->Range(8, 128)
+    ->UseRealTime();
 } // namespace tests
 } // namespace DB
@@ -304,7 +304,7 @@ public:
         EXPECT_TRUE(rate3 > 1);
     }
 
-    void testLargeRUSmallCPU(bool static_token_bucket)
+    void testLargeRUSmallCPU(bool static_token_bucket, TaskQueueType cpu_queue_type = TaskQueueType::DEFAULT)
     {
         std::vector<ResourceGroupPtr> resource_groups;
         // RU proportion is 1:5:10.
@@ -331,7 +331,7 @@ public:
         {
             const int thread_num = 3;
 
-            TaskSchedulerConfig config{thread_num, thread_num};
+            TaskSchedulerConfig config{{thread_num, cpu_queue_type}, thread_num};
             TaskScheduler task_scheduler(config);
 
             task_scheduler.submit(tasks);
@@ -520,6 +520,11 @@ TEST_F(TestResourceControlQueue, LargeRUSmallCPUDynamicTokenBucket)
 {
     testLargeRUSmallCPU(false);
 }
+// The work-stealing queues are nested in the resource control queue, so the cpu time is also proportional to RU.
+TEST_F(TestResourceControlQueue, LargeRUSmallCPUWorkStealingMLFQ)
+{
+    testLargeRUSmallCPU(false, TaskQueueType::WS_MLFQ);
+}
 
 // Both RU and cpu resource is enough.
 // Expect all tasks should run ok, and RCQ should effect the execution of tasks.
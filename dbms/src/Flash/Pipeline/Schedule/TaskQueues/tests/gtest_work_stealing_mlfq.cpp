@@ -0,0 +1,282 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/ThreadManager.h>
+#include <Flash/Executor/PipelineExecutorContext.h>
+#include <Flash/Pipeline/Schedule/TaskQueues/WorkStealingMultiLevelFeedbackQueue.h>
+#include <Flash/Pipeline/Schedule/Tasks/TaskHelper.h>
+#include <TestUtils/TiFlashTestBasic.h>
+#include <gtest/gtest.h>
+
+namespace DB::tests
+{
+namespace
+{
+class PlainTask : public Task
+{
+public:
+    explicit PlainTask(PipelineExecutorContext & exec_context_)
+        : Task(exec_context_)
+    {}
+
+    ExecTaskStatus executeImpl() noexcept override { return ExecTaskStatus::FINISHED; }
+};
+} // namespace
+
+class TestWorkStealingMLFQTaskQueue : public ::testing::Test
+{
+};
+
+TEST_F(TestWorkStealingMLFQTaskQueue, init)
+try
+{
+    PipelineExecutorContext context;
+    // To avoid the active ref count being returned to 0 in advance.
+    context.incActiveRefCount();
+    SCOPE_EXIT({ context.decActiveRefCount(); });
+
+    TaskQueuePtr queue = std::make_unique<CPUWorkStealingMultiLevelFeedbackQueue>(4);
+    size_t valid_task_num = 1000;
+    // submit
+    for (size_t i = 0; i < valid_task_num; ++i)
+        queue->submit(std::make_unique<PlainTask>(context));
+    // take, the tasks in other shards are stolen.
+    for (size_t i = 0; i < valid_task_num; ++i)
+    {
+        TaskPtr task;
+        queue->take(task);
+        ASSERT_EQ(task->mlfq_level, 0);
+        FINALIZE_TASK(task);
+    }
+    ASSERT_TRUE(queue->empty());
+    queue->finish();
+    // No tasks can be submitted after the queue is finished.
+    queue->submit(std::make_unique<PlainTask>(context));
+    TaskPtr task;
+    ASSERT_FALSE(queue->take(task));
+}
+CATCH
+
+TEST_F(TestWorkStealingMLFQTaskQueue, multiWorkers)
+try
+{
+    PipelineExecutorContext context;
+    // To avoid the active ref count being returned to 0 in advance.
+    context.incActiveRefCount();
+    SCOPE_EXIT({ context.decActiveRefCount(); });
+
+    constexpr size_t worker_num = 8;
+    CPUWorkStealingMultiLevelFeedbackQueue queue(worker_num);
+
+    // Each task is taken and resubmitted by the workers for several rounds.
+    constexpr size_t task_num = 100;
+    constexpr size_t round_num = 100;
+    std::vector<TaskPtr> tasks;
+    for (size_t i = 0; i < task_num; ++i)
+        tasks.push_back(std::make_unique<PlainTask>(context));
+    queue.submit(tasks);
+
+    std::atomic_size_t take_count = 0;
+    auto thread_manager = newThreadManager();
+    for (size_t i = 0; i < worker_num; ++i)
+    {
+        thread_manager->schedule(false, "take", [&]() {
+            TaskPtr task;
+            while (queue.take(task))
+            {
+                ASSERT_TRUE(task);
+                queue.updateStatistics(task, ExecTaskStatus::RUNNING, 1000);
+                const auto count = take_count.fetch_add(1) + 1;
+                if (count <= task_num * (round_num - 1))
+                {
+                    queue.submit(std::move(task));
+                }
+                else
+                {
+                    FINALIZE_TASK(task);
+                    if (count == task_num * round_num)
+                        queue.finish();
+                }
+            }
+        });
+    }
+    thread_manager->wait();
+    ASSERT_EQ(take_count, task_num * round_num);
+    ASSERT_TRUE(queue.empty());
+}
+CATCH
+
+TEST_F(TestWorkStealingMLFQTaskQueue, level)
+try
+{
+    PipelineExecutorContext context;
+    // To avoid the active ref count being returned to 0 in advance.
+    context.incActiveRefCount();
+    SCOPE_EXIT({ context.decActiveRefCount(); });
+
+    CPUWorkStealingMultiLevelFeedbackQueue queue(4);
+    TaskPtr task = std::make_unique<PlainTask>(context);
+    queue.submit(std::move(task));
+    for (size_t level = 0; level < CPUWorkStealingMultiLevelFeedbackQueue::QUEUE_SIZE; ++level)
+    {
+        while (queue.take(task))
+        {
+            ASSERT_EQ(task->mlfq_level, level);
+            ASSERT_TRUE(task);
+            auto value = CPUWorkStealingMultiLevelFeedbackQueue::LEVEL_TIME_SLICE_BASE_NS;
+            queue.updateStatistics(task, ExecTaskStatus::RUNNING, value);
+            task->profile_info.addCPUExecuteTime(value);
+            bool need_break = CPUTimeGetter::get(task) >= queue.getUnitQueueInfo(level).time_slice;
+            queue.submit(std::move(task));
+            if (need_break)
+                break;
+        }
+    }
+    queue.take(task);
+    ASSERT_TRUE(queue.empty());
+    ASSERT_EQ(task->mlfq_level, CPUWorkStealingMultiLevelFeedbackQueue::QUEUE_SIZE - 1);
+    FINALIZE_TASK(task);
+    queue.finish();
+}
+CATCH
+
+TEST_F(TestWorkStealingMLFQTaskQueue, feedback)
+try
+{
+    PipelineExecutorContext context;
+    // To avoid the active ref count being returned to 0 in advance.
+    context.incActiveRefCount();
+    SCOPE_EXIT({ context.decActiveRefCount(); });
+
+    CPUWorkStealingMultiLevelFeedbackQueue queue(4);
+
+    // The tasks of level `0` are spread to all shards by the batch submit,
+    // but the level is still chosen by the global execution time.
+    size_t task_num = 1000;
+    std::vector<TaskPtr> tasks;
+    for (size_t i = 0; i < task_num; ++i)
+    {
+        // level `0`
+        TaskPtr task = std::make_unique<PlainTask>(context);
+        auto value = queue.getUnitQueueInfo(0).time_slice - 1;
+        queue.updateStatistics(task, ExecTaskStatus::RUNNING, value);
+        task->profile_info.addCPUExecuteTime(value);
+        tasks.push_back(std::move(task));
+    }
+    queue.submit(tasks);
+    {
+        // level `QUEUE_SIZE - 1`
+        TaskPtr task = std::make_unique<PlainTask>(context);
+        task->mlfq_level = CPUWorkStealingMultiLevelFeedbackQueue::QUEUE_SIZE - 1;
+        auto value = queue.getUnitQueueInfo(task->mlfq_level).time_slice;
+        queue.updateStatistics(task, ExecTaskStatus::RUNNING, value);
+        task->profile_info.addCPUExecuteTime(value);
+        queue.submit(std::move(task));
+    }
+    // the first task will be level `QUEUE_SIZE - 1`.
+    {
+        TaskPtr task;
+        queue.take(task);
+        ASSERT_EQ(task->mlfq_level, CPUWorkStealingMultiLevelFeedbackQueue::QUEUE_SIZE - 1);
+        FINALIZE_TASK(task);
+    }
+    for (size_t i = 0; i < task_num; ++i)
+    {
+        TaskPtr task;
+        queue.take(task);
+        ASSERT_EQ(task->mlfq_level, 0);
+        FINALIZE_TASK(task);
+    }
+    ASSERT_TRUE(queue.empty());
+    queue.finish();
+}
+CATCH
+
+TEST_F(TestWorkStealingMLFQTaskQueue, cancel)
+try
+{
+    PipelineExecutorContext context1("id1", "", nullptr);
+    // To avoid the active ref count being returned to 0 in advance.
+    context1.incActiveRefCount();
+    SCOPE_EXIT({ context1.decActiveRefCount(); });
+
+    PipelineExecutorContext context2("id2", "", nullptr);
+    // To avoid the active ref count being returned to 0 in advance.
+    context2.incActiveRefCount();
+    SCOPE_EXIT({ context2.decActiveRefCount(); });
+
+    // case1 submit first.
+    {
+        CPUWorkStealingMultiLevelFeedbackQueue queue(4);
+        queue.submit(std::make_unique<PlainTask>(context1));
+        queue.submit(std::make_unique<PlainTask>(context2));
+        queue.cancel(TaskCancelInfo{.query_id = "id2"});
+        TaskPtr task;
+        ASSERT_TRUE(!queue.empty());
+        queue.take(task);
+        ASSERT_EQ(task->getQueryId(), "id2");
+        FINALIZE_TASK(task);
+        ASSERT_TRUE(!queue.empty());
+        queue.take(task);
+        ASSERT_EQ(task->getQueryId(), "id1");
+        FINALIZE_TASK(task);
+    }
+
+    // case2 cancel first.
+    {
+        CPUWorkStealingMultiLevelFeedbackQueue queue(4);
+        queue.cancel(TaskCancelInfo{.query_id = "id2"});
+        queue.submit(std::make_unique<PlainTask>(context1));
+        queue.submit(std::make_unique<PlainTask>(context2));
+        TaskPtr task;
+        ASSERT_TRUE(!queue.empty());
+        queue.take(task);
+        ASSERT_EQ(task->getQueryId(), "id2");
+        FINALIZE_TASK(task);
+        ASSERT_TRUE(!queue.empty());
+        queue.take(task);
+        ASSERT_EQ(task->getQueryId(), "id1");
+        FINALIZE_TASK(task);
+    }
+
+    // case3 collect the cancelled tasks like ResourceControlQueue.
+    {
+        CPUWorkStealingMultiLevelFeedbackQueue queue(4);
+        for (size_t i = 0; i < 10; ++i)
+        {
+            queue.submit(std::make_unique<PlainTask>(context1));
+            queue.submit(std::make_unique<PlainTask>(context2));
+        }
+        std::deque<TaskPtr> cancel_queue;
+        queue.collectCancelledTasks(cancel_queue, "id2");
+        ASSERT_EQ(cancel_queue.size(), 10U);
+        for (auto & task : cancel_queue)
+        {
+            ASSERT_EQ(task->getQueryId(), "id2");
+            FINALIZE_TASK(task);
+        }
+        for (size_t i = 0; i < 10; ++i)
+        {
+            TaskPtr task;
+            ASSERT_TRUE(!queue.empty());
+            queue.take(task);
+            ASSERT_EQ(task->getQueryId(), "id1");
+            FINALIZE_TASK(task);
+        }
+        ASSERT_TRUE(queue.empty());
+    }
+}
+CATCH
+
+} // namespace DB::tests
@@ -13,28 +13,69 @@
 // limitations under the License.
 
 #include <Common/Exception.h>
+#include <Common/TiFlashMetrics.h>
 #include <Flash/Pipeline/Schedule/TaskScheduler.h>
 #include <Flash/Pipeline/Schedule/Tasks/TaskHelper.h>
 #include <assert.h>
 #include <common/likely.h>
 
+#include <algorithm>
 #include <magic_enum.hpp>
 
 namespace DB
 {
 TaskScheduler::TaskScheduler(const TaskSchedulerConfig & config)
-    : cpu_task_thread_pool(*this, config.cpu_task_thread_pool_config)
+    : cpu_task_thread_pools(newCPUTaskThreadPools(*this, config))
     , io_task_thread_pool(*this, config.io_task_thread_pool_config)
     , wait_reactor(*this)
-{}
+{
+    if (cpu_task_thread_pools.size() > 1)
+        LOG_INFO(
+            logger,
+            "cpu task thread pool is split by numa nodes, numa_nodes={} pool_size={}",
+            cpu_task_thread_pools.size(),
+            config.cpu_task_thread_pool_config.pool_size);
+}
+
+std::vector<std::unique_ptr<TaskThreadPool<CPUImpl>>> TaskScheduler::newCPUTaskThreadPools(
+    TaskScheduler & scheduler,
+    const TaskSchedulerConfig & config)
+{
+    // The gauges are shared by all the pools, reset them once before any thread is started.
+    TaskThreadPoolMetrics<true>::resetGauges();
+    TaskThreadPoolMetrics<false>::resetGauges();
+
+    std::vector<std::unique_ptr<TaskThreadPool<CPUImpl>>> pools;
+    const auto & cpu_config = config.cpu_task_thread_pool_config;
+    const auto & numa_nodes = config.cpu_numa_nodes;
+    if (numa_nodes.size() <= 1)
+    {
+        pools.push_back(std::make_unique<TaskThreadPool<CPUImpl>>(scheduler, cpu_config));
+        return pools;
+    }
+
+    // Split the threads evenly among the numa nodes, the remainder is handed to the first nodes,
+    // so the total number of threads is the same as `pool_size`. Each node has at least one thread.
+    const size_t base_size = cpu_config.pool_size / numa_nodes.size();
+    const size_t remainder = cpu_config.pool_size % numa_nodes.size();
+    for (size_t i = 0; i < numa_nodes.size(); ++i)
+    {
+        ThreadPoolConfig node_config{std::max<size_t>(base_size + (i < remainder ? 1 : 0), 1), cpu_config.queue_type};
+        node_config.cpus = numa_nodes[i];
+        pools.push_back(std::make_unique<TaskThreadPool<CPUImpl>>(scheduler, node_config));
+    }
+    return pools;
+}
 
 TaskScheduler::~TaskScheduler()
 {
-    cpu_task_thread_pool.finish();
+    for (auto & cpu_task_thread_pool : cpu_task_thread_pools)
+        cpu_task_thread_pool->finish();
     io_task_thread_pool.finish();
     wait_reactor.finish();
 
-    cpu_task_thread_pool.waitForStop();
+    for (auto & cpu_task_thread_pool : cpu_task_thread_pools)
+        cpu_task_thread_pool->waitForStop();
     io_task_thread_pool.waitForStop();
     wait_reactor.waitForStop();
 }
@@ -99,14 +140,81 @@ void TaskScheduler::submitToWaitReactor(TaskPtr && task)
     wait_reactor.submit(std::move(task));
 }
 
+size_t TaskScheduler::chooseCPUTaskThreadPool(Task & task)
+{
+    const size_t pool_num = cpu_task_thread_pools.size();
+    if (likely(pool_num == 1))
+        return 0;
+
+    auto get_load = [&](size_t i) {
+        const auto & pool = *cpu_task_thread_pools[i];
+        return static_cast<double>(pool.getActiveTaskNum()) / pool.getThreadNum();
+    };
+
+    if (task.numa_node < 0)
+    {
+        // The first time the task is scheduled, choose the least loaded node.
+        // The blocks produced by its source operator will be allocated in the memory of that node.
+        const size_t start = next_cpu_task_thread_pool.fetch_add(1, std::memory_order_relaxed);
+        size_t chosen = start % pool_num;
+        auto min_load = get_load(chosen);
+        for (size_t i = 1; i < pool_num && min_load > 0; ++i)
+        {
+            const size_t candidate = (start + i) % pool_num;
+            if (auto load = get_load(candidate); load < min_load)
+            {
+                chosen = candidate;
+                min_load = load;
+            }
+        }
+        task.numa_node = chosen;
+        return chosen;
+    }
+
+    const auto preferred = static_cast<size_t>(task.numa_node);
+    assert(preferred < pool_num);
+    // Keep the task on its node unless there are more active tasks than threads,
+    // and only move it to a node having idle threads.
+    if (get_load(preferred) <= 1)
+        return preferred;
+    for (size_t i = 1; i < pool_num; ++i)
+    {
+        const size_t candidate = (preferred + i) % pool_num;
+        if (get_load(candidate) < 1)
+        {
+            task.numa_node = candidate;
+            GET_METRIC(tiflash_pipeline_numa_task_migration, type_cross_node).Increment();
+            return candidate;
+        }
+    }
+    return preferred;
+}
+
 void TaskScheduler::submitToCPUTaskThreadPool(TaskPtr && task)
 {
-    cpu_task_thread_pool.submit(std::move(task));
+    const auto pool = chooseCPUTaskThreadPool(*task);
+    cpu_task_thread_pools[pool]->submit(std::move(task));
 }
 
 void TaskScheduler::submitToCPUTaskThreadPool(std::vector<TaskPtr> & tasks)
 {
-    cpu_task_thread_pool.submit(tasks);
+    if (likely(cpu_task_thread_pools.size() == 1))
+    {
+        cpu_task_thread_pools[0]->submit(tasks);
+        return;
+    }
+
+    std::vector<std::vector<TaskPtr>> pool_tasks(cpu_task_thread_pools.size());
+    for (auto & task : tasks)
+    {
+        const auto pool = chooseCPUTaskThreadPool(*task);
+        pool_tasks[pool].push_back(std::move(task));
+    }
+    for (size_t i = 0; i < pool_tasks.size(); ++i)
+    {
+        if (!pool_tasks[i].empty())
+            cpu_task_thread_pools[i]->submit(pool_tasks[i]);
+    }
 }
 
 void TaskScheduler::submitToIOTaskThreadPool(TaskPtr && task)
@@ -121,7 +229,8 @@ void TaskScheduler::submitToIOTaskThreadPool(std::vector<TaskPtr> & tasks)
 
 void TaskScheduler::cancel(const TaskCancelInfo & cancel_info)
 {
-    cpu_task_thread_pool.cancel(cancel_info);
+    for (auto & cpu_task_thread_pool : cpu_task_thread_pools)
+        cpu_task_thread_pool->cancel(cancel_info);
     io_task_thread_pool.cancel(cancel_info);
 }
 
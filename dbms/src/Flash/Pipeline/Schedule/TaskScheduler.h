@@ -20,19 +20,27 @@
 #include <Flash/Pipeline/Schedule/ThreadPool/TaskThreadPool.h>
 #include <Flash/Pipeline/Schedule/ThreadPool/TaskThreadPoolImpl.h>
 
+#include <atomic>
+#include <memory>
+#include <vector>
+
 namespace DB
 {
 struct TaskSchedulerConfig
 {
     ThreadPoolConfig cpu_task_thread_pool_config;
     ThreadPoolConfig io_task_thread_pool_config;
+    // The cpus of each numa node. If there are more than one node, the cpu task thread pool is split
+    // into one pool per node, and the threads of each pool are bound to the cpus of its node.
+    std::vector<std::vector<int>> cpu_numa_nodes{};
 
     String toString() const
     {
         return fmt::format(
-            "cpu: {}, io: {}",
+            "cpu: {}, io: {}, cpu_numa_nodes: {}",
             cpu_task_thread_pool_config.toString(),
-            io_task_thread_pool_config.toString());
+            io_task_thread_pool_config.toString(),
+            cpu_numa_nodes.size());
     }
 };
 
@@ -58,6 +66,10 @@ struct TaskSchedulerConfig
  * - cpu task thread pool: for operator cpu intensive compute.
  * - io task thread pool: for operator io intensive block.
  * - wait reactor: for polling asynchronous io status, etc.
+ *
+ * The cpu task thread pool can be split by numa nodes, a task keeps running on the node it is first
+ * scheduled to, so that the blocks it produces and consumes stay in the local memory of that node.
+ * A task only migrates to another node when its node is overloaded and the other node has idle threads.
  */
 class TaskScheduler
 {
@@ -79,8 +91,20 @@ public:
 
     static std::unique_ptr<TaskScheduler> instance;
 
+    size_t getCPUTaskThreadPoolNum() const { return cpu_task_thread_pools.size(); }
+
+private:
+    // Called before the other members are initialized, see the declaration order of the members.
+    static std::vector<std::unique_ptr<TaskThreadPool<CPUImpl>>> newCPUTaskThreadPools(
+        TaskScheduler & scheduler,
+        const TaskSchedulerConfig & config);
+
+    size_t chooseCPUTaskThreadPool(Task & task);
+
 private:
-    TaskThreadPool<CPUImpl> cpu_task_thread_pool;
+    // One pool for each numa node. Must be the first member, the metric gauges are reset when creating them.
+    std::vector<std::unique_ptr<TaskThreadPool<CPUImpl>>> cpu_task_thread_pools;
+    std::atomic_size_t next_cpu_task_thread_pool = 0;
 
     TaskThreadPool<IOImpl> io_task_thread_pool;
 
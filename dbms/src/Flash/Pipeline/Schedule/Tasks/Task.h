@@ -150,6 +150,10 @@ public:
     // level of multi-level feedback queue.
     size_t mlfq_level{0};
 
+    // The numa node whose cpu task thread pool runs this task, -1 means not decided yet.
+    // See `TaskScheduler::chooseCPUTaskThreadPool`.
+    Int32 numa_node{-1};
+
 private:
     PipelineExecutorContext & exec_context;
 
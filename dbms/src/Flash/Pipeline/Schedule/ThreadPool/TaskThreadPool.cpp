@@ -22,6 +22,7 @@
 #include <Flash/Pipeline/Schedule/Tasks/TaskTimer.h>
 #include <Flash/Pipeline/Schedule/ThreadPool/TaskThreadPool.h>
 #include <Flash/Pipeline/Schedule/ThreadPool/TaskThreadPoolImpl.h>
+#include <Storages/DeltaMerge/ReadThread/CPU.h>
 #include <common/likely.h>
 #include <common/logger_useful.h>
 
@@ -31,8 +32,9 @@ namespace DB
 {
 template <typename Impl>
 TaskThreadPool<Impl>::TaskThreadPool(TaskScheduler & scheduler_, const ThreadPoolConfig & config)
-    : task_queue(Impl::newTaskQueue(config.queue_type))
+    : task_queue(Impl::newTaskQueue(config.queue_type, config.pool_size))
     , scheduler(scheduler_)
+    , cpus(config.cpus)
 {
     RUNTIME_CHECK(config.pool_size > 0);
     threads.reserve(config.pool_size);
@@ -60,6 +62,9 @@ void TaskThreadPool<Impl>::loop(size_t thread_no)
     try
     {
         CPUAffinityManager::getInstance().bindSelfQueryThread();
+        // The numa binding takes precedence over the query thread binding.
+        if (!cpus.empty())
+            DM::setCPUAffinity(cpus, logger);
         doLoop(thread_no);
     }
     CATCH_AND_TERMINATE(logger)
@@ -111,6 +116,7 @@ void TaskThreadPool<Impl>::handleTask(TaskPtr & task)
     task_queue->updateStatistics(task, status_before_exec, timer.executing_time);
     metrics.addExecuteTime(task, timer.executing_time);
     metrics.decExecutingTask();
+    active_task_num.fetch_sub(1, std::memory_order_relaxed);
     switch (status_after_exec)
     {
     case ExecTaskStatus::RUNNING:
@@ -144,6 +150,7 @@ template <typename Impl>
 void TaskThreadPool<Impl>::submit(TaskPtr && task)
 {
     metrics.incPendingTask(1);
+    active_task_num.fetch_add(1, std::memory_order_relaxed);
     task_queue->submit(std::move(task));
 }
 
@@ -151,6 +158,7 @@ template <typename Impl>
 void TaskThreadPool<Impl>::submit(std::vector<TaskPtr> & tasks)
 {
     metrics.incPendingTask(tasks.size());
+    active_task_num.fetch_add(tasks.size(), std::memory_order_relaxed);
     task_queue->submit(tasks);
 }
 
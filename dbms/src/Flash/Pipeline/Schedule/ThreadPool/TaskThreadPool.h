@@ -20,6 +20,7 @@
 #include <Flash/Pipeline/Schedule/Tasks/Task.h>
 #include <Flash/Pipeline/Schedule/ThreadPool/TaskThreadPoolMetrics.h>
 
+#include <atomic>
 #include <magic_enum.hpp>
 #include <thread>
 #include <vector>
@@ -42,6 +43,8 @@ struct ThreadPoolConfig
 
     size_t pool_size;
     TaskQueueType queue_type = TaskQueueType::DEFAULT;
+    // Bind the threads of the pool to these cpus if not empty.
+    std::vector<int> cpus;
 
     String toString() const
     {
@@ -67,6 +70,11 @@ public:
 
     void cancel(const TaskCancelInfo & cancel_info);
 
+    size_t getThreadNum() const { return threads.size(); }
+
+    // The number of tasks pending or executing in this pool.
+    size_t getActiveTaskNum() const { return active_task_num.load(std::memory_order_relaxed); }
+
 private:
     void loop(size_t thread_no);
     void doLoop(size_t thread_no);
@@ -82,6 +90,10 @@ private:
 
     std::vector<std::thread> threads;
 
+    const std::vector<int> cpus;
+
+    std::atomic_size_t active_task_num = 0;
+
     TaskThreadPoolMetrics<Impl::is_cpu> metrics;
 };
 
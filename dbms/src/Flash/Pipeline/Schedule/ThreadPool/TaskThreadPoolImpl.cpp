@@ -16,13 +16,14 @@
 #include <Flash/Pipeline/Schedule/TaskQueues/IOPriorityQueue.h>
 #include <Flash/Pipeline/Schedule/TaskQueues/MultiLevelFeedbackQueue.h>
 #include <Flash/Pipeline/Schedule/TaskQueues/ResourceControlQueue.h>
+#include <Flash/Pipeline/Schedule/TaskQueues/WorkStealingMultiLevelFeedbackQueue.h>
 #include <Flash/Pipeline/Schedule/ThreadPool/TaskThreadPoolImpl.h>
 
 #include <magic_enum.hpp>
 
 namespace DB
 {
-TaskQueuePtr CPUImpl::newTaskQueue(TaskQueueType type)
+TaskQueuePtr CPUImpl::newTaskQueue(TaskQueueType type, size_t worker_num)
 {
     switch (type)
     {
@@ -32,12 +33,18 @@ TaskQueuePtr CPUImpl::newTaskQueue(TaskQueueType type)
         return std::make_unique<ResourceControlQueue<CPUMultiLevelFeedbackQueue>>();
     case TaskQueueType::MLFQ:
         return std::make_unique<CPUMultiLevelFeedbackQueue>();
+    // The work-stealing queues of resource groups share the shards of workers.
+    case TaskQueueType::WS_MLFQ:
+        return std::make_unique<ResourceControlQueue<CPUWorkStealingMultiLevelFeedbackQueue>>(
+            [worker_num, worker_registry = std::make_shared<WorkStealingWorkerRegistry>()] {
+                return std::make_shared<CPUWorkStealingMultiLevelFeedbackQueue>(worker_num, worker_registry);
+            });
     default:
         throw Exception(fmt::format("Unsupported queue type: {}", magic_enum::enum_name(type)));
     }
 }
 
-TaskQueuePtr IOImpl::newTaskQueue(TaskQueueType type)
+TaskQueuePtr IOImpl::newTaskQueue(TaskQueueType type, size_t worker_num)
 {
     switch (type)
     {
@@ -47,6 +54,8 @@ TaskQueuePtr IOImpl::newTaskQueue(TaskQueueType type)
         return std::make_unique<IOPriorityQueue>();
     case TaskQueueType::MLFQ:
         return std::make_unique<IOMultiLevelFeedbackQueue>();
+    case TaskQueueType::WS_MLFQ:
+        return std::make_unique<IOWorkStealingMultiLevelFeedbackQueue>(worker_num);
     default:
         throw Exception(fmt::format("Unsupported queue type: {}", magic_enum::enum_name(type)));
     }
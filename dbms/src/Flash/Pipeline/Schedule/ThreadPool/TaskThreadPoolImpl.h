@@ -31,7 +31,7 @@ struct CPUImpl
 
     static ExecTaskStatus exec(TaskPtr & task) { return task->execute(); }
 
-    static TaskQueuePtr newTaskQueue(TaskQueueType type);
+    static TaskQueuePtr newTaskQueue(TaskQueueType type, size_t worker_num);
 };
 
 struct IOImpl
@@ -47,6 +47,6 @@ struct IOImpl
 
     static ExecTaskStatus exec(TaskPtr & task) { return task->executeIO(); }
 
-    static TaskQueuePtr newTaskQueue(TaskQueueType type);
+    static TaskQueuePtr newTaskQueue(TaskQueueType type, size_t worker_num);
 };
 } // namespace DB
@@ -65,7 +65,7 @@ namespace DB
     } while (0)
 
 template <bool is_cpu>
-TaskThreadPoolMetrics<is_cpu>::TaskThreadPoolMetrics()
+void TaskThreadPoolMetrics<is_cpu>::resetGauges()
 {
     SET_METRIC(pending_tasks_count, 0);
     SET_METRIC(executing_tasks_count, 0);
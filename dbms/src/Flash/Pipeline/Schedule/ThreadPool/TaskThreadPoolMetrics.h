@@ -24,7 +24,9 @@ template <bool is_cpu>
 class TaskThreadPoolMetrics
 {
 public:
-    TaskThreadPoolMetrics();
+    // The gauges are shared by all the pools of the same kind, so they are reset once by the
+    // `TaskScheduler` before any pool is created, instead of by each pool.
+    static void resetGauges();
 
     void incPendingTask(size_t task_count);
 
@@ -14,12 +14,16 @@
 
 #include <Common/Exception.h>
 #include <Common/MemoryTrackerSetter.h>
+#include <Common/TiFlashMetrics.h>
 #include <Flash/Executor/PipelineExecutorContext.h>
 #include <Flash/Pipeline/Schedule/TaskScheduler.h>
 #include <Flash/ResourceControl/LocalAdmissionController.h>
 #include <TestUtils/TiFlashTestBasic.h>
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <thread>
+
 namespace DB::tests
 {
 namespace
@@ -159,6 +163,31 @@ protected:
     }
 };
 
+class NumaNodeCheckTask : public Task
+{
+public:
+    explicit NumaNodeCheckTask(PipelineExecutorContext & exec_context_)
+        : Task(exec_context_)
+    {}
+
+    static constexpr Int32 numa_node_num = 2;
+
+protected:
+    ExecTaskStatus executeImpl() override
+    {
+        // The numa node is decided before the task is executed by the cpu task thread pool.
+        RUNTIME_CHECK(numa_node >= 0 && numa_node < numa_node_num, numa_node);
+        if ((--loop_count) > 0)
+            return (loop_count % 2) == 0 ? ExecTaskStatus::IO_IN : ExecTaskStatus::RUNNING;
+        return ExecTaskStatus::FINISHED;
+    }
+
+    ExecTaskStatus executeIOImpl() override { return ExecTaskStatus::RUNNING; }
+
+private:
+    int loop_count = 10 + random() % 10;
+};
+
 class DeadLoopTask : public Task
 {
 public:
@@ -181,9 +210,16 @@ public:
     static constexpr size_t thread_num = 5;
 
     static void submitAndWait(std::vector<TaskPtr> & tasks, PipelineExecutorContext & exec_context)
+    {
+        submitAndWait(tasks, exec_context, TaskSchedulerConfig{thread_num, thread_num});
+    }
+
+    static void submitAndWait(
+        std::vector<TaskPtr> & tasks,
+        PipelineExecutorContext & exec_context,
+        const TaskSchedulerConfig & config)
     {
         DB::LocalAdmissionController::global_instance = std::make_unique<DB::MockLocalAdmissionController>();
-        TaskSchedulerConfig config{thread_num, thread_num};
         TaskScheduler task_scheduler{config};
         task_scheduler.submit(tasks);
         std::chrono::seconds timeout(15);
@@ -234,6 +270,42 @@ try
 }
 CATCH
 
+TEST_F(TaskSchedulerTestRunner, numaNodes)
+try
+{
+    // The cpus are not bound in the test.
+    TaskSchedulerConfig config{thread_num, thread_num};
+    config.cpu_numa_nodes.resize(NumaNodeCheckTask::numa_node_num);
+    for (size_t task_num = 1; task_num < 100; ++task_num)
+    {
+        PipelineExecutorContext exec_context;
+        std::vector<TaskPtr> tasks;
+        for (size_t i = 0; i < task_num; ++i)
+            tasks.push_back(std::make_unique<NumaNodeCheckTask>(exec_context));
+        submitAndWait(tasks, exec_context, config);
+        ASSERT_FALSE(exec_context.getExceptionPtr()) << exec_context.getExceptionMsg();
+    }
+}
+CATCH
+
+TEST_F(TaskSchedulerTestRunner, numaNodesPoolSize)
+try
+{
+    DB::LocalAdmissionController::global_instance = std::make_unique<DB::MockLocalAdmissionController>();
+    // 5 threads on 3 nodes, the first two nodes get one more thread.
+    TaskSchedulerConfig config{5, 1};
+    config.cpu_numa_nodes.resize(3);
+    TaskScheduler task_scheduler{config};
+    ASSERT_EQ(task_scheduler.getCPUTaskThreadPoolNum(), 3);
+
+    // The gauge is not reset by the pools created later, it counts the threads of all the pools.
+    auto & pool_size_gauge = GET_METRIC(tiflash_pipeline_scheduler, type_cpu_task_thread_pool_size);
+    for (size_t i = 0; i < 1000 && pool_size_gauge.Value() != 5; ++i)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    ASSERT_EQ(pool_size_gauge.Value(), 5);
+}
+CATCH
+
 TEST_F(TaskSchedulerTestRunner, shutdown)
 try
 {
@@ -29,12 +29,31 @@
 #include <Flash/Planner/Plans/PhysicalAggregation.h>
 #include <Flash/Planner/Plans/PhysicalAggregationBuild.h>
 #include <Flash/Planner/Plans/PhysicalAggregationConvergent.h>
+#include <Flash/Planner/Plans/PhysicalTableScan.h>
 #include <Interpreters/Context.h>
 #include <Operators/AutoPassThroughAggregateTransform.h>
 #include <Operators/LocalAggregateTransform.h>
 
 namespace DB
 {
+namespace
+{
+/// Estimate the number of distinct keys when grouping by a single column of the table scan, 0 if unknown.
+/// The hash table is converted to two level after the keys exceed the threshold, so it is enough to reserve
+/// up to the threshold.
+size_t estimateKeyCount(const Context & context, const PhysicalPlanNodePtr & child, const Names & aggregation_keys)
+{
+    if (aggregation_keys.size() != 1)
+        return 0;
+    auto table_scan = std::dynamic_pointer_cast<PhysicalTableScan>(child);
+    if (!table_scan)
+        return 0;
+    return std::min<size_t>(
+        table_scan->estimateNDV(context, aggregation_keys.front()),
+        context.getSettingsRef().group_by_two_level_threshold);
+}
+} // namespace
+
 PhysicalPlanNodePtr PhysicalAggregation::build(
     const Context & context,
     const String & executor_id,
@@ -111,7 +130,8 @@ PhysicalPlanNodePtr PhysicalAggregation::build(
         AggregationInterpreterHelper::isFinalAgg(aggregation),
         auto_pass_through_switcher,
         aggregate_descriptions,
-        expr_after_agg_actions);
+        expr_after_agg_actions,
+        estimateKeyCount(context, child, aggregation_keys));
     return physical_agg;
 }
 
@@ -148,6 +168,7 @@ void PhysicalAggregation::buildBlockInputStreamImpl(DAGPipeline & pipeline, Cont
         aggregate_descriptions,
         is_final_agg,
         spill_config);
+    params.estimated_key_count = estimated_key_count;
 
     if (fine_grained_shuffle.enabled())
     {
@@ -301,6 +322,7 @@ void PhysicalAggregation::buildPipelineExecGroupImpl(
         aggregate_descriptions,
         is_final_agg,
         spill_config);
+    params.estimated_key_count = estimated_key_count;
     if (fine_grained_shuffle.enabled())
     {
         group_builder.transform([&](auto & builder) {
@@ -47,7 +47,8 @@ public:
         bool is_final_agg_,
         AutoPassThroughSwitcher auto_pass_through_switcher_,
         const AggregateDescriptions & aggregate_descriptions_,
-        const ExpressionActionsPtr & expr_after_agg_)
+        const ExpressionActionsPtr & expr_after_agg_,
+        size_t estimated_key_count_)
         : PhysicalUnary(executor_id_, PlanType::Aggregation, schema_, fine_grained_shuffle_, req_id, child_)
         , before_agg_actions(before_agg_actions_)
         , aggregation_keys(aggregation_keys_)
@@ -58,6 +59,7 @@ public:
         , auto_pass_through_switcher(auto_pass_through_switcher_)
         , aggregate_descriptions(aggregate_descriptions_)
         , expr_after_agg(expr_after_agg_)
+        , estimated_key_count(estimated_key_count_)
     {}
 
     void buildPipeline(PipelineBuilder & builder, Context & context, PipelineExecutorContext & exec_context) override;
@@ -85,5 +87,7 @@ private:
     const AutoPassThroughSwitcher auto_pass_through_switcher;
     AggregateDescriptions aggregate_descriptions;
     ExpressionActionsPtr expr_after_agg;
+    // Estimated by the column statistics of the table scan, 0 if unknown.
+    size_t estimated_key_count;
 };
 } // namespace DB
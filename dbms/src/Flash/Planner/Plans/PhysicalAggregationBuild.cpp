@@ -66,6 +66,7 @@ void PhysicalAggregationBuild::buildPipelineExecGroupImpl(
         aggregate_descriptions,
         is_final_agg,
         spill_config);
+    params->estimated_key_count = estimated_key_count;
     assert(aggregate_context);
     aggregate_context->initBuild(
         *params,
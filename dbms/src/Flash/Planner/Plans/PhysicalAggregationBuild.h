@@ -42,7 +42,8 @@ public:
         const AggFuncRefKeyMap & agg_func_ref_key_,
         bool is_final_agg_,
         const AggregateDescriptions & aggregate_descriptions_,
-        const AggregateContextPtr & aggregate_context_)
+        const AggregateContextPtr & aggregate_context_,
+        size_t estimated_key_count_)
         : PhysicalUnary(executor_id_, PlanType::AggregationBuild, schema_, FineGrainedShuffle{}, req_id, child_)
         , before_agg_actions(before_agg_actions_)
         , aggregation_keys(aggregation_keys_)
@@ -52,6 +53,7 @@ public:
         , is_final_agg(is_final_agg_)
         , aggregate_descriptions(aggregate_descriptions_)
         , aggregate_context(aggregate_context_)
+        , estimated_key_count(estimated_key_count_)
     {
         // The profile info of Aggregation is collected by PhysicalAggregationConvergent,
         // so calling notTiDBoPerator for PhysicalAggregationBuild to skip collecting profile info.
@@ -78,6 +80,7 @@ private:
     bool is_final_agg;
     AggregateDescriptions aggregate_descriptions;
     AggregateContextPtr aggregate_context;
+    size_t estimated_key_count;
 
     OperatorProfileInfos profile_infos;
 };
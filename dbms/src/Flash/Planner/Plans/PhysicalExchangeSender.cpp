@@ -27,6 +27,15 @@
 
 namespace DB
 {
+namespace
+{
+// Only local tunnel version 2 hands packets to the receiver directly, so blocks can be passed without serialization.
+bool enableLocalZeroCopy(const Settings & settings)
+{
+    return settings.enable_local_tunnel_zero_copy && settings.local_tunnel_version == 2;
+}
+} // namespace
+
 PhysicalPlanNodePtr PhysicalExchangeSender::build(
     const String & executor_id,
     const LoggerPtr & log,
@@ -95,6 +104,8 @@ void PhysicalExchangeSender::buildBlockInputStreamImpl(DAGPipeline & pipeline, C
             fine_grained_shuffle.batch_size,
             compression_mode,
             context.getSettingsRef().batch_send_min_limit_compression,
+            context.getSettingsRef().enable_mpp_exchange_adaptive_compression,
+            enableLocalZeroCopy(context.getSettingsRef()),
             log->identifier());
         stream
             = std::make_shared<ExchangeSenderBlockInputStream>(stream, std::move(response_writer), log->identifier());
@@ -132,6 +143,8 @@ void PhysicalExchangeSender::buildPipelineExecGroupImpl(
             fine_grained_shuffle.batch_size,
             compression_mode,
             context.getSettingsRef().batch_send_min_limit_compression,
+            context.getSettingsRef().enable_mpp_exchange_adaptive_compression,
+            enableLocalZeroCopy(context.getSettingsRef()),
             log->identifier(),
             /*is_async=*/true);
         builder.setSinkOp(
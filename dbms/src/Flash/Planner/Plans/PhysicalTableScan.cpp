@@ -27,6 +27,9 @@
 #include <Interpreters/Context.h>
 #include <Interpreters/SharedContexts/Disagg.h>
 #include <Operators/ExpressionTransformOp.h>
+#include <Storages/DeltaMerge/DeltaMergeStore.h>
+#include <Storages/KVStore/TMTContext.h>
+#include <Storages/StorageDeltaMerge.h>
 
 namespace DB
 {
@@ -213,4 +216,38 @@ const String & PhysicalTableScan::getFilterConditionsId() const
     RUNTIME_CHECK(hasFilterConditions());
     return filter_conditions.executor_id;
 }
+
+size_t PhysicalTableScan::estimateNDV(const Context & context, const String & column_name) const
+{
+    // The compute node has no local storage.
+    if (context.getSharedContextDisagg()->isDisaggregatedComputeMode())
+        return 0;
+
+    auto iter
+        = std::find_if(schema.cbegin(), schema.cend(), [&](const auto & column) { return column.name == column_name; });
+    if (iter == schema.cend())
+        return 0;
+    const auto & column_info = tidb_table_scan.getColumns()[iter - schema.cbegin()];
+
+    auto & tmt = context.getTMTContext();
+    const auto keyspace_id = context.getDAGContext()->getKeyspaceID();
+    size_t ndv = 0;
+    for (const auto physical_table_id : tidb_table_scan.getPhysicalTableIDs())
+    {
+        auto storage
+            = std::dynamic_pointer_cast<StorageDeltaMerge>(tmt.getStorages().get(keyspace_id, physical_table_id));
+        if (!storage)
+            return 0;
+        // Do not initiate the store, the table without any data has no statistics.
+        auto store = storage->getStoreIfInited();
+        if (!store)
+            continue;
+        // The distinct values of the partitions are assumed to be disjoint.
+        const auto column_stats = store->getColumnStatistics(column_info.id);
+        if (!column_stats.stats)
+            return 0;
+        ndv += column_stats.stats->ndv();
+    }
+    return ndv;
+}
 } // namespace DB
@@ -48,6 +48,10 @@ public:
 
     const String & getFilterConditionsId() const;
 
+    /// Estimate the number of distinct values of the column by the column statistics of the local storages,
+    /// return 0 if unknown, e.g. the storages are not local or some of them have no statistics.
+    size_t estimateNDV(const Context & context, const String & column_name) const;
+
     void buildPipeline(PipelineBuilder & builder, Context & context, PipelineExecutorContext & exec_context) override;
 
 private:
@@ -13,15 +13,18 @@
 // limitations under the License.
 
 #include <Common/Logger.h>
+#include <DataStreams/TopNThreshold.h>
 #include <Flash/Coprocessor/DAGContext.h>
 #include <Flash/Coprocessor/DAGExpressionAnalyzer.h>
 #include <Flash/Coprocessor/DAGPipeline.h>
+#include <Flash/Coprocessor/DAGUtils.h>
 #include <Flash/Coprocessor/InterpreterUtils.h>
 #include <Flash/Pipeline/Exec/PipelineExecBuilder.h>
 #include <Flash/Planner/FinalizeHelper.h>
 #include <Flash/Planner/PhysicalPlanHelper.h>
 #include <Flash/Planner/Plans/PhysicalTopN.h>
 #include <Interpreters/Context.h>
+#include <Storages/DeltaMerge/FilterParser/FilterParser.h>
 
 namespace DB
 {
@@ -46,6 +49,28 @@ PhysicalPlanNodePtr PhysicalTopN::build(
     auto order_columns = analyzer.buildOrderColumns(before_sort_actions, top_n.order_by());
     SortDescription order_descr = getSortDescription(order_columns, top_n.order_by());
 
+    TopNThresholdPtr topn_threshold;
+    auto * dag_context = context.getDAGContext();
+    // The selection on the table scan is merged into it, so the rows of the table scan are sent to the TopN directly.
+    // Push the threshold down if the first order by item is a column of the table scan.
+    const auto & first_order_by = top_n.order_by(0).expr();
+    if (context.getSettingsRef().enable_topn_runtime_threshold && dag_context && child->tp() == PlanType::TableScan
+        && isColumnExpr(first_order_by) && DM::FilterParser::isRSFilterSupportType(first_order_by.field_type().tp()))
+    {
+        const auto & first_sort_column = before_sort_actions->getSampleBlock().getByName(order_descr[0].column_name);
+        if (TopNThreshold::isSupportType(first_sort_column.type))
+        {
+            topn_threshold = std::make_shared<TopNThreshold>(
+                first_order_by,
+                first_sort_column.name,
+                first_sort_column.type,
+                order_descr[0].direction,
+                order_descr[0].nulls_direction,
+                context.getTimezoneInfo());
+            dag_context->topn_threshold_map[child->execId()] = topn_threshold;
+        }
+    }
+
     auto physical_top_n = std::make_shared<PhysicalTopN>(
         executor_id,
         child->getSchema(),
@@ -54,7 +79,8 @@ PhysicalPlanNodePtr PhysicalTopN::build(
         child,
         order_descr,
         before_sort_actions,
-        top_n.limit());
+        top_n.limit(),
+        topn_threshold);
     return physical_top_n;
 }
 
@@ -79,7 +105,7 @@ void PhysicalTopN::buildPipelineExecGroupImpl(
     // TODO find a suitable threshold is necessary; 10000 is just a value picked without much consideration.
     if (group_builder.concurrency() * limit <= 10000)
     {
-        executeLocalSort(exec_context, group_builder, order_descr, limit, false, context, log);
+        executeLocalTopN(exec_context, group_builder, order_descr, limit, topn_threshold, context, log);
     }
     else
     {
@@ -15,6 +15,7 @@
 #pragma once
 
 #include <Core/SortDescription.h>
+#include <DataStreams/TopNThreshold_fwd.h>
 #include <Flash/Planner/Plans/PhysicalUnary.h>
 #include <Interpreters/ExpressionActions.h>
 #include <tipb/executor.pb.h>
@@ -39,11 +40,13 @@ public:
         const PhysicalPlanNodePtr & child_,
         const SortDescription & order_descr_,
         const ExpressionActionsPtr & before_sort_actions_,
-        size_t limit_)
+        size_t limit_,
+        const TopNThresholdPtr & topn_threshold_ = nullptr)
         : PhysicalUnary(executor_id_, PlanType::TopN, schema_, fine_grained_shuffle_, req_id, child_)
         , order_descr(order_descr_)
         , before_sort_actions(before_sort_actions_)
         , limit(limit_)
+        , topn_threshold(topn_threshold_)
     {}
 
     void finalizeImpl(const Names & parent_require) override;
@@ -63,5 +66,7 @@ private:
     SortDescription order_descr;
     ExpressionActionsPtr before_sort_actions;
     size_t limit;
+    // Published to the table scan under this TopN, nullptr if the threshold can not be pushed down.
+    TopNThresholdPtr topn_threshold;
 };
 } // namespace DB
@@ -0,0 +1,103 @@
+// Copyright 2024 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <IO/Compression/CompressionMethod.h>
+#include <common/types.h>
+
+#include <atomic>
+
+namespace DB
+{
+// The compression methods used by the packets sent through one tunnel.
+struct CompressionProfileInfo
+{
+    void update(CompressionMethod method, size_t original_size, size_t packet_size)
+    {
+        switch (method)
+        {
+        case CompressionMethod::NONE:
+            ++none_packets;
+            break;
+        case CompressionMethod::LZ4:
+            ++lz4_packets;
+            break;
+        case CompressionMethod::ZSTD:
+            ++zstd_packets;
+            break;
+        default:
+            break;
+        }
+        original_bytes += original_size;
+        encoded_bytes += packet_size;
+    }
+
+    void merge(const CompressionProfileInfo & other)
+    {
+        none_packets += other.none_packets;
+        lz4_packets += other.lz4_packets;
+        zstd_packets += other.zstd_packets;
+        original_bytes += other.original_bytes;
+        encoded_bytes += other.encoded_bytes;
+    }
+
+    Int64 none_packets = 0;
+    Int64 lz4_packets = 0;
+    Int64 zstd_packets = 0;
+    Int64 original_bytes = 0;
+    Int64 encoded_bytes = 0;
+};
+
+// The same as `CompressionProfileInfo` but can be updated for every packet without locking.
+struct ConcurrentCompressionProfileInfo
+{
+    void update(CompressionMethod method, size_t original_size, size_t packet_size)
+    {
+        switch (method)
+        {
+        case CompressionMethod::NONE:
+            none_packets.fetch_add(1, std::memory_order_relaxed);
+            break;
+        case CompressionMethod::LZ4:
+            lz4_packets.fetch_add(1, std::memory_order_relaxed);
+            break;
+        case CompressionMethod::ZSTD:
+            zstd_packets.fetch_add(1, std::memory_order_relaxed);
+            break;
+        default:
+            break;
+        }
+        original_bytes.fetch_add(original_size, std::memory_order_relaxed);
+        encoded_bytes.fetch_add(packet_size, std::memory_order_relaxed);
+    }
+
+    CompressionProfileInfo load() const
+    {
+        CompressionProfileInfo info;
+        info.none_packets = none_packets.load(std::memory_order_relaxed);
+        info.lz4_packets = lz4_packets.load(std::memory_order_relaxed);
+        info.zstd_packets = zstd_packets.load(std::memory_order_relaxed);
+        info.original_bytes = original_bytes.load(std::memory_order_relaxed);
+        info.encoded_bytes = encoded_bytes.load(std::memory_order_relaxed);
+        return info;
+    }
+
+    std::atomic<Int64> none_packets = 0;
+    std::atomic<Int64> lz4_packets = 0;
+    std::atomic<Int64> zstd_packets = 0;
+    std::atomic<Int64> original_bytes = 0;
+    std::atomic<Int64> encoded_bytes = 0;
+};
+} // namespace DB
@@ -24,14 +24,20 @@ namespace DB
 String MPPTunnelDetail::toJson() const
 {
     return fmt::format(
-        R"({{"tunnel_id":"{}","sender_target_task_id":{},"sender_target_host":"{}","is_local":{},"conn_type":"{}","packets":{},"bytes":{}}})",
+        R"({{"tunnel_id":"{}","sender_target_task_id":{},"sender_target_host":"{}","is_local":{},"conn_type":"{}","packets":{},"bytes":{},)"
+        R"("compression":{{"none_packets":{},"lz4_packets":{},"zstd_packets":{},"original_bytes":{},"encoded_bytes":{}}}}})",
         tunnel_id,
         sender_target_task_id,
         sender_target_host,
         is_local,
         conn_profile_info.getTypeString(),
         conn_profile_info.packets,
-        conn_profile_info.bytes);
+        conn_profile_info.bytes,
+        compression_profile_info.none_packets,
+        compression_profile_info.lz4_packets,
+        compression_profile_info.zstd_packets,
+        compression_profile_info.original_bytes,
+        compression_profile_info.encoded_bytes);
 }
 
 void ExchangeSenderStatistics::appendExtraJson(FmtBuffer & fmt_buffer) const
@@ -57,6 +63,7 @@ void ExchangeSenderStatistics::collectExtraRuntimeDetail()
         const auto & connection_profile_info = mpp_tunnels[i]->getConnectionProfileInfo();
         mpp_tunnel_details[i].conn_profile_info.packets += connection_profile_info.packets;
         mpp_tunnel_details[i].conn_profile_info.bytes += connection_profile_info.bytes;
+        mpp_tunnel_details[i].compression_profile_info.merge(mpp_tunnels[i]->getCompressionProfileInfo());
         base.updateSendConnectionInfo(connection_profile_info);
     }
 }
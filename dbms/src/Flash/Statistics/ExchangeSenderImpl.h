@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <Flash/Statistics/CompressionProfileInfo.h>
 #include <Flash/Statistics/ConnectionProfileInfo.h>
 #include <Flash/Statistics/ExecutorStatistics.h>
 #include <tipb/executor.pb.h>
@@ -27,6 +28,7 @@ struct MPPTunnelDetail
     String sender_target_host;
     bool is_local;
     ConnectionProfileInfo conn_profile_info;
+    CompressionProfileInfo compression_profile_info;
 
     MPPTunnelDetail(
         const ConnectionProfileInfo & conn_profile_info_,
@@ -0,0 +1,99 @@
+// Copyright 2024 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/WeakHash.h>
+#include <Core/Block.h>
+#include <Flash/Mpp/HashBaseWriterHelper.h>
+#include <TestUtils/ColumnGenerator.h>
+#include <benchmark/benchmark.h>
+
+namespace DB
+{
+namespace tests
+{
+namespace
+{
+constexpr size_t block_rows = 65536;
+
+Block generateBlock()
+{
+    // A wide row with fixed size and variable size columns, the first column is the partition key.
+    ColumnsWithTypeAndName columns;
+    columns.push_back(ColumnGenerator::instance().generate({block_rows, "Int64", RANDOM, "key"}));
+    for (size_t i = 0; i < 4; ++i)
+        columns.push_back(ColumnGenerator::instance().generate({block_rows, "Int64", RANDOM, fmt::format("i{}", i)}));
+    columns.push_back(ColumnGenerator::instance().generate({block_rows, "Decimal(15,2)", RANDOM, "d"}));
+    columns.push_back(ColumnGenerator::instance().generate({block_rows, "Nullable(Int32)", RANDOM, "n"}));
+    columns.push_back(ColumnGenerator::instance().generate({block_rows, "String", RANDOM, "s", 16}));
+    return Block(columns);
+}
+
+const Block & getBlock()
+{
+    static const Block block = generateBlock();
+    return block;
+}
+
+// The scatter before grouping rows by partition: every column is scattered by `IColumn::scatter` separately.
+void scatterEachColumn(const Block & block, uint32_t part_num, std::vector<MutableColumns> & result_columns)
+{
+    std::vector<String> partition_key_containers(1);
+    WeakHash32 hash(0);
+    HashBaseWriterHelper::computeHash(block, {0}, {nullptr}, partition_key_containers, hash);
+
+    const auto & hash_data = hash.getData();
+    IColumn::Selector selector(block.rows());
+    for (size_t i = 0; i < block.rows(); ++i)
+        selector[i] = (static_cast<UInt64>(hash_data[i]) * part_num) >> 32u;
+
+    for (size_t col_id = 0; col_id < block.columns(); ++col_id)
+    {
+        auto part_columns = block.getByPosition(col_id).column->scatter(part_num, selector);
+        for (size_t part_id = 0; part_id < part_num; ++part_id)
+            result_columns[part_id][col_id] = std::move(part_columns[part_id]);
+    }
+}
+} // namespace
+
+static void scatterColumnByColumn(benchmark::State & state)
+{
+    const auto & block = getBlock();
+    const auto part_num = static_cast<uint32_t>(state.range(0));
+    for (auto _ : state)
+    {
+        auto result_columns = HashBaseWriterHelper::createDestColumns(block, part_num);
+        scatterEachColumn(block, part_num, result_columns);
+        benchmark::DoNotOptimize(result_columns);
+    }
+    state.SetItemsProcessed(state.iterations() * block.rows());
+}
+
+static void scatterColumnsGroupedByPartition(benchmark::State & state)
+{
+    const auto & block = getBlock();
+    const auto part_num = static_cast<uint32_t>(state.range(0));
+    std::vector<String> partition_key_containers(1);
+    for (auto _ : state)
+    {
+        auto result_columns = HashBaseWriterHelper::createDestColumns(block, part_num);
+        HashBaseWriterHelper::scatterColumns(block, {0}, {nullptr}, partition_key_containers, part_num, result_columns);
+        benchmark::DoNotOptimize(result_columns);
+    }
+    state.SetItemsProcessed(state.iterations() * block.rows());
+}
+
+BENCHMARK(scatterColumnByColumn)->RangeMultiplier(4)->Range(16, 1024);
+BENCHMARK(scatterColumnsGroupedByPartition)->RangeMultiplier(4)->Range(16, 1024);
+} // namespace tests
+} // namespace DB
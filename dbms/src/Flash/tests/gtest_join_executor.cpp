@@ -4792,6 +4792,7 @@ try
         context.addMockTable("right_semi_family", "t", {{"a", TiDB::TP::TypeLong}}, left);
         context.addMockTable("right_semi_family", "s", {{"a", TiDB::TP::TypeLong}}, right);
 
+        WRAP_FOR_JOIN_TEST_BEGIN
         auto request = context.scan("right_semi_family", "t")
                            .join(context.scan("right_semi_family", "s"), type, {col("a")}, {}, {}, {}, {}, 0, false, 0)
                            .build(context);
@@ -4802,6 +4803,7 @@ try
                   .aggregation({Count(lit(static_cast<UInt64>(1)))}, {})
                   .build(context);
         ASSERT_COLUMNS_EQ_UR(genScalarCountResults(res), executeStreams(request_column_prune, 2));
+        WRAP_FOR_JOIN_TEST_END
     }
 
     /// One join key(t.a = s.a) + other condition(t.c < s.c).
@@ -4850,6 +4852,7 @@ try
         context.addMockTable("right_semi_family", "t", {{"a", TiDB::TP::TypeLong}, {"c", TiDB::TP::TypeLong}}, left);
         context.addMockTable("right_semi_family", "s", {{"a", TiDB::TP::TypeLong}, {"c", TiDB::TP::TypeLong}}, right);
 
+        WRAP_FOR_JOIN_FOR_OTHER_CONDITION_TEST_BEGIN
         auto request = context.scan("right_semi_family", "t")
                            .join(
                                context.scan("right_semi_family", "s"),
@@ -4879,6 +4882,7 @@ try
                                         .aggregation({Count(lit(static_cast<UInt64>(1)))}, {})
                                         .build(context);
         ASSERT_COLUMNS_EQ_UR(genScalarCountResults(res), executeStreams(request_column_prune, 2));
+        WRAP_FOR_JOIN_FOR_OTHER_CONDITION_TEST_END
     }
 }
 CATCH
@@ -4943,6 +4947,7 @@ try
                            .build(context);
         auto expect = executeStreams(request, 1);
         auto swap_expect = swapLeftRightTableColumns(expect);
+        WRAP_FOR_JOIN_TEST_BEGIN
         auto request2 = context.scan("right_outer", "t")
                             .join(context.scan("right_outer", "s"), type, {col("a")}, {}, {}, {}, {}, 0, false, 1)
                             .build(context);
@@ -4953,6 +4958,7 @@ try
                   .aggregation({Count(lit(static_cast<UInt64>(1)))}, {})
                   .build(context);
         ASSERT_COLUMNS_EQ_UR(genScalarCountResults(swap_expect), executeStreams(request_column_prune, 2));
+        WRAP_FOR_JOIN_TEST_END
     }
 
     /// One join key(t.a = s.a) + no left/right condition + other condition(t.c < s.c).
@@ -5010,6 +5016,7 @@ try
                            .build(context);
         auto expect = executeStreams(request, 1);
         auto swap_expect = swapLeftRightTableColumns(expect);
+        WRAP_FOR_JOIN_FOR_OTHER_CONDITION_TEST_BEGIN
         auto request2 = context.scan("right_outer", "t")
                             .join(
                                 context.scan("right_outer", "s"),
@@ -5039,6 +5046,7 @@ try
                                         .aggregation({Count(lit(static_cast<UInt64>(1)))}, {})
                                         .build(context);
         ASSERT_COLUMNS_EQ_UR(genScalarCountResults(swap_expect), executeStreams(request_column_prune, 2));
+        WRAP_FOR_JOIN_FOR_OTHER_CONDITION_TEST_END
     }
 
     /// One join key(t.a = s.a) + left/right condition + other condition(t.c < s.c).
@@ -5097,6 +5105,7 @@ try
                            .build(context);
         auto expect = executeStreams(request, 1);
         auto swap_expect = swapLeftRightTableColumns(expect);
+        WRAP_FOR_JOIN_FOR_OTHER_CONDITION_TEST_BEGIN
         auto request2 = context.scan("right_outer", "t")
                             .join(
                                 context.scan("right_outer", "s"),
@@ -5126,6 +5135,7 @@ try
                                         .aggregation({Count(lit(static_cast<UInt64>(1)))}, {})
                                         .build(context);
         ASSERT_COLUMNS_EQ_UR(genScalarCountResults(swap_expect), executeStreams(request_column_prune, 2));
+        WRAP_FOR_JOIN_FOR_OTHER_CONDITION_TEST_END
     }
 }
 CATCH
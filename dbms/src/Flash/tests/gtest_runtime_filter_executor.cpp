@@ -103,6 +103,149 @@ try
 }
 CATCH
 
+TEST_F(RuntimeFilterExecutorTestRunner, MinMaxAndBloomFilterTest)
+try
+{
+    context.context->getSettingsRef().dt_segment_stable_pack_rows = 1;
+    context.context->getSettingsRef().dt_segment_limit_rows = 1;
+    context.context->getSettingsRef().dt_segment_delta_cache_limit_rows = 1;
+    context.context->getSettingsRef().dt_segment_force_split_size = 70;
+    context.context->getSettingsRef().enable_hash_join_v2 = false;
+    context.addMockDeltaMerge(
+        {"test_db", "left_table"},
+        {{"col0", TiDB::TP::TypeLongLong, false}, {"k1", TiDB::TP::TypeLong}},
+        {toVec<Int64>("col0", {0, 1, 2, 3, 4}), toNullableVec<Int32>("k1", {1, 2, 3, 5, 7})},
+        concurrency);
+
+    context.addExchangeReceiver(
+        "right_exchange_table",
+        {{"k1", TiDB::TP::TypeLong}},
+        {toNullableVec<Int32>("k1", {2, 2, 5, {}, 6})});
+    context.addExchangeReceiver("right_empty_table", {{"k1", TiDB::TP::TypeLong}});
+
+    WRAP_FOR_RF_TEST_BEGIN
+    {
+        // with min max runtime filter, the packs out of [2, 6] are pruned, table_scan_0 return 3 rows
+        mock::MockRuntimeFilter rf(1, col("k1"), col("k1"), "exchange_receiver_1", "table_scan_0", tipb::MIN_MAX);
+        auto request
+            = context.scan("test_db", "left_table", std::vector<int>{1})
+                  .join(context.receive("right_exchange_table"), tipb::JoinType::TypeInnerJoin, {col("k1")}, rf)
+                  .build(context);
+        Expect expect{
+            {"table_scan_0", {3, enable_pipeline ? concurrency : 1}},
+            {"exchange_receiver_1", {5, concurrency}},
+            {"Join_2", {3, concurrency}}};
+        testForExecutionSummary(request, expect);
+    }
+
+    {
+        // with bloom filter runtime filter, the rows not in {2, 5, 6} are filtered, table_scan_0 return 2 rows
+        mock::MockRuntimeFilter rf(1, col("k1"), col("k1"), "exchange_receiver_1", "table_scan_0", tipb::BLOOM_FILTER);
+        auto request
+            = context.scan("test_db", "left_table", std::vector<int>{1})
+                  .join(context.receive("right_exchange_table"), tipb::JoinType::TypeInnerJoin, {col("k1")}, rf)
+                  .build(context);
+        Expect expect{
+            {"table_scan_0", {2, enable_pipeline ? concurrency : 1}},
+            {"exchange_receiver_1", {5, concurrency}},
+            {"Join_2", {3, concurrency}}};
+        testForExecutionSummary(request, expect);
+    }
+
+    for (auto rf_type : {tipb::MIN_MAX, tipb::BLOOM_FILTER})
+    {
+        // empty build side, table_scan_0 return 0 rows
+        mock::MockRuntimeFilter rf(1, col("k1"), col("k1"), "exchange_receiver_1", "table_scan_0", rf_type);
+        auto request = context.scan("test_db", "left_table", std::vector<int>{1})
+                           .join(context.receive("right_empty_table"), tipb::JoinType::TypeInnerJoin, {col("k1")}, rf)
+                           .build(context);
+        Expect expect{
+            {"table_scan_0", {0, enable_pipeline ? concurrency : 1}},
+            {"exchange_receiver_1", {0, concurrency}},
+            {"Join_2", {0, concurrency}}};
+        testForExecutionSummary(request, expect);
+    }
+    WRAP_FOR_RF_TEST_END
+}
+CATCH
+
+TEST_F(RuntimeFilterExecutorTestRunner, BloomFilterExceedsMaxKeys)
+try
+{
+    context.context->getSettingsRef().dt_segment_stable_pack_rows = 1;
+    context.context->getSettingsRef().dt_segment_limit_rows = 1;
+    context.context->getSettingsRef().dt_segment_delta_cache_limit_rows = 1;
+    context.context->getSettingsRef().dt_segment_force_split_size = 70;
+    context.context->getSettingsRef().enable_hash_join_v2 = false;
+    // The smallest bloom filter can not keep such a low false positive rate for 4 keys.
+    context.context->getSettingsRef().rf_max_bloom_filter_bytes = 0;
+    context.context->getSettingsRef().rf_bloom_filter_false_positive_rate = 1e-9;
+    context.addMockDeltaMerge(
+        {"test_db", "left_table"},
+        {{"col0", TiDB::TP::TypeLongLong, false}, {"k1", TiDB::TP::TypeLong}},
+        {toVec<Int64>("col0", {0, 1, 2, 3, 4}), toNullableVec<Int32>("k1", {1, 2, 3, 5, 7})},
+        concurrency);
+
+    context.addExchangeReceiver(
+        "right_exchange_table",
+        {{"k1", TiDB::TP::TypeLong}},
+        {toNullableVec<Int32>("k1", {2, 2, 5, {}, 6})});
+
+    WRAP_FOR_RF_TEST_BEGIN
+    {
+        // the bloom filter rf is failed, table_scan_0 return all the rows
+        mock::MockRuntimeFilter rf(1, col("k1"), col("k1"), "exchange_receiver_1", "table_scan_0", tipb::BLOOM_FILTER);
+        auto request
+            = context.scan("test_db", "left_table", std::vector<int>{1})
+                  .join(context.receive("right_exchange_table"), tipb::JoinType::TypeInnerJoin, {col("k1")}, rf)
+                  .build(context);
+        Expect expect{
+            {"table_scan_0", {5, enable_pipeline ? concurrency : 1}},
+            {"exchange_receiver_1", {5, concurrency}},
+            {"Join_2", {3, concurrency}}};
+        testForExecutionSummary(request, expect);
+    }
+    WRAP_FOR_RF_TEST_END
+}
+CATCH
+
+TEST_F(RuntimeFilterExecutorTestRunner, UnsupportedRuntimeFilterIsSkipped)
+try
+{
+    context.context->getSettingsRef().dt_segment_stable_pack_rows = 1;
+    context.context->getSettingsRef().dt_segment_limit_rows = 1;
+    context.context->getSettingsRef().dt_segment_delta_cache_limit_rows = 1;
+    context.context->getSettingsRef().dt_segment_force_split_size = 70;
+    context.context->getSettingsRef().enable_hash_join_v2 = false;
+    context.addMockDeltaMerge(
+        {"test_db", "left_table"},
+        {{"col0", TiDB::TP::TypeLongLong, false}, {"k1", TiDB::TP::TypeString}},
+        {toVec<Int64>("col0", {0, 1, 2, 3, 4}), toNullableVec<String>("k1", {"1", "2", "3", "5", "7"})},
+        concurrency);
+
+    context.addExchangeReceiver(
+        "right_exchange_table",
+        {{"k1", TiDB::TP::TypeString}},
+        {toNullableVec<String>("k1", {"2", "2", "5", {}, "6"})});
+
+    WRAP_FOR_RF_TEST_BEGIN
+    {
+        // the min max rf doesn't support string column, the query runs without it and table_scan_0 return all rows
+        mock::MockRuntimeFilter rf(1, col("k1"), col("k1"), "exchange_receiver_1", "table_scan_0", tipb::MIN_MAX);
+        auto request
+            = context.scan("test_db", "left_table", std::vector<int>{1})
+                  .join(context.receive("right_exchange_table"), tipb::JoinType::TypeInnerJoin, {col("k1")}, rf)
+                  .build(context);
+        Expect expect{
+            {"table_scan_0", {5, enable_pipeline ? concurrency : 1}},
+            {"exchange_receiver_1", {5, concurrency}},
+            {"Join_2", {3, concurrency}}};
+        testForExecutionSummary(request, expect);
+    }
+    WRAP_FOR_RF_TEST_END
+}
+CATCH
+
 #undef WRAP_FOR_RF_TEST_BEGIN
 #undef WRAP_FOR_RF_TEST_END
 
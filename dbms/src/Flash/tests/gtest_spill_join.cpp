@@ -12,10 +12,17 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <Common/ProfileEvents.h>
 #include <Flash/tests/gtest_join.h>
 
 #include <magic_enum.hpp>
 
+namespace ProfileEvents
+{
+extern const Event JoinV2SpilledPartitions;
+extern const Event JoinV2RestoredPartitions;
+} // namespace ProfileEvents
+
 namespace DB
 {
 namespace tests
@@ -578,6 +585,67 @@ try
 }
 CATCH
 
+TEST_F(SpillJoinTestRunner, HashJoinV2Spill)
+try
+{
+    constexpr size_t rows = 1000;
+    std::vector<std::optional<TypeTraits<Int32>::FieldType>> t1_a(rows), t1_b(rows), t2_a(rows), t2_c(rows);
+    for (size_t i = 0; i < rows; ++i)
+    {
+        if (i % 7 != 0)
+            t1_a[i] = i % 300;
+        t1_b[i] = i;
+        if (i % 11 != 0)
+            t2_a[i] = (i * 3) % 400;
+        t2_c[i] = i % 13;
+    }
+    context.addMockTable(
+        "spill_test",
+        "t1",
+        {{"a", TiDB::TP::TypeLong}, {"b", TiDB::TP::TypeLong}},
+        {toNullableVec<Int32>("a", t1_a), toNullableVec<Int32>("b", t1_b)});
+    context.addMockTable(
+        "spill_test",
+        "t2",
+        {{"a", TiDB::TP::TypeLong}, {"c", TiDB::TP::TypeLong}},
+        {toNullableVec<Int32>("a", t2_a), toNullableVec<Int32>("c", t2_c)});
+
+    enablePipeline(true);
+    context.context->getSettingsRef().enable_hash_join_v2 = true;
+    for (auto join_type : join_types)
+    {
+        auto request = context.scan("spill_test", "t1")
+                           .join(context.scan("spill_test", "t2"), join_type, {col("a")})
+                           .build(context);
+        context.context->setSetting("max_bytes_before_external_join", Field(static_cast<UInt64>(0)));
+        auto reference = executeStreams(request, 2);
+
+        context.context->setSetting("max_bytes_before_external_join", Field(static_cast<UInt64>(1)));
+        for (size_t concurrency : {1, 2, 5})
+        {
+            auto spilled_partitions = ProfileEvents::get(ProfileEvents::JoinV2SpilledPartitions);
+            auto restored_partitions = ProfileEvents::get(ProfileEvents::JoinV2RestoredPartitions);
+            ASSERT_COLUMNS_EQ_UR(reference, executeStreams(request, concurrency))
+                << "join_type = " << magic_enum::enum_name(join_type) << ", concurrency = " << concurrency;
+            // Every spilled partition is restored.
+            spilled_partitions = ProfileEvents::get(ProfileEvents::JoinV2SpilledPartitions) - spilled_partitions;
+            restored_partitions = ProfileEvents::get(ProfileEvents::JoinV2RestoredPartitions) - restored_partitions;
+            ASSERT_GT(spilled_partitions, 0);
+            ASSERT_EQ(spilled_partitions, restored_partitions);
+        }
+
+        // Nothing is spilled if there is no memory pressure.
+        context.context->setSetting("max_bytes_before_external_join", Field(static_cast<UInt64>(1024 * 1024 * 1024)));
+        auto spilled_partitions = ProfileEvents::get(ProfileEvents::JoinV2SpilledPartitions);
+        ASSERT_COLUMNS_EQ_UR(reference, executeStreams(request, 2))
+            << "join_type = " << magic_enum::enum_name(join_type);
+        ASSERT_EQ(ProfileEvents::get(ProfileEvents::JoinV2SpilledPartitions), spilled_partitions);
+    }
+    context.context->setSetting("max_bytes_before_external_join", Field(static_cast<UInt64>(0)));
+    context.context->getSettingsRef().enable_hash_join_v2 = false;
+}
+CATCH
+
 #undef WRAP_FOR_SPILL_TEST_BEGIN
 #undef WRAP_FOR_SPILL_TEST_END
 
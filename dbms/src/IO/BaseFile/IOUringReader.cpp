@@ -0,0 +1,349 @@
+// Copyright 2024 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/Exception.h>
+#include <Common/Logger.h>
+#include <IO/BaseFile/IOUringReader.h>
+#include <common/logger_useful.h>
+#include <common/types.h>
+#include <sys/uio.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#if __has_include(<linux/io_uring.h>) && defined(__NR_io_uring_setup)
+#include <linux/io_uring.h>
+#define TIFLASH_HAS_IO_URING 1
+#endif
+#endif
+
+namespace DB
+{
+namespace ErrorCodes
+{
+extern const int NOT_IMPLEMENTED;
+} // namespace ErrorCodes
+
+namespace
+{
+// The number of entries of the submission queue, the completion queue is twice as large by default.
+constexpr unsigned IO_URING_ENTRIES = 256;
+} // namespace
+
+class IOUringReader::Batch : public AsyncReadHandle
+{
+public:
+    struct Slot
+    {
+        struct iovec iov;
+        ReadRequest * req;
+        Batch * batch;
+    };
+
+    Batch(IOUringReader & reader_, ReadRequests & requests)
+        : reader(reader_)
+        , slots(requests.size())
+        , pending(requests.size())
+    {
+        for (size_t i = 0; i < requests.size(); ++i)
+        {
+            slots[i].iov = {.iov_base = requests[i].buf, .iov_len = requests[i].size};
+            slots[i].req = &requests[i];
+            slots[i].batch = this;
+        }
+    }
+
+    ~Batch() override { wait(); }
+
+    bool poll() override
+    {
+        if (isCompleted())
+            return true;
+        std::unique_lock lock(reader.mutex);
+        reader.reapLocked();
+        return isCompleted();
+    }
+
+    void wait() override
+    {
+        if (isCompleted())
+            return;
+        std::unique_lock lock(reader.mutex);
+        reader.reapLocked();
+        while (!isCompleted())
+            reader.waitAndReap(lock);
+    }
+
+    bool isCompleted() const { return pending.load(std::memory_order_acquire) == 0; }
+
+    // Called by the reader when the request is completed or failed to submit.
+    // Note that the batch may be destroyed by other threads after the last request is completed.
+    static void complete(Slot & slot, ssize_t result)
+    {
+        slot.req->result = result;
+        slot.batch->pending.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    IOUringReader & reader;
+    std::vector<Slot> slots;
+    std::atomic<size_t> pending;
+};
+
+#ifdef TIFLASH_HAS_IO_URING
+
+IOUringReader * IOUringReader::instance()
+{
+    // Shared by the whole process and never released.
+    static IOUringReader * reader = []() -> IOUringReader * {
+        auto * r = new IOUringReader();
+        if (r->setup(IO_URING_ENTRIES))
+            return r;
+        LOG_INFO(Logger::get(), "io_uring is not available, fallback to synchronous reads, errno={}", errno);
+        delete r;
+        return nullptr;
+    }();
+    return reader;
+}
+
+bool IOUringReader::setup(unsigned entries)
+{
+    struct io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    ring_fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+    if (ring_fd < 0)
+        return false;
+
+    sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (single_mmap)
+        sq_ring_size = cq_ring_size = std::max(sq_ring_size, cq_ring_size);
+
+    sq_ring = ::mmap(
+        nullptr,
+        sq_ring_size,
+        PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE,
+        ring_fd,
+        IORING_OFF_SQ_RING);
+    if (sq_ring == MAP_FAILED)
+    {
+        sq_ring = nullptr;
+        return false;
+    }
+    if (single_mmap)
+    {
+        cq_ring = sq_ring;
+    }
+    else
+    {
+        cq_ring = ::mmap(
+            nullptr,
+            cq_ring_size,
+            PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_POPULATE,
+            ring_fd,
+            IORING_OFF_CQ_RING);
+        if (cq_ring == MAP_FAILED)
+        {
+            cq_ring = nullptr;
+            return false;
+        }
+    }
+    sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    sqes = ::mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED)
+    {
+        sqes = nullptr;
+        return false;
+    }
+
+    auto * sq_base = static_cast<char *>(sq_ring);
+    sq_head = reinterpret_cast<unsigned *>(sq_base + params.sq_off.head);
+    sq_tail = reinterpret_cast<unsigned *>(sq_base + params.sq_off.tail);
+    sq_mask = reinterpret_cast<unsigned *>(sq_base + params.sq_off.ring_mask);
+    sq_array = reinterpret_cast<unsigned *>(sq_base + params.sq_off.array);
+    sq_entries = params.sq_entries;
+    auto * cq_base = static_cast<char *>(cq_ring);
+    cq_head = reinterpret_cast<unsigned *>(cq_base + params.cq_off.head);
+    cq_tail = reinterpret_cast<unsigned *>(cq_base + params.cq_off.tail);
+    cq_mask = reinterpret_cast<unsigned *>(cq_base + params.cq_off.ring_mask);
+    cqes = cq_base + params.cq_off.cqes;
+    cq_entries = params.cq_entries;
+    return true;
+}
+
+IOUringReader::~IOUringReader()
+{
+    if (sqes != nullptr)
+        ::munmap(sqes, sqes_size);
+    if (cq_ring != nullptr && cq_ring != sq_ring)
+        ::munmap(cq_ring, cq_ring_size);
+    if (sq_ring != nullptr)
+        ::munmap(sq_ring, sq_ring_size);
+    if (ring_fd >= 0)
+        ::close(ring_fd);
+}
+
+int IOUringReader::enter(unsigned to_submit, unsigned min_complete, unsigned flags) const
+{
+    return static_cast<int>(::syscall(__NR_io_uring_enter, ring_fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+AsyncReadHandlePtr IOUringReader::submit(int fd, ReadRequests & requests)
+{
+    if (requests.empty())
+        return std::make_unique<CompletedReadHandle>();
+
+    auto batch = std::make_unique<Batch>(*this, requests);
+    std::unique_lock lock(mutex);
+    size_t next = 0;
+    while (next < batch->slots.size())
+    {
+        reapLocked();
+        const size_t free_cqes = cq_entries - inflight;
+        if (free_cqes == 0)
+        {
+            waitAndReap(lock);
+            continue;
+        }
+
+        // The submission queue is always empty here because the kernel consumes the entries
+        // in `io_uring_enter` and the unconsumed entries are rolled back below.
+        const auto to_submit
+            = static_cast<unsigned>(std::min({batch->slots.size() - next, size_t{sq_entries}, free_cqes}));
+        unsigned tail = *sq_tail;
+        for (unsigned i = 0; i < to_submit; ++i, ++tail)
+        {
+            auto & slot = batch->slots[next + i];
+            const unsigned index = tail & *sq_mask;
+            auto * sqe = static_cast<struct io_uring_sqe *>(sqes) + index;
+            std::memset(sqe, 0, sizeof(*sqe));
+            sqe->opcode = IORING_OP_READV;
+            sqe->fd = fd;
+            sqe->off = slot.req->offset;
+            sqe->addr = reinterpret_cast<UInt64>(&slot.iov);
+            sqe->len = 1;
+            sqe->user_data = reinterpret_cast<UInt64>(&slot);
+            sq_array[index] = index;
+        }
+        __atomic_store_n(sq_tail, tail, __ATOMIC_RELEASE);
+
+        int submitted = 0;
+        do
+        {
+            submitted = enter(to_submit, 0, 0);
+        } while (submitted < 0 && errno == EINTR);
+        const int err = errno;
+
+        if (submitted < static_cast<int>(to_submit))
+        {
+            // Roll back the entries not consumed by the kernel, so they won't be submitted by others later
+            const unsigned consumed = std::max(submitted, 0);
+            __atomic_store_n(sq_tail, tail - (to_submit - consumed), __ATOMIC_RELEASE);
+            if (submitted < 0 && ((err != EAGAIN && err != EBUSY) || inflight == 0))
+            {
+                // Fail all the requests not submitted yet
+                inflight += consumed;
+                for (size_t i = next + consumed; i < batch->slots.size(); ++i)
+                    Batch::complete(batch->slots[i], -err);
+                break;
+            }
+            if (consumed == 0 && inflight > 0)
+                waitAndReap(lock);
+            submitted = consumed;
+        }
+        inflight += submitted;
+        next += submitted;
+    }
+    return batch;
+}
+
+size_t IOUringReader::reapLocked()
+{
+    unsigned head = *cq_head;
+    const unsigned tail = __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE);
+    size_t reaped = 0;
+    for (; head != tail; ++head, ++reaped)
+    {
+        const auto * cqe = static_cast<const struct io_uring_cqe *>(cqes) + (head & *cq_mask);
+        auto * slot = reinterpret_cast<Batch::Slot *>(cqe->user_data);
+        Batch::complete(*slot, cqe->res);
+    }
+    __atomic_store_n(cq_head, head, __ATOMIC_RELEASE);
+    inflight -= reaped;
+    return reaped;
+}
+
+void IOUringReader::waitAndReap(std::unique_lock<std::mutex> & lock)
+{
+    if (waiting_in_kernel)
+    {
+        // Another thread is waiting in the kernel, it will reap all the completions
+        // and notify us.
+        cv.wait(lock);
+        return;
+    }
+
+    // It is ok to wait without holding the lock, because only this thread waits in the kernel,
+    // and there must be some requests in flight.
+    waiting_in_kernel = true;
+    lock.unlock();
+    enter(0, 1, IORING_ENTER_GETEVENTS);
+    lock.lock();
+    waiting_in_kernel = false;
+    reapLocked();
+    cv.notify_all();
+}
+
+#else
+
+IOUringReader * IOUringReader::instance()
+{
+    return nullptr;
+}
+
+bool IOUringReader::setup(unsigned)
+{
+    return false;
+}
+
+IOUringReader::~IOUringReader() = default;
+
+int IOUringReader::enter(unsigned, unsigned, unsigned) const
+{
+    return -1;
+}
+
+AsyncReadHandlePtr IOUringReader::submit(int, ReadRequests &)
+{
+    throw Exception("io_uring is not supported", ErrorCodes::NOT_IMPLEMENTED);
+}
+
+size_t IOUringReader::reapLocked()
+{
+    return 0;
+}
+
+void IOUringReader::waitAndReap(std::unique_lock<std::mutex> &) {}
+
+#endif
+
+} // namespace DB
@@ -0,0 +1,94 @@
+// Copyright 2024 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Common/nocopyable.h>
+#include <IO/BaseFile/RandomAccessFile.h>
+
+#include <condition_variable>
+#include <mutex>
+
+namespace DB
+{
+/**
+ * A minimal io_uring based reader shared by the whole process. It is used by
+ * `PosixRandomAccessFile::submitReads` to issue many ranges with one syscall and
+ * let the caller poll the completions instead of blocking on every range.
+ *
+ * The ring is set up by the raw syscalls so that no extra library is required.
+ * `instance()` returns nullptr if io_uring is not supported by the kernel or it is
+ * disabled (e.g. by seccomp or `kernel.io_uring_disabled`), and the caller should
+ * fall back to the synchronous reads.
+ */
+class IOUringReader
+{
+public:
+    static IOUringReader * instance();
+
+    ~IOUringReader();
+
+    DISALLOW_COPY_AND_MOVE(IOUringReader);
+
+    // Submit the reads of `requests` on `fd`. The returned handle must be kept until the
+    // batch is completed, which is ensured by its destructor.
+    AsyncReadHandlePtr submit(int fd, ReadRequests & requests);
+
+private:
+    class Batch;
+
+    IOUringReader() = default;
+
+    bool setup(unsigned entries);
+
+    // Move the completed requests out of the completion queue. Return the number of reaped completions.
+    size_t reapLocked();
+
+    // Block until there are completions, and reap them. Only one thread waits in the kernel at a time,
+    // others wait for its notification. There must be some requests in flight.
+    void waitAndReap(std::unique_lock<std::mutex> & lock);
+
+    int enter(unsigned to_submit, unsigned min_complete, unsigned flags) const;
+
+private:
+    int ring_fd = -1;
+
+    // The mmaped submission queue and completion queue
+    void * sq_ring = nullptr;
+    size_t sq_ring_size = 0;
+    void * cq_ring = nullptr;
+    size_t cq_ring_size = 0;
+    void * sqes = nullptr;
+    size_t sqes_size = 0;
+
+    unsigned * sq_head = nullptr;
+    unsigned * sq_tail = nullptr;
+    unsigned * sq_mask = nullptr;
+    unsigned * sq_array = nullptr;
+    unsigned sq_entries = 0;
+    unsigned * cq_head = nullptr;
+    unsigned * cq_tail = nullptr;
+    unsigned * cq_mask = nullptr;
+    void * cqes = nullptr;
+    unsigned cq_entries = 0;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    // The number of requests submitted to the kernel but not reaped yet.
+    // It is limited by `cq_entries` to avoid the completion queue overflow.
+    size_t inflight = 0;
+    bool waiting_in_kernel = false;
+};
+
+} // namespace DB
@@ -15,6 +15,7 @@
 #include <Common/Exception.h>
 #include <Common/ProfileEvents.h>
 #include <Common/TiFlashMetrics.h>
+#include <IO/BaseFile/IOUringReader.h>
 #include <IO/BaseFile/PosixRandomAccessFile.h>
 #include <IO/BaseFile/RateLimiter.h>
 #include <fcntl.h>
@@ -132,4 +133,24 @@ ssize_t PosixRandomAccessFile::pread(char * buf, size_t size, off_t offset) cons
     return ::pread(fd, buf, size, offset);
 }
 
+AsyncReadHandlePtr PosixRandomAccessFile::submitReads(ReadRequests & requests)
+{
+    auto * io_uring = IOUringReader::instance();
+    if (io_uring == nullptr)
+        return RandomAccessFile::submitReads(requests);
+
+    size_t total_size = 0;
+    for (const auto & req : requests)
+        total_size += req.size;
+    if (read_limiter != nullptr)
+    {
+        read_limiter->request(total_size);
+    }
+    if (file_seg != nullptr)
+    {
+        GET_METRIC(tiflash_storage_remote_cache_bytes, type_dtfile_read_bytes).Increment(total_size);
+    }
+    return io_uring->submit(fd, requests);
+}
+
 } // namespace DB
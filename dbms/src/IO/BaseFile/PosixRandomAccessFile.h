@@ -51,6 +51,9 @@ public:
 
     [[nodiscard]] ssize_t pread(char * buf, size_t size, off_t offset) const override;
 
+    // Submit the reads by io_uring if it is available, otherwise read them one by one.
+    [[nodiscard]] AsyncReadHandlePtr submitReads(ReadRequests & requests) override;
+
     std::string getFileName() const override { return file_name; }
     std::string getInitialFileName() const override { return file_name; }
 
@@ -0,0 +1,32 @@
+// Copyright 2024 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <IO/BaseFile/RandomAccessFile.h>
+
+#include <cerrno>
+
+namespace DB
+{
+AsyncReadHandlePtr RandomAccessFile::submitReads(ReadRequests & requests)
+{
+    for (auto & req : requests)
+    {
+        req.result = pread(req.buf, req.size, req.offset);
+        if (req.result < 0)
+            req.result = -errno;
+    }
+    return std::make_unique<CompletedReadHandle>();
+}
+
+} // namespace DB
@@ -17,6 +17,7 @@
 #include <sys/types.h>
 
 #include <memory>
+#include <vector>
 
 #ifndef O_DIRECT
 #define O_DIRECT 00040000
@@ -24,6 +25,43 @@
 
 namespace DB
 {
+// A range to read by `RandomAccessFile::submitReads`.
+struct ReadRequest
+{
+    char * buf = nullptr;
+    size_t size = 0;
+    off_t offset = 0;
+    // The number of bytes read or -errno. Only valid after the request is completed.
+    // Same as `pread`, it could be less than `size` when reaching the end of file.
+    ssize_t result = 0;
+};
+using ReadRequests = std::vector<ReadRequest>;
+
+// The handle of a batch of reads submitted by `RandomAccessFile::submitReads`.
+// The requests and the buffers must be kept alive until the batch is completed.
+// Destroying the handle waits for the batch to be completed.
+class AsyncReadHandle
+{
+public:
+    virtual ~AsyncReadHandle() = default;
+
+    // Return true if all the requests are completed. It never blocks, so the caller
+    // like a pipeline IO task can yield and check again later.
+    virtual bool poll() = 0;
+
+    // Block until all the requests are completed.
+    virtual void wait() = 0;
+};
+using AsyncReadHandlePtr = std::unique_ptr<AsyncReadHandle>;
+
+// The handle of the requests completed when they are submitted.
+class CompletedReadHandle : public AsyncReadHandle
+{
+public:
+    bool poll() override { return true; }
+    void wait() override {}
+};
+
 class RandomAccessFile
 {
 public:
@@ -35,6 +73,11 @@ public:
 
     [[nodiscard]] virtual ssize_t pread(char * buf, size_t size, off_t offset) const = 0;
 
+    // Submit a batch of reads and return without waiting for them if the implementation
+    // supports asynchronous IO. The default implementation reads the ranges one by one
+    // by `pread` and returns a completed handle.
+    [[nodiscard]] virtual AsyncReadHandlePtr submitReads(ReadRequests & requests);
+
     virtual std::string getFileName() const = 0;
 
     // This is a temporary hack interface for `S3RandomAccessFile`
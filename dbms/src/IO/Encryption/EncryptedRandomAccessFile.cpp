@@ -18,6 +18,53 @@
 
 namespace DB
 {
+namespace
+{
+class DecryptReadHandle : public AsyncReadHandle
+{
+public:
+    DecryptReadHandle(AsyncReadHandlePtr && handle_, ReadRequests & requests_, BlockAccessCipherStreamPtr stream_)
+        : handle(std::move(handle_))
+        , requests(requests_)
+        , stream(std::move(stream_))
+    {}
+
+    bool poll() override
+    {
+        if (decrypted)
+            return true;
+        if (!handle->poll())
+            return false;
+        decrypt();
+        return true;
+    }
+
+    void wait() override
+    {
+        if (decrypted)
+            return;
+        handle->wait();
+        decrypt();
+    }
+
+private:
+    void decrypt()
+    {
+        for (auto & req : requests)
+        {
+            if (req.result > 0)
+                stream->decrypt(req.offset, req.buf, req.result);
+        }
+        decrypted = true;
+    }
+
+    AsyncReadHandlePtr handle;
+    ReadRequests & requests;
+    BlockAccessCipherStreamPtr stream;
+    bool decrypted = false;
+};
+} // namespace
+
 void EncryptedRandomAccessFile::close()
 {
     file->close();
@@ -44,4 +91,9 @@ ssize_t EncryptedRandomAccessFile::pread(char * buf, size_t size, off_t offset)
     return bytes_read;
 }
 
+AsyncReadHandlePtr EncryptedRandomAccessFile::submitReads(ReadRequests & requests)
+{
+    return std::make_unique<DecryptReadHandle>(file->submitReads(requests), requests, stream);
+}
+
 } // namespace DB
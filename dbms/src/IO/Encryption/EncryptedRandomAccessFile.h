@@ -38,6 +38,9 @@ public:
 
     [[nodiscard]] ssize_t pread(char * buf, size_t size, off_t offset) const override;
 
+    // Submit the reads to the underlying file, and decrypt the data when they are completed.
+    [[nodiscard]] AsyncReadHandlePtr submitReads(ReadRequests & requests) override;
+
     std::string getFileName() const override { return file->getFileName(); }
 
     std::string getInitialFileName() const override { return file->getFileName(); }
@@ -28,6 +28,8 @@
 #include <TestUtils/TiFlashTestBasic.h>
 #include <gtest/gtest.h>
 
+#include <thread>
+
 
 #ifdef NDEBUG
 #define DBMS_ASSERT(X)    \
@@ -384,6 +386,67 @@ try
 }
 CATCH
 
+TEST(PosixRandomAccessFileTest, SubmitReads)
+try
+{
+    String file_path = tests::TiFlashTestEnv::getTemporaryPath("posix_submit_reads_file");
+    const size_t file_size = 1024 * 1024;
+    std::vector<char> data(file_size);
+    for (size_t i = 0; i < file_size; i++)
+    {
+        data[i] = (i * 7) % 0xFF;
+    }
+
+    std::string key_str(
+        reinterpret_cast<const char *>(test::KEY),
+        DB::Encryption::keySize(EncryptionMethod::Aes128Ctr));
+    std::string iv_str(reinterpret_cast<const char *>(test::IV_RANDOM), 16);
+    KeyManagerPtr key_manager = std::make_shared<MockKeyManager>(EncryptionMethod::Aes128Ctr, key_str, iv_str);
+    auto encryption_info = key_manager->newInfo(EncryptionPath("encryption", ""));
+    BlockAccessCipherStreamPtr cipher_stream = encryption_info.createCipherStream(EncryptionPath("encryption", ""));
+    {
+        WriteReadableFilePtr file
+            = std::make_shared<PosixWriteReadableFile>(file_path, true, -1, 0600, nullptr, nullptr);
+        WriteReadableFilePtr enc_file = std::make_shared<EncryptedWriteReadableFile>(file, cipher_stream);
+        // The buffer is encrypted in place
+        std::vector<char> buff_write(data);
+        ASSERT_EQ(file_size, enc_file->pwrite(buff_write.data(), file_size, 0));
+        enc_file->close();
+    }
+
+    auto check_reads = [&](RandomAccessFilePtr file) {
+        // More ranges than the entries of io_uring, they are submitted in multiple rounds
+        const size_t num_ranges = 2000;
+        ReadRequests requests(num_ranges);
+        std::vector<std::vector<char>> buffs(num_ranges);
+        for (size_t i = 0; i < num_ranges; ++i)
+        {
+            buffs[i].resize((i % 97) * 41 + 1);
+            requests[i].buf = buffs[i].data();
+            requests[i].size = buffs[i].size();
+            requests[i].offset = (i * 4099) % file_size;
+        }
+        // Read across the end of file
+        requests[0].offset = file_size - 10;
+
+        auto handle = file->submitReads(requests);
+        while (!handle->poll())
+            std::this_thread::yield();
+        for (size_t i = 0; i < num_ranges; ++i)
+        {
+            const auto & req = requests[i];
+            const size_t expected_size = std::min(req.size, file_size - static_cast<size_t>(req.offset));
+            ASSERT_EQ(req.result, static_cast<ssize_t>(expected_size)) << i;
+            ASSERT_EQ(memcmp(req.buf, data.data() + req.offset, expected_size), 0) << i;
+        }
+    };
+
+    RandomAccessFilePtr file = std::make_shared<PosixRandomAccessFile>(file_path, -1);
+    check_reads(std::make_shared<EncryptedRandomAccessFile>(file, cipher_stream));
+    file->close();
+}
+CATCH
+
 class FtruncateTest : public ::testing::Test
 {
 public:
@@ -113,7 +113,21 @@ void AggregatedDataVariants::destroyAggregationMethodImpl()
 #undef M
 }
 
-void AggregatedDataVariants::init(Type variants_type)
+namespace
+{
+template <typename Data>
+void reserveAggregatedData(Data & data, size_t reserve_size)
+{
+    // Only the single level hash tables support reserving, the others grow as usual.
+    if constexpr (requires { data.reserve(reserve_size); })
+    {
+        if (reserve_size > 0)
+            data.reserve(reserve_size);
+    }
+}
+} // namespace
+
+void AggregatedDataVariants::init(Type variants_type, size_t reserve_size)
 {
     destroyAggregationMethodImpl();
 
@@ -124,16 +138,18 @@ void AggregatedDataVariants::init(Type variants_type)
     case Type::without_key:
         break;
 
-#define M(NAME, IS_TWO_LEVEL)                                                                \
-    case AggregationMethodType(NAME):                                                        \
-    {                                                                                        \
-        aggregation_method_impl = std::make_unique<AggregationMethodName(NAME)>().release(); \
-        if (aggregator && !aggregator->params.key_ref_agg_func.empty())                      \
-            RUNTIME_CHECK_MSG(                                                               \
-                AggregationMethodName(NAME)::canUseKeyRefAggFuncOptimization(),              \
-                "cannot use key_ref_agg_func optimization for method {}",                    \
-                getMethodName());                                                            \
-        break;                                                                               \
+#define M(NAME, IS_TWO_LEVEL)                                                   \
+    case AggregationMethodType(NAME):                                           \
+    {                                                                           \
+        auto method_impl = std::make_unique<AggregationMethodName(NAME)>();     \
+        reserveAggregatedData(method_impl->data, reserve_size);                 \
+        aggregation_method_impl = method_impl.release();                        \
+        if (aggregator && !aggregator->params.key_ref_agg_func.empty())         \
+            RUNTIME_CHECK_MSG(                                                  \
+                AggregationMethodName(NAME)::canUseKeyRefAggFuncOptimization(), \
+                "cannot use key_ref_agg_func optimization for method {}",       \
+                getMethodName());                                               \
+        break;                                                                  \
     }
 
         APPLY_FOR_AGGREGATED_VARIANTS(M)
@@ -1162,7 +1178,7 @@ bool Aggregator::executeOnBlockImpl(
     /// How to perform the aggregation?
     if (!result.inited())
     {
-        result.init(method_chosen);
+        result.init(method_chosen, params.estimated_key_count);
         result.keys_size = params.keys_size;
         result.key_sizes = key_sizes;
         LOG_TRACE(log, "Aggregation method: `{}`", result.getMethodName());
@@ -615,7 +615,8 @@ struct AggregatedDataVariants : private boost::noncopyable
 
     ~AggregatedDataVariants();
 
-    void init(Type variants_type);
+    /// `reserve_size` is the number of keys to reserve in the hash table at the beginning, 0 - no reservation.
+    void init(Type variants_type, size_t reserve_size = 0);
 
     /// Number of rows (different keys).
     size_t size() const
@@ -875,6 +876,10 @@ public:
 
         bool use_magic_hash;
 
+        /// The estimated number of distinct keys, e.g. from the column statistics of the table scanned before
+        /// the aggregation. The hash table reserves it at the beginning to avoid rehashing, 0 - unknown.
+        size_t estimated_key_count = 0;
+
         Params(
             const Block & src_header_,
             const ColumnNumbers & keys_,
@@ -208,6 +208,22 @@ void AsynchronousMetrics::update()
         }
     }
 
+    {
+        if (auto ngram_bloom_cache = context.getNgramBloomIndexCache())
+        {
+            set("NgramBloomIndexCacheBytes", ngram_bloom_cache->weight());
+            set("NgramBloomIndexFiles", ngram_bloom_cache->count());
+        }
+    }
+
+    {
+        if (auto equality_bloom_cache = context.getEqualityBloomIndexCache())
+        {
+            set("EqualityBloomIndexCacheBytes", equality_bloom_cache->weight());
+            set("EqualityBloomIndexFiles", equality_bloom_cache->count());
+        }
+    }
+
     {
         if (auto rn_mvcc_index_cache = context.getSharedContextDisagg()->rn_mvcc_index_cache)
         {
@@ -305,6 +321,13 @@ void AsynchronousMetrics::update()
         set("LogDiskBytes", usage.total_log_disk_size);
         set("PagesInMem", usage.num_pages);
         set("VersionedEntries", DB::PS::PageStorageMemorySummary::versioned_entry_or_delete_count.load());
+        const auto versioned_pages = DB::PS::PageStorageMemorySummary::versioned_page_entries_count.load();
+        const auto versioned_pages_bytes = DB::PS::PageStorageMemorySummary::versioned_page_entries_bytes.load();
+        set("VersionedPageEntries", versioned_pages);
+        set("VersionedPageEntriesBytes", versioned_pages_bytes);
+        set(
+            "VersionedPageEntriesBytesPerPage",
+            versioned_pages > 0 ? 1.0 * versioned_pages_bytes / versioned_pages : 0);
         set("UniversalWrite", DB::PS::PageStorageMemorySummary::universal_write_count.load());
     }
 
@@ -58,6 +58,8 @@
 #include <Storages/DeltaMerge/File/ColumnCacheLongTerm.h>
 #include <Storages/DeltaMerge/Index/LocalIndexCache.h>
 #include <Storages/DeltaMerge/Index/MinMaxIndex.h>
+#include <Storages/DeltaMerge/Index/EqualityBloomIndex.h>
+#include <Storages/DeltaMerge/Index/NgramBloomIndex.h>
 #include <Storages/DeltaMerge/LocalIndexerScheduler.h>
 #include <Storages/DeltaMerge/StoragePool/GlobalPageIdAllocator.h>
 #include <Storages/DeltaMerge/StoragePool/GlobalStoragePool.h>
@@ -150,6 +152,9 @@ struct ContextShared
     mutable DBGInvoker dbg_invoker; /// Execute inner functions, debug only.
     mutable MarkCachePtr mark_cache; /// Cache of marks in compressed files.
     mutable DM::MinMaxIndexCachePtr minmax_index_cache; /// Cache of minmax index in compressed files.
+    mutable DM::NgramBloomIndexCachePtr ngram_bloom_index_cache; /// Cache of n-gram bloom index in compressed files.
+    mutable DM::EqualityBloomIndexCachePtr
+        equality_bloom_index_cache; /// Cache of equality bloom index in compressed files.
     mutable DM::LocalIndexCachePtr
         light_local_index_cache; // Cache of local index reader which memory usage is small < 1MB.
     mutable DM::LocalIndexCachePtr
@@ -1262,6 +1267,52 @@ bool Context::dropMinMaxIndexCacheAndReport() const
     return true;
 }
 
+void Context::setNgramBloomIndexCache(size_t cache_size_in_bytes)
+{
+    auto lock = getLock();
+
+    if (shared->ngram_bloom_index_cache)
+        throw Exception("N-gram bloom index cache has been already created.", ErrorCodes::LOGICAL_ERROR);
+
+    shared->ngram_bloom_index_cache = std::make_shared<DM::NgramBloomIndexCache>(cache_size_in_bytes);
+}
+
+DM::NgramBloomIndexCachePtr Context::getNgramBloomIndexCache() const
+{
+    auto lock = getLock();
+    return shared->ngram_bloom_index_cache;
+}
+
+void Context::dropNgramBloomIndexCache() const
+{
+    auto lock = getLock();
+    if (shared->ngram_bloom_index_cache)
+        shared->ngram_bloom_index_cache->reset();
+}
+
+void Context::setEqualityBloomIndexCache(size_t cache_size_in_bytes)
+{
+    auto lock = getLock();
+
+    if (shared->equality_bloom_index_cache)
+        throw Exception("Equality bloom index cache has been already created.", ErrorCodes::LOGICAL_ERROR);
+
+    shared->equality_bloom_index_cache = std::make_shared<DM::EqualityBloomIndexCache>(cache_size_in_bytes);
+}
+
+DM::EqualityBloomIndexCachePtr Context::getEqualityBloomIndexCache() const
+{
+    auto lock = getLock();
+    return shared->equality_bloom_index_cache;
+}
+
+void Context::dropEqualityBloomIndexCache() const
+{
+    auto lock = getLock();
+    if (shared->equality_bloom_index_cache)
+        shared->equality_bloom_index_cache->reset();
+}
+
 void Context::setLocalIndexCache(size_t light_local_index_cache, size_t heavy_cache_entities)
 {
     auto lock = getLock();
@@ -1757,6 +1808,7 @@ void Context::initializeWriteNodePageStorageIfNeed(const PathPool & path_pool)
         try
         {
             PageStorageConfig config;
+            config.wal_restore_threads = getSettingsRef().dt_page_wal_restore_threads;
             shared->ps_write = UniversalPageStorageService::create( //
                 *this,
                 "uni_write",
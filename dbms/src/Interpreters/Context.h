@@ -110,6 +110,8 @@ enum class PageStorageRunMode : UInt8;
 namespace DM
 {
 class MinMaxIndexCache;
+class NgramBloomIndexCache;
+class EqualityBloomIndexCache;
 class LocalIndexCache;
 class ColumnCacheLongTerm;
 class DeltaIndexManager;
@@ -403,6 +405,14 @@ public:
     /// Reset MinMaxIndexCache and report whether it was enabled before the reset.
     bool dropMinMaxIndexCacheAndReport() const;
 
+    void setNgramBloomIndexCache(size_t cache_size_in_bytes);
+    std::shared_ptr<DM::NgramBloomIndexCache> getNgramBloomIndexCache() const;
+    void dropNgramBloomIndexCache() const;
+
+    void setEqualityBloomIndexCache(size_t cache_size_in_bytes);
+    std::shared_ptr<DM::EqualityBloomIndexCache> getEqualityBloomIndexCache() const;
+    void dropEqualityBloomIndexCache() const;
+
     void setLocalIndexCache(size_t light_local_index_cache, size_t heavy_cache_entities);
     std::shared_ptr<DM::LocalIndexCache> getLightLocalIndexCache() const;
     std::shared_ptr<DM::LocalIndexCache> getHeavyLocalIndexCache() const;
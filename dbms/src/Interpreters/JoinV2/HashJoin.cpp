@@ -12,13 +12,20 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <Columns/ColumnString.h>
 #include <Columns/ColumnUtils.h>
+#include <Columns/ColumnsNumber.h>
 #include <Common/Exception.h>
 #include <Common/FailPoint.h>
+#include <Common/ProfileEvents.h>
 #include <Common/Stopwatch.h>
+#include <Common/assert_cast.h>
 #include <Core/ColumnsWithTypeAndName.h>
 #include <DataStreams/materializeBlock.h>
 #include <DataTypes/DataTypeNullable.h>
+#include <DataTypes/DataTypeString.h>
+#include <DataTypes/DataTypesNumber.h>
+#include <Flash/Pipeline/Schedule/Tasks/OneTimeNotifyFuture.h>
 #include <Interpreters/JoinUtils.h>
 #include <Interpreters/JoinV2/HashJoin.h>
 #include <Interpreters/JoinV2/HashJoinProbe.h>
@@ -29,6 +36,12 @@
 #include <magic_enum.hpp>
 #include <memory>
 
+namespace ProfileEvents
+{
+extern const Event JoinV2SpilledPartitions;
+extern const Event JoinV2RestoredPartitions;
+} // namespace ProfileEvents
+
 namespace DB
 {
 namespace FailPoints
@@ -108,6 +121,70 @@ StringCollatorKind getStringCollatorKind(const TiDB::TiDBCollators & collators)
     }
 }
 
+/// Scatter the block into `scatter_num` blocks by the selector.
+Blocks scatterBlock(const Block & block, const IColumn::Selector & selector, size_t scatter_num)
+{
+    Blocks result(scatter_num);
+    for (auto & res : result)
+        res = block.cloneEmpty();
+    size_t columns = block.columns();
+    for (size_t i = 0; i < columns; ++i)
+    {
+        auto scattered_columns = block.getByPosition(i).column->scatter(scatter_num, selector);
+        for (size_t j = 0; j < scatter_num; ++j)
+            result[j].getByPosition(i).column = std::move(scattered_columns[j]);
+    }
+    return result;
+}
+
+template <typename KeyGetter>
+void NO_INLINE computeJoinBuildPartitionsImpl(
+    void * key_getter_ptr,
+    ConstNullMapPtr null_map,
+    size_t rows,
+    IColumn::Selector & selector)
+{
+    using KeyGetterType = typename KeyGetter::Type;
+    using Hash = typename KeyGetter::Hash;
+    using HashValueType = typename KeyGetter::HashValueType;
+
+    auto & key_getter = *static_cast<KeyGetterType *>(key_getter_ptr);
+    for (size_t i = 0; i < rows; ++i)
+    {
+        if (null_map && (*null_map)[i])
+        {
+            selector[i] = JOIN_BUILD_PARTITION_COUNT;
+            continue;
+        }
+        const auto & key = key_getter.getJoinKeyWithBuffer(i);
+        selector[i] = getJoinBuildPartitionNum<HashValueType>(static_cast<HashValueType>(Hash()(key)));
+    }
+}
+
+/// Convert the rows of a row container to a spill block, each row is kept as its raw bytes.
+Block convertRowContainerToSpillBlock(const RowContainer & container, const Block & header)
+{
+    size_t rows = container.size();
+    auto row_column = ColumnString::create();
+    row_column->getChars().reserve(container.data.size() + rows);
+    row_column->getOffsets().reserve(rows);
+    for (size_t i = 0; i < rows; ++i)
+    {
+        size_t begin = i == 0 ? 0 : container.offsets[i - 1];
+        row_column->insertData(&container.data[begin], container.offsets[i] - begin);
+    }
+    auto hash_column = ColumnUInt64::create();
+    if (container.hashes.empty())
+        hash_column->getData().resize_fill_zero(rows);
+    else
+        hash_column->getData().assign(container.hashes.begin(), container.hashes.end());
+
+    Block block = header.cloneEmpty();
+    block.getByPosition(0).column = std::move(row_column);
+    block.getByPosition(1).column = std::move(hash_column);
+    return block;
+}
+
 } // namespace
 
 const DataTypePtr HashJoin::match_helper_type = makeNullable(std::make_shared<DataTypeInt8>());
@@ -120,8 +197,12 @@ HashJoin::HashJoin(
     const NamesAndTypes & output_columns_,
     const TiDB::TiDBCollators & collators_,
     const JoinNonEqualConditions & non_equal_conditions_,
-    const Settings & settings_,
-    const String & match_helper_name_)
+    const HashJoinSettings & settings_,
+    const String & match_helper_name_,
+    const SpillConfig & build_spill_config_,
+    const SpillConfig & probe_spill_config_,
+    size_t max_bytes_before_external_join_,
+    const RegisterOperatorSpillContext & register_operator_spill_context_)
     : kind(kind_)
     , join_req_id(req_id)
     , key_names_left(key_names_left_)
@@ -133,6 +214,13 @@ HashJoin::HashJoin(
     , log(Logger::get(join_req_id))
     , has_other_condition(non_equal_conditions.other_cond_expr != nullptr)
     , output_columns(output_columns_)
+    , wait_probe_finished_future(std::make_shared<OneTimeNotifyFuture>(NotifyType::WAIT_ON_JOIN_PROBE_FINISH))
+    , hash_join_spill_context(std::make_shared<HashJoinSpillContext>(
+          build_spill_config_,
+          probe_spill_config_,
+          max_bytes_before_external_join_,
+          log))
+    , register_operator_spill_context(register_operator_spill_context_)
 {
     RUNTIME_ASSERT(key_names_left.size() == key_names_right.size());
     output_block = Block(output_columns);
@@ -289,6 +377,8 @@ void HashJoin::initRowLayoutAndHashJoinMethod()
             c.name);
     }
     RUNTIME_CHECK(row_layout.raw_key_column_indexes.size() + row_layout.other_column_indexes.size() == columns);
+    if (needScanHashMapAfterProbe(kind))
+        row_layout.match_flag_size = ROW_MATCH_FLAG_SIZE;
     for (auto [column_index, is_nullable] : row_layout.raw_key_column_indexes)
         RUNTIME_CHECK(
             right_sample_block_pruned.safeGetByPosition(column_index).column->isColumnNullable() == is_nullable);
@@ -322,6 +412,26 @@ void HashJoin::initBuild(const Block & sample_block, size_t build_concurrency_)
     for (size_t i = 0; i < JOIN_BUILD_PARTITION_COUNT + 1; ++i)
         multi_row_containers.emplace_back(std::make_unique<MultipleRowContainer>());
 
+    hash_join_spill_context->init(JOIN_BUILD_PARTITION_COUNT);
+    if (hash_join_spill_context->supportSpill() && method == HashJoinKeyMethod::Cross)
+    {
+        hash_join_spill_context->disableSpill();
+        LOG_WARNING(log, "Join does not support spill, reason: cross join spill is not supported");
+    }
+    if (register_operator_spill_context != nullptr)
+        register_operator_spill_context(hash_join_spill_context);
+    if (hash_join_spill_context->isSpillEnabled())
+    {
+        build_input_header = sample_block.cloneEmpty();
+        build_spill_header = Block{
+            {ColumnString::create(), std::make_shared<DataTypeString>(), "__join_row"},
+            {ColumnUInt64::create(), std::make_shared<DataTypeUInt64>(), "__join_row_hash"}};
+        hash_join_spill_context->buildBuildSpiller(build_spill_header);
+        for (size_t i = 0; i < JOIN_BUILD_PARTITION_COUNT; ++i)
+            spill_partitions.emplace_back(std::make_unique<HashJoinSpillPartition>());
+        build_side_marked_spill_data.resize(build_concurrency);
+    }
+
     build_initialized = true;
 }
 
@@ -415,6 +525,13 @@ void HashJoin::initProbe(const Block & sample_block, size_t probe_concurrency_)
     active_probe_worker = probe_concurrency;
     probe_workers_data.resize(probe_concurrency);
 
+    if (hash_join_spill_context->isSpillEnabled())
+    {
+        probe_input_header = sample_block.cloneEmpty();
+        hash_join_spill_context->buildProbeSpiller(probe_input_header);
+        probe_side_marked_spill_data.resize(probe_concurrency);
+    }
+
     probe_initialized = true;
 }
 
@@ -433,6 +550,12 @@ bool HashJoin::finishOneBuildRow(size_t stream_index)
     if (active_build_worker.fetch_sub(1) == 1)
     {
         FAIL_POINT_TRIGGER_EXCEPTION(FailPoints::exception_mpp_hash_build);
+        /// All build workers have flushed their marked spill data before finishing.
+        if (hash_join_spill_context->isSpillEnabled())
+        {
+            hash_join_spill_context->finishBuild();
+            hash_join_spill_context->getBuildSpiller()->finishSpill();
+        }
         workAfterBuildRowFinish();
         return true;
     }
@@ -455,16 +578,60 @@ bool HashJoin::finishOneProbe(size_t stream_index)
     if (active_probe_worker.fetch_sub(1) == 1)
     {
         FAIL_POINT_TRIGGER_EXCEPTION(FailPoints::exception_mpp_hash_probe);
+        if (isSpilled())
+        {
+            /// Collect the remaining probe blocks of spilled partitions.
+            for (size_t i = 0; i < spill_partitions.size(); ++i)
+            {
+                if (!hash_join_spill_context->isPartitionSpilled(i))
+                    continue;
+                auto & partition = *spill_partitions[i];
+                std::unique_lock lock(partition.mu);
+                if (partition.probe_blocks.empty())
+                    continue;
+                auto & blocks = probe_side_marked_spill_data[stream_index][i];
+                for (auto & block : partition.probe_blocks)
+                    blocks.push_back(std::move(block));
+                partition.probe_blocks.clear();
+                partition.probe_bytes = 0;
+            }
+        }
+        if (!hasProbeSideMarkedSpillData(stream_index))
+            finalizeProbe();
         return true;
     }
     return false;
 }
 
+void HashJoin::finalizeProbe()
+{
+    profile_info->is_spill_enabled = hash_join_spill_context->isSpillEnabled();
+    profile_info->is_spilled = isSpilled();
+    if (hash_join_spill_context->isSpillEnabled())
+    {
+        hash_join_spill_context->getProbeSpiller()->finishSpill();
+        hash_join_spill_context->finishSpillableStage();
+    }
+    probe_finalized = true;
+    wait_probe_finished_future->finish();
+}
+
+bool HashJoin::isAllProbeFinished() const
+{
+    if (!probe_finalized.load())
+    {
+        setNotifyFuture(wait_probe_finished_future.get());
+        return false;
+    }
+    return true;
+}
+
 void HashJoin::workAfterBuildRowFinish()
 {
+    /// The rows of spilled partitions have been taken out of the row containers.
     size_t all_build_row_count = 0;
-    for (size_t i = 0; i < build_concurrency; ++i)
-        all_build_row_count += build_workers_data[i].row_count;
+    for (size_t i = 0; i < JOIN_BUILD_PARTITION_COUNT; ++i)
+        all_build_row_count += multi_row_containers[i]->all_row_count;
 
     bool enable_tagged_pointer = settings.enable_tagged_pointer;
     for (size_t i = 0; i < build_concurrency; ++i)
@@ -476,7 +643,8 @@ void HashJoin::workAfterBuildRowFinish()
         getHashValueByteSize(method),
         settings.probe_enable_prefetch_threshold,
         enable_tagged_pointer,
-        false);
+        false,
+        pointer_table_ignored_high_bits);
 
     /// Conservative threshold: trigger late materialization when lm_row_size average >= 16 bytes.
     constexpr size_t trigger_lm_row_size_threshold = 16;
@@ -523,6 +691,56 @@ void HashJoin::buildRowFromBlock(const Block & b, size_t stream_index)
     if unlikely (b.rows() == 0)
         return;
 
+    buildRowFromBlockImpl(b, stream_index);
+    if (hash_join_spill_context->isSpillEnabled())
+        spillBuildPartitionsIfNeeded(stream_index);
+}
+
+void HashJoin::buildRowFromSpilledBlock(const Block & block, size_t stream_index)
+{
+    RUNTIME_ASSERT(stream_index < build_concurrency);
+    RUNTIME_CHECK_MSG(build_initialized, "Logical error: Join build was not initialized");
+
+    size_t rows = block.rows();
+    if unlikely (rows == 0)
+        return;
+
+    Stopwatch watch;
+    auto & wd = build_workers_data[stream_index];
+    const auto & row_column = assert_cast<const ColumnString &>(*block.getByPosition(0).column);
+    const auto & hash_data = assert_cast<const ColumnUInt64 &>(*block.getByPosition(1).column).getData();
+
+    RowContainer container;
+    container.match_flag_size = row_layout.match_flag_size;
+    /// Each row needs at most `ROW_ALIGN - 1` bytes of padding to be aligned.
+    container.data.resize(row_column.getChars().size() + rows * ROW_ALIGN, CPU_CACHE_LINE_SIZE);
+    container.offsets.reserve(rows);
+    size_t data_size = 0;
+    for (size_t i = 0; i < rows; ++i)
+    {
+        /// The padding is added to the end of the previous row like `insertBlockToRowContainers`.
+        data_size = (data_size + ROW_ALIGN - 1) / ROW_ALIGN * ROW_ALIGN;
+        if (i > 0)
+            container.offsets.back() = data_size;
+        auto row = row_column.getDataAt(i);
+        memcpy(&container.data[data_size], row.data, row.size);
+        data_size += row.size;
+        container.offsets.push_back(data_size);
+    }
+    container.data.resize(data_size);
+    container.hashes.assign(hash_data.begin(), hash_data.end());
+
+    wd.enable_tagged_pointer &= isRowPtrTagZero(container.data.data());
+    wd.enable_tagged_pointer &= isRowPtrTagZero(container.data.data() + data_size);
+    wd.row_count += rows;
+    wd.all_size += data_size;
+    /// All the restored rows belong to one partition, so they are put into the first row container.
+    multi_row_containers[0]->insert(std::move(container), rows);
+    wd.build_time += watch.elapsedMilliseconds();
+}
+
+void HashJoin::buildRowFromBlockImpl(const Block & b, size_t stream_index)
+{
     Stopwatch watch;
 
     Block block = b;
@@ -665,6 +883,289 @@ Block HashJoin::probeLastResultBlock(size_t stream_index)
     return {};
 }
 
+Block HashJoin::scanAfterProbe(size_t stream_index)
+{
+    RUNTIME_ASSERT(stream_index < probe_concurrency);
+    RUNTIME_CHECK_MSG(needScanAfterProbe(), "join kind {} does not need scan after probe", magic_enum::enum_name(kind));
+    RUNTIME_CHECK_MSG(active_probe_worker == 0, "Logical error: scan after probe before all probe workers finish");
+
+    auto & wd = probe_workers_data[stream_index];
+    Stopwatch watch;
+    Block res = join_probe_helper->scanAfterProbe(wd);
+    wd.scan_after_probe_time += watch.elapsedFromLastTime();
+    if (!res)
+    {
+        LOG_DEBUG(
+            log,
+            "{} scan after probe cost {}ms, scan rows {}",
+            stream_index,
+            wd.scan_after_probe_time / 1000000UL,
+            wd.scan_after_probe_rows);
+    }
+    else
+    {
+        wd.scan_after_probe_rows += res.rows();
+    }
+    return res;
+}
+
+void HashJoin::spillBuildPartitionsIfNeeded(size_t stream_index)
+{
+    const auto & wd = build_workers_data[stream_index];
+    for (size_t i = 0; i < spill_partitions.size(); ++i)
+    {
+        if (wd.partition_row_count[i] == 0)
+            continue;
+        auto & partition = *spill_partitions[i];
+        std::unique_lock lock(partition.mu);
+        /// Also count the offset and hash of each row.
+        partition.build_bytes
+            += wd.partition_row_sizes[i] + wd.partition_row_count[i] * (sizeof(size_t) + sizeof(UInt64));
+        checkAndMarkBuildPartitionSpilledIfNeeded(i, stream_index);
+    }
+
+    for (auto partition_index : hash_join_spill_context->getPartitionsToSpill())
+    {
+        auto & partition = *spill_partitions[partition_index];
+        std::unique_lock lock(partition.mu);
+        if (hash_join_spill_context->isPartitionSpilled(partition_index))
+            continue;
+        LOG_INFO(log, "Join used {} bytes, will spill partition: {}", partition.build_bytes, partition_index);
+        hash_join_spill_context->markPartitionSpilled(partition_index);
+        ProfileEvents::increment(ProfileEvents::JoinV2SpilledPartitions);
+        if (!markBuildSideSpillData(partition_index, stream_index))
+            hash_join_spill_context->finishOneSpill(partition_index);
+    }
+}
+
+void HashJoin::checkAndMarkBuildPartitionSpilledIfNeeded(size_t partition_index, size_t stream_index)
+{
+    auto & partition = *spill_partitions[partition_index];
+    if (!hash_join_spill_context->updatePartitionRevocableMemory(partition_index, partition.build_bytes))
+        return;
+    if (!hash_join_spill_context->isPartitionSpilled(partition_index))
+    {
+        hash_join_spill_context->markPartitionSpilled(partition_index);
+        ProfileEvents::increment(ProfileEvents::JoinV2SpilledPartitions);
+    }
+    if (!markBuildSideSpillData(partition_index, stream_index))
+        hash_join_spill_context->finishOneSpill(partition_index);
+}
+
+bool HashJoin::markBuildSideSpillData(size_t partition_index, size_t stream_index)
+{
+    auto & partition = *spill_partitions[partition_index];
+    partition.build_bytes = 0;
+    auto row_containers = multi_row_containers[partition_index]->takeAll();
+    if (row_containers.empty())
+        return false;
+    auto & blocks_to_spill = build_side_marked_spill_data[stream_index][partition_index];
+    for (auto & container : row_containers)
+    {
+        blocks_to_spill.push_back(convertRowContainerToSpillBlock(container, build_spill_header));
+        /// Release the memory of rows as soon as they are converted.
+        container = RowContainer{};
+    }
+    return true;
+}
+
+void HashJoin::checkAndMarkPartitionSpilledIfNeeded(size_t stream_index)
+{
+    if (!hash_join_spill_context->isSpillEnabled())
+        return;
+    for (size_t i = 0; i < spill_partitions.size(); ++i)
+    {
+        if (!hash_join_spill_context->isPartitionMarkedForAutoSpill(i))
+            continue;
+        auto & partition = *spill_partitions[i];
+        std::unique_lock lock(partition.mu, std::try_to_lock);
+        /// If someone already holds the lock, it will check the spill.
+        if (lock.owns_lock())
+            checkAndMarkBuildPartitionSpilledIfNeeded(i, stream_index);
+    }
+}
+
+void HashJoin::markRemainingBuildSideSpillData(size_t stream_index)
+{
+    if (!hash_join_spill_context->isSpillEnabled())
+        return;
+    for (size_t i = 0; i < spill_partitions.size(); ++i)
+    {
+        if (!hash_join_spill_context->isPartitionSpilled(i))
+            continue;
+        auto & partition = *spill_partitions[i];
+        std::unique_lock lock(partition.mu);
+        markBuildSideSpillData(i, stream_index);
+    }
+}
+
+bool HashJoin::hasBuildSideMarkedSpillData(size_t stream_index) const
+{
+    if (!hash_join_spill_context->isSpillEnabled())
+        return false;
+    return !build_side_marked_spill_data[stream_index].empty();
+}
+
+void HashJoin::flushBuildSideMarkedSpillData(size_t stream_index)
+{
+    auto & data = build_side_marked_spill_data[stream_index];
+    for (auto & [partition_index, blocks_to_spill] : data)
+    {
+        hash_join_spill_context->getBuildSpiller()->spillBlocks(std::move(blocks_to_spill), partition_index);
+        hash_join_spill_context->finishOneSpill(partition_index);
+    }
+    data.clear();
+}
+
+Block HashJoin::dispatchProbeBlock(const Block & block, size_t stream_index)
+{
+    size_t partition_num = spill_partitions.size();
+    BoolVec partition_spilled(partition_num);
+    for (size_t i = 0; i < partition_num; ++i)
+        partition_spilled[i] = hash_join_spill_context->isPartitionSpilled(i);
+    IColumn::Selector selector = getProbePartitionSelector(block);
+    /// The rows of not spilled partitions and the rows with null join key are gathered in the extra last block.
+    for (auto & partition_index : selector)
+    {
+        if (partition_index >= partition_num || !partition_spilled[partition_index])
+            partition_index = partition_num;
+    }
+    Blocks partition_blocks = scatterBlock(block, selector, partition_num + 1);
+    for (size_t i = 0; i < partition_num; ++i)
+    {
+        if (partition_blocks[i].rows() == 0)
+            continue;
+        auto & partition = *spill_partitions[i];
+        std::unique_lock lock(partition.mu);
+        partition.probe_bytes += partition_blocks[i].allocatedBytes();
+        partition.probe_blocks.push_back(std::move(partition_blocks[i]));
+        if (hash_join_spill_context->updatePartitionRevocableMemory(i, partition.probe_bytes))
+        {
+            auto & blocks_to_spill = probe_side_marked_spill_data[stream_index][i];
+            for (auto & probe_block : partition.probe_blocks)
+                blocks_to_spill.push_back(std::move(probe_block));
+            partition.probe_blocks.clear();
+            partition.probe_bytes = 0;
+        }
+    }
+    /// The last block contains the rows of not spilled partitions.
+    return std::move(partition_blocks.back());
+}
+
+IColumn::Selector HashJoin::getProbePartitionSelector(const Block & block) const
+{
+    size_t rows = block.rows();
+    Columns materialized_columns;
+    ColumnRawPtrs key_columns = extractAndMaterializeKeyColumns(block, materialized_columns, key_names_left);
+    ColumnPtr null_map_holder;
+    ConstNullMapPtr null_map{};
+    extractNestedColumnsAndNullMap(key_columns, null_map_holder, null_map);
+
+    /// The same hash value as the build side, so a probe row is dispatched to the build partition of its key.
+    auto key_getter = createHashJoinKeyGetter(method, collators);
+    resetHashJoinKeyGetter(method, key_getter, key_columns, row_layout);
+    IColumn::Selector selector(rows);
+    switch (method)
+    {
+#define M(METHOD)                                                                            \
+    case HashJoinKeyMethod::METHOD:                                                          \
+        computeJoinBuildPartitionsImpl<HashJoinKeyGetterForType<HashJoinKeyMethod::METHOD>>( \
+            key_getter.get(),                                                                \
+            null_map,                                                                        \
+            rows,                                                                            \
+            selector);                                                                       \
+        break;
+        APPLY_FOR_HASH_JOIN_VARIANTS(M)
+#undef M
+
+    default:
+        throw Exception(
+            fmt::format("Unknown JOIN keys variant {}.", magic_enum::enum_name(method)),
+            ErrorCodes::UNKNOWN_SET_DATA_VARIANT);
+    }
+    return selector;
+}
+
+bool HashJoin::hasProbeSideMarkedSpillData(size_t stream_index) const
+{
+    if (!hash_join_spill_context->isSpillEnabled())
+        return false;
+    return !probe_side_marked_spill_data[stream_index].empty();
+}
+
+void HashJoin::flushProbeSideMarkedSpillData(size_t stream_index)
+{
+    auto & data = probe_side_marked_spill_data[stream_index];
+    for (auto & [partition_index, blocks_to_spill] : data)
+    {
+        hash_join_spill_context->getProbeSpiller()->spillBlocks(std::move(blocks_to_spill), partition_index);
+        hash_join_spill_context->finishOneSpill(partition_index);
+    }
+    data.clear();
+}
+
+std::optional<HashJoinRestoreInfo> HashJoin::getOneRestoreInfo()
+{
+    if (!isSpilled())
+        return {};
+    RUNTIME_CHECK_MSG(probe_finalized, "Logical error: restore before all probe workers finish");
+    while (true)
+    {
+        size_t partition_index = restore_partition_index.fetch_add(1);
+        if (partition_index >= spill_partitions.size())
+            return {};
+        if (!hash_join_spill_context->isPartitionSpilled(partition_index))
+            continue;
+
+        auto build_streams = hash_join_spill_context->getBuildSpiller()->restoreBlocks(partition_index, 1);
+        auto probe_streams = hash_join_spill_context->getProbeSpiller()->restoreBlocks(partition_index, 1);
+        RUNTIME_CHECK(build_streams.size() == 1 && probe_streams.size() == 1);
+        LOG_INFO(log, "Begin to restore spilled partition {}", partition_index);
+        ProfileEvents::increment(ProfileEvents::JoinV2RestoredPartitions);
+        return HashJoinRestoreInfo{
+            createRestoreJoin(partition_index),
+            partition_index,
+            build_streams.back(),
+            probe_streams.back()};
+    }
+}
+
+HashJoinPtr HashJoin::createRestoreJoin(size_t partition_index) const
+{
+    auto restore_req_id = fmt::format("{}_restore_{}", join_req_id, partition_index);
+    auto restore_join = std::make_shared<HashJoin>(
+        key_names_left,
+        key_names_right,
+        kind,
+        restore_req_id,
+        output_columns,
+        collators,
+        non_equal_conditions,
+        settings,
+        match_helper_name,
+        hash_join_spill_context->createBuildSpillConfig(fmt::format("{}_build", restore_req_id)),
+        hash_join_spill_context->createProbeSpillConfig(fmt::format("{}_probe", restore_req_id)),
+        0,
+        nullptr);
+    /// The restore join shares the finalized schema with the original join.
+    restore_join->output_columns_after_finalize = output_columns_after_finalize;
+    restore_join->output_block_after_finalize = output_block_after_finalize;
+    restore_join->output_column_names_set_after_finalize = output_column_names_set_after_finalize;
+    restore_join->output_columns_names_set_for_other_condition_after_finalize
+        = output_columns_names_set_for_other_condition_after_finalize;
+    restore_join->required_columns = required_columns;
+    restore_join->required_columns_names_set_for_other_condition = required_columns_names_set_for_other_condition;
+    restore_join->finalized = true;
+    /// The restored rows are in one build partition, so the partition bits of the hash value are useless.
+    restore_join->pointer_table_ignored_high_bits = JOIN_BUILD_PARTITION_BITS;
+
+    restore_join->initBuild(build_input_header, 1);
+    restore_join->initProbe(probe_input_header, 1);
+    /// The spilled rows are restored as they are, so the layout of rows must be the same.
+    RUNTIME_CHECK(restore_join->method == method);
+    return restore_join;
+}
+
 void HashJoin::removeUselessColumn(Block & block) const
 {
     const NameSet & probe_output_name_set = has_other_condition
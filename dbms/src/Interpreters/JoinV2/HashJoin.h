@@ -17,9 +17,13 @@
 #include <Common/Arena.h>
 #include <Common/Logger.h>
 #include <Core/Block.h>
+#include <DataStreams/IBlockInputStream.h>
 #include <Flash/Coprocessor/DAGContext.h>
 #include <Flash/Coprocessor/JoinInterpreterHelper.h>
+#include <Flash/Pipeline/Schedule/Tasks/OneTimeNotifyFuture.h>
 #include <Interpreters/ExpressionActions.h>
+#include <Interpreters/HashJoinSpillContext.h>
+#include <Interpreters/JoinUtils.h>
 #include <Interpreters/JoinV2/HashJoinBuild.h>
 #include <Interpreters/JoinV2/HashJoinKey.h>
 #include <Interpreters/JoinV2/HashJoinPointerTable.h>
@@ -28,10 +32,38 @@
 #include <Interpreters/JoinV2/HashJoinSettings.h>
 #include <Interpreters/JoinV2/SemiJoinProbe.h>
 
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
 
 namespace DB
 {
 
+/// The unit of spill and restore. The spill partitions are the build partitions of the row containers,
+/// so the build rows are inserted into the row containers directly and only spilled when needed.
+struct HashJoinSpillPartition
+{
+    std::mutex mu;
+    /// Bytes of the build rows of this partition in the row containers.
+    size_t build_bytes = 0;
+    /// Probe blocks of a spilled partition which are waiting to be spilled.
+    Blocks probe_blocks;
+    size_t probe_bytes = 0;
+};
+
+class HashJoin;
+using HashJoinPtr = std::shared_ptr<HashJoin>;
+
+struct HashJoinRestoreInfo
+{
+    /// A join without spill to join the restored blocks of one spilled partition.
+    HashJoinPtr join;
+    size_t partition_index;
+    BlockInputStreamPtr build_stream;
+    BlockInputStreamPtr probe_stream;
+};
+
 class HashJoin
 {
 public:
@@ -43,8 +75,12 @@ public:
         const NamesAndTypes & output_columns_,
         const TiDB::TiDBCollators & collators_,
         const JoinNonEqualConditions & non_equal_conditions_,
-        const Settings & settings,
-        const String & match_helper_name_);
+        const HashJoinSettings & settings_,
+        const String & match_helper_name_,
+        const SpillConfig & build_spill_config_,
+        const SpillConfig & probe_spill_config_,
+        size_t max_bytes_before_external_join_,
+        const RegisterOperatorSpillContext & register_operator_spill_context_);
 
     void initBuild(const Block & sample_block, size_t build_concurrency_ = 1);
 
@@ -56,10 +92,22 @@ public:
     bool finishOneProbe(size_t stream_index);
 
     void buildRowFromBlock(const Block & block, size_t stream_index);
+    /// Insert the rows spilled from a row container, used by the restore join.
+    void buildRowFromSpilledBlock(const Block & block, size_t stream_index);
     bool buildPointerTable(size_t stream_index);
 
     Block probeBlock(JoinProbeContext & ctx, size_t stream_index);
     Block probeLastResultBlock(size_t stream_index);
+    /// Called by the last probe worker after its marked spill data have been flushed.
+    void finalizeProbe();
+
+    /// Right outer/semi/anti join needs to scan the build side rows after all probe workers finish.
+    bool needScanAfterProbe() const { return needScanHashMapAfterProbe(kind); }
+    /// Return false and set the notify future if some probe workers have not finished.
+    bool isAllProbeFinished() const;
+    /// Return an empty block if there is no more data.
+    Block scanAfterProbe(size_t stream_index);
+    const OneTimeNotifyFuturePtr & getWaitProbeFinishedFuture() const { return wait_probe_finished_future; }
 
     void removeUselessColumn(Block & block) const;
     /// Block's schema must be all_sample_block_pruned.
@@ -76,11 +124,41 @@ public:
 
     const JoinProfileInfoPtr & getProfileInfo() const { return profile_info; }
 
+    /// For spill
+    bool isSpilled() const { return hash_join_spill_context->isSpilled(); }
+    /// Check the partitions marked by auto spill and collect the blocks to spill of them.
+    void checkAndMarkPartitionSpilledIfNeeded(size_t stream_index);
+    /// Collect the remaining build rows of spilled partitions, must be called before `finishOneBuildRow`.
+    void markRemainingBuildSideSpillData(size_t stream_index);
+    bool hasBuildSideMarkedSpillData(size_t stream_index) const;
+    void flushBuildSideMarkedSpillData(size_t stream_index);
+    /// Buffer the rows of spilled partitions to be spilled and return the rest rows.
+    Block dispatchProbeBlock(const Block & block, size_t stream_index);
+    bool hasProbeSideMarkedSpillData(size_t stream_index) const;
+    void flushProbeSideMarkedSpillData(size_t stream_index);
+    /// Return nullopt if there is no more spilled partition to restore.
+    std::optional<HashJoinRestoreInfo> getOneRestoreInfo();
+
 private:
     void initRowLayoutAndHashJoinMethod();
 
     void workAfterBuildRowFinish();
 
+    void buildRowFromBlockImpl(const Block & block, size_t stream_index);
+
+    /// For spill
+    using MarkedSpillData = std::unordered_map<size_t, Blocks>;
+    /// Account the rows just inserted by this worker and spill the partitions if needed.
+    void spillBuildPartitionsIfNeeded(size_t stream_index);
+    /// The lock of the partition must be held.
+    void checkAndMarkBuildPartitionSpilledIfNeeded(size_t partition_index, size_t stream_index);
+    /// Take the rows of the partition out of the row containers to spill.
+    /// The lock of the partition must be held. Return false if there is no row.
+    bool markBuildSideSpillData(size_t partition_index, size_t stream_index);
+    /// Return the build partition of each row, `JOIN_BUILD_PARTITION_COUNT` for the rows with null join key.
+    IColumn::Selector getProbePartitionSelector(const Block & block) const;
+    HashJoinPtr createRestoreJoin(size_t partition_index) const;
+
 private:
     friend JoinProbeHelper;
     friend SemiJoinProbeHelper;
@@ -147,6 +225,8 @@ private:
     std::atomic<size_t> active_build_worker = 0;
 
     HashJoinPointerTable pointer_table;
+    /// The restored rows of a spilled partition have the same partition bits in the hash value.
+    size_t pointer_table_ignored_high_bits = 0;
 
     /// Probe phase
     size_t probe_concurrency = 0;
@@ -154,13 +234,26 @@ private:
     std::atomic<size_t> active_probe_worker = 0;
     std::unique_ptr<JoinProbeHelper> join_probe_helper;
     std::unique_ptr<SemiJoinProbeHelper> semi_join_probe_helper;
+    std::atomic<bool> probe_finalized = false;
+    OneTimeNotifyFuturePtr wait_probe_finished_future;
 
     const JoinProfileInfoPtr profile_info = std::make_shared<JoinProfileInfo>();
 
     /// For other condition
     BoolVec left_required_flag_for_other_condition;
-};
 
-using HashJoinPtr = std::shared_ptr<HashJoin>;
+    /// For spill
+    HashJoinSpillContextPtr hash_join_spill_context;
+    const RegisterOperatorSpillContext register_operator_spill_context;
+    /// Input headers of both sides.
+    Block build_input_header;
+    Block probe_input_header;
+    /// The schema of spilled build blocks, each row of a row container is spilled as its raw bytes and hash.
+    Block build_spill_header;
+    std::vector<std::unique_ptr<HashJoinSpillPartition>> spill_partitions;
+    std::vector<MarkedSpillData> build_side_marked_spill_data;
+    std::vector<MarkedSpillData> probe_side_marked_spill_data;
+    std::atomic<size_t> restore_partition_index = 0;
+};
 
 } // namespace DB
@@ -72,17 +72,24 @@ void NO_INLINE insertBlockToRowContainersTypeImpl(
             block.getByPosition(index).column->countSerializeByteSize(wd.row_sizes);
     }
 
+    if constexpr (need_record_null_rows)
+    {
+        /// The raw required join keys of the rows with null join key can not be restored from the serialized join key.
+        wd.raw_key_sizes.clear();
+        wd.raw_key_sizes.resize_fill_zero(rows);
+        for (const auto & [index, _] : row_layout.raw_key_column_indexes)
+            block.getByPosition(index).column->countSerializeByteSize(wd.raw_key_sizes);
+    }
+
     for (size_t i = 0; i < rows; ++i)
     {
         if (has_null_map && (*null_map)[i])
         {
             if constexpr (need_record_null_rows)
             {
-                //TODO
-                //wd.row_sizes[i] += sizeof(RowPtr);
-                //wd.row_sizes[i] = alignRowSize(wd.row_sizes[i]);
-                //wd.partition_row_sizes[part_count - 1] += wd.row_sizes[i];
-                //++wd.partition_row_count[part_count - 1];
+                wd.row_sizes[i] += wd.raw_key_sizes[i];
+                wd.partition_row_sizes[part_count - 1] += wd.row_sizes[i];
+                ++wd.partition_row_count[part_count - 1];
             }
             continue;
         }
@@ -90,7 +97,7 @@ void NO_INLINE insertBlockToRowContainersTypeImpl(
         wd.hashes[i] = static_cast<HashValueType>(Hash()(key));
         size_t part_num = getJoinBuildPartitionNum<HashValueType>(wd.hashes[i]);
 
-        size_t ptr_and_key_size = sizeof(RowPtr) + key_getter.getJoinKeyByteSize(key);
+        size_t ptr_and_key_size = row_layout.match_flag_size + sizeof(RowPtr) + key_getter.getJoinKeyByteSize(key);
         if constexpr (KeyGetterType::joinKeyCompareHashFirst())
         {
             ptr_and_key_size += sizeof(HashValueType);
@@ -137,6 +144,8 @@ void NO_INLINE insertBlockToRowContainersTypeImpl(
             wd.enable_tagged_pointer &= isRowPtrTagZero(container.data.data() + wd.partition_row_sizes[i]);
             RUNTIME_CHECK((reinterpret_cast<uintptr_t>(container.data.data()) & (CPU_CACHE_LINE_SIZE - 1)) == 0);
             wd.all_size += wd.partition_row_sizes[i];
+            if (i != JOIN_BUILD_PARTITION_COUNT)
+                container.match_flag_size = row_layout.match_flag_size;
 
             container.offsets.reserve(wd.partition_row_count[i]);
             if constexpr (!KeyGetterType::joinKeyCompareHashFirst())
@@ -165,7 +174,11 @@ void NO_INLINE insertBlockToRowContainersTypeImpl(
             {
                 if constexpr (need_record_null_rows)
                 {
-                    //TODO
+                    constexpr size_t null_part_num = JOIN_BUILD_PARTITION_COUNT;
+                    wd.row_ptrs.push_back(
+                        partition_column_row[null_part_num].data.data() + wd.partition_row_sizes[null_part_num]);
+                    wd.partition_row_sizes[null_part_num] += wd.row_sizes[j];
+                    partition_column_row[null_part_num].offsets.push_back(wd.partition_row_sizes[null_part_num]);
                 }
                 else
                 {
@@ -181,6 +194,11 @@ void NO_INLINE insertBlockToRowContainersTypeImpl(
             wd.partition_row_sizes[part_num] += wd.row_sizes[j];
             partition_column_row[part_num].offsets.push_back(wd.partition_row_sizes[part_num]);
 
+            if (row_layout.match_flag_size > 0)
+            {
+                memset(ptr, 0, row_layout.match_flag_size);
+                ptr += row_layout.match_flag_size;
+            }
             unalignedStore<RowPtr>(ptr, nullptr);
             ptr += sizeof(RowPtr);
 
@@ -197,6 +215,22 @@ void NO_INLINE insertBlockToRowContainersTypeImpl(
             key_getter.serializeJoinKey(key, ptr);
             ptr += key_getter.getJoinKeyByteSize(key);
         }
+        if constexpr (need_record_null_rows)
+        {
+            if (!row_layout.raw_key_column_indexes.empty())
+            {
+                wd.null_row_ptrs.clear();
+                for (size_t j = start; j < end; ++j)
+                    wd.null_row_ptrs.push_back((*null_map)[j] ? wd.row_ptrs[j - start] : nullptr);
+                for (const auto & [index, _] : row_layout.raw_key_column_indexes)
+                    block.getByPosition(index).column->serializeToPos(wd.null_row_ptrs, start, end - start, true);
+                for (size_t j = start; j < end; ++j)
+                {
+                    if ((*null_map)[j])
+                        wd.row_ptrs[j - start] = wd.null_row_ptrs[j - start];
+                }
+            }
+        }
         for (const auto & [index, _] : row_layout.other_column_indexes)
         {
             if constexpr (has_null_map && !need_record_null_rows)
@@ -52,6 +52,10 @@ struct alignas(CPU_CACHE_LINE_SIZE) JoinBuildWorkerData
     PaddedPODArray<size_t> hashes;
     RowPtrs row_ptrs;
 
+    /// For rows with null join key that need to be recorded
+    PaddedPODArray<size_t> raw_key_sizes;
+    RowPtrs null_row_ptrs;
+
     PaddedPODArray<size_t> partition_row_sizes;
     PaddedPODArray<size_t> partition_row_count;
     PaddedPODArray<ssize_t> partition_last_row_index;
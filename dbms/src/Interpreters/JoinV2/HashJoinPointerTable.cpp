@@ -25,26 +25,33 @@ void HashJoinPointerTable::init(
     size_t hash_value_bytes,
     size_t probe_prefetch_threshold,
     bool enable_tagged_pointer_,
-    bool is_unit_test)
+    bool is_unit_test,
+    size_t ignored_high_bits)
 {
     hash_value_bits = hash_value_bytes * 8;
     if (method == HashJoinKeyMethod::OneKey8)
     {
         assert(hash_value_bits == 8);
         pointer_table_size = 1 << 8;
+        ignored_high_bits = 0;
     }
     else if (method == HashJoinKeyMethod::OneKey16)
     {
         assert(hash_value_bits == 16);
         pointer_table_size = 1 << 16;
+        ignored_high_bits = 0;
     }
     else
     {
+        /// The ignored high bits are the same for all rows, e.g. the rows restored from one spilled partition,
+        /// so they are skipped to spread the rows to all buckets.
+        RUNTIME_CHECK(ignored_high_bits < hash_value_bits);
+        size_t usable_hash_value_bits = hash_value_bits - ignored_high_bits;
         pointer_table_size = pointerTableCapacity(row_count);
-        /// Pointer table size cannot exceed the number that the hash value's byte number can express.
-        /// If hash_value_bits >= 64, 1ULL << hash_value_bits is an undefined behavior.
-        if (hash_value_bits < 64)
-            pointer_table_size = std::min(pointer_table_size, 1ULL << hash_value_bits);
+        /// Pointer table size cannot exceed the number that the usable bits of hash value can express.
+        /// If usable_hash_value_bits >= 64, 1ULL << usable_hash_value_bits is an undefined behavior.
+        if (usable_hash_value_bits < 64)
+            pointer_table_size = std::min(pointer_table_size, 1ULL << usable_hash_value_bits);
         /// It also cannot exceed 2^32 to avoid memory allocation error.
         pointer_table_size = std::min(pointer_table_size, 1ULL << 32);
     }
@@ -55,7 +62,8 @@ void HashJoinPointerTable::init(
 
     enable_probe_prefetch = pointer_table_size >= probe_prefetch_threshold;
 
-    pointer_table_size_mask = (pointer_table_size - 1) << (hash_value_bits - pointer_table_size_degree);
+    pointer_table_size_shift = hash_value_bits - ignored_high_bits - pointer_table_size_degree;
+    pointer_table_size_mask = (pointer_table_size - 1) << pointer_table_size_shift;
 
     // Do not allocate memory to speed up the unit test
     if likely (!is_unit_test)
@@ -40,7 +40,8 @@ public:
         size_t hash_value_bytes,
         size_t probe_prefetch_threshold,
         bool enable_tagged_pointer_,
-        bool is_unit_test);
+        bool is_unit_test,
+        size_t ignored_high_bits = 0);
 
     template <typename HashValueType>
     bool build(
@@ -50,7 +51,7 @@ public:
 
     size_t getBucketNum(UInt64 hash) const
     {
-        return (hash & pointer_table_size_mask) >> (hash_value_bits - pointer_table_size_degree);
+        return (hash & pointer_table_size_mask) >> pointer_table_size_shift;
     }
 
     size_t getPointerTableSize() const { return pointer_table_size; }
@@ -81,6 +82,7 @@ public:
     size_t pointer_table_size = 0;
     size_t pointer_table_size_degree = 0;
     size_t pointer_table_size_mask = 0;
+    size_t pointer_table_size_shift = 0;
     std::atomic<uintptr_t> * pointer_table = nullptr;
     Allocator<true> alloc;
     bool enable_probe_prefetch = false;
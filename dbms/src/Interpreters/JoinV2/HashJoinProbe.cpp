@@ -436,6 +436,103 @@ struct JoinProbeAdder<LeftOuterAnti, false, false>
     static void flush(JoinProbeHelper &, JoinProbeWorkerData &, MutableColumns &) {}
 };
 
+template <bool has_other_condition, bool late_materialization>
+struct JoinProbeAdder<RightOuter, has_other_condition, late_materialization>
+{
+    static constexpr bool need_matched = true;
+    static constexpr bool need_not_matched = false;
+    static constexpr bool break_on_first_match = false;
+
+    static bool ALWAYS_INLINE addMatched(
+        JoinProbeHelper & helper,
+        JoinProbeContext &,
+        JoinProbeWorkerData & wd,
+        MutableColumns & added_columns,
+        size_t idx,
+        size_t & current_offset,
+        RowPtr row_ptr,
+        size_t ptr_offset)
+    {
+        ++current_offset;
+        wd.selective_offsets.push_back(idx);
+        /// The build row is matched only if the other conditions are satisfied.
+        if constexpr (has_other_condition)
+            wd.matched_row_ptrs.push_back(row_ptr);
+        else
+            setRowMatched(row_ptr);
+        helper.insertRowToBatch<late_materialization>(wd, added_columns, row_ptr + ptr_offset);
+        return current_offset >= helper.settings.max_block_size;
+    }
+
+    static bool ALWAYS_INLINE
+    addNotMatched(JoinProbeHelper &, JoinProbeContext &, JoinProbeWorkerData &, size_t, size_t &)
+    {
+        return false;
+    }
+
+    static void flush(JoinProbeHelper & helper, JoinProbeWorkerData & wd, MutableColumns & added_columns)
+    {
+        helper.flushInsertBatch<late_materialization, true>(wd, added_columns);
+        helper.fillNullMapWithZero<late_materialization>(added_columns);
+    }
+};
+
+/// Right semi/anti join only marks the matched build rows in probe,
+/// the result is generated by scanning the build side after probe.
+template <bool has_other_condition, bool late_materialization>
+struct JoinProbeAdder<RightSemi, has_other_condition, late_materialization>
+{
+    static constexpr bool need_matched = true;
+    static constexpr bool need_not_matched = false;
+    static constexpr bool break_on_first_match = false;
+
+    static bool ALWAYS_INLINE addMatched(
+        JoinProbeHelper & helper,
+        JoinProbeContext &,
+        JoinProbeWorkerData & wd,
+        MutableColumns & added_columns,
+        size_t idx,
+        size_t & current_offset,
+        RowPtr row_ptr,
+        size_t ptr_offset)
+    {
+        if constexpr (has_other_condition)
+        {
+            ++current_offset;
+            wd.selective_offsets.push_back(idx);
+            wd.matched_row_ptrs.push_back(row_ptr);
+            helper.insertRowToBatch<late_materialization>(wd, added_columns, row_ptr + ptr_offset);
+            return current_offset >= helper.settings.max_block_size;
+        }
+        else
+        {
+            setRowMatched(row_ptr);
+            return false;
+        }
+    }
+
+    static bool ALWAYS_INLINE
+    addNotMatched(JoinProbeHelper &, JoinProbeContext &, JoinProbeWorkerData &, size_t, size_t &)
+    {
+        return false;
+    }
+
+    static void flush(JoinProbeHelper & helper, JoinProbeWorkerData & wd, MutableColumns & added_columns)
+    {
+        if constexpr (has_other_condition)
+        {
+            helper.flushInsertBatch<late_materialization, true>(wd, added_columns);
+            helper.fillNullMapWithZero<late_materialization>(added_columns);
+        }
+    }
+};
+
+template <bool has_other_condition, bool late_materialization>
+struct JoinProbeAdder<RightAnti, has_other_condition, late_materialization>
+    : JoinProbeAdder<RightSemi, has_other_condition, late_materialization>
+{
+};
+
 JoinProbeHelper::JoinProbeHelper(const HashJoin * join, bool late_materialization)
     : JoinProbeHelperUtil(join->settings, join->row_layout)
     , join(join)
@@ -488,6 +585,12 @@ JoinProbeHelper::JoinProbeHelper(const HashJoin * join, bool late_materializatio
             CALL2(KeyGetter, LeftOuterSemi, false, false)                                                  \
         else if (kind == LeftOuterAnti && !has_other_condition)                                            \
             CALL2(KeyGetter, LeftOuterAnti, false, false)                                                  \
+        else if (kind == RightOuter)                                                                       \
+            CALL1(KeyGetter, RightOuter)                                                                   \
+        else if (kind == RightSemi)                                                                        \
+            CALL1(KeyGetter, RightSemi)                                                                    \
+        else if (kind == RightAnti)                                                                        \
+            CALL1(KeyGetter, RightAnti)                                                                    \
         else                                                                                               \
             throw Exception(                                                                               \
                 fmt::format("Logical error: unknown combination of JOIN {}", magic_enum::enum_name(kind)), \
@@ -500,6 +603,8 @@ JoinProbeHelper::JoinProbeHelper(const HashJoin * join, bool late_materializatio
     case HashJoinKeyMethod::METHOD:                                                        \
         using KeyGetterType##METHOD = HashJoinKeyGetterForType<HashJoinKeyMethod::METHOD>; \
         CALL(KeyGetterType##METHOD);                                                       \
+        if (needScanHashMapAfterProbe(join->kind))                                         \
+            scan_func_ptr = &JoinProbeHelper::scanAfterProbeImpl<KeyGetterType##METHOD>;   \
         break;
         APPLY_FOR_HASH_JOIN_VARIANTS(M)
 #undef M
@@ -513,6 +618,20 @@ JoinProbeHelper::JoinProbeHelper(const HashJoin * join, bool late_materializatio
 #undef CALL1
 #undef CALL2
 #undef CALL3
+
+    if (needScanHashMapAfterProbe(join->kind))
+    {
+        /// The key getter is only used to get the offset of raw required join keys in the build rows,
+        /// which only depends on the types of join key columns.
+        Columns materialized_columns;
+        ColumnRawPtrs key_columns
+            = extractAndMaterializeKeyColumns(join->right_sample_block, materialized_columns, join->key_names_right);
+        ColumnPtr null_map_holder;
+        ConstNullMapPtr null_map{};
+        extractNestedColumnsAndNullMap(key_columns, null_map_holder, null_map);
+        scan_key_getter = createHashJoinKeyGetter(join->method, join->collators);
+        resetHashJoinKeyGetter(join->method, scan_key_getter, key_columns, row_layout);
+    }
 }
 
 Block JoinProbeHelper::probe(JoinProbeContext & ctx, JoinProbeWorkerData & wd)
@@ -523,6 +642,12 @@ Block JoinProbeHelper::probe(JoinProbeContext & ctx, JoinProbeWorkerData & wd)
         return (this->*func_ptr_no_null)(ctx, wd);
 }
 
+Block JoinProbeHelper::scanAfterProbe(JoinProbeWorkerData & wd)
+{
+    RUNTIME_CHECK(scan_func_ptr != nullptr);
+    return (this->*scan_func_ptr)(wd);
+}
+
 JOIN_PROBE_HELPER_TEMPLATE
 Block JoinProbeHelper::probeImpl(JoinProbeContext & ctx, JoinProbeWorkerData & wd)
 {
@@ -556,6 +681,11 @@ Block JoinProbeHelper::probeImpl(JoinProbeContext & ctx, JoinProbeWorkerData & w
         wd.row_ptrs_for_lm.clear();
         wd.row_ptrs_for_lm.reserve(settings.max_block_size);
     }
+    if constexpr ((kind == RightOuter || kind == RightSemi || kind == RightAnti) && has_other_condition)
+    {
+        wd.matched_row_ptrs.clear();
+        wd.matched_row_ptrs.reserve(settings.max_block_size);
+    }
 
     size_t left_columns = join->left_sample_block_pruned.columns();
     size_t right_columns = join->right_sample_block_pruned.columns();
@@ -595,7 +725,9 @@ Block JoinProbeHelper::probeImpl(JoinProbeContext & ctx, JoinProbeWorkerData & w
     for (size_t i = 0; i < right_columns; ++i)
         wd.result_block.safeGetByPosition(left_columns + i).column = std::move(added_columns[i]);
 
-    if constexpr (kind == Inner || kind == LeftOuter || kind == Semi || kind == Anti)
+    if constexpr (
+        kind == Inner || kind == LeftOuter || kind == Semi || kind == Anti || kind == RightOuter || kind == RightSemi
+        || kind == RightAnti)
     {
         if (wd.selective_offsets.empty())
             return join->output_block_after_finalize;
@@ -1086,6 +1218,20 @@ Block JoinProbeHelper::handleOtherConditions(
         }
     }
 
+    if (kind == RightOuter || kind == RightSemi || kind == RightAnti)
+    {
+        RUNTIME_CHECK(wd.matched_row_ptrs.size() == rows);
+        RUNTIME_CHECK(wd.filter.size() == rows);
+        for (size_t i = 0; i < rows; ++i)
+        {
+            if (wd.filter[i])
+                setRowMatched(wd.matched_row_ptrs[i]);
+        }
+        /// The result of right semi/anti join is generated after probe.
+        if (kind != RightOuter)
+            return output_block_after_finalize;
+    }
+
     join->initOutputBlock(wd.result_block_for_other_condition);
 
     RUNTIME_CHECK_MSG(
@@ -1360,6 +1506,108 @@ Block JoinProbeHelper::fillNotMatchedRowsForLeftOuter(JoinProbeContext & ctx, Jo
     return res_block;
 }
 
+template <typename KeyGetter>
+Block JoinProbeHelper::scanAfterProbeImpl(JoinProbeWorkerData & wd)
+{
+    using KeyGetterType = typename KeyGetter::Type;
+    using HashValueType = typename KeyGetter::HashValueType;
+
+    const auto kind = join->kind;
+    RUNTIME_CHECK(kind == RightOuter || kind == RightSemi || kind == RightAnti);
+    /// Right semi join outputs the matched rows and right outer/anti join outputs the not matched rows.
+    const bool output_matched = kind == RightSemi;
+    /// The rows with null join key are stored in the last partition if needed.
+    const size_t partition_count
+        = needRecordNotInsertRows(kind) ? JOIN_BUILD_PARTITION_COUNT + 1 : JOIN_BUILD_PARTITION_COUNT;
+
+    const auto & key_getter = *static_cast<const KeyGetterType *>(scan_key_getter.get());
+    constexpr size_t key_offset
+        = sizeof(RowPtr) + (KeyGetterType::joinKeyCompareHashFirst() ? sizeof(HashValueType) : 0);
+
+    size_t left_columns = join->left_sample_block_pruned.columns();
+    size_t right_columns = join->right_sample_block_pruned.columns();
+    Block res_block = join->all_sample_block_pruned.cloneEmpty();
+    RUNTIME_CHECK(left_columns + right_columns == res_block.columns());
+    MutableColumns added_columns(right_columns);
+    for (size_t i = 0; i < right_columns; ++i)
+    {
+        added_columns[i] = res_block.safeGetByPosition(left_columns + i).column->assumeMutable();
+        added_columns[i]->reserveAlign(settings.max_block_size, FULL_VECTOR_SIZE_AVX2);
+    }
+
+    wd.insert_batch.clear();
+    wd.insert_batch.reserve(settings.probe_insert_batch_size);
+    size_t scan_rows = 0;
+    while (scan_rows < settings.max_block_size)
+    {
+        if (wd.scan_container == nullptr || wd.scan_row_index >= wd.scan_container->size())
+        {
+            wd.scan_container = nullptr;
+            wd.scan_row_index = 0;
+            while (wd.scan_partition_index < partition_count)
+            {
+                wd.scan_container = join->multi_row_containers[wd.scan_partition_index]->getScanNext();
+                if (wd.scan_container != nullptr)
+                    break;
+                ++wd.scan_partition_index;
+            }
+            if (wd.scan_container == nullptr)
+                break;
+        }
+
+        RowContainer & container = *wd.scan_container;
+        size_t container_rows = container.size();
+        if (wd.scan_partition_index < JOIN_BUILD_PARTITION_COUNT)
+        {
+            for (; wd.scan_row_index < container_rows && scan_rows < settings.max_block_size; ++wd.scan_row_index)
+            {
+                RowPtr row_ptr = container.getRowPtr(wd.scan_row_index);
+                if (isRowMatched(row_ptr) != output_matched)
+                    continue;
+                const auto & key = key_getter.deserializeJoinKey(row_ptr + key_offset);
+                insertRowToBatch<false>(
+                    wd,
+                    added_columns,
+                    row_ptr + key_offset + key_getter.getRequiredKeyOffset(key));
+                ++scan_rows;
+            }
+        }
+        else
+        {
+            /// The rows with null join key never match, so all of them are output.
+            /// Their raw required join keys are serialized with null flags so the nullable columns are used directly.
+            flushInsertBatch<false, true>(wd, added_columns);
+            fillNullMapWithZero<false>(added_columns);
+
+            size_t length = std::min(container_rows - wd.scan_row_index, settings.max_block_size - scan_rows);
+            for (size_t i = 0; i < length; ++i)
+                wd.insert_batch.push_back(container.getRowPtr(wd.scan_row_index + i));
+            for (auto [column_index, _] : row_layout.raw_key_column_indexes)
+                added_columns[column_index]->deserializeAndInsertFromPos(wd.insert_batch, false);
+            for (auto [column_index, _] : row_layout.other_column_indexes)
+                added_columns[column_index]->deserializeAndInsertFromPos(wd.insert_batch, false);
+            wd.insert_batch.clear();
+            wd.scan_row_index += length;
+            scan_rows += length;
+        }
+    }
+    flushInsertBatch<false, true>(wd, added_columns);
+    fillNullMapWithZero<false>(added_columns);
+
+    if (scan_rows == 0)
+        return {};
+
+    for (size_t i = 0; i < right_columns; ++i)
+        res_block.safeGetByPosition(left_columns + i).column = std::move(added_columns[i]);
+    for (size_t i = 0; i < left_columns; ++i)
+    {
+        auto column = res_block.safeGetByPosition(i).column->assumeMutable();
+        column->insertManyDefaults(scan_rows);
+        res_block.safeGetByPosition(i).column = std::move(column);
+    }
+    return join->removeUselessColumnForOutput(res_block);
+}
+
 Block JoinProbeHelper::genResultBlockForLeftOuterSemi(JoinProbeContext & ctx)
 {
     RUNTIME_CHECK(join->kind == LeftOuterSemi || join->kind == LeftOuterAnti);
@@ -100,6 +100,13 @@ struct alignas(CPU_CACHE_LINE_SIZE) JoinProbeWorkerData
     /// For late materialization
     RowPtrs row_ptrs_for_lm;
     RowPtrs filter_row_ptrs_for_lm;
+    /// For right outer/semi/anti join with other conditions
+    RowPtrs matched_row_ptrs;
+
+    /// For scanning the build side after probe
+    size_t scan_partition_index = 0;
+    RowContainer * scan_container = nullptr;
+    size_t scan_row_index = 0;
 
     /// Schema: HashJoin::all_sample_block_pruned
     Block result_block;
@@ -113,6 +120,8 @@ struct alignas(CPU_CACHE_LINE_SIZE) JoinProbeWorkerData
     size_t replicate_time = 0;
     size_t other_condition_time = 0;
     size_t collision = 0;
+    size_t scan_after_probe_time = 0;
+    size_t scan_after_probe_rows = 0;
 };
 
 class JoinProbeHelperUtil
@@ -179,10 +188,15 @@ public:
 
     Block probe(JoinProbeContext & ctx, JoinProbeWorkerData & wd);
 
+    Block scanAfterProbe(JoinProbeWorkerData & wd);
+
 private:
     JOIN_PROBE_HELPER_TEMPLATE
     Block probeImpl(JoinProbeContext & ctx, JoinProbeWorkerData & wd);
 
+    template <typename KeyGetter>
+    Block scanAfterProbeImpl(JoinProbeWorkerData & wd);
+
     JOIN_PROBE_HELPER_TEMPLATE
     void NO_INLINE probeFillColumns(JoinProbeContext & ctx, JoinProbeWorkerData & wd, MutableColumns & added_columns);
     JOIN_PROBE_HELPER_TEMPLATE
@@ -206,6 +220,10 @@ private:
     using FuncType = Block (JoinProbeHelper::*)(JoinProbeContext &, JoinProbeWorkerData &);
     FuncType func_ptr_has_null = nullptr;
     FuncType func_ptr_no_null = nullptr;
+    using ScanFuncType = Block (JoinProbeHelper::*)(JoinProbeWorkerData &);
+    ScanFuncType scan_func_ptr = nullptr;
+    /// Only used for deserializing the join keys of build rows when scanning after probe.
+    std::unique_ptr<void, std::function<void(void *)>> scan_key_getter;
     const HashJoin * join;
     const HashJoinPointerTable & pointer_table;
 };
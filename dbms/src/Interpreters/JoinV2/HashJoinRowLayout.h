@@ -18,6 +18,7 @@
 #include <Storages/KVStore/Utils.h>
 #include <common/unaligned.h>
 
+#include <atomic>
 #include <vector>
 
 namespace DB
@@ -28,6 +29,11 @@ namespace DB
 ///    <Next Pointer> <Hash Value> <Other Join Keys> <Raw Required Join Keys> <Other Required Columns>
 /// 2. if not required hash value comparison:
 ///    <Next Pointer> <Other Join Keys> <Raw Required Join Keys> <Other Required Columns>
+/// For right outer/semi/anti join, a match flag is stored in the `match_flag_size` bytes before <Next Pointer>,
+/// so the row pointer still points to <Next Pointer> and the layout above is unchanged.
+/// The rows with null join key are not inserted to the pointer table and their layout is
+///    <Raw Required Join Keys> <Other Required Columns>
+/// where the raw required join keys are serialized with their null flags.
 struct HashJoinRowLayout
 {
     /// The raw join key column are the same as the original data.
@@ -41,12 +47,17 @@ struct HashJoinRowLayout
 
     size_t key_column_fixed_size = 0;
     size_t other_column_fixed_size = 0;
+
+    /// Non-zero if the join needs to know whether a build row has been matched after probe.
+    size_t match_flag_size = 0;
 };
 
 using RowPtr = char *;
 using RowPtrs = PaddedPODArray<RowPtr>;
 
 constexpr size_t ROW_ALIGN = 4;
+/// Keep the row pointer aligned after adding the match flag.
+constexpr size_t ROW_MATCH_FLAG_SIZE = ROW_ALIGN;
 
 constexpr size_t ROW_PTR_TAG_BITS = 16;
 constexpr size_t ROW_PTR_TAG_MASK = (1 << ROW_PTR_TAG_BITS) - 1;
@@ -83,15 +94,32 @@ inline bool containOtherTag(RowPtr ptr, UInt16 other_tag)
     return (tag | other_tag) == tag;
 }
 
+/// The match flag can be set by several probe workers concurrently.
+inline bool isRowMatched(RowPtr ptr)
+{
+    std::atomic_ref<UInt8> flag(*reinterpret_cast<UInt8 *>(ptr - ROW_MATCH_FLAG_SIZE));
+    return flag.load(std::memory_order_relaxed) != 0;
+}
+
+inline void setRowMatched(RowPtr ptr)
+{
+    std::atomic_ref<UInt8> flag(*reinterpret_cast<UInt8 *>(ptr - ROW_MATCH_FLAG_SIZE));
+    /// Avoid writing to the shared cache line again if the row has been matched.
+    if (flag.load(std::memory_order_relaxed) == 0)
+        flag.store(1, std::memory_order_relaxed);
+}
+
 struct RowContainer
 {
     PaddedPODArray<char> data;
     PaddedPODArray<size_t> offsets;
     PaddedPODArray<UInt64> hashes;
+    /// See `HashJoinRowLayout::match_flag_size`.
+    size_t match_flag_size = 0;
 
     size_t size() const { return offsets.size(); }
 
-    RowPtr getRowPtr(ssize_t row) { return &data[offsets[row - 1]]; }
+    RowPtr getRowPtr(ssize_t row) { return &data[offsets[row - 1] + match_flag_size]; }
     UInt64 getHash(ssize_t row) { return hashes[row]; }
 };
 
@@ -126,6 +154,16 @@ struct alignas(CPU_CACHE_LINE_SIZE) MultipleRowContainer
             return nullptr;
         return &column_rows[scan_table_index++];
     }
+
+    /// Take all the row containers out, e.g. to spill them.
+    std::vector<RowContainer> takeAll()
+    {
+        std::unique_lock lock(mu);
+        std::vector<RowContainer> res;
+        res.swap(column_rows);
+        all_row_count = 0;
+        return res;
+    }
 };
 
 } // namespace DB
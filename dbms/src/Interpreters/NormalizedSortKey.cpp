@@ -0,0 +1,477 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Columns/ColumnDecimal.h>
+#include <Columns/ColumnNullable.h>
+#include <Columns/ColumnString.h>
+#include <Columns/ColumnsNumber.h>
+#include <Common/PODArray.h>
+#include <Common/RadixSort.h>
+#include <Common/typeid_cast.h>
+#include <Interpreters/NormalizedSortKey.h>
+#include <TiDB/Collation/Collator.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <functional>
+#include <optional>
+
+namespace DB
+{
+namespace
+{
+/// The normalized key of a row takes at most `MAX_KEY_WORDS` words.
+constexpr size_t MAX_KEY_WORDS = 4;
+constexpr size_t MAX_KEY_BYTES = MAX_KEY_WORDS * sizeof(UInt64);
+/// The max bytes of the sort key of a string kept in the normalized key.
+constexpr size_t MAX_STRING_PREFIX_BYTES = 16;
+/// Radix sort is slower than comparison sort for small arrays, see `RadixSort::execute`.
+constexpr size_t MIN_ROWS_FOR_RADIX_SORT = 256;
+
+struct SortColumn
+{
+    const IColumn * column;
+    const SortColumnDescription * description;
+    bool need_collation;
+};
+using SortColumns = std::vector<SortColumn>;
+
+int compareRows(const SortColumns & columns, size_t a, size_t b)
+{
+    for (const auto & col : columns)
+    {
+        const auto & desc = *col.description;
+        int res = col.need_collation
+            ? col.column->compareAt(a, b, *col.column, desc.nulls_direction, *desc.collator)
+            : col.column->compareAt(a, b, *col.column, desc.nulls_direction);
+        if (res)
+            return res * desc.direction;
+    }
+    return 0;
+}
+
+/// Writes the normalized key of a sort column for `rows` rows, the key of row i starts at `keys + i * stride`.
+using KeyColumnEncoder = std::function<void(UInt8 * keys, size_t stride, size_t rows)>;
+
+struct KeyColumnPlan
+{
+    size_t width = 0;
+    // Whether the order of the column is decided by its key completely.
+    bool complete = true;
+    KeyColumnEncoder encoder;
+};
+
+ALWAYS_INLINE inline void writeBigEndian(UInt8 * pos, UInt64 value, size_t width)
+{
+    for (size_t i = width; i > 0; --i)
+    {
+        pos[i - 1] = static_cast<UInt8>(value);
+        value >>= 8;
+    }
+}
+
+/// Maps the value to an unsigned integer keeping the order.
+template <typename T>
+ALWAYS_INLINE inline UInt64 toOrderedUInt64(T value)
+{
+    if constexpr (IsDecimal<T>)
+        return toOrderedUInt64(value.value);
+    else if constexpr (std::is_signed_v<T>)
+        return static_cast<UInt64>(static_cast<Int64>(value)) ^ (1ULL << 63);
+    else
+        return static_cast<UInt64>(value);
+}
+
+/// The NULLs are encoded as one byte before the value, so that they are ordered as `compareAt` does.
+KeyColumnPlan planNullMap(const NullMap * null_map, const SortColumnDescription & desc)
+{
+    const bool nulls_last = desc.nulls_direction * desc.direction > 0;
+    return KeyColumnPlan{
+        .width = 1,
+        .complete = true,
+        .encoder =
+            [null_map, nulls_last](UInt8 * keys, size_t stride, size_t rows) {
+                const auto & null_data = *null_map;
+                for (size_t i = 0; i < rows; ++i)
+                    keys[i * stride] = static_cast<UInt8>(null_data[i] == nulls_last);
+            },
+    };
+}
+
+/// Integers are encoded as the offset to the minimum value, the NULLs are skipped.
+template <typename T>
+KeyColumnPlan planInteger(const T * data, size_t rows, const NullMap * null_map, int direction)
+{
+    UInt64 min_value = std::numeric_limits<UInt64>::max();
+    UInt64 max_value = 0;
+    for (size_t i = 0; i < rows; ++i)
+    {
+        if (null_map && (*null_map)[i])
+            continue;
+        const auto value = toOrderedUInt64(data[i]);
+        min_value = std::min(min_value, value);
+        max_value = std::max(max_value, value);
+    }
+    if (min_value > max_value)
+        return KeyColumnPlan{.width = 0, .complete = true, .encoder = {}};
+
+    const UInt64 range = max_value - min_value;
+    const size_t width = range == 0 ? 0 : (std::bit_width(range) + 7) / 8;
+    return KeyColumnPlan{
+        .width = width,
+        .complete = true,
+        .encoder =
+            [data, null_map, min_value, range, width, direction](UInt8 * keys, size_t stride, size_t rows) {
+                if (width == 0)
+                    return;
+                for (size_t i = 0; i < rows; ++i)
+                {
+                    if (null_map && (*null_map)[i])
+                        continue;
+                    auto offset = toOrderedUInt64(data[i]) - min_value;
+                    if (direction < 0)
+                        offset = range - offset;
+                    writeBigEndian(keys + i * stride, offset, width);
+                }
+            },
+    };
+}
+
+/// Strings are encoded as a prefix of the sort keys, padded with zeros.
+/// The rows having the same prefix must be compared by the strings again.
+KeyColumnPlan planString(
+    const ColumnString * column,
+    const NullMap * null_map,
+    const TiDB::ITiDBCollator * collator,
+    int direction,
+    size_t width)
+{
+    return KeyColumnPlan{
+        .width = width,
+        .complete = false,
+        .encoder =
+            [column, null_map, collator, direction, width](UInt8 * keys, size_t stride, size_t rows) {
+                std::string container;
+                for (size_t i = 0; i < rows; ++i)
+                {
+                    if (null_map && (*null_map)[i])
+                        continue;
+                    auto * pos = keys + i * stride;
+                    auto value = column->getDataAt(i);
+                    auto sort_key = collator ? collator->sortKeyFastPath(value.data, value.size, container) : value;
+                    memcpy(pos, sort_key.data, std::min(sort_key.size, width));
+                    if (direction < 0)
+                    {
+                        for (size_t j = 0; j < width; ++j)
+                            pos[j] = ~pos[j];
+                    }
+                }
+            },
+    };
+}
+
+std::optional<KeyColumnPlan> planColumn(
+    const IColumn & column,
+    const NullMap * null_map,
+    const SortColumn & sort_column,
+    size_t rows,
+    size_t max_width)
+{
+    const auto & desc = *sort_column.description;
+#define M(TYPE)                                                                    \
+    if (const auto * col = typeid_cast<const ColumnVector<TYPE> *>(&column))       \
+        return planInteger(col->getData().data(), rows, null_map, desc.direction);
+    M(UInt8)
+    M(UInt16)
+    M(UInt32)
+    M(UInt64)
+    M(Int8)
+    M(Int16)
+    M(Int32)
+    M(Int64)
+#undef M
+    if (const auto * col = typeid_cast<const ColumnDecimal<Decimal32> *>(&column))
+        return planInteger(col->getData().data(), rows, null_map, desc.direction);
+    if (const auto * col = typeid_cast<const ColumnDecimal<Decimal64> *>(&column))
+        return planInteger(col->getData().data(), rows, null_map, desc.direction);
+    if (const auto * col = typeid_cast<const ColumnString *>(&column); col && max_width > 0)
+    {
+        const auto * collator = sort_column.need_collation ? desc.collator : nullptr;
+        return planString(col, null_map, collator, desc.direction, std::min(max_width, MAX_STRING_PREFIX_BYTES));
+    }
+    return std::nullopt;
+}
+
+template <size_t N>
+struct KeyElement
+{
+    std::array<UInt64, N> words;
+    UInt64 row;
+};
+
+template <typename KeyType>
+struct RadixKeyElement
+{
+    KeyType key;
+    UInt32 row;
+};
+
+template <typename KeyType>
+struct RadixSortKeyTraits
+{
+    using Element = RadixKeyElement<KeyType>;
+    using Key = KeyType;
+    using CountType = UInt32;
+    using KeyBits = KeyType;
+    static constexpr size_t PART_SIZE_BITS = 8;
+    using Transform = RadixSortIdentityTransform<KeyBits>;
+    using Allocator = RadixSortMallocAllocator;
+
+    static Key & extractKey(Element & elem) { return elem.key; }
+};
+
+/// Sorts the rows having the same key by the sort columns.
+template <typename Element, typename SameKey>
+void breakTies(Element * begin, Element * end, const SortColumns & columns, SameKey && same_key)
+{
+    auto less = [&](const Element & lhs, const Element & rhs) {
+        return compareRows(columns, lhs.row, rhs.row) < 0;
+    };
+    for (auto * run_begin = begin; run_begin != end;)
+    {
+        auto * run_end = run_begin + 1;
+        while (run_end != end && same_key(*run_begin, *run_end))
+            ++run_end;
+        if (run_end - run_begin > 1)
+            std::sort(run_begin, run_end, less);
+        run_begin = run_end;
+    }
+}
+
+template <typename Element, typename Less, typename SameKey>
+void sortElements(
+    PaddedPODArray<Element> & elements,
+    size_t limit,
+    bool complete,
+    const SortColumns & columns,
+    Less && less,
+    SameKey && same_key)
+{
+    auto * begin = elements.data();
+    auto * end = begin + elements.size();
+    if (!limit)
+    {
+        std::sort(begin, end, less);
+        if (!complete)
+            breakTies(begin, end, columns, same_key);
+        return;
+    }
+
+    std::partial_sort(begin, begin + limit, end, less);
+    if (complete)
+        return;
+
+    // The rows having the same key as the last row in the limit may be out of the limit,
+    // collect them together and sort them by the sort columns.
+    const auto boundary = begin[limit - 1];
+    auto * boundary_end
+        = std::partition(begin + limit, end, [&](const Element & elem) { return same_key(elem, boundary); });
+    auto * boundary_begin = begin + limit - 1;
+    while (boundary_begin != begin && same_key(*(boundary_begin - 1), boundary))
+        --boundary_begin;
+    breakTies(begin, boundary_begin, columns, same_key);
+    std::partial_sort(boundary_begin, begin + limit, boundary_end, [&](const Element & lhs, const Element & rhs) {
+        return compareRows(columns, lhs.row, rhs.row) < 0;
+    });
+}
+
+template <typename KeyType>
+void radixSortKeys(
+    const PaddedPODArray<KeyElement<1>> & keys,
+    size_t key_bytes,
+    bool complete,
+    const SortColumns & columns,
+    IColumn::Permutation & perm)
+{
+    // The key is aligned to the high bytes of the word, shift it to use less radix passes.
+    const size_t shift = (sizeof(UInt64) - key_bytes) * 8;
+    PaddedPODArray<RadixKeyElement<KeyType>> elements(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i)
+        elements[i] = {static_cast<KeyType>(keys[i].words[0] >> shift), static_cast<UInt32>(keys[i].row)};
+
+    RadixSort<RadixSortKeyTraits<KeyType>>::execute(elements.data(), elements.size());
+    if (!complete)
+    {
+        breakTies(
+            elements.data(),
+            elements.data() + elements.size(),
+            columns,
+            [](const RadixKeyElement<KeyType> & lhs, const RadixKeyElement<KeyType> & rhs) {
+                return lhs.key == rhs.key;
+            });
+    }
+    for (size_t i = 0; i < elements.size(); ++i)
+        perm[i] = elements[i].row;
+}
+
+template <size_t N>
+void sortByKeys(
+    const std::vector<KeyColumnPlan> & plans,
+    size_t key_bytes,
+    bool complete,
+    const SortColumns & columns,
+    size_t limit,
+    IColumn::Permutation & perm)
+{
+    using Element = KeyElement<N>;
+    const size_t rows = perm.size();
+    PaddedPODArray<Element> elements;
+    elements.resize_fill(rows, Element{});
+
+    auto * keys = reinterpret_cast<UInt8 *>(elements.data());
+    size_t offset = 0;
+    for (const auto & plan : plans)
+    {
+        if (plan.width > 0)
+            plan.encoder(keys + offset, sizeof(Element), rows);
+        offset += plan.width;
+    }
+    // The keys are written in big-endian, so that they can be compared as integers.
+    for (size_t i = 0; i < rows; ++i)
+    {
+        elements[i].row = i;
+        if constexpr (std::endian::native == std::endian::little)
+        {
+            for (auto & word : elements[i].words)
+                word = __builtin_bswap64(word);
+        }
+    }
+
+    if constexpr (N == 1)
+    {
+        if (!limit && rows >= MIN_ROWS_FOR_RADIX_SORT && rows <= std::numeric_limits<UInt32>::max())
+        {
+            if (key_bytes <= sizeof(UInt16))
+                radixSortKeys<UInt16>(elements, key_bytes, complete, columns, perm);
+            else if (key_bytes <= sizeof(UInt32))
+                radixSortKeys<UInt32>(elements, key_bytes, complete, columns, perm);
+            else
+                radixSortKeys<UInt64>(elements, key_bytes, complete, columns, perm);
+            return;
+        }
+    }
+
+    sortElements(
+        elements,
+        limit,
+        complete,
+        columns,
+        [](const Element & lhs, const Element & rhs) { return lhs.words < rhs.words; },
+        [](const Element & lhs, const Element & rhs) { return lhs.words == rhs.words; });
+    for (size_t i = 0; i < rows; ++i)
+        perm[i] = elements[i].row;
+}
+} // namespace
+
+bool sortByNormalizedKeys(
+    const Block & block,
+    const SortDescription & description,
+    size_t limit,
+    IColumn::Permutation & perm)
+{
+    const size_t rows = block.rows();
+    if (rows <= 1)
+        return true;
+
+    SortColumns columns;
+    columns.reserve(description.size());
+    for (const auto & desc : description)
+    {
+        const IColumn * column = !desc.column_name.empty() ? block.getByName(desc.column_name).column.get()
+                                                           : block.safeGetByPosition(desc.column_number).column.get();
+        const IColumn * not_null_column = column->isColumnNullable()
+            ? &static_cast<const ColumnNullable *>(column)->getNestedColumn()
+            : column;
+        const bool need_collation = desc.collator && !not_null_column->isColumnConst()
+            && typeid_cast<const ColumnString *>(not_null_column);
+        columns.push_back(SortColumn{.column = column, .description = &desc, .need_collation = need_collation});
+    }
+
+    std::vector<KeyColumnPlan> plans;
+    size_t key_bytes = 0;
+    bool complete = true;
+    for (const auto & sort_column : columns)
+    {
+        // All the rows are equal in a const column.
+        if (sort_column.column->isColumnConst())
+            continue;
+
+        const IColumn * column = sort_column.column;
+        const NullMap * null_map = nullptr;
+        if (const auto * nullable = typeid_cast<const ColumnNullable *>(column))
+        {
+            column = &nullable->getNestedColumn();
+            null_map = &nullable->getNullMapData();
+        }
+        const size_t null_bytes = null_map ? 1 : 0;
+        const size_t max_width = MAX_KEY_BYTES - std::min(MAX_KEY_BYTES, key_bytes + null_bytes);
+        auto plan = planColumn(*column, null_map, sort_column, rows, max_width);
+        if (!plan || plan->width > max_width)
+        {
+            complete = false;
+            break;
+        }
+
+        if (null_map)
+            plans.push_back(planNullMap(null_map, *sort_column.description));
+        key_bytes += null_bytes + plan->width;
+        plans.push_back(std::move(*plan));
+        // The columns after a column not decided by its key can not be ordered by the keys.
+        if (!plans.back().complete)
+        {
+            complete = false;
+            break;
+        }
+    }
+
+    if (key_bytes == 0)
+    {
+        // All the rows are equal if all the sort columns are normalized.
+        return complete;
+    }
+
+    if (limit >= rows)
+        limit = 0;
+    switch ((key_bytes + sizeof(UInt64) - 1) / sizeof(UInt64))
+    {
+    case 1:
+        sortByKeys<1>(plans, key_bytes, complete, columns, limit, perm);
+        break;
+    case 2:
+        sortByKeys<2>(plans, key_bytes, complete, columns, limit, perm);
+        break;
+    case 3:
+        sortByKeys<3>(plans, key_bytes, complete, columns, limit, perm);
+        break;
+    case 4:
+        sortByKeys<4>(plans, key_bytes, complete, columns, limit, perm);
+        break;
+    default:
+        __builtin_unreachable();
+    }
+    return true;
+}
+
+} // namespace DB
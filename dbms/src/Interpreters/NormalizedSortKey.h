@@ -0,0 +1,44 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Columns/IColumn.h>
+#include <Core/Block.h>
+#include <Core/SortDescription.h>
+
+namespace DB
+{
+/** Sort the rows of a block by normalized keys.
+  *
+  * The leading sort columns of each row are encoded into a fixed-width memcomparable key, respecting the
+  * direction, the nulls direction and the collation of each column:
+  * - Integers and decimals are encoded as the offset to the minimum value of the block, in as few bytes as
+  *   the value range of the block needs.
+  * - Strings are encoded as a prefix of their collation sort keys, and no more columns are encoded after them.
+  * - Nullable columns take one more byte to order the NULLs.
+  *
+  * The keys are sorted by radix sort if they fit into one word, otherwise by comparing the words. Only the
+  * rows having equal keys are compared by the sort columns again if the keys can not decide the order.
+  *
+  * `perm` must be the identity permutation of the block. Returns false and leaves `perm` untouched if the
+  * first sort column can not be normalized. If limit != 0, only the first `limit` rows are sorted.
+  */
+bool sortByNormalizedKeys(
+    const Block & block,
+    const SortDescription & description,
+    size_t limit,
+    IColumn::Permutation & perm);
+
+} // namespace DB
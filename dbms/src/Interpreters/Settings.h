@@ -50,6 +50,7 @@ struct Settings
     M(SettingInt64, dag_records_per_chunk, DEFAULT_DAG_RECORDS_PER_CHUNK, "default chunk size of a DAG response.")                                                                                                                      \
     M(SettingInt64, batch_send_min_limit, DEFAULT_BATCH_SEND_MIN_LIMIT, "default minimal chunk size of exchanging data among TiFlash.")                                                                                                 \
     M(SettingInt64, batch_send_min_limit_compression, -1, "default minimal chunk size of exchanging data among TiFlash when using data compression.")                                                                                   \
+    M(SettingBool, enable_mpp_exchange_adaptive_compression, false, "Choose the compression of each exchange packet by the compression ratio and the send cost of its tunnel.")                                                         \
     M(SettingInt64, schema_version, DEFAULT_UNSPECIFIED_SCHEMA_VERSION, "TiDB query schema version.")                                                                                                                                   \
     M(SettingUInt64, mpp_task_timeout, DEFAULT_MPP_TASK_TIMEOUT, "mpp task max endurable time.")                                                                                                                                        \
     M(SettingUInt64, mpp_task_running_timeout, DEFAULT_MPP_TASK_RUNNING_TIMEOUT, "mpp task max time that running without any progress.")                                                                                                \
@@ -185,9 +186,12 @@ struct Settings
     M(SettingUInt64, dt_merged_file_max_size, 16 * 1024 * 1024, "Small files are merged into one or more files not larger than dt_merged_file_max_size")                                                                                \
     M(SettingDouble, dt_page_gc_threshold, 0.5, "Max valid rate of deciding to do a GC in PageStorage")                                                                                                                                 \
     M(SettingDouble, dt_page_gc_threshold_raft_data, 0.05, "Max valid rate of deciding to do a GC for BlobFile storing PageData in PageStorage")                                                                                        \
+    M(SettingUInt64, dt_page_wal_restore_threads, 4, "The number of threads to read and decode the WAL files when restoring PageStorage. 0 or 1 means restoring in the current thread.")                                                \
     M(SettingInt64, enable_version_chain, 0, "Enable version chain or not: 0 - disable, 1 - enabled. "                                                                                                                                  \
                                              "More details are in the comments of `enum class VersionChainMode`."                                                                                                                       \
                                              "Modifying this configuration requires a restart to reset the in-memory state.")                                                                                                           \
+    M(SettingUInt64, dt_mvcc_bitmap_cache_entries, 4, "Max number of MVCC bitmaps cached in each segment for reusing across queries when version chain is enabled. 0 means disable.")                                                   \
+    M(SettingBool, dt_version_chain_replay_after_flush, true, "Replay the flushed data into version chain by background tasks right after flush, so that queries don't need to replay them.")                                           \
     /* DeltaTree engine testing settings */\
     M(SettingUInt64, dt_insert_max_rows, 0, "[testing] Max rows of insert blocks when write into DeltaTree Engine. By default 0 means no limit.")                                                                                       \
     M(SettingBool, dt_raw_filter_range, true, "[unused] Do range filter or not when read data in raw mode in DeltaTree Engine.")                                                                                                        \
@@ -225,6 +229,9 @@ struct Settings
     M(SettingUInt64, min_compress_block_size, DEFAULT_MIN_COMPRESS_BLOCK_SIZE, "The actual size of the block to compress, if the uncompressed data less than max_compress_block_size is no less than this value "                       \
                                                                                "and no less than the volume of data for one mark.")                                                                                                     \
     M(SettingUInt64, max_compress_block_size, DEFAULT_MAX_COMPRESS_BLOCK_SIZE, "The maximum size of blocks of uncompressed data before compressing for writing to a table.")                                                            \
+    M(SettingBool, dt_enable_ngram_bloom_index, false, "Build the n-gram bloom index of string columns for DTFile, which is used to skip packs by LIKE.")                                                                               \
+    M(SettingBool, dt_enable_equality_bloom_index, false, "Build the equality bloom index for DTFile on the leading columns of the secondary indexes, which is used to skip packs by =, != and IN.")                                    \
+    M(SettingBool, dt_enable_column_statistics, false, "Build the statistics (histogram, NDV and null count) of numeric columns for DTFile, which are used to estimate the cardinality.")                                               \
     \
     /* Storage read thread and data sharing */\
     M(SettingBool, dt_enable_read_thread, true, "Enable storage read thread or not")                                                                                                                                                    \
@@ -252,10 +259,12 @@ struct Settings
     M(SettingDouble, dt_filecache_max_downloading_count_scale, 10.0, "Max queue size of download task count of FileCache = number of logical cpu cores * dt_filecache_max_downloading_count_scale.")                                    \
     M(SettingUInt64, dt_filecache_min_age_seconds, 1800, "Files of the same priority can only be evicted from files that were not accessed within `dt_filecache_min_age_seconds` seconds.")                                             \
     M(SettingUInt64, dt_filecache_wait_on_downloading_ms, 0, "When a remote cache lookup sees the same key is already being downloaded, wait up to this many milliseconds for that download to finish. 0 disables the bounded wait.")   \
+    M(SettingUInt64, dt_filecache_range_block_size, 0, "Cache the data files of DMFile by ranges of this size instead of whole objects, only the ranges being read are downloaded. 0 disables it.")                                     \
     M(SettingBool, dt_enable_fetch_memtableset, true, "Whether fetching delta cache in FetchDisaggPages")                                                                                                                               \
     M(SettingUInt64, dt_fetch_pages_packet_limit_size, 512 * 1024, "Response packet bytes limit of FetchDisaggPages, 0 means one page per packet")                                                                                      \
     M(SettingDouble, dt_fetch_page_concurrency_scale, 4.0, "Concurrency of fetching pages of one query equals to num_streams * dt_fetch_page_concurrency_scale.")                                                                       \
     M(SettingDouble, dt_prepare_stream_concurrency_scale, 2.0, "Concurrency of preparing streams of one query equals to num_streams * dt_prepare_stream_concurrency_scale.")                                                            \
+    M(SettingDouble, dt_prefetch_stable_concurrency_scale, 2.0, "Concurrency of prefetching stable files of one query equals to num_streams * dt_prefetch_stable_concurrency_scale. 0 means disable prefetch.")                         \
     M(SettingBool, dt_enable_delta_index_error_fallback, true, "Whether fallback to an empty delta index if a delta index error is detected")                                                                                           \
     M(SettingDouble, disagg_read_concurrency_scale, 20.0, "Deprecated")                                                                                                                                                                 \
     M(SettingUInt64, disagg_build_task_timeout, DEFAULT_DISAGG_TASK_BUILD_TIMEOUT_SEC, "disagg task establish timeout, unit is second.")                                                                                                \
@@ -279,6 +288,9 @@ struct Settings
     /* Runtime Filter */ \
     M(SettingUInt64, max_rows_in_set, 0, "Maximum size of the set (in number of elements) resulting from the execution of the IN section.")                                                                                             \
     M(SettingUInt64, rf_max_in_value_set, 1024, "Maximum size of the set (in number of elements) resulting from the execution of the RF IN Predicate.")                                                                                 \
+    M(SettingUInt64, rf_max_bloom_filter_bytes, 16777216, "Maximum size (in bytes) of the bloom filter built for the RF BLOOM_FILTER Predicate.")                                                                                       \
+    M(SettingFloat, rf_bloom_filter_false_positive_rate, 0.01, "The expected false positive rate of the bloom filter built for the RF BLOOM_FILTER Predicate.")                                                                         \
+    M(SettingBool, enable_topn_runtime_threshold, true, "Push the threshold of TopN down to the table scan under it to skip the packs and rows that can not enter the result.")                                                         \
     M(SettingUInt64, max_bytes_in_set, 0, "Maximum size of the set (in bytes in memory) resulting from the execution of the IN section.")                                                                                               \
     M(SettingOverflowMode<false>, set_overflow_mode, OverflowMode::THROW, "What to do when the limit is exceeded.")                                                                                                                     \
                                                                                                                                                                                                                                         \
@@ -329,7 +341,9 @@ struct Settings
     M(SettingUInt64, pipeline_io_task_thread_pool_size, 0, "The size of io task thread pool. 0 means using number_of_logical_cpu_cores.")                                                                                               \
     M(SettingTaskQueueType, pipeline_cpu_task_thread_pool_queue_type, TaskQueueType::DEFAULT, "The task queue of cpu task thread pool")                                                                                                 \
     M(SettingTaskQueueType, pipeline_io_task_thread_pool_queue_type, TaskQueueType::DEFAULT, "The task queue of io task thread pool")                                                                                                   \
+    M(SettingBool, pipeline_cpu_task_thread_pool_numa_aware, false, "Split the cpu task thread pool by numa nodes and keep the pipeline tasks on the node they are first scheduled to.")                                                \
     M(SettingUInt64, local_tunnel_version, 2, "1: not refined, 2: refined")                                                                                                                                                             \
+    M(SettingBool, enable_local_tunnel_zero_copy, false, "Pass blocks through local tunnel without serialization. Only works when local_tunnel_version is 2.")                                                                          \
     M(SettingBool, force_push_down_all_filters_to_scan, false, "Push down all filters to scan, only used for test")                                                                                                                     \
     M(SettingUInt64, async_recv_version, 2, "1: reactor mode, 2: no additional threads")                                                                                                                                                \
     M(SettingUInt64, recv_queue_size, 0, "size of ExchangeReceiver queue, 0 means the size is set to data_source_mpp_task_num * 50")                                                                                                    \
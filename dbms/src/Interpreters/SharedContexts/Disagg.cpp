@@ -72,6 +72,7 @@ void SharedContextDisagg::initReadNodePageCache(
         }
 
         PageStorageConfig config;
+        config.wal_restore_threads = global_context.getSettingsRef().dt_page_wal_restore_threads;
         rn_page_cache_storage = UniversalPageStorageService::create( //
             global_context,
             "read_cache",
@@ -17,6 +17,7 @@
 #include <Columns/ColumnNullable.h>
 #include <Columns/ColumnString.h>
 #include <Common/typeid_cast.h>
+#include <Interpreters/NormalizedSortKey.h>
 #include <Interpreters/sortBlock.h>
 #include <TiDB/Collation/Collator.h>
 #include <TiDB/Collation/CollatorUtils.h>
@@ -433,25 +434,30 @@ void sortBlock(Block & block, const SortDescription & description, size_t limit)
         if (limit >= size)
             limit = 0;
 
-        ColumnsWithSortDescriptions columns_with_sort_desc = getColumnsWithSortDescription(block, description);
-        const auto collator_desc = FastSortDesc{columns_with_sort_desc};
-        if (collator_desc.can_use_fast_path)
+        // Sorting by the normalized keys compares a few words instead of the columns for each pair of rows,
+        // fall back to comparing the columns if the first sort column can't be normalized.
+        if (!sortByNormalizedKeys(block, description, limit, perm))
         {
-            assert(collator_desc.fast_path_cnt == max_fast_path_num);
+            ColumnsWithSortDescriptions columns_with_sort_desc = getColumnsWithSortDescription(block, description);
+            const auto collator_desc = FastSortDesc{columns_with_sort_desc};
+            if (collator_desc.can_use_fast_path)
+            {
+                assert(collator_desc.fast_path_cnt == max_fast_path_num);
 
-            FastPathPermutationSort<max_fast_path_num>{}(collator_desc, perm, limit);
+                FastPathPermutationSort<max_fast_path_num>{}(collator_desc, perm, limit);
 
-            // TODO: optimize for other cases
-        }
-        else if (collator_desc.has_collation)
-        {
-            PartialSortingLessWithCollation less_with_collation(collator_desc);
-            PermutationSort(perm, limit, less_with_collation);
-        }
-        else
-        {
-            PartialSortingLess less(columns_with_sort_desc);
-            PermutationSort(perm, limit, less);
+                // TODO: optimize for other cases
+            }
+            else if (collator_desc.has_collation)
+            {
+                PartialSortingLessWithCollation less_with_collation(collator_desc);
+                PermutationSort(perm, limit, less_with_collation);
+            }
+            else
+            {
+                PartialSortingLess less(columns_with_sort_desc);
+                PermutationSort(perm, limit, less);
+            }
         }
 
         for (size_t i = 0; i < block.columns(); ++i)
@@ -88,5 +88,36 @@ try
 }
 CATCH
 
+TEST_F(HashJoinPointerTableTest, TestInitWithIgnoredHighBits)
+try
+{
+    {
+        HashJoinPointerTable t;
+        t.init(HashJoinKeyMethod::OneKey32, 1 << 24, 4, 0, false, true, JOIN_BUILD_PARTITION_BITS);
+        ASSERT_EQ(t.pointer_table_size, 1ULL << 25);
+        ASSERT_EQ(t.pointer_table_size_degree, 25U);
+        ASSERT_EQ(t.pointer_table_size_mask, 0x7fffffcULL);
+        // The high bits do not affect the bucket.
+        ASSERT_EQ(t.getBucketNum(0xfffffffc), t.getBucketNum(0x07fffffc));
+        ASSERT_EQ(t.getBucketNum(0xfffffffc), (1ULL << 25) - 1);
+    }
+    {
+        // Pointer table size can not exceed the number that the usable bits can express.
+        HashJoinPointerTable t;
+        t.init(HashJoinKeyMethod::KeysFixed32, (1 << 26) + 9, 3, 0, false, true, JOIN_BUILD_PARTITION_BITS);
+        ASSERT_EQ(t.pointer_table_size, 1ULL << 19);
+        ASSERT_EQ(t.pointer_table_size_degree, 19U);
+        ASSERT_EQ(t.pointer_table_size_mask, 0x7ffffULL);
+    }
+    {
+        // The pointer table of one key 8/16 always covers all hash values.
+        HashJoinPointerTable t;
+        t.init(HashJoinKeyMethod::OneKey16, 1, 2, 0, false, true, JOIN_BUILD_PARTITION_BITS);
+        ASSERT_EQ(t.pointer_table_size, 1ULL << 16);
+        ASSERT_EQ(t.pointer_table_size_mask, 0xffffULL);
+    }
+}
+CATCH
+
 } // namespace tests
 } // namespace DB
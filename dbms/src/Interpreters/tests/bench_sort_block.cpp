@@ -0,0 +1,147 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Columns/ColumnNullable.h>
+#include <Columns/ColumnString.h>
+#include <Columns/ColumnsNumber.h>
+#include <DataTypes/DataTypeNullable.h>
+#include <DataTypes/DataTypeString.h>
+#include <DataTypes/DataTypesNumber.h>
+#include <Interpreters/NormalizedSortKey.h>
+#include <TiDB/Collation/Collator.h>
+#include <benchmark/benchmark.h>
+
+#include <numeric>
+#include <random>
+
+using namespace DB;
+
+namespace bench
+{
+enum class SortCase
+{
+    Int64x2,
+    NullableInt64x2,
+    StringInt64,
+};
+
+enum class SortVersion
+{
+    // Sort the permutation by comparing the columns row by row, as `sortBlock` did.
+    Compare,
+    Normalized,
+};
+
+std::pair<Block, SortDescription> createBlock(SortCase sort_case, size_t rows)
+{
+    std::mt19937_64 rng(0);
+    auto create_int64 = [&](UInt64 range) {
+        auto column = ColumnInt64::create();
+        for (size_t i = 0; i < rows; ++i)
+            column->insert(static_cast<Int64>(rng() % range));
+        return column;
+    };
+
+    Block block;
+    SortDescription description;
+    switch (sort_case)
+    {
+    case SortCase::Int64x2:
+        block.insert({create_int64(1000), std::make_shared<DataTypeInt64>(), "a"});
+        block.insert({create_int64(1000000), std::make_shared<DataTypeInt64>(), "b"});
+        description.emplace_back("a", 1, 1);
+        description.emplace_back("b", -1, 1);
+        break;
+    case SortCase::NullableInt64x2:
+        for (const auto * name : {"a", "b"})
+        {
+            auto null_map = ColumnUInt8::create();
+            for (size_t i = 0; i < rows; ++i)
+                null_map->insert(static_cast<UInt64>(rng() % 10 == 0));
+            block.insert(
+                {ColumnNullable::create(create_int64(1000), std::move(null_map)),
+                 makeNullable(std::make_shared<DataTypeInt64>()),
+                 name});
+            description.emplace_back(name, 1, -1);
+        }
+        break;
+    case SortCase::StringInt64:
+    {
+        auto column = ColumnString::create();
+        for (size_t i = 0; i < rows; ++i)
+        {
+            auto str = "Name_" + std::to_string(rng() % 10000);
+            column->insertData(str.data(), str.size());
+        }
+        block.insert({std::move(column), std::make_shared<DataTypeString>(), "a"});
+        block.insert({create_int64(1000000), std::make_shared<DataTypeInt64>(), "b"});
+        description.emplace_back(
+            "a",
+            1,
+            1,
+            TiDB::ITiDBCollator::getCollator(TiDB::ITiDBCollator::UTF8MB4_GENERAL_CI));
+        description.emplace_back("b", 1, 1);
+        break;
+    }
+    }
+    return {std::move(block), std::move(description)};
+}
+
+void sortByCompare(const Block & block, const SortDescription & description, IColumn::Permutation & perm)
+{
+    std::vector<std::pair<const IColumn *, const SortColumnDescription *>> columns;
+    for (const auto & desc : description)
+        columns.emplace_back(block.getByName(desc.column_name).column.get(), &desc);
+    std::sort(perm.begin(), perm.end(), [&](size_t lhs, size_t rhs) {
+        for (const auto & [column, desc] : columns)
+        {
+            int res = desc->collator ? column->compareAt(lhs, rhs, *column, desc->nulls_direction, *desc->collator)
+                                     : column->compareAt(lhs, rhs, *column, desc->nulls_direction);
+            if (res)
+                return res * desc->direction < 0;
+        }
+        return false;
+    });
+}
+
+template <typename... Args>
+void sortBlockByKeys(benchmark::State & state, Args &&... args)
+{
+    auto [version, sort_case, rows] = std::make_tuple(std::move(args)...);
+    auto [block, description] = createBlock(sort_case, rows);
+    IColumn::Permutation perm(rows);
+    for (auto _ : state)
+    {
+        std::iota(perm.begin(), perm.end(), 0);
+        if (version == SortVersion::Compare)
+            sortByCompare(block, description, perm);
+        else
+            sortByNormalizedKeys(block, description, 0, perm);
+        benchmark::DoNotOptimize(perm.data());
+    }
+}
+
+BENCHMARK_CAPTURE(sortBlockByKeys, compare_int64x2, SortVersion::Compare, SortCase::Int64x2, 65536);
+BENCHMARK_CAPTURE(sortBlockByKeys, normalized_int64x2, SortVersion::Normalized, SortCase::Int64x2, 65536);
+BENCHMARK_CAPTURE(sortBlockByKeys, compare_nullable_int64x2, SortVersion::Compare, SortCase::NullableInt64x2, 65536);
+BENCHMARK_CAPTURE(
+    sortBlockByKeys,
+    normalized_nullable_int64x2,
+    SortVersion::Normalized,
+    SortCase::NullableInt64x2,
+    65536);
+BENCHMARK_CAPTURE(sortBlockByKeys, compare_string_int64, SortVersion::Compare, SortCase::StringInt64, 65536);
+BENCHMARK_CAPTURE(sortBlockByKeys, normalized_string_int64, SortVersion::Normalized, SortCase::StringInt64, 65536);
+
+} // namespace bench
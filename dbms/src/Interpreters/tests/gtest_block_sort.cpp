@@ -17,6 +17,8 @@
 #include <Interpreters/sortBlock.h>
 #include <TestUtils/FunctionTestUtils.h>
 
+#include <random>
+
 
 namespace DB
 {
@@ -143,5 +145,127 @@ try
 }
 CATCH
 
+TEST_F(BlockSort, NormalizedKeys)
+try
+{
+    // Fixed seed so that a failure can be reproduced.
+    std::mt19937_64 rng(20250101);
+    const size_t rows = 1000;
+    ColumnWithInt64 ints;
+    std::vector<std::optional<Int64>> nullable_ints;
+    std::vector<String> decimals;
+    std::vector<std::optional<String>> strings;
+    ColumnWithUInt64 row_ids;
+    for (size_t i = 0; i < rows; ++i)
+    {
+        // Small ranges to have many equal values.
+        ints.push_back(static_cast<Int64>(rng() % 100) - 50);
+        if (rng() % 5 == 0)
+            nullable_ints.push_back(std::nullopt);
+        else
+            nullable_ints.push_back(static_cast<Int64>(rng() % 1000000) - 500000);
+        decimals.push_back(fmt::format("{}.{:02}", static_cast<Int64>(rng() % 20) - 10, rng() % 100));
+        if (rng() % 5 == 0)
+        {
+            strings.push_back(std::nullopt);
+        }
+        else
+        {
+            String str;
+            for (size_t j = 0, len = rng() % 24; j < len; ++j)
+                str.push_back("aAbB "[rng() % 5]);
+            strings.push_back(str);
+        }
+        row_ids.push_back(i);
+    }
+    const ColumnsWithTypeAndName ori_col
+        = {toVec<Int64>("int", ints),
+           toNullableVec<Int64>("nullable_int", nullable_ints),
+           createColumn<Decimal32>(std::make_tuple(9, 2), decimals, "decimal"),
+           toNullableVec<String>("string", strings),
+           toVec<Float64>("float", std::vector<Float64>(rows, 1.0)),
+           toVec<UInt64>("row_id", row_ids)};
+
+    auto compare_rows = [](const Block & block, const SortDescription & description, size_t lhs, size_t rhs) {
+        for (const auto & desc : description)
+        {
+            const auto & column = *block.getByName(desc.column_name).column;
+            int res = desc.collator ? column.compareAt(lhs, rhs, column, desc.nulls_direction, *desc.collator)
+                                    : column.compareAt(lhs, rhs, column, desc.nulls_direction);
+            if (res)
+                return res * desc.direction;
+        }
+        return 0;
+    };
+
+    const std::vector<std::vector<String>> sort_columns_list{
+        {"int", "nullable_int"},
+        {"nullable_int", "int", "decimal"},
+        {"decimal", "int"},
+        {"string", "int"},
+        {"int", "string", "nullable_int"},
+        {"int", "float", "decimal"},
+        {"float", "int"},
+    };
+    for (const auto & sort_columns : sort_columns_list)
+    {
+        for (int direction : {-1, 1})
+        {
+            for (int nulls_direction : {-1, 1})
+            {
+                for (auto collator_id :
+                     {TiDB::ITiDBCollator::BINARY,
+                      TiDB::ITiDBCollator::UTF8MB4_BIN,
+                      TiDB::ITiDBCollator::UTF8MB4_GENERAL_CI})
+                {
+                    SortDescription description;
+                    for (size_t i = 0; i < sort_columns.size(); ++i)
+                    {
+                        const auto * collator
+                            = sort_columns[i] == "string" ? TiDB::ITiDBCollator::getCollator(collator_id) : nullptr;
+                        // Mix the directions of the sort columns.
+                        description.emplace_back(
+                            sort_columns[i],
+                            i % 2 ? -direction : direction,
+                            nulls_direction,
+                            collator);
+                    }
+
+                    Block full_block(ori_col);
+                    sortBlock(full_block, description, 0);
+                    ASSERT_EQ(full_block.rows(), rows);
+                    for (size_t i = 1; i < rows; ++i)
+                        ASSERT_LE(compare_rows(full_block, description, i - 1, i), 0);
+                    // All the rows are kept.
+                    std::vector<UInt64> sorted_row_ids;
+                    for (size_t i = 0; i < rows; ++i)
+                        sorted_row_ids.push_back(full_block.getByName("row_id").column->getUInt(i));
+                    std::sort(sorted_row_ids.begin(), sorted_row_ids.end());
+                    ASSERT_EQ(sorted_row_ids, row_ids);
+
+                    // The rows in the limit are the same as the first rows of the full sorted block.
+                    for (size_t limit : {1ul, 10ul, 500ul})
+                    {
+                        Block block(ori_col);
+                        sortBlock(block, description, limit);
+                        ASSERT_EQ(block.rows(), limit);
+                        Block merged(ori_col);
+                        for (auto & column : merged)
+                        {
+                            auto mutable_column = column.column->cloneEmpty();
+                            mutable_column->insertRangeFrom(*block.getByName(column.name).column, 0, limit);
+                            mutable_column->insertRangeFrom(*full_block.getByName(column.name).column, 0, limit);
+                            column.column = std::move(mutable_column);
+                        }
+                        for (size_t i = 0; i < limit; ++i)
+                            ASSERT_EQ(compare_rows(merged, description, i, limit + i), 0);
+                    }
+                }
+            }
+        }
+    }
+}
+CATCH
+
 } // namespace tests
 } // namespace DB
@@ -15,6 +15,7 @@
 #include <DataStreams/IBlockInputStream.h>
 #include <Flash/Coprocessor/CoprocessorReader.h>
 #include <Flash/Coprocessor/GenSchemaAndColumn.h>
+#include <Flash/Pipeline/Schedule/Tasks/NotifyFuture.h>
 #include <Operators/CoprocessorReaderSourceOp.h>
 
 namespace DB
@@ -135,7 +136,8 @@ OperatorStatus CoprocessorReaderSourceOp::awaitImpl()
     else
     {
         reader_res.reset();
-        return OperatorStatus::WAITING;
+        setNotifyFuture(coprocessor_reader.get());
+        return OperatorStatus::WAIT_FOR_NOTIFY;
     }
 }
 } // namespace DB
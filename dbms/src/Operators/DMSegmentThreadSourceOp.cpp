@@ -13,9 +13,11 @@
 // limitations under the License.
 
 #include <Common/FailPoint.h>
+#include <Common/typeid_cast.h>
 #include <Interpreters/Context.h>
 #include <Operators/DMSegmentThreadSourceOp.h>
 #include <Storages/DeltaMerge/DMContext.h>
+#include <Storages/DeltaMerge/File/DMFileBlockInputStream.h>
 
 namespace DB
 {
@@ -24,6 +26,22 @@ namespace FailPoints
 extern const char pause_when_reading_from_dt_stream[];
 } // namespace FailPoints
 
+namespace
+{
+void collectDMFileStreams(IBlockInputStream & stream, std::vector<DM::DMFileBlockInputStream *> & dmfile_streams)
+{
+    if (auto * dmfile_stream = typeid_cast<DM::DMFileBlockInputStream *>(&stream); dmfile_stream)
+    {
+        dmfile_streams.push_back(dmfile_stream);
+        return;
+    }
+    stream.forEachChild([&](IBlockInputStream & child) {
+        collectDMFileStreams(child, dmfile_streams);
+        return false;
+    });
+}
+} // namespace
+
 DMSegmentThreadSourceOp::DMSegmentThreadSourceOp(
     PipelineExecutorContext & exec_context_,
     const DM::DMContextPtr & dm_context_,
@@ -103,10 +121,15 @@ OperatorStatus DMSegmentThreadSourceOp::executeIOImpl()
             executor,
             start_ts,
             block_size);
+        collectDMFileStreams(*cur_stream, dmfile_streams);
         LOG_TRACE(log, "Start to read segment, segment={}", cur_segment->simpleInfo());
     }
     FAIL_POINT_PAUSE(FailPoints::pause_when_reading_from_dt_stream);
 
+    // Yield the IO thread while the packs read ahead are in flight, they are polled by `awaitImpl`.
+    if (!isReadAheadReady())
+        return OperatorStatus::WAITING;
+
     Block res = cur_stream->read(filter_ignored, false);
     if (res)
     {
@@ -118,9 +141,22 @@ OperatorStatus DMSegmentThreadSourceOp::executeIOImpl()
         after_segment_read(dm_context, cur_segment);
         LOG_TRACE(log, "Finish reading segment, segment={}", cur_segment->simpleInfo());
         cur_segment = {};
+        dmfile_streams.clear();
         cur_stream = {};
         return OperatorStatus::IO_IN;
     }
 }
 
+OperatorStatus DMSegmentThreadSourceOp::awaitImpl()
+{
+    return isReadAheadReady() ? OperatorStatus::IO_IN : OperatorStatus::WAITING;
+}
+
+bool DMSegmentThreadSourceOp::isReadAheadReady() const
+{
+    return std::all_of(dmfile_streams.cbegin(), dmfile_streams.cend(), [](const auto * stream) {
+        return stream->pollReadAhead();
+    });
+}
+
 } // namespace DB
@@ -21,6 +21,10 @@
 
 namespace DB
 {
+namespace DM
+{
+class DMFileBlockInputStream;
+} // namespace DM
 
 class DMSegmentThreadSourceOp : public SourceOp
 {
@@ -51,6 +55,12 @@ protected:
 
     OperatorStatus executeIOImpl() override;
 
+    OperatorStatus awaitImpl() override;
+
+private:
+    // Whether the packs read ahead by the DMFiles of `cur_stream` are ready.
+    bool isReadAheadReady() const;
+
 private:
     DM::DMContextPtr dm_context;
     DM::SegmentReadTaskPoolPtr task_pool;
@@ -64,6 +74,8 @@ private:
     bool done = false;
 
     BlockInputStreamPtr cur_stream;
+    // The DMFile streams in `cur_stream`
+    std::vector<DM::DMFileBlockInputStream *> dmfile_streams;
 
     DM::SegmentPtr cur_segment;
 
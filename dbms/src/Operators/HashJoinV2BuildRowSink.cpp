@@ -21,11 +21,34 @@ OperatorStatus HashJoinV2BuildRowSink::writeImpl(Block && block)
     if unlikely (!block)
     {
         is_finish_status = true;
+        /// The remaining rows of spilled partitions must be spilled before finishing build row.
+        join_ptr->markRemainingBuildSideSpillData(op_index);
+        if (join_ptr->hasBuildSideMarkedSpillData(op_index))
+            return OperatorStatus::IO_OUT;
         join_ptr->finishOneBuildRow(op_index);
         return OperatorStatus::FINISHED;
     }
     join_ptr->buildRowFromBlock(block, op_index);
     block.clear();
+    return join_ptr->hasBuildSideMarkedSpillData(op_index) ? OperatorStatus::IO_OUT : OperatorStatus::NEED_INPUT;
+}
+
+OperatorStatus HashJoinV2BuildRowSink::prepareImpl()
+{
+    if (is_finish_status)
+    {
+        /// Finish build row in the cpu thread, it may allocate the pointer table.
+        join_ptr->finishOneBuildRow(op_index);
+        return OperatorStatus::FINISHED;
+    }
+    join_ptr->checkAndMarkPartitionSpilledIfNeeded(op_index);
+    return join_ptr->hasBuildSideMarkedSpillData(op_index) ? OperatorStatus::IO_OUT : OperatorStatus::NEED_INPUT;
+}
+
+OperatorStatus HashJoinV2BuildRowSink::executeIOImpl()
+{
+    join_ptr->flushBuildSideMarkedSpillData(op_index);
+    /// If finishing, `prepareImpl` will finish build row.
     return OperatorStatus::NEED_INPUT;
 }
 
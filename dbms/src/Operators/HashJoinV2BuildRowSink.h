@@ -37,6 +37,10 @@ public:
 protected:
     OperatorStatus writeImpl(Block && block) override;
 
+    OperatorStatus prepareImpl() override;
+
+    OperatorStatus executeIOImpl() override;
+
 private:
     HashJoinPtr join_ptr;
     size_t op_index;
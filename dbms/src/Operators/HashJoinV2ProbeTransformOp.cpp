@@ -16,6 +16,8 @@
 #include <Operators/HashJoinV2ProbeTransformOp.h>
 #include <Operators/Operator.h>
 
+#include <magic_enum.hpp>
+
 namespace DB
 {
 
@@ -50,40 +52,173 @@ void HashJoinV2ProbeTransformOp::operateSuffixImpl()
 
 OperatorStatus HashJoinV2ProbeTransformOp::onOutput(Block & block)
 {
-    assert(!probe_context.isAllFinished());
-    block = join_ptr->probeBlock(probe_context, op_index);
-    size_t rows = block.rows();
-    joined_rows += rows;
-    return OperatorStatus::HAS_OUTPUT;
+    while (true)
+    {
+        switch (status)
+        {
+        case ProbeStatus::PROBE:
+            if (probe_context.isAllFinished())
+                return OperatorStatus::NEED_INPUT;
+            block = join_ptr->probeBlock(probe_context, op_index);
+            joined_rows += block.rows();
+            return OperatorStatus::HAS_OUTPUT;
+        case ProbeStatus::PROBE_FINAL_SPILL:
+            return OperatorStatus::IO_OUT;
+        case ProbeStatus::WAIT_PROBE_FINISH:
+            if (!join_ptr->isAllProbeFinished())
+                return OperatorStatus::WAIT_FOR_NOTIFY;
+            status = join_ptr->needScanAfterProbe() ? ProbeStatus::SCAN_AFTER_PROBE : ProbeStatus::GET_RESTORE_JOIN;
+            break;
+        case ProbeStatus::SCAN_AFTER_PROBE:
+            block = join_ptr->scanAfterProbe(op_index);
+            if unlikely (!block)
+            {
+                status = ProbeStatus::GET_RESTORE_JOIN;
+                break;
+            }
+            scan_hash_map_rows += block.rows();
+            return OperatorStatus::HAS_OUTPUT;
+        case ProbeStatus::GET_RESTORE_JOIN:
+            restore_info = join_ptr->getOneRestoreInfo();
+            if (!restore_info)
+            {
+                status = ProbeStatus::FINISHED;
+                break;
+            }
+            restore_probe_context = JoinProbeContext();
+            status = ProbeStatus::RESTORE_BUILD;
+            return OperatorStatus::IO_IN;
+        case ProbeStatus::RESTORE_BUILD:
+        {
+            if (!restored_block)
+                return OperatorStatus::IO_IN;
+            Block build_block = std::move(*restored_block);
+            restored_block.reset();
+            const auto & restore_join = restore_info->join;
+            if (build_block)
+            {
+                restore_join->buildRowFromSpilledBlock(build_block, 0);
+                return OperatorStatus::IO_IN;
+            }
+            restore_join->finishOneBuildRow(0);
+            status = ProbeStatus::RESTORE_BUILD_POINTER_TABLE;
+            break;
+        }
+        case ProbeStatus::RESTORE_BUILD_POINTER_TABLE:
+            /// The restore join has only one build worker, so the whole pointer table is built by this operator.
+            /// Like `HashJoinV2BuildPointerTableTask`, it is built chunk by chunk, and an empty block is returned
+            /// between chunks to give up the cpu.
+            if (!restore_info->join->buildPointerTable(0))
+            {
+                block = join_ptr->getOutputBlock().cloneEmpty();
+                return OperatorStatus::HAS_OUTPUT;
+            }
+            status = ProbeStatus::RESTORE_PROBE;
+            return OperatorStatus::IO_IN;
+        case ProbeStatus::RESTORE_PROBE:
+        {
+            const auto & restore_join = restore_info->join;
+            if (!restore_probe_context.isAllFinished())
+            {
+                block = restore_join->probeBlock(restore_probe_context, 0);
+                joined_rows += block.rows();
+                return OperatorStatus::HAS_OUTPUT;
+            }
+            if (!restored_block)
+                return OperatorStatus::IO_IN;
+            Block probe_block = std::move(*restored_block);
+            restored_block.reset();
+            if (probe_block)
+            {
+                if (probe_block.rows() > 0)
+                    restore_probe_context.resetBlock(probe_block);
+                break;
+            }
+            restore_probe_context.input_is_finished = true;
+            restore_join->finishOneProbe(0);
+            status = restore_join->needScanAfterProbe() ? ProbeStatus::RESTORE_SCAN_AFTER_PROBE
+                                                        : ProbeStatus::GET_RESTORE_JOIN;
+            block = restore_join->probeLastResultBlock(0);
+            if (block)
+                return OperatorStatus::HAS_OUTPUT;
+            break;
+        }
+        case ProbeStatus::RESTORE_SCAN_AFTER_PROBE:
+            block = restore_info->join->scanAfterProbe(0);
+            if unlikely (!block)
+            {
+                status = ProbeStatus::GET_RESTORE_JOIN;
+                break;
+            }
+            scan_hash_map_rows += block.rows();
+            return OperatorStatus::HAS_OUTPUT;
+        case ProbeStatus::FINISHED:
+            block = {};
+            return OperatorStatus::HAS_OUTPUT;
+        }
+    }
 }
 
 OperatorStatus HashJoinV2ProbeTransformOp::transformImpl(Block & block)
 {
+    assert(status == ProbeStatus::PROBE);
     assert(probe_context.isAllFinished());
     if unlikely (!block)
     {
-        join_ptr->finishOneProbe(op_index);
         probe_context.input_is_finished = true;
+        if (join_ptr->finishOneProbe(op_index) && join_ptr->hasProbeSideMarkedSpillData(op_index))
+            status = ProbeStatus::PROBE_FINAL_SPILL;
+        else if (join_ptr->needScanAfterProbe() || join_ptr->isSpilled())
+            status = ProbeStatus::WAIT_PROBE_FINISH;
+        else
+            status = ProbeStatus::FINISHED;
         block = join_ptr->probeLastResultBlock(op_index);
-        return OperatorStatus::HAS_OUTPUT;
+        if (block)
+            return OperatorStatus::HAS_OUTPUT;
+        return onOutput(block);
     }
     if (block.rows() == 0)
         return OperatorStatus::NEED_INPUT;
+    if (join_ptr->isSpilled())
+    {
+        /// The rows of spilled partitions will be probed after restoring.
+        block = join_ptr->dispatchProbeBlock(block, op_index);
+        if (block.rows() > 0)
+            probe_context.resetBlock(block);
+        if (join_ptr->hasProbeSideMarkedSpillData(op_index))
+            return OperatorStatus::IO_OUT;
+        return onOutput(block);
+    }
     probe_context.resetBlock(block);
     return onOutput(block);
 }
 
 OperatorStatus HashJoinV2ProbeTransformOp::tryOutputImpl(Block & block)
 {
-    if unlikely (probe_context.input_is_finished)
+    return onOutput(block);
+}
+
+OperatorStatus HashJoinV2ProbeTransformOp::executeIOImpl()
+{
+    switch (status)
     {
-        block = {};
+    case ProbeStatus::PROBE:
+        join_ptr->flushProbeSideMarkedSpillData(op_index);
+        return OperatorStatus::NEED_INPUT;
+    case ProbeStatus::PROBE_FINAL_SPILL:
+        join_ptr->flushProbeSideMarkedSpillData(op_index);
+        join_ptr->finalizeProbe();
+        status = ProbeStatus::WAIT_PROBE_FINISH;
+        return OperatorStatus::HAS_OUTPUT;
+    case ProbeStatus::RESTORE_BUILD:
+        restored_block = restore_info->build_stream->read();
         return OperatorStatus::HAS_OUTPUT;
+    case ProbeStatus::RESTORE_PROBE:
+        restored_block = restore_info->probe_stream->read();
+        return OperatorStatus::HAS_OUTPUT;
+    default:
+        throw Exception(fmt::format("Unexpected status: {}", magic_enum::enum_name(status)));
     }
-    if (probe_context.isAllFinished())
-        return OperatorStatus::NEED_INPUT;
-    return onOutput(block);
 }
 
-
 } // namespace DB
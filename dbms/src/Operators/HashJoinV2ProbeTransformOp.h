@@ -36,6 +36,8 @@ protected:
 
     OperatorStatus tryOutputImpl(Block & block) override;
 
+    OperatorStatus executeIOImpl() override;
+
     void transformHeaderImpl(Block & header_) override;
 
     void operateSuffixImpl() override;
@@ -43,13 +45,51 @@ protected:
 private:
     OperatorStatus onOutput(Block & block);
 
+    /*
+     *   PROBE ───────► PROBE_FINAL_SPILL
+     *     │                  │
+     *     │                  ▼
+     *     ├───────► WAIT_PROBE_FINISH ──────► SCAN_AFTER_PROBE
+     *     │                  │                       │
+     *     │                  ▼                       │
+     *     │         GET_RESTORE_JOIN ◄───────────────┘
+     *     │           │  ▲        │
+     *     │           │  │        ▼
+     *     │           │  │   RESTORE_BUILD ──► RESTORE_PROBE ──► RESTORE_SCAN_AFTER_PROBE
+     *     │           │  │                           │                      │
+     *     │           │  └───────────────────────────┴──────────────────────┘
+     *     │           ▼
+     *     └──────► FINISHED
+     */
+    enum class ProbeStatus
+    {
+        PROBE, /// probe data
+        PROBE_FINAL_SPILL, /// the last probe worker spills the remaining probe data of spilled partitions
+        WAIT_PROBE_FINISH, /// wait all probe workers finish
+        SCAN_AFTER_PROBE, /// output the build rows by scanning after probe
+        GET_RESTORE_JOIN, /// get one spilled partition to restore
+        RESTORE_BUILD, /// build the restore join with the spilled build data
+        RESTORE_BUILD_POINTER_TABLE, /// build the pointer table of the restore join
+        RESTORE_PROBE, /// probe the restore join with the spilled probe data
+        RESTORE_SCAN_AFTER_PROBE, /// output the build rows of the restore join by scanning after probe
+        FINISHED, /// the final state
+    };
+
 private:
     HashJoinPtr join_ptr;
     size_t op_index;
 
     JoinProbeContext probe_context;
 
+    /// For restoring the spilled partitions.
+    std::optional<HashJoinRestoreInfo> restore_info;
+    JoinProbeContext restore_probe_context;
+    /// The block read from the restore streams in `executeIO`, empty block means the end of the stream.
+    std::optional<Block> restored_block;
+
     size_t joined_rows = 0;
     size_t scan_hash_map_rows = 0;
+
+    ProbeStatus status{ProbeStatus::PROBE};
 };
 } // namespace DB
@@ -0,0 +1,169 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <DataStreams/SortHelper.h>
+#include <DataStreams/TopNThreshold.h>
+#include <Operators/TopNTransformOp.h>
+
+#include <algorithm>
+
+namespace DB
+{
+void TopNTransformOp::operatePrefixImpl()
+{
+    header_without_constants = getHeader();
+    SortHelper::removeConstantsFromBlock(header_without_constants);
+    SortHelper::removeConstantsFromSortDescription(header, order_desc);
+    // For order by constants, generate LimitOperator instead of TopNOperator.
+    assert(!order_desc.empty());
+
+    // The first sort column may be removed as a constant column.
+    publish_threshold = threshold && threshold->getColumnName() == order_desc[0].column_name;
+}
+
+OperatorStatus TopNTransformOp::transformImpl(Block & block)
+{
+    if unlikely (!block)
+    {
+        prepareOutput();
+        block = getOutput();
+        return OperatorStatus::HAS_OUTPUT;
+    }
+
+    SortHelper::removeConstantsFromBlock(block);
+    RUNTIME_CHECK_MSG(
+        block.columns() == header_without_constants.columns(),
+        "Unexpected number of constant columns in block in TopNTransformOp, n_block={}, n_head={}",
+        block.columns(),
+        header_without_constants.columns());
+    if (limit > 0 && block.rows() > 0)
+        consume(std::move(block));
+    block = {};
+    return OperatorStatus::NEED_INPUT;
+}
+
+OperatorStatus TopNTransformOp::tryOutputImpl(Block & block)
+{
+    if (!is_output)
+        return OperatorStatus::NEED_INPUT;
+    block = getOutput();
+    return OperatorStatus::HAS_OUTPUT;
+}
+
+void TopNTransformOp::consume(Block && block)
+{
+    auto cursor = std::make_unique<SortCursorImpl>(block, order_desc, next_cursor_order++);
+    const size_t rows = block.rows();
+    size_t kept_rows = 0;
+    for (size_t i = 0; i < rows; ++i)
+    {
+        RowRef ref{cursor.get(), i};
+        if (heap.size() < limit)
+        {
+            heap.push_back(ref);
+            std::push_heap(heap.begin(), heap.end(), less);
+            ++kept_rows;
+        }
+        else if (less(ref, heap.front()))
+        {
+            // Replace the last row kept.
+            std::pop_heap(heap.begin(), heap.end(), less);
+            heap.back() = ref;
+            std::push_heap(heap.begin(), heap.end(), less);
+            ++kept_rows;
+        }
+    }
+    // No row of this block can enter the result.
+    if (kept_rows == 0)
+        return;
+
+    rows_in_blocks += rows;
+    blocks.push_back(std::move(block));
+    cursors.push_back(std::move(cursor));
+    if (blocks.size() > 1 && rows_in_blocks > 2 * std::max(limit, max_block_size))
+        compact();
+    publishThreshold();
+}
+
+void TopNTransformOp::compact()
+{
+    // Gather the rows kept into one block, the i-th row of the heap becomes the i-th row of the new block,
+    // so the heap is still valid.
+    auto columns = header_without_constants.cloneEmptyColumns();
+    for (auto & column : columns)
+        column->reserve(heap.size());
+    for (const auto & ref : heap)
+    {
+        for (size_t i = 0; i < columns.size(); ++i)
+            columns[i]->insertFrom(*ref.cursor->all_columns[i], ref.row);
+    }
+    Block block = header_without_constants.cloneWithColumns(std::move(columns));
+
+    blocks.clear();
+    cursors.clear();
+    auto cursor = std::make_unique<SortCursorImpl>(block, order_desc, next_cursor_order++);
+    for (size_t i = 0; i < heap.size(); ++i)
+        heap[i] = RowRef{cursor.get(), i};
+    rows_in_blocks = block.rows();
+    blocks.push_back(std::move(block));
+    cursors.push_back(std::move(cursor));
+}
+
+void TopNTransformOp::publishThreshold()
+{
+    if (!publish_threshold || heap.size() < limit)
+        return;
+    // Any row ordered after the last row kept by the first sort column can not enter the result.
+    const auto & last = heap.front();
+    Field value;
+    last.cursor->sort_columns[0]->get(last.row, value);
+    threshold->update(value);
+}
+
+void TopNTransformOp::prepareOutput()
+{
+    std::sort_heap(heap.begin(), heap.end(), less);
+    is_output = true;
+    output_pos = 0;
+}
+
+Block TopNTransformOp::getOutput()
+{
+    assert(is_output);
+    if (output_pos >= heap.size())
+    {
+        heap.clear();
+        cursors.clear();
+        blocks.clear();
+        return {};
+    }
+
+    const size_t output_rows = std::min(max_block_size, heap.size() - output_pos);
+    auto columns = header_without_constants.cloneEmptyColumns();
+    for (auto & column : columns)
+        column->reserve(output_rows);
+    for (size_t pos = output_pos; pos < output_pos + output_rows; ++pos)
+    {
+        const auto & ref = heap[pos];
+        for (size_t i = 0; i < columns.size(); ++i)
+            columns[i]->insertFrom(*ref.cursor->all_columns[i], ref.row);
+    }
+    output_pos += output_rows;
+
+    Block block = header_without_constants.cloneWithColumns(std::move(columns));
+    SortHelper::enrichBlockWithConstants(block, header);
+    return block;
+}
+
+} // namespace DB
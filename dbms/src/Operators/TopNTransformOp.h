@@ -0,0 +1,106 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Core/SortCursor.h>
+#include <Core/SortDescription.h>
+#include <DataStreams/TopNThreshold_fwd.h>
+#include <Operators/Operator.h>
+
+#include <memory>
+#include <vector>
+
+namespace DB
+{
+/// Keep the first `limit` rows of all the input blocks in a bounded heap, and output them in order after
+/// all the input blocks are consumed.
+///
+/// Unlike the partial sort followed by the merge sort, the input blocks are not sorted. Once the heap is full,
+/// each row is only compared with the last row kept, and the blocks having no row before it are dropped at once.
+/// The rows kept are compacted into one block when the blocks referenced by the heap become much larger than
+/// `limit`, so the memory used is bounded by the limit instead of the input.
+///
+/// If `threshold` is set, the value of the first sort column of the last row kept is published to it whenever
+/// the heap is full, so that the table scan under the TopN can skip the rows that can not enter the result.
+class TopNTransformOp : public TransformOp
+{
+public:
+    TopNTransformOp(
+        PipelineExecutorContext & exec_context_,
+        const String & req_id_,
+        const SortDescription & order_desc_,
+        size_t limit_,
+        size_t max_block_size_,
+        const TopNThresholdPtr & threshold_)
+        : TransformOp(exec_context_, req_id_)
+        , order_desc(order_desc_)
+        , limit(limit_)
+        , max_block_size(max_block_size_)
+        , threshold(threshold_)
+    {}
+
+    String getName() const override { return "TopNTransformOp"; }
+
+protected:
+    void operatePrefixImpl() override;
+
+    OperatorStatus transformImpl(Block & block) override;
+    OperatorStatus tryOutputImpl(Block & block) override;
+
+    void transformHeaderImpl(Block &) override {}
+
+private:
+    struct RowRef
+    {
+        SortCursorImpl * cursor;
+        size_t row;
+    };
+
+    // Whether `lhs` is ordered before `rhs`, the rows of the earlier blocks come first if they are equal.
+    static bool less(const RowRef & lhs, const RowRef & rhs)
+    {
+        return SortCursorWithCollation(rhs.cursor).greaterAt(SortCursorWithCollation(lhs.cursor), rhs.row, lhs.row);
+    }
+
+    void consume(Block && block);
+    void compact();
+    void publishThreshold();
+    void prepareOutput();
+    Block getOutput();
+
+private:
+    SortDescription order_desc;
+    const size_t limit;
+    const size_t max_block_size;
+    TopNThresholdPtr threshold;
+    // Whether the first sort column is the column the threshold is built for.
+    bool publish_threshold = false;
+
+    /// Before operation, will remove constant columns from blocks. And after, place constant columns back.
+    Block header_without_constants;
+
+    // The blocks having rows in the heap, and the cursors comparing their rows.
+    Blocks blocks;
+    std::vector<std::unique_ptr<SortCursorImpl>> cursors;
+    size_t rows_in_blocks = 0;
+    size_t next_cursor_order = 0;
+    // A max heap ordered by `less`, the top is the last row kept.
+    std::vector<RowRef> heap;
+
+    bool is_output = false;
+    size_t output_pos = 0;
+};
+
+} // namespace DB
@@ -13,9 +13,11 @@
 // limitations under the License.
 
 #include <DataStreams/AddExtraTableIDColumnTransformAction.h>
+#include <DataStreams/TopNThreshold.h>
 #include <Flash/Pipeline/Schedule/TaskScheduler.h>
 #include <Flash/Pipeline/Schedule/Tasks/Impls/RFWaitTask.h>
 #include <Operators/UnorderedSourceOp.h>
+#include <Storages/DeltaMerge/ScanContext.h>
 
 namespace DB
 {
@@ -27,12 +29,16 @@ UnorderedSourceOp::UnorderedSourceOp(
     const String & req_id,
     const RuntimeFilterList & runtime_filter_list_,
     int max_wait_time_ms_,
-    bool is_disagg_)
+    bool is_disagg_,
+    const DM::ScanContextPtr & scan_context_)
     : SourceOp(exec_context_, req_id)
     , task_pool(task_pool_)
     , ref_no(0)
     , waiting_rf_list(runtime_filter_list_)
+    , row_filter_rf_list(RuntimeFilterMgr::getRowFilterList(runtime_filter_list_))
     , max_wait_time_ms(max_wait_time_ms_)
+    , topn_threshold(task_pool->getTopNThreshold())
+    , scan_context(scan_context_)
 {
     setHeader(AddExtraTableIDColumnTransformAction::buildHeader(columns_to_read_, extra_table_id_index_));
     ref_no = task_pool->increaseUnorderedInputStreamRefCount();
@@ -64,6 +70,13 @@ OperatorStatus UnorderedSourceOp::readImpl(Block & block)
 
         if (block)
         {
+            RuntimeFilterMgr::applyRowFilters(row_filter_rf_list, block);
+            if (topn_threshold)
+            {
+                const auto filtered_rows = topn_threshold->filterBlock(block);
+                if (scan_context)
+                    scan_context->topn_threshold_filtered_rows += filtered_rows;
+            }
             if unlikely (block.rows() == 0)
             {
                 block.clear();
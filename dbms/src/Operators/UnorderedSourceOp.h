@@ -18,6 +18,7 @@
 #include <Flash/Coprocessor/RuntimeFilterMgr.h>
 #include <Operators/Operator.h>
 #include <Storages/DeltaMerge/ReadThread/SegmentReadTaskScheduler.h>
+#include <Storages/DeltaMerge/ScanContext_fwd.h>
 #include <Storages/DeltaMerge/SegmentReadTaskPool.h>
 
 namespace DB
@@ -35,7 +36,8 @@ public:
         const String & req_id,
         const RuntimeFilterList & runtime_filter_list_ = std::vector<RuntimeFilterPtr>{},
         int max_wait_time_ms_ = 0,
-        bool is_disagg_ = false);
+        bool is_disagg_ = false,
+        const DM::ScanContextPtr & scan_context_ = nullptr);
 
     ~UnorderedSourceOp() override
     {
@@ -60,6 +62,7 @@ public:
     void setRuntimeFilterInfo(const RuntimeFilterList & runtime_filter_list_, int max_wait_time_ms_)
     {
         waiting_rf_list = runtime_filter_list_;
+        row_filter_rf_list = RuntimeFilterMgr::getRowFilterList(runtime_filter_list_);
         max_wait_time_ms = max_wait_time_ms_;
     }
 
@@ -75,7 +78,13 @@ private:
 
     // runtime filter
     RuntimeFilterList waiting_rf_list;
+    // the rfs which are applied on the rows read from the storage, such as bloom filter
+    RuntimeFilterList row_filter_rf_list;
     int max_wait_time_ms;
+    // the threshold of the TopN above, the rows ordered after it are removed
+    TopNThresholdPtr topn_threshold;
+    // record the rows removed by `topn_threshold`, may be nullptr
+    DM::ScanContextPtr scan_context;
 
     bool done = false;
     IOProfileInfoPtr io_profile_info;
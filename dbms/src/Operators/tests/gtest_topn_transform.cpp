@@ -0,0 +1,241 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Core/ColumnWithTypeAndName.h>
+#include <DataStreams/TopNThreshold.h>
+#include <DataTypes/DataTypeNullable.h>
+#include <DataTypes/DataTypesNumber.h>
+#include <Flash/Coprocessor/DAGCodec.h>
+#include <Flash/Executor/PipelineExecutorContext.h>
+#include <IO/Buffer/WriteBufferFromString.h>
+#include <Interpreters/sortBlock.h>
+#include <Operators/TopNTransformOp.h>
+#include <Storages/DeltaMerge/Filter/RSOperator.h>
+#include <TestUtils/FunctionTestUtils.h>
+#include <TestUtils/TiFlashTestBasic.h>
+#include <TiDB/Schema/TiDB.h>
+#include <gtest/gtest.h>
+
+#include <random>
+
+namespace DB::tests
+{
+namespace
+{
+tipb::Expr buildColumnRef(Int64 column_index)
+{
+    tipb::Expr col_ref;
+    col_ref.set_tp(tipb::ExprType::ColumnRef);
+    WriteBufferFromOwnString ss;
+    encodeDAGInt64(column_index, ss);
+    col_ref.set_val(ss.releaseStr());
+    auto * field_type = col_ref.mutable_field_type();
+    field_type->set_tp(TiDB::TypeLongLong);
+    field_type->set_flag(0); // Nullable
+    return col_ref;
+}
+
+Blocks generateBlocks(size_t block_num, size_t rows_per_block, UInt64 seed)
+{
+    std::mt19937_64 rng(seed);
+    Blocks blocks;
+    for (size_t i = 0; i < block_num; ++i)
+    {
+        InferredDataVector<Nullable<Int64>> a;
+        InferredDataVector<Int64> b;
+        for (size_t j = 0; j < rows_per_block; ++j)
+        {
+            if (rng() % 10 == 0)
+                a.push_back({});
+            else
+                a.push_back(static_cast<Int64>(rng() % 50));
+            b.push_back(static_cast<Int64>(rng() % 20));
+        }
+        blocks.push_back(Block{
+            createColumn<Nullable<Int64>>(a, "a"),
+            createColumn<Int64>(b, "b"),
+            createConstColumn<Int64>(rows_per_block, 7, "k")});
+    }
+    return blocks;
+}
+
+Block runTopN(
+    const Blocks & blocks,
+    const SortDescription & desc,
+    size_t limit,
+    size_t max_block_size,
+    const TopNThresholdPtr & threshold)
+{
+    PipelineExecutorContext exec_context;
+    TopNTransformOp op(exec_context, "test", desc, limit, max_block_size, threshold);
+    Block header = blocks[0].cloneEmpty();
+    op.transformHeader(header);
+    op.operatePrefix();
+    for (const auto & block : blocks)
+    {
+        Block input = block;
+        EXPECT_EQ(op.transform(input), OperatorStatus::NEED_INPUT);
+    }
+
+    Blocks outputs;
+    Block output;
+    EXPECT_EQ(op.transform(output), OperatorStatus::HAS_OUTPUT);
+    while (output)
+    {
+        EXPECT_LE(output.rows(), max_block_size);
+        outputs.push_back(std::move(output));
+        output = {};
+        EXPECT_EQ(op.tryOutput(output), OperatorStatus::HAS_OUTPUT);
+    }
+    op.operateSuffix();
+
+    if (outputs.empty())
+        return header.cloneEmpty();
+    MutableColumns columns = outputs[0].cloneEmptyColumns();
+    for (const auto & block : outputs)
+    {
+        for (size_t i = 0; i < columns.size(); ++i)
+            columns[i]->insertRangeFrom(*block.getByPosition(i).column, 0, block.rows());
+    }
+    return outputs[0].cloneWithColumns(std::move(columns));
+}
+
+Block sortAll(const Blocks & blocks, const SortDescription & desc)
+{
+    MutableColumns columns{
+        blocks[0].getByName("a").column->cloneEmpty(),
+        blocks[0].getByName("b").column->cloneEmpty(),
+    };
+    for (const auto & block : blocks)
+    {
+        columns[0]->insertRangeFrom(*block.getByName("a").column, 0, block.rows());
+        columns[1]->insertRangeFrom(*block.getByName("b").column, 0, block.rows());
+    }
+    Block block{
+        ColumnWithTypeAndName(std::move(columns[0]), blocks[0].getByName("a").type, "a"),
+        ColumnWithTypeAndName(std::move(columns[1]), blocks[0].getByName("b").type, "b")};
+    sortBlock(block, desc);
+    return block;
+}
+} // namespace
+
+class TestTopNTransformOp : public ::testing::Test
+{
+};
+
+TEST_F(TestTopNTransformOp, compareWithSort)
+try
+{
+    const auto blocks = generateBlocks(20, 50, 0x1234);
+    for (int direction : {1, -1})
+    {
+        for (int nulls_direction : {1, -1})
+        {
+            SortDescription desc{
+                SortColumnDescription("a", direction, nulls_direction),
+                SortColumnDescription("b", -direction, nulls_direction)};
+            const Block expected = sortAll(blocks, desc);
+            for (size_t limit : {0, 1, 3, 17, 100, 999, 1000, 2000})
+            {
+                for (size_t max_block_size : {7, 8192})
+                {
+                    auto threshold = std::make_shared<TopNThreshold>(
+                        buildColumnRef(0),
+                        "a",
+                        makeNullable(std::make_shared<DataTypeInt64>()),
+                        direction,
+                        nulls_direction,
+                        TimezoneInfo{});
+                    const Block actual = runTopN(blocks, desc, limit, max_block_size, threshold);
+                    const size_t expected_rows = std::min(limit, expected.rows());
+                    ASSERT_EQ(actual.rows(), expected_rows) << limit;
+                    ASSERT_EQ(actual.columns(), 3);
+                    for (const auto & name : {"a", "b"})
+                    {
+                        const auto & expected_column = *expected.getByName(name).column;
+                        const auto & actual_column = *actual.getByName(name).column;
+                        for (size_t i = 0; i < expected_rows; ++i)
+                            ASSERT_EQ(actual_column[i], expected_column[i]) << name << " " << i << " " << limit;
+                    }
+                    ASSERT_TRUE(actual.getByName("k").column->isColumnConst());
+
+                    // The threshold is the first sort column of the last row kept.
+                    if (limit > 0 && limit <= expected.rows() && !expected.getByName("a").column->isNullAt(limit - 1))
+                    {
+                        ASSERT_TRUE(threshold->hasThreshold());
+                        ASSERT_EQ(threshold->getThreshold(), (*expected.getByName("a").column)[limit - 1]);
+                    }
+                    if (limit == 0 || limit > expected.rows())
+                        ASSERT_FALSE(threshold->hasThreshold());
+                }
+            }
+        }
+    }
+}
+CATCH
+
+TEST_F(TestTopNTransformOp, threshold)
+try
+{
+    TiDB::ColumnInfo column_info;
+    column_info.id = 1;
+    column_info.name = "a";
+    column_info.tp = TiDB::TypeLongLong;
+    const auto type = makeNullable(std::make_shared<DataTypeInt64>());
+    const DM::ColumnDefines column_defines{DM::ColumnDefine(1, "a", type)};
+    auto generate_block = [] {
+        return Block{createColumn<Nullable<Int64>>({5, 10, 15, {}}, "a"), createColumn<Int64>({1, 2, 3, 4}, "b")};
+    };
+
+    // ASC, nulls last
+    {
+        TopNThreshold threshold(buildColumnRef(0), "a", type, 1, 1, TimezoneInfo{});
+        threshold.setTargetAttr({column_info}, column_defines);
+        ASSERT_EQ(threshold.parseToRSOperator(), nullptr);
+        Block block = generate_block();
+        ASSERT_EQ(threshold.filterBlock(block), 0);
+
+        threshold.update(Field(static_cast<Int64>(10)));
+        // A looser threshold is ignored.
+        threshold.update(Field(static_cast<Int64>(20)));
+        threshold.update(Field());
+        ASSERT_EQ(threshold.getThreshold(), Field(static_cast<Int64>(10)));
+        ASSERT_EQ(threshold.parseToRSOperator()->name(), "less_equal");
+        ASSERT_EQ(threshold.filterBlock(block), 2);
+        ASSERT_COLUMN_EQ(block.getByName("b"), createColumn<Int64>({1, 2}));
+    }
+    // DESC, nulls first
+    {
+        TopNThreshold threshold(buildColumnRef(0), "a", type, -1, 1, TimezoneInfo{});
+        threshold.setTargetAttr({column_info}, column_defines);
+        threshold.update(Field(static_cast<Int64>(5)));
+        threshold.update(Field(static_cast<Int64>(10)));
+        ASSERT_EQ(threshold.getThreshold(), Field(static_cast<Int64>(10)));
+        ASSERT_EQ(threshold.parseToRSOperator()->name(), "or");
+        Block block = generate_block();
+        ASSERT_EQ(threshold.filterBlock(block), 1);
+        ASSERT_COLUMN_EQ(block.getByName("b"), createColumn<Int64>({2, 3, 4}));
+    }
+    // The target column is not read by the table scan.
+    {
+        TopNThreshold threshold(buildColumnRef(0), "a", type, 1, 1, TimezoneInfo{});
+        threshold.update(Field(static_cast<Int64>(10)));
+        ASSERT_EQ(threshold.parseToRSOperator()->name(), "unsupported");
+        Block block = generate_block();
+        ASSERT_EQ(threshold.filterBlock(block), 0);
+    }
+}
+CATCH
+
+} // namespace DB::tests
@@ -81,6 +81,7 @@
 #include <Server/TCPServersHolder.h>
 #include <Server/UserConfigParser.h>
 #include <Storages/DeltaMerge/ColumnFile/ColumnFileSchema.h>
+#include <Storages/DeltaMerge/ReadThread/CPU.h>
 #include <Storages/DeltaMerge/ReadThread/DMFileReaderPool.h>
 #include <Storages/DeltaMerge/ReadThread/SegmentReadTaskScheduler.h>
 #include <Storages/DeltaMerge/ReadThread/SegmentReader.h>
@@ -532,6 +533,17 @@ void Server::initCaches(bool is_disagg_compute_mode, bool is_disagg_storage_mode
     if (minmax_index_cache_size)
         global_context->setMinMaxIndexCache(minmax_index_cache_size);
 
+    /// Size of cache for n-gram bloom index, used by DeltaMerge engine.
+    size_t ngram_bloom_index_cache_size = config().getUInt64("ngram_bloom_index_cache_size", minmax_index_cache_size);
+    if (ngram_bloom_index_cache_size)
+        global_context->setNgramBloomIndexCache(ngram_bloom_index_cache_size);
+
+    /// Size of cache for equality bloom index, used by DeltaMerge engine.
+    size_t equality_bloom_index_cache_size
+        = config().getUInt64("equality_bloom_index_cache_size", minmax_index_cache_size);
+    if (equality_bloom_index_cache_size)
+        global_context->setEqualityBloomIndexCache(equality_bloom_index_cache_size);
+
     /// The vector index cache by number instead of bytes. Because it use `mmap` and let the operating system decide the memory usage.
     size_t light_local_index_cache_entities = config().getUInt64("light_local_index_cache_entities", 10000);
     size_t heavy_local_index_cache_entities = config().getUInt64("heavy_local_index_cache_entities", 500);
@@ -1276,6 +1288,8 @@ try
                 {get_pool_size(settings.pipeline_io_task_thread_pool_size),
                  settings.pipeline_io_task_thread_pool_queue_type},
             };
+            if (settings.pipeline_cpu_task_thread_pool_numa_aware)
+                config.cpu_numa_nodes = DM::getNumaNodes(log);
             RUNTIME_CHECK(!TaskScheduler::instance);
             TaskScheduler::instance = std::make_unique<TaskScheduler>(config);
             LOG_INFO(log, "init pipeline task scheduler with {}", config.toString());
@@ -35,6 +35,7 @@
 #include <Storages/KVStore/Region.h>
 #include <Storages/Page/PageStorage.h>
 #include <Storages/Page/V2/PageStorage.h>
+#include <Storages/Page/V3/WAL/WALConfig.h>
 #include <Storages/PathCapacityMetrics.h>
 #include <Storages/PathPool.h>
 #include <TestUtils/ConfigTestUtils.h>
@@ -389,6 +390,7 @@ dt_storage_pool_data_gc_min_bytes = 256
 dt_storage_pool_data_gc_max_valid_rate = 0.5
 dt_open_file_max_idle_seconds = 20
 dt_page_gc_low_write_prob = 0.2
+dt_page_wal_restore_threads = 2
         )"};
     auto & global_ctx = TiFlashTestEnv::getGlobalContext();
     if (global_ctx.getPageStorageRunMode() == PageStorageRunMode::UNI_PS)
@@ -421,6 +423,8 @@ dt_page_gc_low_write_prob = 0.2
         EXPECT_EQ(cfg.blob_heavy_gc_valid_rate, settings.dt_page_gc_threshold);
         EXPECT_EQ(cfg.open_file_max_idle_time, settings.dt_open_file_max_idle_seconds);
         EXPECT_EQ(cfg.prob_do_gc_when_write_is_low, settings.dt_page_gc_low_write_prob * 1000);
+        EXPECT_EQ(cfg.wal_restore_threads, settings.dt_page_wal_restore_threads);
+        EXPECT_EQ(PS::V3::WALConfig::from(cfg).restore_threads, settings.dt_page_wal_restore_threads);
     };
 
     for (size_t i = 0; i < tests.size(); ++i)
@@ -444,6 +448,7 @@ dt_page_gc_low_write_prob = 0.2
         ASSERT_DOUBLE_EQ(global_ctx.getSettingsRef().dt_page_gc_threshold, 0.3);
         ASSERT_EQ(global_ctx.getSettingsRef().dt_open_file_max_idle_seconds, 20);
         ASSERT_FLOAT_EQ(global_ctx.getSettingsRef().dt_page_gc_low_write_prob, 0.2);
+        ASSERT_EQ(global_ctx.getSettingsRef().dt_page_wal_restore_threads, 2);
         verify_persister_reload_config(persister);
     }
     global_ctx.setSettings(origin_settings);
@@ -12,19 +12,54 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <Columns/countBytesInFilter.h>
+#include <Common/TargetSpecific.h>
 #include <Storages/DeltaMerge/BitmapFilter/BitmapFilter.h>
 #include <Storages/DeltaMerge/DeltaMergeHelpers.h>
 
+#include <algorithm>
+#include <cstring>
+
 namespace DB::DM
 {
 
+namespace
+{
+// The runs are used only if they are at least `COMPRESS_RATIO` times smaller than the dense bytes,
+// so that walking the runs is not slower than scanning the bytes.
+constexpr size_t COMPRESS_RATIO = 16;
+
+// The values of the filters are not always 0 or 1, so compare them with 0 before combining.
+TIFLASH_DECLARE_MULTITARGET_FUNCTION(
+    void,
+    filterAnd,
+    (dst, src, size),
+    (UInt8 * __restrict dst, const UInt8 * __restrict src, size_t size),
+    {
+        for (size_t i = 0; i < size; ++i)
+            dst[i] = static_cast<UInt8>(dst[i] != 0) & static_cast<UInt8>(src[i] != 0);
+    })
+
+TIFLASH_DECLARE_MULTITARGET_FUNCTION(
+    void,
+    filterOr,
+    (dst, src, size),
+    (UInt8 * __restrict dst, const UInt8 * __restrict src, size_t size),
+    {
+        for (size_t i = 0; i < size; ++i)
+            dst[i] = static_cast<UInt8>((dst[i] | src[i]) != 0);
+    })
+} // namespace
+
 BitmapFilter::BitmapFilter(UInt32 size_, bool default_value)
     : filter(size_, static_cast<UInt8>(default_value))
+    , rows(size_)
     , all_match(default_value)
 {}
 
 BitmapFilter::BitmapFilter(std::initializer_list<UInt8> init)
     : filter(init)
+    , rows(init.size())
     , all_match(false)
 {
     runOptimize();
@@ -56,6 +91,8 @@ void BitmapFilter::set(std::span<const UInt32> row_ids, const FilterPtr & f)
     {
         return;
     }
+    if (compressed)
+        toDense();
     if (!f)
     {
         for (auto row_id : row_ids)
@@ -75,16 +112,30 @@ void BitmapFilter::set(std::span<const UInt32> row_ids, const FilterPtr & f)
 
 void BitmapFilter::set(UInt32 start, UInt32 limit, bool value)
 {
-    RUNTIME_CHECK(start + limit <= filter.size(), start, limit, filter.size());
+    RUNTIME_CHECK(start + limit <= rows, start, limit, rows);
+    if (compressed)
+        toDense();
     std::fill_n(filter.begin() + start, limit, static_cast<UInt8>(value));
 }
 
 bool BitmapFilter::get(IColumn::Filter & f, UInt32 start, UInt32 limit) const
 {
-    RUNTIME_CHECK(start + limit <= filter.size(), start, limit, filter.size());
+    RUNTIME_CHECK(start + limit <= rows, start, limit, rows);
+    if (all_match)
+    {
+        return true;
+    }
+    if (compressed)
+    {
+        auto it = firstRunEndAfter(start);
+        if (it != runs.end() && it->start <= start && it->end >= start + limit)
+            return true;
+        fillRange(f.data(), start, limit);
+        return false;
+    }
     auto begin = filter.cbegin() + start;
     auto end = filter.cbegin() + start + limit;
-    if (all_match || std::find(begin, end, static_cast<UInt8>(false)) == end)
+    if (std::find(begin, end, static_cast<UInt8>(false)) == end)
     {
         return true;
     }
@@ -97,55 +148,123 @@ bool BitmapFilter::get(IColumn::Filter & f, UInt32 start, UInt32 limit) const
 
 void BitmapFilter::rangeAnd(IColumn::Filter & f, UInt32 start, UInt32 limit) const
 {
-    RUNTIME_CHECK(start + limit <= filter.size() && f.size() == limit);
-    auto begin = filter.cbegin() + start;
-    if (!all_match)
+    RUNTIME_CHECK(start + limit <= rows && f.size() == limit);
+    if (all_match)
     {
-        std::transform(f.begin(), f.end(), begin, f.begin(), [](const auto a, const auto b) { return a && b; });
+        return;
     }
+    if (compressed)
+    {
+        // Clear the rows that are not covered by any run
+        const UInt32 end = start + limit;
+        UInt32 pos = start;
+        for (auto it = firstRunEndAfter(start); it != runs.end() && it->start < end && pos < end; ++it)
+        {
+            if (it->start > pos)
+                std::memset(f.data() + (pos - start), 0, it->start - pos);
+            pos = std::max(pos, it->end);
+        }
+        if (pos < end)
+            std::memset(f.data() + (pos - start), 0, end - pos);
+        return;
+    }
+    filterAnd(f.data(), filter.data() + start, limit);
 }
 
 void BitmapFilter::logicalOr(const BitmapFilter & other)
 {
-    RUNTIME_CHECK(filter.size() == other.filter.size());
+    RUNTIME_CHECK(rows == other.rows);
     if (all_match)
     {
         return;
     }
     if (other.all_match)
     {
-        filter.assign(filter.size(), static_cast<UInt8>(true));
+        // All rows are true, which is a single run
+        toRuns(Runs{{0, rows}});
         all_match = true;
         return;
     }
-    for (UInt32 i = 0; i < filter.size(); ++i)
+    if (compressed && other.compressed)
+    {
+        runs = unionRuns(runs, other.runs);
+        all_match = runs.size() == 1 && runs[0].start == 0 && runs[0].end == rows;
+        return;
+    }
+    if (compressed)
+        toDense();
+    if (other.compressed)
     {
-        filter[i] = filter[i] || other.filter[i];
+        for (const auto & run : other.runs)
+            std::memset(filter.data() + run.start, 1, run.end - run.start);
+    }
+    else
+    {
+        filterOr(filter.data(), other.filter.data(), rows);
     }
-    all_match = all_match || other.all_match;
 }
 
 void BitmapFilter::logicalAnd(const BitmapFilter & other)
 {
-    RUNTIME_CHECK(filter.size() == other.filter.size());
+    RUNTIME_CHECK(rows == other.rows);
     if (other.all_match)
         return;
     if (all_match)
     {
-        std::copy(other.filter.cbegin(), other.filter.cend(), filter.begin());
+        filter.assign(other.filter.cbegin(), other.filter.cend());
+        runs = other.runs;
+        compressed = other.compressed;
         all_match = other.all_match;
         return;
     }
-    for (UInt32 i = 0; i < filter.size(); ++i)
+    // `other` is not all match, so the result is not all match either
+    all_match = false;
+    if (compressed && other.compressed)
     {
-        filter[i] = filter[i] && other.filter[i];
+        runs = intersectRuns(runs, other.runs);
+        return;
+    }
+    if (compressed)
+        toDense();
+    if (other.compressed)
+    {
+        // Clear the rows that are not covered by the runs of `other`
+        UInt32 pos = 0;
+        for (const auto & run : other.runs)
+        {
+            std::memset(filter.data() + pos, 0, run.start - pos);
+            pos = run.end;
+        }
+        std::memset(filter.data() + pos, 0, rows - pos);
+    }
+    else
+    {
+        filterAnd(filter.data(), other.filter.data(), rows);
     }
-    all_match = all_match && other.all_match;
 }
 
 void BitmapFilter::append(const BitmapFilter & other)
 {
-    filter.insert(filter.end(), other.filter.cbegin(), other.filter.cend());
+    if (compressed && other.compressed)
+    {
+        auto it = other.runs.begin();
+        // Merge the adjacent runs
+        if (!runs.empty() && it != other.runs.end() && runs.back().end == rows && it->start == 0)
+        {
+            runs.back().end = rows + it->end;
+            ++it;
+        }
+        for (; it != other.runs.end(); ++it)
+            runs.push_back({rows + it->start, rows + it->end});
+    }
+    else
+    {
+        if (compressed)
+            toDense();
+        filter.resize(rows + other.rows);
+        other.fillRange(filter.data() + rows, 0, other.rows);
+    }
+    rows += other.rows;
     all_match = all_match && other.all_match;
 }
 
@@ -155,23 +274,53 @@ bool BitmapFilter::isAllNotMatch(size_t start, size_t limit) const
     {
         return false;
     }
-    assert(start + limit <= filter.size());
+    assert(start + limit <= rows);
+    if (compressed)
+    {
+        auto it = firstRunEndAfter(start);
+        return it == runs.end() || it->start >= start + limit;
+    }
     return std::all_of(filter.cbegin() + start, filter.cbegin() + start + limit, [](const auto a) { return !a; });
 }
 
 void BitmapFilter::runOptimize()
 {
-    all_match = std::find(filter.begin(), filter.end(), static_cast<UInt8>(false)) == filter.end();
+    // Each run costs `sizeof(Run)` bytes, and a filter with single run is always compressed
+    // so that `all_match` can be derived from the runs.
+    const size_t max_runs = std::max(rows / (sizeof(Run) * COMPRESS_RATIO), size_t{1});
+    if (compressed)
+    {
+        all_match = rows == 0 || (runs.size() == 1 && runs[0].start == 0 && runs[0].end == rows);
+        if (runs.size() > max_runs)
+            toDense();
+        return;
+    }
+
+    Runs new_runs;
+    if (!collectRuns(filter.data(), rows, max_runs, new_runs))
+    {
+        // There are more than one runs, so some rows must be false
+        all_match = false;
+        return;
+    }
+    all_match = rows == 0 || (new_runs.size() == 1 && new_runs[0].start == 0 && new_runs[0].end == rows);
+    toRuns(std::move(new_runs));
 }
 
 String BitmapFilter::toDebugString() const
 {
-    String s(filter.size(), '1');
-    for (UInt32 i = 0; i < filter.size(); ++i)
+    String s(rows, '0');
+    if (compressed)
+    {
+        for (const auto & run : runs)
+            std::fill_n(s.begin() + run.start, run.end - run.start, '1');
+        return s;
+    }
+    for (UInt32 i = 0; i < rows; ++i)
     {
-        if (!filter[i])
+        if (filter[i])
         {
-            s[i] = '0';
+            s[i] = '1';
         }
     }
     return s;
@@ -179,6 +328,144 @@ String BitmapFilter::toDebugString() const
 
 size_t BitmapFilter::count() const
 {
-    return std::count(filter.cbegin(), filter.cend(), static_cast<UInt8>(true));
+    if (compressed)
+    {
+        size_t n = 0;
+        for (const auto & run : runs)
+            n += run.end - run.start;
+        return n;
+    }
+    return countBytesInFilter(filter);
+}
+
+size_t BitmapFilter::allocatedBytes() const
+{
+    return filter.capacity() + runs.capacity() * sizeof(Run);
+}
+
+bool BitmapFilter::operator==(const BitmapFilter & other) const
+{
+    if (rows != other.rows || all_match != other.all_match)
+        return false;
+    if (!compressed && !other.compressed)
+        return filter == other.filter;
+    if (compressed && other.compressed)
+    {
+        return std::equal(
+            runs.begin(),
+            runs.end(),
+            other.runs.begin(),
+            other.runs.end(),
+            [](const Run & lhs, const Run & rhs) { return lhs.start == rhs.start && lhs.end == rhs.end; });
+    }
+    const auto & dense = compressed ? other : *this;
+    const auto & sparse = compressed ? *this : other;
+    IColumn::Filter values(rows);
+    sparse.fillRange(values.data(), 0, rows);
+    return values == dense.filter;
+}
+
+bool BitmapFilter::getFromRuns(UInt32 n) const
+{
+    auto it = firstRunEndAfter(n);
+    return it != runs.end() && it->start <= n;
+}
+
+BitmapFilter::Runs::const_iterator BitmapFilter::firstRunEndAfter(UInt32 n) const
+{
+    // The runs are sorted and not overlapped, so the ends are sorted too.
+    return std::partition_point(runs.begin(), runs.end(), [n](const Run & run) { return run.end <= n; });
+}
+
+void BitmapFilter::fillRange(UInt8 * dst, UInt32 start, UInt32 limit) const
+{
+    if (!compressed)
+    {
+        std::memcpy(dst, filter.data() + start, limit);
+        return;
+    }
+    std::memset(dst, 0, limit);
+    const UInt32 end = start + limit;
+    for (auto it = firstRunEndAfter(start); it != runs.end() && it->start < end; ++it)
+    {
+        const UInt32 run_start = std::max(it->start, start);
+        const UInt32 run_end = std::min(it->end, end);
+        std::memset(dst + (run_start - start), 1, run_end - run_start);
+    }
+}
+
+void BitmapFilter::toDense()
+{
+    filter.resize_fill_zero(rows);
+    for (const auto & run : runs)
+        std::memset(filter.data() + run.start, 1, run.end - run.start);
+    Runs().swap(runs);
+    compressed = false;
+}
+
+void BitmapFilter::toRuns(Runs && runs_)
+{
+    runs = std::move(runs_);
+    runs.shrink_to_fit();
+    IColumn::Filter().swap(filter);
+    compressed = true;
+}
+
+bool BitmapFilter::collectRuns(const UInt8 * data, UInt32 size, size_t max_runs, Runs & res)
+{
+    const UInt8 * pos = data;
+    const UInt8 * end = data + size;
+    while (pos < end)
+    {
+        // Skip the false rows
+        const auto * run_start = std::find_if(pos, end, [](UInt8 v) { return v != 0; });
+        if (run_start == end)
+            break;
+        if (res.size() == max_runs)
+            return false;
+        // The true rows are usually much more than the false rows, find the end of run by `memchr`
+        const auto * run_end = static_cast<const UInt8 *>(std::memchr(run_start, 0, end - run_start));
+        if (run_end == nullptr)
+            run_end = end;
+        res.push_back({static_cast<UInt32>(run_start - data), static_cast<UInt32>(run_end - data)});
+        pos = run_end;
+    }
+    return true;
+}
+
+BitmapFilter::Runs BitmapFilter::unionRuns(const Runs & lhs, const Runs & rhs)
+{
+    Runs res;
+    res.reserve(lhs.size() + rhs.size());
+    size_t i = 0;
+    size_t j = 0;
+    while (i < lhs.size() || j < rhs.size())
+    {
+        const auto & run = (j == rhs.size() || (i < lhs.size() && lhs[i].start < rhs[j].start)) ? lhs[i++] : rhs[j++];
+        if (!res.empty() && run.start <= res.back().end)
+            res.back().end = std::max(res.back().end, run.end);
+        else
+            res.push_back(run);
+    }
+    return res;
+}
+
+BitmapFilter::Runs BitmapFilter::intersectRuns(const Runs & lhs, const Runs & rhs)
+{
+    Runs res;
+    size_t i = 0;
+    size_t j = 0;
+    while (i < lhs.size() && j < rhs.size())
+    {
+        const UInt32 start = std::max(lhs[i].start, rhs[j].start);
+        const UInt32 end = std::min(lhs[i].end, rhs[j].end);
+        if (start < end)
+            res.push_back({start, end});
+        if (lhs[i].end < rhs[j].end)
+            ++i;
+        else
+            ++j;
+    }
+    return res;
 }
 } // namespace DB::DM
@@ -16,12 +16,24 @@
 
 #include <Columns/IColumn.h>
 #include <DataStreams/IBlockInputStream.h>
+#include <common/likely.h>
 
 #include <span>
+#include <vector>
 
 namespace DB::DM
 {
 
+/**
+ * A filter with one value for each row of a segment.
+ *
+ * The filter is built in the dense representation, which stores one byte for each row. After building,
+ * `runOptimize` selects the representation by density: if the true rows form only a few runs (e.g. a
+ * segment with few deletes, or an inverted index search result with few matches), the filter is converted
+ * to a sorted list of runs and the dense bytes are released. Otherwise the dense representation is kept.
+ * Both representations provide the same interfaces, and the filter is converted back to the dense
+ * representation if it is modified by `operator[]` or `set` after compressed.
+ */
 class BitmapFilter
 {
 public:
@@ -37,7 +49,7 @@ public:
     // If return true, all data is match and do not fill the filter.
     bool get(IColumn::Filter & f, UInt32 start, UInt32 limit) const;
     // Caller should ensure n in [0, size).
-    inline bool get(UInt32 n) const { return filter[n]; }
+    inline bool get(UInt32 n) const { return likely(!compressed) ? filter[n] : getFromRuns(n); }
     // filter[start, start+limit) & f -> f
     void rangeAnd(IColumn::Filter & f, UInt32 start, UInt32 limit) const;
 
@@ -50,22 +62,59 @@ public:
     // all_of(filter[start, start+limit), false)
     bool isAllNotMatch(size_t start, size_t limit) const;
 
+    // Update `all_match` and select the representation by density.
     void runOptimize();
     void setAllMatch(bool all_match_) { all_match = all_match_; }
     bool isAllMatch() const { return all_match; }
+    bool isCompressed() const { return compressed; }
 
     String toDebugString() const;
     size_t count() const;
-    inline size_t size() const { return filter.size(); }
+    inline size_t size() const { return rows; }
+    // The bytes allocated by the filter, for both representations.
+    size_t allocatedBytes() const;
 
-    ALWAYS_INLINE auto & operator[](size_t n) { return filter[n]; }
+    ALWAYS_INLINE auto & operator[](size_t n)
+    {
+        if (unlikely(compressed))
+            toDense();
+        return filter[n];
+    }
 
-    bool operator==(const BitmapFilter & other) const { return filter == other.filter && all_match == other.all_match; }
+    bool operator==(const BitmapFilter & other) const;
 
     friend class BitmapFilterView;
 
 private:
+    // The rows in [start, end) are all true.
+    struct Run
+    {
+        UInt32 start;
+        UInt32 end;
+    };
+    using Runs = std::vector<Run>;
+
+    bool getFromRuns(UInt32 n) const;
+    // Return the first run that ends after `n`.
+    Runs::const_iterator firstRunEndAfter(UInt32 n) const;
+    // Copy the values of [start, start+limit) to `dst`.
+    void fillRange(UInt8 * dst, UInt32 start, UInt32 limit) const;
+
+    void toDense();
+    void toRuns(Runs && runs_);
+
+    // Collect the runs of true values in `data`. Return false if there are more than `max_runs` runs.
+    static bool collectRuns(const UInt8 * data, UInt32 size, size_t max_runs, Runs & res);
+    static Runs unionRuns(const Runs & lhs, const Runs & rhs);
+    static Runs intersectRuns(const Runs & lhs, const Runs & rhs);
+
+private:
+    // The dense representation, it is empty if the filter is compressed.
     IColumn::Filter filter;
+    // The compressed representation, only valid if `compressed` is true.
+    Runs runs;
+    UInt32 rows;
+    bool compressed = false;
     bool all_match;
 };
 
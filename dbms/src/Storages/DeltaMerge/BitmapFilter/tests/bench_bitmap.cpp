@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <Core/Defines.h>
+#include <Storages/DeltaMerge/BitmapFilter/BitmapFilter.h>
 #include <benchmark/benchmark.h>
 
 #include <random>
@@ -155,6 +156,138 @@ static void bitmapGetRangeUInt8(benchmark::State & state)
     bitmapGetRange<UInt8>(state);
 }
 
+// Patterns of the MVCC bitmap filters
+enum class FilterPattern
+{
+    FewDeletes = 0, // 1 of 10000 rows are false
+    ManyDeletes,    // 1 of 100 rows are false
+    Random,         // half of the rows are false
+    FewMatches,     // 1 of 10000 rows are true, e.g. the result of inverted index
+    Clustered,      // the true rows and false rows are in large ranges
+};
+
+constexpr UInt32 TEST_FILTER_ROWS = 1000000;
+constexpr UInt32 TEST_BLOCK_ROWS = 8192;
+
+static DM::BitmapFilter buildFilterByPattern(FilterPattern pattern, bool optimize, UInt32 seed)
+{
+    std::mt19937 gen(seed);
+    DM::BitmapFilter filter(TEST_FILTER_ROWS, false);
+    for (UInt32 i = 0; i < TEST_FILTER_ROWS; ++i)
+    {
+        switch (pattern)
+        {
+        case FilterPattern::FewDeletes:
+            filter[i] = gen() % 10000 != 0;
+            break;
+        case FilterPattern::ManyDeletes:
+            filter[i] = gen() % 100 != 0;
+            break;
+        case FilterPattern::Random:
+            filter[i] = gen() % 2;
+            break;
+        case FilterPattern::FewMatches:
+            filter[i] = gen() % 10000 == 0;
+            break;
+        case FilterPattern::Clustered:
+            filter[i] = (i / (TEST_BLOCK_ROWS * 3)) % 2;
+            break;
+        }
+    }
+    // Without `runOptimize`, the filter is kept in the dense representation.
+    if (optimize)
+        filter.runOptimize();
+    return filter;
+}
+
+// Arguments: pattern, whether to select the representation by `runOptimize`
+static void filterPatternArgs(benchmark::internal::Benchmark * b)
+{
+    for (Int64 pattern = 0; pattern <= static_cast<Int64>(FilterPattern::Clustered); ++pattern)
+    {
+        b->Args({pattern, 0});
+        b->Args({pattern, 1});
+    }
+}
+
+static void setFilterCounters(benchmark::State & state, const DM::BitmapFilter & filter)
+{
+    state.counters["compressed"] = filter.isCompressed();
+    state.counters["bytes"] = filter.allocatedBytes();
+}
+
+static void bitmapFilterRangeAnd(benchmark::State & state)
+{
+    const auto filter = buildFilterByPattern(static_cast<FilterPattern>(state.range(0)), state.range(1), 0);
+    IColumn::Filter f(TEST_BLOCK_ROWS);
+    for (auto _ : state)
+    {
+        for (UInt32 start = 0; start + TEST_BLOCK_ROWS <= TEST_FILTER_ROWS; start += TEST_BLOCK_ROWS)
+        {
+            std::fill(f.begin(), f.end(), 1);
+            filter.rangeAnd(f, start, TEST_BLOCK_ROWS);
+            benchmark::DoNotOptimize(f.data());
+        }
+    }
+    setFilterCounters(state, filter);
+}
+
+static void bitmapFilterGet(benchmark::State & state)
+{
+    const auto filter = buildFilterByPattern(static_cast<FilterPattern>(state.range(0)), state.range(1), 0);
+    IColumn::Filter f(TEST_BLOCK_ROWS);
+    for (auto _ : state)
+    {
+        for (UInt32 start = 0; start + TEST_BLOCK_ROWS <= TEST_FILTER_ROWS; start += TEST_BLOCK_ROWS)
+        {
+            auto all_match = filter.get(f, start, TEST_BLOCK_ROWS);
+            benchmark::DoNotOptimize(all_match);
+            benchmark::DoNotOptimize(f.data());
+        }
+    }
+    setFilterCounters(state, filter);
+}
+
+static void bitmapFilterLogicalAnd(benchmark::State & state)
+{
+    const auto pattern = static_cast<FilterPattern>(state.range(0));
+    const auto lhs = buildFilterByPattern(pattern, state.range(1), 0);
+    const auto rhs = buildFilterByPattern(pattern, state.range(1), 1);
+    for (auto _ : state)
+    {
+        // The copy is included, which is same as building a new filter in practice
+        auto res = lhs;
+        res.logicalAnd(rhs);
+        benchmark::DoNotOptimize(res);
+    }
+    setFilterCounters(state, lhs);
+}
+
+static void bitmapFilterLogicalOr(benchmark::State & state)
+{
+    const auto pattern = static_cast<FilterPattern>(state.range(0));
+    const auto lhs = buildFilterByPattern(pattern, state.range(1), 0);
+    const auto rhs = buildFilterByPattern(pattern, state.range(1), 1);
+    for (auto _ : state)
+    {
+        auto res = lhs;
+        res.logicalOr(rhs);
+        benchmark::DoNotOptimize(res);
+    }
+    setFilterCounters(state, lhs);
+}
+
+static void bitmapFilterCount(benchmark::State & state)
+{
+    const auto filter = buildFilterByPattern(static_cast<FilterPattern>(state.range(0)), state.range(1), 0);
+    for (auto _ : state)
+    {
+        auto n = filter.count();
+        benchmark::DoNotOptimize(n);
+    }
+    setFilterCounters(state, filter);
+}
+
 BENCHMARK(bitmapAndBool);
 BENCHMARK(bitmapAndUInt8);
 BENCHMARK(bitmapSetRowIDBool);
@@ -163,4 +296,9 @@ BENCHMARK(bitmapSetRangeBool);
 BENCHMARK(bitmapSetRangeUInt8);
 BENCHMARK(bitmapGetRangeBool);
 BENCHMARK(bitmapGetRangeUInt8);
+BENCHMARK(bitmapFilterRangeAnd)->Apply(filterPatternArgs);
+BENCHMARK(bitmapFilterGet)->Apply(filterPatternArgs);
+BENCHMARK(bitmapFilterLogicalAnd)->Apply(filterPatternArgs);
+BENCHMARK(bitmapFilterLogicalOr)->Apply(filterPatternArgs);
+BENCHMARK(bitmapFilterCount)->Apply(filterPatternArgs);
 } // namespace DB::bench
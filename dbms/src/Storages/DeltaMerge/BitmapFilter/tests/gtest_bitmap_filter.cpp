@@ -0,0 +1,181 @@
+// Copyright 2024 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Storages/DeltaMerge/BitmapFilter/BitmapFilter.h>
+#include <Storages/DeltaMerge/BitmapFilter/BitmapFilterView.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+
+namespace DB::DM::tests
+{
+namespace
+{
+// About `1 / ratio` of the values are false, or about `1 / ratio` of the values are true if `sparse` is true.
+std::vector<UInt8> genValues(UInt32 size, UInt32 ratio, bool sparse, std::mt19937 & gen)
+{
+    std::vector<UInt8> values(size);
+    for (auto & v : values)
+        v = (gen() % ratio == 0) == sparse;
+    return values;
+}
+
+BitmapFilter buildFilter(const std::vector<UInt8> & values, bool optimize)
+{
+    BitmapFilter filter(values.size(), false);
+    for (UInt32 i = 0; i < values.size(); ++i)
+        filter[i] = values[i];
+    if (optimize)
+        filter.runOptimize();
+    return filter;
+}
+
+void checkFilter(const BitmapFilter & filter, const std::vector<UInt8> & values)
+{
+    ASSERT_EQ(filter.size(), values.size());
+    ASSERT_EQ(filter.count(), static_cast<size_t>(std::count(values.begin(), values.end(), 1)));
+    for (UInt32 i = 0; i < values.size(); ++i)
+        ASSERT_EQ(filter.get(i), static_cast<bool>(values[i])) << i;
+
+    constexpr UInt32 block_rows = 100;
+    for (UInt32 start = 0; start < values.size(); start += block_rows)
+    {
+        const UInt32 limit = std::min<UInt32>(block_rows, values.size() - start);
+        const auto matched = std::count(values.begin() + start, values.begin() + start + limit, 1);
+        ASSERT_EQ(filter.isAllNotMatch(start, limit), matched == 0);
+
+        IColumn::Filter f(limit);
+        if (filter.get(f, start, limit))
+        {
+            ASSERT_EQ(static_cast<UInt32>(matched), limit);
+        }
+        else
+        {
+            for (UInt32 i = 0; i < limit; ++i)
+                ASSERT_EQ(f[i], values[start + i]);
+        }
+
+        IColumn::Filter and_f(limit, 1);
+        and_f[0] = 0;
+        filter.rangeAnd(and_f, start, limit);
+        ASSERT_EQ(and_f[0], 0);
+        for (UInt32 i = 1; i < limit; ++i)
+            ASSERT_EQ(and_f[i], values[start + i]);
+    }
+}
+} // namespace
+
+TEST(BitmapFilterTest, SelectRepresentation)
+{
+    std::mt19937 gen(0);
+    // Few deletes, compressed
+    {
+        auto values = genValues(100000, 10000, false, gen);
+        auto filter = buildFilter(values, true);
+        ASSERT_TRUE(filter.isCompressed());
+        ASSERT_LT(filter.allocatedBytes(), values.size() / 16);
+        checkFilter(filter, values);
+    }
+    // Few matches, compressed
+    {
+        auto values = genValues(100000, 10000, true, gen);
+        auto filter = buildFilter(values, true);
+        ASSERT_TRUE(filter.isCompressed());
+        checkFilter(filter, values);
+    }
+    // Random, dense
+    {
+        auto values = genValues(100000, 2, false, gen);
+        auto filter = buildFilter(values, true);
+        ASSERT_FALSE(filter.isCompressed());
+        checkFilter(filter, values);
+    }
+    // All match, compressed to a single run
+    {
+        BitmapFilter filter(100000, false);
+        filter.set(0, 100000);
+        filter.runOptimize();
+        ASSERT_TRUE(filter.isCompressed());
+        ASSERT_TRUE(filter.isAllMatch());
+        ASSERT_EQ(filter.count(), 100000UL);
+    }
+}
+
+TEST(BitmapFilterTest, MixedRepresentations)
+{
+    std::mt19937 gen(0);
+    constexpr UInt32 size = 20000;
+    const std::vector<std::pair<UInt32, bool>> patterns = {{1000, false}, {1000, true}, {2, false}};
+    for (const auto & [ratio1, sparse1] : patterns)
+    {
+        for (const auto & [ratio2, sparse2] : patterns)
+        {
+            const auto values1 = genValues(size, ratio1, sparse1, gen);
+            const auto values2 = genValues(size, ratio2, sparse2, gen);
+            for (bool optimize1 : {false, true})
+            {
+                for (bool optimize2 : {false, true})
+                {
+                    const auto filter2 = buildFilter(values2, optimize2);
+
+                    auto and_filter = buildFilter(values1, optimize1);
+                    and_filter.logicalAnd(filter2);
+                    std::vector<UInt8> and_values(size);
+                    for (UInt32 i = 0; i < size; ++i)
+                        and_values[i] = values1[i] && values2[i];
+                    checkFilter(and_filter, and_values);
+                    and_filter.runOptimize();
+                    checkFilter(and_filter, and_values);
+                    ASSERT_EQ(and_filter, buildFilter(and_values, true));
+
+                    auto or_filter = buildFilter(values1, optimize1);
+                    or_filter.logicalOr(filter2);
+                    std::vector<UInt8> or_values(size);
+                    for (UInt32 i = 0; i < size; ++i)
+                        or_values[i] = values1[i] || values2[i];
+                    checkFilter(or_filter, or_values);
+
+                    auto append_filter = buildFilter(values1, optimize1);
+                    append_filter.append(filter2);
+                    auto append_values = values1;
+                    append_values.insert(append_values.end(), values2.begin(), values2.end());
+                    checkFilter(append_filter, append_values);
+
+                    // Modify after compressed
+                    append_filter[0] = 0;
+                    append_values[0] = 0;
+                    ASSERT_FALSE(append_filter.isCompressed());
+                    checkFilter(append_filter, append_values);
+                }
+            }
+        }
+    }
+}
+
+TEST(BitmapFilterTest, View)
+{
+    auto filter = std::make_shared<BitmapFilter>(1000, true);
+    (*filter)[10] = 0;
+    (*filter)[500] = 0;
+    filter->runOptimize();
+    ASSERT_TRUE(filter->isCompressed());
+
+    BitmapFilterView view(filter, 5, 100);
+    ASSERT_FALSE(view.get(5));
+    ASSERT_TRUE(view.get(4));
+    auto raw = view.getRawSubFilter(3, 4);
+    ASSERT_EQ(raw, IColumn::Filter({1, 1, 0, 1}));
+}
+} // namespace DB::DM::tests
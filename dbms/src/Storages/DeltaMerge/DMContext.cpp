@@ -67,6 +67,8 @@ DMContext::DMContext(
     , read_stable_only(settings.dt_read_stable_only)
     , enable_relevant_place(settings.dt_enable_relevant_place)
     , enable_skippable_place(settings.dt_enable_skippable_place)
+    , mvcc_bitmap_cache_entries(settings.dt_mvcc_bitmap_cache_entries)
+    , version_chain_replay_after_flush(settings.dt_version_chain_replay_after_flush)
     , tracing_id(tracing_id_)
     , scan_context(scan_context_ ? scan_context_ : std::make_shared<ScanContext>())
 {}
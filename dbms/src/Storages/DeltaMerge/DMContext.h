@@ -99,11 +99,18 @@ struct DMContext : private boost::noncopyable
     const bool read_stable_only;
     const bool enable_relevant_place;
     const bool enable_skippable_place;
+    // The max number of MVCC bitmaps cached in each segment, 0 means disable.
+    const size_t mvcc_bitmap_cache_entries;
+    // Whether to replay the flushed data into version chain by background tasks right after flush.
+    const bool version_chain_replay_after_flush;
 
     String tracing_id;
 
     const ScanContextPtr scan_context;
 
+    // The columns to build the equality bloom index when writing DTFiles, derived from the table schema.
+    std::unordered_set<ColId> equality_bloom_index_columns;
+
 public:
     static DMContextPtr create(
         const Context & session_context_,
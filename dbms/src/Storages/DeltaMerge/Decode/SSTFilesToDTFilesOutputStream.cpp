@@ -23,6 +23,7 @@
 #include <Storages/DeltaMerge/DeltaMergeStore.h>
 #include <Storages/DeltaMerge/File/DMFile.h>
 #include <Storages/DeltaMerge/File/DMFileBlockOutputStream.h>
+#include <Storages/DeltaMerge/Index/LocalIndexInfo.h>
 #include <Storages/DeltaMerge/Remote/DataStore/DataStore.h>
 #include <Storages/KVStore/Decode/PartitionStreams.h>
 #include <Storages/KVStore/FFI/ProxyFFI.h>
@@ -189,7 +190,11 @@ bool SSTFilesToDTFilesOutputStream<ChildStream>::newDTFileStream()
         context.getGlobalContext().getSettingsRef().dt_small_file_size_threshold,
         context.getGlobalContext().getSettingsRef().dt_merged_file_max_size,
         storage->getKeyspaceID());
-    dt_stream = std::make_unique<DMFileBlockOutputStream>(context, dt_file, *(schema_snap->column_defines));
+    dt_stream = std::make_unique<DMFileBlockOutputStream>(
+        context,
+        dt_file,
+        *(schema_snap->column_defines),
+        getEqualityBloomIndexColumns(storage->getTableInfo()));
     dt_stream->writePrefix();
     ingest_files.emplace_back(dt_file);
     ingest_files_range.emplace_back(std::nullopt);
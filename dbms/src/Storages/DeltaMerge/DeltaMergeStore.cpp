@@ -275,6 +275,7 @@ DeltaMergeStore::DeltaMergeStore(
     , blockable_background_pool(db_context.getBlockableBackgroundPool())
     , next_gc_check_key(is_common_handle ? RowKeyValue::COMMON_HANDLE_MIN_KEY : RowKeyValue::INT_HANDLE_MIN_KEY)
     , local_index_infos(std::move(local_index_infos_))
+    , equality_bloom_index_columns(settings_.equality_bloom_index_columns)
     , log(Logger::get(fmt::format("keyspace={} table_id={}", keyspace_id_, physical_table_id_)))
 {
     {
@@ -550,7 +551,7 @@ DMContextPtr DeltaMergeStore::newDMContext(
     // Here we use global context from db_context, instead of db_context directly.
     // Because db_context could be a temporary object and won't last long enough during the query process.
     // Like the context created by InterpreterSelectWithUnionQuery.
-    return DMContext::create(
+    auto dm_context = DMContext::create(
         db_context,
         path_pool,
         storage_pool,
@@ -563,6 +564,11 @@ DMContextPtr DeltaMergeStore::newDMContext(
         db_settings,
         scan_context_,
         tracing_id);
+    {
+        std::shared_lock index_read_lock(mtx_local_index_infos);
+        dm_context->equality_bloom_index_columns = equality_bloom_index_columns;
+    }
+    return dm_context;
 }
 
 inline Block getSubBlock(const Block & block, size_t offset, size_t limit)
@@ -895,6 +901,7 @@ bool DeltaMergeStore::flushCache(const DMContextPtr & dm_context, const RowKeyRa
             {
                 // After flush, try to add delta local index.
                 segmentEnsureDeltaLocalIndexAsync(segment);
+                segmentReplayVersionChainAsync(dm_context, segment, ThreadType::Write);
                 break;
             }
             else if (!try_until_succeed)
@@ -1487,7 +1494,9 @@ void DeltaMergeStore::read(
                 extra_table_id_index,
                 log_tracing_id,
                 runtime_filter_list,
-                rf_max_wait_time_ms));
+                rf_max_wait_time_ms,
+                /*is_disagg_*/ false,
+                dm_context->scan_context));
         }
     }
     else
@@ -1741,23 +1750,7 @@ bool DeltaMergeStore::checkSegmentUpdate(
     });
 
     auto try_add_background_task = [&](const BackgroundTask & task) {
-        if (shutdown_called.load(std::memory_order_relaxed))
-            return;
-
-        size_t max_task_num = 0;
-        {
-            std::shared_lock lock(read_write_mutex); // protect `id_to_segment`
-            max_task_num = std::max(id_to_segment.size() * 2, background_pool.getNumberOfThreads() * 3);
-        }
-
-        auto [added, heavy] = background_tasks.tryAddTask(task, thread_type, max_task_num, log);
-        // Prevent too many tasks.
-        if (!added)
-            return;
-        if (heavy)
-            blockable_background_pool_handle->wake();
-        else
-            background_task_handle->wake();
+        tryAddBackgroundTask(task, thread_type);
     };
 
     /// Note a bg flush task may still be added even when we have a fg flush here.
@@ -1791,6 +1784,7 @@ bool DeltaMergeStore::checkSegmentUpdate(
             segment->flushCache(*dm_context);
             // After flush, try to add delta local index.
             segmentEnsureDeltaLocalIndexAsync(segment);
+            segmentReplayVersionChainAsync(dm_context, segment, thread_type);
             if (input_type == InputType::RaftLog)
             {
                 // Only the segment update is from a raft log write, will we notify KVStore to trigger a foreground flush.
@@ -1897,6 +1891,8 @@ bool DeltaMergeStore::checkSegmentUpdate(
         return false;
     };
     auto try_place_delta_index = [&]() {
+        if (dm_context->isVersionChainEnabled() && dm_context->version_chain_replay_after_flush)
+            return segmentReplayVersionChainAsync(dm_context, segment, thread_type);
         if (should_place_delta_index)
         {
             delta_last_try_place_delta_index_rows = delta_rows;
@@ -1954,6 +1950,58 @@ bool DeltaMergeStore::checkSegmentUpdate(
     // The segment does not need any updates for now.
 }
 
+bool DeltaMergeStore::tryAddBackgroundTask(const BackgroundTask & task, ThreadType thread_type)
+{
+    if (shutdown_called.load(std::memory_order_relaxed))
+        return false;
+
+    size_t max_task_num = 0;
+    {
+        std::shared_lock lock(read_write_mutex); // protect `id_to_segment`
+        max_task_num = std::max(id_to_segment.size() * 2, background_pool.getNumberOfThreads() * 3);
+    }
+
+    auto [added, heavy] = background_tasks.tryAddTask(task, thread_type, max_task_num, log);
+    // Prevent too many tasks.
+    if (!added)
+        return false;
+    if (heavy)
+        blockable_background_pool_handle->wake();
+    else
+        background_task_handle->wake();
+    return true;
+}
+
+bool DeltaMergeStore::segmentReplayVersionChainAsync(
+    const DMContextPtr & dm_context,
+    const SegmentPtr & segment,
+    ThreadType thread_type)
+{
+    if (!dm_context->isVersionChainEnabled() || !dm_context->version_chain_replay_after_flush)
+        return false;
+
+    // The data in memory is replayed together with the flushed data, but only the flushed data
+    // triggers the replaying. So the background tasks are added at most once per flush.
+    const auto & delta = segment->getDelta();
+    const size_t flushed_rows_and_deletes = delta->getRows(/* use_unsaved */ false) + delta->getDeletes();
+    auto & delta_last_try_replay_rows = delta->getLastTryPlaceDeltaIndexRows();
+    size_t last_try_replay_rows = delta_last_try_replay_rows.load();
+    if (flushed_rows_and_deletes <= getVersionChainReplayedRowsAndDeletes(*segment->getVersionChain())
+        || flushed_rows_and_deletes <= last_try_replay_rows)
+        return false;
+
+    // Claim the flushed data before adding the task, so that concurrent flushes don't add duplicated tasks.
+    if (!delta_last_try_replay_rows.compare_exchange_strong(last_try_replay_rows, flushed_rows_and_deletes))
+        return false;
+    if (tryAddBackgroundTask(BackgroundTask{TaskType::PlaceIndex, dm_context, segment}, thread_type))
+        return true;
+
+    // The task is not added, e.g. there are too many background tasks. Give it back so that it can be retried.
+    size_t expected = flushed_rows_and_deletes;
+    delta_last_try_replay_rows.compare_exchange_strong(expected, last_try_replay_rows);
+    return false;
+}
+
 void DeltaMergeStore::check(const Context & /*db_context*/)
 {
     std::shared_lock lock(read_write_mutex);
@@ -2101,6 +2149,12 @@ void DeltaMergeStore::applySchemaChanges(TiDB::TableInfo & table_info)
 
 void DeltaMergeStore::applyLocalIndexChange(const TiDB::TableInfo & new_table_info)
 {
+    {
+        auto new_equality_bloom_index_columns = getEqualityBloomIndexColumns(new_table_info);
+        std::unique_lock index_write_lock(mtx_local_index_infos);
+        equality_bloom_index_columns.swap(new_equality_bloom_index_columns);
+    }
+
     // Get a snapshot on the local_index_infos to check whether any new index is created
     auto changeset = generateLocalIndexInfos(getLocalIndexInfosSnapshot(), new_table_info, log);
 
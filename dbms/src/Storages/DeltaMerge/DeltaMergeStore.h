@@ -114,6 +114,8 @@ public:
     struct Settings
     {
         NotCompress not_compress_columns;
+        // The columns to build the equality bloom index, see `getEqualityBloomIndexColumns`.
+        std::unordered_set<ColId> equality_bloom_index_columns;
     };
     static Settings EMPTY_SETTINGS;
 
@@ -506,6 +508,7 @@ public:
 
     StoreStats getStoreStats();
     SegmentsStats getSegmentsStats();
+    ColumnStatistics getColumnStatistics(ColId col_id);
 
     LocalIndexesStats getLocalIndexStats();
     // Generate local index stats for non inited DeltaMergeStore
@@ -812,6 +815,22 @@ private:
         ThreadType thread_type,
         InputType input_type);
 
+    /**
+     * Try to add a background task, it is ignored if the store is shutting down or there are too many tasks.
+     * Returns whether the task is added.
+     */
+    bool tryAddBackgroundTask(const BackgroundTask & task, ThreadType thread_type);
+
+    /**
+     * Replay the flushed data of the segment into its version chain by a background task,
+     * so that the following queries don't need to replay them.
+     * Returns whether a task is added.
+     */
+    bool segmentReplayVersionChainAsync(
+        const DMContextPtr & dm_context,
+        const SegmentPtr & segment,
+        ThreadType thread_type);
+
     /**
      * Segment update meta with new DMFiles. A lock must be provided, so that it is
      * possible to update the meta for multiple segments all at once.
@@ -939,6 +958,8 @@ public:
     // Compares to the lightweight RoughSet Indexes, these indexes require lot
     // of resources to build, so they will be built in separated background pool.
     LocalIndexInfosPtr local_index_infos;
+    // The equality bloom index is built together with the DTFiles, so it only applies to the newly written DTFiles.
+    std::unordered_set<ColId> equality_bloom_index_columns;
     mutable std::shared_mutex mtx_local_index_infos;
 
     struct DMFileIDToSegmentIDs
@@ -963,6 +984,16 @@ public:
     // Synchronize between write threads and read threads.
     mutable std::shared_mutex read_write_mutex;
 
+    // The merged column statistics and the sorted ids of the stable DMFiles they are merged from.
+    // The DMFiles are immutable, so the cached statistics are valid until the stable DMFiles change.
+    struct CachedColumnStatistics
+    {
+        std::vector<UInt64> file_ids;
+        std::shared_ptr<const RSIndexNumber> stats;
+    };
+    std::mutex mtx_column_statistics;
+    std::unordered_map<ColId, CachedColumnStatistics> column_statistics_cache;
+
     LoggerPtr log;
 };
 
@@ -14,12 +14,15 @@
 
 #include <Storages/DeltaMerge/DeltaMergeStore.h>
 #include <Storages/DeltaMerge/DeltaMergeStore_Statistics.h>
+#include <Storages/DeltaMerge/File/DMFilePackFilter.h>
 #include <Storages/DeltaMerge/Index/LocalIndexInfo.h>
 #include <Storages/DeltaMerge/Segment.h>
 #include <Storages/DeltaMerge/StoragePool/StoragePool.h>
 #include <Storages/Page/PageStorage.h>
 #include <tipb/executor.pb.h>
 
+#include <algorithm>
+
 namespace DB::DM
 {
 
@@ -204,6 +207,77 @@ SegmentsStats DeltaMergeStore::getSegmentsStats()
     return stats;
 }
 
+ColumnStatistics DeltaMergeStore::getColumnStatistics(ColId col_id)
+{
+    ColumnStatistics column_stats;
+    column_stats.column_id = col_id;
+
+    if (shutdown_called.load(std::memory_order_relaxed))
+        return column_stats;
+
+    DMFiles dmfiles;
+    std::vector<UInt64> file_ids;
+    {
+        std::shared_lock lock(read_write_mutex);
+        std::unordered_set<UInt64> file_id_set;
+        for (const auto & [handle, segment] : segments)
+        {
+            UNUSED(handle);
+            column_stats.total_rows += segment->getDelta()->getRows() + segment->getStable()->getRows();
+            // The DMFiles may be shared by the segments after logical split, count them only once.
+            for (const auto & dmfile : segment->getStable()->getDMFiles())
+            {
+                if (file_id_set.insert(dmfile->fileId()).second)
+                {
+                    dmfiles.push_back(dmfile);
+                    file_ids.push_back(dmfile->fileId());
+                }
+            }
+        }
+    }
+    std::sort(file_ids.begin(), file_ids.end());
+
+    {
+        std::lock_guard lock(mtx_column_statistics);
+        if (auto iter = column_statistics_cache.find(col_id);
+            iter != column_statistics_cache.end() && iter->second.file_ids == file_ids)
+        {
+            column_stats.stats = iter->second.stats;
+            if (column_stats.stats)
+                column_stats.stats_rows = column_stats.stats->rows();
+            return column_stats;
+        }
+    }
+
+    // Load the statistics without holding the lock, because it may read from disk or S3.
+    const auto file_provider = global_context.getFileProvider();
+    const auto read_limiter = global_context.getReadLimiter();
+    RSIndexNumberPtr merged_stats;
+    for (const auto & dmfile : dmfiles)
+    {
+        auto stats = DMFilePackFilter::loadColumnStatistics(*dmfile, file_provider, col_id, read_limiter, nullptr);
+        if (!stats)
+            continue;
+        if (!merged_stats)
+            merged_stats = stats;
+        else
+            merged_stats->merge(*stats);
+    }
+
+    column_stats.stats = merged_stats;
+    if (column_stats.stats)
+        column_stats.stats_rows = column_stats.stats->rows();
+
+    {
+        std::lock_guard lock(mtx_column_statistics);
+        column_statistics_cache[col_id] = CachedColumnStatistics{
+            .file_ids = std::move(file_ids),
+            .stats = column_stats.stats,
+        };
+    }
+    return column_stats;
+}
+
 std::optional<LocalIndexesStats> DeltaMergeStore::genLocalIndexStatsByTableInfo(const TiDB::TableInfo & table_info)
 {
     auto local_index_infos = DM::initLocalIndexInfos(table_info, Logger::get());
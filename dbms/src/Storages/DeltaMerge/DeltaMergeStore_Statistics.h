@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <Storages/DeltaMerge/Index/Histogram.h>
 #include <Storages/DeltaMerge/RowKeyRange.h>
 #include <common/types.h>
 
@@ -120,4 +121,22 @@ struct StoreStats
 
     UInt64 background_tasks_length = 0;
 };
+
+/// The statistics of a column, merged from the statistics of the stable DMFiles.
+/// Used to estimate the cardinality, e.g. choosing the build side of join or pre-sizing the hash table.
+///
+/// Note the rows are physical rows: the deleted rows are excluded, but all the MVCC versions kept in the
+/// stable layer are counted, so `total_rows`, `stats_rows` and the histogram may overestimate the visible
+/// rows when a row has several versions. The NDV is not affected by the versions of the same value.
+struct ColumnStatistics
+{
+    ColId column_id = 0;
+    // The rows of the whole table, including the delta and the DMFiles without statistics.
+    UInt64 total_rows = 0;
+    // The rows covered by `stats`.
+    UInt64 stats_rows = 0;
+    // nullptr if no DMFile has the statistics of the column.
+    // It is shared with the cache of the store, so it is read-only.
+    std::shared_ptr<const RSIndexNumber> stats;
+};
 } // namespace DB::DM
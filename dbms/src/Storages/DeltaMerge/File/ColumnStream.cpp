@@ -306,6 +306,7 @@ ColumnReadStream::ColumnReadStream(
     size_t packs = reader.dmfile->getPacks();
     if (packs == 0)
         return;
+    total_packs = packs;
 
     auto data_guard = S3::S3RandomAccessFile::setReadFileInfo({
         .size = reader.dmfile->getReadFileSize(col_id, colDataFileName(file_name_base)),
@@ -316,6 +317,9 @@ ColumnReadStream::ColumnReadStream(
     if (likely(reader.dmfile->useMetaV2()))
     {
         buf = buildColDataReadBuffByMetaV2(reader, col_id, file_name_base, read_limiter);
+        const auto * dmfile_meta = typeid_cast<const DMFileMetaV2 *>(reader.dmfile->meta.get());
+        if (!dmfile_meta->merged_sub_file_infos.contains(colDataFileName(file_name_base)))
+            initPackReads(reader, col_id, file_name_base, read_limiter);
     }
     else if (unlikely(!reader.dmfile->getConfiguration())) // checksum not enabled
     {
@@ -331,7 +335,130 @@ ColumnReadStream::ColumnReadStream(
     else
     {
         buf = buildColDataReadBuffWitChecksum(reader, col_id, file_name_base, read_limiter);
+        initPackReads(reader, col_id, file_name_base, read_limiter);
+    }
+}
+
+void ColumnReadStream::initPackReads(
+    DMFileReader & reader,
+    ColId col_id,
+    const String & file_name_base,
+    const ReadLimiterPtr & read_limiter)
+{
+    const auto & config = reader.dmfile->getConfiguration();
+    assert(config);
+    data_file_path = reader.dmfile->colDataPath(file_name_base);
+    // The file sizes of substreams are not distinguished in the column stats before metav2, so get it from disk
+    data_file_bytes = reader.dmfile->useMetaV2()
+        ? reader.dmfile->getReadFileSize(col_id, colDataFileName(file_name_base))
+        : reader.dmfile->colDataSizeByName(file_name_base);
+    data_file = reader.file_provider->newRandomAccessFile(
+        data_file_path,
+        reader.dmfile->encryptionDataPath(file_name_base),
+        read_limiter);
+    checksum_algo = config->getChecksumAlgorithm();
+    checksum_frame_length = config->getChecksumFrameLength();
+    checksum_frame_stride = config->getChecksumHeaderLength() + checksum_frame_length;
+}
+
+bool ColumnReadStream::submitPackReads(size_t start_pack_id, size_t pack_count)
+{
+    read_since_last_submit = false;
+    if (!data_file || pack_count == 0 || start_pack_id + pack_count > total_packs)
+        return false;
+    if (pending_reads && pending_reads->start_pack_id == start_pack_id && pending_reads->pack_count == pack_count)
+        return true;
+
+    // If the end of the packs is inside a compressed block, we will need to read the block too.
+    size_t end = start_pack_id + pack_count;
+    if (end < total_packs && getOffsetInDecompressedBlock(end) > 0)
+    {
+        const size_t last_offset_in_file = getOffsetInFile(end);
+        while (end < total_packs && getOffsetInFile(end) == last_offset_in_file)
+            ++end;
     }
+
+    // The offsets in marks exclude the checksum headers, map them to the frames in the data file.
+    const size_t begin_frame = getOffsetInFile(start_pack_id) / checksum_frame_length;
+    const size_t end_frame = (end == total_packs)
+        ? (data_file_bytes + checksum_frame_stride - 1) / checksum_frame_stride
+        : (getOffsetInFile(end) + checksum_frame_length - 1) / checksum_frame_length;
+    if (end_frame <= begin_frame || (end_frame - begin_frame) * checksum_frame_stride > MAX_PACK_READS_BYTES)
+        return false;
+
+    auto reads = std::make_unique<PackReads>();
+    reads->start_pack_id = start_pack_id;
+    reads->pack_count = pack_count;
+    reads->begin_frame = begin_frame;
+    reads->data.resize((end_frame - begin_frame) * checksum_frame_stride);
+    // One request for each pack. The frame shared by the adjacent packs is read by the latter one.
+    size_t frame = begin_frame;
+    for (size_t pack_id = start_pack_id + 1; pack_id <= end; ++pack_id)
+    {
+        const size_t next_frame
+            = (pack_id == end) ? end_frame : std::min(getOffsetInFile(pack_id) / checksum_frame_length, end_frame);
+        if (next_frame <= frame)
+            continue;
+        reads->requests.push_back(ReadRequest{
+            .buf = reads->data.data() + (frame - begin_frame) * checksum_frame_stride,
+            .size = (next_frame - frame) * checksum_frame_stride,
+            .offset = static_cast<off_t>(frame * checksum_frame_stride),
+        });
+        frame = next_frame;
+    }
+    reads->handle = data_file->submitReads(reads->requests);
+    pending_reads = std::move(reads);
+    return true;
+}
+
+CompressedSeekableReaderBuffer * ColumnReadStream::seekToPacks(size_t start_pack_id, size_t pack_count)
+{
+    if (!pending_reads || pending_reads->start_pack_id != start_pack_id || pending_reads->pack_count != pack_count)
+    {
+        // Not read ahead, or read ahead for other packs
+        pending_reads.reset();
+        submitPackReads(start_pack_id, pack_count);
+    }
+    read_since_last_submit = true;
+
+    const size_t offset_in_file = getOffsetInFile(start_pack_id);
+    const size_t offset_in_decompressed_block = getOffsetInDecompressedBlock(start_pack_id);
+    if (!pending_reads)
+    {
+        buf->seek(offset_in_file, offset_in_decompressed_block);
+        return buf.get();
+    }
+
+    auto reads = std::move(pending_reads);
+    reads->handle->wait();
+    pack_reads_buf = buildPackReadsBuffer(*reads);
+    pack_reads_buf->seek(offset_in_file - reads->begin_frame * checksum_frame_length, offset_in_decompressed_block);
+    return pack_reads_buf.get();
+}
+
+std::unique_ptr<CompressedSeekableReaderBuffer> ColumnReadStream::buildPackReadsBuffer(PackReads & reads) const
+{
+    size_t data_size = 0;
+    for (size_t i = 0; i < reads.requests.size(); ++i)
+    {
+        const auto & req = reads.requests[i];
+        // Only the last request could reach the end of file
+        RUNTIME_CHECK_MSG(
+            req.result >= 0 && (static_cast<size_t>(req.result) == req.size || i + 1 == reads.requests.size()),
+            "Failed to read packs in batch, file={} offset={} size={} result={}",
+            data_file_path,
+            req.offset,
+            req.size,
+            req.result);
+        data_size = req.buf - reads.data.data() + req.result;
+    }
+    reads.data.resize(data_size);
+    // The data begins with the frame `begin_frame`, the offsets in it are shifted by the caller
+    return CompressedReadBufferFromFileBuilder::build(
+        std::move(reads.data),
+        data_file_path,
+        checksum_algo,
+        checksum_frame_length);
 }
 
 } // namespace DB::DM
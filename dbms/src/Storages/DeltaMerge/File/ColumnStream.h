@@ -14,7 +14,9 @@
 
 #pragma once
 
+#include <Common/Checksum.h>
 #include <DataStreams/MarkInCompressedFile.h>
+#include <IO/BaseFile/RandomAccessFile.h>
 #include <IO/FileProvider/CompressedReadBufferFromFileBuilder.h>
 #include <Storages/DeltaMerge/DeltaMergeDefines.h>
 #include <common/types.h>
@@ -24,6 +26,11 @@
 
 namespace DB::DM
 {
+namespace tests
+{
+class DMFileMetaV2Test;
+} // namespace tests
+
 class DMFileReader;
 
 // The stream for reading one column data or its substream (nullmap/size0)
@@ -43,11 +50,53 @@ public:
 
     size_t getOffsetInDecompressedBlock(size_t i) const { return (*marks)[i].offset_in_decompressed_block; }
 
+    // Submit the reads of packs [start_pack_id, start_pack_id + pack_count) as one batch without waiting
+    // for them. The result is consumed by the `seekToPacks` with the same packs.
+    // Return false if the packs can not be read in batch, e.g. the data file is merged into the merged file.
+    bool submitPackReads(size_t start_pack_id, size_t pack_count);
+
+    // Return true if there are no batched reads in flight. It never blocks.
+    bool pollPackReads() const { return !pending_reads || pending_reads->handle->poll(); }
+
+    // Seek to the beginning of `start_pack_id` and return the buffer for reading the packs
+    // [start_pack_id, start_pack_id + pack_count). The packs are read in batch if possible.
+    CompressedSeekableReaderBuffer * seekToPacks(size_t start_pack_id, size_t pack_count);
+
     double avg_size_hint;
     MarksInCompressedFilePtr marks;
     std::unique_ptr<CompressedSeekableReaderBuffer> buf;
 
+    // Whether `seekToPacks` is called since the last `submitPackReads`. Used by `DMFileReader`
+    // to read ahead only the streams which are read from disk.
+    bool read_since_last_submit = false;
+
+    // Do not read the packs in batch if they are too large, they are read by `buf` instead.
+    static constexpr size_t MAX_PACK_READS_BYTES = 16 * 1024 * 1024;
+
 private:
+    friend class tests::DMFileMetaV2Test;
+
+    // The packs read in batch from the data file. The requests and the data must be kept until
+    // the batch is completed, so `handle` is declared last to be destroyed (and wait) first.
+    struct PackReads
+    {
+        size_t start_pack_id = 0;
+        size_t pack_count = 0;
+        // The first checksum frame in `data`
+        size_t begin_frame = 0;
+        String data;
+        ReadRequests requests;
+        AsyncReadHandlePtr handle;
+    };
+
+    void initPackReads(
+        DMFileReader & reader,
+        ColId col_id,
+        const String & file_name_base,
+        const ReadLimiterPtr & read_limiter);
+
+    std::unique_ptr<CompressedSeekableReaderBuffer> buildPackReadsBuffer(PackReads & reads) const;
+
     std::unique_ptr<CompressedSeekableReaderBuffer> buildColDataReadBuffWithoutChecksum(
         DMFileReader & reader,
         ColId col_id,
@@ -66,6 +115,20 @@ private:
         ColId col_id,
         const String & file_name_base,
         const ReadLimiterPtr & read_limiter);
+
+    // Only set if the packs can be read in batch, i.e. the data file is checksummed and not merged
+    RandomAccessFilePtr data_file;
+    String data_file_path;
+    size_t data_file_bytes = 0;
+    size_t total_packs = 0;
+    ChecksumAlgo checksum_algo = ChecksumAlgo::None;
+    size_t checksum_frame_length = 0;
+    // The size of the checksum header and the data of one frame in the data file
+    size_t checksum_frame_stride = 0;
+
+    std::unique_ptr<PackReads> pending_reads;
+    // The buffer of the packs read in batch by the last `seekToPacks`
+    std::unique_ptr<CompressedSeekableReaderBuffer> pack_reads_buf;
 };
 using ColumnReadStreamPtr = std::unique_ptr<ColumnReadStream>;
 // stream_name/substream_name -> stream_ptr
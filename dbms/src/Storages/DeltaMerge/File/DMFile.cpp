@@ -197,6 +197,16 @@ String DMFile::colMarkCacheKey(const FileNameBase & file_name_base) const
     return colMarkPath(file_name_base);
 }
 
+String DMFile::colNgramBloomCacheKey(const FileNameBase & file_name_base) const
+{
+    return subFilePath(colNgramBloomFileName(file_name_base));
+}
+
+String DMFile::colEqualityBloomCacheKey(const FileNameBase & file_name_base) const
+{
+    return subFilePath(colEqualityBloomFileName(file_name_base));
+}
+
 bool DMFile::isColIndexExist(const ColId & col_id) const
 {
     if (useMetaV2())
@@ -210,6 +220,31 @@ bool DMFile::isColIndexExist(const ColId & col_id) const
     }
 }
 
+bool DMFile::isMergedSubFileExist(const String & fname) const
+{
+    // The bloom filter indexes and the statistics are only written into the merged file of metav2
+    if (!useMetaV2())
+        return false;
+    const auto * dmfile_meta = typeid_cast<const DMFileMetaV2 *>(meta.get());
+    assert(dmfile_meta != nullptr);
+    return dmfile_meta->merged_sub_file_infos.contains(fname);
+}
+
+bool DMFile::isColNgramBloomExist(const ColId & col_id) const
+{
+    return isMergedSubFileExist(colNgramBloomFileName(getFileNameBase(col_id)));
+}
+
+bool DMFile::isColEqualityBloomExist(const ColId & col_id) const
+{
+    return isMergedSubFileExist(colEqualityBloomFileName(getFileNameBase(col_id)));
+}
+
+bool DMFile::isColStatisticsExist(const ColId & col_id) const
+{
+    return isMergedSubFileExist(colStatisticsFileName(getFileNameBase(col_id)));
+}
+
 size_t DMFile::colIndexSize(ColId id) const
 {
     if (useMetaV2())
@@ -485,6 +520,35 @@ std::vector<String> DMFile::listFilesForUpload() const
     return fnames;
 }
 
+std::vector<std::pair<String, UInt64>> DMFile::listColumnFiles(ColId col_id) const
+{
+    std::vector<std::pair<String, UInt64>> files;
+    if (!isColumnExist(col_id))
+        return files;
+
+    const auto * dmfile_meta = useMetaV2() ? typeid_cast<const DMFileMetaV2 *>(meta.get()) : nullptr;
+    auto add_file = [&](const String & fname) {
+        auto size = getReadFileSize(col_id, fname);
+        if (dmfile_meta != nullptr)
+        {
+            if (auto itr = dmfile_meta->merged_sub_file_infos.find(fname);
+                itr != dmfile_meta->merged_sub_file_infos.end())
+            {
+                files.emplace_back(dmfile_meta->mergedPath(itr->second.number), size);
+                return;
+            }
+        }
+        files.emplace_back(subFilePath(fname), size);
+    };
+    auto callback = [&](const IDataType::SubstreamPath & substream) {
+        const auto file_name_base = getFileNameBase(col_id, substream);
+        add_file(colDataFileName(file_name_base));
+        add_file(colMarkFileName(file_name_base));
+    };
+    getColumnStat(col_id).type->enumerateStreams(callback, {});
+    return files;
+}
+
 void DMFile::switchToRemote(const S3::DMFileOID & oid) const
 {
     RUNTIME_CHECK(useMetaV2());
@@ -206,6 +206,10 @@ public:
     bool useMetaV2() const { return meta->format_version == DMFileFormat::V3; }
 
     std::vector<String> listFilesForUpload() const;
+    /// Return the path and size of the files that store the data and marks of column `col_id`.
+    /// Note that small sub files are merged for DMFile with meta v2, so the same merged file may
+    /// be returned for different columns.
+    std::vector<std::pair<String, UInt64>> listColumnFiles(ColId col_id) const;
     void switchToRemote(const S3::DMFileOID & oid) const;
 
     UInt32 metaVersion() const { return meta->metaVersion(); }
@@ -214,6 +218,9 @@ public:
     const DMFileMetaPtr & getMeta() const { return meta; }
 
     bool isColIndexExist(const ColId & col_id) const;
+    bool isColNgramBloomExist(const ColId & col_id) const;
+    bool isColEqualityBloomExist(const ColId & col_id) const;
+    bool isColStatisticsExist(const ColId & col_id) const;
 
 private:
     DMFile(
@@ -297,6 +304,10 @@ private:
 
     String colIndexCacheKey(const FileNameBase & file_name_base) const;
     String colMarkCacheKey(const FileNameBase & file_name_base) const;
+    String colNgramBloomCacheKey(const FileNameBase & file_name_base) const;
+    String colEqualityBloomCacheKey(const FileNameBase & file_name_base) const;
+
+    bool isMergedSubFileExist(const String & fname) const;
 
     String encryptionBasePath() const;
     EncryptionPath encryptionDataPath(const FileNameBase & file_name_base) const;
@@ -66,6 +66,9 @@ public:
 
     Block read() override { return reader.read(); }
 
+    // Return true if the packs read ahead for the next `read` are ready.
+    bool pollReadAhead() const { return reader.pollReadAhead(); }
+
     Block readWithFilter(const IColumn::Filter & filter) override { return reader.readWithFilter(filter); }
 
 private:
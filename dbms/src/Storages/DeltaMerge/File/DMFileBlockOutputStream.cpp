@@ -20,7 +20,8 @@ namespace DB::DM
 DMFileBlockOutputStream::DMFileBlockOutputStream(
     const Context & context,
     const DMFilePtr & dmfile,
-    const ColumnDefines & write_columns)
+    const ColumnDefines & write_columns,
+    const std::unordered_set<ColId> & equality_bloom_index_columns)
     : writer(
         dmfile,
         write_columns,
@@ -31,7 +32,11 @@ DMFileBlockOutputStream::DMFileBlockOutputStream(
                 context.getSettingsRef().dt_compression_method,
                 context.getSettingsRef().dt_compression_level),
             context.getSettingsRef().min_compress_block_size,
-            context.getSettingsRef().max_compress_block_size})
+            context.getSettingsRef().max_compress_block_size,
+            context.getSettingsRef().dt_enable_ngram_bloom_index,
+            context.getSettingsRef().dt_enable_equality_bloom_index ? equality_bloom_index_columns
+                                                                    : std::unordered_set<ColId>{},
+            context.getSettingsRef().dt_enable_column_statistics})
 {}
 
 } // namespace DB::DM
\ No newline at end of file
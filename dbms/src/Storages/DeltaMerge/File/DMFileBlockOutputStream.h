@@ -32,7 +32,13 @@ namespace DM
 class DMFileBlockOutputStream
 {
 public:
-    DMFileBlockOutputStream(const Context & context, const DMFilePtr & dmfile, const ColumnDefines & write_columns);
+    /// The equality bloom index is built for `equality_bloom_index_columns` if `dt_enable_equality_bloom_index`
+    /// is enabled, see `getEqualityBloomIndexColumns`.
+    DMFileBlockOutputStream(
+        const Context & context,
+        const DMFilePtr & dmfile,
+        const ColumnDefines & write_columns,
+        const std::unordered_set<ColId> & equality_bloom_index_columns = {});
 
     DMFilePtr getFile() const { return writer.getFile(); }
 
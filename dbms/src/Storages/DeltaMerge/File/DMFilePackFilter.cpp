@@ -129,9 +129,12 @@ DMFilePackFilterResultPtr DMFilePackFilter::load()
         // Load index based on filter.
         ColIds ids = filter->getColumnIDs();
         for (const auto & id : ids)
-        {
             tryLoadIndex(result.param, id);
-        }
+        // The bloom indexes are only used by some operators, skip loading them for other operators.
+        for (const auto & id : filter->getNgramBloomColumnIDs())
+            tryLoadNgramBloomIndex(result.param, id);
+        for (const auto & id : filter->getEqualityBloomColumnIDs())
+            tryLoadEqualityBloomIndex(result.param, id);
 
         const auto check_results = filter->roughCheck(0, pack_count, result.param);
         std::transform(
@@ -377,6 +380,128 @@ void DMFilePackFilter::tryLoadIndex(RSCheckParam & param, ColId col_id)
     loadIndex(param.indexes, dmfile, file_provider, index_cache, set_cache_if_miss, col_id, read_limiter, scan_context);
 }
 
+template <typename Index>
+std::shared_ptr<Index> DMFilePackFilter::loadMergedIndex(
+    const DMFile & dmfile,
+    const FileProviderPtr & file_provider,
+    ColId col_id,
+    const String & fname,
+    const ReadLimiterPtr & read_limiter,
+    const ScanContextPtr & scan_context)
+{
+    const auto * dmfile_meta = typeid_cast<const DMFileMetaV2 *>(dmfile.meta.get());
+    assert(dmfile_meta != nullptr);
+    auto info_iter = dmfile_meta->merged_sub_file_infos.find(fname);
+    RUNTIME_CHECK_MSG(
+        info_iter != dmfile_meta->merged_sub_file_infos.end(),
+        "Unknown merged index file, dmfile_path={} fname={}",
+        dmfile.parentPath(),
+        fname);
+
+    const auto & merged_file_info = info_iter->second;
+    const auto file_path = dmfile.meta->mergedPath(merged_file_info.number);
+    const auto offset = merged_file_info.offset;
+    const auto data_size = merged_file_info.size;
+
+    auto index_guard = S3::S3RandomAccessFile::setReadFileInfo({
+        .size = dmfile.getReadFileSize(col_id, fname),
+        .scan_context = scan_context,
+    });
+
+    // Same as the min-max index in metav2, read the raw data (contains the checksum header) from the merged file.
+    auto buffer = ReadBufferFromRandomAccessFileBuilder::build(
+        file_provider,
+        file_path,
+        dmfile_meta->encryptionMergedPath(merged_file_info.number),
+        std::min(data_size, dmfile.getConfiguration()->getChecksumFrameLength()),
+        read_limiter);
+    auto ret = buffer.seek(offset);
+    RUNTIME_CHECK_MSG(ret >= 0, "Failed to seek in merged file, ret={} file_path={} offset={}", ret, file_path, offset);
+
+    String raw_data(data_size, '\0');
+    buffer.read(reinterpret_cast<char *>(raw_data.data()), data_size);
+
+    auto buf = ChecksumReadBufferBuilder::build(
+        std::move(raw_data),
+        file_path,
+        dmfile.getConfiguration()->getChecksumAlgorithm(),
+        dmfile.getConfiguration()->getChecksumFrameLength());
+
+    auto header_size = dmfile.getConfiguration()->getChecksumHeaderLength();
+    auto frame_total_size = dmfile.getConfiguration()->getChecksumFrameLength() + header_size;
+    auto frame_count = data_size / frame_total_size + (data_size % frame_total_size != 0);
+    return Index::read(*buf, data_size - header_size * frame_count);
+}
+
+template <typename Index>
+std::shared_ptr<Index> DMFilePackFilter::loadMergedIndexWithCache(
+    const std::shared_ptr<BloomIndexCache<Index>> & cache,
+    ColId col_id,
+    const String & fname,
+    const String & cache_key)
+{
+    auto loader = [&]() {
+        return loadMergedIndex<Index>(*dmfile, file_provider, col_id, fname, read_limiter, scan_context);
+    };
+    if (cache && set_cache_if_miss)
+        return cache->getOrSet(cache_key, loader);
+
+    // try load from the cache first
+    std::shared_ptr<Index> index;
+    if (cache)
+        index = cache->get(cache_key);
+    if (index == nullptr)
+        index = loader();
+    return index;
+}
+
+RSIndexNumberPtr DMFilePackFilter::loadColumnStatistics(
+    const DMFile & dmfile,
+    const FileProviderPtr & file_provider,
+    ColId col_id,
+    const ReadLimiterPtr & read_limiter,
+    const ScanContextPtr & scan_context)
+{
+    if (!dmfile.isColStatisticsExist(col_id))
+        return nullptr;
+    const auto fname = colStatisticsFileName(DMFile::getFileNameBase(col_id));
+    return loadMergedIndex<RSIndexNumber>(dmfile, file_provider, col_id, fname, read_limiter, scan_context);
+}
+
+void DMFilePackFilter::tryLoadNgramBloomIndex(RSCheckParam & param, ColId col_id)
+{
+    if (param.ngram_bloom_indexes.count(col_id))
+        return;
+
+    if (!dmfile->isColNgramBloomExist(col_id))
+        return;
+
+    const auto file_name_base = DMFile::getFileNameBase(col_id);
+    auto index = loadMergedIndexWithCache<NgramBloomIndex>(
+        ngram_bloom_index_cache,
+        col_id,
+        colNgramBloomFileName(file_name_base),
+        dmfile->colNgramBloomCacheKey(file_name_base));
+    param.ngram_bloom_indexes.emplace(col_id, index);
+}
+
+void DMFilePackFilter::tryLoadEqualityBloomIndex(RSCheckParam & param, ColId col_id)
+{
+    if (param.equality_bloom_indexes.count(col_id))
+        return;
+
+    if (!dmfile->isColEqualityBloomExist(col_id))
+        return;
+
+    const auto file_name_base = DMFile::getFileNameBase(col_id);
+    auto index = loadMergedIndexWithCache<EqualityBloomIndex>(
+        equality_bloom_index_cache,
+        col_id,
+        colEqualityBloomFileName(file_name_base),
+        dmfile->colEqualityBloomCacheKey(file_name_base));
+    param.equality_bloom_indexes.emplace(col_id, index);
+}
+
 std::pair<std::vector<DMFilePackFilter::Range>, DMFilePackFilterResults> DMFilePackFilter::getSkippedRangeAndFilter(
     const DMContext & dm_context,
     const DMFiles & dmfiles,
@@ -21,6 +21,7 @@
 #include <Storages/DeltaMerge/File/DMFilePackFilterResult.h>
 #include <Storages/DeltaMerge/File/DMFilePackFilter_fwd.h>
 #include <Storages/DeltaMerge/Filter/RSOperator_fwd.h>
+#include <Storages/DeltaMerge/Index/Histogram.h>
 #include <Storages/DeltaMerge/RowKeyRange.h>
 #include <Storages/DeltaMerge/ScanContext_fwd.h>
 
@@ -65,6 +66,8 @@ public:
         DMFilePackFilter pack_filter(
             dmfile,
             dm_context.global_context.getMinMaxIndexCache(),
+            dm_context.global_context.getNgramBloomIndexCache(),
+            dm_context.global_context.getEqualityBloomIndexCache(),
             set_cache_if_miss,
             rowkey_ranges,
             filter,
@@ -91,6 +94,8 @@ public:
         DMFilePackFilter pack_filter(
             dmfile,
             index_cache_,
+            /*ngram_bloom_index_cache_*/ nullptr,
+            /*equality_bloom_index_cache_*/ nullptr,
             set_cache_if_miss,
             rowkey_ranges,
             filter,
@@ -163,6 +168,8 @@ private:
     DMFilePackFilter(
         const DMFilePtr & dmfile_,
         const MinMaxIndexCachePtr & index_cache_,
+        const NgramBloomIndexCachePtr & ngram_bloom_index_cache_,
+        const EqualityBloomIndexCachePtr & equality_bloom_index_cache_,
         bool set_cache_if_miss_,
         const RowKeyRanges & rowkey_ranges_, // filter by handle range
         const RSOperatorPtr & filter_, // filter by push down where clause
@@ -173,6 +180,8 @@ private:
         const String & tracing_id)
         : dmfile(dmfile_)
         , index_cache(index_cache_)
+        , ngram_bloom_index_cache(ngram_bloom_index_cache_)
+        , equality_bloom_index_cache(equality_bloom_index_cache_)
         , set_cache_if_miss(set_cache_if_miss_)
         , rowkey_ranges(rowkey_ranges_)
         , filter(filter_)
@@ -197,10 +206,38 @@ private:
 
     void tryLoadIndex(RSCheckParam & param, ColId col_id);
 
+    template <typename Index>
+    static std::shared_ptr<Index> loadMergedIndex(
+        const DMFile & dmfile,
+        const FileProviderPtr & file_provider,
+        ColId col_id,
+        const String & fname,
+        const ReadLimiterPtr & read_limiter,
+        const ScanContextPtr & scan_context);
+
+    template <typename Index>
+    std::shared_ptr<Index> loadMergedIndexWithCache(
+        const std::shared_ptr<BloomIndexCache<Index>> & cache,
+        ColId col_id,
+        const String & fname,
+        const String & cache_key);
+
+    static RSIndexNumberPtr loadColumnStatistics(
+        const DMFile & dmfile,
+        const FileProviderPtr & file_provider,
+        ColId col_id,
+        const ReadLimiterPtr & read_limiter,
+        const ScanContextPtr & scan_context);
+
+    void tryLoadNgramBloomIndex(RSCheckParam & param, ColId col_id);
+    void tryLoadEqualityBloomIndex(RSCheckParam & param, ColId col_id);
+
 private:
     DMFilePtr dmfile;
 
     MinMaxIndexCachePtr index_cache;
+    NgramBloomIndexCachePtr ngram_bloom_index_cache;
+    EqualityBloomIndexCachePtr equality_bloom_index_cache;
     bool set_cache_if_miss;
     RowKeyRanges rowkey_ranges;
     RSOperatorPtr filter;
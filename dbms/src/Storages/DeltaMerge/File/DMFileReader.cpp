@@ -237,7 +237,31 @@ Block DMFileReader::read()
 
     const auto read_info = read_block_infos.front();
     read_block_infos.pop_front();
-    return readImpl(read_info);
+    auto block = readImpl(read_info);
+    readAhead();
+    return block;
+}
+
+void DMFileReader::readAhead()
+{
+    if (read_block_infos.empty())
+        return;
+
+    // Only read ahead the streams which are read from disk by the last read, the others are likely
+    // to be read from cache or skipped by clean read.
+    const auto & next_info = read_block_infos.front();
+    for (auto & [stream_name, stream] : column_streams)
+    {
+        if (stream->read_since_last_submit)
+            stream->submitPackReads(next_info.start_pack_id, next_info.pack_count);
+    }
+}
+
+bool DMFileReader::pollReadAhead() const
+{
+    return std::all_of(column_streams.cbegin(), column_streams.cend(), [](const auto & iter) {
+        return iter.second->pollPackReads();
+    });
 }
 
 Block DMFileReader::readImpl(const ReadBlockInfo & read_info)
@@ -526,6 +550,7 @@ ColumnPtr DMFileReader::readFromDisk(
     const ColumnDefine & cd,
     const DataTypePtr & type_on_disk,
     size_t start_pack_id,
+    size_t pack_count,
     size_t read_rows)
 {
     const auto stream_name = DMFile::getFileNameBase(cd.id);
@@ -548,7 +573,8 @@ ColumnPtr DMFileReader::readFromDisk(
             const auto offset_in_decompressed_block = sub_stream->getOffsetInDecompressedBlock(start_pack_id);
             try
             {
-                sub_stream->buf->seek(offset_in_file, offset_in_decompressed_block);
+                // All the packs of the substream are read in one batch
+                return sub_stream->seekToPacks(start_pack_id, pack_count);
             }
             catch (...)
             {
@@ -556,7 +582,7 @@ ColumnPtr DMFileReader::readFromDisk(
                     log,
                     fmt::format(
                         "DMFile substream seek failed, dmfile={} column_id={} type_on_disk={} stream_name={} "
-                        "substream_name={} start_pack_id={} read_rows={} offset_in_file={} "
+                        "substream_name={} start_pack_id={} pack_count={} read_rows={} offset_in_file={} "
                         "offset_in_decompressed_block={}",
                         path(),
                         cd.id,
@@ -564,12 +590,12 @@ ColumnPtr DMFileReader::readFromDisk(
                         stream_name,
                         substream_name,
                         start_pack_id,
+                        pack_count,
                         read_rows,
                         offset_in_file,
                         offset_in_decompressed_block));
                 throw;
             }
-            return sub_stream->buf.get();
         },
         read_rows,
         top_stream->avg_size_hint,
@@ -605,14 +631,14 @@ ColumnPtr DMFileReader::readFromDiskOrSharingCache(
             [&](const ColumnDefine & cd,
                 const DataTypePtr & type_on_disk,
                 size_t start_pack_id,
-                size_t /*pack_count*/,
+                size_t pack_count,
                 size_t read_rows) {
                 // If there are concurrent read requests, this data is likely to be shared.
                 // So the allocation and deallocation of this data may not be in the same MemoryTracker.
                 // This can lead to inaccurate memory statistics of MemoryTracker.
                 // To solve this problem, we use a independent global memory tracker to trace the shared column data in the data_sharing_col_data_cache.
                 MemoryTrackerSetter mem_tracker_guard(true, nullptr);
-                return readFromDisk(cd, type_on_disk, start_pack_id, read_rows);
+                return readFromDisk(cd, type_on_disk, start_pack_id, pack_count, read_rows);
             });
         // Set the column to DMFileReaderPool to share the column data.
         DMFileReaderPool::instance().set(*this, cd.id, start_pack_id, pack_count, column);
@@ -621,7 +647,7 @@ ColumnPtr DMFileReader::readFromDiskOrSharingCache(
         return column;
     }
 
-    return readFromDisk(cd, type_on_disk, start_pack_id, read_rows);
+    return readFromDisk(cd, type_on_disk, start_pack_id, pack_count, read_rows);
 }
 
 void DMFileReader::addColumnToCache(
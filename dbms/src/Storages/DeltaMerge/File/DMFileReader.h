@@ -88,6 +88,11 @@ public:
     Block readWithFilter(const IColumn::Filter & filter);
 
     Block read();
+
+    /// Return true if the packs read ahead for the next call of #read() are ready, or nothing is read ahead.
+    /// It never blocks, so the caller can yield and check again later.
+    bool pollReadAhead() const;
+
     std::string path() const
     {
         // Status of DMFile can be updated when DMFileReader in used and the pathname will be changed.
@@ -107,6 +112,9 @@ private:
 
     Block readImpl(const ReadBlockInfo & read_info);
 
+    // Submit the reads of the next read block info in batch without waiting for them.
+    void readAhead();
+
     ColumnPtr readExtraColumn(
         const ColumnDefine & cd,
         size_t start_pack_id,
@@ -117,6 +125,7 @@ private:
         const ColumnDefine & cd,
         const DataTypePtr & type_on_disk,
         size_t start_pack_id,
+        size_t pack_count,
         size_t read_rows);
     ColumnPtr readFromDiskOrSharingCache(
         const ColumnDefine & cd,
@@ -54,5 +54,17 @@ String colMarkFileName(const FileNameBase & file_name_base)
 {
     return file_name_base + details::MARK_FILE_SUFFIX;
 }
+String colNgramBloomFileName(const FileNameBase & file_name_base)
+{
+    return file_name_base + details::NGRAM_BLOOM_FILE_SUFFIX;
+}
+String colEqualityBloomFileName(const FileNameBase & file_name_base)
+{
+    return file_name_base + details::EQUALITY_BLOOM_FILE_SUFFIX;
+}
+String colStatisticsFileName(const FileNameBase & file_name_base)
+{
+    return file_name_base + details::STATISTICS_FILE_SUFFIX;
+}
 
 } // namespace DB::DM
\ No newline at end of file
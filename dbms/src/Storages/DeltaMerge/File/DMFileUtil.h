@@ -29,6 +29,9 @@ inline constexpr static const char * FOLDER_PREFIX_DROPPED = ".del.dmf_";
 inline constexpr static const char * DATA_FILE_SUFFIX = ".dat";
 inline constexpr static const char * INDEX_FILE_SUFFIX = ".idx";
 inline constexpr static const char * MARK_FILE_SUFFIX = ".mrk";
+inline constexpr static const char * NGRAM_BLOOM_FILE_SUFFIX = ".ngram";
+inline constexpr static const char * EQUALITY_BLOOM_FILE_SUFFIX = ".bloom";
+inline constexpr static const char * STATISTICS_FILE_SUFFIX = ".stats";
 
 inline String getNGCPath(const String & prefix)
 {
@@ -50,5 +53,8 @@ using FileNameBase = String;
 String colDataFileName(const FileNameBase & file_name_base);
 String colIndexFileName(const FileNameBase & file_name_base);
 String colMarkFileName(const FileNameBase & file_name_base);
+String colNgramBloomFileName(const FileNameBase & file_name_base);
+String colEqualityBloomFileName(const FileNameBase & file_name_base);
+String colStatisticsFileName(const FileNameBase & file_name_base);
 
 } // namespace DB::DM
\ No newline at end of file
@@ -63,8 +63,17 @@ DMFileWriter::DMFileWriter(
         /// for handle column always generate index
         auto type = removeNullable(cd.type);
         bool do_index = cd.id == MutSup::extra_handle_id || type->isInteger() || type->isDateOrDateTime();
-
-        addStreams(cd.id, cd.type, do_index);
+        // The n-gram bloom index is merged into metav2, and only used for checking LIKE on string columns.
+        bool do_ngram_bloom = options.enable_ngram_bloom_index && dmfile->useMetaV2()
+            && cd.id != MutSup::extra_handle_id && type->getTypeId() == TypeIndex::String;
+        // The equality bloom index is built for the columns defined by the table schema.
+        bool do_equality_bloom = dmfile->useMetaV2() && cd.id != MutSup::extra_handle_id
+            && options.equality_bloom_index_columns.contains(cd.id) && EqualityBloomIndex::isSupportedType(cd.type);
+        // The statistics are built for the numeric columns except the extra columns (handle, version, del_mark).
+        bool do_statistics = options.enable_column_statistics && dmfile->useMetaV2() && cd.id >= 0
+            && RSIndexNumber::isSupportedType(cd.type);
+
+        addStreams(cd.id, cd.type, do_index, do_ngram_bloom, do_equality_bloom, do_statistics);
         dmfile->meta->getColumnStats().emplace(
             cd.id,
             ColumnStat{
@@ -109,7 +118,13 @@ DMFileWriter::WriteBufferFromFileBasePtr DMFileWriter::createMetaFile()
     }
 }
 
-void DMFileWriter::addStreams(ColId col_id, DataTypePtr type, bool do_index)
+void DMFileWriter::addStreams(
+    ColId col_id,
+    DataTypePtr type,
+    bool do_index,
+    bool do_ngram_bloom,
+    bool do_equality_bloom,
+    bool do_statistics)
 {
     auto callback = [&](const IDataType::SubstreamPath & substream_path) {
         const auto stream_name = DMFile::getFileNameBase(col_id, substream_path);
@@ -123,7 +138,10 @@ void DMFileWriter::addStreams(ColId col_id, DataTypePtr type, bool do_index)
             options.max_compress_block_size,
             file_provider,
             write_limiter,
-            do_index && substream_can_index);
+            do_index && substream_can_index,
+            do_ngram_bloom && substream_can_index,
+            do_equality_bloom && substream_can_index,
+            do_statistics && substream_can_index);
         column_streams.emplace(stream_name, std::move(stream));
     };
     type->enumerateStreams(callback, {});
@@ -211,6 +229,12 @@ void DMFileWriter::writeColumn(
                     column,
                     (col_id == MutSup::extra_handle_id || col_id == MutSup::delmark_col_id) ? nullptr : del_mark);
             }
+            if (stream->ngram_bloom)
+                stream->ngram_bloom->addPack(column);
+            if (stream->equality_bloom)
+                stream->equality_bloom->addPack(column);
+            if (stream->statistics)
+                stream->statistics->addPack(column, del_mark);
 
             /// There could already be enough data to compress into the new block.
             if (stream->compressed_buf->offset() >= options.min_compress_block_size)
@@ -258,6 +282,28 @@ void DMFileWriter::writeColumn(
     IDataType::updateAvgValueSizeHint(column, avg_size);
 }
 
+template <typename Index>
+void DMFileWriter::writeIndexToMergedFile(const Index & index, const String & fname)
+{
+    auto * dmfile_meta = typeid_cast<DMFileMetaV2 *>(dmfile->meta.get());
+    assert(dmfile_meta != nullptr);
+    dmfile_meta->checkMergedFile(merged_file, file_provider, write_limiter);
+
+    auto buffer = ChecksumWriteBufferBuilder::build(
+        merged_file.buffer,
+        dmfile->getConfiguration()->getChecksumAlgorithm(),
+        dmfile->getConfiguration()->getChecksumFrameLength());
+
+    index.write(*buffer);
+
+    size_t index_size = buffer->getMaterializedBytes();
+    MergedSubFileInfo info{fname, merged_file.file_info.number, merged_file.file_info.size, index_size};
+    dmfile_meta->merged_sub_file_infos[fname] = info;
+
+    merged_file.file_info.size += index_size;
+    buffer->next();
+}
+
 void DMFileWriter::finalizeColumn(ColId col_id, DataTypePtr type)
 {
     // Update column's bytes in memory
@@ -337,6 +383,21 @@ void DMFileWriter::finalizeColumn(ColId col_id, DataTypePtr type)
                 buffer->next();
             }
 
+            // write n-gram bloom index into merged_file_writer
+            if (stream->ngram_bloom && !is_empty_file)
+                writeIndexToMergedFile(*stream->ngram_bloom, colNgramBloomFileName(stream_name));
+
+            // write equality bloom index into merged_file_writer
+            if (stream->equality_bloom && !is_empty_file)
+                writeIndexToMergedFile(*stream->equality_bloom, colEqualityBloomFileName(stream_name));
+
+            // write statistics into merged_file_writer
+            if (stream->statistics && !is_empty_file)
+            {
+                stream->statistics->finalize();
+                writeIndexToMergedFile(*stream->statistics, colStatisticsFileName(stream_name));
+            }
+
             // write mark into merged_file_writer
             if (!is_empty_file)
             {
@@ -22,7 +22,12 @@
 #include <IO/FileProvider/ChecksumWriteBufferBuilder.h>
 #include <Storages/DeltaMerge/DMChecksumConfig.h>
 #include <Storages/DeltaMerge/File/DMFile.h>
+#include <Storages/DeltaMerge/Index/EqualityBloomIndex.h>
+#include <Storages/DeltaMerge/Index/Histogram.h>
 #include <Storages/DeltaMerge/Index/MinMaxIndex.h>
+#include <Storages/DeltaMerge/Index/NgramBloomIndex.h>
+
+#include <unordered_set>
 
 namespace DB::DM
 {
@@ -53,7 +58,10 @@ public:
             size_t max_compress_block_size,
             FileProviderPtr & file_provider,
             const WriteLimiterPtr & write_limiter_,
-            bool do_index)
+            bool do_index,
+            bool do_ngram_bloom,
+            bool do_equality_bloom,
+            bool do_statistics)
             : plain_file(ChecksumWriteBufferBuilder::build(
                 dmfile->getConfiguration().has_value(),
                 file_provider,
@@ -67,6 +75,9 @@ public:
                 /*mode*/ 0666,
                 max_compress_block_size))
             , minmaxes(do_index ? std::make_shared<MinMaxIndex>(*type) : nullptr)
+            , ngram_bloom(do_ngram_bloom ? std::make_shared<NgramBloomIndex>() : nullptr)
+            , equality_bloom(do_equality_bloom ? std::make_shared<EqualityBloomIndex>() : nullptr)
+            , statistics(do_statistics ? std::make_shared<RSIndexNumber>() : nullptr)
         {
             assert(compression_settings.settings.size() == 1);
             auto setting = getCompressionSetting(type, file_base_name, compression_settings.settings[0]);
@@ -117,6 +128,12 @@ public:
 
         MinMaxIndexPtr minmaxes;
 
+        NgramBloomIndexPtr ngram_bloom;
+
+        EqualityBloomIndexPtr equality_bloom;
+
+        RSIndexNumberPtr statistics;
+
         MarksInCompressedFilePtr marks;
 
         WriteBufferFromFileBasePtr mark_file;
@@ -137,16 +154,28 @@ public:
         CompressionSettings compression_settings;
         size_t min_compress_block_size{};
         size_t max_compress_block_size{};
+        // Whether to build the n-gram bloom index for string columns, only for DMFileFormat::V3
+        bool enable_ngram_bloom_index = false;
+        // The ids of the columns to build the equality bloom index, only for DMFileFormat::V3
+        std::unordered_set<ColId> equality_bloom_index_columns;
+        // Whether to build the statistics for numeric columns, only for DMFileFormat::V3
+        bool enable_column_statistics = false;
 
         Options() = default;
 
         Options(
             CompressionSettings compression_settings_,
             size_t min_compress_block_size_,
-            size_t max_compress_block_size_)
+            size_t max_compress_block_size_,
+            bool enable_ngram_bloom_index_ = false,
+            std::unordered_set<ColId> equality_bloom_index_columns_ = {},
+            bool enable_column_statistics_ = false)
             : compression_settings(compression_settings_)
             , min_compress_block_size(min_compress_block_size_)
             , max_compress_block_size(max_compress_block_size_)
+            , enable_ngram_bloom_index(enable_ngram_bloom_index_)
+            , equality_bloom_index_columns(std::move(equality_bloom_index_columns_))
+            , enable_column_statistics(enable_column_statistics_)
         {}
 
         Options(const Options & from) = default;
@@ -177,7 +206,17 @@ private:
     /// Add streams with specified column id. Since a single column may have more than one Stream,
     /// for example Nullable column has a NullMap column, we would track them with a mapping
     /// FileNameBase -> Stream.
-    void addStreams(ColId col_id, DataTypePtr type, bool do_index);
+    void addStreams(
+        ColId col_id,
+        DataTypePtr type,
+        bool do_index,
+        bool do_ngram_bloom,
+        bool do_equality_bloom,
+        bool do_statistics);
+
+    /// Write the index into the merged file of metav2 as a sub file named `fname`.
+    template <typename Index>
+    void writeIndexToMergedFile(const Index & index, const String & fname);
 
     WriteBufferFromFileBasePtr createMetaFile();
     void finalizeMeta();
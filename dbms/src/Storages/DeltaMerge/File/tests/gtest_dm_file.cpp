@@ -14,11 +14,13 @@
 
 #include <Columns/ColumnArray.h>
 #include <Common/FailPoint.h>
+#include <Common/StringUtils/StringUtils.h>
 #include <Core/ColumnWithTypeAndName.h>
 #include <IO/BaseFile/PosixRandomAccessFile.h>
 #include <IO/BaseFile/PosixWritableFile.h>
 #include <Interpreters/Context.h>
 #include <Poco/DirectoryIterator.h>
+#include <Poco/File.h>
 #include <Storages/DeltaMerge/DMContext.h>
 #include <Storages/DeltaMerge/DeltaMergeStore.h>
 #include <Storages/DeltaMerge/File/DMFileBlockInputStream.h>
@@ -40,7 +42,9 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <ext/scope_guard.h>
 #include <magic_enum.hpp>
+#include <thread>
 #include <vector>
 namespace DB
 {
@@ -183,6 +187,15 @@ public:
         ASSERT_EQ(stream->skipNextBlock(), pack_stats[pack_id].rows);
     }
 
+    static size_t countPendingPackReads(const SkippableBlockInputStreamPtr & stream_)
+    {
+        const auto stream = std::dynamic_pointer_cast<DMFileBlockInputStream>(stream_);
+        const auto & column_streams = stream->reader.column_streams;
+        return std::count_if(column_streams.cbegin(), column_streams.cend(), [](const auto & iter) {
+            return iter.second->pending_reads != nullptr;
+        });
+    }
+
 protected:
     std::unique_ptr<DMContext> dm_context;
     /// all these var live as ref in dm_context
@@ -372,6 +385,35 @@ try
 }
 CATCH
 
+TEST_F(DMFileMetaV2Test, ListColumnFiles)
+try
+{
+    auto cols = DMTestEnv::getDefaultColumns(DMTestEnv::PkType::HiddenTiDBRowID, /*add_nullable*/ true);
+    {
+        Block block = DMTestEnv::prepareSimpleWriteBlockWithNullable(0, 128);
+        auto stream = std::make_shared<DMFileBlockOutputStream>(dbContext(), dm_file, *cols);
+        stream->writePrefix();
+        stream->write(block, DMFileBlockOutputStream::BlockProperty{0, 0, 0, 0});
+        stream->writeSuffix();
+    }
+    dm_file = restoreDMFile();
+
+    for (const auto & cd : *cols)
+    {
+        auto files = dm_file->listColumnFiles(cd.id);
+        // data and mark for each substream
+        ASSERT_GE(files.size(), 2) << cd.name;
+        for (const auto & [fname, fsize] : files)
+        {
+            // tiny data is merged into the merged file
+            ASSERT_TRUE(endsWith(fname, "/0.merged")) << fname;
+            ASSERT_EQ(fsize, Poco::File(fname).getSize()) << fname;
+        }
+    }
+    ASSERT_TRUE(dm_file->listColumnFiles(/*col_id*/ 10000).empty());
+}
+CATCH
+
 // test multiple data  into v3, and read it
 TEST_F(DMFileMetaV2Test, CheckDMFileV3WithMultiData)
 try
@@ -1304,6 +1346,77 @@ try
 }
 CATCH
 
+TEST_P(DMFileTest, ReadPacksInBatch)
+try
+{
+    const auto mode = GetParam();
+    // Use a small checksum frame so that a pack spans several frames, and do not merge
+    // the data files into the merged file so that they can be read in batch.
+    auto configuration = (mode != DMFileMode::DirectoryLegacy)
+        ? std::make_optional<DMChecksumConfig>(std::map<std::string, std::string>{}, 512)
+        : std::nullopt;
+    dm_file = DMFile::create(
+        2,
+        parent_path,
+        std::move(configuration),
+        /*small_file_size_threshold*/ 1,
+        16 * 1024 * 1024,
+        NullspaceID,
+        modeToVersion(mode));
+
+    auto cols = DMTestEnv::getDefaultColumns(DMTestEnv::PkType::HiddenTiDBRowID, /*add_nullable*/ true);
+    const size_t num_packs = 6;
+    const size_t rows_per_pack = 1000;
+    {
+        auto stream = std::make_shared<DMFileBlockOutputStream>(dbContext(), dm_file, *cols);
+        stream->writePrefix();
+        for (size_t i = 0; i < num_packs; ++i)
+        {
+            Block block = DMTestEnv::prepareSimpleWriteBlockWithNullable(i * rows_per_pack, (i + 1) * rows_per_pack);
+            stream->write(block, DMFileBlockOutputStream::BlockProperty{});
+        }
+        stream->writeSuffix();
+        ASSERT_EQ(dm_file->getPacks(), num_packs);
+    }
+
+    // Read 2 packs every time, and the next 2 packs are read ahead in batch
+    DMFileBlockInputStreamBuilder builder(dbContext());
+    auto stream = builder.setRowsThreshold(2 * rows_per_pack)
+                      .build(
+                          dm_file,
+                          *cols,
+                          RowKeyRanges{RowKeyRange::newAll(false, 1)},
+                          std::make_shared<ScanContext>());
+    const auto dmfile_stream = std::dynamic_pointer_cast<DMFileBlockInputStream>(stream);
+    ASSERT_NE(dmfile_stream, nullptr);
+
+    size_t num_reads = 0;
+    Int64 next_pk = 0;
+    stream->readPrefix();
+    while (true)
+    {
+        // Wait for the packs read ahead like the pipeline IO task
+        while (!dmfile_stream->pollReadAhead())
+            std::this_thread::yield();
+        Block block = stream->read();
+        if (!block)
+            break;
+        ++num_reads;
+        if (num_reads < num_packs / 2 && mode != DMFileMode::DirectoryLegacy)
+            ASSERT_GT(countPendingPackReads(stream), 0U);
+        else
+            ASSERT_EQ(countPendingPackReads(stream), 0U);
+
+        const auto & pk = block.getByName(DMTestEnv::pk_name).column;
+        for (size_t i = 0; i < pk->size(); ++i)
+            ASSERT_EQ(pk->getInt(i), next_pk++);
+    }
+    stream->readSuffix();
+    ASSERT_EQ(num_reads, num_packs / 2);
+    ASSERT_EQ(next_pk, static_cast<Int64>(num_packs * rows_per_pack));
+}
+CATCH
+
 // test seek
 TEST_P(DMFileTest, Seek)
 try
@@ -1872,6 +1985,83 @@ try
 }
 CATCH
 
+TEST_P(DMFileTest, ReadFilteredByNgramBloomIndex)
+try
+{
+    auto cols = DMTestEnv::getDefaultColumns();
+    ColumnDefine str_cd(2, "str", typeFromString(DataTypeString::getDefaultName()));
+    cols->push_back(str_cd);
+
+    reload(cols);
+
+    const Strings words{"apple", "banana", "cherry", "durian"};
+    const size_t rows_per_pack = 100;
+    {
+        db_context->getSettingsRef().dt_enable_ngram_bloom_index = true;
+        SCOPE_EXIT({ db_context->getSettingsRef().dt_enable_ngram_bloom_index = false; });
+        auto stream = std::make_shared<DMFileBlockOutputStream>(dbContext(), dm_file, *cols);
+
+        DMFileBlockOutputStream::BlockProperty block_property;
+        stream->writePrefix();
+        // Every block is written as a pack, and the strings of each pack contain one of the words.
+        for (size_t i = 0; i < words.size(); ++i)
+        {
+            Block block = DMTestEnv::prepareSimpleWriteBlock(i * rows_per_pack, (i + 1) * rows_per_pack, false);
+            Strings values;
+            for (size_t j = 0; j < rows_per_pack; ++j)
+                values.push_back(fmt::format("{}_{}", words[i], j));
+            block.insert(ColumnWithTypeAndName{
+                DB::tests::makeColumn<String>(str_cd.type, values),
+                str_cd.type,
+                str_cd.name,
+                str_cd.id});
+            stream->write(block, block_property);
+        }
+        stream->writeSuffix();
+    }
+
+    // The n-gram bloom index is only built for DMFileFormat::V3.
+    const bool has_index = GetParam() == DMFileMode::DirectoryMetaV2;
+    ASSERT_EQ(dm_file->isColNgramBloomExist(str_cd.id), has_index);
+
+    if (!db_context->getNgramBloomIndexCache())
+        db_context->setNgramBloomIndexCache(16 * 1024 * 1024);
+    auto cache = db_context->getNgramBloomIndexCache();
+    cache->reset();
+    SCOPE_EXIT({ cache->reset(); });
+
+    const auto read_ranges = RowKeyRanges{RowKeyRange::newAll(false, 1)};
+    const Attr attr{str_cd.name, str_cd.id, str_cd.type};
+    auto check_packs = [&](const RSOperatorPtr & filter, const std::vector<bool> & expected_use) {
+        auto pack_result = DMFilePackFilter::loadFrom(dmContext(), dm_file, true, read_ranges, filter, {});
+        const auto & pack_res = pack_result->getPackRes();
+        ASSERT_EQ(pack_res.size(), expected_use.size());
+        for (size_t i = 0; i < pack_res.size(); ++i)
+            ASSERT_EQ(pack_res[i].isUse(), expected_use[i]) << fmt::format("pack={}", i);
+    };
+    const std::vector<bool> use_all(words.size(), true);
+
+    // The index is not loaded for the operators other than `like`.
+    check_packs(createNotEqual(attr, Field(String("banana"))), use_all);
+    ASSERT_EQ(cache->count(), 0);
+
+    // Only the pack containing "banana" is read by `like`.
+    check_packs(
+        createLike(attr, Field(String("%banana%"))),
+        has_index ? std::vector<bool>{false, true, false, false} : use_all);
+    ASSERT_EQ(cache->count(), has_index ? 1 : 0);
+    check_packs(
+        createOr({createLike(attr, Field(String("apple%"))), createLike(attr, Field(String("%urian%")))}),
+        has_index ? std::vector<bool>{true, false, false, true} : use_all);
+
+    // Restore file from disk and read again
+    dm_file = restoreDMFile();
+    check_packs(
+        createLike(attr, Field(String("%cherry%"))),
+        has_index ? std::vector<bool>{false, false, true, false} : use_all);
+}
+CATCH
+
 // Test rough filter with some unsupported operations
 TEST_P(DMFileTest, ReadFilteredByRoughSetFilterWithUnsupportedOperation)
 try
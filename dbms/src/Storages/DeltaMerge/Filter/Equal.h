@@ -29,9 +29,13 @@ public:
 
     String name() override { return "equal"; }
 
+    ColIds getEqualityBloomColumnIDs() override { return {attr.col_id}; }
+
     RSResults roughCheck(size_t start_pack, size_t pack_count, const RSCheckParam & param) override
     {
-        return minMaxCheckCmp<RoughCheck::CheckEqual>(start_pack, pack_count, param, attr, value);
+        auto results = minMaxCheckCmp<RoughCheck::CheckEqual>(start_pack, pack_count, param, attr, value);
+        equalityBloomCheckIn(start_pack, pack_count, param, attr, {value}, results);
+        return results;
     }
 
     ColumnRangePtr buildSets(const google::protobuf::RepeatedPtrField<tipb::ColumnarIndexInfo> & index_infos) override
@@ -34,6 +34,8 @@ public:
 
     ColIds getColumnIDs() override { return {attr.col_id}; }
 
+    ColIds getEqualityBloomColumnIDs() override { return {attr.col_id}; }
+
     String toDebugString() override
     {
         FmtBuffer buf;
@@ -70,8 +72,10 @@ public:
         if (values.empty())
             return RSResults(pack_count, RSResult::None);
         auto rs_index = getRSIndex(param, attr);
-        return rs_index ? rs_index->minmax->checkIn(start_pack, pack_count, values, rs_index->type)
-                        : RSResults(pack_count, RSResult::Some);
+        auto results = rs_index ? rs_index->minmax->checkIn(start_pack, pack_count, values, rs_index->type)
+                                : RSResults(pack_count, RSResult::Some);
+        equalityBloomCheckIn(start_pack, pack_count, param, attr, values, results);
+        return results;
     }
 
     ColumnRangePtr buildSets(const google::protobuf::RepeatedPtrField<tipb::ColumnarIndexInfo> & index_infos) override
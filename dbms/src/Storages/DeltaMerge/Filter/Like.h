@@ -22,21 +22,35 @@ namespace DB::DM
 class Like : public ColCmpVal
 {
 public:
-    Like(const Attr & attr_, const Field & value_)
+    Like(const Attr & attr_, const Field & value_, char escape_char_)
         : ColCmpVal(attr_, value_)
-    {}
+        , escape_char(escape_char_)
+    {
+        if (value.getType() == Field::Types::String)
+            ngrams = NgramBloomIndex::extractLikeNgrams(value.get<String>(), escape_char);
+    }
 
     String name() override { return "like"; }
 
-    RSResults roughCheck(size_t /*start_pack*/, size_t pack_count, const RSCheckParam & /*param*/) override
+    ColIds getNgramBloomColumnIDs() override { return {attr.col_id}; }
+
+    RSResults roughCheck(size_t start_pack, size_t pack_count, const RSCheckParam & param) override
     {
-        return RSResults(pack_count, RSResult::Some);
+        // Only the n-gram bloom index can check the pattern
+        auto it = param.ngram_bloom_indexes.find(attr.col_id);
+        if (ngrams.empty() || it == param.ngram_bloom_indexes.end())
+            return RSResults(pack_count, RSResult::Some);
+        return it->second->checkNgrams(start_pack, pack_count, ngrams);
     }
 
     ColumnRangePtr buildSets(const google::protobuf::RepeatedPtrField<tipb::ColumnarIndexInfo> &) override
     {
         return UnsupportedColumnRange::create();
     }
+
+private:
+    char escape_char;
+    std::vector<UInt32> ngrams;
 };
 
 } // namespace DB::DM
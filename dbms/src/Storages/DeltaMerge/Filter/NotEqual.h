@@ -29,9 +29,13 @@ public:
 
     String name() override { return "not_equal"; }
 
+    ColIds getEqualityBloomColumnIDs() override { return {attr.col_id}; }
+
     RSResults roughCheck(size_t start_pack, size_t pack_count, const RSCheckParam & param) override
     {
         auto results = minMaxCheckCmp<RoughCheck::CheckEqual>(start_pack, pack_count, param, attr, value);
+        // The packs that do not contain `value` are all matched by `not_equal`.
+        equalityBloomCheckIn(start_pack, pack_count, param, attr, {value}, results);
         std::transform(results.begin(), results.end(), results.begin(), [](RSResult result) { return !result; });
         return results;
     }
@@ -19,6 +19,7 @@
 #include <Poco/JSON/Object.h>
 #pragma GCC diagnostic pop
 #include <Common/config.h> // For ENABLE_CLARA
+#include <DataStreams/TopNThreshold_fwd.h>
 #include <Flash/Coprocessor/TiDBTableScan.h>
 #include <Interpreters/ExpressionActions.h>
 #include <Storages/DeltaMerge/Filter/RSOperator.h>
@@ -144,6 +145,9 @@ public:
 #endif
     // The column_range contains the column values of the pushed down filters
     const ColumnRangePtr column_range;
+    // The threshold of the TopN above the table scan, it becomes tighter while reading.
+    // Combined with `rs_operator` when the input stream of each segment is built.
+    TopNThresholdPtr topn_threshold;
 };
 
 } // namespace DB::DM
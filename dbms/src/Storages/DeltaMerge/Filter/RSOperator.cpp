@@ -45,7 +45,7 @@ RSOperatorPtr createGreaterEqual(const Attr & attr, const Field & value)
 RSOperatorPtr createIn(const Attr & attr, const Fields & values)                { return std::make_shared<In>(attr, values); }
 RSOperatorPtr createLess(const Attr & attr, const Field & value)                { return std::make_shared<Less>(attr, value); }
 RSOperatorPtr createLessEqual(const Attr & attr, const Field & value)           { return std::make_shared<LessEqual>(attr, value); }
-RSOperatorPtr createLike(const Attr & attr, const Field & value)                { return std::make_shared<Like>(attr, value); }
+RSOperatorPtr createLike(const Attr & attr, const Field & value, char escape_char) { return std::make_shared<Like>(attr, value, escape_char); }
 RSOperatorPtr createNot(const RSOperatorPtr & op)                               { return std::make_shared<Not>(op); }
 RSOperatorPtr createNotEqual(const Attr & attr, const Field & value)            { return std::make_shared<NotEqual>(attr, value); }
 RSOperatorPtr createOr(const RSOperators & children)                            { return std::make_shared<Or>(children); }
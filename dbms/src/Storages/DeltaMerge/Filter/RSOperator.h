@@ -42,6 +42,8 @@ inline static const RSOperatorPtr EMPTY_RS_OPERATOR{};
 struct RSCheckParam
 {
     ColumnIndexes indexes;
+    ColumnNgramBloomIndexes ngram_bloom_indexes;
+    ColumnEqualityBloomIndexes equality_bloom_indexes;
 };
 
 class RSOperator
@@ -60,6 +62,11 @@ public:
 
     virtual ColIds getColumnIDs() = 0;
 
+    // The columns whose n-gram bloom index is used by `roughCheck`, there is no need to load it for other columns.
+    virtual ColIds getNgramBloomColumnIDs() { return {}; }
+    // The columns whose equality bloom index is used by `roughCheck`.
+    virtual ColIds getEqualityBloomColumnIDs() { return {}; }
+
     virtual ColumnRangePtr buildSets(const google::protobuf::RepeatedPtrField<tipb::ColumnarIndexInfo> & index_infos)
         = 0;
 
@@ -125,6 +132,28 @@ public:
         return col_ids;
     }
 
+    ColIds getNgramBloomColumnIDs() override
+    {
+        ColIds col_ids;
+        for (const auto & child : children)
+        {
+            auto child_col_ids = child->getNgramBloomColumnIDs();
+            col_ids.insert(col_ids.end(), child_col_ids.begin(), child_col_ids.end());
+        }
+        return col_ids;
+    }
+
+    ColIds getEqualityBloomColumnIDs() override
+    {
+        ColIds col_ids;
+        for (const auto & child : children)
+        {
+            auto child_col_ids = child->getEqualityBloomColumnIDs();
+            col_ids.insert(col_ids.end(), child_col_ids.begin(), child_col_ids.end());
+        }
+        return col_ids;
+    }
+
     String toDebugString() override
     {
         FmtBuffer buf;
@@ -174,6 +203,26 @@ RSResults minMaxCheckCmp(
                     : RSResults(pack_count, RSResult::Some);
 }
 
+// Set the results of the packs that contain none of the `values` to `None`, according to the equality bloom index.
+inline void equalityBloomCheckIn(
+    size_t start_pack,
+    size_t pack_count,
+    const RSCheckParam & param,
+    const Attr & attr,
+    const Fields & values,
+    RSResults & results)
+{
+    auto it = param.equality_bloom_indexes.find(attr.col_id);
+    if (it == param.equality_bloom_indexes.end())
+        return;
+    auto bloom_results = it->second->checkIn(start_pack, pack_count, values, attr.type);
+    for (size_t i = 0; i < pack_count; ++i)
+    {
+        if (!bloom_results[i].isUse())
+            results[i] = bloom_results[i] && results[i];
+    }
+}
+
 // logical
 RSOperatorPtr createNot(const RSOperatorPtr & op);
 RSOperatorPtr createOr(const RSOperators & children);
@@ -189,7 +238,7 @@ RSOperatorPtr createLessEqual(const Attr & attr, const Field & value);
 // set
 RSOperatorPtr createIn(const Attr & attr, const Fields & values);
 //
-RSOperatorPtr createLike(const Attr & attr, const Field & value);
+RSOperatorPtr createLike(const Attr & attr, const Field & value, char escape_char = '\\');
 //
 RSOperatorPtr createIsNull(const Attr & attr);
 //
@@ -80,6 +80,39 @@ inline bool isRoughSetFilterSupportType(const Int32 field_type)
     return false;
 }
 
+inline bool isStringType(const Int32 field_type)
+{
+    switch (field_type)
+    {
+    case TiDB::TypeVarchar:
+    case TiDB::TypeVarString:
+    case TiDB::TypeString:
+    case TiDB::TypeTinyBlob:
+    case TiDB::TypeMediumBlob:
+    case TiDB::TypeLongBlob:
+    case TiDB::TypeBlob:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// String columns can only be checked by the equality bloom index, which compares the raw bytes (ignoring the
+// trailing spaces). So only equality compare with the binary collations is supported.
+inline bool isEqualityBloomFilterSupportType(
+    const tipb::Expr & expr,
+    const FilterParser::RSFilterType filter_type,
+    const Int32 field_type)
+{
+    if (filter_type != FilterParser::RSFilterType::Equal && filter_type != FilterParser::RSFilterType::NotEqual
+        && filter_type != FilterParser::RSFilterType::In)
+        return false;
+    if (!isStringType(field_type))
+        return false;
+    const auto collator = getCollatorFromExpr(expr);
+    return collator == nullptr || collator->isBinary() || collator->isPaddingBinary();
+}
+
 ColumnID getColumnIDForColumnExpr(const tipb::Expr & expr, const TiDB::ColumnInfos & scan_column_infos)
 {
     assert(isColumnExpr(expr));
@@ -158,7 +191,8 @@ inline RSOperatorPtr parseTiCompareExpr( //
                     tipb::ScalarFuncSig_Name(expr.sig())));
 
             auto field_type = child.field_type().tp();
-            if (!isRoughSetFilterSupportType(field_type))
+            if (!isRoughSetFilterSupportType(field_type)
+                && !isEqualityBloomFilterSupportType(expr, filter_type, field_type))
                 return createUnsupported(fmt::format(
                     "ColumnRef with field type is not supported, sig={} field_type={}",
                     tipb::ScalarFuncSig_Name(expr.sig()),
@@ -246,6 +280,39 @@ inline RSOperatorPtr parseTiCompareExpr( //
     }
 }
 
+// Only support `like(column, pattern_literal, escape_literal)`, which is checked by the n-gram bloom index.
+inline RSOperatorPtr parseTiLikeExpr( //
+    const tipb::Expr & expr,
+    const TiDB::ColumnInfos & scan_column_infos,
+    const FilterParser::ColumnIDToAttrMap & id_to_attr)
+{
+    if (unlikely(expr.children_size() != 3))
+        return createUnsupported(fmt::format("like with {} children is not supported", expr.children_size()));
+
+    // The n-grams are built on the raw bytes, other collations may match different bytes.
+    if (const auto collator = getCollatorFromExpr(expr);
+        collator != nullptr && !collator->isBinary() && !collator->isPaddingBinary())
+        return createUnsupported(fmt::format("like with collation {} is not supported", collator->getCollatorId()));
+
+    const auto & column = expr.children(0);
+    const auto & pattern = expr.children(1);
+    const auto & escape = expr.children(2);
+    if (!isColumnExpr(column) || !isLiteralExpr(pattern) || !isLiteralExpr(escape))
+        return createUnsupported("like is only supported with ColumnRef and Literal pattern");
+    if (unlikely(!column.has_field_type() || !isStringType(column.field_type().tp())))
+        return createUnsupported("like is only supported on string column");
+
+    Field pattern_value = decodeLiteral(pattern);
+    Field escape_value = decodeLiteral(escape);
+    if (pattern_value.getType() != Field::Types::String
+        || (escape_value.getType() != Field::Types::Int64 && escape_value.getType() != Field::Types::UInt64))
+        return createUnsupported("like with non-string pattern or non-integer escape is not supported");
+
+    auto col_id = getColumnIDForColumnExpr(column, scan_column_infos);
+    const auto & attr = id_to_attr.at(col_id);
+    return createLike(attr, pattern_value, static_cast<char>(escape_value.get<UInt64>()));
+}
+
 RSOperatorPtr parseTiExpr(
     const tipb::Expr & expr,
     const TiDB::ColumnInfos & scan_column_infos,
@@ -350,8 +417,10 @@ RSOperatorPtr parseTiExpr(
             }
             break;
         }
-        // Unsupported filter type:
         case FilterParser::RSFilterType::Like:
+            return parseTiLikeExpr(expr, scan_column_infos, id_to_attr);
+
+        // Unsupported filter type:
         case FilterParser::RSFilterType::Unsupported:
             return createUnsupported(reason);
         }
@@ -428,6 +497,67 @@ RSOperatorPtr FilterParser::parseRFInExpr(
     }
 }
 
+RSOperatorPtr FilterParser::parseRFMinMaxExpr(
+    const tipb::Expr & target_expr,
+    const std::optional<Attr> & target_attr,
+    const Field & min_value,
+    const Field & max_value,
+    const TimezoneInfo & timezone_info)
+{
+    if (!isColumnExpr(target_expr) || !target_attr)
+        return createUnsupported(fmt::format(
+            "rf target expr is {}",
+            target_attr.has_value() ? fmt::format("not column expr, tp={}", tipb::ExprType_Name(target_expr.tp()))
+                                    : "not found"));
+    const auto & attr = *target_attr;
+    // The build side is empty or only contains null values, no row can match.
+    if (min_value.isNull() || max_value.isNull())
+        return createIn(attr, Fields{});
+
+    Field min_bound = min_value;
+    Field max_bound = max_value;
+    if (target_expr.field_type().tp() == TiDB::TypeTimestamp && !timezone_info.is_utc_timezone)
+    {
+        // convert literal value from timezone specified in cop request to UTC
+        cop::convertFieldWithTimezone(min_bound, timezone_info);
+        cop::convertFieldWithTimezone(max_bound, timezone_info);
+    }
+    return createAnd({createGreaterEqual(attr, min_bound), createLessEqual(attr, max_bound)});
+}
+
+RSOperatorPtr FilterParser::parseTopNThresholdExpr(
+    const tipb::Expr & target_expr,
+    const std::optional<Attr> & target_attr,
+    const Field & threshold,
+    bool is_asc,
+    bool nulls_first,
+    const TimezoneInfo & timezone_info)
+{
+    if (!isColumnExpr(target_expr) || !target_attr)
+        return createUnsupported(fmt::format(
+            "topn target expr is {}",
+            target_attr.has_value() ? fmt::format("not column expr, tp={}", tipb::ExprType_Name(target_expr.tp()))
+                                    : "not found"));
+    if (!cop::isRoughSetFilterSupportType(target_expr.field_type().tp()))
+        return createUnsupported(
+            fmt::format("topn target type is not supported, field_type={}", target_expr.field_type().tp()));
+    const auto & attr = *target_attr;
+    // No value has been produced yet, all rows may enter the result.
+    if (threshold.isNull())
+        return createUnsupported("topn threshold is not ready");
+
+    Field bound = threshold;
+    if (target_expr.field_type().tp() == TiDB::TypeTimestamp && !timezone_info.is_utc_timezone)
+    {
+        // convert literal value from timezone specified in cop request to UTC
+        cop::convertFieldWithTimezone(bound, timezone_info);
+    }
+    auto op = is_asc ? createLessEqual(attr, bound) : createGreaterEqual(attr, bound);
+    if (nulls_first)
+        op = createOr({op, createIsNull(attr)});
+    return op;
+}
+
 std::optional<Attr> FilterParser::createAttr(
     const tipb::Expr & expr,
     const TiDB::ColumnInfos & scan_column_infos,
@@ -795,7 +925,7 @@ std::unordered_map<tipb::ScalarFuncSig, FilterParser::RSFilterType> FilterParser
     //{tipb::ScalarFuncSig::IsIPv6, "cast"},
     //{tipb::ScalarFuncSig::UUID, "cast"},
 
-    // {tipb::ScalarFuncSig::LikeSig, "like3Args"},
+    {tipb::ScalarFuncSig::LikeSig, FilterParser::RSFilterType::Like},
     //{tipb::ScalarFuncSig::RegexpBinarySig, "cast"},
     //{tipb::ScalarFuncSig::RegexpSig, "cast"},
 
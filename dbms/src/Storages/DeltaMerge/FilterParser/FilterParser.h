@@ -51,6 +51,23 @@ public:
         const std::set<Field> & setElements,
         const TimezoneInfo & timezone_info);
 
+    // only for runtime filter min max predicate
+    static RSOperatorPtr parseRFMinMaxExpr(
+        const tipb::Expr & target_expr,
+        const std::optional<Attr> & target_attr,
+        const Field & min_value,
+        const Field & max_value,
+        const TimezoneInfo & timezone_info);
+
+    // only for the threshold of TopN, keep the rows ordered before or equal to `threshold`
+    static RSOperatorPtr parseTopNThresholdExpr(
+        const tipb::Expr & target_expr,
+        const std::optional<Attr> & target_attr,
+        const Field & threshold,
+        bool is_asc,
+        bool nulls_first,
+        const TimezoneInfo & timezone_info);
+
     static std::optional<Attr> createAttr(
         const tipb::Expr & expr,
         const TiDB::ColumnInfos & scan_column_infos,
@@ -0,0 +1,152 @@
+// Copyright 2024 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Columns/ColumnNullable.h>
+#include <Columns/ColumnString.h>
+#include <Common/HashTable/Hash.h>
+#include <Common/HashTable/HashSet.h>
+#include <Common/typeid_cast.h>
+#include <DataTypes/DataTypeNullable.h>
+#include <Storages/DeltaMerge/Index/EqualityBloomIndex.h>
+#include <city.h>
+
+#include <algorithm>
+
+namespace DB::DM
+{
+namespace
+{
+inline UInt64 hashString(const char * data, size_t size)
+{
+    // Ignore the trailing spaces, which are not compared in the padding binary collations.
+    while (size > 0 && data[size - 1] == ' ')
+        --size;
+    return CityHash_v1_0_2::CityHash64(data, size);
+}
+
+inline UInt64 hashInteger(UInt64 value)
+{
+    return intHash64(value);
+}
+} // namespace
+
+bool EqualityBloomIndex::isSupportedType(const DataTypePtr & type)
+{
+    const auto nested_type = removeNullable(type);
+    return nested_type->isInteger() || nested_type->isMyDateOrMyDateTime() || nested_type->isString();
+}
+
+void EqualityBloomIndex::addPack(const IColumn & column)
+{
+    const IColumn * nested_column = &column;
+    const NullMap * null_map = nullptr;
+    if (column.isColumnNullable())
+    {
+        const auto & nullable_column = static_cast<const ColumnNullable &>(column);
+        nested_column = &nullable_column.getNestedColumn();
+        null_map = &nullable_column.getNullMapData();
+    }
+
+    bool has_null = false;
+    HashSet<UInt64, TrivialHash> hashes;
+    const auto * string_column = typeid_cast<const ColumnString *>(nested_column);
+    for (size_t i = 0; i < nested_column->size(); ++i)
+    {
+        if (null_map && (*null_map)[i])
+        {
+            has_null = true;
+            continue;
+        }
+        if (string_column)
+        {
+            const auto value = string_column->getDataAt(i);
+            hashes.insert(hashString(value.data, value.size));
+        }
+        else
+        {
+            // `getUInt` sign-extends the signed integers, which is the same as converting the Int64 field to UInt64.
+            hashes.insert(hashInteger(nested_column->getUInt(i)));
+        }
+    }
+
+    std::vector<UInt64> pack_hashes;
+    pack_hashes.reserve(hashes.size());
+    for (const auto & cell : hashes)
+        pack_hashes.push_back(cell.getValue());
+    filters.addPack(pack_hashes, has_null);
+}
+
+std::optional<UInt64> EqualityBloomIndex::hashField(const Field & value, const IDataType & type)
+{
+    if (type.isString())
+    {
+        if (value.getType() != Field::Types::String)
+            return std::nullopt;
+        const auto & str = value.get<String>();
+        return hashString(str.data(), str.size());
+    }
+
+    switch (value.getType())
+    {
+    case Field::Types::UInt64:
+        return hashInteger(value.get<UInt64>());
+    case Field::Types::Int64:
+        return hashInteger(static_cast<UInt64>(value.get<Int64>()));
+    default:
+        // Decimal or Float values, or the other types which need conversion.
+        return std::nullopt;
+    }
+}
+
+RSResults EqualityBloomIndex::checkIn(
+    size_t start_pack,
+    size_t pack_count,
+    const Fields & values,
+    const DataTypePtr & type) const
+{
+    const auto nested_type = removeNullable(type);
+    std::vector<UInt64> hashes;
+    hashes.reserve(values.size());
+    for (const auto & value : values)
+    {
+        // The result of comparing with NULL is NULL, which never matches.
+        if (value.isNull())
+            continue;
+        auto hash = hashField(value, *nested_type);
+        if (!hash)
+            return RSResults(pack_count, RSResult::Some);
+        hashes.push_back(*hash);
+    }
+
+    RSResults results(pack_count, RSResult::None);
+    for (size_t i = start_pack; i < start_pack + pack_count; ++i)
+    {
+        bool may_match
+            = std::any_of(hashes.begin(), hashes.end(), [&](UInt64 hash) { return filters.mayContain(i, hash); });
+        auto result = may_match ? RSResult::Some : RSResult::None;
+        if (filters.hasNull(i))
+            result.setHasNull();
+        results[i - start_pack] = result;
+    }
+    return results;
+}
+
+EqualityBloomIndexPtr EqualityBloomIndex::read(ReadBuffer & buf, size_t bytes_limit)
+{
+    auto index = std::make_shared<EqualityBloomIndex>();
+    index->filters.read(buf, bytes_limit);
+    return index;
+}
+
+} // namespace DB::DM
@@ -0,0 +1,75 @@
+// Copyright 2024 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Columns/IColumn.h>
+#include <Core/Field.h>
+#include <DataTypes/IDataType.h>
+#include <IO/Buffer/ReadBuffer.h>
+#include <IO/Buffer/WriteBuffer.h>
+#include <Storages/DeltaMerge/Index/PackBloomFilters.h>
+#include <Storages/DeltaMerge/Index/RSResult.h>
+
+#include <optional>
+
+namespace DB::DM
+{
+class EqualityBloomIndex;
+using EqualityBloomIndexPtr = std::shared_ptr<EqualityBloomIndex>;
+
+/// A bloom filter of the distinct values in each pack.
+///
+/// The min-max index can not skip any pack for `col = 'some-uuid'` when the values are random, because the range of
+/// every pack covers the value. The bloom filter can tell that the value is absent from most packs.
+/// Integer, date/datetime and string columns are supported. The trailing spaces of strings are ignored, so the index
+/// is valid for both the binary and the padding binary collations.
+class EqualityBloomIndex
+{
+public:
+    EqualityBloomIndex() = default;
+
+    static bool isSupportedType(const DataTypePtr & type);
+
+    size_t byteSize() const { return filters.byteSize(); }
+
+    size_t size() const { return filters.size(); }
+
+    // The type of `column` must be supported by `isSupportedType`.
+    void addPack(const IColumn & column);
+
+    void write(WriteBuffer & buf) const { filters.write(buf); }
+
+    static EqualityBloomIndexPtr read(ReadBuffer & buf, size_t bytes_limit);
+
+    // Return `None` for the packs that can not contain any of the `values`, `Some` for the others.
+    // `type` is the type of the column.
+    RSResults checkIn(size_t start_pack, size_t pack_count, const Fields & values, const DataTypePtr & type) const;
+
+private:
+    // Return std::nullopt if the `value` can not be compared with the column of `type` by hash.
+    static std::optional<UInt64> hashField(const Field & value, const IDataType & type);
+
+    PackBloomFilters filters;
+};
+
+class EqualityBloomIndexCache : public BloomIndexCache<EqualityBloomIndex>
+{
+public:
+    using BloomIndexCache<EqualityBloomIndex>::BloomIndexCache;
+};
+
+using EqualityBloomIndexCachePtr = std::shared_ptr<EqualityBloomIndexCache>;
+
+} // namespace DB::DM
@@ -0,0 +1,354 @@
+// Copyright 2024 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <AggregateFunctions/Helpers.h>
+#include <Columns/ColumnNullable.h>
+#include <Common/FieldVisitors.h>
+#include <Common/TiFlashException.h>
+#include <Common/typeid_cast.h>
+#include <DataTypes/DataTypeNullable.h>
+#include <IO/ReadHelpers.h>
+#include <IO/WriteHelpers.h>
+#include <Storages/DeltaMerge/Index/Histogram.h>
+
+#include <algorithm>
+
+namespace DB
+{
+namespace ErrorCodes
+{
+extern const int LOGICAL_ERROR;
+} // namespace ErrorCodes
+
+namespace DM
+{
+namespace
+{
+bool less(const Field & l, const Field & r)
+{
+    return applyVisitor(FieldVisitorAccurateLess(), l, r);
+}
+
+bool equals(const Field & l, const Field & r)
+{
+    return applyVisitor(FieldVisitorAccurateEquals(), l, r);
+}
+
+Float64 toFloat64(const Field & f)
+{
+    return applyVisitor(FieldVisitorConvertToNumber<Float64>(), f);
+}
+
+void writeBound(const Field & bound, RSIndexNumber::ValueKind kind, WriteBuffer & buf)
+{
+    switch (kind)
+    {
+    case RSIndexNumber::ValueKind::Int64:
+        DB::writeIntBinary(bound.get<Int64>(), buf);
+        break;
+    case RSIndexNumber::ValueKind::UInt64:
+        DB::writeIntBinary(bound.get<UInt64>(), buf);
+        break;
+    case RSIndexNumber::ValueKind::Float64:
+        DB::writeFloatBinary(bound.get<Float64>(), buf);
+        break;
+    }
+}
+
+Field readBound(RSIndexNumber::ValueKind kind, ReadBuffer & buf)
+{
+    switch (kind)
+    {
+    case RSIndexNumber::ValueKind::Int64:
+    {
+        Int64 v = 0;
+        DB::readIntBinary(v, buf);
+        return Field(v);
+    }
+    case RSIndexNumber::ValueKind::UInt64:
+    {
+        UInt64 v = 0;
+        DB::readIntBinary(v, buf);
+        return Field(v);
+    }
+    case RSIndexNumber::ValueKind::Float64:
+    {
+        Float64 v = 0;
+        DB::readFloatBinary(v, buf);
+        return Field(v);
+    }
+    }
+    __builtin_unreachable();
+}
+} // namespace
+
+bool RSIndexNumber::isSupportedType(const DataTypePtr & type)
+{
+    const auto nested_type = removeNullable(type);
+    return nested_type->isInteger() || nested_type->isFloatingPoint() || nested_type->isMyDateOrMyDateTime();
+}
+
+void RSIndexNumber::addPack(const IColumn & column, const ColumnVector<UInt8> * del_mark)
+{
+    const IColumn * nested_column = &column;
+    const NullMap * null_map = nullptr;
+    if (column.isColumnNullable())
+    {
+        const auto & nullable_column = static_cast<const ColumnNullable &>(column);
+        nested_column = &nullable_column.getNestedColumn();
+        null_map = &nullable_column.getNullMapData();
+    }
+
+#define DISPATCH(TYPE)                                                                 \
+    if (const auto * vec = typeid_cast<const ColumnVector<TYPE> *>(nested_column); vec) \
+    {                                                                                  \
+        addValues(vec->getData(), null_map, del_mark);                                 \
+        return;                                                                        \
+    }
+    FOR_NUMERIC_TYPES(DISPATCH)
+#undef DISPATCH
+
+    throw Exception(ErrorCodes::LOGICAL_ERROR, "Unsupported column for statistics, column={}", column.getName());
+}
+
+template <typename T>
+void RSIndexNumber::addValues(
+    const PaddedPODArray<T> & data,
+    const NullMap * null_map,
+    const ColumnVector<UInt8> * del_mark)
+{
+    // Sample the values in their exact type, so the bounds of the integers are not rounded.
+    using SampleType = std::conditional_t<
+        std::is_floating_point_v<T>,
+        Float64,
+        std::conditional_t<std::is_signed_v<T>, Int64, UInt64>>;
+    std::unique_ptr<ReservoirSampler<SampleType>> * sampler = nullptr;
+    if constexpr (std::is_same_v<SampleType, Int64>)
+    {
+        value_kind = ValueKind::Int64;
+        sampler = &int_sampler;
+    }
+    else if constexpr (std::is_same_v<SampleType, UInt64>)
+    {
+        value_kind = ValueKind::UInt64;
+        sampler = &uint_sampler;
+    }
+    else
+    {
+        value_kind = ValueKind::Float64;
+        sampler = &float_sampler;
+    }
+    if (!*sampler)
+        *sampler = std::make_unique<ReservoirSampler<SampleType>>(sample_count);
+
+    const auto * del_mark_data = del_mark ? &del_mark->getData() : nullptr;
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        if (del_mark_data && (*del_mark_data)[i])
+            continue;
+        ++total_rows;
+        if (null_map && (*null_map)[i])
+        {
+            ++null_count;
+            continue;
+        }
+        ndv_counter.insert(unionCastToUInt64(data[i]));
+        (*sampler)->insert(static_cast<SampleType>(data[i]));
+    }
+}
+
+void RSIndexNumber::finalize()
+{
+    histogram.clear();
+    switch (value_kind)
+    {
+    case ValueKind::Int64:
+        if (int_sampler)
+            buildHistogram(*int_sampler);
+        break;
+    case ValueKind::UInt64:
+        if (uint_sampler)
+            buildHistogram(*uint_sampler);
+        break;
+    case ValueKind::Float64:
+        if (float_sampler)
+            buildHistogram(*float_sampler);
+        break;
+    }
+    int_sampler.reset();
+    uint_sampler.reset();
+    float_sampler.reset();
+}
+
+template <typename T>
+void RSIndexNumber::buildHistogram(ReservoirSampler<T> & sampler)
+{
+    if (sampler.size() == 0)
+        return;
+
+    const UInt64 not_null_rows = total_rows - null_count;
+    const size_t num_buckets = std::min(max_buckets, std::min(sample_count, sampler.size()));
+    T lower = sampler.quantileNearest(0);
+    UInt64 assigned_rows = 0;
+    for (size_t k = 1; k <= num_buckets; ++k)
+    {
+        const T upper = sampler.quantileNearest(static_cast<double>(k) / num_buckets);
+        const UInt64 count = not_null_rows * k / num_buckets - assigned_rows;
+        assigned_rows += count;
+        // The frequent value produces the consecutive buckets with the same bounds, merge them into one bucket.
+        if (lower == upper && !histogram.empty() && histogram.back().lower == Field(upper)
+            && histogram.back().upper == Field(upper))
+            histogram.back().count += count;
+        else
+            histogram.push_back(Bucket{.lower = Field(lower), .upper = Field(upper), .count = count});
+        lower = upper;
+    }
+}
+
+void RSIndexNumber::merge(const RSIndexNumber & other)
+{
+    assert(!int_sampler && !uint_sampler && !float_sampler);
+    total_rows += other.total_rows;
+    null_count += other.null_count;
+    ndv_counter.merge(other.ndv_counter);
+
+    // The bounds are compared accurately, so the buckets of different kinds (e.g. after the column type is changed)
+    // can be merged too.
+    histogram.insert(histogram.end(), other.histogram.begin(), other.histogram.end());
+    std::sort(histogram.begin(), histogram.end(), [](const Bucket & l, const Bucket & r) {
+        return less(l.lower, r.lower) || (equals(l.lower, r.lower) && less(l.upper, r.upper));
+    });
+    // Combine the adjacent buckets until the number of buckets is small enough.
+    // The buckets of different DMFiles may overlap, which is fine for the estimation.
+    while (histogram.size() > max_buckets)
+    {
+        Buckets combined;
+        combined.reserve((histogram.size() + 1) / 2);
+        for (size_t i = 0; i < histogram.size(); i += 2)
+        {
+            if (i + 1 == histogram.size())
+            {
+                combined.push_back(histogram[i]);
+                break;
+            }
+            const auto & l = histogram[i];
+            const auto & r = histogram[i + 1];
+            combined.push_back(Bucket{
+                .lower = l.lower,
+                .upper = less(l.upper, r.upper) ? r.upper : l.upper,
+                .count = l.count + r.count});
+        }
+        histogram.swap(combined);
+    }
+}
+
+Float64 RSIndexNumber::estimateEqualRows(const Field & value) const
+{
+    bool in_range = false;
+    UInt64 frequent_rows = 0;
+    for (const auto & bucket : histogram)
+    {
+        in_range = in_range || (!less(value, bucket.lower) && !less(bucket.upper, value));
+        // The bucket of a frequent value.
+        if (equals(bucket.lower, value) && equals(bucket.upper, value))
+            frequent_rows += bucket.count;
+    }
+    if (!in_range)
+        return 0;
+    if (frequent_rows > 0)
+        return frequent_rows;
+    // Assume the rows are evenly distributed among the distinct values.
+    return static_cast<Float64>(total_rows - null_count) / std::max<UInt64>(ndv(), 1);
+}
+
+Float64 RSIndexNumber::estimateRangeRows(const Field & lower, const Field & upper) const
+{
+    Float64 rows = 0;
+    for (const auto & bucket : histogram)
+    {
+        if (less(upper, bucket.lower) || less(bucket.upper, lower))
+            continue;
+        if (equals(bucket.lower, bucket.upper))
+        {
+            rows += bucket.count;
+            continue;
+        }
+        // Assume the values are uniformly distributed in the bucket.
+        // Only the fraction of the overlap is computed in Float64, the bounds are compared exactly.
+        const auto & overlap_lower = less(lower, bucket.lower) ? bucket.lower : lower;
+        const auto & overlap_upper = less(bucket.upper, upper) ? bucket.upper : upper;
+        const Float64 overlap = toFloat64(overlap_upper) - toFloat64(overlap_lower);
+        const Float64 width = toFloat64(bucket.upper) - toFloat64(bucket.lower);
+        rows += width > 0 ? bucket.count * std::min(overlap / width, 1.0) : bucket.count;
+    }
+    return rows;
+}
+
+void RSIndexNumber::write(WriteBuffer & buf) const
+{
+    assert(!int_sampler && !uint_sampler && !float_sampler);
+    UInt64 size = histogram.size();
+    DB::writeIntBinary(total_rows, buf);
+    DB::writeIntBinary(null_count, buf);
+    ndv_counter.write(buf);
+    DB::writeIntBinary(static_cast<UInt8>(value_kind), buf);
+    DB::writeIntBinary(size, buf);
+    for (const auto & bucket : histogram)
+    {
+        writeBound(bucket.lower, value_kind, buf);
+        writeBound(bucket.upper, value_kind, buf);
+        DB::writeIntBinary(bucket.count, buf);
+    }
+}
+
+RSIndexNumberPtr RSIndexNumber::read(ReadBuffer & buf, size_t bytes_limit)
+{
+    auto index = std::make_shared<RSIndexNumber>();
+    UInt64 size = 0;
+    UInt8 kind = 0;
+    size_t buf_pos = buf.count();
+    DB::readIntBinary(index->total_rows, buf);
+    DB::readIntBinary(index->null_count, buf);
+    index->ndv_counter.read(buf);
+    DB::readIntBinary(kind, buf);
+    if (unlikely(kind > static_cast<UInt8>(ValueKind::Float64)))
+    {
+        throw DB::TiFlashException(
+            Errors::DeltaTree::Internal,
+            "Bad file format: unknown value kind of statistics: {}",
+            kind);
+    }
+    index->value_kind = static_cast<ValueKind>(kind);
+    DB::readIntBinary(size, buf);
+    index->histogram.resize(size);
+    for (auto & bucket : index->histogram)
+    {
+        bucket.lower = readBound(index->value_kind, buf);
+        bucket.upper = readBound(index->value_kind, buf);
+        DB::readIntBinary(bucket.count, buf);
+    }
+    size_t bytes_read = buf.count() - buf_pos;
+    if (unlikely(bytes_read != bytes_limit))
+    {
+        throw DB::TiFlashException(
+            Errors::DeltaTree::Internal,
+            "Bad file format: expected read statistics content size: {} vs. actual: {}",
+            bytes_limit,
+            bytes_read);
+    }
+    return index;
+}
+
+} // namespace DM
+} // namespace DB
@@ -14,14 +14,104 @@
 
 #pragma once
 
+#include <AggregateFunctions/ReservoirSampler.h>
+#include <Columns/ColumnsNumber.h>
+#include <Columns/IColumn.h>
+#include <Common/HyperLogLogCounter.h>
+#include <Core/Field.h>
+#include <DataTypes/IDataType.h>
+#include <IO/Buffer/ReadBuffer.h>
+#include <IO/Buffer/WriteBuffer.h>
+
+#include <memory>
+#include <vector>
+
 namespace DB
 {
 namespace DM
 {
+class RSIndexNumber;
+using RSIndexNumberPtr = std::shared_ptr<RSIndexNumber>;
+
+/// The statistics of a numeric column in a DMFile, used to estimate the cardinality without scanning the data:
+/// - the number of rows and NULLs
+/// - the number of distinct values, estimated by HyperLogLog
+/// - an equi-depth histogram of the not null values, built from a reservoir sample of the column
+///
+/// Integer, float and date/datetime columns are supported. The bounds of the histogram keep the exact values, i.e.
+/// Int64 / UInt64 for integer and date/datetime columns and Float64 for float columns.
 class RSIndexNumber
 {
-};
+public:
+    enum class ValueKind : UInt8
+    {
+        Int64 = 0,
+        UInt64 = 1,
+        Float64 = 2,
+    };
+
+    struct Bucket
+    {
+        Field lower;
+        Field upper;
+        // The estimated number of rows in [lower, upper].
+        UInt64 count = 0;
+    };
+    using Buckets = std::vector<Bucket>;
+
+    static constexpr size_t max_buckets = 64;
+    static constexpr size_t sample_count = 4096;
+
+    RSIndexNumber() = default;
+
+    static bool isSupportedType(const DataTypePtr & type);
+
+    // Add the values of a pack. The deleted rows are ignored if `del_mark` is not null, but all the MVCC versions
+    // of a row are added.
+    void addPack(const IColumn & column, const ColumnVector<UInt8> * del_mark);
+
+    // Build the histogram from the sampled values. Must be called after all the packs are added.
+    void finalize();
+
+    // Merge the statistics of another DMFile, both of them must be finalized.
+    void merge(const RSIndexNumber & other);
 
+    UInt64 rows() const { return total_rows; }
+    UInt64 nullCount() const { return null_count; }
+    UInt64 ndv() const { return ndv_counter.size(); }
+    const Buckets & buckets() const { return histogram; }
+
+    // Estimate the number of rows equal to `value`.
+    Float64 estimateEqualRows(const Field & value) const;
+    // Estimate the number of not null rows in [lower, upper].
+    Float64 estimateRangeRows(const Field & lower, const Field & upper) const;
+
+    size_t byteSize() const { return sizeof(RSIndexNumber) + sizeof(Bucket) * histogram.capacity(); }
+
+    void write(WriteBuffer & buf) const;
+
+    static RSIndexNumberPtr read(ReadBuffer & buf, size_t bytes_limit);
+
+private:
+    template <typename T>
+    void addValues(const PaddedPODArray<T> & data, const NullMap * null_map, const ColumnVector<UInt8> * del_mark);
+
+    template <typename T>
+    void buildHistogram(ReservoirSampler<T> & sampler);
+
+    using NDVCounter = HyperLogLogCounter<12>;
+
+    UInt64 total_rows = 0;
+    UInt64 null_count = 0;
+    NDVCounter ndv_counter;
+    ValueKind value_kind = ValueKind::Int64;
+    Buckets histogram;
+
+    // Only used when building the statistics, the values are sampled by `value_kind`.
+    std::unique_ptr<ReservoirSampler<Int64>> int_sampler;
+    std::unique_ptr<ReservoirSampler<UInt64>> uint_sampler;
+    std::unique_ptr<ReservoirSampler<Float64>> float_sampler;
+};
 
 } // namespace DM
-} // namespace DB
\ No newline at end of file
+} // namespace DB
@@ -89,6 +89,27 @@ LocalIndexInfosPtr initLocalIndexInfos(const TiDB::TableInfo & table_info, const
     return generateLocalIndexInfos(nullptr, table_info, logger).new_local_index_infos;
 }
 
+std::unordered_set<ColumnID> getEqualityBloomIndexColumns(const TiDB::TableInfo & table_info)
+{
+    std::unordered_set<ColumnID> column_ids;
+    for (const auto & idx : table_info.index_infos)
+    {
+        // The primary key is filtered by the handle range and the columnar indexes are built locally.
+        if (idx.is_primary || idx.isColumnarIndex() || idx.idx_cols.empty() || idx.state != TiDB::StatePublic)
+            continue;
+        // The index is keyed by the column id, so it is kept after the column is renamed.
+        for (const auto & col : table_info.columns)
+        {
+            if (col.name == idx.idx_cols[0].name)
+            {
+                column_ids.emplace(col.id);
+                break;
+            }
+        }
+    }
+    return column_ids;
+}
+
 namespace
 {
 LocalIndexInfosChangeset nothingChanged(const std::unordered_map<IndexID, size_t> & original_local_index_id_map)
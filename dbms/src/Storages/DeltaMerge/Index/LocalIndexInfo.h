@@ -24,6 +24,7 @@
 #include <TiDB/Schema/VectorIndex.h>
 
 #include <span>
+#include <unordered_set>
 
 namespace TiDB
 {
@@ -73,6 +74,11 @@ struct LocalIndexInfo
 };
 
 LocalIndexInfosPtr initLocalIndexInfos(const TiDB::TableInfo & table_info, const LoggerPtr & logger);
+
+// Return the columns to build the equality bloom index, which are the leading columns of the public secondary
+// indexes of the table. Unlike the local indexes, the equality bloom index is built together with the DTFile.
+std::unordered_set<ColumnID> getEqualityBloomIndexColumns(const TiDB::TableInfo & table_info);
+
 class LocalIndexInfosChangeset
 {
 public:
@@ -0,0 +1,132 @@
+// Copyright 2024 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Columns/ColumnNullable.h>
+#include <Columns/ColumnString.h>
+#include <Common/HashTable/Hash.h>
+#include <Common/HashTable/HashSet.h>
+#include <Storages/DeltaMerge/Index/NgramBloomIndex.h>
+
+#include <algorithm>
+
+namespace DB::DM
+{
+namespace
+{
+inline UInt32 ngramAt(const UInt8 * pos)
+{
+    static_assert(NgramBloomIndex::ngram_size == 3);
+    return static_cast<UInt32>(pos[0]) | (static_cast<UInt32>(pos[1]) << 8) | (static_cast<UInt32>(pos[2]) << 16);
+}
+} // namespace
+
+void NgramBloomIndex::addPack(const IColumn & column)
+{
+    const ColumnString * string_column = nullptr;
+    const NullMap * null_map = nullptr;
+    if (column.isColumnNullable())
+    {
+        const auto & nullable_column = static_cast<const ColumnNullable &>(column);
+        string_column = &static_cast<const ColumnString &>(nullable_column.getNestedColumn());
+        null_map = &nullable_column.getNullMapData();
+    }
+    else
+    {
+        string_column = &static_cast<const ColumnString &>(column);
+    }
+
+    bool has_null = false;
+    HashSet<UInt32, DefaultHash<UInt32>> ngrams;
+    for (size_t i = 0; i < string_column->size(); ++i)
+    {
+        if (null_map && (*null_map)[i])
+        {
+            has_null = true;
+            continue;
+        }
+        const auto value = string_column->getDataAt(i);
+        const auto * data = reinterpret_cast<const UInt8 *>(value.data);
+        for (size_t pos = 0; pos + ngram_size <= value.size; ++pos)
+            ngrams.insert(ngramAt(data + pos));
+    }
+
+    std::vector<UInt64> hashes;
+    hashes.reserve(ngrams.size());
+    for (const auto & cell : ngrams)
+        hashes.push_back(intHash64(cell.getValue()));
+    filters.addPack(hashes, has_null);
+}
+
+RSResults NgramBloomIndex::checkNgrams(size_t start_pack, size_t pack_count, const std::vector<UInt32> & ngrams) const
+{
+    RSResults results(pack_count, RSResult::Some);
+    if (ngrams.empty())
+        return results;
+
+    std::vector<UInt64> hashes(ngrams.size());
+    std::transform(ngrams.begin(), ngrams.end(), hashes.begin(), [](UInt32 ngram) { return intHash64(ngram); });
+    for (size_t i = start_pack; i < start_pack + pack_count; ++i)
+    {
+        bool may_match
+            = std::all_of(hashes.begin(), hashes.end(), [&](UInt64 hash) { return filters.mayContain(i, hash); });
+        auto result = may_match ? RSResult::Some : RSResult::None;
+        if (filters.hasNull(i))
+            result.setHasNull();
+        results[i - start_pack] = result;
+    }
+    return results;
+}
+
+std::vector<UInt32> NgramBloomIndex::extractLikeNgrams(const String & pattern, char escape_char)
+{
+    std::vector<UInt32> ngrams;
+    String literal;
+    auto add_literal = [&]() {
+        const auto * data = reinterpret_cast<const UInt8 *>(literal.data());
+        for (size_t pos = 0; pos + ngram_size <= literal.size(); ++pos)
+            ngrams.push_back(ngramAt(data + pos));
+        literal.clear();
+    };
+
+    for (size_t i = 0; i < pattern.size(); ++i)
+    {
+        const char c = pattern[i];
+        if (c == escape_char && i + 1 < pattern.size())
+        {
+            literal.push_back(pattern[++i]);
+        }
+        else if (c == '%' || c == '_')
+        {
+            add_literal();
+        }
+        else
+        {
+            literal.push_back(c);
+        }
+    }
+    add_literal();
+
+    std::sort(ngrams.begin(), ngrams.end());
+    ngrams.erase(std::unique(ngrams.begin(), ngrams.end()), ngrams.end());
+    return ngrams;
+}
+
+NgramBloomIndexPtr NgramBloomIndex::read(ReadBuffer & buf, size_t bytes_limit)
+{
+    auto index = std::make_shared<NgramBloomIndex>();
+    index->filters.read(buf, bytes_limit);
+    return index;
+}
+
+} // namespace DB::DM
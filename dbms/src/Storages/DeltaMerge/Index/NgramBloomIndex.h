@@ -0,0 +1,70 @@
+// Copyright 2024 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Columns/IColumn.h>
+#include <IO/Buffer/ReadBuffer.h>
+#include <IO/Buffer/WriteBuffer.h>
+#include <Storages/DeltaMerge/Index/PackBloomFilters.h>
+#include <Storages/DeltaMerge/Index/RSResult.h>
+
+namespace DB::DM
+{
+class NgramBloomIndex;
+using NgramBloomIndexPtr = std::shared_ptr<NgramBloomIndex>;
+
+/// A bloom filter of the n-grams (every `ngram_size` consecutive bytes) of the strings in each pack.
+///
+/// A string matching `col LIKE '%error-code-123%'` must contain every n-gram of "error-code-123", so a pack can be
+/// skipped when any of these n-grams is absent from its bloom filter. The n-grams are taken from the raw bytes, so it
+/// is only valid for the patterns compared with the binary collations.
+class NgramBloomIndex
+{
+public:
+    static constexpr size_t ngram_size = 3;
+
+    NgramBloomIndex() = default;
+
+    size_t byteSize() const { return filters.byteSize(); }
+
+    size_t size() const { return filters.size(); }
+
+    // `column` must be a String or Nullable(String) column.
+    void addPack(const IColumn & column);
+
+    void write(WriteBuffer & buf) const { filters.write(buf); }
+
+    static NgramBloomIndexPtr read(ReadBuffer & buf, size_t bytes_limit);
+
+    // Return `None` for the packs that can not contain all of the `ngrams`, `Some` for the others.
+    RSResults checkNgrams(size_t start_pack, size_t pack_count, const std::vector<UInt32> & ngrams) const;
+
+    /// Return the n-grams that every string matching the `LIKE` pattern must contain.
+    /// The n-grams are extracted from the literal parts of the pattern, which are separated by `%` and `_`.
+    static std::vector<UInt32> extractLikeNgrams(const String & pattern, char escape_char);
+
+private:
+    PackBloomFilters filters;
+};
+
+class NgramBloomIndexCache : public BloomIndexCache<NgramBloomIndex>
+{
+public:
+    using BloomIndexCache<NgramBloomIndex>::BloomIndexCache;
+};
+
+using NgramBloomIndexCachePtr = std::shared_ptr<NgramBloomIndexCache>;
+
+} // namespace DB::DM
@@ -0,0 +1,108 @@
+// Copyright 2024 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/TiFlashException.h>
+#include <IO/ReadHelpers.h>
+#include <IO/WriteHelpers.h>
+#include <Storages/DeltaMerge/Index/PackBloomFilters.h>
+
+#include <algorithm>
+
+namespace DB::DM
+{
+namespace
+{
+// Calls `f(bit_index)` for every bit of the key in a bloom filter of `bits` bits.
+template <typename F>
+inline void forEachBit(UInt64 hash, size_t bits, F && f)
+{
+    // Double hashing: bit_i = h1 + i * h2
+    const UInt64 h1 = hash & 0xFFFFFFFF;
+    const UInt64 h2 = (hash >> 32) | 1;
+    for (size_t i = 0; i < PackBloomFilters::hash_count; ++i)
+        f((h1 + i * h2) % bits);
+}
+} // namespace
+
+void PackBloomFilters::addPack(const std::vector<UInt64> & hashes, bool has_null)
+{
+    const size_t num_words = std::min((hashes.size() * bits_per_key + 63) / 64, max_words_per_pack);
+    const size_t begin = words.size();
+    words.resize_fill(begin + num_words, 0);
+    if (num_words > 0)
+    {
+        auto * pack_words = words.data() + begin;
+        for (const auto hash : hashes)
+        {
+            forEachBit(hash, num_words * 64, [&](size_t bit) { pack_words[bit / 64] |= (1ULL << (bit % 64)); });
+        }
+    }
+    offsets.push_back(words.size());
+    has_null_marks.push_back(has_null);
+}
+
+bool PackBloomFilters::mayContain(size_t pack_index, UInt64 hash) const
+{
+    const size_t begin = offsets[pack_index];
+    const size_t num_words = offsets[pack_index + 1] - begin;
+    // No key in the pack.
+    if (num_words == 0)
+        return false;
+
+    const auto * pack_words = words.data() + begin;
+    bool contain = true;
+    forEachBit(hash, num_words * 64, [&](size_t bit) {
+        contain = contain && (pack_words[bit / 64] & (1ULL << (bit % 64)));
+    });
+    return contain;
+}
+
+void PackBloomFilters::write(WriteBuffer & buf) const
+{
+    UInt64 size = has_null_marks.size();
+    UInt64 num_words = words.size();
+    DB::writeIntBinary(size, buf);
+    DB::writeIntBinary(num_words, buf);
+    buf.write(reinterpret_cast<const char *>(has_null_marks.data()), sizeof(UInt8) * size);
+    buf.write(reinterpret_cast<const char *>(offsets.data()), sizeof(UInt64) * (size + 1));
+    buf.write(reinterpret_cast<const char *>(words.data()), sizeof(UInt64) * num_words);
+}
+
+void PackBloomFilters::read(ReadBuffer & buf, size_t bytes_limit)
+{
+    UInt64 size = 0;
+    UInt64 num_words = 0;
+    size_t buf_pos = buf.count();
+    DB::readIntBinary(size, buf);
+    DB::readIntBinary(num_words, buf);
+    has_null_marks.resize(size);
+    offsets.resize(size + 1);
+    words.resize(num_words);
+    buf.readStrict(reinterpret_cast<char *>(has_null_marks.data()), sizeof(UInt8) * size);
+    buf.readStrict(reinterpret_cast<char *>(offsets.data()), sizeof(UInt64) * (size + 1));
+    buf.readStrict(reinterpret_cast<char *>(words.data()), sizeof(UInt64) * num_words);
+    size_t bytes_read = buf.count() - buf_pos;
+    if (unlikely(bytes_read != bytes_limit || offsets.back() != num_words))
+    {
+        throw DB::TiFlashException(
+            Errors::DeltaTree::Internal,
+            "Bad file format: expected read bloom filter content size: {} vs. actual: {}, words: {} vs. {}",
+            bytes_limit,
+            bytes_read,
+            offsets.back(),
+            num_words);
+    }
+}
+
+} // namespace DB::DM
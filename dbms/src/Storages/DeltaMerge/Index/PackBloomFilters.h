@@ -0,0 +1,101 @@
+// Copyright 2024 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Common/LRUCache.h>
+#include <Common/PODArray.h>
+#include <IO/Buffer/ReadBuffer.h>
+#include <IO/Buffer/WriteBuffer.h>
+
+#include <vector>
+
+namespace DB::DM
+{
+/// A bloom filter for each pack, the keys are 64-bit hashes of the values in the pack.
+/// The size of the bloom filter of each pack is decided by the number of distinct keys in the pack.
+class PackBloomFilters
+{
+public:
+    static constexpr size_t hash_count = 3;
+    static constexpr size_t bits_per_key = 10;
+    // At most 64KiB for the bloom filter of one pack.
+    static constexpr size_t max_words_per_pack = 8192;
+
+    PackBloomFilters() = default;
+
+    size_t byteSize() const
+    {
+        return sizeof(UInt8) * has_null_marks.size() + sizeof(UInt64) * offsets.size() + sizeof(UInt64) * words.size()
+            + 3 * sizeof(PaddedPODArray<UInt8>);
+    }
+
+    size_t size() const { return has_null_marks.size(); }
+
+    bool hasNull(size_t pack_index) const { return has_null_marks[pack_index]; }
+
+    // `hashes` should be distinct, or the bloom filter will be larger than needed.
+    void addPack(const std::vector<UInt64> & hashes, bool has_null);
+
+    // Return false if the pack definitely does not contain the key.
+    bool mayContain(size_t pack_index, UInt64 hash) const;
+
+    void write(WriteBuffer & buf) const;
+
+    void read(ReadBuffer & buf, size_t bytes_limit);
+
+private:
+    PaddedPODArray<UInt8> has_null_marks;
+    // The bloom filter of pack i is `words[offsets[i], offsets[i + 1])`.
+    PaddedPODArray<UInt64> offsets = PaddedPODArray<UInt64>(1, 0);
+    PaddedPODArray<UInt64> words;
+};
+
+template <typename Index>
+struct BloomIndexWeightFunction
+{
+    size_t operator()(const String & key, const Index & index) const
+    {
+        // The same approximate memory cost of the cache entry as `MinMaxIndexWeightFunction`.
+        auto index_memory_usage = index.byteSize();
+        auto key_memory_usage = key.size() * 2 + sizeof(String) * 2;
+        auto unordered_map_memory_usage = 28;
+        auto list_memory_usage = sizeof(std::list<String>);
+        return index_memory_usage + key_memory_usage + unordered_map_memory_usage + list_memory_usage;
+    }
+};
+
+template <typename Index>
+class BloomIndexCache : public LRUCache<String, Index, std::hash<String>, BloomIndexWeightFunction<Index>>
+{
+private:
+    using Base = LRUCache<String, Index, std::hash<String>, BloomIndexWeightFunction<Index>>;
+
+public:
+    using typename Base::Key;
+    using typename Base::MappedPtr;
+
+    explicit BloomIndexCache(size_t max_size_in_bytes)
+        : Base(max_size_in_bytes)
+    {}
+
+    template <typename LoadFunc>
+    MappedPtr getOrSet(const Key & key, LoadFunc && load)
+    {
+        auto result = Base::getOrSet(key, load);
+        return result.first;
+    }
+};
+
+} // namespace DB::DM
@@ -14,7 +14,9 @@
 
 #pragma once
 
+#include <Storages/DeltaMerge/Index/EqualityBloomIndex.h>
 #include <Storages/DeltaMerge/Index/MinMaxIndex.h>
+#include <Storages/DeltaMerge/Index/NgramBloomIndex.h>
 
 namespace DB::DM
 {
@@ -30,5 +32,7 @@ struct RSIndex
 };
 
 using ColumnIndexes = std::unordered_map<ColId, RSIndex>;
+using ColumnNgramBloomIndexes = std::unordered_map<ColId, NgramBloomIndexPtr>;
+using ColumnEqualityBloomIndexes = std::unordered_map<ColId, EqualityBloomIndexPtr>;
 
 } // namespace DB::DM
@@ -0,0 +1,158 @@
+// Copyright 2024 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <DataTypes/DataTypeDecimal.h>
+#include <DataTypes/DataTypeNullable.h>
+#include <DataTypes/DataTypeString.h>
+#include <DataTypes/DataTypesNumber.h>
+#include <IO/Buffer/ReadBufferFromString.h>
+#include <IO/Buffer/WriteBufferFromString.h>
+#include <Storages/DeltaMerge/Filter/RSOperator.h>
+#include <Storages/DeltaMerge/Index/EqualityBloomIndex.h>
+#include <TestUtils/FunctionTestUtils.h>
+#include <TestUtils/TiFlashTestBasic.h>
+
+namespace DB::DM::tests
+{
+
+using namespace DB::tests;
+
+namespace
+{
+EqualityBloomIndexPtr buildStringIndex()
+{
+    auto index = std::make_shared<EqualityBloomIndex>();
+    // pack 0
+    index->addPack(*createColumn<Nullable<String>>({"a3f1c2", "77b0de"}).column);
+    // pack 1, with trailing spaces
+    index->addPack(*createColumn<Nullable<String>>({"c9e4a8  ", "0d15ef"}).column);
+    // pack 2
+    index->addPack(*createColumn<Nullable<String>>({"5b2f90", std::nullopt}).column);
+    return index;
+}
+} // namespace
+
+TEST(EqualityBloomIndexTest, SupportedType)
+{
+    ASSERT_TRUE(EqualityBloomIndex::isSupportedType(std::make_shared<DataTypeInt64>()));
+    ASSERT_TRUE(EqualityBloomIndex::isSupportedType(std::make_shared<DataTypeUInt8>()));
+    ASSERT_TRUE(EqualityBloomIndex::isSupportedType(makeNullable(std::make_shared<DataTypeString>())));
+    ASSERT_FALSE(EqualityBloomIndex::isSupportedType(std::make_shared<DataTypeFloat64>()));
+    ASSERT_FALSE(EqualityBloomIndex::isSupportedType(createDecimal(10, 2)));
+}
+
+TEST(EqualityBloomIndexTest, CheckInInteger)
+{
+    auto type = std::make_shared<DataTypeInt64>();
+    EqualityBloomIndex index;
+    index.addPack(*createColumn<Int64>({-100, 1, 2}).column);
+    index.addPack(*createColumn<Int64>({1000, 2000}).column);
+    index.addPack(*createColumn<Int64>({5}).column);
+    ASSERT_EQ(index.size(), 3);
+
+    auto results = index.checkIn(0, 3, {Field(static_cast<Int64>(-100))}, type);
+    ASSERT_EQ(results, RSResults({RSResult::Some, RSResult::None, RSResult::None}));
+
+    // The positive values may be UInt64 fields.
+    results = index.checkIn(0, 3, {Field(static_cast<UInt64>(2000))}, type);
+    ASSERT_EQ(results, RSResults({RSResult::None, RSResult::Some, RSResult::None}));
+
+    results = index.checkIn(1, 2, {Field(static_cast<Int64>(2)), Field(static_cast<Int64>(1000))}, type);
+    ASSERT_EQ(results, RSResults({RSResult::Some, RSResult::None}));
+
+    // Can not compare the decimal value by hash.
+    results = index.checkIn(0, 3, {Field(DecimalField<Decimal32>(100, 2))}, type);
+    ASSERT_EQ(results, RSResults(3, RSResult::Some));
+}
+
+TEST(EqualityBloomIndexTest, CheckInString)
+{
+    auto type = makeNullable(std::make_shared<DataTypeString>());
+    auto index = buildStringIndex();
+
+    auto results = index->checkIn(0, 3, {Field(String("77b0de"))}, type);
+    ASSERT_EQ(results, RSResults({RSResult::Some, RSResult::None, RSResult::NoneNull}));
+
+    // The trailing spaces are ignored.
+    results = index->checkIn(0, 3, {Field(String("c9e4a8"))}, type);
+    ASSERT_EQ(results, RSResults({RSResult::None, RSResult::Some, RSResult::NoneNull}));
+
+    // NULL never matches.
+    results = index->checkIn(0, 3, {Field(), Field(String("5b2f90"))}, type);
+    ASSERT_EQ(results, RSResults({RSResult::None, RSResult::None, RSResult::SomeNull}));
+}
+
+TEST(EqualityBloomIndexTest, WriteAndRead)
+{
+    auto type = makeNullable(std::make_shared<DataTypeString>());
+    auto index = buildStringIndex();
+    WriteBufferFromOwnString write_buf;
+    index->write(write_buf);
+    const auto & data = write_buf.releaseStr();
+
+    ReadBufferFromString read_buf(data);
+    auto read_index = EqualityBloomIndex::read(read_buf, data.size());
+    ASSERT_EQ(read_index->size(), index->size());
+    ASSERT_EQ(read_index->byteSize(), index->byteSize());
+
+    Fields values{Field(String("0d15ef"))};
+    ASSERT_EQ(read_index->checkIn(0, 3, values, type), index->checkIn(0, 3, values, type));
+
+    ReadBufferFromString bad_buf(data);
+    ASSERT_THROW(EqualityBloomIndex::read(bad_buf, data.size() - 1), DB::TiFlashException);
+}
+
+TEST(EqualityBloomIndexTest, RoughCheck)
+{
+    Attr attr{"s", 1, makeNullable(std::make_shared<DataTypeString>())};
+    RSCheckParam param;
+    auto equal = createEqual(attr, Field(String("c9e4a8")));
+
+    // Without the index, every pack may match
+    for (const auto & res : equal->roughCheck(0, 3, param))
+        ASSERT_EQ(res, RSResult::Some);
+
+    param.equality_bloom_indexes.emplace(1, buildStringIndex());
+    auto results = equal->roughCheck(0, 3, param);
+    ASSERT_EQ(results, RSResults({RSResult::None, RSResult::Some, RSResult::NoneNull}));
+
+    auto not_equal = createNotEqual(attr, Field(String("c9e4a8")));
+    results = not_equal->roughCheck(0, 3, param);
+    ASSERT_EQ(results[0], RSResult::All);
+    ASSERT_EQ(results[1], RSResult::Some);
+    ASSERT_EQ(results[2], RSResult::AllNull);
+
+    auto in = createIn(attr, {Field(String("a3f1c2")), Field(String("5b2f90"))});
+    results = in->roughCheck(0, 3, param);
+    ASSERT_EQ(results, RSResults({RSResult::Some, RSResult::None, RSResult::SomeNull}));
+}
+
+TEST(EqualityBloomIndexTest, IndexColumnsOfFilter)
+{
+    Attr a{"a", 1, std::make_shared<DataTypeInt64>()};
+    Attr b{"b", 2, std::make_shared<DataTypeString>()};
+    Attr c{"c", 3, std::make_shared<DataTypeInt64>()};
+    // Only `equal`, `not_equal` and `in` use the equality bloom index.
+    auto filter = createAnd({
+        createOr({createEqual(a, Field(Int64(1))), createLike(b, Field(String("%x%")))}),
+        createNot(createIn(b, {Field(String("y"))})),
+        createGreater(c, Field(Int64(1))),
+        createNotEqual(c, Field(Int64(2))),
+    });
+    ASSERT_EQ(filter->getEqualityBloomColumnIDs(), ColIds({1, 2, 3}));
+    ASSERT_EQ(filter->getNgramBloomColumnIDs(), ColIds({2}));
+    ASSERT_TRUE(createGreater(c, Field(Int64(1)))->getEqualityBloomColumnIDs().empty());
+}
+
+} // namespace DB::DM::tests
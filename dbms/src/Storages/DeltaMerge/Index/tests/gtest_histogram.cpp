@@ -0,0 +1,171 @@
+// Copyright 2024 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <DataTypes/DataTypeNullable.h>
+#include <DataTypes/DataTypeString.h>
+#include <DataTypes/DataTypesNumber.h>
+#include <IO/Buffer/ReadBufferFromString.h>
+#include <IO/Buffer/WriteBufferFromString.h>
+#include <Storages/DeltaMerge/Index/Histogram.h>
+#include <TestUtils/FunctionTestUtils.h>
+#include <TestUtils/TiFlashTestBasic.h>
+
+namespace DB::DM::tests
+{
+
+using namespace DB::tests;
+
+namespace
+{
+// Values in [begin, end), each value repeats `repeat` times.
+ColumnPtr createSequence(Int64 begin, Int64 end, size_t repeat)
+{
+    auto column = ColumnInt64::create();
+    for (Int64 v = begin; v < end; ++v)
+    {
+        for (size_t i = 0; i < repeat; ++i)
+            column->insert(v);
+    }
+    return column;
+}
+} // namespace
+
+TEST(RSIndexNumberTest, SupportedType)
+{
+    ASSERT_TRUE(RSIndexNumber::isSupportedType(std::make_shared<DataTypeInt32>()));
+    ASSERT_TRUE(RSIndexNumber::isSupportedType(makeNullable(std::make_shared<DataTypeFloat64>())));
+    ASSERT_FALSE(RSIndexNumber::isSupportedType(std::make_shared<DataTypeString>()));
+}
+
+TEST(RSIndexNumberTest, Build)
+{
+    RSIndexNumber stats;
+    // 10000 distinct values, each value repeats twice.
+    stats.addPack(*createSequence(0, 5000, 2), nullptr);
+    stats.addPack(*createSequence(5000, 10000, 2), nullptr);
+    stats.addPack(*createColumn<Nullable<Int64>>({1, std::nullopt, std::nullopt}).column, nullptr);
+    stats.finalize();
+
+    ASSERT_EQ(stats.rows(), 20003);
+    ASSERT_EQ(stats.nullCount(), 2);
+    // The error of HyperLogLog with 2^12 buckets is about 1.6%
+    ASSERT_NEAR(stats.ndv(), 10000, 500);
+    ASSERT_LE(stats.buckets().size(), RSIndexNumber::max_buckets);
+
+    UInt64 bucket_rows = 0;
+    for (const auto & bucket : stats.buckets())
+        bucket_rows += bucket.count;
+    ASSERT_EQ(bucket_rows, 20001);
+
+    ASSERT_NEAR(stats.estimateRangeRows(0, 9999), 20001, 1);
+    ASSERT_NEAR(stats.estimateRangeRows(0, 4999), 10000, 1000);
+    ASSERT_EQ(stats.estimateRangeRows(20000, 30000), 0);
+    ASSERT_NEAR(stats.estimateEqualRows(100), 2, 0.5);
+    ASSERT_EQ(stats.estimateEqualRows(-1), 0);
+}
+
+TEST(RSIndexNumberTest, DeleteMark)
+{
+    RSIndexNumber stats;
+    auto del_mark = ColumnUInt8::create();
+    del_mark->insert(static_cast<UInt64>(0));
+    del_mark->insert(static_cast<UInt64>(1));
+    del_mark->insert(static_cast<UInt64>(0));
+    stats.addPack(*createColumn<Int64>({1, 100, 3}).column, del_mark.get());
+    stats.finalize();
+
+    ASSERT_EQ(stats.rows(), 2);
+    ASSERT_EQ(stats.estimateEqualRows(100), 0);
+}
+
+TEST(RSIndexNumberTest, FrequentValue)
+{
+    RSIndexNumber stats;
+    stats.addPack(*createSequence(7, 8, 10000), nullptr);
+    stats.addPack(*createSequence(0, 100, 1), nullptr);
+    stats.finalize();
+
+    // The buckets of the frequent value are merged into one.
+    ASSERT_LT(stats.buckets().size(), RSIndexNumber::max_buckets / 2);
+    ASSERT_GT(stats.estimateRangeRows(7, 7), 9000);
+    ASSERT_GT(stats.estimateEqualRows(7), 9000);
+}
+
+TEST(RSIndexNumberTest, ExactIntegerBounds)
+{
+    // The values can not be distinguished by Float64.
+    const UInt64 value = (1ULL << 60) + 1;
+    RSIndexNumber stats;
+    stats.addPack(*createColumn<UInt64>(std::vector<UInt64>(1000, value)).column, nullptr);
+    stats.finalize();
+
+    ASSERT_EQ(stats.buckets().size(), 1);
+    ASSERT_EQ(stats.buckets()[0].lower, Field(value));
+    ASSERT_EQ(stats.buckets()[0].upper, Field(value));
+    ASSERT_EQ(stats.estimateEqualRows(Field(value)), 1000);
+    ASSERT_EQ(stats.estimateEqualRows(Field(value + 1)), 0);
+    ASSERT_EQ(stats.estimateRangeRows(Field(value + 1), Field(value + 100)), 0);
+
+    WriteBufferFromOwnString write_buf;
+    stats.write(write_buf);
+    const auto & data = write_buf.releaseStr();
+    ReadBufferFromString read_buf(data);
+    auto read_stats = RSIndexNumber::read(read_buf, data.size());
+    ASSERT_EQ(read_stats->buckets()[0].lower, Field(value));
+    ASSERT_EQ(read_stats->estimateEqualRows(Field(value - 1)), 0);
+}
+
+TEST(RSIndexNumberTest, Merge)
+{
+    RSIndexNumber stats;
+    stats.addPack(*createSequence(0, 10000, 1), nullptr);
+    stats.finalize();
+
+    RSIndexNumber other;
+    other.addPack(*createSequence(5000, 15000, 1), nullptr);
+    other.addPack(*createColumn<Nullable<Int64>>({std::nullopt}).column, nullptr);
+    other.finalize();
+
+    stats.merge(other);
+    ASSERT_EQ(stats.rows(), 20001);
+    ASSERT_EQ(stats.nullCount(), 1);
+    ASSERT_NEAR(stats.ndv(), 15000, 750);
+    ASSERT_LE(stats.buckets().size(), RSIndexNumber::max_buckets);
+    ASSERT_NEAR(stats.estimateRangeRows(0, 15000), 20000, 1);
+    ASSERT_NEAR(stats.estimateRangeRows(5000, 9999), 10000, 1500);
+}
+
+TEST(RSIndexNumberTest, WriteAndRead)
+{
+    RSIndexNumber stats;
+    stats.addPack(*createColumn<Nullable<Float64>>({1.5, 2.5, std::nullopt, 100.0}).column, nullptr);
+    stats.finalize();
+
+    WriteBufferFromOwnString write_buf;
+    stats.write(write_buf);
+    const auto & data = write_buf.releaseStr();
+
+    ReadBufferFromString read_buf(data);
+    auto read_stats = RSIndexNumber::read(read_buf, data.size());
+    ASSERT_EQ(read_stats->rows(), stats.rows());
+    ASSERT_EQ(read_stats->nullCount(), stats.nullCount());
+    ASSERT_EQ(read_stats->ndv(), stats.ndv());
+    ASSERT_EQ(read_stats->buckets().size(), stats.buckets().size());
+    ASSERT_EQ(read_stats->estimateRangeRows(0, 10), stats.estimateRangeRows(0, 10));
+
+    ReadBufferFromString bad_buf(data);
+    ASSERT_THROW(RSIndexNumber::read(bad_buf, data.size() + 1), DB::TiFlashException);
+}
+
+} // namespace DB::DM::tests
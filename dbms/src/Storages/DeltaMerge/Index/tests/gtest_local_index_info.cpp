@@ -244,4 +244,44 @@ try
 }
 CATCH
 
+TEST(LocalIndexInfoTest, EqualityBloomIndexColumns)
+try
+{
+    TiDB::TableInfo table_info;
+    for (const auto & [id, name] : std::vector<std::pair<ColumnID, String>>{{1, "pk"}, {2, "a"}, {3, "b"}, {4, "c"}})
+    {
+        TiDB::ColumnInfo column_info;
+        column_info.name = name;
+        column_info.id = id;
+        table_info.columns.emplace_back(column_info);
+    }
+    auto add_index = [&](IndexID id, const Strings & col_names, bool is_primary, TiDB::SchemaState state) {
+        TiDB::IndexInfo idx;
+        idx.id = id;
+        idx.is_primary = is_primary;
+        idx.state = state;
+        for (const auto & name : col_names)
+        {
+            TiDB::IndexColumnInfo col;
+            col.name = name;
+            idx.idx_cols.emplace_back(col);
+        }
+        table_info.index_infos.emplace_back(idx);
+    };
+    ASSERT_TRUE(getEqualityBloomIndexColumns(table_info).empty());
+
+    add_index(1, {"pk"}, true, TiDB::StatePublic);
+    add_index(2, {"a", "b"}, false, TiDB::StatePublic);
+    add_index(3, {"c"}, false, TiDB::StateWriteReorganization);
+    // Only the leading columns of the public secondary indexes
+    ASSERT_EQ(getEqualityBloomIndexColumns(table_info), std::unordered_set<ColumnID>({2}));
+
+    // The index is kept after the column is renamed
+    table_info.columns[1].name = "a2";
+    table_info.index_infos[1].idx_cols[0].name = "a2";
+    table_info.index_infos[2].state = TiDB::StatePublic;
+    ASSERT_EQ(getEqualityBloomIndexColumns(table_info), std::unordered_set<ColumnID>({2, 4}));
+}
+CATCH
+
 } // namespace DB::DM::tests
@@ -0,0 +1,130 @@
+// Copyright 2024 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <DataTypes/DataTypeString.h>
+#include <IO/Buffer/ReadBufferFromString.h>
+#include <IO/Buffer/WriteBufferFromString.h>
+#include <Storages/DeltaMerge/Filter/RSOperator.h>
+#include <Storages/DeltaMerge/Index/NgramBloomIndex.h>
+#include <TestUtils/FunctionTestUtils.h>
+#include <TestUtils/TiFlashTestBasic.h>
+
+namespace DB::DM::tests
+{
+
+using namespace DB::tests;
+
+namespace
+{
+NgramBloomIndexPtr buildIndex()
+{
+    auto index = std::make_shared<NgramBloomIndex>();
+    // pack 0
+    index->addPack(*createColumn<String>({"error-code-123", "ok"}).column);
+    // pack 1
+    index->addPack(*createColumn<String>({"warning-code-456", "info"}).column);
+    // pack 2, strings shorter than the n-gram size
+    index->addPack(*createColumn<String>({"a", "bc"}).column);
+    // pack 3
+    index->addPack(*createColumn<Nullable<String>>({"error-code-789", std::nullopt}).column);
+    return index;
+}
+} // namespace
+
+TEST(NgramBloomIndexTest, ExtractLikeNgrams)
+{
+    // Literal parts shorter than the n-gram size produce nothing
+    ASSERT_TRUE(NgramBloomIndex::extractLikeNgrams("%ab%", '\\').empty());
+    ASSERT_TRUE(NgramBloomIndex::extractLikeNgrams("a_b%c", '\\').empty());
+
+    // "abc" + "bcd"
+    ASSERT_EQ(NgramBloomIndex::extractLikeNgrams("%abcd%", '\\').size(), 2);
+    // Duplicated n-grams are removed
+    ASSERT_EQ(NgramBloomIndex::extractLikeNgrams("abc%abc", '\\').size(), 1);
+    // "a%b" is a literal with the escaped '%'
+    ASSERT_EQ(NgramBloomIndex::extractLikeNgrams("a\\%b", '\\').size(), 1);
+    ASSERT_EQ(NgramBloomIndex::extractLikeNgrams("a|%b", '|'), NgramBloomIndex::extractLikeNgrams("a\\%b", '\\'));
+}
+
+TEST(NgramBloomIndexTest, CheckNgrams)
+{
+    auto index = buildIndex();
+    ASSERT_EQ(index->size(), 4);
+
+    {
+        auto ngrams = NgramBloomIndex::extractLikeNgrams("%error-code%", '\\');
+        auto results = index->checkNgrams(0, 4, ngrams);
+        ASSERT_EQ(results[0], RSResult::Some);
+        ASSERT_EQ(results[1], RSResult::None);
+        ASSERT_EQ(results[2], RSResult::None);
+        ASSERT_EQ(results[3], RSResult::SomeNull);
+    }
+    {
+        auto ngrams = NgramBloomIndex::extractLikeNgrams("%code-456", '\\');
+        auto results = index->checkNgrams(1, 2, ngrams);
+        ASSERT_EQ(results.size(), 2);
+        ASSERT_EQ(results[0], RSResult::Some);
+        ASSERT_EQ(results[1], RSResult::None);
+    }
+    {
+        // No n-gram can be extracted, can not skip any pack
+        auto results = index->checkNgrams(0, 4, {});
+        for (const auto & res : results)
+            ASSERT_EQ(res, RSResult::Some);
+    }
+}
+
+TEST(NgramBloomIndexTest, WriteAndRead)
+{
+    auto index = buildIndex();
+    WriteBufferFromOwnString write_buf;
+    index->write(write_buf);
+    const auto & data = write_buf.releaseStr();
+
+    ReadBufferFromString read_buf(data);
+    auto read_index = NgramBloomIndex::read(read_buf, data.size());
+    ASSERT_EQ(read_index->size(), index->size());
+    ASSERT_EQ(read_index->byteSize(), index->byteSize());
+
+    auto ngrams = NgramBloomIndex::extractLikeNgrams("%error-code%", '\\');
+    ASSERT_EQ(read_index->checkNgrams(0, 4, ngrams), index->checkNgrams(0, 4, ngrams));
+
+    ReadBufferFromString bad_buf(data);
+    ASSERT_THROW(NgramBloomIndex::read(bad_buf, data.size() + 1), DB::TiFlashException);
+}
+
+TEST(NgramBloomIndexTest, LikeRoughCheck)
+{
+    Attr attr{"s", 1, std::make_shared<DataTypeString>()};
+    RSCheckParam param;
+    auto like = createLike(attr, Field(String("%warning%")), '\\');
+
+    // Without the index, every pack may match
+    for (const auto & res : like->roughCheck(0, 4, param))
+        ASSERT_EQ(res, RSResult::Some);
+
+    param.ngram_bloom_indexes.emplace(1, buildIndex());
+    auto results = like->roughCheck(0, 4, param);
+    ASSERT_EQ(results[0], RSResult::None);
+    ASSERT_EQ(results[1], RSResult::Some);
+    ASSERT_EQ(results[2], RSResult::None);
+    ASSERT_EQ(results[3], RSResult::NoneNull);
+
+    auto not_like = createNot(like);
+    results = not_like->roughCheck(0, 4, param);
+    ASSERT_EQ(results[0], RSResult::All);
+    ASSERT_EQ(results[1], RSResult::Some);
+}
+
+} // namespace DB::DM::tests
@@ -45,6 +45,7 @@ public:
         , ref_no(0)
         , task_pool_added(false)
         , runtime_filter_list(runtime_filter_list_)
+        , row_filter_rf_list(RuntimeFilterMgr::getRowFilterList(runtime_filter_list_))
         , max_wait_time_ms(max_wait_time_ms_)
         , is_disagg(is_disagg_)
     {
@@ -74,6 +75,7 @@ public:
     void setRuntimeFilterInfo(const RuntimeFilterList & runtime_filter_list_, int max_wait_time_ms_)
     {
         runtime_filter_list = runtime_filter_list_;
+        row_filter_rf_list = RuntimeFilterMgr::getRowFilterList(runtime_filter_list_);
         max_wait_time_ms = max_wait_time_ms_;
     }
 
@@ -100,6 +102,7 @@ protected:
             task_pool->popBlock(res);
             if (res)
             {
+                RuntimeFilterMgr::applyRowFilters(row_filter_rf_list, res);
                 if (res.rows() > 0)
                 {
                     total_rows += res.rows();
@@ -175,6 +178,8 @@ private:
 
     // runtime filter
     std::vector<RuntimeFilterPtr> runtime_filter_list;
+    // the rfs which are applied on the rows read from the storage, such as bloom filter
+    std::vector<RuntimeFilterPtr> row_filter_rf_list;
     int max_wait_time_ms;
 
     std::vector<ConnectionProfileInfo> connection_profile_infos;
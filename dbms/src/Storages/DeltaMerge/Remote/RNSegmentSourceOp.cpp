@@ -14,6 +14,7 @@
 
 #include <Common/FailPoint.h>
 #include <Common/TiFlashMetrics.h>
+#include <Flash/Pipeline/Schedule/Tasks/NotifyFuture.h>
 #include <Storages/DeltaMerge/Remote/RNSegmentSourceOp.h>
 #include <Storages/DeltaMerge/Remote/RNWorkers.h>
 
@@ -51,11 +52,22 @@ void RNSegmentSourceOp::operatePrefixImpl()
 OperatorStatus RNSegmentSourceOp::startGettingNextReadyTask()
 {
     // Start timing the time of get next ready task.
-    wait_stop_watch.start();
-    // A quick try to get the next task to reduce the overhead of switching to WaitReactor.
+    // When re-entering after being notified, the stopwatch is already timing.
+    if (!waiting_ready_task)
+    {
+        wait_stop_watch.start();
+        waiting_ready_task = true;
+    }
+    // A quick try to get the next task to avoid registering to the notify future.
     return awaitImpl();
 }
 
+void RNSegmentSourceOp::finishWaitingReadyTask()
+{
+    duration_wait_ready_task_sec += wait_stop_watch.elapsedSeconds();
+    waiting_ready_task = false;
+}
+
 OperatorStatus RNSegmentSourceOp::readImpl(Block & block)
 {
     if unlikely (done)
@@ -79,13 +91,13 @@ OperatorStatus RNSegmentSourceOp::awaitImpl()
 {
     if unlikely (done || t_block.has_value())
     {
-        duration_wait_ready_task_sec += wait_stop_watch.elapsedSeconds();
+        finishWaitingReadyTask();
         return OperatorStatus::HAS_OUTPUT;
     }
 
     if unlikely (current_seg_task)
     {
-        duration_wait_ready_task_sec += wait_stop_watch.elapsedSeconds();
+        finishWaitingReadyTask();
         return OperatorStatus::IO_IN;
     }
 
@@ -95,24 +107,26 @@ OperatorStatus RNSegmentSourceOp::awaitImpl()
     case MPMCQueueResult::OK:
         processed_seg_tasks += 1;
         RUNTIME_CHECK(current_seg_task != nullptr);
-        duration_wait_ready_task_sec += wait_stop_watch.elapsedSeconds();
+        finishWaitingReadyTask();
         return OperatorStatus::IO_IN;
     case MPMCQueueResult::EMPTY:
-        return OperatorStatus::WAITING;
+        // Wait until the workers push a ready segment task or close the channel.
+        setNotifyFuture(workers->getReadyNotifyFuture());
+        return OperatorStatus::WAIT_FOR_NOTIFY;
     case MPMCQueueResult::FINISHED:
         current_seg_task = nullptr;
         done = true;
-        duration_wait_ready_task_sec += wait_stop_watch.elapsedSeconds();
+        finishWaitingReadyTask();
         return OperatorStatus::HAS_OUTPUT;
     case MPMCQueueResult::CANCELLED:
         current_seg_task = nullptr;
         done = true;
-        duration_wait_ready_task_sec += wait_stop_watch.elapsedSeconds();
+        finishWaitingReadyTask();
         throw Exception(workers->getReadyChannel()->getCancelReason());
     default:
         current_seg_task = nullptr;
         done = true;
-        duration_wait_ready_task_sec += wait_stop_watch.elapsedSeconds();
+        finishWaitingReadyTask();
         throw Exception(fmt::format("Unexpected pop result {}", magic_enum::enum_name(pop_result)));
     }
 }
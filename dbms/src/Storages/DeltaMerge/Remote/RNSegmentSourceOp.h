@@ -69,6 +69,8 @@ protected:
 private:
     OperatorStatus startGettingNextReadyTask();
 
+    void finishWaitingReadyTask();
+
 private:
     const RNWorkersPtr workers;
     AddExtraTableIDColumnTransformAction action;
@@ -85,6 +87,8 @@ private:
     // Count the time spent waiting for segment tasks to be ready.
     double duration_wait_ready_task_sec = 0;
     Stopwatch wait_stop_watch{CLOCK_MONOTONIC_COARSE};
+    // Whether `wait_stop_watch` is timing, it keeps timing while the task waits for notification.
+    bool waiting_ready_task = false;
 
     // Count the time consumed by reading blocks in the stream of segment tasks.
     double duration_read_sec = 0;
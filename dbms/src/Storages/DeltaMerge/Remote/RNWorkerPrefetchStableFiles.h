@@ -0,0 +1,89 @@
+// Copyright 2024 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Common/Exception.h>
+#include <Common/ThreadedWorker.h>
+#include <Storages/DeltaMerge/Filter/PushDownExecutor.h>
+#include <Storages/DeltaMerge/SegmentReadTask.h>
+
+#include <boost/noncopyable.hpp>
+
+namespace DB::DM::Remote
+{
+
+class RNWorkerPrefetchStableFiles;
+using RNWorkerPrefetchStableFilesPtr = std::shared_ptr<RNWorkerPrefetchStableFiles>;
+
+/// Warm the local file cache with the stable files of the segment read tasks, so that the
+/// downloading from S3 is overlapped with the following stages instead of stalling the reading.
+class RNWorkerPrefetchStableFiles
+    : private boost::noncopyable
+    , public ThreadedWorker<SegmentReadTaskPtr, SegmentReadTaskPtr>
+{
+protected:
+    SegmentReadTaskPtr doWork(const SegmentReadTaskPtr & task) override
+    {
+        try
+        {
+            task->prefetchStableFiles(*columns_to_read, push_down_executor, read_mode);
+        }
+        catch (...)
+        {
+            // Prefetch is best-effort, the files will be read on demand if it fails.
+            tryLogCurrentException(log, fmt::format("Prefetch stable files failed, task={}", task));
+        }
+        return task;
+    }
+
+    String getName() const noexcept override { return "PrefetchStableFiles"; }
+
+public:
+    const ColumnDefinesPtr columns_to_read;
+    const PushDownExecutorPtr push_down_executor;
+    const ReadMode read_mode;
+
+public:
+    struct Options
+    {
+        const std::shared_ptr<MPMCQueue<SegmentReadTaskPtr>> & source_queue;
+        const std::shared_ptr<MPMCQueue<SegmentReadTaskPtr>> & result_queue;
+        const LoggerPtr & log;
+        const size_t concurrency;
+        const ColumnDefinesPtr & columns_to_read;
+        const PushDownExecutorPtr & push_down_executor;
+        const ReadMode read_mode;
+    };
+
+    static RNWorkerPrefetchStableFilesPtr create(const Options & options)
+    {
+        return std::make_shared<RNWorkerPrefetchStableFiles>(options);
+    }
+
+    explicit RNWorkerPrefetchStableFiles(const Options & options)
+        : ThreadedWorker<SegmentReadTaskPtr, SegmentReadTaskPtr>(
+            options.source_queue,
+            options.result_queue,
+            options.log,
+            options.concurrency)
+        , columns_to_read(options.columns_to_read)
+        , push_down_executor(options.push_down_executor)
+        , read_mode(options.read_mode)
+    {}
+
+    ~RNWorkerPrefetchStableFiles() override { wait(); }
+};
+
+} // namespace DB::DM::Remote
@@ -15,6 +15,8 @@
 #pragma once
 
 #include <Common/ThreadedWorker.h>
+#include <Flash/Pipeline/Schedule/Tasks/NotifyFuture.h>
+#include <Flash/Pipeline/Schedule/Tasks/PipeConditionVariable.h>
 #include <Interpreters/Context.h>
 #include <Storages/DeltaMerge/DMContext.h>
 #include <Storages/DeltaMerge/Filter/PushDownExecutor.h>
@@ -31,9 +33,12 @@ using RNWorkerPrepareStreamsPtr = std::shared_ptr<RNWorkerPrepareStreams>;
 /// This worker prepare data streams for reading.
 /// For example, when S3 files of the stable layer does not exist locally,
 /// they will be downloaded.
+/// It is the last worker of RNWorkers, pipeline tasks waiting for a ready segment are registered on it
+/// and notified when a segment is pushed into the result queue or the result queue is closed.
 class RNWorkerPrepareStreams
     : private boost::noncopyable
     , public ThreadedWorker<SegmentReadTaskPtr, SegmentReadTaskPtr>
+    , public NotifyFuture
 {
 protected:
     SegmentReadTaskPtr doWork(const SegmentReadTaskPtr & task) override
@@ -51,6 +56,35 @@ protected:
 
     String getName() const noexcept override { return "PrepareStreams"; }
 
+    void onResultPushed() override
+    {
+        std::lock_guard lock(notify_mu);
+        pipe_cv.notifyOne();
+    }
+
+    void onResultQueueClosed() override
+    {
+        std::lock_guard lock(notify_mu);
+        pipe_cv.notifyAll();
+    }
+
+public:
+    void registerTask(TaskPtr && task) override
+    {
+        {
+            // The result queue is changed under its own mutex, `notify_mu` makes sure the task registered
+            // after seeing an empty queue will be notified by the following push or close.
+            std::lock_guard lock(notify_mu);
+            if (result_queue->size() == 0 && result_queue->getStatus() == MPMCQueueStatus::NORMAL)
+            {
+                task->setNotifyType(NotifyType::WAIT_ON_TABLE_SCAN_READ);
+                pipe_cv.registerTask(std::move(task));
+                return;
+            }
+        }
+        PipeConditionVariable::notifyTaskDirectly(std::move(task));
+    }
+
 public:
     const ColumnDefinesPtr columns_to_read;
     const UInt64 start_ts;
@@ -88,6 +122,10 @@ public:
     {}
 
     ~RNWorkerPrepareStreams() override { wait(); }
+
+private:
+    std::mutex notify_mu;
+    PipeConditionVariable pipe_cv;
 };
 
 } // namespace DB::DM::Remote
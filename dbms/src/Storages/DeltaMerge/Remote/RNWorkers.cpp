@@ -32,9 +32,16 @@ RNWorkers::RNWorkers(
         return;
     }
 
+    auto prefetch_stable_concurrency = n;
     auto fetch_pages_concurrency = n;
     auto prepare_streams_concurrency = n;
     const auto & settings = context.getSettingsRef();
+    if (settings.dt_prefetch_stable_concurrency_scale > 0.0)
+    {
+        prefetch_stable_concurrency = std::min(
+            std::ceil(num_streams * settings.dt_prefetch_stable_concurrency_scale),
+            prefetch_stable_concurrency);
+    }
     if (settings.dt_fetch_page_concurrency_scale > 0.0)
     {
         fetch_pages_concurrency
@@ -47,8 +54,24 @@ RNWorkers::RNWorkers(
             prepare_streams_concurrency);
     }
 
+    // The stable files are prefetched in background before fetching pages, so that downloading them from S3
+    // is overlapped with fetching pages and preparing streams.
+    if (settings.dt_prefetch_stable_concurrency_scale > 0.0)
+    {
+        worker_prefetch_stable_files = RNWorkerPrefetchStableFiles::create({
+            .source_queue = std::make_shared<Channel>(n),
+            .result_queue = std::make_shared<Channel>(n),
+            .log = options.log,
+            .concurrency = prefetch_stable_concurrency,
+            .columns_to_read = options.columns_to_read,
+            .push_down_executor = options.push_down_executor,
+            .read_mode = options.read_mode,
+        });
+    }
+
     worker_fetch_pages = RNWorkerFetchPages::create({
-        .source_queue = std::make_shared<Channel>(n),
+        .source_queue = worker_prefetch_stable_files ? worker_prefetch_stable_files->result_queue
+                                                     : std::make_shared<Channel>(n),
         .result_queue = std::make_shared<Channel>(n),
         .log = options.log,
         .concurrency = fetch_pages_concurrency,
@@ -66,18 +89,22 @@ RNWorkers::RNWorkers(
     });
 
     // TODO: Can we push the task that all delta/stable data hit local cache first?
+    const auto & source_queue
+        = worker_prefetch_stable_files ? worker_prefetch_stable_files->source_queue : worker_fetch_pages->source_queue;
     for (auto const & seg_task : read_tasks)
     {
-        auto push_result = worker_fetch_pages->source_queue->tryPush(seg_task);
+        auto push_result = source_queue->tryPush(seg_task);
         RUNTIME_CHECK(push_result == MPMCQueueResult::OK, magic_enum::enum_name(push_result));
     }
-    worker_fetch_pages->source_queue->finish();
+    source_queue->finish();
 }
 
 void RNWorkers::startInBackground()
 {
     if (!empty_channel)
     {
+        if (worker_prefetch_stable_files)
+            worker_prefetch_stable_files->startInBackground();
         worker_fetch_pages->startInBackground();
         worker_prepare_streams->startInBackground();
     }
@@ -87,6 +114,8 @@ void RNWorkers::wait()
 {
     if (!empty_channel)
     {
+        if (worker_prefetch_stable_files)
+            worker_prefetch_stable_files->wait();
         worker_fetch_pages->wait();
         worker_prepare_streams->wait();
     }
@@ -98,4 +127,11 @@ RNWorkers::ChannelPtr RNWorkers::getReadyChannel() const
         return empty_channel;
     return worker_prepare_streams->result_queue;
 }
+
+NotifyFuture * RNWorkers::getReadyNotifyFuture() const
+{
+    // The empty channel is always finished, nobody should wait on it.
+    RUNTIME_CHECK(!empty_channel);
+    return worker_prepare_streams.get();
+}
 } // namespace DB::DM::Remote
@@ -16,6 +16,7 @@
 
 #include <Common/MPMCQueue.h>
 #include <Storages/DeltaMerge/Remote/RNWorkerFetchPages.h>
+#include <Storages/DeltaMerge/Remote/RNWorkerPrefetchStableFiles.h>
 #include <Storages/DeltaMerge/Remote/RNWorkerPrepareStreams.h>
 #include <Storages/DeltaMerge/Remote/RNWorkers_fwd.h>
 
@@ -35,6 +36,10 @@ public:
     /// Get the channel which outputs ready-for-read segment tasks.
     ChannelPtr getReadyChannel() const;
 
+    /// Get the future to wait on when the ready channel is empty, it is notified when a segment task
+    /// is pushed into the ready channel or the ready channel is closed.
+    NotifyFuture * getReadyNotifyFuture() const;
+
     void startInBackground();
 
     void wait();
@@ -65,6 +70,8 @@ public:
 private:
     ChannelPtr empty_channel;
 
+    // nullptr if prefetching stable files is disabled.
+    RNWorkerPrefetchStableFilesPtr worker_prefetch_stable_files;
     RNWorkerFetchPagesPtr worker_fetch_pages;
     RNWorkerPrepareStreamsPtr worker_prepare_streams;
 };
@@ -100,6 +100,8 @@ public:
     std::atomic<uint64_t> mvcc_input_rows{0};
     std::atomic<uint64_t> mvcc_input_bytes{0};
     std::atomic<uint64_t> mvcc_output_rows{0};
+    // The rows removed by the threshold of the TopN above the table scan, only recorded locally.
+    std::atomic<uint64_t> topn_threshold_filtered_rows{0};
 
     // Learner read
     std::atomic<uint64_t> learner_read_ns{0};
@@ -388,6 +390,7 @@ public:
         mvcc_input_rows += other.mvcc_input_rows;
         mvcc_input_bytes += other.mvcc_input_bytes;
         mvcc_output_rows += other.mvcc_output_rows;
+        topn_threshold_filtered_rows += other.topn_threshold_filtered_rows;
 
         learner_read_ns += other.learner_read_ns;
         create_snapshot_time_ns += other.create_snapshot_time_ns;
@@ -23,6 +23,7 @@
 #include <DataStreams/ExpressionBlockInputStream.h>
 #include <DataStreams/FilterBlockInputStream.h>
 #include <DataStreams/SquashingBlockInputStream.h>
+#include <DataStreams/TopNThreshold.h>
 #include <Interpreters/Context.h>
 #include <Interpreters/SharedContexts/Disagg.h>
 #include <Poco/Logger.h>
@@ -180,7 +181,11 @@ DMFilePtr writeIntoNewDMFile(
         dm_context.global_context.getSettingsRef().dt_small_file_size_threshold,
         dm_context.global_context.getSettingsRef().dt_merged_file_max_size,
         dm_context.keyspace_id);
-    auto output_stream = std::make_shared<DMFileBlockOutputStream>(dm_context.global_context, dmfile, *schema_snap);
+    auto output_stream = std::make_shared<DMFileBlockOutputStream>(
+        dm_context.global_context,
+        dmfile,
+        *schema_snap,
+        dm_context.equality_bloom_index_columns);
     const auto * mvcc_stream
         = typeid_cast<const DMVersionFilterBlockInputStream<DMVersionFilterMode::COMPACT> *>(input_stream.get());
 
@@ -1026,6 +1031,14 @@ BlockInputStreamPtr Segment::getInputStream(
     if (real_ranges.empty())
         return std::make_shared<EmptyBlockInputStream>(toEmptyBlock(columns_to_read));
 
+    auto rs_filter = executor ? executor->rs_operator : EMPTY_RS_OPERATOR;
+    if (executor && executor->topn_threshold)
+    {
+        // The threshold of TopN becomes tighter while reading, take the latest one for this segment.
+        if (auto topn_filter = executor->topn_threshold->parseToRSOperator(); topn_filter)
+            rs_filter = rs_filter ? createAnd({rs_filter, topn_filter}) : topn_filter;
+    }
+
     // load DMilePackFilterResult for each DMFile
     // Note that the ranges must be shrunk by the segment key-range
     DMFilePackFilterResults pack_filter_results;
@@ -1037,7 +1050,7 @@ BlockInputStreamPtr Segment::getInputStream(
             dmfile,
             /*set_cache_if_miss*/ true,
             real_ranges,
-            executor ? executor->rs_operator : EMPTY_RS_OPERATOR,
+            rs_filter,
             /*read_pack*/ {});
         pack_filter_results.push_back(result);
     }
@@ -3106,14 +3119,29 @@ BitmapFilterPtr Segment::buildMVCCBitmapFilter(
     {
         if (enable_version_chain)
         {
+            const bool enable_cache = dm_context.mvcc_bitmap_cache_entries > 0;
+            std::optional<MVCCBitmapCache::Key> cache_key;
+            if (enable_cache)
+            {
+                cache_key = MVCCBitmapCache::Key::create(*segment_snap, read_ranges, pack_filter_results);
+                if (auto bitmap_filter = mvcc_bitmap_cache.get(*cache_key, start_ts); bitmap_filter)
+                    return bitmap_filter;
+            }
+
             consumeBuildMVCCReadBytesRU(dm_context, segment_snap, pack_filter_results, start_ts);
-            return ::DB::DM::buildMVCCBitmapFilter(
+            ReadTsRange valid_read_ts;
+            auto bitmap_filter = ::DB::DM::buildMVCCBitmapFilter(
                 dm_context,
                 *segment_snap,
                 read_ranges,
                 pack_filter_results,
                 start_ts,
-                *version_chain);
+                *version_chain,
+                valid_read_ts);
+            if (enable_cache)
+                mvcc_bitmap_cache
+                    .put(std::move(*cache_key), valid_read_ts, bitmap_filter, dm_context.mvcc_bitmap_cache_entries);
+            return bitmap_filter;
         }
     }
 
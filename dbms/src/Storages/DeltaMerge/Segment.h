@@ -29,6 +29,7 @@
 #include <Storages/DeltaMerge/Segment_fwd.h>
 #include <Storages/DeltaMerge/SkippableBlockInputStream.h>
 #include <Storages/DeltaMerge/StableValueSpace.h>
+#include <Storages/DeltaMerge/VersionChain/MVCCBitmapCache.h>
 #include <Storages/DeltaMerge/VersionChain/VersionChain.h>
 #include <Storages/KVStore/MultiRaft/Disagg/CheckpointInfo.h>
 #include <Storages/KVStore/MultiRaft/Disagg/fast_add_peer.pb.h>
@@ -876,6 +877,8 @@ public:
     const LoggerPtr log;
 
     GenericVersionChainPtr version_chain;
+    // The MVCC bitmaps built by `version_chain` recently, shared by the queries reading this segment.
+    MVCCBitmapCache mvcc_bitmap_cache;
 };
 
 void readSegmentMetaInfo(ReadBuffer & buf, Segment::SegmentMetaInfo & segment_info);
@@ -19,6 +19,8 @@
 #include <Interpreters/SharedContexts/Disagg.h>
 #include <Storages/DeltaMerge/ColumnFile/ColumnFileDataProvider.h>
 #include <Storages/DeltaMerge/DMContext.h>
+#include <Storages/DeltaMerge/File/DMFilePackFilter.h>
+#include <Storages/DeltaMerge/Filter/PushDownExecutor.h>
 #include <Storages/DeltaMerge/Remote/RNDataProvider.h>
 #include <Storages/DeltaMerge/Remote/Serializer.h>
 #include <Storages/DeltaMerge/RowKeyRangeUtils.h>
@@ -26,6 +28,8 @@
 #include <Storages/KVStore/KVStore.h>
 #include <Storages/KVStore/TMTContext.h>
 #include <Storages/Page/V3/Universal/UniversalWriteBatchImpl.h>
+#include <Storages/S3/FileCache.h>
+#include <Storages/S3/S3Filename.h>
 #include <common/logger_useful.h>
 
 using namespace std::chrono_literals;
@@ -348,6 +352,94 @@ void SegmentReadTask::doInitInputStream(
 }
 
 
+std::vector<std::pair<String, UInt64>> SegmentReadTask::getStableFilesToPrefetch(
+    const ColumnDefines & columns_to_read,
+    const PushDownExecutorPtr & push_down_executor,
+    ReadMode read_mode) const
+{
+    std::vector<ColId> col_ids;
+    col_ids.reserve(columns_to_read.size() + 3);
+    for (const auto & cd : columns_to_read)
+        col_ids.push_back(cd.id);
+    if (read_mode == ReadMode::Normal || read_mode == ReadMode::Bitmap)
+    {
+        // The MVCC columns are also read to filter out the invisible versions.
+        col_ids.push_back(MutSup::extra_handle_id);
+        col_ids.push_back(MutSup::version_col_id);
+        col_ids.push_back(MutSup::delmark_col_id);
+    }
+
+    const auto & filter = push_down_executor ? push_down_executor->rs_operator : EMPTY_RS_OPERATOR;
+    std::vector<std::pair<String, UInt64>> files;
+    std::unordered_set<String> added;
+    for (const auto & dmfile : read_snapshot->stable->getDMFiles())
+    {
+        // The min-max indexes are loaded here, and they are kept in the index cache for the coming read.
+        auto pack_filter_result = DMFilePackFilter::loadFrom(
+            *dm_context,
+            dmfile,
+            /*set_cache_if_miss*/ true,
+            ranges,
+            filter,
+            /*read_packs*/ {});
+        if (pack_filter_result->countUsePack() == 0)
+            continue;
+
+        for (const auto col_id : col_ids)
+        {
+            for (auto & [fname, fsize] : dmfile->listColumnFiles(col_id))
+            {
+                if (added.emplace(fname).second)
+                    files.emplace_back(std::move(fname), fsize);
+            }
+        }
+    }
+    return files;
+}
+
+void SegmentReadTask::prefetchStableFiles(
+    const ColumnDefines & columns_to_read,
+    const PushDownExecutorPtr & push_down_executor,
+    ReadMode read_mode)
+{
+    // Not remote segment.
+    if (!extra_remote_info.has_value())
+        return;
+    auto * file_cache = FileCache::instance();
+    if (file_cache == nullptr)
+        return;
+
+    Stopwatch watch_work{CLOCK_MONOTONIC_COARSE};
+    SCOPE_EXIT({
+        GET_METRIC(tiflash_disaggregated_breakdown_duration_seconds, type_worker_prefetch_stable)
+            .Observe(watch_work.elapsedSeconds());
+    });
+
+    size_t n_prefetched = 0;
+    auto files = getStableFilesToPrefetch(columns_to_read, push_down_executor, read_mode);
+    for (const auto & [fname, fsize] : files)
+    {
+        auto s3_fname = S3::S3FilenameView::fromKeyWithPrefix(fname);
+        if (!s3_fname.isValid())
+            continue;
+        // The file is cached by ranges, the blocks of the packs to read are downloaded when they are read.
+        // Downloading the whole object here would double the S3 traffic and the cache usage.
+        if (file_cache->getRangeBlockSize(s3_fname) > 0)
+            continue;
+        // `get` returns immediately. If the file is not cached, it is downloaded in background,
+        // and the download is bounded by the S3ReadLimiter and the download concurrency of FileCache.
+        file_cache->get(s3_fname, fsize);
+        GET_METRIC(tiflash_disaggregated_details, type_stable_file_prefetch).Increment();
+        ++n_prefetched;
+    }
+    LOG_DEBUG(
+        read_snapshot->log,
+        "Prefetch stable files finished, n_files={} n_prefetched={} cost={:.3f}s",
+        files.size(),
+        n_prefetched,
+        watch_work.elapsedSeconds());
+}
+
 void SegmentReadTask::fetchPages()
 {
     // Not remote segment.
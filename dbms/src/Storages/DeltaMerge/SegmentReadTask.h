@@ -105,6 +105,21 @@ public:
 
     void fetchPages();
 
+    // Schedule the background downloads of the stable files that will be read by this task into the local
+    // file cache, so that the S3 latency is overlapped with fetching pages and preparing streams.
+    // Only the files of the DMFiles that have packs remaining after filtering by `ranges` and the pushed-down
+    // filter are downloaded. The files that are cached by ranges are skipped.
+    void prefetchStableFiles(
+        const ColumnDefines & columns_to_read,
+        const PushDownExecutorPtr & push_down_executor,
+        ReadMode read_mode);
+
+    // Return the path and size of the stable files that `prefetchStableFiles` may download.
+    std::vector<std::pair<String, UInt64>> getStableFilesToPrefetch(
+        const ColumnDefines & columns_to_read,
+        const PushDownExecutorPtr & push_down_executor,
+        ReadMode read_mode) const;
+
     void initInputStream(
         const ColumnDefines & columns_to_read,
         UInt64 start_ts,
@@ -192,6 +192,8 @@ public:
         }
     }
 
+    TopNThresholdPtr getTopNThreshold() const { return executor ? executor->topn_threshold : nullptr; }
+
     bool isRUExhausted();
 
     const LoggerPtr & getLogger() const { return log; }
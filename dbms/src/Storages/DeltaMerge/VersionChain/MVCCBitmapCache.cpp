@@ -0,0 +1,76 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/TiFlashMetrics.h>
+#include <Storages/DeltaMerge/File/DMFilePackFilterResult.h>
+#include <Storages/DeltaMerge/Segment.h>
+#include <Storages/DeltaMerge/VersionChain/MVCCBitmapCache.h>
+
+namespace DB::DM
+{
+MVCCBitmapCache::Key MVCCBitmapCache::Key::create(
+    const SegmentSnapshot & snapshot,
+    const RowKeyRanges & read_ranges,
+    const DMFilePackFilterResults & pack_filter_results)
+{
+    RUNTIME_CHECK(pack_filter_results.size() == 1, pack_filter_results.size());
+    const auto & stable_filter_res = pack_filter_results[0];
+    return Key{
+        .stable_id = snapshot.stable->getId(),
+        .delta_rows = snapshot.delta->getRows(),
+        .delta_deletes = snapshot.delta->getDeletes(),
+        .read_ranges = read_ranges,
+        .handle_res = stable_filter_res->getHandleRes(),
+        .pack_res = stable_filter_res->getPackRes(),
+    };
+}
+
+BitmapFilterPtr MVCCBitmapCache::get(const Key & key, UInt64 read_ts)
+{
+    std::lock_guard lock(mtx);
+    for (auto itr = entries.begin(); itr != entries.end(); ++itr)
+    {
+        if (itr->valid_read_ts.contains(read_ts) && itr->key == key)
+        {
+            // Move to the front as the most recently used
+            entries.splice(entries.begin(), entries, itr);
+            GET_METRIC(tiflash_storage_mvcc_bitmap_cache, type_hit).Increment();
+            return itr->bitmap;
+        }
+    }
+    GET_METRIC(tiflash_storage_mvcc_bitmap_cache, type_miss).Increment();
+    return nullptr;
+}
+
+void MVCCBitmapCache::put(
+    Key && key,
+    const ReadTsRange & valid_read_ts,
+    const BitmapFilterPtr & bitmap,
+    size_t capacity)
+{
+    if (capacity == 0)
+        return;
+
+    std::lock_guard lock(mtx);
+    entries.push_front(Entry{.key = std::move(key), .valid_read_ts = valid_read_ts, .bitmap = bitmap});
+    while (entries.size() > capacity)
+        entries.pop_back();
+}
+
+size_t MVCCBitmapCache::size() const
+{
+    std::lock_guard lock(mtx);
+    return entries.size();
+}
+} // namespace DB::DM
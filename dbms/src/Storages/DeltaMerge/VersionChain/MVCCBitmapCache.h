@@ -0,0 +1,86 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Storages/DeltaMerge/File/DMFilePackFilter_fwd.h>
+#include <Storages/DeltaMerge/Index/RSResult.h>
+#include <Storages/DeltaMerge/RowKeyRange.h>
+#include <Storages/DeltaMerge/VersionChain/VersionFilter.h>
+#include <Storages/Page/PageDefinesBase.h>
+
+#include <boost/noncopyable.hpp>
+#include <list>
+#include <mutex>
+
+namespace DB::DM
+{
+struct SegmentSnapshot;
+class BitmapFilter;
+using BitmapFilterPtr = std::shared_ptr<BitmapFilter>;
+
+/**
+ * Keeps the recent MVCC bitmaps built by the version chain of a segment, so that the concurrent queries
+ * reading the same segment can share the bitmap instead of building it again.
+ *
+ * A bitmap is reused only if it is provably the same as building a new one:
+ * - The snapshot has the same data, i.e. the same stable and the same number of rows and deletes in delta.
+ *   The delta of a segment is append-only, so its data is identified by the number of rows and deletes.
+ * - The read_ranges and the pack filter results are the same, they are used by the row key filter.
+ * - The read_ts is in the `ReadTsRange` of the bitmap, i.e. no version in the snapshot is between
+ *   the read_ts and the read_ts used to build the bitmap.
+ *
+ * The cached bitmaps are shared by queries, so they must not be modified after put into the cache.
+ */
+class MVCCBitmapCache : private boost::noncopyable
+{
+public:
+    struct Key
+    {
+        PageIdU64 stable_id;
+        size_t delta_rows;
+        size_t delta_deletes;
+        RowKeyRanges read_ranges;
+        RSResults handle_res;
+        RSResults pack_res;
+
+        static Key create(
+            const SegmentSnapshot & snapshot,
+            const RowKeyRanges & read_ranges,
+            const DMFilePackFilterResults & pack_filter_results);
+
+        bool operator==(const Key & other) const = default;
+    };
+
+    // Return the bitmap built with the same `key` and `read_ts` is in its valid range, or nullptr if not found.
+    BitmapFilterPtr get(const Key & key, UInt64 read_ts);
+
+    // Keep at most `capacity` bitmaps, the least recently used bitmaps are evicted.
+    void put(Key && key, const ReadTsRange & valid_read_ts, const BitmapFilterPtr & bitmap, size_t capacity);
+
+    size_t size() const;
+
+private:
+    struct Entry
+    {
+        Key key;
+        ReadTsRange valid_read_ts;
+        BitmapFilterPtr bitmap;
+    };
+
+    mutable std::mutex mtx;
+    // The most recently used entry is at the front.
+    std::list<Entry> entries;
+};
+} // namespace DB::DM
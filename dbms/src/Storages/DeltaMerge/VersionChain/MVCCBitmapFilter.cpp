@@ -32,7 +32,8 @@ BitmapFilterPtr buildMVCCBitmapFilter(
     const RowKeyRanges & read_ranges,
     const DMFilePackFilterResults & pack_filter_results,
     const UInt64 read_ts,
-    VersionChain<HandleType> & version_chain)
+    VersionChain<HandleType> & version_chain,
+    ReadTsRange & valid_read_ts)
 {
     Stopwatch sw;
     RUNTIME_CHECK(pack_filter_results.size() == 1, pack_filter_results.size());
@@ -49,7 +50,8 @@ BitmapFilterPtr buildMVCCBitmapFilter(
         *base_ver_snap,
         read_ts,
         stable_filter_res,
-        *bitmap_filter);
+        *bitmap_filter,
+        valid_read_ts);
     const auto build_version_filter_ms = sw.elapsedMillisecondsFromLastTime();
 
     const auto rowkey_filtered_out_rows
@@ -62,7 +64,8 @@ BitmapFilterPtr buildMVCCBitmapFilter(
 
     // The sum of `*_filtered_out_rows` may greater than the actual number of rows that are filtered out,
     // because the same row may be filtered out by multiple filters and counted multiple times.
-    bitmap_filter->setAllMatch(rowkey_filtered_out_rows + version_filtered_out_rows + delete_filtered_out_rows == 0);
+    // So `all_match` is updated by `runOptimize`, which also selects the representation by density.
+    bitmap_filter->runOptimize();
 
     GET_METRIC(tiflash_storage_version_chain_ms, type_replay).Observe(replay_ms);
     GET_METRIC(tiflash_storage_version_chain_ms, type_version_filter).Observe(build_version_filter_ms);
@@ -91,7 +94,8 @@ template BitmapFilterPtr buildMVCCBitmapFilter<Int64>(
     const RowKeyRanges & read_ranges,
     const DMFilePackFilterResults & pack_filter_results,
     const UInt64 read_ts,
-    VersionChain<Int64> & version_chain);
+    VersionChain<Int64> & version_chain,
+    ReadTsRange & valid_read_ts);
 
 template BitmapFilterPtr buildMVCCBitmapFilter<String>(
     const DMContext & dm_context,
@@ -99,7 +103,8 @@ template BitmapFilterPtr buildMVCCBitmapFilter<String>(
     const RowKeyRanges & read_ranges,
     const DMFilePackFilterResults & pack_filter_results,
     const UInt64 read_ts,
-    VersionChain<String> & version_chain);
+    VersionChain<String> & version_chain,
+    ReadTsRange & valid_read_ts);
 
 BitmapFilterPtr buildMVCCBitmapFilter(
     const DMContext & dm_context,
@@ -107,7 +112,8 @@ BitmapFilterPtr buildMVCCBitmapFilter(
     const RowKeyRanges & read_ranges,
     const DMFilePackFilterResults & pack_filter_results,
     const UInt64 read_ts,
-    GenericVersionChain & generic_version_chain)
+    GenericVersionChain & generic_version_chain,
+    ReadTsRange & valid_read_ts)
 {
     return std::visit(
         [&](auto & version_chain) {
@@ -117,7 +123,8 @@ BitmapFilterPtr buildMVCCBitmapFilter(
                 read_ranges,
                 pack_filter_results,
                 read_ts,
-                version_chain);
+                version_chain,
+                valid_read_ts);
         },
         generic_version_chain);
 }
@@ -16,6 +16,7 @@
 
 #include <Storages/DeltaMerge/VersionChain/Common.h>
 #include <Storages/DeltaMerge/VersionChain/VersionChain.h>
+#include <Storages/DeltaMerge/VersionChain/VersionFilter.h>
 
 namespace DB::DM
 {
@@ -29,6 +30,8 @@ using BitmapFilterPtr = std::shared_ptr<BitmapFilter>;
 
 // buildMVCCBitmapFilter calls buildVersionFilter, buildRowKeyFilter, and buildDeleteMarkFilter,
 // returning a result consistent with Segment::buildMVCCBitmapFilterNormal/Segment::buildMVCCBitmapFilterStableOnly.
+// `valid_read_ts` is set to the range of read_ts that builds the same bitmap with the same snapshot,
+// read_ranges and pack_filter_results.
 template <ExtraHandleType HandleType>
 BitmapFilterPtr buildMVCCBitmapFilter(
     const DMContext & dm_context,
@@ -36,7 +39,8 @@ BitmapFilterPtr buildMVCCBitmapFilter(
     const RowKeyRanges & read_ranges,
     const DMFilePackFilterResults & pack_filter_results,
     UInt64 read_ts,
-    VersionChain<HandleType> & version_chain);
+    VersionChain<HandleType> & version_chain,
+    ReadTsRange & valid_read_ts);
 
 BitmapFilterPtr buildMVCCBitmapFilter(
     const DMContext & dm_context,
@@ -44,5 +48,6 @@ BitmapFilterPtr buildMVCCBitmapFilter(
     const RowKeyRanges & read_ranges,
     const DMFilePackFilterResults & pack_filter_results,
     UInt64 read_ts,
-    GenericVersionChain & generic_version_chain);
+    GenericVersionChain & generic_version_chain,
+    ReadTsRange & valid_read_ts);
 } // namespace DB::DM
@@ -21,6 +21,8 @@
 #include <Storages/DeltaMerge/VersionChain/NewHandleIndex.h>
 #include <Storages/DeltaMerge/VersionChain/VersionChain_fwd.h>
 
+#include <atomic>
+
 namespace DB::DM
 {
 
@@ -73,6 +75,9 @@ public:
 
     size_t getBytes() const;
 
+    // It can be called without blocking by the replaying, so the result may be outdated.
+    [[nodiscard]] UInt32 getReplayedRowsAndDeletes() const { return replayed_rows_and_deletes.load(); }
+
 #ifdef DBMS_PUBLIC_GTEST
     [[nodiscard]] auto getReplayedRows() const { return base_versions->size(); }
     [[nodiscard]] auto deepCopy() const { return VersionChain(*this); }
@@ -80,7 +85,7 @@ public:
 
 private:
     VersionChain(const VersionChain & other)
-        : replayed_rows_and_deletes(other.replayed_rows_and_deletes)
+        : replayed_rows_and_deletes(other.replayed_rows_and_deletes.load())
         , base_versions(std::make_shared<std::vector<RowID>>(*(other.base_versions)))
         , new_handle_to_row_ids(other.new_handle_to_row_ids)
         , dmfile_or_delete_range_list(other.dmfile_or_delete_range_list)
@@ -143,7 +148,7 @@ private:
     friend class tests::VersionChainTest;
 
     mutable std::mutex mtx;
-    UInt32 replayed_rows_and_deletes = 0; // delta.getRows() + delta.getDeletes()
+    std::atomic<UInt32> replayed_rows_and_deletes = 0; // delta.getRows() + delta.getDeletes()
     // After replaySnapshot, base_versions->size() == delta.getRows().
     // The records in delta correspond one-to-one with base_versions.
     // Base version means the oldest version that has not been garbage collected yet.
@@ -170,6 +175,11 @@ inline size_t getVersionChainBytes(const GenericVersionChain & version_chain)
     return std::visit([](auto && v) { return v.getBytes(); }, version_chain);
 }
 
+inline size_t getVersionChainReplayedRowsAndDeletes(const GenericVersionChain & version_chain)
+{
+    return std::visit([](auto && v) { return v.getReplayedRowsAndDeletes(); }, version_chain);
+}
+
 enum class VersionChainMode : Int64
 {
     // Generating MVCC bitmap by using delta index.
@@ -30,13 +30,15 @@ UInt32 buildVersionFilterVector(
     const std::vector<RowID> & base_ver_snap,
     const UInt32 stable_rows,
     const UInt32 start_row_id,
-    BitmapFilter & filter)
+    BitmapFilter & filter,
+    ReadTsRange & valid_read_ts)
 {
     UInt32 filtered_out_rows = 0;
     // Traverse data from new to old
     for (ssize_t i = versions.size() - 1; i >= 0; --i)
     {
         const UInt32 row_id = start_row_id + i;
+        valid_read_ts.add(versions[i], read_ts);
         // Already filtered out, maybe by newer version.
         if (!filter[row_id])
             continue;
@@ -76,7 +78,8 @@ UInt32 buildVersionFilterVector(
     const std::vector<RowID> & base_ver_snap,
     const UInt32 stable_rows,
     const UInt32 start_row_id,
-    BitmapFilter & filter)
+    BitmapFilter & filter,
+    ReadTsRange & valid_read_ts)
 {
     assert(cf.isInMemoryFile() || cf.isTinyFile() || cf.isBigFile());
     static const auto version_cds_ptr = std::make_shared<ColumnDefines>(1, getVersionColumnDefine());
@@ -94,8 +97,14 @@ UInt32 buildVersionFilterVector(
         ++read_block_count;
         read_rows += block.rows();
         const auto & versions = *toColumnVectorDataPtr<UInt64>(block.begin()->column);
-        filtered_out_rows
-            += buildVersionFilterVector(versions, read_ts, base_ver_snap, stable_rows, start_row_id, filter);
+        filtered_out_rows += buildVersionFilterVector(
+            versions,
+            read_ts,
+            base_ver_snap,
+            stable_rows,
+            start_row_id,
+            filter,
+            valid_read_ts);
     }
 
     RUNTIME_CHECK(cf.getRows() == read_rows, cf.toString(), read_rows);
@@ -118,7 +127,8 @@ template <ExtraHandleType HandleType>
     const UInt32 start_pack_id,
     const RSResults & rs_results, // Use to skip packs that are not used.
     const ssize_t start_row_id,
-    BitmapFilter & filter)
+    BitmapFilter & filter,
+    ReadTsRange & valid_read_ts)
 {
     // Load the max version of each pack.
     // Note that it is the max version of the non-deleted rows.
@@ -141,6 +151,7 @@ template <ExtraHandleType HandleType>
         if (!rs_results[i].isUse())
             continue;
 
+        valid_read_ts.add(max_versions[pack_id], read_ts);
         // `not_clean` means there have <multiple versions of the same handle> or <delete mark> in this pack.
         // Delete mark is handled by DeleteMarkFilter, so we don't read delete mark column below.
         // `max_versions[pack_id] > read_ts` means there is a version of this pack that is not visible to `read_ts`.
@@ -180,6 +191,7 @@ template <ExtraHandleType HandleType>
         // Filter invisible versions
         for (UInt32 i = 0; i < block.rows(); ++i)
         {
+            valid_read_ts.add(versions[i], read_ts);
             if (filter[pack_start_row_id + i] && versions[i] > read_ts)
             {
                 filter[pack_start_row_id + i] = 0;
@@ -244,7 +256,8 @@ template <ExtraHandleType HandleType>
     const ColumnFileBig & cf_big,
     const UInt64 read_ts,
     const ssize_t start_row_id,
-    BitmapFilter & filter)
+    BitmapFilter & filter,
+    ReadTsRange & valid_read_ts)
 {
     auto [valid_handle_res, valid_start_pack_id]
         = getClippedRSResultsByRange(dm_context, cf_big.getFile(), cf_big.getRange());
@@ -258,7 +271,8 @@ template <ExtraHandleType HandleType>
         valid_start_pack_id,
         valid_handle_res,
         start_row_id,
-        filter);
+        filter,
+        valid_read_ts);
 }
 
 template <ExtraHandleType HandleType>
@@ -267,7 +281,8 @@ template <ExtraHandleType HandleType>
     const StableValueSpace::Snapshot & stable,
     const UInt64 read_ts,
     const DMFilePackFilterResultPtr & stable_filter_res,
-    BitmapFilter & filter)
+    BitmapFilter & filter,
+    ReadTsRange & valid_read_ts)
 {
     const auto & dmfiles = stable.getDMFiles();
     RUNTIME_CHECK(dmfiles.size() == 1, dmfiles.size());
@@ -282,7 +297,8 @@ template <ExtraHandleType HandleType>
         start_pack_id,
         pack_res,
         start_row_id,
-        filter);
+        filter,
+        valid_read_ts);
 }
 
 template <ExtraHandleType HandleType>
@@ -292,7 +308,8 @@ UInt32 buildVersionFilter(
     const std::vector<RowID> & base_ver_snap,
     const UInt64 read_ts,
     const DMFilePackFilterResultPtr & stable_filter_res,
-    BitmapFilter & filter)
+    BitmapFilter & filter,
+    ReadTsRange & valid_read_ts)
 {
     const auto & delta = *(snapshot.delta);
     const auto & stable = *(snapshot.stable);
@@ -332,7 +349,8 @@ UInt32 buildVersionFilter(
                 base_ver_snap,
                 stable_rows,
                 start_row_id,
-                filter);
+                filter,
+                valid_read_ts);
             continue;
         }
 
@@ -348,8 +366,13 @@ UInt32 buildVersionFilter(
             // If `​has_base_version` is ​false, it means we only need to handle version filtering ​within the DMFile.
             if (likely(!has_base_version))
             {
-                filtered_out_rows
-                    += buildVersionFilterColumnFileBig<HandleType>(dm_context, *cf_big, read_ts, start_row_id, filter);
+                filtered_out_rows += buildVersionFilterColumnFileBig<HandleType>(
+                    dm_context,
+                    *cf_big,
+                    read_ts,
+                    start_row_id,
+                    filter,
+                    valid_read_ts);
             }
             else
             {
@@ -361,14 +384,21 @@ UInt32 buildVersionFilter(
                     base_ver_snap,
                     stable_rows,
                     start_row_id,
-                    filter);
+                    filter,
+                    valid_read_ts);
             }
             continue;
         }
         RUNTIME_CHECK_MSG(false, "{}: unknow ColumnFile type", cf->toString());
     }
     RUNTIME_CHECK(read_rows == delta_rows, read_rows, delta_rows);
-    filtered_out_rows += buildVersionFilterStable<HandleType>(dm_context, stable, read_ts, stable_filter_res, filter);
+    filtered_out_rows += buildVersionFilterStable<HandleType>(
+        dm_context,
+        stable,
+        read_ts,
+        stable_filter_res,
+        filter,
+        valid_read_ts);
     return filtered_out_rows;
 }
 
@@ -378,7 +408,8 @@ template UInt32 buildVersionFilter<Int64>(
     const std::vector<RowID> & base_ver_snap,
     const UInt64 read_ts,
     const DMFilePackFilterResultPtr & stable_filter_res,
-    BitmapFilter & filter);
+    BitmapFilter & filter,
+    ReadTsRange & valid_read_ts);
 
 template UInt32 buildVersionFilter<String>(
     const DMContext & dm_context,
@@ -386,5 +417,6 @@ template UInt32 buildVersionFilter<String>(
     const std::vector<RowID> & base_ver_snap,
     const UInt64 read_ts,
     const DMFilePackFilterResultPtr & stable_filter_res,
-    BitmapFilter & filter);
+    BitmapFilter & filter,
+    ReadTsRange & valid_read_ts);
 } // namespace DB::DM
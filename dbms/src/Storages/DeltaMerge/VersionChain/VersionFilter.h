@@ -16,14 +16,37 @@
 
 #include <Storages/DeltaMerge/VersionChain/Common.h>
 
+#include <algorithm>
+#include <limits>
+
 namespace DB::DM
 {
 struct DMContext;
 struct SegmentSnapshot;
 
+// The range of read_ts that the version filter is the same as built by `read_ts`, both ends are inclusive.
+// The version filter only depends on whether each version is greater than `read_ts`, so the range is
+// narrowed by every version compared with `read_ts` during building.
+struct ReadTsRange
+{
+    UInt64 min_ts = 0;
+    UInt64 max_ts = std::numeric_limits<UInt64>::max();
+
+    void add(UInt64 version, UInt64 read_ts)
+    {
+        if (version <= read_ts)
+            min_ts = std::max(min_ts, version);
+        else
+            max_ts = std::min(max_ts, version - 1);
+    }
+
+    bool contains(UInt64 ts) const { return min_ts <= ts && ts <= max_ts; }
+};
+
 // Filter out record versions that do not meet the requirement of `read_ts`
 // based on `base_versions`. This is the core logic of MVCC.
 // Returns how many rows are filtered out.
+// `valid_read_ts` is narrowed to the range of read_ts that builds the same filter.
 template <ExtraHandleType HandleType>
 UInt32 buildVersionFilter(
     const DMContext & dm_context,
@@ -31,5 +54,6 @@ UInt32 buildVersionFilter(
     const std::vector<RowID> & base_ver_snap,
     UInt64 read_ts,
     const DMFilePackFilterResultPtr & stable_filter_res,
-    BitmapFilter & filter);
+    BitmapFilter & filter,
+    ReadTsRange & valid_read_ts);
 } // namespace DB::DM
@@ -45,6 +45,9 @@ try
     std::visit(
         [&](auto & version_chain) { ASSERT_EQ(version_chain.getReplayedRows(), delta_rows); },
         *(segment->version_chain));
+    ASSERT_EQ(
+        getVersionChainReplayedRowsAndDeletes(*(segment->version_chain)),
+        segment_snapshot->delta->getRows() + segment_snapshot->delta->getDeletes());
 
     auto rs_results = loadPackFilterResults(*dm_context, segment_snapshot, {segment->getRowKeyRange()});
     auto bitmap_filter_delta_index = segment->buildMVCCBitmapFilter(
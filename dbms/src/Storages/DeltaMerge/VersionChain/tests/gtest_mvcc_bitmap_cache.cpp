@@ -0,0 +1,110 @@
+// Copyright 2025 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Storages/DeltaMerge/BitmapFilter/BitmapFilter.h>
+#include <Storages/DeltaMerge/VersionChain/MVCCBitmapCache.h>
+#include <gtest/gtest.h>
+
+namespace DB::DM::tests
+{
+namespace
+{
+MVCCBitmapCache::Key genKey(PageIdU64 stable_id, size_t delta_rows)
+{
+    return MVCCBitmapCache::Key{
+        .stable_id = stable_id,
+        .delta_rows = delta_rows,
+        .delta_deletes = 0,
+        .read_ranges = {RowKeyRange::newAll(false, 1)},
+        .handle_res = RSResults(3, RSResult::All),
+        .pack_res = RSResults(3, RSResult::Some),
+    };
+}
+
+ReadTsRange genReadTsRange(const std::vector<UInt64> & versions, UInt64 read_ts)
+{
+    ReadTsRange range;
+    for (auto v : versions)
+        range.add(v, read_ts);
+    return range;
+}
+} // namespace
+
+TEST(MVCCBitmapCacheTest, ReadTsRange)
+{
+    ReadTsRange empty;
+    ASSERT_TRUE(empty.contains(0));
+    ASSERT_TRUE(empty.contains(std::numeric_limits<UInt64>::max()));
+
+    const std::vector<UInt64> versions{10, 20, 30, 40};
+    auto range = genReadTsRange(versions, 25);
+    ASSERT_EQ(range.min_ts, 20);
+    ASSERT_EQ(range.max_ts, 29);
+    // Every read_ts in the range must see the same versions as the read_ts used to build it.
+    for (UInt64 ts = 0; ts <= 50; ++ts)
+        ASSERT_EQ(range.contains(ts), genReadTsRange(versions, ts).contains(25)) << ts;
+
+    range = genReadTsRange(versions, 40);
+    ASSERT_EQ(range.min_ts, 40);
+    ASSERT_EQ(range.max_ts, std::numeric_limits<UInt64>::max());
+    range = genReadTsRange(versions, 5);
+    ASSERT_EQ(range.min_ts, 0);
+    ASSERT_EQ(range.max_ts, 9);
+}
+
+TEST(MVCCBitmapCacheTest, GetAndPut)
+{
+    MVCCBitmapCache cache;
+    auto bitmap = std::make_shared<BitmapFilter>(100, true);
+    cache.put(genKey(1, 10), genReadTsRange({10, 20}, 15), bitmap, 2);
+    ASSERT_EQ(cache.size(), 1);
+
+    ASSERT_EQ(cache.get(genKey(1, 10), 10), bitmap);
+    ASSERT_EQ(cache.get(genKey(1, 10), 19), bitmap);
+    // Different visible versions
+    ASSERT_EQ(cache.get(genKey(1, 10), 9), nullptr);
+    ASSERT_EQ(cache.get(genKey(1, 10), 20), nullptr);
+    // Different snapshots
+    ASSERT_EQ(cache.get(genKey(2, 10), 15), nullptr);
+    ASSERT_EQ(cache.get(genKey(1, 11), 15), nullptr);
+    auto key = genKey(1, 10);
+    key.read_ranges = {RowKeyRange::fromHandleRange(HandleRange(0, 100))};
+    ASSERT_EQ(cache.get(key, 15), nullptr);
+    key = genKey(1, 10);
+    key.pack_res[1] = RSResult::None;
+    ASSERT_EQ(cache.get(key, 15), nullptr);
+
+    // Capacity 0 means disable
+    cache.put(genKey(2, 10), ReadTsRange{}, bitmap, 0);
+    ASSERT_EQ(cache.size(), 1);
+}
+
+TEST(MVCCBitmapCacheTest, EvictLeastRecentlyUsed)
+{
+    MVCCBitmapCache cache;
+    std::vector<BitmapFilterPtr> bitmaps;
+    for (PageIdU64 id = 0; id < 3; ++id)
+        bitmaps.push_back(std::make_shared<BitmapFilter>(100, true));
+
+    cache.put(genKey(0, 10), ReadTsRange{}, bitmaps[0], 2);
+    cache.put(genKey(1, 10), ReadTsRange{}, bitmaps[1], 2);
+    // Make bitmaps[0] the most recently used
+    ASSERT_EQ(cache.get(genKey(0, 10), 100), bitmaps[0]);
+    cache.put(genKey(2, 10), ReadTsRange{}, bitmaps[2], 2);
+    ASSERT_EQ(cache.size(), 2);
+    ASSERT_EQ(cache.get(genKey(0, 10), 100), bitmaps[0]);
+    ASSERT_EQ(cache.get(genKey(1, 10), 100), nullptr);
+    ASSERT_EQ(cache.get(genKey(2, 10), 100), bitmaps[2]);
+}
+} // namespace DB::DM::tests
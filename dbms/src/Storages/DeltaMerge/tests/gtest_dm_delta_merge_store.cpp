@@ -17,13 +17,17 @@
 #include <Common/MyTime.h>
 #include <Common/SyncPoint/SyncPoint.h>
 #include <Core/Defines.h>
+#include <DataStreams/TopNThreshold.h>
 #include <DataTypes/DataTypeMyDateTime.h>
 #include <DataTypes/DataTypesNumber.h>
 #include <Debug/TiFlashTestEnv.h>
+#include <Flash/Coprocessor/DAGCodec.h>
+#include <IO/Buffer/WriteBufferFromString.h>
 #include <Interpreters/Context.h>
 #include <Storages/DeltaMerge/DeltaMergeDefines.h>
 #include <Storages/DeltaMerge/DeltaMergeHelpers.h>
 #include <Storages/DeltaMerge/DeltaMergeStore.h>
+#include <Storages/DeltaMerge/Filter/PushDownExecutor.h>
 #include <Storages/DeltaMerge/Filter/RSOperator.h>
 #include <Storages/DeltaMerge/Filter/Unsupported.h>
 #include <Storages/DeltaMerge/PKSquashingBlockInputStream.h>
@@ -32,6 +36,7 @@
 #include <Storages/DeltaMerge/ScanContext.h>
 #include <Storages/DeltaMerge/StoragePool/GlobalStoragePool.h>
 #include <Storages/DeltaMerge/StoragePool/StoragePool.h>
+#include <Storages/DeltaMerge/VersionChain/VersionChain.h>
 #include <Storages/DeltaMerge/tests/DMTestEnv.h>
 #include <Storages/DeltaMerge/tests/gtest_dm_delta_merge_store_test_basic.h>
 #include <Storages/PathPool.h>
@@ -46,6 +51,7 @@
 #include <iterator>
 #include <memory>
 #include <random>
+#include <thread>
 
 
 namespace DB::ErrorCodes
@@ -295,6 +301,53 @@ try
 }
 CATCH
 
+TEST_F(DeltaMergeStoreTest, ColumnStatisticsCachedByStableDMFiles)
+try
+{
+    db_context->getGlobalContext().getSettingsRef().dt_enable_column_statistics = true;
+    SCOPE_EXIT({ db_context->getGlobalContext().getSettingsRef().dt_enable_column_statistics = false; });
+
+    const ColumnDefine col_a_define(2, "col_a", std::make_shared<DataTypeInt64>());
+    {
+        auto table_column_defines = DMTestEnv::getDefaultColumns();
+        table_column_defines->emplace_back(col_a_define);
+        store = reload(table_column_defines);
+    }
+
+    const size_t num_rows_write = 1000;
+    auto write_and_merge_delta = [&](UInt64 tso) {
+        Block block = DMTestEnv::prepareSimpleWriteBlock(0, num_rows_write, false, tso);
+        block.insert(DB::tests::createColumn<Int64>(
+            createSignedNumbers(0, num_rows_write),
+            col_a_define.name,
+            col_a_define.id));
+        store->write(*db_context, db_context->getSettingsRef(), block);
+        store->flushCache(*db_context, RowKeyRange::newAll(store->isCommonHandle(), store->getRowKeyColumnSize()));
+        store->mergeDeltaAll(*db_context);
+    };
+
+    write_and_merge_delta(2);
+    const auto stats = store->getColumnStatistics(col_a_define.id);
+    ASSERT_NE(stats.stats, nullptr);
+    ASSERT_EQ(stats.total_rows, num_rows_write);
+    ASSERT_EQ(stats.stats_rows, num_rows_write);
+    ASSERT_NEAR(stats.stats->ndv(), num_rows_write, num_rows_write * 0.05);
+
+    // The stable DMFiles are not changed, so the merged statistics are reused.
+    ASSERT_EQ(store->getColumnStatistics(col_a_define.id).stats, stats.stats);
+
+    // Update all the rows. The new stable DMFiles keep both versions of the rows, which are all counted,
+    // but the NDV is not changed.
+    write_and_merge_delta(3);
+    const auto new_stats = store->getColumnStatistics(col_a_define.id);
+    ASSERT_NE(new_stats.stats, nullptr);
+    ASSERT_NE(new_stats.stats, stats.stats);
+    ASSERT_EQ(new_stats.total_rows, 2 * num_rows_write);
+    ASSERT_EQ(new_stats.stats_rows, 2 * num_rows_write);
+    ASSERT_NEAR(new_stats.stats->ndv(), num_rows_write, num_rows_write * 0.05);
+}
+CATCH
+
 TEST_F(DeltaMergeStoreTest, OpenWithExtraColumns)
 try
 {
@@ -688,6 +741,89 @@ try
 }
 CATCH
 
+TEST_P(DeltaMergeStoreRWTest, ReadWithTopNThreshold)
+try
+{
+    const ColumnDefine col_a_define(2, "col_a", std::make_shared<DataTypeInt64>());
+    {
+        auto table_column_defines = DMTestEnv::getDefaultColumns();
+        table_column_defines->emplace_back(col_a_define);
+
+        store = reload(table_column_defines);
+    }
+
+    const size_t num_rows_write = 50000;
+    {
+        Block block = DMTestEnv::prepareSimpleWriteBlock(0, num_rows_write, false);
+        block.insert(DB::tests::createColumn<Int64>(
+            createSignedNumbers(0, num_rows_write),
+            col_a_define.name,
+            col_a_define.id));
+        store->write(*db_context, db_context->getSettingsRef(), block);
+    }
+    store->flushCache(*db_context, RowKeyRange::newAll(store->isCommonHandle(), store->getRowKeyColumnSize()));
+    store->mergeDeltaAll(*db_context);
+
+    // ORDER BY col_a ASC, the column is the first one of the table scan.
+    tipb::Expr col_ref;
+    col_ref.set_tp(tipb::ExprType::ColumnRef);
+    {
+        WriteBufferFromOwnString ss;
+        encodeDAGInt64(0, ss);
+        col_ref.set_val(ss.releaseStr());
+    }
+    col_ref.mutable_field_type()->set_tp(TiDB::TypeLongLong);
+    TiDB::ColumnInfo column_info;
+    column_info.id = col_a_define.id;
+    column_info.name = col_a_define.name;
+    column_info.tp = TiDB::TypeLongLong;
+    auto threshold
+        = std::make_shared<TopNThreshold>(col_ref, col_a_define.name, col_a_define.type, 1, 1, TimezoneInfo{});
+    threshold->setTargetAttr({column_info}, store->getTableColumns());
+    // The threshold is the min value of the second pack.
+    const Int64 threshold_value = 8192;
+    threshold->update(Field(threshold_value));
+    auto executor = std::make_shared<PushDownExecutor>(EMPTY_RS_OPERATOR);
+    executor->topn_threshold = threshold;
+
+    auto scan_context = std::make_shared<ScanContext>();
+    auto in = store->read(
+        *db_context,
+        db_context->getSettingsRef(),
+        store->getTableColumns(),
+        {RowKeyRange::newAll(store->isCommonHandle(), store->getRowKeyColumnSize())},
+        /* num_streams= */ 1,
+        /* start_ts= */ std::numeric_limits<UInt64>::max(),
+        executor,
+        std::vector<RuntimeFilterPtr>{},
+        0,
+        TRACING_NAME,
+        DMReadOptions{},
+        /* expected_block_size= */ 1024,
+        /* read_segments */ {},
+        /* extra_table_id_index */ MutSup::invalid_col_id,
+        /* scan_context */ scan_context)[0];
+    size_t read_rows = 0;
+    size_t rows_not_after_threshold = 0;
+    in->readPrefix();
+    while (Block block = in->read())
+    {
+        read_rows += block.rows();
+        const auto & col_a = toColumnVectorData<Int64>(block.getByName(col_a_define.name).column);
+        rows_not_after_threshold += std::count_if(col_a.begin(), col_a.end(), [&](Int64 v) {
+            return v <= threshold_value;
+        });
+    }
+    in->readSuffix();
+
+    // The packs entirely beyond the threshold are skipped, the pack begins with the threshold is kept.
+    ASSERT_EQ(scan_context->dmfile_data_scanned_rows, 16384);
+    ASSERT_EQ(scan_context->dmfile_data_skipped_rows, num_rows_write - 16384);
+    ASSERT_EQ(read_rows, 16384);
+    ASSERT_EQ(rows_not_after_threshold, threshold_value + 1);
+}
+CATCH
+
 
 TEST_P(DeltaMergeStoreRWTest, WriteCrashBeforeWalWithoutCache)
 try
@@ -4480,4 +4616,41 @@ try
 }
 CATCH
 
+TEST_F(DeltaMergeStoreTest, ReplayVersionChainAfterFlush)
+try
+{
+    auto & settings = db_context->getSettingsRef();
+    auto version_chain_guard = enableVersionChainTemporary(settings);
+    settings.dt_version_chain_replay_after_flush = true;
+    constexpr size_t num_rows = 100;
+    {
+        auto block = DMTestEnv::prepareSimpleWriteBlock(0, num_rows, false);
+        store->write(*db_context, settings, block);
+    }
+    ASSERT_EQ(store->id_to_segment.size(), 1);
+    auto seg = store->id_to_segment.begin()->second;
+    const auto & delta = seg->getDelta();
+    ASSERT_EQ(delta->getRows(/*use_unsaved*/ false), 0);
+    ASSERT_EQ(delta->getLastTryPlaceDeltaIndexRows().load(), 0);
+
+    // The foreground flush adds one task to replay the flushed data.
+    auto dm_context = store->newDMContext(*db_context, settings);
+    ASSERT_TRUE(
+        store->flushCache(dm_context, RowKeyRange::newAll(store->isCommonHandle(), store->getRowKeyColumnSize())));
+    ASSERT_EQ(delta->getRows(/*use_unsaved*/ false), num_rows);
+    ASSERT_EQ(delta->getLastTryPlaceDeltaIndexRows().load(), num_rows);
+    ASSERT_LE(store->background_tasks.length(), 1);
+    // No more task is added for the same flushed data.
+    ASSERT_FALSE(store->segmentReplayVersionChainAsync(dm_context, seg, DeltaMergeStore::ThreadType::Write));
+
+    // The task may have been run by the background pool, run it here otherwise.
+    while (store->handleBackgroundTask(/*heavy*/ false)) {}
+    for (size_t i = 0; i < 100 && getVersionChainReplayedRowsAndDeletes(*seg->getVersionChain()) < num_rows; ++i)
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_EQ(getVersionChainReplayedRowsAndDeletes(*seg->getVersionChain()), num_rows);
+    // Nothing to replay after catching up.
+    ASSERT_FALSE(store->segmentReplayVersionChainAsync(dm_context, seg, DeltaMergeStore::ThreadType::Write));
+}
+CATCH
+
 } // namespace DB::DM::tests
@@ -16,6 +16,8 @@
 #include <Core/BlockUtils.h>
 #include <Flash/Disaggregated/WNFetchPagesStreamWriter.h>
 #include <Interpreters/SharedContexts/Disagg.h>
+#include <Storages/DeltaMerge/Filter/PushDownExecutor.h>
+#include <Storages/DeltaMerge/Filter/RSOperator.h>
 #include <Storages/DeltaMerge/ReadThread/WorkQueue.h>
 #include <Storages/DeltaMerge/Remote/DataStore/DataStoreMock.h>
 #include <Storages/DeltaMerge/Remote/DisaggSnapshot.h>
@@ -29,6 +31,8 @@
 #include <TestUtils/InputStreamTestUtils.h>
 #include <TestUtils/TiFlashTestBasic.h>
 
+#include <filesystem>
+
 using namespace DB::tests;
 
 namespace DB::ErrorCodes
@@ -917,4 +921,45 @@ try
     fetchPagesTinyInMem();
 }
 CATCH
+
+TEST_F(DMStoreForSegmentReadTaskTest, StableFilesToPrefetch)
+try
+{
+    auto table_column_defines = DMTestEnv::getDefaultColumns();
+    store = reload(table_column_defines);
+    {
+        auto block = DMTestEnv::prepareSimpleWriteBlock(0, 4096, false);
+        store->write(*db_context, db_context->getSettingsRef(), block);
+        store->mergeDeltaAll(*db_context);
+    }
+
+    auto [remote_seg, local_seg] = getRemoteAndLocalSegmentReadTasks(/*need_mem_data*/ false, 0);
+    const ColumnDefines columns_to_read{getExtraHandleColumnDefine(/*is_common_handle*/ false)};
+
+    // The files of the handle column and the MVCC columns.
+    auto files = remote_seg->getStableFilesToPrefetch(columns_to_read, EMPTY_FILTER, ReadMode::Normal);
+    ASSERT_FALSE(files.empty());
+    std::unordered_set<String> fnames;
+    for (const auto & [fname, fsize] : files)
+    {
+        ASSERT_TRUE(fnames.emplace(fname).second) << fname;
+        ASSERT_TRUE(std::filesystem::exists(fname)) << fname;
+        ASSERT_EQ(fsize, std::filesystem::file_size(fname)) << fname;
+    }
+
+    // All packs are filtered out, nothing to prefetch.
+    auto filter = createGreater(
+        Attr{MutSup::extra_handle_column_name, MutSup::extra_handle_id, MutSup::getExtraHandleColumnIntType()},
+        Field(static_cast<Int64>(100000)));
+    ASSERT_TRUE(remote_seg
+                    ->getStableFilesToPrefetch(
+                        columns_to_read,
+                        std::make_shared<PushDownExecutor>(filter),
+                        ReadMode::Normal)
+                    .empty());
+
+    // Prefetching is skipped without FileCache.
+    remote_seg->prefetchStableFiles(columns_to_read, EMPTY_FILTER, ReadMode::Normal);
+}
+CATCH
 } // namespace DB::DM::tests
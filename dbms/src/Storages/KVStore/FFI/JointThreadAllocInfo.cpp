@@ -277,6 +277,8 @@ void JointThreadInfoJeallocMap::recordClassdAlloc()
         .Set(PS::PageStorageMemorySummary::uni_page_id_bytes.load());
     GET_METRIC(tiflash_memory_usage_by_class, type_versioned_entries)
         .Set(PS::PageStorageMemorySummary::versioned_entry_or_delete_bytes.load());
+    GET_METRIC(tiflash_memory_usage_by_class, type_versioned_page_entries)
+        .Set(PS::PageStorageMemorySummary::versioned_page_entries_bytes.load());
 }
 
 
@@ -104,6 +104,8 @@ struct PageStorageConfig
 
     SettingUInt64 wal_roll_size = PAGE_META_ROLL_SIZE;
     SettingUInt64 wal_max_persisted_log_files = MAX_PERSISTED_LOG_FILES;
+    // Only used when restoring, 0 or 1 means restoring in the current thread.
+    SettingUInt64 wal_restore_threads = WAL_RESTORE_THREADS;
 
     void reload(const PageStorageConfig & rhs)
     {
@@ -128,6 +130,7 @@ struct PageStorageConfig
 
         wal_roll_size = rhs.wal_roll_size;
         wal_max_persisted_log_files = rhs.wal_max_persisted_log_files;
+        wal_restore_threads = rhs.wal_restore_threads;
     }
 
     String toDebugStringV2() const
@@ -155,14 +158,16 @@ struct PageStorageConfig
             "PageStorageConfig {{"
             "blob_file_limit_size: {}, blob_spacemap_type: {}, "
             "blob_heavy_gc_valid_rate: {:.3f}, blob_heavy_gc_valid_rate_raft_data: {:.3f}, "
-            "blob_block_alignment_bytes: {}, wal_roll_size: {}, wal_max_persisted_log_files: {}}}",
+            "blob_block_alignment_bytes: {}, wal_roll_size: {}, wal_max_persisted_log_files: {}, "
+            "wal_restore_threads: {}}}",
             blob_file_limit_size.get(),
             blob_spacemap_type.get(),
             blob_heavy_gc_valid_rate.get(),
             blob_heavy_gc_valid_rate_raft_data.get(),
             blob_block_alignment_bytes.get(),
             wal_roll_size.get(),
-            wal_max_persisted_log_files.get());
+            wal_max_persisted_log_files.get(),
+            wal_restore_threads.get());
     }
 };
 } // namespace DB
@@ -36,6 +36,7 @@ void mergeConfigFromSettings(const DB::Settings & settings, PageStorageConfig &
 
     // V3 setting which export to global setting
     config.blob_heavy_gc_valid_rate = settings.dt_page_gc_threshold;
+    config.wal_restore_threads = settings.dt_page_wal_restore_threads;
 }
 
 PageStorageConfig getConfigFromSettings(const DB::Settings & settings)
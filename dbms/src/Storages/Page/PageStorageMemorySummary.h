@@ -23,6 +23,10 @@ struct PageStorageMemorySummary
     static inline std::atomic_int64_t uni_page_id_bytes{0};
     static inline std::atomic_int64_t versioned_entry_or_delete_bytes{0};
     static inline std::atomic_int64_t versioned_entry_or_delete_count{0};
+    // The number of `VersionedPageEntries` and the bytes they consume, including the
+    // version lists and the states for ref/external pages allocated on heap.
+    static inline std::atomic_int64_t versioned_page_entries_count{0};
+    static inline std::atomic_int64_t versioned_page_entries_bytes{0};
     static inline std::atomic_int64_t universal_write_count{0};
 };
 
@@ -199,7 +199,8 @@ typename VersionedPageEntries<Trait>::PageId VersionedPageEntries<Trait>::create
 
     if (type == EditRecordType::VAR_REF)
     {
-        // an ref-page is rewritten into a normal page
+        // an ref-page is rewritten into a normal page, the ref states are not needed anymore
+        auto ref = std::move(ref_state);
         if (!is_deleted)
         {
             // Full GC has rewritten new data on disk, we need to update this RefPage
@@ -208,7 +209,7 @@ typename VersionedPageEntries<Trait>::PageId VersionedPageEntries<Trait>::create
             is_deleted = false;
             type = EditRecordType::VAR_ENTRY;
             // Also we need to decrease the ref-count of ori_page_id.
-            return ori_page_id;
+            return ref->ori_page_id;
         }
         else
         {
@@ -217,13 +218,13 @@ typename VersionedPageEntries<Trait>::PageId VersionedPageEntries<Trait>::create
             // be normal page with upsert-entry and a delete. Then later GC will
             // remove the useless data on `entry`.
             entries.emplace(ver, EntryOrDelete::newNormalEntry(entry));
-            entries.emplace(delete_ver, EntryOrDelete::newDelete());
+            entries.emplace(ref->delete_ver, EntryOrDelete::newDelete());
             is_deleted = false;
             type = EditRecordType::VAR_ENTRY;
             // Though the ref-id is marked as deleted, but the ref-count of
             // ori_page_id is not decreased. Return the ori_page_id
             // for decreasing ref-count.
-            return ori_page_id;
+            return ref->ori_page_id;
         }
     }
 
@@ -249,13 +250,14 @@ std::shared_ptr<typename VersionedPageEntries<Trait>::PageId> VersionedPageEntri
     {
         type = EditRecordType::VAR_EXTERNAL;
         is_deleted = false;
-        create_ver = ver;
-        delete_ver = PageVersion(0);
+        ref_state = std::make_unique<RefOrExternalState>();
+        ref_state->create_ver = ver;
+        ref_state->delete_ver = PageVersion(0);
         RUNTIME_CHECK(entries.empty());
-        entries.emplace(create_ver, EntryOrDelete::newNormalEntry(entry));
+        entries.emplace(ref_state->create_ver, EntryOrDelete::newNormalEntry(entry));
         // return the new created holder to caller to set the page_id
-        external_holder = std::make_shared<typename Trait::PageId>();
-        return external_holder;
+        ref_state->external_holder = std::make_shared<typename Trait::PageId>();
+        return ref_state->external_holder;
     }
 
     if (type == EditRecordType::VAR_EXTERNAL)
@@ -263,15 +265,15 @@ std::shared_ptr<typename VersionedPageEntries<Trait>::PageId> VersionedPageEntri
         if (is_deleted)
         {
             // adding external after deleted should be ok
-            if (delete_ver <= ver)
+            if (ref_state->delete_ver <= ver)
             {
                 is_deleted = false;
-                create_ver = ver;
-                delete_ver = PageVersion(0);
-                entries.emplace(create_ver, EntryOrDelete::newNormalEntry(entry));
+                ref_state->create_ver = ver;
+                ref_state->delete_ver = PageVersion(0);
+                entries.emplace(ref_state->create_ver, EntryOrDelete::newNormalEntry(entry));
                 // return the new created holder to caller to set the page_id
-                external_holder = std::make_shared<typename Trait::PageId>();
-                return external_holder;
+                ref_state->external_holder = std::make_shared<typename Trait::PageId>();
+                return ref_state->external_holder;
             }
             else
             {
@@ -313,7 +315,7 @@ void VersionedPageEntries<Trait>::createDelete(const PageVersion & ver) NO_THREA
     if (type == EditRecordType::VAR_EXTERNAL || type == EditRecordType::VAR_REF)
     {
         is_deleted = true;
-        delete_ver = ver;
+        ref_state->delete_ver = ver;
         return;
     }
 
@@ -393,8 +395,9 @@ bool VersionedPageEntries<Trait>::createNewRef(const PageVersion & ver, const Pa
     {
         type = EditRecordType::VAR_REF;
         is_deleted = false;
-        ori_page_id = ori_page_id_;
-        create_ver = ver;
+        ref_state = std::make_unique<RefOrExternalState>();
+        ref_state->ori_page_id = ori_page_id_;
+        ref_state->create_ver = ver;
         return true;
     }
 
@@ -403,15 +406,15 @@ bool VersionedPageEntries<Trait>::createNewRef(const PageVersion & ver, const Pa
         if (is_deleted)
         {
             // adding ref after deleted should be ok
-            if (delete_ver <= ver)
+            if (ref_state->delete_ver <= ver)
             {
-                ori_page_id = ori_page_id_;
-                create_ver = ver;
+                ref_state->ori_page_id = ori_page_id_;
+                ref_state->create_ver = ver;
                 is_deleted = false;
-                delete_ver = PageVersion(0);
+                ref_state->delete_ver = PageVersion(0);
                 return true;
             }
-            else if (ori_page_id == ori_page_id_)
+            else if (ref_state->ori_page_id == ori_page_id_)
             {
                 // apply a ref to same ori id with small ver, just ignore
                 return false;
@@ -420,7 +423,7 @@ bool VersionedPageEntries<Trait>::createNewRef(const PageVersion & ver, const Pa
         }
         else
         {
-            if (ori_page_id == ori_page_id_)
+            if (ref_state->ori_page_id == ori_page_id_)
             {
                 // adding ref to the same ori id should be idempotent, just ignore
                 return false;
@@ -450,19 +453,21 @@ std::shared_ptr<typename VersionedPageEntries<Trait>::PageId> VersionedPageEntri
     {
         type = EditRecordType::VAR_REF;
         is_deleted = false;
-        create_ver = rec.version;
-        ori_page_id = rec.ori_page_id;
+        ref_state = std::make_unique<RefOrExternalState>();
+        ref_state->create_ver = rec.version;
+        ref_state->ori_page_id = rec.ori_page_id;
         return nullptr;
     }
     case EditRecordType::VAR_EXTERNAL:
     {
         type = EditRecordType::VAR_EXTERNAL;
         is_deleted = false;
-        create_ver = rec.version;
-        being_ref_count.restoreFrom(rec.version, rec.being_ref_count);
+        ref_state = std::make_unique<RefOrExternalState>();
+        ref_state->create_ver = rec.version;
+        ref_state->being_ref_count.restoreFrom(rec.version, rec.being_ref_count);
         entries.emplace(rec.version, EntryOrDelete::newFromRestored(rec.entry, rec.version, 1 /* meaningless */));
-        external_holder = std::make_shared<typename Trait::PageId>(rec.page_id);
-        return external_holder;
+        ref_state->external_holder = std::make_shared<typename Trait::PageId>(rec.page_id);
+        return ref_state->external_holder;
     }
     case EditRecordType::VAR_ENTRY:
     {
@@ -520,10 +525,10 @@ VersionedPageEntries<Trait>::resolveToPageId(UInt64 seq, bool ignore_delete, Pag
     {
         // If `ignore_delete` is true, we need the origin page id even if it is logical deleted.
         // Checkout the details in `PageDirectory::getNormalPageId`.
-        bool ok = ignore_delete || (!is_deleted || seq < delete_ver.sequence);
-        if (create_ver.sequence <= seq && ok)
+        bool ok = ignore_delete || (!is_deleted || seq < ref_state->delete_ver.sequence);
+        if (ref_state->create_ver.sequence <= seq && ok)
         {
-            auto iter = entries.find(create_ver);
+            auto iter = entries.find(ref_state->create_ver);
             RUNTIME_CHECK(iter != entries.end());
             if (entry != nullptr)
                 *entry = iter->second.entry.value();
@@ -533,9 +538,9 @@ VersionedPageEntries<Trait>::resolveToPageId(UInt64 seq, bool ignore_delete, Pag
     else if (type == EditRecordType::VAR_REF)
     {
         // Return the origin page id if this ref is visible by `seq`.
-        if (create_ver.sequence <= seq && (!is_deleted || seq < delete_ver.sequence))
+        if (ref_state->create_ver.sequence <= seq && (!is_deleted || seq < ref_state->delete_ver.sequence))
         {
-            return {ResolveResult::TO_REF, ori_page_id, create_ver};
+            return {ResolveResult::TO_REF, ref_state->ori_page_id, ref_state->create_ver};
         }
     }
     else
@@ -664,7 +669,7 @@ bool VersionedPageEntries<Trait>::isVisible(UInt64 seq) const NO_THREAD_SAFETY_A
     else if (type == EditRecordType::VAR_EXTERNAL || type == EditRecordType::VAR_REF)
     {
         // `delete_ver` is only valid when `is_deleted == true`
-        return create_ver.sequence <= seq && (!is_deleted || delete_ver.sequence > seq);
+        return ref_state->create_ver.sequence <= seq && (!is_deleted || ref_state->delete_ver.sequence > seq);
     }
 
     throw Exception(
@@ -710,11 +715,11 @@ Int64 VersionedPageEntries<Trait>::incrRefCount(const PageVersion & target_ver,
     }
     else if (type == EditRecordType::VAR_EXTERNAL)
     {
-        if (create_ver <= target_ver)
+        if (ref_state->create_ver <= target_ver)
         {
             // We may add reference to an external id even if it is logically deleted.
-            auto ref_count_value = being_ref_count.getLatestRefCount();
-            being_ref_count.incrRefCount(ref_ver, 1);
+            auto ref_count_value = ref_state->being_ref_count.getLatestRefCount();
+            ref_state->being_ref_count.incrRefCount(ref_ver, 1);
             return ref_count_value + 1;
         }
     }
@@ -744,7 +749,7 @@ PageSize VersionedPageEntries<Trait>::getEntriesByBlobIds(
         // If the ref-id is not deleted, we will check whether its origin_entry.file_id in blob_ids
         if (!is_deleted)
         {
-            ref_ids_maybe_rewrite[page_id] = {ori_page_id, create_ver};
+            ref_ids_maybe_rewrite[page_id] = {ref_state->ori_page_id, ref_state->create_ver};
         }
         return 0;
     }
@@ -783,19 +788,21 @@ bool VersionedPageEntries<Trait>::cleanOutdatedEntries(
 {
     if (type == EditRecordType::VAR_EXTERNAL)
     {
-        return (being_ref_count.getLatestRefCount() == 1 && is_deleted && delete_ver.sequence <= lowest_seq);
+        return (
+            ref_state->being_ref_count.getLatestRefCount() == 1 && is_deleted
+            && ref_state->delete_ver.sequence <= lowest_seq);
     }
     else if (type == EditRecordType::VAR_REF)
     {
         // still visible by `lowest_seq`
-        if (!is_deleted || lowest_seq < delete_ver.sequence)
+        if (!is_deleted || lowest_seq < ref_state->delete_ver.sequence)
             return false;
         // Else this ref page is safe to be deleted.
         if (normal_entries_to_deref != nullptr)
         {
             // need to decrease the ref count by <id=iter->second.origin_page_id, ver=iter->first, num=1>
             if (auto [deref_counter, new_created] = normal_entries_to_deref->emplace(
-                    std::make_pair(ori_page_id, std::make_pair(/*ver=*/create_ver, /*count=*/1)));
+                    std::make_pair(ref_state->ori_page_id, std::make_pair(/*ver=*/ref_state->create_ver, /*count=*/1)));
                 !new_created)
             {
                 // the id is already exist in deref map, increase the num to decrease ref count
@@ -890,6 +897,8 @@ bool VersionedPageEntries<Trait>::cleanOutdatedEntries(
             break;
         --iter;
     }
+    // Only one version left in most cases, move it back to the inline storage
+    entries.shrinkToFit();
 
     return entries.empty() || (entries.size() == 1 && entries.begin()->second.isDelete());
 }
@@ -905,8 +914,10 @@ bool VersionedPageEntries<Trait>::derefAndClean(
     auto page_lock = acquireLock();
     if (type == EditRecordType::VAR_EXTERNAL)
     {
-        being_ref_count.decrRefCountInSnap(lowest_seq, deref_count);
-        return (is_deleted && delete_ver.sequence <= lowest_seq && being_ref_count.getLatestRefCount() == 1);
+        ref_state->being_ref_count.decrRefCountInSnap(lowest_seq, deref_count);
+        return (
+            is_deleted && ref_state->delete_ver.sequence <= lowest_seq
+            && ref_state->being_ref_count.getLatestRefCount() == 1);
     }
     else if (type == EditRecordType::VAR_ENTRY)
     {
@@ -963,36 +974,40 @@ void VersionedPageEntries<Trait>::collapseTo(const UInt64 seq, const PageId & pa
     auto page_lock = acquireLock();
     if (type == EditRecordType::VAR_REF)
     {
-        if (create_ver.sequence > seq)
+        if (ref_state->create_ver.sequence > seq)
             return;
         // - If create_ver > seq && ! is_deleted, then
         //   we need to keep a record for {page_id, VAR_REF}
         // - If create_ver > seq && is_deleted, then
         //   we need to keep a record for {page_id, VAR_REF} and {page_id, VAR_DEL}
         //   so that the page_id and being-ref page_id can be cleanup after restore
-        edit.varRef(page_id, create_ver, ori_page_id);
-        if (is_deleted && delete_ver.sequence <= seq)
+        edit.varRef(page_id, ref_state->create_ver, ref_state->ori_page_id);
+        if (is_deleted && ref_state->delete_ver.sequence <= seq)
         {
-            edit.varDel(page_id, delete_ver);
+            edit.varDel(page_id, ref_state->delete_ver);
         }
         return;
     }
 
     if (type == EditRecordType::VAR_EXTERNAL)
     {
-        if (create_ver.sequence > seq)
+        if (ref_state->create_ver.sequence > seq)
             return;
-        auto iter = entries.find(create_ver);
+        auto iter = entries.find(ref_state->create_ver);
         RUNTIME_CHECK(iter != entries.end());
         // - If create_ver > seq && ! is_deleted, then
         //   we need to keep a record for {page_id, VAR_EXT}
         // - If create_ver > seq && is_deleted, then
         //   we need to keep a record for {page_id, VAR_EXT} and {page_id, VAR_DEL}
         //   so that the page_id can be ref by another page_id after restore
-        edit.varExternal(page_id, create_ver, iter->second.entry.value(), being_ref_count.getRefCountInSnap(seq));
-        if (is_deleted && delete_ver.sequence <= seq)
+        edit.varExternal(
+            page_id,
+            ref_state->create_ver,
+            iter->second.entry.value(),
+            ref_state->being_ref_count.getRefCountInSnap(seq));
+        if (is_deleted && ref_state->delete_ver.sequence <= seq)
         {
-            edit.varDel(page_id, delete_ver);
+            edit.varDel(page_id, ref_state->delete_ver);
         }
         return;
     }
@@ -1132,35 +1147,30 @@ typename PageDirectory<Trait>::PageIdAndEntry PageDirectory<Trait>::getByIDImpl(
     bool ok = true;
     while (ok)
     {
-        VersionedPageEntriesPtr iter_v;
+        VersionedPageEntriesPtr iter_v = mvcc_table_directory.find(id_to_resolve);
+        if (iter_v == nullptr)
         {
-            std::shared_lock read_lock(table_rw_mutex);
-            auto iter = mvcc_table_directory.find(id_to_resolve);
-            if (iter == mvcc_table_directory.end())
+            if (throw_on_not_exist)
             {
-                if (throw_on_not_exist)
-                {
-                    LOG_WARNING(log, "Dump state for invalid page id, page_id={}", page_id);
-                    for (const auto & [dump_id, dump_entry] : mvcc_table_directory)
-                    {
-                        LOG_WARNING(
-                            log,
-                            "Dumping state, page_id={} entry={}",
-                            dump_id,
-                            dump_entry == nullptr ? "<null>" : dump_entry->toDebugString());
-                    }
-                    throw Exception(
-                        ErrorCodes::PS_ENTRY_NOT_EXISTS,
-                        "Invalid page id, entry not exist, page_id={} resolve_id={}",
-                        page_id,
-                        id_to_resolve);
-                }
-                else
+                LOG_WARNING(log, "Dump state for invalid page id, page_id={}", page_id);
+                for (const auto & [dump_id, dump_entry] : mvcc_table_directory.copyAll())
                 {
-                    return PageIdAndEntry{page_id, PageEntryV3{.file_id = INVALID_BLOBFILE_ID}};
+                    LOG_WARNING(
+                        log,
+                        "Dumping state, page_id={} entry={}",
+                        dump_id,
+                        dump_entry == nullptr ? "<null>" : dump_entry->toDebugString());
                 }
+                throw Exception(
+                    ErrorCodes::PS_ENTRY_NOT_EXISTS,
+                    "Invalid page id, entry not exist, page_id={} resolve_id={}",
+                    page_id,
+                    id_to_resolve);
+            }
+            else
+            {
+                return PageIdAndEntry{page_id, PageEntryV3{.file_id = INVALID_BLOBFILE_ID}};
             }
-            iter_v = iter->second;
         }
         auto [resolve_state, next_id_to_resolve, next_ver_to_resolve]
             = iter_v->resolveToPageId(ver_to_resolve.sequence, /*ignore_delete=*/id_to_resolve != page_id, &entry_got);
@@ -1223,26 +1233,21 @@ std::pair<typename PageDirectory<Trait>::PageIdAndEntries, typename PageDirector
         bool ok = true;
         while (ok)
         {
-            VersionedPageEntriesPtr iter_v;
+            VersionedPageEntriesPtr iter_v = mvcc_table_directory.find(id_to_resolve);
+            if (iter_v == nullptr)
             {
-                std::shared_lock read_lock(table_rw_mutex);
-                auto iter = mvcc_table_directory.find(id_to_resolve);
-                if (iter == mvcc_table_directory.end())
+                if (throw_on_not_exist)
                 {
-                    if (throw_on_not_exist)
-                    {
-                        throw Exception(
-                            ErrorCodes::PS_ENTRY_NOT_EXISTS,
-                            "Invalid page id, entry not exist, page_id={} resolve_id={}",
-                            page_id,
-                            id_to_resolve);
-                    }
-                    else
-                    {
-                        return false;
-                    }
+                    throw Exception(
+                        ErrorCodes::PS_ENTRY_NOT_EXISTS,
+                        "Invalid page id, entry not exist, page_id={} resolve_id={}",
+                        page_id,
+                        id_to_resolve);
+                }
+                else
+                {
+                    return false;
                 }
-                iter_v = iter->second;
             }
             auto [resolve_state, next_id_to_resolve, next_ver_to_resolve] = iter_v->resolveToPageId(
                 ver_to_resolve.sequence,
@@ -1312,26 +1317,21 @@ typename PageDirectory<Trait>::PageId PageDirectory<Trait>::getNormalPageId(
     bool keep_resolve = true;
     while (keep_resolve)
     {
-        VersionedPageEntriesPtr iter_v;
+        VersionedPageEntriesPtr iter_v = mvcc_table_directory.find(id_to_resolve);
+        if (iter_v == nullptr)
         {
-            std::shared_lock read_lock(table_rw_mutex);
-            auto iter = mvcc_table_directory.find(id_to_resolve);
-            if (iter == mvcc_table_directory.end())
+            if (throw_on_not_exist)
             {
-                if (throw_on_not_exist)
-                {
-                    throw Exception(
-                        ErrorCodes::LOGICAL_ERROR,
-                        "Invalid page id, page_id={} resolve_id={}",
-                        page_id,
-                        id_to_resolve);
-                }
-                else
-                {
-                    return Trait::PageIdTrait::getInvalidID();
-                }
+                throw Exception(
+                    ErrorCodes::LOGICAL_ERROR,
+                    "Invalid page id, page_id={} resolve_id={}",
+                    page_id,
+                    id_to_resolve);
+            }
+            else
+            {
+                return Trait::PageIdTrait::getInvalidID();
             }
-            iter_v = iter->second;
         }
         auto [resolve_state, next_id_to_resolve, next_ver_to_resolve]
             = iter_v->resolveToPageId(ver_to_resolve.sequence, /*ignore_delete=*/id_to_resolve != page_id, nullptr);
@@ -1375,7 +1375,7 @@ typename PageDirectory<Trait>::PageId PageDirectory<Trait>::getNormalPageId(
 template <typename Trait>
 UInt64 PageDirectory<Trait>::getMaxIdAfterRestart() const
 {
-    std::shared_lock read_lock(table_rw_mutex);
+    // `max_page_id` is only updated when restoring the directory
     return max_page_id;
 }
 
@@ -1385,13 +1385,17 @@ typename PageDirectory<Trait>::PageIdSet PageDirectory<Trait>::getAllPageIds()
     GET_METRIC(tiflash_storage_page_command_count, type_scan).Increment();
     std::set<PageId> page_ids;
 
-    std::shared_lock read_lock(table_rw_mutex);
     const auto seq = sequence.load();
-    for (auto & [page_id, versioned] : mvcc_table_directory)
+    for (size_t shard_idx = 0; shard_idx < ShardedMVCCMapType::num_shards; ++shard_idx)
     {
-        // Only return the page_id that is visible
-        if (versioned->isVisible(seq))
-            page_ids.insert(page_id);
+        const auto & shard = mvcc_table_directory.shardAt(shard_idx);
+        std::shared_lock read_lock(shard.mutex);
+        for (const auto & [page_id, versioned] : shard.map)
+        {
+            // Only return the page_id that is visible
+            if (versioned->isVisible(seq))
+                page_ids.insert(page_id);
+        }
     }
     return page_ids;
 }
@@ -1406,14 +1410,18 @@ typename PageDirectory<Trait>::PageIdSet PageDirectory<Trait>::getAllPageIdsWith
     {
         PageIdSet page_ids;
         auto seq = toConcreteSnapshot(snap_)->sequence;
-        std::shared_lock read_lock(table_rw_mutex);
-        for (auto iter = mvcc_table_directory.lower_bound(prefix); iter != mvcc_table_directory.end(); ++iter)
+        for (size_t shard_idx = 0; shard_idx < ShardedMVCCMapType::num_shards; ++shard_idx)
         {
-            if (!iter->first.hasPrefix(prefix))
-                break;
-            // Only return the page_id that is visible
-            if (iter->second->isVisible(seq))
-                page_ids.insert(iter->first);
+            const auto & shard = mvcc_table_directory.shardAt(shard_idx);
+            std::shared_lock read_lock(shard.mutex);
+            for (auto iter = shard.map.lower_bound(prefix); iter != shard.map.end(); ++iter)
+            {
+                if (!iter->first.hasPrefix(prefix))
+                    break;
+                // Only return the page_id that is visible
+                if (iter->second->isVisible(seq))
+                    page_ids.insert(iter->first);
+            }
         }
         return page_ids;
     }
@@ -1434,14 +1442,18 @@ typename PageDirectory<Trait>::PageIdSet PageDirectory<Trait>::getAllPageIdsInRa
     {
         PageIdSet page_ids;
         auto seq = toConcreteSnapshot(snap_)->sequence;
-        std::shared_lock read_lock(table_rw_mutex);
-        for (auto iter = mvcc_table_directory.lower_bound(start); iter != mvcc_table_directory.end(); ++iter)
+        for (size_t shard_idx = 0; shard_idx < ShardedMVCCMapType::num_shards; ++shard_idx)
         {
-            if (!end.empty() && iter->first >= end)
-                break;
-            // Only return the page_id that is visible
-            if (iter->second->isVisible(seq))
-                page_ids.insert(iter->first);
+            const auto & shard = mvcc_table_directory.shardAt(shard_idx);
+            std::shared_lock read_lock(shard.mutex);
+            for (auto iter = shard.map.lower_bound(start); iter != shard.map.end(); ++iter)
+            {
+                if (!end.empty() && iter->first >= end)
+                    break;
+                // Only return the page_id that is visible
+                if (iter->second->isVisible(seq))
+                    page_ids.insert(iter->first);
+            }
         }
         return page_ids;
     }
@@ -1459,14 +1471,25 @@ std::optional<typename PageDirectory<Trait>::PageId> PageDirectory<Trait>::getLo
     if constexpr (std::is_same_v<Trait, universal::PageDirectoryTrait>)
     {
         auto seq = toConcreteSnapshot(snap_)->sequence;
-        std::shared_lock read_lock(table_rw_mutex);
-        for (auto iter = mvcc_table_directory.lower_bound(start); iter != mvcc_table_directory.end(); ++iter)
+        // The pages are only ordered inside a shard, find the lower bound in every shard and return the minimum one
+        std::optional<PageId> lower_bound;
+        for (size_t shard_idx = 0; shard_idx < ShardedMVCCMapType::num_shards; ++shard_idx)
         {
-            // Only return the page_id that is visible
-            if (iter->second->isVisible(seq))
-                return iter->first;
+            const auto & shard = mvcc_table_directory.shardAt(shard_idx);
+            std::shared_lock read_lock(shard.mutex);
+            for (auto iter = shard.map.lower_bound(start); iter != shard.map.end(); ++iter)
+            {
+                if (lower_bound && !(iter->first < *lower_bound))
+                    break;
+                // Only return the page_id that is visible
+                if (iter->second->isVisible(seq))
+                {
+                    lower_bound = iter->first;
+                    break;
+                }
+            }
         }
-        return std::nullopt;
+        return lower_bound;
     }
     else
     {
@@ -1476,7 +1499,7 @@ std::optional<typename PageDirectory<Trait>::PageId> PageDirectory<Trait>::getLo
 
 template <typename Trait>
 void PageDirectory<Trait>::applyRefEditRecord(
-    MVCCMapType & mvcc_table_directory,
+    ShardedMVCCMapType & mvcc_table_directory,
     const VersionedPageEntriesPtr & version_list,
     const typename PageEntriesEdit::EditRecord & rec,
     const PageVersion & version)
@@ -1518,11 +1541,10 @@ void PageDirectory<Trait>::applyRefEditRecord(
               PageVersion ver_to_resolve) -> std::tuple<bool, PageId, PageVersion> {
         while (true)
         {
-            auto resolve_ver_iter = mvcc_table_directory.find(id_to_resolve);
-            if (resolve_ver_iter == mvcc_table_directory.end())
+            const VersionedPageEntriesPtr resolve_version_list = mvcc_table_directory.find(id_to_resolve);
+            if (resolve_version_list == nullptr)
                 return {false, Trait::PageIdTrait::getInvalidID(), PageVersion(0)};
 
-            const VersionedPageEntriesPtr & resolve_version_list = resolve_ver_iter->second;
             auto [resolve_state, next_id_to_resolve, next_ver_to_resolve] = resolve_version_list->resolveToPageId(
                 ver_to_resolve.sequence,
                 /*ignore_delete=*/id_to_resolve != ori_page_id,
@@ -1564,9 +1586,9 @@ void PageDirectory<Trait>::applyRefEditRecord(
     {
         SYNC_FOR("before_PageDirectory::applyRefEditRecord_incr_ref_count");
         // Add the ref-count of being-ref entry
-        if (auto resolved_iter = mvcc_table_directory.find(resolved_id); resolved_iter != mvcc_table_directory.end())
+        if (auto resolved_version_list = mvcc_table_directory.find(resolved_id); resolved_version_list != nullptr)
         {
-            resolved_iter->second->incrRefCount(resolved_ver, version);
+            resolved_version_list->incrRefCount(resolved_ver, version);
         }
         else
         {
@@ -1711,95 +1733,84 @@ std::unordered_set<String> PageDirectory<Trait>::apply(PageEntriesEdit && edit,
     });
 
     SYNC_FOR("before_PageDirectory::apply_to_memory");
+    // create entry version list for page_id.
+    for (const auto & r : edit.getRecords())
     {
-        std::unique_lock table_lock(table_rw_mutex);
+        // Only the write group owner applies edits. The readers and gc only lock the shard they access.
+        if (r.type == EditRecordType::DEL && mvcc_table_directory.find(r.page_id) == nullptr)
+        {
+            // Deleting a non-existing page
+            GET_METRIC(tiflash_storage_page_apply_edit_type, type_del_not_exist).Increment();
+            continue;
+        }
+        auto [version_list, created] = mvcc_table_directory.getOrCreate(r.page_id, [] {
+            return std::make_shared<VersionedPageEntries<Trait>>();
+        });
 
-        // create entry version list for page_id.
-        for (const auto & r : edit.getRecords())
+        try
         {
-            // Protected in write_lock
-            if (r.type == EditRecordType::DEL)
+            switch (r.type)
+            {
+            case EditRecordType::PUT_EXTERNAL:
             {
-                auto iter = mvcc_table_directory.find(r.page_id);
-                if (iter == mvcc_table_directory.end())
+                GET_METRIC(tiflash_storage_page_apply_edit_type, type_put_external).Increment();
+                auto holder = version_list->createNewExternal(r.version, r.entry);
+                if (holder)
                 {
-                    // Deleting a non-existing page
-                    GET_METRIC(tiflash_storage_page_apply_edit_type, type_del_not_exist).Increment();
-                    continue;
+                    // put the new created holder into `external_ids`
+                    *holder = r.page_id;
+                    external_ids_by_ns.addExternalId(holder);
                 }
+                break;
             }
-            auto [iter, created] = mvcc_table_directory.insert(std::make_pair(r.page_id, nullptr));
-            if (created)
+            case EditRecordType::PUT:
             {
-                iter->second = std::make_shared<VersionedPageEntries<Trait>>();
+                GET_METRIC(tiflash_storage_page_apply_edit_type, type_put).Increment();
+                version_list->createNewEntry(r.version, r.entry);
+                break;
             }
-
-            auto & version_list = iter->second;
-            try
+            case EditRecordType::DEL:
             {
-                switch (r.type)
-                {
-                case EditRecordType::PUT_EXTERNAL:
-                {
-                    GET_METRIC(tiflash_storage_page_apply_edit_type, type_put_external).Increment();
-                    auto holder = version_list->createNewExternal(r.version, r.entry);
-                    if (holder)
-                    {
-                        // put the new created holder into `external_ids`
-                        *holder = r.page_id;
-                        external_ids_by_ns.addExternalId(holder);
-                    }
-                    break;
-                }
-                case EditRecordType::PUT:
-                {
-                    GET_METRIC(tiflash_storage_page_apply_edit_type, type_put).Increment();
-                    version_list->createNewEntry(r.version, r.entry);
-                    break;
-                }
-                case EditRecordType::DEL:
-                {
-                    assert(created == false);
-                    GET_METRIC(tiflash_storage_page_apply_edit_type, type_del).Increment();
-                    // append a "delete" to the version list
-                    version_list->createDelete(r.version);
-                    break;
-                }
-                case EditRecordType::REF:
-                {
-                    GET_METRIC(tiflash_storage_page_apply_edit_type, type_ref).Increment();
-                    applyRefEditRecord(mvcc_table_directory, version_list, r, r.version);
-                    break;
-                }
-                case EditRecordType::UPSERT:
-                case EditRecordType::VAR_DELETE:
-                case EditRecordType::VAR_ENTRY:
-                case EditRecordType::VAR_EXTERNAL:
-                case EditRecordType::VAR_REF:
-                case EditRecordType::UPDATE_DATA_FROM_REMOTE:
-                    throw Exception(
-                        ErrorCodes::LOGICAL_ERROR,
-                        "should not handle edit with invalid type, type={}",
-                        magic_enum::enum_name(r.type));
-                }
+                assert(created == false);
+                GET_METRIC(tiflash_storage_page_apply_edit_type, type_del).Increment();
+                // append a "delete" to the version list
+                version_list->createDelete(r.version);
+                break;
             }
-            catch (DB::Exception & e)
+            case EditRecordType::REF:
             {
-                e.addMessage(fmt::format(
-                    " type={} page_id={} ver={} edit_size={}",
-                    magic_enum::enum_name(r.type),
-                    r.page_id,
-                    r.version,
-                    edit_size));
-                exception.reset(e.clone());
-                e.rethrow();
+                GET_METRIC(tiflash_storage_page_apply_edit_type, type_ref).Increment();
+                applyRefEditRecord(mvcc_table_directory, version_list, r, r.version);
+                break;
+            }
+            case EditRecordType::UPSERT:
+            case EditRecordType::VAR_DELETE:
+            case EditRecordType::VAR_ENTRY:
+            case EditRecordType::VAR_EXTERNAL:
+            case EditRecordType::VAR_REF:
+            case EditRecordType::UPDATE_DATA_FROM_REMOTE:
+                throw Exception(
+                    ErrorCodes::LOGICAL_ERROR,
+                    "should not handle edit with invalid type, type={}",
+                    magic_enum::enum_name(r.type));
             }
         }
-
-        // stage 3, the edit committed, incr the sequence number to publish changes for `createSnapshot`
-        sequence.fetch_add(edit_size);
+        catch (DB::Exception & e)
+        {
+            e.addMessage(fmt::format(
+                " type={} page_id={} ver={} edit_size={}",
+                magic_enum::enum_name(r.type),
+                r.page_id,
+                r.version,
+                edit_size));
+            exception.reset(e.clone());
+            e.rethrow();
+        }
     }
 
+    // stage 3, the edit committed, incr the sequence number to publish changes for `createSnapshot`
+    sequence.fetch_add(edit_size);
+
     success = true;
     // Even for write-group owner, return only this writer's pre-captured ids.
     // Other writers return their own ids in the `w.done` branch above.
@@ -1821,64 +1832,59 @@ typename PageDirectory<Trait>::PageEntries PageDirectory<Trait>::updateLocalCach
     }
     wal->apply(Trait::Serializer::serializeTo(edit), write_limiter);
     typename PageDirectory<Trait>::PageEntries ignored_entries;
+    for (const auto & r : edit.getRecords())
     {
-        std::unique_lock table_lock(table_rw_mutex);
-
-        for (const auto & r : edit.getRecords())
+        try
         {
-            try
+            auto id_to_resolve = r.page_id;
+            auto sequence_to_resolve = seq;
+            while (true)
             {
-                auto id_to_resolve = r.page_id;
-                auto sequence_to_resolve = seq;
-                while (true)
+                auto version_list = mvcc_table_directory.find(id_to_resolve);
+                assert(version_list != nullptr);
+                // We need to ignore the "deletes" both when resolve page id and update local cache.
+                // Check `PageDirectory::getByIDImpl` or the unit test
+                // `UniPageStorageRemoteReadTest.WriteReadRefWithRestart` for details.
+                const bool ignore_delete = id_to_resolve != r.page_id;
+                auto [resolve_state, next_id_to_resolve, next_ver_to_resolve]
+                    = version_list->resolveToPageId(sequence_to_resolve, ignore_delete, nullptr);
+                if (resolve_state == ResolveResult::TO_NORMAL)
                 {
-                    auto iter = mvcc_table_directory.lower_bound(id_to_resolve);
-                    assert(iter != mvcc_table_directory.end());
-                    auto & version_list = iter->second;
-                    // We need to ignore the "deletes" both when resolve page id and update local cache.
-                    // Check `PageDirectory::getByIDImpl` or the unit test
-                    // `UniPageStorageRemoteReadTest.WriteReadRefWithRestart` for details.
-                    const bool ignore_delete = id_to_resolve != r.page_id;
-                    auto [resolve_state, next_id_to_resolve, next_ver_to_resolve]
-                        = version_list->resolveToPageId(sequence_to_resolve, ignore_delete, nullptr);
-                    if (resolve_state == ResolveResult::TO_NORMAL)
-                    {
-                        if (!version_list->updateLocalCacheForRemotePage(
-                                PageVersion(sequence_to_resolve, 0),
-                                r.entry,
-                                ignore_delete))
-                        {
-                            // The entry is not valid for updating the version_list.
-                            // Caller should notice these part of "ignored_entries" and release
-                            // the space allocated for these invalid entries.
-                            // For the information persisted in WAL, it should be ignored when
-                            // restoring from disk.
-                            ignored_entries.push_back(r.entry);
-                        }
-                        break;
-                    }
-                    else if (resolve_state == ResolveResult::TO_REF)
+                    if (!version_list->updateLocalCacheForRemotePage(
+                            PageVersion(sequence_to_resolve, 0),
+                            r.entry,
+                            ignore_delete))
                     {
-                        id_to_resolve = next_id_to_resolve;
-                        sequence_to_resolve = next_ver_to_resolve.sequence;
-                    }
-                    else
-                    {
-                        RUNTIME_CHECK(false);
+                        // The entry is not valid for updating the version_list.
+                        // Caller should notice these part of "ignored_entries" and release
+                        // the space allocated for these invalid entries.
+                        // For the information persisted in WAL, it should be ignored when
+                        // restoring from disk.
+                        ignored_entries.push_back(r.entry);
                     }
+                    break;
+                }
+                else if (resolve_state == ResolveResult::TO_REF)
+                {
+                    id_to_resolve = next_id_to_resolve;
+                    sequence_to_resolve = next_ver_to_resolve.sequence;
+                }
+                else
+                {
+                    RUNTIME_CHECK(false);
                 }
-            }
-            catch (DB::Exception & e)
-            {
-                e.addMessage(fmt::format(
-                    " type={} page_id={} ver={} seq={}",
-                    magic_enum::enum_name(r.type),
-                    r.page_id,
-                    r.version,
-                    seq));
-                throw e;
             }
         }
+        catch (DB::Exception & e)
+        {
+            e.addMessage(fmt::format(
+                " type={} page_id={} ver={} seq={}",
+                magic_enum::enum_name(r.type),
+                r.page_id,
+                r.version,
+                seq));
+            throw e;
+        }
     }
     return ignored_entries;
 }
@@ -1898,33 +1904,23 @@ void PageDirectory<Trait>::gcApply(PageEntriesEdit && migrated_edit, const Write
     // Apply migrate edit to the mvcc map
     for (const auto & record : migrated_edit.getRecords())
     {
-        typename MVCCMapType::const_iterator iter;
-        {
-            std::shared_lock read_lock(table_rw_mutex);
-            iter = mvcc_table_directory.find(record.page_id);
-            RUNTIME_CHECK_MSG(
-                iter != mvcc_table_directory.end(),
-                "Can't find page while doing gcApply, page_id={}",
-                record.page_id);
-        } // release the read lock on `table_rw_mutex`
+        const auto versioned_entries = mvcc_table_directory.find(record.page_id);
+        RUNTIME_CHECK_MSG(
+            versioned_entries != nullptr,
+            "Can't find page while doing gcApply, page_id={}",
+            record.page_id);
 
         // Append the gc version to version list
-        const auto & versioned_entries = iter->second;
         auto id_to_deref = versioned_entries->createUpsertEntry(record.version, record.entry, /*strict_check*/ true);
         if (id_to_deref != Trait::PageIdTrait::getInvalidID())
         {
             // The ref-page is rewritten into a normal page, we need to decrease the ref-count of original page
-            typename MVCCMapType::const_iterator deref_iter;
-            {
-                std::shared_lock read_lock(table_rw_mutex);
-                deref_iter = mvcc_table_directory.find(id_to_deref);
-                RUNTIME_CHECK_MSG(
-                    deref_iter != mvcc_table_directory.end(),
-                    "Can't find page to deref after gcApply, page_id={}",
-                    id_to_deref);
-            }
-            auto deref_res
-                = deref_iter->second->derefAndClean(/*lowest_seq*/ 0, id_to_deref, record.version, 1, nullptr);
+            const auto deref_entries = mvcc_table_directory.find(id_to_deref);
+            RUNTIME_CHECK_MSG(
+                deref_entries != nullptr,
+                "Can't find page to deref after gcApply, page_id={}",
+                id_to_deref);
+            auto deref_res = deref_entries->derefAndClean(/*lowest_seq*/ 0, id_to_deref, record.version, 1, nullptr);
             RUNTIME_ASSERT(!deref_res);
         }
     }
@@ -1947,15 +1943,17 @@ std::pair<typename PageDirectory<Trait>::GcEntriesMap, PageSize> PageDirectory<T
     UInt64 total_page_nums = 0;
     std::map<PageId, std::tuple<PageId, PageVersion>> ref_ids_maybe_rewrite;
 
+    for (size_t shard_idx = 0; shard_idx < ShardedMVCCMapType::num_shards; ++shard_idx)
     {
+        const auto & shard = mvcc_table_directory.shardAt(shard_idx);
         PageId page_id;
         VersionedPageEntriesPtr version_entries;
 
         {
-            std::shared_lock read_lock(table_rw_mutex);
-            auto iter = mvcc_table_directory.cbegin();
-            if (iter == mvcc_table_directory.end())
-                return {blob_versioned_entries, total_page_size};
+            std::shared_lock read_lock(shard.mutex);
+            auto iter = shard.map.cbegin();
+            if (iter == shard.map.end())
+                continue;
             page_id = iter->first;
             version_entries = iter->second;
         }
@@ -1981,15 +1979,22 @@ std::pair<typename PageDirectory<Trait>::GcEntriesMap, PageSize> PageDirectory<T
             }
 
             {
-                std::shared_lock read_lock(table_rw_mutex);
-                auto iter = mvcc_table_directory.upper_bound(page_id);
-                if (iter == mvcc_table_directory.end())
+                std::shared_lock read_lock(shard.mutex);
+                auto iter = shard.map.upper_bound(page_id);
+                if (iter == shard.map.end())
                     break;
                 page_id = iter->first;
                 version_entries = iter->second;
             }
         }
     }
+    // The shards are scanned one by one, sort the entries by page id so that the pages are rewritten in order
+    for (auto & [blob_id, entries] : blob_versioned_entries)
+    {
+        std::stable_sort(entries.begin(), entries.end(), [](const auto & lhs, const auto & rhs) {
+            return std::get<0>(lhs) < std::get<0>(rhs);
+        });
+    }
 
     // For the non-deleted ref-ids, we will check whether theirs original entries lay on
     // `blob_id_set`. Rewrite the entries for these ref-ids to be normal pages.
@@ -1999,13 +2004,8 @@ std::pair<typename PageDirectory<Trait>::GcEntriesMap, PageSize> PageDirectory<T
         const auto ori_id = std::get<0>(ori_id_ver);
         const auto ver = std::get<1>(ori_id_ver);
 
-        VersionedPageEntriesPtr version_entries;
-        {
-            std::shared_lock read_lock(table_rw_mutex);
-            auto page_iter = mvcc_table_directory.find(ori_id);
-            RUNTIME_CHECK(page_iter != mvcc_table_directory.end(), ref_id, ori_id, ver);
-            version_entries = page_iter->second;
-        }
+        VersionedPageEntriesPtr version_entries = mvcc_table_directory.find(ori_id);
+        RUNTIME_CHECK(version_entries != nullptr, ref_id, ori_id, ver);
         // After storing all data in one PageStorage instance, we will run full gc
         // with external pages. Skip rewriting if it is an external pages.
         if (version_entries->isExternalPage())
@@ -2113,17 +2113,12 @@ size_t PageDirectory<Trait>::copyCheckpointInfoFromEdit(const PageEntriesEdit &
 
         // TODO: Improve from O(nlogn) to O(n).
 
-        VersionedPageEntriesPtr entries;
-        {
-            std::shared_lock read_lock(table_rw_mutex);
-            auto iter = mvcc_table_directory.find(rec.page_id);
-            if (iter == mvcc_table_directory.end())
-                // There may be obsolete entries deleted.
-                // For example, if there is a `Put 1` with sequence 10, `Del 1` with sequence 11,
-                // and the snapshot sequence is 12, Page with id 1 may be deleted by the gc process.
-                continue;
-            entries = iter->second;
-        }
+        VersionedPageEntriesPtr entries = mvcc_table_directory.find(rec.page_id);
+        if (entries == nullptr)
+            // There may be obsolete entries deleted.
+            // For example, if there is a `Put 1` with sequence 10, `Del 1` with sequence 11,
+            // and the snapshot sequence is 12, Page with id 1 may be deleted by the gc process.
+            continue;
 
         entries->copyCheckpointInfoFromEdit(rec);
         num_copied += 1;
@@ -2221,13 +2216,6 @@ typename PageDirectory<Trait>::PageEntries PageDirectory<Trait>::gcInMemEntries(
     SYNC_FOR("after_PageDirectory::doGC_getLowestSeq");
 
     PageEntriesV3 all_del_entries;
-    typename MVCCMapType::iterator iter;
-    {
-        std::shared_lock read_lock(table_rw_mutex);
-        iter = mvcc_table_directory.begin();
-        if (iter == mvcc_table_directory.end())
-            return all_del_entries;
-    }
 
     // The number of page removed this round. Not counting raft pages.
     UInt64 invalid_page_nums = 0;
@@ -2238,64 +2226,76 @@ typename PageDirectory<Trait>::PageEntries PageDirectory<Trait>::gcInMemEntries(
     // The page_id that we need to decrease ref count
     // { id_0: <version, num to decrease>, id_1: <...>, ... }
     std::map<PageId, std::pair<PageVersion, Int64>> normal_entries_to_deref;
-    // Iterate all page_id and try to clean up useless var entries
-    while (true)
+    // Iterate all page_id and try to clean up useless var entries, shard by shard
+    for (size_t shard_idx = 0; shard_idx < ShardedMVCCMapType::num_shards; ++shard_idx)
     {
-        bool page_id_from_raft = false;
-        UInt64 actual_seq = 0;
-        if constexpr (std::is_same_v<Trait, universal::PageDirectoryTrait>)
-        {
-            // For Universal PageDirectory, we store Raft data together but this kind
-            // of data is frequently created and deleted. So we split the snapshot into
-            // two kinds and the delta-tree-only reading snapshot does not protect the
-            // Raft data from being GCed.
-            // If the page_id is from proxy and there is no general snapshot,
-            // we can use `seq_clone` to clean up entries more aggressively to
-            // reduce memory usage.
-            page_id_from_raft = Trait::PageIdTrait::isFromRaftLayer(iter->first); //
-            if (page_id_from_raft)
-            {
-                // Pages from proxy is only protected by general snapshots
-                actual_seq = snap_stat.general_seq.value_or(snap_stat.seq);
-            }
-            else
-            {
-                // Other Pages are protected by all kinds of snapshots
-                actual_seq = snap_stat.lowest_seq_of_all;
-            }
-        }
-        else
+        auto & shard = mvcc_table_directory.shardAt(shard_idx);
+        typename MVCCMapType::iterator iter;
         {
-            // Protected by all kinds of snapshots
-            actual_seq = snap_stat.lowest_seq_of_all;
+            std::shared_lock read_lock(shard.mutex);
+            iter = shard.map.begin();
+            if (iter == shard.map.end())
+                continue;
         }
-        // `iter` is an iter that won't be invalid cause by `apply`/`gcApply`.
-        // do gc on the version list without lock on `mvcc_table_directory`.
-        const bool all_deleted = iter->second->cleanOutdatedEntries(
-            actual_seq,
-            &normal_entries_to_deref,
-            options.need_removed_entries ? &all_del_entries : nullptr,
-            options.remote_valid_sizes,
-            iter->second->acquireLock());
 
+        while (true)
         {
-            std::unique_lock write_lock(table_rw_mutex);
-            if (all_deleted)
+            bool page_id_from_raft = false;
+            UInt64 actual_seq = 0;
+            if constexpr (std::is_same_v<Trait, universal::PageDirectoryTrait>)
             {
-                iter = mvcc_table_directory.erase(iter);
+                // For Universal PageDirectory, we store Raft data together but this kind
+                // of data is frequently created and deleted. So we split the snapshot into
+                // two kinds and the delta-tree-only reading snapshot does not protect the
+                // Raft data from being GCed.
+                // If the page_id is from proxy and there is no general snapshot,
+                // we can use `seq_clone` to clean up entries more aggressively to
+                // reduce memory usage.
+                page_id_from_raft = Trait::PageIdTrait::isFromRaftLayer(iter->first); //
                 if (page_id_from_raft)
-                    invalid_raft_pages_nums++;
+                {
+                    // Pages from proxy is only protected by general snapshots
+                    actual_seq = snap_stat.general_seq.value_or(snap_stat.seq);
+                }
                 else
-                    invalid_page_nums++;
+                {
+                    // Other Pages are protected by all kinds of snapshots
+                    actual_seq = snap_stat.lowest_seq_of_all;
+                }
             }
             else
             {
-                valid_page_nums++;
-                iter++;
+                // Protected by all kinds of snapshots
+                actual_seq = snap_stat.lowest_seq_of_all;
             }
+            // `iter` is an iter that won't be invalid cause by `apply`/`gcApply`.
+            // do gc on the version list without lock on the shard.
+            const bool all_deleted = iter->second->cleanOutdatedEntries(
+                actual_seq,
+                &normal_entries_to_deref,
+                options.need_removed_entries ? &all_del_entries : nullptr,
+                options.remote_valid_sizes,
+                iter->second->acquireLock());
 
-            if (iter == mvcc_table_directory.end())
-                break;
+            {
+                std::unique_lock write_lock(shard.mutex);
+                if (all_deleted)
+                {
+                    iter = shard.map.erase(iter);
+                    if (page_id_from_raft)
+                        invalid_raft_pages_nums++;
+                    else
+                        invalid_page_nums++;
+                }
+                else
+                {
+                    valid_page_nums++;
+                    iter++;
+                }
+
+                if (iter == shard.map.end())
+                    break;
+            }
         }
     }
 
@@ -2304,11 +2304,12 @@ typename PageDirectory<Trait>::PageEntries PageDirectory<Trait>::gcInMemEntries(
     // Iterate all page_id that need to decrease ref count of specified version.
     for (const auto & [page_id, deref_counter] : normal_entries_to_deref)
     {
+        auto & shard = mvcc_table_directory.shardOf(page_id);
         typename MVCCMapType::iterator iter;
         {
-            std::shared_lock read_lock(table_rw_mutex);
-            iter = mvcc_table_directory.find(page_id);
-            if (iter == mvcc_table_directory.end())
+            std::shared_lock read_lock(shard.mutex);
+            iter = shard.map.find(page_id);
+            if (iter == shard.map.end())
                 continue;
         }
 
@@ -2321,8 +2322,8 @@ typename PageDirectory<Trait>::PageEntries PageDirectory<Trait>::gcInMemEntries(
 
         if (all_deleted)
         {
-            std::unique_lock write_lock(table_rw_mutex);
-            mvcc_table_directory.erase(iter);
+            std::unique_lock write_lock(shard.mutex);
+            shard.map.erase(iter);
             invalid_page_nums++;
             valid_page_nums--;
         }
@@ -2369,29 +2370,39 @@ typename PageDirectory<Trait>::PageEntriesEdit PageDirectory<Trait>::dumpSnapsho
 
     PageEntriesEdit edit;
 
-    PageId iter_k;
-    VersionedPageEntriesPtr iter_v;
-    {
-        std::shared_lock read_lock(table_rw_mutex);
-        auto iter = mvcc_table_directory.begin();
-        if (iter == mvcc_table_directory.end())
-            return edit;
-        iter_k = iter->first;
-        iter_v = iter->second;
-    }
-    while (true)
+    for (size_t shard_idx = 0; shard_idx < ShardedMVCCMapType::num_shards; ++shard_idx)
     {
-        iter_v->collapseTo(snap->sequence, iter_k, edit);
-
+        const auto & shard = mvcc_table_directory.shardAt(shard_idx);
+        PageId iter_k;
+        VersionedPageEntriesPtr iter_v;
         {
-            std::shared_lock read_lock(table_rw_mutex);
-            auto iter = mvcc_table_directory.upper_bound(iter_k);
-            if (iter == mvcc_table_directory.end())
-                break;
+            std::shared_lock read_lock(shard.mutex);
+            auto iter = shard.map.begin();
+            if (iter == shard.map.end())
+                continue;
             iter_k = iter->first;
             iter_v = iter->second;
         }
+        while (true)
+        {
+            iter_v->collapseTo(snap->sequence, iter_k, edit);
+
+            {
+                std::shared_lock read_lock(shard.mutex);
+                auto iter = shard.map.upper_bound(iter_k);
+                if (iter == shard.map.end())
+                    break;
+                iter_k = iter->first;
+                iter_v = iter->second;
+            }
+        }
     }
+    // Keep the records ordered by page id as the edit dumped from a single ordered map, the records
+    // of the same page id are kept in the order of version.
+    auto & records = edit.getMutRecords();
+    std::stable_sort(records.begin(), records.end(), [](const auto & lhs, const auto & rhs) {
+        return lhs.page_id < rhs.page_id;
+    });
 
     LOG_INFO(log, "Dumped snapshot to edits, sequence={} edit_size={}", snap->sequence, edit.size());
     return edit;
@@ -2402,13 +2413,17 @@ size_t PageDirectory<Trait>::numPagesWithPrefix(const String & prefix) const
 {
     if constexpr (std::is_same_v<Trait, universal::PageDirectoryTrait>)
     {
-        std::shared_lock read_lock(table_rw_mutex);
         size_t num = 0;
-        for (auto iter = mvcc_table_directory.lower_bound(prefix); iter != mvcc_table_directory.end(); ++iter)
+        for (size_t shard_idx = 0; shard_idx < ShardedMVCCMapType::num_shards; ++shard_idx)
         {
-            if (!iter->first.hasPrefix(prefix))
-                break;
-            num++;
+            const auto & shard = mvcc_table_directory.shardAt(shard_idx);
+            std::shared_lock read_lock(shard.mutex);
+            for (auto iter = shard.map.lower_bound(prefix); iter != shard.map.end(); ++iter)
+            {
+                if (!iter->first.hasPrefix(prefix))
+                    break;
+                num++;
+            }
         }
         return num;
     }
@@ -24,6 +24,8 @@
 #include <Storages/Page/V3/MapUtils.h>
 #include <Storages/Page/V3/PageDefines.h>
 #include <Storages/Page/V3/PageDirectory/ExternalIdsByNamespace.h>
+#include <Storages/Page/V3/PageDirectory/ShardedMVCCMap.h>
+#include <Storages/Page/V3/PageDirectory/VersionedEntryList.h>
 #include <Storages/Page/V3/PageEntriesEdit.h>
 #include <Storages/Page/V3/PageEntry.h>
 #include <Storages/Page/V3/WAL/serialize.h>
@@ -101,6 +103,8 @@ public:
             versioned_ref_counts = nullptr;
         }
     }
+    MultiVersionRefCount(MultiVersionRefCount && other) noexcept = default;
+    MultiVersionRefCount & operator=(MultiVersionRefCount && other) noexcept = default;
 
     void restoreFrom(const PageVersion & ver, Int64 ref_count)
     {
@@ -232,6 +236,26 @@ struct EntryOrDelete
         if (entry)
             PageStorageMemorySummary::versioned_entry_or_delete_bytes.fetch_add(sizeof(PageEntryV3));
     }
+    // Moving is required by `VersionedEntryList` when inserting or erasing versions.
+    // The moved-from entry still holds a value, so the bytes are released by its dtor.
+    EntryOrDelete(EntryOrDelete && other) noexcept
+        : being_ref_count(std::move(other.being_ref_count))
+        , entry(std::move(other.entry))
+    {
+        PageStorageMemorySummary::versioned_entry_or_delete_count.fetch_add(1);
+        if (entry)
+            PageStorageMemorySummary::versioned_entry_or_delete_bytes.fetch_add(sizeof(PageEntryV3));
+    }
+    EntryOrDelete & operator=(EntryOrDelete && other) noexcept
+    {
+        if (entry)
+            PageStorageMemorySummary::versioned_entry_or_delete_bytes.fetch_sub(sizeof(PageEntryV3));
+        being_ref_count = std::move(other.being_ref_count);
+        entry = std::move(other.entry);
+        if (entry)
+            PageStorageMemorySummary::versioned_entry_or_delete_bytes.fetch_add(sizeof(PageEntryV3));
+        return *this;
+    }
     EntryOrDelete() { PageStorageMemorySummary::versioned_entry_or_delete_count.fetch_add(1); }
     EntryOrDelete(std::optional<PageEntryV3> entry_)
         : entry(std::move(entry_))
@@ -297,10 +321,18 @@ public:
     VersionedPageEntries()
         : type(EditRecordType::VAR_DELETE)
         , is_deleted(false)
-        , create_ver(0)
-        , delete_ver(0)
-        , ori_page_id{}
-    {}
+    {
+        PageStorageMemorySummary::versioned_page_entries_count.fetch_add(1);
+        PageStorageMemorySummary::versioned_page_entries_bytes.fetch_add(sizeof(VersionedPageEntries));
+    }
+
+    ~VersionedPageEntries()
+    {
+        PageStorageMemorySummary::versioned_page_entries_count.fetch_sub(1);
+        PageStorageMemorySummary::versioned_page_entries_bytes.fetch_sub(sizeof(VersionedPageEntries));
+    }
+
+    DISALLOW_COPY_AND_MOVE(VersionedPageEntries);
 
     bool isExternalPage() const { return type == EditRecordType::VAR_EXTERNAL; }
 
@@ -386,23 +418,55 @@ public:
 
     String toDebugString() const
     {
+        if (!ref_state)
+            return fmt::format(
+                "{{type:{}, is_deleted: {}, num_entries: {}}}",
+                magic_enum::enum_name(type),
+                is_deleted,
+                entries.size());
         return fmt::format(
             "{{"
             "type:{}, create_ver: {}, is_deleted: {}, delete_ver: {}, "
             "ori_page_id: {}, being_ref_count: {}, num_entries: {}"
             "}}",
             magic_enum::enum_name(type),
-            create_ver,
+            ref_state->create_ver,
             is_deleted,
-            delete_ver,
-            ori_page_id,
-            being_ref_count.getLatestRefCount(),
+            ref_state->delete_ver,
+            ref_state->ori_page_id,
+            ref_state->being_ref_count.getLatestRefCount(),
             entries.size());
     }
     template <typename T>
     friend class PageStorageControlV3;
 
 private:
+    // The states only valid when type == VAR_REF/VAR_EXTERNAL. Most of the pages are
+    // VAR_ENTRY, so it is allocated on demand to keep `VersionedPageEntries` small.
+    struct RefOrExternalState
+    {
+        RefOrExternalState()
+        {
+            PageStorageMemorySummary::versioned_page_entries_bytes.fetch_add(sizeof(RefOrExternalState));
+        }
+        ~RefOrExternalState()
+        {
+            PageStorageMemorySummary::versioned_page_entries_bytes.fetch_sub(sizeof(RefOrExternalState));
+        }
+        DISALLOW_COPY_AND_MOVE(RefOrExternalState);
+
+        // The created version, valid when type == VAR_REF/VAR_EXTERNAL
+        PageVersion create_ver{0};
+        // The deleted version, valid when type == VAR_REF/VAR_EXTERNAL && is_deleted = true
+        PageVersion delete_ver{0};
+        // Original page id, valid when type == VAR_REF
+        PageId ori_page_id{};
+        // Being ref counter, valid when type == VAR_EXTERNAL
+        MultiVersionRefCount being_ref_count;
+        // A shared ptr to a holder, valid when type == VAR_EXTERNAL
+        std::shared_ptr<PageId> external_holder;
+    };
+
     mutable std::mutex m;
 
     // Valid value of `type` is one of
@@ -414,18 +478,11 @@ private:
 
     // Has been deleted, valid when type == VAR_REF/VAR_EXTERNAL
     bool is_deleted;
-    // Entries sorted by version, valid when type == VAR_ENTRY
-    std::multimap<PageVersion, EntryOrDelete> entries;
-    // The created version, valid when type == VAR_REF/VAR_EXTERNAL
-    PageVersion create_ver;
-    // The deleted version, valid when type == VAR_REF/VAR_EXTERNAL && is_deleted = true
-    PageVersion delete_ver;
-    // Original page id, valid when type == VAR_REF
-    PageId ori_page_id;
-    // Being ref counter, valid when type == VAR_EXTERNAL
-    MultiVersionRefCount being_ref_count;
-    // A shared ptr to a holder, valid when type == VAR_EXTERNAL
-    std::shared_ptr<PageId> external_holder;
+    // Entries sorted by version, valid when type == VAR_ENTRY/VAR_EXTERNAL.
+    // The single version is stored inline.
+    VersionedEntryList<PageVersion, EntryOrDelete> entries;
+    // Not null iff type == VAR_REF/VAR_EXTERNAL
+    std::unique_ptr<RefOrExternalState> ref_state;
 };
 
 struct SnapshotGCStatistics
@@ -569,11 +626,7 @@ public:
     PageEntriesEdit dumpSnapshotToEdit(PageDirectorySnapshotPtr snap = nullptr);
 
     // Approximate number of pages in memory
-    size_t numPages() const
-    {
-        std::shared_lock read_lock(table_rw_mutex);
-        return mvcc_table_directory.size();
-    }
+    size_t numPages() const { return mvcc_table_directory.size(); }
     // Only used in test
     size_t numPagesWithPrefix(const String & prefix) const;
 
@@ -608,14 +661,13 @@ private:
     SnapshotGCStatistics gcInMemSnapshots() const;
 
 private:
-    // Only `std::map` is allow for `MVCCMap`. Cause `std::map::insert` ensure that
-    // "No iterators or references are invalidated"
-    // https://en.cppreference.com/w/cpp/container/map/insert
     using VersionedPageEntriesPtr = std::shared_ptr<VersionedPageEntries<Trait>>;
-    using MVCCMapType = std::map<PageId, VersionedPageEntriesPtr>;
+    using ShardedMVCCMapType = ShardedMVCCMap<PageId, VersionedPageEntriesPtr>;
+    // The map of a single shard
+    using MVCCMapType = typename ShardedMVCCMapType::Map;
 
     static void applyRefEditRecord(
-        MVCCMapType & mvcc_table_directory,
+        ShardedMVCCMapType & mvcc_table_directory,
         const VersionedPageEntriesPtr & version_list,
         const typename PageEntriesEdit::EditRecord & rec,
         const PageVersion & version);
@@ -667,9 +719,9 @@ private:
     //   2. it becomes the head of the queue, so it continue to finish the write process of the leader;
     std::deque<Writer *> writers;
 
-    // Used to protect mvcc_table_directory between apply threads and read threads
-    mutable std::shared_mutex table_rw_mutex;
-    MVCCMapType mvcc_table_directory;
+    // Every shard of mvcc_table_directory is protected by its own lock, so the apply threads, read threads
+    // and gc threads accessing different pages do not block each other.
+    ShardedMVCCMapType mvcc_table_directory;
 
     mutable std::mutex snapshots_mutex;
     mutable std::list<std::weak_ptr<PageDirectorySnapshot>> snapshots;
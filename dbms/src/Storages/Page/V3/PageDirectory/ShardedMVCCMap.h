@@ -0,0 +1,110 @@
+// Copyright 2024 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Common/nocopyable.h>
+
+#include <array>
+#include <functional>
+#include <map>
+#include <shared_mutex>
+
+namespace DB::PS::V3
+{
+// The map from page id to its versioned entries used by `PageDirectory`.
+// The pages are split into shards by the hash of page id, and every shard is an ordered `std::map`
+// protected by its own `shared_mutex`. So the threads accessing different pages (read, write, gc)
+// do not contend on a single lock.
+// The pages are only ordered inside a shard. The caller should merge the results of all shards
+// if a global order is required.
+template <typename PageId, typename Value>
+class ShardedMVCCMap
+{
+public:
+    // Only `std::map` is allowed. Cause `std::map::insert` ensure that
+    // "No iterators or references are invalidated"
+    // https://en.cppreference.com/w/cpp/container/map/insert
+    using Map = std::map<PageId, Value>;
+
+    struct Shard
+    {
+        mutable std::shared_mutex mutex;
+        Map map;
+    };
+
+    static constexpr size_t num_shards = 32;
+
+    ShardedMVCCMap() = default;
+
+    DISALLOW_COPY_AND_MOVE(ShardedMVCCMap);
+
+    Shard & shardAt(size_t index) { return shards[index]; }
+    const Shard & shardAt(size_t index) const { return shards[index]; }
+
+    Shard & shardOf(const PageId & page_id) { return shards[std::hash<PageId>()(page_id) % num_shards]; }
+    const Shard & shardOf(const PageId & page_id) const
+    {
+        return shards[std::hash<PageId>()(page_id) % num_shards];
+    }
+
+    // Return a default constructed `Value` (nullptr) if the page does not exist.
+    Value find(const PageId & page_id) const
+    {
+        const auto & shard = shardOf(page_id);
+        std::shared_lock read_lock(shard.mutex);
+        auto iter = shard.map.find(page_id);
+        return iter == shard.map.end() ? Value{} : iter->second;
+    }
+
+    // Return the value of `page_id`, create it by `creator` if not exist.
+    template <typename Creator>
+    std::pair<Value, bool> getOrCreate(const PageId & page_id, Creator && creator)
+    {
+        auto & shard = shardOf(page_id);
+        std::unique_lock write_lock(shard.mutex);
+        auto [iter, created] = shard.map.try_emplace(page_id);
+        if (created)
+            iter->second = creator();
+        return {iter->second, created};
+    }
+
+    // Approximate number of pages, the shards are not locked at the same time.
+    size_t size() const
+    {
+        size_t total = 0;
+        for (const auto & shard : shards)
+        {
+            std::shared_lock read_lock(shard.mutex);
+            total += shard.map.size();
+        }
+        return total;
+    }
+
+    // Copy all pages in order. Only used by tools, which do not care about the memory and time cost.
+    Map copyAll() const
+    {
+        Map all;
+        for (const auto & shard : shards)
+        {
+            std::shared_lock read_lock(shard.mutex);
+            all.insert(shard.map.begin(), shard.map.end());
+        }
+        return all;
+    }
+
+private:
+    std::array<Shard, num_shards> shards;
+};
+} // namespace DB::PS::V3
@@ -0,0 +1,136 @@
+// Copyright 2024 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Common/nocopyable.h>
+#include <Storages/Page/PageStorageMemorySummary.h>
+#include <absl/container/inlined_vector.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace DB::PS::V3
+{
+// A multimap from version to value sorted by version, used by `VersionedPageEntries`.
+// Most of the pages only have one live version, so the first version is stored inline
+// and only the pages with multiple versions allocate memory on heap.
+// It provides the subset of `std::multimap` interface used by `VersionedPageEntries`
+// and `MapUtils`. Note that unlike `std::multimap`, inserting or erasing invalidates
+// all the iterators.
+template <typename Key, typename Value>
+class VersionedEntryList
+{
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<Key, Value>;
+
+private:
+    static constexpr size_t inline_capacity = 1;
+    using Container = absl::InlinedVector<value_type, inline_capacity>;
+
+public:
+    using iterator = typename Container::iterator;
+    using const_iterator = typename Container::const_iterator;
+    using reverse_iterator = typename Container::reverse_iterator;
+    using const_reverse_iterator = typename Container::const_reverse_iterator;
+
+    VersionedEntryList() = default;
+
+    ~VersionedEntryList() { PageStorageMemorySummary::versioned_page_entries_bytes.fetch_sub(allocatedBytes()); }
+
+    DISALLOW_COPY_AND_MOVE(VersionedEntryList);
+
+    size_t size() const { return values.size(); }
+    bool empty() const { return values.empty(); }
+
+    iterator begin() { return values.begin(); }
+    iterator end() { return values.end(); }
+    const_iterator begin() const { return values.begin(); }
+    const_iterator end() const { return values.end(); }
+    const_iterator cbegin() const { return values.cbegin(); }
+    const_iterator cend() const { return values.cend(); }
+    reverse_iterator rbegin() { return values.rbegin(); }
+    reverse_iterator rend() { return values.rend(); }
+    const_reverse_iterator rbegin() const { return values.rbegin(); }
+    const_reverse_iterator rend() const { return values.rend(); }
+
+    // Same as `std::multimap::emplace`, the new value is inserted after the values with the same key.
+    iterator emplace(const Key & key, Value && value)
+    {
+        const size_t bytes_before = allocatedBytes();
+        // The versions are appended in increasing order in most cases
+        auto pos = (values.empty() || !(key < values.back().first)) ? values.end() : upper_bound(key);
+        auto iter = values.emplace(pos, key, std::move(value));
+        PageStorageMemorySummary::versioned_page_entries_bytes.fetch_add(allocatedBytes() - bytes_before);
+        return iter;
+    }
+
+    iterator erase(const_iterator pos) { return values.erase(pos); }
+
+    iterator find(const Key & key)
+    {
+        auto iter = lower_bound(key);
+        return (iter != values.end() && iter->first == key) ? iter : values.end();
+    }
+    const_iterator find(const Key & key) const
+    {
+        auto iter = lower_bound(key);
+        return (iter != values.end() && iter->first == key) ? iter : values.end();
+    }
+
+    iterator lower_bound(const Key & key) // NOLINT(readability-identifier-naming)
+    {
+        return std::lower_bound(values.begin(), values.end(), key, keyLess);
+    }
+    const_iterator lower_bound(const Key & key) const // NOLINT(readability-identifier-naming)
+    {
+        return std::lower_bound(values.begin(), values.end(), key, keyLess);
+    }
+
+    iterator upper_bound(const Key & key) // NOLINT(readability-identifier-naming)
+    {
+        return std::upper_bound(values.begin(), values.end(), key, lessKey);
+    }
+    const_iterator upper_bound(const Key & key) const // NOLINT(readability-identifier-naming)
+    {
+        return std::upper_bound(values.begin(), values.end(), key, lessKey);
+    }
+
+    // Move the values back to the inline storage if possible. It should be called after
+    // erasing values, otherwise the heap memory is kept until the list is destroyed.
+    void shrinkToFit()
+    {
+        if (allocatedBytes() == 0 || values.size() > inline_capacity)
+            return;
+        const size_t bytes_before = allocatedBytes();
+        values.shrink_to_fit();
+        PageStorageMemorySummary::versioned_page_entries_bytes.fetch_sub(bytes_before - allocatedBytes());
+    }
+
+    // The bytes allocated on heap, 0 means all values are stored inline.
+    size_t allocatedBytes() const
+    {
+        return values.capacity() > inline_capacity ? values.capacity() * sizeof(value_type) : 0;
+    }
+
+private:
+    static bool keyLess(const value_type & lhs, const Key & rhs) { return lhs.first < rhs; }
+    static bool lessKey(const Key & lhs, const value_type & rhs) { return lhs < rhs.first; }
+
+private:
+    Container values;
+};
+} // namespace DB::PS::V3
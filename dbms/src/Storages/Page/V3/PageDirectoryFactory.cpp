@@ -13,6 +13,10 @@
 // limitations under the License.
 
 #include <Common/Exception.h>
+#include <Common/MPMCQueue.h>
+#include <Common/Stopwatch.h>
+#include <Common/TiFlashMetrics.h>
+#include <Common/UniThreadPool.h>
 #include <Storages/Page/V3/PageDefines.h>
 #include <Storages/Page/V3/PageDirectory.h>
 #include <Storages/Page/V3/PageDirectoryFactory.h>
@@ -23,6 +27,8 @@
 #include <Storages/Page/V3/WALStore.h>
 #include <common/logger_useful.h>
 
+#include <ext/scope_guard.h>
+#include <future>
 #include <memory>
 #include <optional>
 
@@ -42,6 +48,7 @@ typename PageDirectoryFactory<Trait>::PageDirectoryPtr PageDirectoryFactory<Trai
     const WALConfig & config)
 {
     auto [wal, reader] = WALStore::create(storage_name, file_provider, delegator, config);
+    restore_threads = std::max<size_t>(config.restore_threads.get(), 1);
     return createFromReader(storage_name, reader, std::move(wal));
 }
 
@@ -51,6 +58,7 @@ typename PageDirectoryFactory<Trait>::PageDirectoryPtr PageDirectoryFactory<Trai
     WALStoreReaderPtr reader,
     WALStorePtr wal)
 {
+    Stopwatch total_watch;
     PageDirectoryPtr dir = std::make_unique<typename Trait::PageDirectory>(storage_name, std::move(wal));
     loadFromDisk(dir, std::move(reader));
 
@@ -60,14 +68,21 @@ typename PageDirectoryFactory<Trait>::PageDirectoryPtr PageDirectoryFactory<Trai
     // After restoring from the disk, we need cleanup all invalid entries in memory, or it will
     // try to run GC again on some entries that are already marked as invalid in BlobStore.
     // It's no need to remove the expired entries in BlobStore, so skip filling removed_entries to improve performance.
+    Stopwatch watch;
     dir->gcInMemEntries({.need_removed_entries = false});
+    GET_METRIC(tiflash_storage_page_restore_duration_seconds, type_gc_in_mem).Observe(watch.elapsedSeconds());
     LOG_INFO(
         DB::Logger::get(storage_name),
-        "PageDirectory restored, max_page_id={} max_applied_ver={}",
+        "PageDirectory restored, max_page_id={} max_applied_ver={} restore_threads={} elapsed={:.3f}s",
         dir->getMaxIdAfterRestart(),
-        dir->sequence);
+        dir->sequence,
+        restore_threads,
+        total_watch.elapsedSeconds());
 
+    watch.restart();
     restoreBlobStats(dir);
+    GET_METRIC(tiflash_storage_page_restore_duration_seconds, type_blob_stats).Observe(watch.elapsedSeconds());
+    GET_METRIC(tiflash_storage_page_restore_duration_seconds, type_total).Observe(total_watch.elapsedSeconds());
 
     return dir;
 }
@@ -139,42 +154,46 @@ void PageDirectoryFactory<Trait>::restoreBlobStats(const PageDirectoryPtr & dir)
     // the latest entry to `blob_stats`, or we may meet error since
     // some entries may be removed in memory but not get compacted
     // in the log file.
-    for (const auto & [page_id, entries] : dir->mvcc_table_directory)
+    for (size_t shard_idx = 0; shard_idx < Trait::PageDirectory::ShardedMVCCMapType::num_shards; ++shard_idx)
     {
-        // We should restore the entry to `blob_stats` even if it is marked as "deleted",
-        // or we will mistakenly reuse the space to write other blobs down into that space.
-        // So we need to use `getLastEntry` instead of `getEntry(version)` here.
-        if (auto entry = entries->getLastEntry(std::nullopt); entry)
+        const auto & shard = dir->mvcc_table_directory.shardAt(shard_idx);
+        for (const auto & [page_id, entries] : shard.map)
         {
-            auto [success, details_msg] = blob_stats->restoreByEntry(*entry);
-            if (success)
-                continue;
-
-            // Restore entry to blob_stats fail, if the entry->size == 0,
-            // it is acceptable. Just ingore.
-            if (entry->size == 0)
+            // We should restore the entry to `blob_stats` even if it is marked as "deleted",
+            // or we will mistakenly reuse the space to write other blobs down into that space.
+            // So we need to use `getLastEntry` instead of `getEntry(version)` here.
+            if (auto entry = entries->getLastEntry(std::nullopt); entry)
             {
-                // log down the page_id for tracing back
-                LOG_WARNING(
-                    Logger::get(),
-                    "Restore position from BlobStat ignore empty page"
-                    ", offset=0x{:X} blob_id={} page_id={} entry={}",
-                    entry->offset,
-                    entry->file_id,
-                    page_id,
-                    *entry);
-            }
-            else
-            {
-                LOG_ERROR(Logger::get(), details_msg);
-                throw Exception(
-                    ErrorCodes::LOGICAL_ERROR,
-                    "Restore position from BlobStat failed, the space/subspace is already being used"
-                    ", offset=0x{:X} blob_id={} page_id={} entry={}",
-                    entry->offset,
-                    entry->file_id,
-                    page_id,
-                    *entry);
+                auto [success, details_msg] = blob_stats->restoreByEntry(*entry);
+                if (success)
+                    continue;
+
+                // Restore entry to blob_stats fail, if the entry->size == 0,
+                // it is acceptable. Just ingore.
+                if (entry->size == 0)
+                {
+                    // log down the page_id for tracing back
+                    LOG_WARNING(
+                        Logger::get(),
+                        "Restore position from BlobStat ignore empty page"
+                        ", offset=0x{:X} blob_id={} page_id={} entry={}",
+                        entry->offset,
+                        entry->file_id,
+                        page_id,
+                        *entry);
+                }
+                else
+                {
+                    LOG_ERROR(Logger::get(), details_msg);
+                    throw Exception(
+                        ErrorCodes::LOGICAL_ERROR,
+                        "Restore position from BlobStat failed, the space/subspace is already being used"
+                        ", offset=0x{:X} blob_id={} page_id={} entry={}",
+                        entry->offset,
+                        entry->file_id,
+                        page_id,
+                        *entry);
+                }
             }
         }
     }
@@ -234,22 +253,13 @@ void PageDirectoryFactory<Trait>::applyRecord(
     const typename PageEntriesEdit::EditRecord & r,
     bool strict_check)
 {
-    auto [iter, created] = dir->mvcc_table_directory.insert(std::make_pair(r.page_id, nullptr));
-    if (created)
-    {
-        if constexpr (std::is_same_v<Trait, u128::FactoryTrait>)
-        {
-            iter->second = std::make_shared<VersionedPageEntries<u128::PageDirectoryTrait>>();
-        }
-        else if constexpr (std::is_same_v<Trait, universal::FactoryTrait>)
-        {
-            iter->second = std::make_shared<VersionedPageEntries<universal::PageDirectoryTrait>>();
-        }
-    }
+    using VersionedPageEntriesType = typename Trait::PageDirectory::VersionedPageEntriesPtr::element_type;
+    auto [version_list, created] = dir->mvcc_table_directory.getOrCreate(r.page_id, [] {
+        return std::make_shared<VersionedPageEntriesType>();
+    });
 
     updateMaxIdByRecord(dir, r);
 
-    const auto & version_list = iter->second;
     const auto & restored_version = r.version;
     try
     {
@@ -286,10 +296,9 @@ void PageDirectoryFactory<Trait>::applyRecord(
         {
             auto id_to_resolve = r.page_id;
             auto sequence_to_resolve = restored_version.sequence;
-            auto version_list_iter = iter;
+            auto current_version_list = version_list;
             while (true)
             {
-                const auto & current_version_list = version_list_iter->second;
                 // We need to ignore the "deletes" both when resolve page id and update local cache.
                 // Check `PageDirectory::getByIDImpl` or the unit test
                 // `UniPageStorageRemoteReadTest.WriteReadRefWithRestart` for details.
@@ -313,8 +322,8 @@ void PageDirectoryFactory<Trait>::applyRecord(
                 {
                     RUNTIME_CHECK(false);
                 }
-                version_list_iter = dir->mvcc_table_directory.lower_bound(id_to_resolve);
-                assert(version_list_iter != dir->mvcc_table_directory.end());
+                current_version_list = dir->mvcc_table_directory.find(id_to_resolve);
+                assert(current_version_list != nullptr);
             }
             break;
         }
@@ -331,13 +340,13 @@ void PageDirectoryFactory<Trait>::applyRecord(
             if (Trait::PageIdTrait::getU64ID(id_to_deref) != INVALID_PAGE_U64_ID)
             {
                 // The ref-page is rewritten into a normal page, we need to decrease the ref-count of the original page
-                auto deref_iter = dir->mvcc_table_directory.find(id_to_deref);
+                auto deref_entries = dir->mvcc_table_directory.find(id_to_deref);
                 RUNTIME_CHECK_MSG(
-                    deref_iter != dir->mvcc_table_directory.end(),
+                    deref_entries != nullptr,
                     "Can't find page to deref when applying upsert, page_id={}",
                     id_to_deref);
                 auto deref_res
-                    = deref_iter->second->derefAndClean(/*lowest_seq*/ 0, id_to_deref, restored_version, 1, nullptr);
+                    = deref_entries->derefAndClean(/*lowest_seq*/ 0, id_to_deref, restored_version, 1, nullptr);
                 RUNTIME_ASSERT(!deref_res);
             }
             break;
@@ -377,17 +386,49 @@ void PageDirectoryFactory<Trait>::updateMaxIdByRecord(
     }
 }
 
+namespace
+{
+// The edits decoded by different threads hold their own copies of the data file ids, share them
+// to save memory as `Serializer::deserializeFrom` does.
+template <typename PageEntriesEdit>
+void shareDataFileIds(PageEntriesEdit & edit, DataFileIdSet & data_file_ids)
+{
+    for (auto & r : edit.getMutRecords())
+    {
+        if (!r.entry.checkpoint_info.has_value())
+            continue;
+        auto & data_file_id = r.entry.checkpoint_info.data_location.data_file_id;
+        if (auto iter = data_file_ids.find(*data_file_id); iter != data_file_ids.end())
+            data_file_id = *iter;
+        else
+            data_file_ids.emplace(data_file_id);
+    }
+}
+} // namespace
+
 template <typename Trait>
 void PageDirectoryFactory<Trait>::loadFromDisk(const PageDirectoryPtr & dir, WALStoreReaderPtr && reader)
 {
-    DataFileIdSet data_file_ids;
     auto checkpoint_snap_seq = reader->getSnapSeqForCheckpoint();
     // make sure the max sequence is larger or equal than the checkpoint sequence
     if (max_applied_ver.sequence < checkpoint_snap_seq)
         max_applied_ver = PageVersion(checkpoint_snap_seq, 0);
 
+    // The edits can not be applied in parallel, but the log files can be read and decoded in parallel.
+    // The debug tool always read in the current thread to keep the dumped entries in order.
+    if (restore_threads > 1 && !debug.dump_entries)
+    {
+        loadFromDiskParallel(dir, reader, checkpoint_snap_seq);
+        return;
+    }
+
+    DataFileIdSet data_file_ids;
+    Stopwatch watch;
+    double read_seconds = 0;
+    double apply_seconds = 0;
     while (reader->remained())
     {
+        watch.restart();
         auto [from_checkpoint, record] = reader->next();
         if (!record)
         {
@@ -405,18 +446,109 @@ void PageDirectoryFactory<Trait>::loadFromDisk(const PageDirectoryPtr & dir, WAL
         if constexpr (std::is_same_v<Trait, u128::FactoryTrait>)
         {
             auto edit = Trait::Serializer::deserializeFrom(record.value(), nullptr);
+            read_seconds += watch.elapsedSecondsFromLastTime();
             loadEdit(dir, edit, from_checkpoint, checkpoint_snap_seq);
         }
         else if constexpr (std::is_same_v<Trait, universal::FactoryTrait>)
         {
             auto edit = Trait::Serializer::deserializeFrom(record.value(), &data_file_ids);
+            read_seconds += watch.elapsedSecondsFromLastTime();
             loadEdit(dir, edit, from_checkpoint, checkpoint_snap_seq);
         }
         else
         {
             RUNTIME_CHECK(false);
         }
+        apply_seconds += watch.elapsedSecondsFromLastTime();
+    }
+    GET_METRIC(tiflash_storage_page_restore_duration_seconds, type_wal_read).Observe(read_seconds);
+    GET_METRIC(tiflash_storage_page_restore_duration_seconds, type_apply).Observe(apply_seconds);
+}
+
+template <typename Trait>
+void PageDirectoryFactory<Trait>::loadFromDiskParallel(
+    const PageDirectoryPtr & dir,
+    const WALStoreReaderPtr & reader,
+    UInt64 checkpoint_snap_seq)
+{
+    using EditQueue = MPMCQueue<PageEntriesEdit>;
+    // The max number of decoded edits buffered for each log file
+    static constexpr Int64 max_buffered_edits = 64;
+
+    // Every log file is read and decoded by a task, and the decoded edits are pushed into the queue of the file.
+    // The current thread pops and applies the edits file by file, so the edits are applied in the same order as
+    // reading sequentially. At most `restore_threads` files are read ahead to bound the memory usage.
+    const auto files = reader->listFilesToRead();
+    std::vector<std::unique_ptr<EditQueue>> queues(files.size());
+    std::vector<std::future<void>> read_results(files.size());
+    // Must be destroyed before the queues, so that all the tasks are finished.
+    ThreadPool pool(restore_threads, restore_threads, 0);
+
+    size_t next_file_to_read = 0;
+    auto schedule_next_file = [&] {
+        const size_t index = next_file_to_read++;
+        queues[index] = std::make_unique<EditQueue>(CapacityLimits(max_buffered_edits));
+        auto task = std::make_shared<std::packaged_task<void()>>(
+            [&reader, &filename = files[index].second, &queue = *queues[index]] {
+                SCOPE_EXIT({ queue.finish(); });
+                DataFileIdSet data_file_ids;
+                reader->readRecordsInFile(filename, [&](String && record) {
+                    DataFileIdSet * data_file_ids_ptr = nullptr;
+                    if constexpr (std::is_same_v<Trait, universal::FactoryTrait>)
+                        data_file_ids_ptr = &data_file_ids;
+                    auto edit = Trait::Serializer::deserializeFrom(record, data_file_ids_ptr);
+                    // The queue is cancelled if the current thread fails to apply edits
+                    return queue.push(std::move(edit)) == MPMCQueueResult::OK;
+                });
+            });
+        read_results[index] = task->get_future();
+        pool.scheduleOrThrowOnError([task] { (*task)(); });
+    };
+
+    DataFileIdSet data_file_ids;
+    Stopwatch watch;
+    double wait_seconds = 0;
+    double apply_seconds = 0;
+    try
+    {
+        for (size_t index = 0; index < files.size(); ++index)
+        {
+            while (next_file_to_read < files.size() && next_file_to_read < index + restore_threads)
+                schedule_next_file();
+
+            const bool from_checkpoint = files[index].first;
+            PageEntriesEdit edit;
+            while (true)
+            {
+                watch.restart();
+                auto res = queues[index]->pop(edit);
+                wait_seconds += watch.elapsedSecondsFromLastTime();
+                if (res != MPMCQueueResult::OK)
+                    break;
+
+                if constexpr (std::is_same_v<Trait, universal::FactoryTrait>)
+                    shareDataFileIds(edit, data_file_ids);
+                loadEdit(dir, edit, from_checkpoint, checkpoint_snap_seq);
+                apply_seconds += watch.elapsedSecondsFromLastTime();
+            }
+            // Rethrow the exception while reading this file
+            read_results[index].get();
+            queues[index].reset();
+        }
+    }
+    catch (...)
+    {
+        // Wake up the tasks blocked on pushing and wait for them to exit
+        for (auto & queue : queues)
+        {
+            if (queue)
+                queue->cancel();
+        }
+        pool.wait();
+        throw;
     }
+    GET_METRIC(tiflash_storage_page_restore_duration_seconds, type_wal_read).Observe(wait_seconds);
+    GET_METRIC(tiflash_storage_page_restore_duration_seconds, type_apply).Observe(apply_seconds);
 }
 
 template class PageDirectoryFactory<u128::FactoryTrait>;
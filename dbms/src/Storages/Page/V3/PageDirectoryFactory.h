@@ -79,6 +79,11 @@ public:
 
 private:
     void loadFromDisk(const PageDirectoryPtr & dir, WALStoreReaderPtr && reader);
+    // Read and decode the log files by `restore_threads` threads, the edits are still applied in order.
+    void loadFromDiskParallel(
+        const PageDirectoryPtr & dir,
+        const WALStoreReaderPtr & reader,
+        UInt64 checkpoint_snap_seq);
     void loadEdit(const PageDirectoryPtr & dir, const PageEntriesEdit & edit, bool force_apply, UInt64 filter_seq = 0);
     static void applyRecord(
         const PageDirectoryPtr & dir,
@@ -90,6 +95,8 @@ private:
 
     BlobStats * blob_stats = nullptr;
 
+    size_t restore_threads = 1;
+
     // For debug tool
     template <typename T>
     friend class PageStorageControlV3;
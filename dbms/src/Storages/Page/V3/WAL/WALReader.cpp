@@ -269,6 +269,41 @@ std::pair<bool, std::optional<String>> WALStoreReader::next()
     } while (true);
 }
 
+std::vector<std::pair<bool, LogFilename>> WALStoreReader::listFilesToRead() const
+{
+    std::vector<std::pair<bool, LogFilename>> files;
+    files.reserve(files_to_read.size() + 1);
+    if (checkpoint_file)
+        files.emplace_back(true, *checkpoint_file);
+    for (const auto & file : files_to_read)
+        files.emplace_back(false, file);
+    return files;
+}
+
+void WALStoreReader::readRecordsInFile(
+    const LogFilename & filename,
+    const std::function<bool(String &&)> & consumer) const
+{
+    ReportCollector file_reporter;
+    auto file_provider = provider;
+    auto log_reader = createLogReader(filename, file_provider, &file_reporter, recovery_mode, read_limiter, logger);
+    while (true)
+    {
+        auto [ok, record] = log_reader->readRecord();
+        if (!ok)
+            break;
+        if (!consumer(std::move(record)))
+            return;
+    }
+    if (file_reporter.hasError())
+    {
+        throw Exception(
+            ErrorCodes::CORRUPTED_DATA,
+            "Something wrong while reading log file, file={}",
+            filename.fullname(filename.stage));
+    }
+}
+
 bool WALStoreReader::openNextFile()
 {
     if (checkpoint_reader_created && next_reading_file == files_to_read.end())
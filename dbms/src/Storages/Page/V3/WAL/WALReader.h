@@ -20,6 +20,9 @@
 #include <Storages/Page/V3/LogFile/LogReader.h>
 #include <Storages/Page/V3/WALStore.h>
 
+#include <functional>
+#include <vector>
+
 namespace DB
 {
 namespace ErrorCodes
@@ -89,6 +92,15 @@ public:
     // std::pair<from_checkpoint, record>
     std::pair<bool, std::optional<String>> next();
 
+    // All the log files to be read in order, the checkpoint file comes first if exists.
+    // std::pair<from_checkpoint, filename>
+    std::vector<std::pair<bool, LogFilename>> listFilesToRead() const;
+
+    // Read the records in `filename` one by one and pass them to `consumer` until the end of file
+    // or `consumer` returns false. Different files can be read concurrently by different threads.
+    // Throw exception if the file is corrupted.
+    void readRecordsInFile(const LogFilename & filename, const std::function<bool(String &&)> & consumer) const;
+
     void throwIfError() const
     {
         if (reporter.hasError())
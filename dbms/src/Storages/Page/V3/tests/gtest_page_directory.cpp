@@ -1401,6 +1401,59 @@ try
 }
 CATCH
 
+TEST_F(PageDirectoryTest, RestoreInParallel)
+try
+{
+    auto restore = [](size_t restore_threads) {
+        auto path = getTemporaryPath();
+        auto provider = DB::tests::TiFlashTestEnv::getDefaultFileProvider();
+        PSDiskDelegatorPtr delegator = std::make_shared<DB::tests::MockDiskDelegatorSingle>(path);
+        WALConfig config;
+        // roll the log file frequently so that there are many log files to restore
+        config.roll_size = 4 * 1024;
+        config.restore_threads = restore_threads;
+        PageDirectoryFactory<u128::FactoryTrait> factory;
+        return factory.create("PageDirectoryTest", provider, delegator, config);
+    };
+    dir = restore(1);
+
+    constexpr size_t num_pages = 1000;
+    for (size_t i = 0; i < num_pages; ++i)
+    {
+        PageEntriesEdit edit;
+        edit.put(
+            buildV3Id(TEST_NAMESPACE_ID, i),
+            PageEntryV3{.file_id = 1, .size = 1, .padded_size = 0, .tag = 0, .offset = i, .checksum = 0x4567});
+        if (i % 3 == 1)
+            edit.ref(buildV3Id(TEST_NAMESPACE_ID, num_pages + i), buildV3Id(TEST_NAMESPACE_ID, i - 1));
+        if (i % 5 == 4)
+            edit.del(buildV3Id(TEST_NAMESPACE_ID, i - 2));
+        dir->apply(std::move(edit));
+        // The edits are restored from both the checkpoint file and the later log files
+        if (i == num_pages / 2)
+            ASSERT_TRUE(dir->tryDumpSnapshot(nullptr, true));
+    }
+    dir.reset();
+
+    std::map<PageIdU64, PageEntryV3> expected_entries;
+    {
+        auto serial_dir = restore(1);
+        auto snap = serial_dir->createSnapshot();
+        for (const auto & page_id : serial_dir->getAllPageIds())
+            expected_entries.emplace(page_id.low, getEntry(serial_dir, page_id.low, snap));
+    }
+    ASSERT_FALSE(expected_entries.empty());
+
+    auto parallel_dir = restore(4);
+    auto snap = parallel_dir->createSnapshot();
+    ASSERT_EQ(parallel_dir->getAllPageIds().size(), expected_entries.size());
+    for (const auto & [page_id, entry] : expected_entries)
+    {
+        ASSERT_SAME_ENTRY(getEntry(parallel_dir, page_id, snap), entry);
+    }
+}
+CATCH
+
 class PageDirectoryGCTest : public PageDirectoryTest
 {
 };
@@ -342,6 +342,30 @@ try
 }
 CATCH
 
+TEST_F(VersionedEntriesTest, SingleVersionStoredInline)
+try
+{
+    const auto bytes_before = PageStorageMemorySummary::versioned_page_entries_bytes.load();
+
+    // The single version is stored inline, no extra memory is allocated
+    INSERT_ENTRY(2);
+    ASSERT_EQ(PageStorageMemorySummary::versioned_page_entries_bytes.load(), bytes_before);
+
+    // Memory is allocated for multiple versions
+    INSERT_ENTRY(5);
+    INSERT_ENTRY(10);
+    ASSERT_GT(PageStorageMemorySummary::versioned_page_entries_bytes.load(), bytes_before);
+    ASSERT_SAME_ENTRY(*entries.getEntry(6), entry_v5);
+
+    // <2,0>, <5,0> get removed, the only left version is moved back to the inline storage
+    auto [all_removed, removed_entries, deref_counter] = runClean(10);
+    ASSERT_FALSE(all_removed);
+    ASSERT_EQ(removed_entries.size(), 2);
+    ASSERT_EQ(PageStorageMemorySummary::versioned_page_entries_bytes.load(), bytes_before);
+    ASSERT_SAME_ENTRY(*entries.getEntry(10), entry_v10);
+}
+CATCH
+
 TEST_F(VersionedEntriesTest, DeleteMultiTime)
 try
 {
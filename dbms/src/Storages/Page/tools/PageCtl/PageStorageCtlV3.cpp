@@ -416,7 +416,7 @@ private:
         {
             PageStorageImpl ps(String(NAME), delegator, config, provider);
             ps.restore();
-            auto & mvcc_table_directory = ps.page_directory->mvcc_table_directory;
+            auto mvcc_table_directory = ps.page_directory->mvcc_table_directory.copyAll();
             auto & blobstore = ps.blob_store;
             display(ps, mvcc_table_directory, blobstore, options);
         }
@@ -424,7 +424,7 @@ private:
         {
             auto ps = UniversalPageStorage::create(String(NAME), delegator, config, provider);
             ps->restore();
-            auto & mvcc_table_directory = ps->page_directory->mvcc_table_directory;
+            auto mvcc_table_directory = ps->page_directory->mvcc_table_directory.copyAll();
             auto & blobstore = ps->blob_store;
             display(ps, mvcc_table_directory, *blobstore, options);
         }
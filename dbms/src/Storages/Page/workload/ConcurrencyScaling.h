@@ -0,0 +1,169 @@
+// Copyright 2024 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Storages/Page/workload/PSRunnable.h>
+#include <Storages/Page/workload/PSWorkload.h>
+
+#include <atomic>
+#include <thread>
+
+namespace DB::PS::tests
+{
+// Wrap a runnable so that it can be stopped at the end of a round
+// without stopping the whole workload.
+template <typename Base>
+class PSRoundRunnable : public Base
+{
+public:
+    using Base::Base;
+
+    void setStopFlag(const std::atomic<bool> * stopped_) { stopped = stopped_; }
+
+    bool runImpl() override { return !stopped->load(std::memory_order_relaxed) && Base::runImpl(); }
+
+private:
+    const std::atomic<bool> * stopped = nullptr;
+};
+
+// Run small reads and writes with increasing number of threads, and report the
+// throughput of every round. It is used to check whether the page directory scales
+// with the number of threads.
+class ConcurrencyScaling
+    : public StressWorkload
+    , public StressWorkloadFunc<ConcurrencyScaling>
+{
+public:
+    explicit ConcurrencyScaling(const StressEnv & options_)
+        : StressWorkload(options_)
+    {}
+
+    static String name() { return "ConcurrencyScaling"; }
+
+    static UInt64 mask() { return 1 << 8; }
+
+private:
+    struct RoundResult
+    {
+        size_t num_threads;
+        double write_pages_per_second;
+        double read_pages_per_second;
+    };
+
+    static constexpr size_t round_seconds = 10;
+
+    String desc() override
+    {
+        return fmt::format(
+            "Some of options will be ignored"
+            "`paths` will only used first one. which is {}. Data will store in {}"
+            "Please cleanup folder after this test."
+            "The current workload runs {}s for each of thread count 1, 2, 4, ... up to {}",
+            options.paths[0],
+            options.paths[0] + "/" + name(),
+            round_seconds,
+            std::max(options.num_writers, options.num_readers));
+    }
+
+    void run() override
+    {
+        const size_t max_threads = std::max(options.num_writers, options.num_readers);
+        pool.addCapacity(2 * max_threads);
+        DB::PageStorageConfig config;
+        initPageStorage(config, name());
+        initPages(MAX_PAGE_ID_DEFAULT);
+
+        startBackgroundTimer();
+        stop_watch.start();
+        for (size_t num_threads = 1; StressEnvStatus::getInstance().isRunning(); num_threads *= 2)
+        {
+            num_threads = std::min(num_threads, max_threads);
+            runRound(num_threads);
+            if (num_threads == max_threads)
+                break;
+        }
+        stop_watch.stop();
+    }
+
+    void runRound(size_t num_threads)
+    {
+        std::atomic<bool> stopped = false;
+        startWriter<PSRoundRunnable<PSCommonWriter>>(
+            num_threads,
+            [&](std::shared_ptr<PSRoundRunnable<PSCommonWriter>> writer) {
+                writer->setStopFlag(&stopped);
+                writer->setBatchBufferNums(1);
+                writer->setBufferSizeRange(1, 4096);
+                writer->setBatchBufferPageRange(MAX_PAGE_ID_DEFAULT);
+            });
+        startReader<PSRoundRunnable<PSReader>>(num_threads, [&](std::shared_ptr<PSRoundRunnable<PSReader>> reader) {
+            reader->setStopFlag(&stopped);
+            reader->setReadDelay(0);
+            reader->setReadPageRange(MAX_PAGE_ID_DEFAULT);
+            reader->setReadPageNums(1);
+        });
+
+        Stopwatch round_watch;
+        std::this_thread::sleep_for(std::chrono::seconds(round_seconds));
+        stopped = true;
+        pool.joinAll();
+        const double seconds = round_watch.elapsedSeconds();
+
+        size_t pages_written = 0;
+        for (const auto & writer : writers)
+            pages_written += writer->pages_used;
+        size_t pages_read = 0;
+        for (const auto & reader : readers)
+            pages_read += reader->pages_used;
+
+        const auto & result = results.emplace_back(RoundResult{
+            .num_threads = num_threads,
+            .write_pages_per_second = pages_written / seconds,
+            .read_pages_per_second = pages_read / seconds,
+        });
+        LOG_INFO(
+            options.logger,
+            "Round done, num_threads={} write_pages_per_second={:.1f} read_pages_per_second={:.1f}",
+            result.num_threads,
+            result.write_pages_per_second,
+            result.read_pages_per_second);
+    }
+
+    void onDumpResult() override
+    {
+        StressWorkload::onDumpResult();
+        if (results.empty())
+            return;
+
+        // Output to stdout for performance test summary, the speedup is relative to the single thread round
+        const auto & base = results.front();
+        for (const auto & result : results)
+        {
+            fmt::print(
+                stdout,
+                "Scaling summary: num_threads={} write_ops={:.1f} read_ops={:.1f} "
+                "write_speedup={:.2f} read_speedup={:.2f}\n",
+                result.num_threads,
+                result.write_pages_per_second,
+                result.read_pages_per_second,
+                result.write_pages_per_second / std::max(base.write_pages_per_second, 1.0),
+                result.read_pages_per_second / std::max(base.read_pages_per_second, 1.0));
+        }
+    }
+
+    bool verify() override { return true; }
+
+private:
+    std::vector<RoundResult> results;
+};
+} // namespace DB::PS::tests
@@ -11,6 +11,7 @@
 // WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 // See the License for the specific language governing permissions and
 // limitations under the License.
+#include <Storages/Page/workload/ConcurrencyScaling.h>
 #include <Storages/Page/workload/HeavyMemoryCostInGC.h>
 #include <Storages/Page/workload/HeavyRead.h>
 #include <Storages/Page/workload/HeavySkewWriteRead.h>
@@ -28,6 +29,7 @@ using namespace DB::PS::tests;
 int StressWorkload::mainEntry(int argc, char ** argv)
 {
     {
+        work_load_register<ConcurrencyScaling>();
         work_load_register<HeavyMemoryCostInGC>();
         work_load_register<HeavyRead>();
         work_load_register<HeavySkewWriteRead>();
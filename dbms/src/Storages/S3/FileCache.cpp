@@ -42,6 +42,7 @@
 #include <fmt/chrono.h>
 
 #include <atomic>
+#include <charconv>
 #include <chrono>
 #include <cmath>
 #include <filesystem>
@@ -482,6 +483,28 @@ RandomAccessFilePtr FileCache::getRandomAccessFile(
     {
         return nullptr;
     }
+    return openLocalFile(s3_fname, file_seg);
+}
+
+RandomAccessFilePtr FileCache::getCachedRandomAccessFile(const S3::S3FilenameView & s3_fname)
+{
+    auto s3_key = s3_fname.toFullKey();
+    auto & shard = getShard(s3_key);
+    auto & table = shard.tables[static_cast<UInt64>(getFileType(s3_key))];
+    FileSegmentPtr file_seg;
+    {
+        std::lock_guard lock(shard.mtx);
+        file_seg = table.get(s3_key);
+        if (file_seg == nullptr || !file_seg->isReadyToRead())
+            return nullptr;
+        file_seg->setLastAccessTime(std::chrono::system_clock::now());
+    }
+    GET_METRIC(tiflash_storage_remote_cache, type_dtfile_hit).Increment();
+    return openLocalFile(s3_fname, file_seg);
+}
+
+RandomAccessFilePtr FileCache::openLocalFile(const S3::S3FilenameView & s3_fname, const FileSegmentPtr & file_seg)
+{
     try
     {
         // PosixRandomAccessFile should hold the `file_seg` shared_ptr to prevent cached file from evicted.
@@ -563,16 +586,67 @@ std::tuple<FileSegmentPtr, bool> FileCache::downloadFileForLocalReadWithRetry(
         retry_count);
 }
 
+UInt64 FileCache::getRangeBlockSize(const S3::S3FilenameView & s3_fname) const
+{
+    auto block_size = range_block_size.load(std::memory_order_relaxed);
+    if (block_size == 0)
+        return 0;
+    auto file_type = getFileType(s3_fname.toFullKey());
+    if (!isRangeCacheable(file_type) || canCache(file_type) == ShouldCacheRes::RejectTypeNotMatch)
+        return 0;
+    return block_size;
+}
+
+RandomAccessFilePtr FileCache::getRangeRandomAccessFile(
+    const S3::S3FilenameView & s3_fname,
+    const FileSegment::Range & range)
+{
+    auto file_seg = getOrWaitRange(s3_fname, range);
+    if (file_seg == nullptr)
+    {
+        return nullptr;
+    }
+    try
+    {
+        // PosixRandomAccessFile should hold the `file_seg` shared_ptr to prevent cached file from evicted.
+        return std::make_shared<PosixRandomAccessFile>(
+            file_seg->getLocalFileName(),
+            /*flags*/ -1,
+            /*read_limiter*/ nullptr,
+            file_seg);
+    }
+    catch (const DB::Exception & e)
+    {
+        LOG_WARNING(
+            log,
+            "s3_fname={} range=[{}, {}) local_fname={} errcode={} errmsg={}",
+            s3_fname.toFullKey(),
+            range.begin,
+            range.end,
+            file_seg->getLocalFileName(),
+            e.code(),
+            e.message());
+        if (e.code() == ErrorCodes::FILE_DOESNT_EXIST)
+        {
+            // Someone removes cache files manually, remove it from FileCache and let the caller read from S3.
+            remove(toRangeKey(s3_fname.toFullKey(), range), /*force*/ true);
+            return nullptr;
+        }
+        throw;
+    }
+}
+
 FileSegmentPtr FileCache::get(const S3::S3FilenameView & s3_fname, const std::optional<UInt64> & filesize)
 {
     auto s3_key = s3_fname.toFullKey();
     auto file_type = getFileType(s3_key);
-    auto & table = tables[static_cast<UInt64>(file_type)];
+    auto & shard = getShard(s3_key);
+    auto & table = shard.tables[static_cast<UInt64>(file_type)];
 
     FileSegmentPtr file_seg;
     UInt64 wait_ms = 0;
     {
-        std::unique_lock lock(mtx);
+        std::unique_lock lock(shard.mtx);
         if (auto f = table.get(s3_key); f != nullptr)
         {
             f->setLastAccessTime(std::chrono::system_clock::now());
@@ -611,34 +685,8 @@ FileSegmentPtr FileCache::get(const S3::S3FilenameView & s3_fname, const std::op
             case ShouldCacheRes::Cache:
                 break;
             }
-
-            // File not exists, try to download and cache it in background.
-
-            // We don't know the exact size of a object/file, but we need reserve space to save the object/file.
-            // A certain amount of space is reserved for each file type.
-            auto estimated_size = filesize ? *filesize : getEstimatedSizeOfFileType(file_type);
-            if (!reserveSpaceImpl(file_type, estimated_size, EvictMode::TryEvict, lock))
-            {
-                // Space still not enough after eviction.
-                GET_METRIC(tiflash_storage_remote_cache, type_dtfile_full).Increment();
-                LOG_DEBUG(
-                    log,
-                    "s3_key={} space not enough(capacity={} used={} estimated_size={}), skip cache",
-                    s3_key,
-                    cache_capacity,
-                    cache_used,
-                    estimated_size);
-                return nullptr;
-            }
-
-            file_seg = std::make_shared<FileSegment>(
-                toLocalFilename(s3_key),
-                FileSegment::Status::Empty,
-                estimated_size,
-                file_type);
-            table.set(s3_key, file_seg);
         }
-    } // Release the lock before submitting bg download task. Because bgDownload may be blocked when the queue is full.
+    }
 
     if (wait_ms != 0)
     {
@@ -666,6 +714,43 @@ FileSegmentPtr FileCache::get(const S3::S3FilenameView & s3_fname, const std::op
         return nullptr;
     }
 
+    // File not exists, try to download and cache it in background.
+
+    // We don't know the exact size of a object/file, but we need reserve space to save the object/file.
+    // A certain amount of space is reserved for each file type.
+    // Reserve without holding the shard lock, because the eviction may lock other shards.
+    auto estimated_size = getReserveSize(file_type, filesize);
+    if (!reserveSpace(file_type, estimated_size, EvictMode::TryEvict))
+    {
+        // Space still not enough after eviction.
+        GET_METRIC(tiflash_storage_remote_cache, type_dtfile_full).Increment();
+        LOG_DEBUG(
+            log,
+            "s3_key={} space not enough(capacity={} used={} estimated_size={}), skip cache",
+            s3_key,
+            cache_capacity,
+            cache_used.load(std::memory_order_relaxed),
+            estimated_size);
+        return nullptr;
+    }
+
+    {
+        std::unique_lock lock(shard.mtx);
+        if (auto f = table.get(s3_key); f != nullptr)
+        {
+            // Another thread has inserted the same key during the reservation, reuse it.
+            lock.unlock();
+            releaseSpace(estimated_size);
+            return f->isReadyToRead() ? f : nullptr;
+        }
+        file_seg = std::make_shared<FileSegment>(
+            toLocalFilename(s3_key),
+            FileSegment::Status::Empty,
+            estimated_size,
+            file_type);
+        table.set(s3_key, file_seg);
+    } // Release the lock before submitting bg download task. Because bgDownload may be blocked when the queue is full.
+
     bgDownload(s3_key, file_seg);
 
     return nullptr;
@@ -675,55 +760,145 @@ FileSegmentPtr FileCache::getOrWait(const S3::S3FilenameView & s3_fname, const s
 {
     auto s3_key = s3_fname.toFullKey();
     auto file_type = getFileType(s3_key);
-    auto & table = tables[static_cast<UInt64>(file_type)];
+    auto & shard = getShard(s3_key);
+    auto & table = shard.tables[static_cast<UInt64>(file_type)];
 
-    std::unique_lock lock(mtx);
+    std::unique_lock lock(shard.mtx);
 
     auto f = table.get(s3_key);
-    if (f != nullptr)
+    if (f == nullptr)
     {
         lock.unlock();
-        f->setLastAccessTime(std::chrono::system_clock::now());
-        auto status = f->waitForNotEmpty();
-        if (status == FileSegment::Status::Complete)
+        GET_METRIC(tiflash_storage_remote_cache, type_dtfile_miss).Increment();
+
+        // Reserve without holding the shard lock, because the eviction may lock other shards.
+        auto estimated_size = getReserveSize(file_type, filesize);
+        if (!reserveSpace(file_type, estimated_size, EvictMode::ForceEvict))
         {
-            GET_METRIC(tiflash_storage_remote_cache, type_dtfile_hit).Increment();
-            return f;
+            // Space still not enough after eviction.
+            GET_METRIC(tiflash_storage_remote_cache, type_dtfile_full).Increment();
+            LOG_INFO(
+                log,
+                "s3_key={} space not enough(capacity={} used={} estimated_size={}), skip cache",
+                s3_key,
+                cache_capacity,
+                cache_used.load(std::memory_order_relaxed),
+                estimated_size);
+
+            // Just throw, no need to let the caller retry.
+            throw Exception(ErrorCodes::S3_ERROR, "Cannot reserve {} space for object {}", estimated_size, s3_key);
         }
-        // On-going download failed, let the caller retry.
-        return nullptr;
-    }
 
-    GET_METRIC(tiflash_storage_remote_cache, type_dtfile_miss).Increment();
+        lock.lock();
+        f = table.get(s3_key);
+        if (f != nullptr)
+        {
+            // Another thread has inserted the same key during the reservation, wait for it instead.
+            releaseSpace(estimated_size);
+        }
+        else
+        {
+            auto file_seg = std::make_shared<FileSegment>(
+                toLocalFilename(s3_key),
+                FileSegment::Status::Empty,
+                estimated_size,
+                file_type);
+            table.set(s3_key, file_seg);
+            lock.unlock();
 
-    auto estimated_size = filesize ? *filesize : getEstimatedSizeOfFileType(file_type);
-    if (!reserveSpaceImpl(file_type, estimated_size, EvictMode::ForceEvict, lock))
-    {
-        // Space still not enough after eviction.
-        GET_METRIC(tiflash_storage_remote_cache, type_dtfile_full).Increment();
-        LOG_INFO(
-            log,
-            "s3_key={} space not enough(capacity={} used={} estimated_size={}), skip cache",
-            s3_key,
-            cache_capacity,
-            cache_used,
-            estimated_size);
+            ++PerfContext::file_cache.fg_download_from_s3;
+            fgDownload(s3_key, file_seg);
+            if (!file_seg || !file_seg->isReadyToRead())
+                throw Exception(ErrorCodes::S3_ERROR, "Download object {} failed", s3_key);
 
-        // Just throw, no need to let the caller retry.
-        throw Exception(ErrorCodes::S3_ERROR, "Cannot reserve {} space for object {}", estimated_size, s3_key);
+            return file_seg;
+        }
     }
 
-    auto file_seg
-        = std::make_shared<FileSegment>(toLocalFilename(s3_key), FileSegment::Status::Empty, estimated_size, file_type);
-    table.set(s3_key, file_seg);
     lock.unlock();
+    f->setLastAccessTime(std::chrono::system_clock::now());
+    auto status = f->waitForNotEmpty();
+    if (status == FileSegment::Status::Complete)
+    {
+        GET_METRIC(tiflash_storage_remote_cache, type_dtfile_hit).Increment();
+        return f;
+    }
+    // On-going download failed, let the caller retry.
+    return nullptr;
+}
+
+FileSegmentPtr FileCache::getOrWaitRange(const S3::S3FilenameView & s3_fname, const FileSegment::Range & range)
+{
+    auto s3_key = s3_fname.toFullKey();
+    auto file_type = getFileType(s3_key);
+    RUNTIME_CHECK(range.begin < range.end, s3_key, range.begin, range.end);
+    if (!isRangeCacheable(file_type) || canCache(file_type) == ShouldCacheRes::RejectTypeNotMatch)
+        return nullptr;
+
+    auto range_key = toRangeKey(s3_key, range);
+    auto & shard = getShard(range_key);
+    auto & table = shard.tables[static_cast<UInt64>(file_type)];
 
-    ++PerfContext::file_cache.fg_download_from_s3;
-    fgDownload(s3_key, file_seg);
-    if (!file_seg || !file_seg->isReadyToRead())
-        throw Exception(ErrorCodes::S3_ERROR, "Download object {} failed", s3_key);
+    std::unique_lock lock(shard.mtx);
 
-    return file_seg;
+    auto f = table.get(range_key);
+    if (f == nullptr)
+    {
+        lock.unlock();
+        GET_METRIC(tiflash_storage_remote_cache, type_dtfile_miss).Increment();
+
+        // The size of a range is exact, so unlike `getOrWait`, there is no need to finalize the reserved size later.
+        // Ranges are small, do not force evict other files for them.
+        if (!reserveSpace(file_type, range.size(), EvictMode::TryEvict))
+        {
+            GET_METRIC(tiflash_storage_remote_cache, type_dtfile_full).Increment();
+            LOG_DEBUG(
+                log,
+                "range_key={} space not enough(capacity={} used={} range_size={}), skip cache",
+                range_key,
+                cache_capacity,
+                cache_used.load(std::memory_order_relaxed),
+                range.size());
+            return nullptr;
+        }
+
+        lock.lock();
+        f = table.get(range_key);
+        if (f != nullptr)
+        {
+            // Another thread has inserted the same key during the reservation, wait for it instead.
+            releaseSpace(range.size());
+        }
+        else
+        {
+            auto file_seg = std::make_shared<FileSegment>(
+                toLocalFilename(range_key),
+                FileSegment::Status::Empty,
+                range.size(),
+                file_type,
+                range);
+            table.set(range_key, file_seg);
+            lock.unlock();
+
+            ++PerfContext::file_cache.fg_download_from_s3;
+            fgDownload(range_key, file_seg);
+            if (!file_seg || !file_seg->isReadyToRead())
+                return nullptr;
+
+            return file_seg;
+        }
+    }
+
+    lock.unlock();
+    f->setLastAccessTime(std::chrono::system_clock::now());
+    auto status = f->waitForNotEmpty();
+    if (status == FileSegment::Status::Complete)
+    {
+        GET_METRIC(tiflash_storage_remote_cache, type_dtfile_hit).Increment();
+        return f;
+    }
+    // On-going download failed, let the caller read from S3 directly.
+    return nullptr;
 }
 
 // Remove `local_fname` from disk and remove parent directory if parent directory is empty.
@@ -766,9 +941,10 @@ void FileCache::removeDiskFile(const String & local_fname, bool update_fsize_met
 void FileCache::remove(const String & s3_key, bool force)
 {
     auto file_type = getFileType(s3_key);
-    auto & table = tables[static_cast<UInt64>(file_type)];
+    auto & shard = getShard(s3_key);
+    auto & table = shard.tables[static_cast<UInt64>(file_type)];
 
-    std::unique_lock lock(mtx);
+    std::unique_lock lock(shard.mtx);
     auto f = table.get(s3_key, /*update_lru*/ false);
     if (f == nullptr)
         return;
@@ -800,70 +976,72 @@ std::pair<Int64, std::list<String>::iterator> FileCache::removeImpl(
         GET_METRIC(tiflash_storage_remote_cache, type_dtfile_evict).Increment();
         GET_METRIC(tiflash_storage_remote_cache_bytes, type_dtfile_evict_bytes).Increment(release_size);
     }
-    releaseSpaceImpl(release_size);
+    releaseSpace(release_size);
     return {release_size, table.remove(s3_key)};
 }
 
+bool FileCache::tryReserveSpace(UInt64 size)
+{
+    // reserve means that `cache_used` increase `size`.
+    auto used = cache_used.load(std::memory_order_relaxed);
+    do
+    {
+        if (used + size > cache_capacity)
+            return false;
+    } while (!cache_used.compare_exchange_weak(used, used + size, std::memory_order_relaxed));
+    CurrentMetrics::set(CurrentMetrics::DTFileCacheUsed, used + size);
+    return true;
+}
+
 // Try best to reserve space for new coming file.
 // return true if reservation success.
 // `size` is the amount of space to reserve (cache_used will increase by this amount on success).
-bool FileCache::reserveSpaceImpl(
-    FileType reserve_for,
-    UInt64 size,
-    EvictMode mode,
-    std::unique_lock<std::mutex> & guard)
-{
-    if (cache_used + size <= cache_capacity)
-    {
-        // If cache_capacity is enough, just reserve it.
-        // reserve means that `cache_used` increase `size`.
-        cache_used += size;
-        CurrentMetrics::set(CurrentMetrics::DTFileCacheUsed, cache_used);
+bool FileCache::reserveSpace(FileType reserve_for, UInt64 size, EvictMode mode)
+{
+    // If cache_capacity is enough, just reserve it without any lock.
+    if (tryReserveSpace(size))
         return true;
-    }
+    if (mode == EvictMode::NoEvict)
+        return false;
 
-    evictBySizeImpl(reserve_for, size, cache_min_age_seconds.load(std::memory_order_relaxed), mode, guard);
-    // try update `cache_used` after eviction
-    if (cache_used + size <= cache_capacity)
-    {
-        // cache_capacity is enough after eviction. Mark reservation success.
-        cache_used += size;
-        CurrentMetrics::set(CurrentMetrics::DTFileCacheUsed, cache_used);
+    std::lock_guard evict_lock(evict_mtx);
+    // Other threads may have released enough space while waiting for the lock.
+    if (tryReserveSpace(size))
         return true;
-    }
-    return false;
+    evictBySizeImpl(reserve_for, size, cache_min_age_seconds.load(std::memory_order_relaxed), mode);
+    // try update `cache_used` after eviction
+    return tryReserveSpace(size);
 }
 
 // Evict files to free space for new coming file.
 // `size_to_reserve` is the required space to reserve.
 // `min_age_seconds` is the minimum age of files to be evicted.
 // Return the total evicted size.
-// Caller should ensure that `size_to_reserve` is larger than available space.
-UInt64 FileCache::evictBySizeImpl(
-    FileType evict_for,
-    UInt64 size_to_reserve,
-    UInt64 min_age_seconds,
-    EvictMode mode,
-    std::unique_lock<std::mutex> & guard)
+// `cache_used` may be changed concurrently by other threads, so the evicted size is decided by a snapshot of it.
+UInt64 FileCache::evictBySizeImpl(FileType evict_for, UInt64 size_to_reserve, UInt64 min_age_seconds, EvictMode mode)
 {
+    const UInt64 used = cache_used.load(std::memory_order_relaxed);
     UInt64 min_evict_size = 0;
-    if (cache_capacity < cache_used)
+    if (cache_capacity < used)
     {
-        min_evict_size = cache_used - cache_capacity + size_to_reserve;
+        min_evict_size = used - cache_capacity + size_to_reserve;
         LOG_WARNING(
             log,
             "evictBySizeImpl cache overused, capacity={} used={} reserve_size={} min_evict_size={} evict_mode={}",
             cache_capacity,
-            cache_used,
+            used,
             size_to_reserve,
             min_evict_size,
             magic_enum::enum_name(mode));
     }
+    else if (size_to_reserve > cache_capacity - used)
+    {
+        min_evict_size = size_to_reserve - (cache_capacity - used);
+    }
     else
     {
-        assert(cache_capacity >= cache_used); // not underflow
-        assert(size_to_reserve > cache_capacity - cache_used); // not underflow, ensure by the caller
-        min_evict_size = size_to_reserve - (cache_capacity - cache_used);
+        // Other threads have released enough space.
+        return 0;
     }
 
     switch (mode)
@@ -880,7 +1058,7 @@ UInt64 FileCache::evictBySizeImpl(
             magic_enum::enum_name(evict_for),
             min_evict_size,
             magic_enum::enum_name(mode));
-        const UInt64 size_evicted_during_try = tryEvictFile(evict_for, min_evict_size, min_age_seconds, mode, guard);
+        const UInt64 size_evicted_during_try = tryEvictFile(evict_for, min_evict_size, min_age_seconds, mode);
         if (likely(min_evict_size <= size_evicted_during_try))
         {
             // has enough space after eviction, break
@@ -893,7 +1071,7 @@ UInt64 FileCache::evictBySizeImpl(
         {
             // After tryEvictFile, the space is still not sufficient,
             // so we do a force eviction.
-            auto size_force_evicted = forceEvict(min_evict_size_after_try, guard);
+            auto size_force_evicted = forceEvict(min_evict_size_after_try);
             LOG_INFO(
                 log,
                 "forceEvict min_evict_size={} min_evict_size_after_try={} force_evicted_size={}",
@@ -965,8 +1143,7 @@ UInt64 FileCache::tryEvictFile(
     FileType evict_for,
     const UInt64 min_evict_size,
     const UInt64 min_age_seconds,
-    EvictMode mode,
-    std::unique_lock<std::mutex> & guard)
+    EvictMode mode)
 {
     RUNTIME_CHECK(mode != EvictMode::NoEvict);
     // shortcut
@@ -977,26 +1154,39 @@ UInt64 FileCache::tryEvictFile(
     auto file_types = getEvictFileTypes(evict_for, /*evict_same_type_first*/ true);
     for (auto evict_from : file_types)
     {
-        // try to evict from `evict_from` file type.
-        auto evicted_size = tryEvictFileFrom(evict_for, min_evict_size, min_age_seconds, evict_from, guard);
-        total_size_evicted += evicted_size;
+        // try to evict from `evict_from` file type of all shards. Start from a different shard each time,
+        // so that the files of all shards are evicted evenly.
+        for (size_t i = 0; i < shard_count && total_size_evicted < min_evict_size; ++i)
+        {
+            auto & shard = shards[(evict_shard_cursor + i) % shard_count];
+            std::lock_guard lock(shard.mtx);
+            total_size_evicted += tryEvictFileFrom(
+                shard.tables[static_cast<UInt64>(evict_from)],
+                evict_for,
+                min_evict_size - total_size_evicted,
+                min_age_seconds,
+                evict_from);
+        }
         if (total_size_evicted >= min_evict_size)
         {
             // has enough space after eviction, break
             break;
         }
     }
+    evict_shard_cursor = (evict_shard_cursor + 1) % shard_count;
     return total_size_evicted;
 }
 
 UInt64 FileCache::tryEvictFileFrom(
+    LRUFileTable & table,
     FileType evict_for,
     UInt64 min_evict_size,
     UInt64 min_age_seconds,
-    FileType evict_from,
-    std::unique_lock<std::mutex> & /*guard*/)
+    FileType evict_from)
 {
-    auto & table = tables[static_cast<UInt64>(evict_from)];
+    if (table.size() == 0)
+        return 0;
+
     UInt64 total_released_size = 0;
     // max try evict times to prevent long time lock the FileCache
     constexpr UInt32 max_try_evict_count = 10;
@@ -1008,7 +1198,7 @@ UInt64 FileCache::tryEvictFileFrom(
     for (UInt32 try_evict_count = 0; try_evict_count < max_try_evict_count && itr != end; ++try_evict_count)
     {
         auto s3_key = *itr;
-        // protected under guard
+        // protected under the shard lock
         auto f = table.get(s3_key, /*update_lru*/ false);
         if (!check_last_access_time || !f->isRecentlyAccess(std::chrono::seconds(min_age_seconds)))
         {
@@ -1046,7 +1236,7 @@ UInt64 FileCache::tryEvictFileFrom(
 
 struct ForceEvictCandidate
 {
-    UInt64 file_type_slot;
+    UInt64 table_slot;
     String s3_key;
     FileSegmentPtr file_segment;
     std::chrono::time_point<std::chrono::system_clock> last_access_time; // Order by this field
@@ -1057,7 +1247,7 @@ struct ForceEvictCandidateComparer
     bool operator()(ForceEvictCandidate a, ForceEvictCandidate b) { return a.last_access_time > b.last_access_time; }
 };
 
-UInt64 FileCache::forceEvict(UInt64 size_to_reserve, std::unique_lock<std::mutex> & /*guard*/)
+UInt64 FileCache::forceEvict(UInt64 size_to_reserve)
 {
     if (unlikely(size_to_reserve == 0))
         return 0;
@@ -1065,33 +1255,43 @@ UInt64 FileCache::forceEvict(UInt64 size_to_reserve, std::unique_lock<std::mutex
     // For a force evict, we simply evict from the oldest to the newest, until
     // space is sufficient.
 
+    // The oldest file is picked from all shards, so lock all shards in order.
+    std::vector<std::unique_lock<std::mutex>> shard_locks;
+    shard_locks.reserve(shard_count);
+    std::vector<LRUFileTable *> tables;
+    tables.reserve(shard_count * magic_enum::enum_count<FileType>());
+    for (auto & shard : shards)
+    {
+        shard_locks.emplace_back(shard.mtx);
+        for (auto & table : shard.tables)
+            tables.push_back(&table);
+    }
+
     std::priority_queue<ForceEvictCandidate, std::vector<ForceEvictCandidate>, ForceEvictCandidateComparer>
         evict_candidates;
 
-    // First, pick an item from all levels.
-    // Note that access to `tables` is protected under `guard`
+    // First, pick an item from all tables.
+    // Note that access to `tables` is protected under `shard_locks`
     size_t total_released_size = 0;
 
-    constexpr auto all_file_types = magic_enum::enum_values<FileType>();
-    std::vector<std::list<String>::iterator> each_type_lru_iters; // Stores the iterator of next candidate to add
-    each_type_lru_iters.reserve(all_file_types.size());
-    for (const auto file_type : all_file_types)
+    std::vector<std::list<String>::iterator> each_table_lru_iters; // Stores the iterator of next candidate to add
+    each_table_lru_iters.reserve(tables.size());
+    for (UInt64 table_slot = 0; table_slot < tables.size(); ++table_slot)
     {
-        auto file_type_slot = static_cast<UInt64>(file_type);
-        auto iter = tables[file_type_slot].begin();
-        if (iter != tables[file_type_slot].end())
+        auto iter = tables[table_slot]->begin();
+        if (iter != tables[table_slot]->end())
         {
             const auto & s3_key = *iter;
-            const auto & f = tables[file_type_slot].get(s3_key, /*update_lru*/ false);
+            const auto & f = tables[table_slot]->get(s3_key, /*update_lru*/ false);
             evict_candidates.emplace(ForceEvictCandidate{
-                .file_type_slot = file_type_slot,
+                .table_slot = table_slot,
                 .s3_key = s3_key,
                 .file_segment = f,
                 .last_access_time = f->getLastAccessTime(),
             });
             iter++;
         }
-        each_type_lru_iters.emplace_back(iter);
+        each_table_lru_iters.emplace_back(iter);
     }
 
     // Then we iterate the heap to remove the file with oldest access time.
@@ -1101,21 +1301,21 @@ UInt64 FileCache::forceEvict(UInt64 size_to_reserve, std::unique_lock<std::mutex
         auto to_evict = evict_candidates.top(); // intentionally copy
         evict_candidates.pop();
 
-        const auto file_type_slot = to_evict.file_type_slot;
-        if (each_type_lru_iters[file_type_slot] != tables[file_type_slot].end())
+        const auto table_slot = to_evict.table_slot;
+        if (each_table_lru_iters[table_slot] != tables[table_slot]->end())
         {
-            const auto s3_key = *each_type_lru_iters[file_type_slot];
-            const auto & f = tables[file_type_slot].get(s3_key, /*update_lru*/ false);
+            const auto s3_key = *each_table_lru_iters[table_slot];
+            const auto & f = tables[table_slot]->get(s3_key, /*update_lru*/ false);
             evict_candidates.emplace(ForceEvictCandidate{
-                .file_type_slot = file_type_slot,
+                .table_slot = table_slot,
                 .s3_key = s3_key,
                 .file_segment = f,
                 .last_access_time = f->getLastAccessTime(),
             });
-            each_type_lru_iters[file_type_slot]++;
+            each_table_lru_iters[table_slot]++;
         }
 
-        auto [released_size, next_itr] = removeImpl(tables[file_type_slot], to_evict.s3_key, to_evict.file_segment);
+        auto [released_size, next_itr] = removeImpl(*tables[table_slot], to_evict.s3_key, to_evict.file_segment);
         LOG_INFO(
             log,
             "ForceEvict {} size={} size_to_reserve={} total_released={}",
@@ -1133,22 +1333,10 @@ UInt64 FileCache::forceEvict(UInt64 size_to_reserve, std::unique_lock<std::mutex
     return total_released_size;
 }
 
-bool FileCache::reserveSpace(FileType reserve_for, UInt64 size, EvictMode mode)
-{
-    std::unique_lock lock(mtx);
-    return reserveSpaceImpl(reserve_for, size, mode, lock);
-}
-
-void FileCache::releaseSpaceImpl(UInt64 size)
-{
-    cache_used -= size;
-    CurrentMetrics::set(CurrentMetrics::DTFileCacheUsed, cache_used);
-}
-
 void FileCache::releaseSpace(UInt64 size)
 {
-    std::lock_guard lock(mtx);
-    releaseSpaceImpl(size);
+    auto used = cache_used.fetch_sub(size, std::memory_order_relaxed) - size;
+    CurrentMetrics::set(CurrentMetrics::DTFileCacheUsed, used);
 }
 
 FileCache::ShouldCacheRes FileCache::canCache(FileType file_type) const
@@ -1192,6 +1380,17 @@ UInt64 FileCache::getEstimatedSizeOfFileType(FileSegment::FileType file_type)
     return estimated_size_of_file_type[static_cast<UInt64>(file_type)];
 }
 
+UInt64 FileCache::getReserveSize(FileSegment::FileType file_type, const std::optional<UInt64> & filesize)
+{
+    if (filesize)
+    {
+        GET_METRIC(tiflash_storage_remote_cache, type_dtfile_reserve_exact).Increment();
+        return *filesize;
+    }
+    GET_METRIC(tiflash_storage_remote_cache, type_dtfile_reserve_estimated).Increment();
+    return getEstimatedSizeOfFileType(file_type);
+}
+
 FileType FileCache::getFileType(const String & fname)
 {
     std::filesystem::path p(fname);
@@ -1234,6 +1433,11 @@ FileType FileCache::getFileType(const String & fname)
     {
         return FileType::Meta;
     }
+    else if (ext == ".part")
+    {
+        // A range of object, the file type is decided by the object. Example: 1.dat.0_1048576.part
+        return getFileType(p.replace_extension().replace_extension().string());
+    }
 
     return FileType::Unknown;
 }
@@ -1243,11 +1447,15 @@ bool FileCache::finalizeReservedSize(FileType reserve_for, UInt64 reserved_size,
     if (content_length > reserved_size)
     {
         // Need more space.
+        GET_METRIC(tiflash_storage_remote_cache_bytes, type_dtfile_reserve_under_bytes)
+            .Increment(content_length - reserved_size);
         return reserveSpace(reserve_for, content_length - reserved_size, EvictMode::TryEvict);
     }
     else if (content_length < reserved_size)
     {
         // Release extra space.
+        GET_METRIC(tiflash_storage_remote_cache_bytes, type_dtfile_reserve_over_bytes)
+            .Increment(reserved_size - content_length);
         releaseSpace(reserved_size - content_length);
     }
     return true;
@@ -1313,7 +1521,19 @@ void FileCache::downloadImpl(
     auto s3_read_limiter = client->getS3ReadLimiter();
     auto s3_read_metrics_recorder = client->getS3ReadMetricsRecorder();
     Aws::S3::Model::GetObjectRequest req;
-    client->setBucketAndKeyWithRoot(req, s3_key);
+    const auto & range = file_seg->getRange();
+    if (range)
+    {
+        // `s3_key` of a range segment is the range key, send the request with the key of object.
+        auto parsed = parseRangeKey(s3_key);
+        RUNTIME_CHECK(parsed.has_value(), s3_key);
+        client->setBucketAndKeyWithRoot(req, parsed->first);
+        req.SetRange(fmt::format("bytes={}-{}", range->begin, range->end - 1));
+    }
+    else
+    {
+        client->setBucketAndKeyWithRoot(req, s3_key);
+    }
     ProfileEvents::increment(ProfileEvents::S3GetObject);
     auto outcome = client->GetObject(req);
     if (!outcome.IsSuccess())
@@ -1470,8 +1690,9 @@ void FileCache::cleanupFailedDownload(const String & s3_key, FileSegmentPtr & fi
     // the failed placeholder does not stay published in the cache table and block later retries.
     // This is failed-download cleanup rather than cache eviction, so do not count eviction metrics.
     auto file_type = getFileType(s3_key);
-    auto & table = tables[static_cast<UInt64>(file_type)];
-    std::unique_lock lock(mtx);
+    auto & shard = getShard(s3_key);
+    auto & table = shard.tables[static_cast<UInt64>(file_type)];
+    std::unique_lock lock(shard.mtx);
     auto f = table.get(s3_key, /*update_lru*/ false);
     if (f != nullptr)
         std::ignore = removeImpl(table, s3_key, f, /*force*/ true, /*count_as_evict*/ false);
@@ -1499,8 +1720,9 @@ void FileCache::fgDownload(const String & s3_key, FileSegmentPtr & file_seg)
         GET_METRIC(tiflash_storage_remote_cache, type_dtfile_download_failed).Increment();
         file_seg.reset();
         auto file_type = getFileType(s3_key);
-        auto & table = tables[static_cast<UInt64>(file_type)];
-        std::unique_lock lock(mtx);
+        auto & shard = getShard(s3_key);
+        auto & table = shard.tables[static_cast<UInt64>(file_type)];
+        std::unique_lock lock(shard.mtx);
         auto f = table.get(s3_key, /*update_lru*/ false);
         if (f != nullptr)
             std::ignore = removeImpl(table, s3_key, f, /*force*/ true, /*count_as_evict*/ false);
@@ -1524,6 +1746,52 @@ String FileCache::toS3Key(const String & local_fname) const
     return local_fname.substr(cache_dir.size() + 1);
 }
 
+String FileCache::toRangeKey(const String & s3_key, const FileSegment::Range & range)
+{
+    return fmt::format("{}.{}_{}.part", s3_key, range.begin, range.end);
+}
+
+std::optional<std::pair<String, FileSegment::Range>> FileCache::parseRangeKey(const String & key)
+{
+    constexpr std::string_view suffix = ".part";
+    if (!key.ends_with(suffix))
+        return std::nullopt;
+    auto range_end_pos = key.size() - suffix.size();
+    auto dot_pos = key.rfind('.', range_end_pos - 1);
+    if (dot_pos == String::npos)
+        return std::nullopt;
+    auto sep_pos = key.find('_', dot_pos);
+    if (sep_pos == String::npos || sep_pos > range_end_pos)
+        return std::nullopt;
+
+    auto parse_number = [&key](size_t begin_pos, size_t end_pos, UInt64 & value) {
+        const auto * last = key.data() + end_pos;
+        auto [ptr, ec] = std::from_chars(key.data() + begin_pos, last, value);
+        return begin_pos < end_pos && ec == std::errc{} && ptr == last;
+    };
+    FileSegment::Range range;
+    if (!parse_number(dot_pos + 1, sep_pos, range.begin) || !parse_number(sep_pos + 1, range_end_pos, range.end)
+        || range.begin >= range.end)
+        return std::nullopt;
+    return std::make_pair(key.substr(0, dot_pos), range);
+}
+
+bool FileCache::isRangeCacheable(FileType file_type)
+{
+    switch (file_type)
+    {
+    case FileType::Merged:
+    case FileType::NullMap:
+    case FileType::DeleteMarkColData:
+    case FileType::VersionColData:
+    case FileType::HandleColData:
+    case FileType::ColData:
+        return true;
+    default:
+        return false;
+    }
+}
+
 String FileCache::toTemporaryFilename(const String & fname)
 {
     std::filesystem::path p(fname);
@@ -1573,15 +1841,16 @@ void FileCache::restore()
     }
 
     size_t total_count = 0;
-    for (const auto & t : tables)
+    for (const auto & shard : shards)
     {
-        total_count += t.size();
+        for (const auto & t : shard.tables)
+            total_count += t.size();
     }
     LOG_INFO(
         log,
         "restore: cost={:.3f}s used={} capacity={} total_count={}",
         sw.elapsedSeconds(),
-        cache_used,
+        cache_used.load(std::memory_order_relaxed),
         cache_capacity,
         total_count);
 }
@@ -1622,16 +1891,22 @@ void FileCache::restoreDMFile(const std::filesystem::directory_entry & dmfile_en
         else
         {
             auto file_type = getFileType(fname);
-            auto & table = tables[static_cast<UInt64>(file_type)];
             auto size = file_entry.file_size();
-            if (canCache(file_type) == FileCache::ShouldCacheRes::Cache && cache_capacity - cache_used >= size)
+            // restore is done before the cache serving any request, no need to acquire the shard lock
+            if (canCache(file_type) == FileCache::ShouldCacheRes::Cache
+                && cache_capacity - cache_used.load(std::memory_order_relaxed) >= size)
             {
+                auto s3_key = toS3Key(fname);
+                auto & table = getShard(s3_key).tables[static_cast<UInt64>(file_type)];
+                std::optional<FileSegment::Range> range;
+                if (auto parsed = parseRangeKey(s3_key); parsed)
+                    range = parsed->second;
                 table.set(
-                    toS3Key(fname),
-                    std::make_shared<FileSegment>(fname, FileSegment::Status::Complete, size, file_type));
+                    s3_key,
+                    std::make_shared<FileSegment>(fname, FileSegment::Status::Complete, size, file_type, range));
                 capacity_metrics->addUsedSize(fname, size);
-                cache_used += size;
-                CurrentMetrics::set(CurrentMetrics::DTFileCacheUsed, cache_used);
+                auto used = cache_used.fetch_add(size, std::memory_order_relaxed) + size;
+                CurrentMetrics::set(CurrentMetrics::DTFileCacheUsed, used);
             }
             else
             {
@@ -1644,12 +1919,15 @@ void FileCache::restoreDMFile(const std::filesystem::directory_entry & dmfile_en
 
 std::vector<FileSegmentPtr> FileCache::getAll()
 {
-    std::lock_guard lock(mtx);
     std::vector<FileSegmentPtr> file_segs;
-    for (const auto & table : tables)
+    for (const auto & shard : shards)
     {
-        auto values = table.getAllFiles();
-        file_segs.insert(file_segs.end(), values.begin(), values.end());
+        std::lock_guard lock(shard.mtx);
+        for (const auto & table : shard.tables)
+        {
+            auto values = table.getAllFiles();
+            file_segs.insert(file_segs.end(), values.begin(), values.end());
+        }
     }
     return file_segs;
 }
@@ -1749,6 +2027,17 @@ void FileCache::updateConfig(const Settings & settings)
             new_wait_ms);
         wait_on_downloading_ms.store(new_wait_ms, std::memory_order_relaxed);
     }
+
+    UInt64 new_range_block_size = settings.dt_filecache_range_block_size;
+    if (new_range_block_size != range_block_size.load(std::memory_order_relaxed))
+    {
+        LOG_INFO(
+            log,
+            "Update S3FileCache range cache config: range_block_size {} => {}",
+            range_block_size.load(std::memory_order_relaxed),
+            new_range_block_size);
+        range_block_size.store(new_range_block_size, std::memory_order_relaxed);
+    }
 }
 
 // Evict the cached files until no file of >= `file_type` is in cache.
@@ -1757,25 +2046,28 @@ UInt64 FileCache::evictByFileType(FileSegment::FileType file_type)
     // getEvictFileTypes is a static method that is not related to the current object state,
     // so it is safe to call it before acquiring the lock.
     auto file_types = getEvictFileTypes(file_type, /*evict_same_type_first*/ false);
-    std::lock_guard lock(mtx);
     UInt64 total_released_size = 0;
     for (auto evict_from : file_types)
     {
         UInt64 curr_released_size = 0;
-        auto & table = tables[static_cast<UInt64>(evict_from)];
-        for (auto itr = table.begin(); itr != table.end();)
+        for (auto & shard : shards)
         {
-            auto s3_key = *itr;
-            auto f = table.get(s3_key, /*update_lru*/ false);
-            auto [released_size, next_itr] = removeImpl(table, s3_key, f, /*force*/ true);
-            if (released_size < 0) // not remove
+            std::lock_guard lock(shard.mtx);
+            auto & table = shard.tables[static_cast<UInt64>(evict_from)];
+            for (auto itr = table.begin(); itr != table.end();)
             {
-                ++itr;
-            }
-            else // removed
-            {
-                itr = next_itr;
-                curr_released_size += released_size;
+                auto s3_key = *itr;
+                auto f = table.get(s3_key, /*update_lru*/ false);
+                auto [released_size, next_itr] = removeImpl(table, s3_key, f, /*force*/ true);
+                if (released_size < 0) // not remove
+                {
+                    ++itr;
+                }
+                else // removed
+                {
+                    itr = next_itr;
+                    curr_released_size += released_size;
+                }
             }
         }
         total_released_size += curr_released_size;
@@ -1801,8 +2093,8 @@ UInt64 FileCache::evictByFileType(FileSegment::FileType file_type)
 // If `force_evict` is true, it will evict files even if they are being used recently.
 UInt64 FileCache::evictBySize(UInt64 size_to_reserve, UInt64 min_age_seconds, bool force_evict)
 {
-    std::unique_lock lock(mtx);
-    if (size_to_reserve + cache_used <= cache_capacity)
+    std::lock_guard lock(evict_mtx);
+    if (size_to_reserve + cache_used.load(std::memory_order_relaxed) <= cache_capacity)
     {
         // shortcut for no need evict
         LOG_INFO(
@@ -1811,7 +2103,7 @@ UInt64 FileCache::evictBySize(UInt64 size_to_reserve, UInt64 min_age_seconds, bo
             size_to_reserve,
             force_evict,
             cache_capacity,
-            cache_used);
+            cache_used.load(std::memory_order_relaxed));
         return 0;
     }
 
@@ -1821,7 +2113,7 @@ UInt64 FileCache::evictBySize(UInt64 size_to_reserve, UInt64 min_age_seconds, bo
     // in order to respect the priority of file types and avoid evicting high priority files
     // by last_access_time in non-force evict.
     constexpr FileType max_file_type = magic_enum::enum_values<FileType>()[magic_enum::enum_count<FileType>() - 1];
-    auto total_released_size = evictBySizeImpl(max_file_type, size_to_reserve, min_age, mode, lock);
+    auto total_released_size = evictBySizeImpl(max_file_type, size_to_reserve, min_age, mode);
     LOG_INFO(
         log,
         "evictBySize finish, size_to_reserve={} min_age={} force_evict={} total_released_size={} cache_capacity={} "
@@ -1831,20 +2123,26 @@ UInt64 FileCache::evictBySize(UInt64 size_to_reserve, UInt64 min_age_seconds, bo
         force_evict,
         total_released_size,
         cache_capacity,
-        cache_used);
+        cache_used.load(std::memory_order_relaxed));
     return total_released_size;
 }
 
 std::vector<std::tuple<FileSegment::FileType, CacheSizeHistogram>> FileCache::getCacheSizeHistogram() const
 {
-    std::lock_guard lock(mtx);
     std::vector<std::tuple<FileSegment::FileType, CacheSizeHistogram>> result;
     for (const auto & file_type : magic_enum::enum_values<FileSegment::FileType>())
     {
-        const auto & table = tables[static_cast<UInt64>(file_type)];
-        if (table.size() == 0)
+        size_t count = 0;
+        CacheSizeHistogram histogram;
+        for (const auto & shard : shards)
+        {
+            std::lock_guard lock(shard.mtx);
+            const auto & table = shard.tables[static_cast<UInt64>(file_type)];
+            count += table.size();
+            table.addToCacheSizeHistogram(histogram);
+        }
+        if (count == 0)
             continue;
-        CacheSizeHistogram histogram = table.getCacheSizeHistogram();
         result.emplace_back(file_type, histogram);
     }
     return result;
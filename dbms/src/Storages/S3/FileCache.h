@@ -30,6 +30,7 @@
 #include <Poco/JSON/Object.h>
 #pragma GCC diagnostic pop
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
@@ -74,11 +75,26 @@ public:
         ColData,
     };
 
-    FileSegment(const String & local_fname_, Status status_, UInt64 size_, FileType file_type_)
+    // A byte range [begin, end) of the S3 object.
+    struct Range
+    {
+        UInt64 begin = 0;
+        UInt64 end = 0;
+
+        UInt64 size() const { return end - begin; }
+    };
+
+    FileSegment(
+        const String & local_fname_,
+        Status status_,
+        UInt64 size_,
+        FileType file_type_,
+        std::optional<Range> range_ = std::nullopt)
         : local_fname(local_fname_)
         , status(status_)
         , size(size_)
         , file_type(file_type_)
+        , range(range_)
         , last_access_time(std::chrono::system_clock::now())
     {}
 
@@ -139,6 +155,13 @@ public:
         return file_type;
     }
 
+    /// Returns the range of the S3 object cached by this segment, or std::nullopt if the whole object is cached.
+    const std::optional<Range> & getRange() const
+    {
+        // `range` is read-only, no need for a lock.
+        return range;
+    }
+
     void setLastAccessTime(std::chrono::time_point<std::chrono::system_clock> t)
     {
         std::lock_guard lock(mtx);
@@ -168,6 +191,7 @@ private:
     Status status;
     UInt64 size;
     const FileType file_type;
+    const std::optional<Range> range;
     std::chrono::time_point<std::chrono::system_clock> last_access_time;
     std::condition_variable cv_ready;
 };
@@ -268,14 +292,12 @@ public:
         return files;
     }
 
-    CacheSizeHistogram getCacheSizeHistogram() const
+    void addToCacheSizeHistogram(CacheSizeHistogram & histogram) const
     {
-        CacheSizeHistogram histogram;
         for (const auto & pa : table)
         {
             histogram.addFileSegment(pa.second.first);
         }
-        return histogram;
     }
 
     size_t size() const { return table.size(); }
@@ -322,6 +344,10 @@ public:
         const S3::S3FilenameView & s3_fname,
         const std::optional<UInt64> & filesize);
 
+    /// Returns the random access file of the whole object if it is already downloaded to the local cache,
+    /// otherwise returns nullptr. Unlike `getRandomAccessFile`, a miss does not trigger downloading.
+    RandomAccessFilePtr getCachedRandomAccessFile(const S3::S3FilenameView & s3_fname);
+
     /// Download the file if it is not in the local cache and returns the
     /// file guard of the local cache file. When file guard is alive,
     /// local file will not be evicted.
@@ -337,6 +363,15 @@ public:
         const std::optional<UInt64> & filesize,
         Int32 retry_count);
 
+    /// Returns the block size if `s3_fname` should be cached by ranges instead of the whole object,
+    /// otherwise returns 0. See `dt_filecache_range_block_size`.
+    UInt64 getRangeBlockSize(const S3::S3FilenameView & s3_fname) const;
+
+    /// Download `range` of the object if it is not in the local cache and returns the random access file
+    /// of the local cache file. The offset of the returned file is relative to `range.begin`.
+    /// Returns nullptr if the range can not be cached, the caller should read it from S3 directly.
+    RandomAccessFilePtr getRangeRandomAccessFile(const S3::S3FilenameView & s3_fname, const FileSegment::Range & range);
+
     void updateConfig(const Settings & settings);
 
 
@@ -358,11 +393,15 @@ public:
     DISALLOW_COPY_AND_MOVE(FileCache);
 
     FileSegmentPtr get(const S3::S3FilenameView & s3_fname, const std::optional<UInt64> & filesize = std::nullopt);
+    RandomAccessFilePtr openLocalFile(const S3::S3FilenameView & s3_fname, const FileSegmentPtr & file_seg);
     /// Try best to wait until the file is available in cache. If the file is not in cache, it will download the file in foreground.
     /// It may return nullptr after wait. In this case the caller could retry.
     FileSegmentPtr getOrWait(
         const S3::S3FilenameView & s3_fname,
         const std::optional<UInt64> & filesize = std::nullopt);
+    /// The same as `getOrWait`, but only `range` of the object is downloaded and cached.
+    /// Returns nullptr if the space is not enough or the download fails.
+    FileSegmentPtr getOrWaitRange(const S3::S3FilenameView & s3_fname, const FileSegment::Range & range);
 
     void bgDownload(const String & s3_key, FileSegmentPtr & file_seg);
     void fgDownload(const String & s3_key, FileSegmentPtr & file_seg);
@@ -394,6 +433,11 @@ public:
     static bool isS3Filename(const String & fname);
     String toLocalFilename(const String & s3_key);
     String toS3Key(const String & local_fname) const;
+    // The key of a range segment is "{s3_key}.{begin}_{end}.part".
+    static String toRangeKey(const String & s3_key, const FileSegment::Range & range);
+    static std::optional<std::pair<String, FileSegment::Range>> parseRangeKey(const String & key);
+    // Only data files are read by offset. Other files are small or must be read as a whole.
+    static bool isRangeCacheable(FileSegment::FileType file_type);
 
     void restore();
     void restoreWriteNode(const std::filesystem::directory_entry & write_node_entry);
@@ -401,6 +445,7 @@ public:
     void restoreDMFile(const std::filesystem::directory_entry & dmfile_entry);
 
     void remove(const String & s3_key, bool force = false);
+    // The caller should hold the lock of the shard that `table` belongs to.
     std::pair<Int64, std::list<String>::iterator> removeImpl(
         LRUFileTable & table,
         const String & s3_key,
@@ -410,11 +455,11 @@ public:
     void removeDiskFile(const String & local_fname, bool update_fsize_metrics) const;
 
     // Estimated size is an empirical value.
-    // We don't know object size before get object from S3.
-    // But we need reserve space for a object before download it
+    // We need reserve space for a object before download it
     // to avoid wasting request to S3 if cache capacity is exhausted.
-    // TODO: The size of most objects, such as size and data type, can be parsed from the metadata file of DMFile.
-    // We can try to pass this information, although it may be troublesome.
+    // The sizes of most files of DMFile are recorded in its metadata and are passed by the caller
+    // through `S3RandomAccessFile::setReadFileInfo` or the `filesize` argument, then the exact size is reserved.
+    // The estimated size is only used when the caller does not know the size, such as the metadata file itself.
     static constexpr UInt64 estimated_size_of_file_type[] = {
         0, // Unknow type, currently never cache it.
         8 * 1024, // Estimated size of meta.
@@ -434,6 +479,8 @@ public:
         sizeof(estimated_size_of_file_type) / sizeof(estimated_size_of_file_type[0])
         == magic_enum::enum_count<FileSegment::FileType>());
     static UInt64 getEstimatedSizeOfFileType(FileSegment::FileType file_type);
+    // Return the size to reserve for a file: `filesize` if it is known, otherwise the estimated size of `file_type`.
+    static UInt64 getReserveSize(FileSegment::FileType file_type, const std::optional<UInt64> & filesize);
     static FileSegment::FileType getFileType(const String & fname);
     static FileSegment::FileType getFileTypeOfColData(const std::filesystem::path & p);
 
@@ -452,14 +499,12 @@ public:
         ForceEvict,
     };
 
-    bool reserveSpaceImpl(
-        FileSegment::FileType reserve_for,
-        UInt64 size,
-        EvictMode mode,
-        std::unique_lock<std::mutex> & guard);
-    void releaseSpaceImpl(UInt64 size);
-    void releaseSpace(UInt64 size);
+    // Reserve space without any lock. Return false if the space is not enough.
+    bool tryReserveSpace(UInt64 size);
+    // Try best to reserve space, evict files according to `mode` if the space is not enough.
+    // Must not be called with any shard lock held, because eviction locks the shards.
     bool reserveSpace(FileSegment::FileType reserve_for, UInt64 size, EvictMode mode);
+    void releaseSpace(UInt64 size);
     bool finalizeReservedSize(FileSegment::FileType reserve_for, UInt64 reserved_size, UInt64 content_length);
 
     // == evict cached files ==
@@ -467,44 +512,61 @@ public:
     static std::vector<FileSegment::FileType> getEvictFileTypes(
         FileSegment::FileType evict_for,
         bool evict_same_type_first);
+    // The caller should hold `evict_mtx` and no shard lock.
     UInt64 evictBySizeImpl(
         FileSegment::FileType evict_for,
         UInt64 size_to_reserve,
         UInt64 min_age_seconds,
-        EvictMode mode,
-        std::unique_lock<std::mutex> & guard);
+        EvictMode mode);
     UInt64 tryEvictFile(
         FileSegment::FileType evict_for,
         UInt64 min_evict_size,
         UInt64 min_age_seconds,
-        EvictMode mode,
-        std::unique_lock<std::mutex> & guard);
+        EvictMode mode);
+    // The caller should hold the lock of the shard that `table` belongs to.
     UInt64 tryEvictFileFrom(
+        LRUFileTable & table,
         FileSegment::FileType evict_for,
         UInt64 min_evict_size,
         UInt64 min_age_seconds,
-        FileSegment::FileType evict_from,
-        std::unique_lock<std::mutex> & guard);
-    UInt64 forceEvict(UInt64 size, std::unique_lock<std::mutex> & guard);
+        FileSegment::FileType evict_from);
+    UInt64 forceEvict(UInt64 size);
 
     // This function is used for test.
     std::vector<FileSegmentPtr> getAll();
 
-    mutable std::mutex mtx;
+    // The cached files are distributed to shards by the hash of key. Each shard has its own lock and LRU tables,
+    // so that looking up different files does not contend on a single lock. The space accounting is shared by
+    // all shards and updated atomically.
+    // Lock order: `evict_mtx` -> shard locks in ascending index order. Never acquire `evict_mtx` or another
+    // shard lock while holding a shard lock, except `forceEvict` that locks all shards in order.
+    struct Shard
+    {
+        mutable std::mutex mtx;
+        std::array<LRUFileTable, magic_enum::enum_count<FileSegment::FileType>()> tables;
+    };
+    static constexpr size_t shard_count = 16;
+    Shard & getShard(const String & s3_key) { return shards[std::hash<String>{}(s3_key) % shard_count]; }
+
+    std::array<Shard, shard_count> shards;
+    // Serialize the evictions, so that concurrent reservations do not evict more files than necessary.
+    std::mutex evict_mtx;
+    // The shard to start the next `tryEvictFile` from, protected by `evict_mtx`.
+    size_t evict_shard_cursor = 0;
     PathCapacityMetricsPtr capacity_metrics;
     String cache_dir;
     UInt64 cache_capacity;
     UInt64 cache_level;
-    UInt64 cache_used;
+    std::atomic<UInt64> cache_used;
     const UInt16 logical_cores;
     IORateLimiter & rate_limiter;
     std::atomic<UInt64> cache_min_age_seconds = 1800;
     std::atomic<UInt64> wait_on_downloading_ms = 0;
+    std::atomic<UInt64> range_block_size = 0;
     std::atomic<double> download_count_scale = 2.0;
     std::atomic<double> max_downloading_count_scale = 10.0;
     // the on-going background download count
     std::atomic<UInt64> bg_downloading_count = 0;
-    std::array<LRUFileTable, magic_enum::enum_count<FileSegment::FileType>()> tables;
 
     // Currently, these variables are just use for testing.
     std::atomic<UInt64> bg_download_succ_count = 0;
@@ -21,6 +21,7 @@
 #include <IO/BaseFile/MemoryRandomAccessFile.h>
 #include <Storages/DeltaMerge/ScanContext.h>
 #include <Storages/S3/FileCache.h>
+#include <Storages/S3/FileCachePerf.h>
 #include <Storages/S3/S3Common.h>
 #include <Storages/S3/S3Filename.h>
 #include <Storages/S3/S3RandomAccessFile.h>
@@ -31,6 +32,8 @@
 #include <common/logger_useful.h>
 #include <fiu.h>
 
+#include <algorithm>
+#include <numeric>
 #include <optional>
 #include <random>
 #include <string_view>
@@ -91,6 +94,32 @@ S3RandomAccessFile::S3RandomAccessFile(
     CurrentMetrics::add(CurrentMetrics::S3RandomAccessFile);
 }
 
+S3RandomAccessFile::S3RandomAccessFile(
+    std::shared_ptr<TiFlashS3Client> client_ptr_,
+    const String & remote_fname_,
+    const DM::ScanContextPtr & scan_context_,
+    FileCache * file_cache_,
+    UInt64 range_block_size_,
+    UInt64 filesize_)
+    : client_ptr(std::move(client_ptr_))
+    , remote_fname(remote_fname_)
+    , cur_offset(0)
+    , content_length(filesize_)
+    , read_limiter(nullptr)
+    , read_metrics_recorder(nullptr)
+    , log(Logger::get(remote_fname))
+    , scan_context(scan_context_)
+    , file_cache(file_cache_)
+    , range_block_size(range_block_size_)
+{
+    RUNTIME_CHECK(client_ptr != nullptr);
+    RUNTIME_CHECK(file_cache != nullptr && range_block_size > 0, remote_fname, range_block_size);
+    read_limiter = client_ptr->getS3ReadLimiter();
+    read_metrics_recorder = client_ptr->getS3ReadMetricsRecorder();
+    // The body stream is opened lazily, only when some block can not be read from FileCache.
+    CurrentMetrics::add(CurrentMetrics::S3RandomAccessFile);
+}
+
 S3RandomAccessFile::~S3RandomAccessFile()
 {
     CurrentMetrics::sub(CurrentMetrics::S3RandomAccessFile);
@@ -163,6 +192,96 @@ ssize_t S3RandomAccessFile::read(char * buf, size_t size)
 }
 
 ssize_t S3RandomAccessFile::readImpl(char * buf, size_t size)
+{
+    if (file_cache != nullptr)
+        return readFromRangeCache(buf, size);
+    return readFromStream(buf, size);
+}
+
+ssize_t S3RandomAccessFile::readFromRangeCache(char * buf, size_t size)
+{
+    size_t total_read = 0;
+    while (total_read < size && cur_offset < content_length)
+    {
+        const auto block_begin = static_cast<UInt64>(cur_offset) / range_block_size * range_block_size;
+        const auto block_end = std::min(block_begin + range_block_size, static_cast<UInt64>(content_length));
+        const auto to_read = std::min(size - total_read, static_cast<size_t>(block_end - cur_offset));
+        if (range_file_begin != block_begin)
+            openRangeFile(block_begin, block_end);
+
+        if (range_file != nullptr)
+        {
+            auto n = range_file->pread(buf + total_read, to_read, cur_offset - block_begin);
+            if (likely(n == static_cast<ssize_t>(to_read)))
+            {
+                cur_offset += n;
+                total_read += n;
+                continue;
+            }
+            LOG_WARNING(
+                log,
+                "Read local cache file failed, fallback to read from S3, local_fname={} offset={} size={} ret={} "
+                "errno={}",
+                range_file->getFileName(),
+                cur_offset - block_begin,
+                to_read,
+                n,
+                errno);
+            range_file = nullptr;
+        }
+
+        // The block is not cached, read it from S3 directly.
+        if (stream_offset != cur_offset)
+            reopenAt(cur_offset, "read uncached range");
+        auto n = readFromStream(buf + total_read, to_read);
+        if (n <= 0)
+        {
+            // Return the bytes have been read, the caller will read again from the new `cur_offset`.
+            return total_read > 0 ? static_cast<ssize_t>(total_read) : n;
+        }
+        stream_offset = cur_offset;
+        total_read += n;
+    }
+    return total_read;
+}
+
+void S3RandomAccessFile::openRangeFile(UInt64 block_begin, UInt64 block_end)
+{
+    range_file = nullptr;
+    range_file_begin = block_begin;
+    const auto perf_begin = PerfContext::file_cache;
+    try
+    {
+        range_file = file_cache->getRangeRandomAccessFile(
+            S3FilenameView::fromKey(remote_fname),
+            FileSegment::Range{.begin = block_begin, .end = block_end});
+    }
+    catch (...)
+    {
+        tryLogCurrentWarningException(
+            log,
+            fmt::format("Open range [{}, {}) from FileCache failed", block_begin, block_end));
+    }
+
+    if (scan_context)
+    {
+        const bool is_hit = range_file != nullptr
+            && PerfContext::file_cache.fg_download_from_s3 == perf_begin.fg_download_from_s3
+            && PerfContext::file_cache.fg_wait_download_from_s3 == perf_begin.fg_wait_download_from_s3;
+        if (is_hit)
+        {
+            scan_context->disagg_read_cache_hit_size += block_end - block_begin;
+            scan_context->disagg_s3file_hit_count++;
+        }
+        else
+        {
+            scan_context->disagg_read_cache_miss_size += block_end - block_begin;
+            scan_context->disagg_s3file_miss_count++;
+        }
+    }
+}
+
+ssize_t S3RandomAccessFile::readFromStream(char * buf, size_t size)
 {
     if (read_limiter != nullptr && read_limiter->maxReadBytesPerSec() > 0)
         // Charge the shared node-level budget in small chunks instead of allowing a single large `read()` to burst.
@@ -266,6 +385,38 @@ ssize_t S3RandomAccessFile::finalizeRead(
     return actual_size;
 }
 
+AsyncReadHandlePtr S3RandomAccessFile::submitReads(ReadRequests & requests)
+{
+    std::vector<size_t> order(requests.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+        return requests[lhs].offset < requests[rhs].offset;
+    });
+    for (auto i : order)
+    {
+        auto & req = requests[i];
+        if (auto off = seek(req.offset, SEEK_SET); off != req.offset)
+        {
+            req.result = off < 0 ? -errno : -EIO;
+            continue;
+        }
+        req.result = 0;
+        while (static_cast<size_t>(req.result) < req.size)
+        {
+            auto n = read(req.buf + req.result, req.size - req.result);
+            if (n < 0)
+            {
+                req.result = -errno;
+                break;
+            }
+            if (n == 0)
+                break;
+            req.result += n;
+        }
+    }
+    return std::make_unique<CompletedReadHandle>();
+}
+
 off_t S3RandomAccessFile::seek(off_t offset_, int whence)
 {
     for (Int32 stream_retry_times = 0;; ++stream_retry_times)
@@ -317,6 +468,13 @@ off_t S3RandomAccessFile::seekImpl(off_t offset_, int whence)
         cur_offset,
         content_length);
 
+    if (file_cache != nullptr)
+    {
+        // The stream is positioned lazily by the next read that can not be served by FileCache.
+        cur_offset = offset_;
+        return cur_offset;
+    }
+
     if (offset_ == cur_offset)
     {
         return cur_offset;
@@ -558,6 +716,7 @@ void S3RandomAccessFile::initialize(std::string_view action)
         }
         read_result = outcome.GetResultWithOwnership();
         RUNTIME_CHECK(read_result.GetBody(), remote_fname, strerror(errno));
+        stream_offset = cur_offset;
         return; // init successfully
     }
     // exceed max retry times
@@ -584,11 +743,51 @@ inline static RandomAccessFilePtr tryOpenCachedFile(const String & remote_fname,
     }
 }
 
+inline static RandomAccessFilePtr tryOpenWholeCachedFile(FileCache * file_cache, const String & remote_fname)
+{
+    try
+    {
+        return file_cache->getCachedRandomAccessFile(S3::S3FilenameView::fromKey(remote_fname));
+    }
+    catch (...)
+    {
+        tryLogCurrentException("tryOpenWholeCachedFile", remote_fname);
+        return nullptr;
+    }
+}
+
 inline static RandomAccessFilePtr createFromNormalFile(
     const String & remote_fname,
     std::optional<UInt64> filesize,
     std::optional<DM::ScanContextPtr> scan_context)
 {
+    auto * file_cache = FileCache::instance();
+    if (file_cache != nullptr && filesize.value_or(0) > 0)
+    {
+        // Cache the object by ranges, so reading a small part of a large object does not download the whole object.
+        if (auto block_size = file_cache->getRangeBlockSize(S3::S3FilenameView::fromKey(remote_fname)); block_size > 0)
+        {
+            // The object may be cached as a whole before the range mode is enabled, read it locally.
+            if (auto file = tryOpenWholeCachedFile(file_cache, remote_fname); file != nullptr)
+            {
+                if (scan_context.has_value())
+                {
+                    scan_context.value()->disagg_read_cache_hit_size += filesize.value();
+                    scan_context.value()->disagg_s3file_hit_count++;
+                }
+                return file;
+            }
+            auto & ins = S3::ClientFactory::instance();
+            return std::make_shared<S3RandomAccessFile>(
+                ins.sharedTiFlashClient(),
+                remote_fname,
+                scan_context ? *scan_context : nullptr,
+                file_cache,
+                block_size,
+                *filesize);
+        }
+    }
+
     auto file = tryOpenCachedFile(remote_fname, filesize);
     if (file != nullptr)
     {
@@ -31,6 +31,11 @@
 #undef thread_local
 #endif
 
+namespace DB
+{
+class FileCache;
+} // namespace DB
+
 namespace DB::S3
 {
 class TiFlashS3Client;
@@ -55,6 +60,17 @@ public:
         const String & remote_fname_,
         const DM::ScanContextPtr & scan_context_);
 
+    /// Create a reader that reads the object through the range cache of `file_cache_`. The object is split
+    /// into blocks of `range_block_size_` bytes, only the blocks being read are downloaded and cached, and
+    /// the blocks that can not be cached are read from S3 directly.
+    S3RandomAccessFile(
+        std::shared_ptr<TiFlashS3Client> client_ptr_,
+        const String & remote_fname_,
+        const DM::ScanContextPtr & scan_context_,
+        FileCache * file_cache_,
+        UInt64 range_block_size_,
+        UInt64 filesize_);
+
     ~S3RandomAccessFile() override;
 
     /// Seek to `offset` with `SEEK_SET`.
@@ -77,6 +93,10 @@ public:
         throw Exception("S3RandomAccessFile not support pread", ErrorCodes::NOT_IMPLEMENTED);
     }
 
+    /// Read the ranges one by one in the order of offset by `seek` and `read`, so the stream is
+    /// reused as much as possible. The current offset is moved like `read`.
+    [[nodiscard]] AsyncReadHandlePtr submitReads(ReadRequests & requests) override;
+
     int getFd() const override { return -1; }
 
     bool isClosed() const override { return is_close; }
@@ -107,6 +127,10 @@ private:
     [[noreturn]] void throwRetryExhaustedError(std::string_view action, int ret, int err) const;
     off_t seekImpl(off_t offset, int whence);
     ssize_t readImpl(char * buf, size_t size);
+    ssize_t readFromStream(char * buf, size_t size);
+    ssize_t readFromRangeCache(char * buf, size_t size);
+    /// Open the local cache file of the block [block_begin, block_end), download it if not cached.
+    void openRangeFile(UInt64 block_begin, UInt64 block_end);
     String readRangeOfObject();
     ssize_t readChunked(char * buf, size_t size);
     ssize_t finalizeRead(size_t requested_size, size_t actual_size, const Stopwatch & sw, std::istream & istr);
@@ -144,6 +168,17 @@ private:
     Int32 cur_retry = 0;
     static constexpr Int32 max_retry = 3;
     DM::ScanContextPtr scan_context;
+
+    /// Not null when the object is read through the range cache of FileCache.
+    FileCache * file_cache = nullptr;
+    UInt64 range_block_size = 0;
+    /// The local cache file of the block starting at `range_file_begin`.
+    /// It is nullptr if that block can not be cached and should be read from S3 directly.
+    RandomAccessFilePtr range_file;
+    std::optional<UInt64> range_file_begin;
+    /// The offset of the body stream in `read_result`. In the range cache mode, `cur_offset` may move
+    /// without reading the stream, so the stream is reopened when they are different.
+    off_t stream_offset = -1;
 };
 
 using S3RandomAccessFilePtr = std::shared_ptr<S3RandomAccessFile>;
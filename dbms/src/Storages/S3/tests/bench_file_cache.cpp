@@ -0,0 +1,97 @@
+// Copyright 2024 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <IO/BaseFile/RateLimiter.h>
+#include <Interpreters/Context.h>
+#include <Server/StorageConfigParser.h>
+#include <Storages/S3/FileCache.h>
+#include <Storages/S3/S3Filename.h>
+#include <TestUtils/TiFlashTestBasic.h>
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace DB::bench
+{
+namespace
+{
+constexpr size_t CACHED_FILE_COUNT = 10000;
+
+struct FileCacheBenchEnv
+{
+    FileCacheBenchEnv()
+    {
+        auto cache_dir = tests::TiFlashTestEnv::getTemporaryPath("FileCacheBench");
+        StorageRemoteCacheConfig cache_config{
+            .dir = cache_dir,
+            .capacity = 100UL * 1024 * 1024 * 1024,
+            .dtfile_level = 100,
+        };
+        file_cache = std::make_unique<FileCache>(
+            tests::TiFlashTestEnv::getContext()->getPathCapacity(),
+            cache_config,
+            /*logical_cores*/ 16,
+            rate_limiter);
+
+        // Insert the segments directly, so that every `get` is a hit and no download is involved.
+        keys.reserve(CACHED_FILE_COUNT);
+        for (size_t i = 0; i < CACHED_FILE_COUNT; ++i)
+        {
+            auto key = fmt::format("s{}/data/t_{}/dmf_{}/{}.dat", i % 7, i % 13, i, i % 5);
+            auto & shard = file_cache->getShard(key);
+            std::lock_guard lock(shard.mtx);
+            auto file_type = FileCache::getFileType(key);
+            shard.tables[static_cast<UInt64>(file_type)].set(
+                key,
+                std::make_shared<FileSegment>(
+                    file_cache->toLocalFilename(key),
+                    FileSegment::Status::Complete,
+                    4096,
+                    file_type));
+            keys.emplace_back(std::move(key));
+        }
+    }
+
+    IORateLimiter rate_limiter;
+    std::unique_ptr<FileCache> file_cache;
+    std::vector<String> keys;
+};
+
+FileCacheBenchEnv & getEnv()
+{
+    static FileCacheBenchEnv env;
+    return env;
+}
+} // namespace
+
+// Measure the throughput of `FileCache::get` on cached files by thread count.
+static void fileCacheGetHit(benchmark::State & state)
+{
+    auto & env = getEnv();
+    std::mt19937_64 gen(state.thread_index());
+    std::uniform_int_distribution<size_t> dist(0, env.keys.size() - 1);
+    for (auto _ : state)
+    {
+        auto s3_fname = S3::S3FilenameView::fromKey(env.keys[dist(gen)]);
+        auto file_seg = env.file_cache->get(s3_fname);
+        benchmark::DoNotOptimize(file_seg);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(fileCacheGetHit)->ThreadRange(1, 64)->UseRealTime();
+} // namespace DB::bench
@@ -16,6 +16,7 @@
 #include <Common/Logger.h>
 #include <Common/Stopwatch.h>
 #include <Common/SyncPoint/SyncPoint.h>
+#include <Common/TiFlashMetrics.h>
 #include <Debug/TiFlashTestEnv.h>
 #include <IO/BaseFile/RateLimiter.h>
 #include <IO/IOThreadPools.h>
@@ -25,8 +26,10 @@
 #include <Storages/KVStore/Types.h>
 #include <Storages/PathCapacityMetrics.h>
 #include <Storages/S3/FileCache.h>
+#include <Storages/S3/FileCachePerf.h>
 #include <Storages/S3/S3Common.h>
 #include <Storages/S3/S3Filename.h>
+#include <Storages/S3/S3RandomAccessFile.h>
 #include <Storages/S3/S3ReadLimiter.h>
 #include <Storages/S3/S3WritableFile.h>
 #include <TestUtils/TiFlashTestBasic.h>
@@ -240,8 +243,22 @@ protected:
 
     static UInt64 forceEvict(FileCache & file_cache, UInt64 size_to_evict)
     {
-        std::unique_lock lock(file_cache.mtx);
-        return file_cache.forceEvict(size_to_evict, lock);
+        std::lock_guard lock(file_cache.evict_mtx);
+        return file_cache.forceEvict(size_to_evict);
+    }
+
+    static void setFileSegment(FileCache & file_cache, const String & s3_key, const FileSegmentPtr & file_seg)
+    {
+        auto & shard = file_cache.getShard(s3_key);
+        std::lock_guard lock(shard.mtx);
+        shard.tables[static_cast<UInt64>(file_seg->getFileType())].set(s3_key, file_seg);
+    }
+
+    static FileSegmentPtr getFileSegment(FileCache & file_cache, const String & s3_key, FileType file_type)
+    {
+        auto & shard = file_cache.getShard(s3_key);
+        std::lock_guard lock(shard.mtx);
+        return shard.tables[static_cast<UInt64>(file_type)].get(s3_key, /*update_lru*/ false);
     }
 
     String tmp_dir;
@@ -281,7 +298,7 @@ try
         waitForBgDownload(file_cache);
         ASSERT_EQ(file_cache.bg_download_fail_count.load(std::memory_order_relaxed), 0);
         ASSERT_EQ(file_cache.bg_download_succ_count.load(std::memory_order_relaxed), objects.size());
-        ASSERT_EQ(file_cache.cache_used, file_cache.cache_capacity);
+        ASSERT_EQ(file_cache.cache_used.load(), file_cache.cache_capacity);
         for (const auto & obj : objects)
         {
             auto s3_fname = ::DB::S3::S3FilenameView::fromKey(obj.key);
@@ -297,7 +314,7 @@ try
         // restore cache from local filesystem after process restart
         LOG_INFO(log, "Cache restore");
         FileCache file_cache(capacity_metrics, cache_config, vcores, rate_limiter);
-        ASSERT_EQ(file_cache.cache_used, file_cache.cache_capacity);
+        ASSERT_EQ(file_cache.cache_used.load(), file_cache.cache_capacity);
         for (const auto & obj : objects)
         {
             auto s3_fname = ::DB::S3::S3FilenameView::fromKey(obj.key);
@@ -315,7 +332,7 @@ try
         ASSERT_EQ(meta_objects2.size(), 2 * 2 * 2);
 
         FileCache file_cache(capacity_metrics, cache_config, vcores, rate_limiter);
-        UInt64 free_size = file_cache.cache_capacity - file_cache.cache_used;
+        UInt64 free_size = file_cache.cache_capacity - file_cache.cache_used.load();
         LOG_INFO(log, "Running evict failed cases, free_size={}", free_size);
         // Keep the file_seg ptrs to mock reading in progress, it should prevent file_segment from being evicted.
         auto all_file_segs = file_cache.getAll();
@@ -342,8 +359,8 @@ try
         ASSERT_EQ(meta_objects.size(), 2 * 2 * 2);
 
         FileCache file_cache(capacity_metrics, cache_config, vcores, rate_limiter);
-        ASSERT_LE(file_cache.cache_used, file_cache.cache_capacity);
-        UInt64 free_size = file_cache.cache_capacity - file_cache.cache_used;
+        ASSERT_LE(file_cache.cache_used.load(), file_cache.cache_capacity);
+        UInt64 free_size = file_cache.cache_capacity - file_cache.cache_used.load();
         LOG_INFO(log, "Running evict success cases, free_size={}", free_size);
         for (const auto & obj : meta_objects)
         {
@@ -359,8 +376,8 @@ try
             ASSERT_TRUE(file_seg->isReadyToRead());
             ASSERT_EQ(file_seg->getSize(), obj.size);
         }
-        ASSERT_LE(file_cache.cache_used, file_cache.cache_capacity);
-        free_size = file_cache.cache_capacity - file_cache.cache_used;
+        ASSERT_LE(file_cache.cache_used.load(), file_cache.cache_capacity);
+        free_size = file_cache.cache_capacity - file_cache.cache_used.load();
         LOG_INFO(log, "After evict and cache new files, free_size={}", free_size);
 
         waitForBgDownload(file_cache);
@@ -541,6 +558,100 @@ TEST_F(FileCacheTest, Space)
     waitForBgDownload(file_cache);
 }
 
+TEST_F(FileCacheTest, ConcurrentReserveSpace)
+{
+    UInt16 vcores = 1;
+    IORateLimiter rate_limiter;
+    auto cache_dir = fmt::format("{}/concurrent_reserve_space", tmp_dir);
+    StorageRemoteCacheConfig cache_config{.dir = cache_dir, .capacity = cache_capacity, .dtfile_level = cache_level};
+    FileCache file_cache(capacity_metrics, cache_config, vcores, rate_limiter);
+    auto dt_cache_capacity = cache_config.getDTFileCapacity();
+
+    // Reserve concurrently without eviction, the reserved space must never exceed the capacity.
+    constexpr size_t thread_count = 8;
+    const UInt64 reserve_size = dt_cache_capacity / 100;
+    std::atomic<size_t> succ_count = 0;
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < thread_count; ++i)
+    {
+        threads.emplace_back([&]() {
+            for (size_t j = 0; j < 100; ++j)
+            {
+                if (file_cache.reserveSpace(FileType::Meta, reserve_size, FileCache::EvictMode::NoEvict))
+                    succ_count.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+    for (auto & t : threads)
+        t.join();
+    ASSERT_EQ(succ_count.load(), dt_cache_capacity / reserve_size);
+    ASSERT_EQ(file_cache.cache_used.load(), succ_count.load() * reserve_size);
+    ASSERT_LE(file_cache.cache_used.load(), dt_cache_capacity);
+
+    // Release concurrently
+    threads.clear();
+    for (size_t i = 0; i < thread_count; ++i)
+    {
+        threads.emplace_back([&, i]() {
+            for (size_t j = i; j < succ_count.load(); j += thread_count)
+                file_cache.releaseSpace(reserve_size);
+        });
+    }
+    for (auto & t : threads)
+        t.join();
+    ASSERT_EQ(file_cache.cache_used.load(), 0);
+}
+
+TEST_F(FileCacheTest, ReserveExactSize)
+try
+{
+    auto cache_dir = fmt::format("{}/reserve_exact_size", tmp_dir);
+    StorageRemoteCacheConfig cache_config{.dir = cache_dir, .capacity = cache_capacity, .dtfile_level = 100};
+    UInt16 vcores = 2;
+    IORateLimiter rate_limiter;
+    FileCache file_cache(capacity_metrics, cache_config, vcores, rate_limiter);
+
+    auto objects = genObjects(/*store_count*/ 1, /*table_count*/ 1, /*file_count*/ 1, {"1.dat", "2.dat"});
+    auto & reserve_exact = GET_METRIC(tiflash_storage_remote_cache, type_dtfile_reserve_exact);
+    auto & reserve_estimated = GET_METRIC(tiflash_storage_remote_cache, type_dtfile_reserve_estimated);
+    auto & over_bytes = GET_METRIC(tiflash_storage_remote_cache_bytes, type_dtfile_reserve_over_bytes);
+    auto & under_bytes = GET_METRIC(tiflash_storage_remote_cache_bytes, type_dtfile_reserve_under_bytes);
+
+    // The size from the metadata of DMFile is passed, reserve exactly that size.
+    {
+        const auto & obj = objects[0];
+        auto exact_before = reserve_exact.Value();
+        auto over_before = over_bytes.Value();
+        auto under_before = under_bytes.Value();
+        auto file_seg = file_cache.getOrWait(S3FilenameView::fromKey(obj.key), obj.size);
+        ASSERT_NE(file_seg, nullptr);
+        ASSERT_EQ(file_seg->getSize(), obj.size);
+        ASSERT_EQ(file_cache.cache_used.load(), obj.size);
+        ASSERT_EQ(reserve_exact.Value(), exact_before + 1);
+        ASSERT_EQ(over_bytes.Value(), over_before);
+        ASSERT_EQ(under_bytes.Value(), under_before);
+    }
+
+    // The size is unknown, reserve the estimated size and record the error of reservation.
+    {
+        const auto & obj = objects[1];
+        auto estimated_before = reserve_estimated.Value();
+        auto over_before = over_bytes.Value();
+        auto under_before = under_bytes.Value();
+        auto file_seg = file_cache.getOrWait(S3FilenameView::fromKey(obj.key), std::nullopt);
+        ASSERT_NE(file_seg, nullptr);
+        ASSERT_EQ(file_seg->getSize(), obj.size);
+        ASSERT_EQ(file_cache.cache_used.load(), objects[0].size + obj.size);
+        ASSERT_EQ(reserve_estimated.Value(), estimated_before + 1);
+        auto estimated_size = FileCache::getEstimatedSizeOfFileType(FileType::ColData);
+        if (estimated_size > obj.size)
+            ASSERT_EQ(over_bytes.Value() - over_before, estimated_size - obj.size);
+        else
+            ASSERT_EQ(under_bytes.Value() - under_before, obj.size - estimated_size);
+    }
+}
+CATCH
+
 TEST_F(FileCacheTest, ReserveMeetOverUsed)
 {
     UInt16 vcores = 1;
@@ -552,22 +663,25 @@ TEST_F(FileCacheTest, ReserveMeetOverUsed)
 
     // hack to set cache_used to over capacity
     {
-        std::unique_lock lock(file_cache.mtx);
-        file_cache.tables[magic_enum::enum_integer(FileType::Index)].set(
+        setFileSegment(
+            file_cache,
             "/key1",
             std::make_shared<FileSegment>(
                 "/key1",
                 FileSegment::Status::Complete,
                 dt_cache_capacity - 1024,
                 FileType::Index));
-        file_cache.tables[magic_enum::enum_integer(FileType::Index)].set(
+        setFileSegment(
+            file_cache,
             "/key2",
             std::make_shared<FileSegment>("/key2", FileSegment::Status::Complete, 512, FileType::Index));
-        file_cache.tables[magic_enum::enum_integer(FileType::Index)].set(
+        setFileSegment(
+            file_cache,
             "/key3",
             std::make_shared<FileSegment>("/key3", FileSegment::Status::Complete, 512, FileType::Index));
         // somehow 10 byte over used
-        file_cache.tables[magic_enum::enum_integer(FileType::Index)].set(
+        setFileSegment(
+            file_cache,
             "/key4",
             std::make_shared<FileSegment>("/key4", FileSegment::Status::Complete, 10, FileType::Index));
         file_cache.cache_used = dt_cache_capacity + 10;
@@ -703,7 +817,7 @@ try
         ASSERT_TRUE(file_seg->isReadyToRead());
         ASSERT_EQ(file_seg->getSize(), 0);
     }
-    ASSERT_EQ(file_cache.cache_used, 0);
+    ASSERT_EQ(file_cache.cache_used.load(), 0);
 
     // Make cache full
     for (const auto & obj : objects)
@@ -715,7 +829,7 @@ try
     waitForBgDownload(file_cache);
     ASSERT_EQ(file_cache.bg_download_fail_count.load(std::memory_order_relaxed), 0);
     ASSERT_EQ(file_cache.bg_download_succ_count.load(std::memory_order_relaxed), objects.size() + empty_s3_keys.size());
-    ASSERT_EQ(file_cache.cache_used, file_cache.cache_capacity);
+    ASSERT_EQ(file_cache.cache_used.load(), file_cache.cache_capacity);
     for (const auto & obj : objects)
     {
         auto s3_fname = ::DB::S3::S3FilenameView::fromKey(obj.key);
@@ -725,7 +839,7 @@ try
         ASSERT_TRUE(file_seg->isReadyToRead());
         ASSERT_EQ(file_seg->getSize(), obj.size);
     }
-    ASSERT_EQ(file_cache.cache_used, file_cache.cache_capacity);
+    ASSERT_EQ(file_cache.cache_used.load(), file_cache.cache_capacity);
 
     // Evict empty files
     auto objects2 = genObjects(/*store_count*/ 1, /*table_count*/ 1, /*file_count*/ 1, {"meta"});
@@ -773,13 +887,13 @@ try
     waitForBgDownload(file_cache);
     ASSERT_EQ(file_cache.bg_download_fail_count.load(std::memory_order_relaxed), 0);
     ASSERT_EQ(file_cache.bg_download_succ_count.load(std::memory_order_relaxed), objects.size());
-    ASSERT_EQ(file_cache.cache_used, file_cache.cache_capacity);
+    ASSERT_EQ(file_cache.cache_used.load(), file_cache.cache_capacity);
 
     // Drop cache manually
     ASSERT_TRUE(std::filesystem::exists(cache_config.getDTFileCacheDir()));
     std::filesystem::remove_all(cache_config.getDTFileCacheDir());
     ASSERT_FALSE(std::filesystem::exists(cache_config.getDTFileCacheDir()));
-    ASSERT_EQ(file_cache.cache_used, file_cache.cache_capacity);
+    ASSERT_EQ(file_cache.cache_used.load(), file_cache.cache_capacity);
 
     // Remove dropped-files
     Settings settings;
@@ -805,20 +919,20 @@ try
         LOG_INFO(
             log,
             "cache_used={} released_size={} cache_capacity={} obj_size={} file_seg_size={}",
-            file_cache.cache_used,
+            file_cache.cache_used.load(),
             released_size,
             file_cache.cache_capacity,
             obj.size,
             file_seg->getSize());
-        ASSERT_EQ(file_cache.cache_used + released_size, file_cache.cache_capacity) << fmt::format(
+        ASSERT_EQ(file_cache.cache_used.load() + released_size, file_cache.cache_capacity) << fmt::format(
             "cache_used={} released_size={} cache_capacity={}",
-            file_cache.cache_used,
+            file_cache.cache_used.load(),
             released_size,
             file_cache.cache_capacity);
 
         ASSERT_EQ(file_cache.get(s3_fname), nullptr); // Has been removed.
     }
-    ASSERT_EQ(file_cache.cache_used, 0);
+    ASSERT_EQ(file_cache.cache_used.load(), 0);
     ASSERT_EQ(released_size, file_cache.cache_capacity);
 
     waitForBgDownload(file_cache);
@@ -980,18 +1094,20 @@ TEST_F(FileCacheTest, EvictBySize)
         auto dt_cache_capacity = cache_config.getDTFileCapacity();
         // hack to add some files
         {
-            std::unique_lock lock(file_cache.mtx);
-            file_cache.tables[magic_enum::enum_integer(FileType::Index)].set(
+            setFileSegment(
+                file_cache,
                 "/key1",
                 std::make_shared<FileSegment>(
                     "/key1",
                     FileSegment::Status::Complete,
                     dt_cache_capacity - 2048,
                     FileType::Index));
-            file_cache.tables[magic_enum::enum_integer(FileType::Index)].set(
+            setFileSegment(
+                file_cache,
                 "/key2",
                 std::make_shared<FileSegment>("/key2", FileSegment::Status::Complete, 512, FileType::Index));
-            file_cache.tables[magic_enum::enum_integer(FileType::Index)].set(
+            setFileSegment(
+                file_cache,
                 "/key3",
                 std::make_shared<FileSegment>("/key3", FileSegment::Status::Complete, 512, FileType::Index));
             file_cache.cache_used = dt_cache_capacity - 2048 + 512 + 512;
@@ -1009,21 +1125,22 @@ TEST_F(FileCacheTest, EvictBySize)
         auto dt_cache_capacity = cache_config.getDTFileCapacity();
         // hack to add some files
         {
-            std::unique_lock lock(file_cache.mtx);
-            file_cache.tables[magic_enum::enum_integer(FileType::Index)].set(
+            setFileSegment(
+                file_cache,
                 "/key1",
                 std::make_shared<FileSegment>(
                     "/key1",
                     FileSegment::Status::Complete,
                     dt_cache_capacity - 2048,
                     FileType::Index));
-            file_cache.tables[magic_enum::enum_integer(FileType::Index)].set(
+            setFileSegment(
+                file_cache,
                 "/key2",
                 std::make_shared<FileSegment>("/key2", FileSegment::Status::Complete, 512, FileType::Index));
             // hack a older last_access_time
             auto seg = std::make_shared<FileSegment>("/key3", FileSegment::Status::Complete, 512, FileType::Index);
             seg->setLastAccessTime(std::chrono::system_clock::now() - std::chrono::hours(24));
-            file_cache.tables[magic_enum::enum_integer(FileType::Index)].set("/key3", seg);
+            setFileSegment(file_cache, "/key3", seg);
             file_cache.cache_used = dt_cache_capacity - 2048 + 512 + 512;
         }
         // evict should respect the priority and last_access_time, evict the "/key3" with only 512 bytes
@@ -1039,22 +1156,25 @@ TEST_F(FileCacheTest, EvictBySize)
         auto dt_cache_capacity = cache_config.getDTFileCapacity();
         // hack to set cache_used to over capacity
         {
-            std::unique_lock lock(file_cache.mtx);
-            file_cache.tables[magic_enum::enum_integer(FileType::Index)].set(
+            setFileSegment(
+                file_cache,
                 "/key1",
                 std::make_shared<FileSegment>(
                     "/key1",
                     FileSegment::Status::Complete,
                     dt_cache_capacity - 1024,
                     FileType::Index));
-            file_cache.tables[magic_enum::enum_integer(FileType::Index)].set(
+            setFileSegment(
+                file_cache,
                 "/key2",
                 std::make_shared<FileSegment>("/key2", FileSegment::Status::Complete, 512, FileType::Index));
-            file_cache.tables[magic_enum::enum_integer(FileType::Index)].set(
+            setFileSegment(
+                file_cache,
                 "/key3",
                 std::make_shared<FileSegment>("/key3", FileSegment::Status::Complete, 512, FileType::Index));
             // somehow 10 byte over used
-            file_cache.tables[magic_enum::enum_integer(FileType::Index)].set(
+            setFileSegment(
+                file_cache,
                 "/key4",
                 std::make_shared<FileSegment>("/key4", FileSegment::Status::Complete, 10, FileType::Index));
             file_cache.cache_used = dt_cache_capacity + 10;
@@ -1254,9 +1374,7 @@ TEST_F(FileCacheTest, GetWaitOnDownloadingReturnsMissWhenDownloaderFails)
     // The failed placeholder must be removed from the cache table. Otherwise later requests would keep observing
     // the stale failed entry instead of creating a fresh download task.
     {
-        std::lock_guard lock(file_cache.mtx);
-        auto & table = file_cache.tables[static_cast<UInt64>(FileType::Merged)];
-        ASSERT_EQ(table.get(objects[0].key), nullptr);
+        ASSERT_EQ(getFileSegment(file_cache, objects[0].key, FileType::Merged), nullptr);
     }
 
     // A later foreground retry should succeed, proving the failed follower path does not leave the cache stuck.
@@ -1492,11 +1610,11 @@ TEST_F(FileCacheTest, FailedDownloadReleasesFinalizedReservedSize)
         FailPointHelper::enableFailPoint(FailPoints::file_cache_bg_download_fail);
         SCOPE_EXIT({ FailPointHelper::disableFailPoint(FailPoints::file_cache_bg_download_fail); });
 
-        ASSERT_EQ(file_cache.cache_used, 0);
+        ASSERT_EQ(file_cache.cache_used.load(), 0);
         ASSERT_EQ(file_cache.get(key, requested_size), nullptr);
         waitForBgDownload(file_cache);
 
-        ASSERT_EQ(file_cache.cache_used, 0);
+        ASSERT_EQ(file_cache.cache_used.load(), 0);
         ASSERT_EQ(file_cache.bg_download_fail_count.load(std::memory_order_relaxed), 1);
         ASSERT_EQ(file_cache.bg_download_succ_count.load(std::memory_order_relaxed), 0);
     };
@@ -1532,13 +1650,216 @@ TEST_F(FileCacheTest, ScheduleBgDownloadFailureCleansUpPlaceholder)
     ASSERT_EQ(file_cache.get(key, objects[0].size), nullptr);
     ASSERT_EQ(file_cache.bg_downloading_count.load(std::memory_order_relaxed), 0);
     ASSERT_EQ(file_cache.bg_download_fail_count.load(std::memory_order_relaxed), 1);
-    ASSERT_EQ(file_cache.tables[static_cast<UInt64>(file_type)].get(objects[0].key, /*update_lru*/ false), nullptr);
+    ASSERT_EQ(getFileSegment(file_cache, objects[0].key, file_type), nullptr);
 
     FailPointHelper::disableFailPoint(FailPoints::file_cache_bg_download_schedule_fail);
     ASSERT_EQ(file_cache.get(key, objects[0].size), nullptr);
     waitForBgDownload(file_cache);
     ASSERT_EQ(file_cache.bg_download_succ_count.load(std::memory_order_relaxed), 1);
-    ASSERT_NE(file_cache.tables[static_cast<UInt64>(file_type)].get(objects[0].key, /*update_lru*/ false), nullptr);
+    ASSERT_NE(getFileSegment(file_cache, objects[0].key, file_type), nullptr);
+}
+
+TEST_F(FileCacheTest, RangeKey)
+{
+    DMFileOID dmfile_oid = {.store_id = 1, .table_id = 2, .file_id = 3};
+    auto s3_fname = S3Filename::fromDMFileOID(dmfile_oid).toFullKey();
+    auto data_key = fmt::format("{}/1.dat", s3_fname);
+    auto range_key = FileCache::toRangeKey(data_key, {.begin = 1024, .end = 4096});
+    ASSERT_EQ(range_key, fmt::format("{}.1024_4096.part", data_key));
+    auto parsed = FileCache::parseRangeKey(range_key);
+    ASSERT_TRUE(parsed.has_value());
+    ASSERT_EQ(parsed->first, data_key);
+    ASSERT_EQ(parsed->second.begin, 1024);
+    ASSERT_EQ(parsed->second.end, 4096);
+
+    // The file type of a range is the same as the object.
+    ASSERT_EQ(FileCache::getFileType(range_key), FileType::ColData);
+    auto null_key = fmt::format("{}/1.null.dat", s3_fname);
+    ASSERT_EQ(FileCache::getFileType(FileCache::toRangeKey(null_key, {.begin = 0, .end = 1})), FileType::NullMap);
+    auto merged_key = fmt::format("{}/1.merged", s3_fname);
+    ASSERT_EQ(FileCache::getFileType(FileCache::toRangeKey(merged_key, {.begin = 0, .end = 1})), FileType::Merged);
+
+    ASSERT_FALSE(FileCache::parseRangeKey(data_key).has_value());
+    ASSERT_FALSE(FileCache::parseRangeKey(fmt::format("{}.abc_4096.part", data_key)).has_value());
+    ASSERT_FALSE(FileCache::parseRangeKey(fmt::format("{}.1024-4096.part", data_key)).has_value());
+    ASSERT_FALSE(FileCache::parseRangeKey(fmt::format("{}.4096_4096.part", data_key)).has_value());
+    ASSERT_FALSE(FileCache::parseRangeKey(fmt::format("{}._4096.part", data_key)).has_value());
+
+    ASSERT_TRUE(FileCache::isRangeCacheable(FileType::ColData));
+    ASSERT_TRUE(FileCache::isRangeCacheable(FileType::Merged));
+    ASSERT_FALSE(FileCache::isRangeCacheable(FileType::Meta));
+    ASSERT_FALSE(FileCache::isRangeCacheable(FileType::Mark));
+    ASSERT_FALSE(FileCache::isRangeCacheable(FileType::VectorIndex));
+}
+
+TEST_F(FileCacheTest, GetOrWaitRange)
+{
+    auto cache_dir = fmt::format("{}/get_or_wait_range", tmp_dir);
+    StorageRemoteCacheConfig cache_config{.dir = cache_dir, .capacity = cache_capacity, .dtfile_level = 100};
+
+    UInt16 vcores = 2;
+    IORateLimiter rate_limiter;
+    FileCache file_cache(capacity_metrics, cache_config, vcores, rate_limiter);
+
+    auto dmfile_key = fmt::format("s{}/data/t_{}/dmf_{}", nextId(), nextId(), nextId());
+    auto object_key = fmt::format("{}/1.dat", dmfile_key);
+    constexpr size_t object_size = 10 * 1024;
+    String data(object_size, '\0');
+    for (size_t i = 0; i < object_size; ++i)
+        data[i] = static_cast<char>(i % 251);
+    {
+        S3WritableFile file(s3_client, object_key, WriteSettings{});
+        ASSERT_EQ(file.write(data.data(), data.size()), data.size());
+        ASSERT_EQ(file.fsync(), 0);
+    }
+    auto read_local_file = [](const String & fname) {
+        std::ifstream istr(fname, std::ios::binary);
+        return String(std::istreambuf_iterator<char>(istr), std::istreambuf_iterator<char>());
+    };
+
+    auto s3_fname = S3FilenameView::fromKey(object_key);
+    FileSegment::Range range{.begin = 4096, .end = 8192};
+    auto perf_begin = PerfContext::file_cache;
+    auto file_seg = file_cache.getOrWaitRange(s3_fname, range);
+    ASSERT_NE(file_seg, nullptr);
+    ASSERT_TRUE(file_seg->isReadyToRead());
+    ASSERT_EQ(file_seg->getSize(), range.size());
+    ASSERT_TRUE(file_seg->getRange().has_value());
+    ASSERT_EQ(file_seg->getRange()->begin, range.begin);
+    ASSERT_EQ(PerfContext::file_cache.fg_download_from_s3, perf_begin.fg_download_from_s3 + 1);
+    ASSERT_EQ(file_cache.cache_used.load(), range.size());
+    ASSERT_EQ(read_local_file(file_seg->getLocalFileName()), data.substr(range.begin, range.size()));
+
+    // Hit the cached range without downloading again.
+    ASSERT_EQ(file_cache.getOrWaitRange(s3_fname, range), file_seg);
+    ASSERT_EQ(PerfContext::file_cache.fg_download_from_s3, perf_begin.fg_download_from_s3 + 1);
+
+    // The last range of the object is shorter than the block size.
+    FileSegment::Range last_range{.begin = 8192, .end = object_size};
+    auto last_seg = file_cache.getOrWaitRange(s3_fname, last_range);
+    ASSERT_NE(last_seg, nullptr);
+    ASSERT_EQ(last_seg->getSize(), object_size - 8192);
+    ASSERT_EQ(read_local_file(last_seg->getLocalFileName()), data.substr(last_range.begin, last_range.size()));
+    ASSERT_EQ(file_cache.getAll().size(), 2);
+    ASSERT_EQ(file_cache.cache_used.load(), object_size - 4096);
+
+    // Ranges are evicted separately.
+    auto local_fname = file_seg->getLocalFileName();
+    file_seg.reset();
+    file_cache.remove(FileCache::toRangeKey(object_key, range));
+    ASSERT_FALSE(std::filesystem::exists(local_fname));
+    ASSERT_EQ(file_cache.getAll().size(), 1);
+    ASSERT_EQ(file_cache.cache_used.load(), last_range.size());
+
+    // Ranges of the files that are not data files are not cached.
+    auto mark_fname = S3FilenameView::fromKey(fmt::format("{}/1.mrk", dmfile_key));
+    ASSERT_EQ(file_cache.getOrWaitRange(mark_fname, range), nullptr);
+
+    // Restore the cached ranges after restart.
+    last_seg.reset();
+    FileCache restored_cache(capacity_metrics, cache_config, vcores, rate_limiter);
+    auto restored = restored_cache.getAll();
+    ASSERT_EQ(restored.size(), 1);
+    ASSERT_TRUE(restored[0]->getRange().has_value());
+    ASSERT_EQ(restored[0]->getRange()->begin, last_range.begin);
+    ASSERT_EQ(restored[0]->getRange()->end, last_range.end);
+}
+
+TEST_F(FileCacheTest, S3RandomAccessFileReadByRange)
+{
+    auto cache_dir = fmt::format("{}/read_by_range", tmp_dir);
+    StorageRemoteCacheConfig cache_config{.dir = cache_dir, .capacity = cache_capacity, .dtfile_level = 100};
+
+    UInt16 vcores = 2;
+    IORateLimiter rate_limiter;
+    FileCache file_cache(capacity_metrics, cache_config, vcores, rate_limiter);
+    constexpr UInt64 block_size = 4096;
+    Settings settings;
+    settings.dt_filecache_range_block_size = block_size;
+    file_cache.updateConfig(settings);
+
+    auto dmfile_key = fmt::format("s{}/data/t_{}/dmf_{}", nextId(), nextId(), nextId());
+    auto object_key = fmt::format("{}/2.dat", dmfile_key);
+    constexpr size_t object_size = 10 * 1024;
+    String data(object_size, '\0');
+    for (size_t i = 0; i < object_size; ++i)
+        data[i] = static_cast<char>(i % 251);
+    {
+        S3WritableFile file(s3_client, object_key, WriteSettings{});
+        ASSERT_EQ(file.write(data.data(), data.size()), data.size());
+        ASSERT_EQ(file.fsync(), 0);
+    }
+    ASSERT_EQ(file_cache.getRangeBlockSize(S3FilenameView::fromKey(object_key)), block_size);
+    ASSERT_EQ(file_cache.getRangeBlockSize(S3FilenameView::fromKey(fmt::format("{}/2.mrk", dmfile_key))), 0);
+
+    S3RandomAccessFile file(s3_client, object_key, nullptr, &file_cache, block_size, object_size);
+    // Read across two blocks, only these two blocks are downloaded.
+    String buf(4000, '\0');
+    ASSERT_EQ(file.seek(5000, SEEK_SET), 5000);
+    ASSERT_EQ(file.read(buf.data(), buf.size()), buf.size());
+    ASSERT_EQ(buf, data.substr(5000, buf.size()));
+    ASSERT_EQ(file_cache.getAll().size(), 2);
+    ASSERT_EQ(file_cache.cache_used.load(), object_size - block_size);
+
+    // Read until the end of object.
+    ASSERT_EQ(file.seek(0, SEEK_SET), 0);
+    String all(object_size + 100, '\0');
+    ASSERT_EQ(file.read(all.data(), all.size()), object_size);
+    ASSERT_EQ(all.substr(0, object_size), data);
+    ASSERT_EQ(file.read(all.data(), all.size()), 0);
+    ASSERT_EQ(file_cache.getAll().size(), 3);
+    ASSERT_EQ(file_cache.cache_used.load(), object_size);
+
+    // Read from S3 directly if the block can not be cached.
+    file_cache.evictByFileType(FileType::Meta);
+    ASSERT_EQ(file_cache.cache_used.load(), 0);
+    file_cache.cache_capacity = 0;
+    S3RandomAccessFile uncached_file(s3_client, object_key, nullptr, &file_cache, block_size, object_size);
+    ASSERT_EQ(uncached_file.seek(5000, SEEK_SET), 5000);
+    ASSERT_EQ(uncached_file.read(buf.data(), buf.size()), buf.size());
+    ASSERT_EQ(buf, data.substr(5000, buf.size()));
+    ASSERT_EQ(file_cache.getAll().size(), 0);
+}
+
+TEST_F(FileCacheTest, GetCachedRandomAccessFile)
+{
+    auto cache_dir = fmt::format("{}/get_cached_random_access_file", tmp_dir);
+    StorageRemoteCacheConfig cache_config{.dir = cache_dir, .capacity = cache_capacity, .dtfile_level = 100};
+
+    UInt16 vcores = 2;
+    IORateLimiter rate_limiter;
+    FileCache file_cache(capacity_metrics, cache_config, vcores, rate_limiter);
+
+    auto dmfile_key = fmt::format("s{}/data/t_{}/dmf_{}", nextId(), nextId(), nextId());
+    auto object_key = fmt::format("{}/3.dat", dmfile_key);
+    constexpr size_t object_size = 10 * 1024;
+    String data(object_size, '\0');
+    for (size_t i = 0; i < object_size; ++i)
+        data[i] = static_cast<char>(i % 251);
+    {
+        S3WritableFile file(s3_client, object_key, WriteSettings{});
+        ASSERT_EQ(file.write(data.data(), data.size()), data.size());
+        ASSERT_EQ(file.fsync(), 0);
+    }
+    auto s3_fname = S3FilenameView::fromKey(object_key);
+
+    // A miss does not download the object.
+    ASSERT_EQ(file_cache.getCachedRandomAccessFile(s3_fname), nullptr);
+    ASSERT_TRUE(file_cache.getAll().empty());
+
+    // Cache the whole object, then it is read locally even if the range mode is enabled.
+    ASSERT_EQ(file_cache.get(s3_fname, object_size), nullptr);
+    waitForBgDownload(file_cache);
+    Settings settings;
+    settings.dt_filecache_range_block_size = 4096;
+    file_cache.updateConfig(settings);
+    auto file = file_cache.getCachedRandomAccessFile(s3_fname);
+    ASSERT_NE(file, nullptr);
+    String buf(object_size, '\0');
+    ASSERT_EQ(file->pread(buf.data(), buf.size(), 0), object_size);
+    ASSERT_EQ(buf, data);
+    ASSERT_EQ(file_cache.getAll().size(), 1);
+    ASSERT_EQ(file_cache.cache_used.load(), object_size);
 }
 
 } // namespace DB::tests::S3
@@ -28,6 +28,7 @@ SelectQueryInfo::SelectQueryInfo(const SelectQueryInfo & rhs)
     , sets(rhs.sets)
     , mvcc_query_info(rhs.mvcc_query_info != nullptr ? std::make_unique<MvccQueryInfo>(*rhs.mvcc_query_info) : nullptr)
     , dag_query(rhs.dag_query != nullptr ? std::make_unique<DAGQueryInfo>(*rhs.dag_query) : nullptr)
+    , topn_threshold(rhs.topn_threshold)
     , req_id(rhs.req_id)
     , keep_order(rhs.keep_order)
     , is_fast_scan(rhs.is_fast_scan)
@@ -39,6 +40,7 @@ SelectQueryInfo::SelectQueryInfo(SelectQueryInfo && rhs) noexcept
     , sets(std::move(rhs.sets))
     , mvcc_query_info(std::move(rhs.mvcc_query_info))
     , dag_query(std::move(rhs.dag_query))
+    , topn_threshold(std::move(rhs.topn_threshold))
     , req_id(std::move(rhs.req_id))
     , keep_order(rhs.keep_order)
     , is_fast_scan(rhs.is_fast_scan)
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <DataStreams/TopNThreshold_fwd.h>
+
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -52,6 +54,9 @@ struct SelectQueryInfo
 
     std::unique_ptr<DAGQueryInfo> dag_query;
 
+    /// The threshold published by the TopN above the table scan, nullptr if there is none.
+    TopNThresholdPtr topn_threshold;
+
     std::string req_id;
     bool keep_order = true;
     bool is_fast_scan = false;
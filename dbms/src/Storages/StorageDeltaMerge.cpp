@@ -23,6 +23,7 @@
 #include <Core/Defines.h>
 #include <DataStreams/IBlockOutputStream.h>
 #include <DataStreams/OneBlockInputStream.h>
+#include <DataStreams/TopNThreshold.h>
 #include <DataTypes/isSupportedDataTypeCast.h>
 #include <Databases/IDatabase.h>
 #include <Debug/MockTiDB.h>
@@ -825,6 +826,19 @@ RuntimeFilterList parseRuntimeFilterList(
     }
     return runtime_filter_list;
 }
+
+void attachTopNThreshold(
+    const SelectQueryInfo & query_info,
+    const DM::ColumnDefines & table_column_defines,
+    DM::PushDownExecutorPtr & pushdown_executor)
+{
+    if (query_info.topn_threshold == nullptr || query_info.dag_query == nullptr)
+        return;
+    query_info.topn_threshold->setTargetAttr(query_info.dag_query->source_columns, table_column_defines);
+    if (pushdown_executor == nullptr)
+        pushdown_executor = std::make_shared<PushDownExecutor>(EMPTY_RS_OPERATOR);
+    pushdown_executor->topn_threshold = query_info.topn_threshold;
+}
 } // namespace
 
 
@@ -884,6 +898,8 @@ BlockInputStreams StorageDeltaMerge::read(
         context,
         tracing_logger);
 
+    attachTopNThreshold(query_info, store->getTableColumns(), pushdown_executor);
+
     auto runtime_filter_list = parseRuntimeFilterList(query_info, store->getTableColumns(), context, tracing_logger);
 
     const auto & scan_context = mvcc_query_info.scan_context;
@@ -978,6 +994,8 @@ void StorageDeltaMerge::read(
         context,
         tracing_logger);
 
+    attachTopNThreshold(query_info, store->getTableColumns(), pushdown_executor);
+
     auto runtime_filter_list = parseRuntimeFilterList(query_info, store->getTableColumns(), context, tracing_logger);
 
     const auto & scan_context = mvcc_query_info.scan_context;
@@ -1877,7 +1895,7 @@ DeltaMergeStorePtr & StorageDeltaMerge::getAndMaybeInitStore(ThreadPool * thread
             is_common_handle,
             rowkey_column_size,
             std::move(index_infos),
-            DeltaMergeStore::Settings(),
+            DeltaMergeStore::Settings{.equality_bloom_index_columns = getEqualityBloomIndexColumns(tidb_table_info)},
             thread_pool);
         table_column_info.reset(nullptr);
         store_inited.store(true, std::memory_order_release);
@@ -0,0 +1,143 @@
+// Copyright 2024 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <DataStreams/OneBlockInputStream.h>
+#include <DataTypes/DataTypeNullable.h>
+#include <DataTypes/DataTypeString.h>
+#include <DataTypes/DataTypesNumber.h>
+#include <Databases/DatabaseTiFlash.h>
+#include <Databases/IDatabase.h>
+#include <Interpreters/Context.h>
+#include <Storages/DeltaMerge/DeltaMergeStore.h>
+#include <Storages/DeltaMerge/Index/Histogram.h>
+#include <Storages/KVStore/Types.h>
+#include <Storages/MutableSupport.h>
+#include <Storages/StorageDeltaMerge.h>
+#include <Storages/System/StorageSystemDTColumnStatistics.h>
+#include <Storages/System/utils.h>
+#include <TiDB/Schema/TiDB.h>
+
+namespace DB
+{
+
+StorageSystemDTColumnStatistics::StorageSystemDTColumnStatistics(const std::string & name_)
+    : name(name_)
+{
+    setColumns(ColumnsDescription({
+        {"database", std::make_shared<DataTypeString>()},
+        {"table", std::make_shared<DataTypeString>()},
+
+        {"tidb_database", std::make_shared<DataTypeString>()},
+        {"tidb_table", std::make_shared<DataTypeString>()},
+        {"keyspace_id", std::make_shared<DataTypeNullable>(std::make_shared<DataTypeUInt64>())},
+        {"table_id", std::make_shared<DataTypeInt64>()},
+        {"belonging_table_id", std::make_shared<DataTypeInt64>()},
+
+        {"column_id", std::make_shared<DataTypeInt64>()},
+        {"column_name", std::make_shared<DataTypeString>()},
+
+        {"total_rows", std::make_shared<DataTypeUInt64>()}, // The rows of the whole table
+        {"stats_rows", std::make_shared<DataTypeUInt64>()}, // The rows covered by the statistics
+        {"null_count", std::make_shared<DataTypeUInt64>()},
+        {"ndv", std::make_shared<DataTypeUInt64>()},
+        {"histogram_buckets", std::make_shared<DataTypeUInt64>()},
+    }));
+}
+
+BlockInputStreams StorageSystemDTColumnStatistics::read(
+    const Names & column_names,
+    const SelectQueryInfo & query_info,
+    const Context & context,
+    QueryProcessingStage::Enum & processed_stage,
+    const size_t /*max_block_size*/,
+    const unsigned /*num_streams*/)
+{
+    check(column_names);
+    processed_stage = QueryProcessingStage::FetchColumns;
+
+    MutableColumns res_columns = getSampleBlock().cloneEmptyColumns();
+
+    auto databases = context.getDatabases();
+    const auto parsed_keyspace_id = parseKeyspaceIDFromSelectQueryInfo(query_info);
+    for (const auto & d : databases)
+    {
+        String database_name = d.first;
+        const auto & database = d.second;
+        const DatabaseTiFlash * db_tiflash = typeid_cast<DatabaseTiFlash *>(database.get());
+        if (!db_tiflash)
+            continue;
+
+        const auto keyspace_id = db_tiflash->getDatabaseInfo().keyspace_id;
+        if (parsed_keyspace_id != NullspaceID && keyspace_id != parsed_keyspace_id)
+            continue;
+
+        auto it = database->getIterator(context);
+        for (; it->isValid(); it->next())
+        {
+            const auto & table_name = it->name();
+            auto & storage = it->table();
+            if (storage->getName() != MutSup::delta_tree_storage_name)
+                continue;
+
+            auto dm_storage = std::dynamic_pointer_cast<StorageDeltaMerge>(storage);
+            if (dm_storage->isTombstone())
+                continue;
+            // Do not initiate the store, the table without any data has no statistics.
+            auto store = dm_storage->getStoreIfInited();
+            if (!store)
+                continue;
+
+            const auto & table_info = dm_storage->getTableInfo();
+            const auto store_columns = store->getStoreColumns();
+            for (const auto & cd : *store_columns)
+            {
+                // Same as the columns built with statistics in DMFileWriter.
+                if (cd.id < 0 || !DM::RSIndexNumber::isSupportedType(cd.type))
+                    continue;
+                const auto column_stats = store->getColumnStatistics(cd.id);
+                if (!column_stats.stats)
+                    continue;
+
+                size_t j = 0;
+                res_columns[j++]->insert(database_name);
+                res_columns[j++]->insert(table_name);
+
+                String tidb_db_name = db_tiflash->getDatabaseInfo().name;
+                res_columns[j++]->insert(tidb_db_name);
+                String tidb_table_name = table_info.name;
+                res_columns[j++]->insert(tidb_table_name);
+                if (keyspace_id == NullspaceID)
+                    res_columns[j++]->insert(Field());
+                else
+                    res_columns[j++]->insert(static_cast<UInt64>(keyspace_id));
+                res_columns[j++]->insert(table_info.id);
+                res_columns[j++]->insert(table_info.belonging_table_id);
+
+                res_columns[j++]->insert(cd.id);
+                res_columns[j++]->insert(cd.name);
+
+                res_columns[j++]->insert(column_stats.total_rows);
+                res_columns[j++]->insert(column_stats.stats_rows);
+                res_columns[j++]->insert(column_stats.stats->nullCount());
+                res_columns[j++]->insert(column_stats.stats->ndv());
+                res_columns[j++]->insert(static_cast<UInt64>(column_stats.stats->buckets().size()));
+            }
+        }
+    }
+
+    return BlockInputStreams(
+        1,
+        std::make_shared<OneBlockInputStream>(getSampleBlock().cloneWithColumns(std::move(res_columns))));
+}
+
+} // namespace DB
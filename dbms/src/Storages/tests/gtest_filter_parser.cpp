@@ -376,7 +376,7 @@ try
     {
         // And
         auto rs_operator
-            = generateRsOperator(table_info_json, "select * from default.t_111 where col_1 = 'test1' and col_2 = 666");
+            = generateRsOperator(table_info_json, "select * from default.t_111 where col_1 > 'test1' and col_2 = 666");
         EXPECT_EQ(rs_operator->name(), "and");
         EXPECT_EQ(rs_operator->getColumnIDs().size(), 1);
         EXPECT_EQ(rs_operator->getColumnIDs()[0], 2);
@@ -427,7 +427,7 @@ try
         // And with "not supported"
         auto rs_operator = generateRsOperator(
             table_info_json,
-            "select * from default.t_111 where col_1 = 'test1' and not col_2 = 666");
+            "select * from default.t_111 where col_1 > 'test1' and not col_2 = 666");
         EXPECT_EQ(rs_operator->name(), "and");
         EXPECT_EQ(rs_operator->getColumnIDs().size(), 1);
         EXPECT_EQ(rs_operator->getColumnIDs()[0], 2);
@@ -479,7 +479,7 @@ try
     {
         // Or with "not supported"
         auto rs_operator
-            = generateRsOperator(table_info_json, "select * from default.t_111 where col_1 = 'test1' or col_2 = 666");
+            = generateRsOperator(table_info_json, "select * from default.t_111 where col_1 > 'test1' or col_2 = 666");
         EXPECT_EQ(rs_operator->name(), "or");
         EXPECT_EQ(rs_operator->getColumnIDs().size(), 1);
         EXPECT_EQ(rs_operator->getColumnIDs()[0], 2);
@@ -495,7 +495,7 @@ try
         // Or with not
         auto rs_operator = generateRsOperator(
             table_info_json,
-            "select * from default.t_111 where col_1 = 'test1' or not col_2 = 666");
+            "select * from default.t_111 where col_1 > 'test1' or not col_2 = 666");
         EXPECT_EQ(rs_operator->name(), "or");
         EXPECT_EQ(rs_operator->getColumnIDs().size(), 1);
         EXPECT_EQ(rs_operator->getColumnIDs()[0], 2);
@@ -706,6 +706,48 @@ try
 }
 CATCH
 
+// Test cases for equality compare on string column, which is checked by the equality bloom index
+TEST_F(FilterParserTest, StringColumnEquality)
+try
+{
+    const String table_info_json = R"json({
+    "cols":[
+        {"comment":"","default":null,"default_bit":null,"id":1,"name":{"L":"col_1","O":"col_1"},"offset":-1,"origin_default":null,"state":0,"type":{"Charset":null,"Collate":null,"Decimal":0,"Elems":null,"Flag":4097,"Flen":0,"Tp":254}},
+        {"comment":"","default":null,"default_bit":null,"id":2,"name":{"L":"col_2","O":"col_2"},"offset":-1,"origin_default":null,"state":0,"type":{"Charset":null,"Collate":null,"Decimal":0,"Elems":null,"Flag":4097,"Flen":0,"Tp":8}}
+    ],
+    "pk_is_handle":false,"index_info":[],"is_common_handle":false,
+    "name":{"L":"t_111","O":"t_111"},"partition":null,
+    "comment":"Mocked.","id":30,"schema_version":-1,"state":0,"tiflash_replica":{"Count":0},"update_timestamp":1636471547239654
+})json";
+
+    google::protobuf::RepeatedPtrField<tipb::ColumnarIndexInfo> used_indexes;
+
+    {
+        auto rs_operator = generateRsOperator(table_info_json, "select * from default.t_111 where col_1 = 'test1'");
+        EXPECT_EQ(rs_operator->name(), "equal");
+        EXPECT_EQ(rs_operator->getColumnIDs().size(), 1);
+        EXPECT_EQ(rs_operator->getColumnIDs()[0], 1);
+        EXPECT_EQ(rs_operator->toDebugString(), R"({"op":"equal","col":"col_1","value":"'test1'"})");
+        auto sets = rs_operator->buildSets(used_indexes);
+        EXPECT_TRUE(sets != nullptr);
+        EXPECT_EQ(sets->toDebugString(), "Unsupported");
+    }
+
+    {
+        auto rs_operator = generateRsOperator(table_info_json, "select * from default.t_111 where col_1 != 'test1'");
+        EXPECT_EQ(rs_operator->name(), "not_equal");
+        EXPECT_EQ(rs_operator->getColumnIDs()[0], 1);
+    }
+
+    {
+        auto rs_operator
+            = generateRsOperator(table_info_json, "select * from default.t_111 where col_1 in ('test1', 'test2')");
+        EXPECT_EQ(rs_operator->name(), "in");
+        EXPECT_EQ(rs_operator->getColumnIDs()[0], 1);
+    }
+}
+CATCH
+
 // Test cases for unsupported column type
 TEST_F(FilterParserTest, UnsupportedColumnType)
 try